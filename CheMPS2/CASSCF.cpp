@@ -57,6 +57,11 @@ CheMPS2::CASSCF::CASSCF(const string filename){
    checkHF();
    
    setupStartCalled = false;
+   warmStart = false;
+   warmStartDims = false;
+   WarmOptScheme = NULL;
+   augHessDenseMaxMB = CheMPS2::CASSCF_augHessDenseMaxMB;
+   allowRestrictedRotation = CheMPS2::CASSCF_restrictedRotation;
    
 }
 
@@ -106,6 +111,11 @@ CheMPS2::CASSCF::CASSCF(Hamiltonian * HamIn, int * DOCCin, int * SOCCin){
    checkHF();
    
    setupStartCalled = false;
+   warmStart = false;
+   warmStartDims = false;
+   WarmOptScheme = NULL;
+   augHessDenseMaxMB = CheMPS2::CASSCF_augHessDenseMaxMB;
+   allowRestrictedRotation = CheMPS2::CASSCF_restrictedRotation;
    
 }
 
@@ -139,12 +149,21 @@ CheMPS2::CASSCF::~CASSCF(){
       
       delete [] jumpsHamOrig;
       delete [] DMRG1DM;
+      delete [] DMRG2DM;
       delete [] x_firstindex;
       delete [] x_secondindex;
       
       for (int cnt=0; cnt<numberOfIrreps; cnt++){ delete [] Fmatrix[cnt]; }
       delete [] Fmatrix;
       
+      for (int cnt=0; cnt<numberOfIrreps; cnt++){
+         delete [] QmatOcc[cnt];
+         delete [] QmatAct[cnt];
+      }
+      delete [] QmatOcc;
+      delete [] QmatAct;
+      delete [] DMRGindexOfOrbital;
+      
    }
 
 }
@@ -377,6 +396,20 @@ void CheMPS2::CASSCF::setDMRG1DM(const int N){
 
 }
 
+void CheMPS2::CASSCF::setDMRG2DM(){
+
+   const int size = nOrbDMRG * nOrbDMRG * nOrbDMRG * nOrbDMRG;
+   #pragma omp parallel for schedule(static)
+   for (int cnt=0; cnt<size; cnt++){
+      const int cnt1 = cnt % nOrbDMRG;
+      const int cnt2 = (cnt / nOrbDMRG) % nOrbDMRG;
+      const int cnt3 = (cnt / (nOrbDMRG * nOrbDMRG)) % nOrbDMRG;
+      const int cnt4 = cnt / (nOrbDMRG * nOrbDMRG * nOrbDMRG);
+      DMRG2DM[cnt] = theDMRG2DM->getTwoDMA_HAM(cnt1, cnt2, cnt3, cnt4);
+   }
+
+}
+
 void CheMPS2::CASSCF::calcNOON(){
 
    int size = nOrbDMRG * nOrbDMRG;
@@ -681,6 +714,9 @@ void CheMPS2::CASSCF::setupStart(int * NoccIn, int * NDMRGIn, int * NvirtIn){
       passed += NDMRG[cnt];
       passed2 += OrbPerIrrep[cnt];
    }
+   DMRGindexOfOrbital = new int[L];
+   for (int cnt=0; cnt<L; cnt++){ DMRGindexOfOrbital[cnt] = -1; }
+   for (int cnt=0; cnt<nOrbDMRG; cnt++){ DMRGindexOfOrbital[listDMRG[cnt]] = cnt; }
    
    //How many and which orbitals are condensed now.
    nCondensed = 0;
@@ -732,6 +768,7 @@ void CheMPS2::CASSCF::setupStart(int * NoccIn, int * NDMRGIn, int * NvirtIn){
    
    //Allocate space for the DMRG 1DM
    DMRG1DM = new double[nOrbDMRG * nOrbDMRG];
+   DMRG2DM = new double[nOrbDMRG * nOrbDMRG * nOrbDMRG * nOrbDMRG];
    
    //Find the corresponding indices
    x_firstindex = new int[x_linearlength];
@@ -776,6 +813,18 @@ void CheMPS2::CASSCF::setupStart(int * NoccIn, int * NDMRGIn, int * NvirtIn){
       for (int cnt2=0; cnt2<OrbPerIrrep[cnt] * OrbPerIrrep[cnt]; cnt2++){ Fmatrix[cnt][cnt2] = 0.0; }
    }
    
+   //The two-body parts of the inactive and active Fock matrices, needed for the Hessian
+   QmatOcc = new double*[numberOfIrreps];
+   QmatAct = new double*[numberOfIrreps];
+   for (int cnt=0; cnt<numberOfIrreps; cnt++){
+      QmatOcc[cnt] = new double[OrbPerIrrep[cnt] * OrbPerIrrep[cnt]];
+      QmatAct[cnt] = new double[OrbPerIrrep[cnt] * OrbPerIrrep[cnt]];
+      for (int cnt2=0; cnt2<OrbPerIrrep[cnt] * OrbPerIrrep[cnt]; cnt2++){
+         QmatOcc[cnt][cnt2] = 0.0;
+         QmatAct[cnt][cnt2] = 0.0;
+      }
+   }
+   
    //Print what we have just set up.
    cout << "Nocc  = [ ";
    for (int cnt=0; cnt<numberOfIrreps-1; cnt++){ cout << Nocc[cnt] << " , "; }
@@ -25,6 +25,7 @@
 #include <math.h>
 #include <sstream>
 #include <algorithm>
+#include <sys/time.h>
 
 #include "CASSCF.h"
 #include "Lapack.h"
@@ -76,7 +77,14 @@ void CheMPS2::CASSCF::fillRotatedHamAllInMemory(double * temp1, double * temp2){
    
    }
    
-   //Two-body terms --> use eightfold permutation symmetry
+   /*  Two-body terms --> use eightfold permutation symmetry
+       V_ijkl = (ik|jl) is symmetric under i <-> k and under j <-> l. Per irrep block, the indices (i,k) are rotated first for the pairs
+       (j,l) with j <= l only (if irrep2 == irrep4), and afterwards the indices (j,l) are rotated for the pairs (a,c) with a <= c only
+       (if irrep1 == irrep3). This halves the work for each of the two half-transformations. Each quarter transformation is one large
+       dgemm or a threaded loop of dgemms over the pairs.  */
+   double flops = 0.0;
+   struct timeval start, end;
+   gettimeofday(&start, NULL);
    for (int irrep1 = 0; irrep1<numberOfIrreps; irrep1++){
       for (int irrep2 = irrep1; irrep2<numberOfIrreps; irrep2++){
          const int productSymm = SymmInfo.directProd(irrep1,irrep2);
@@ -90,50 +98,283 @@ void CheMPS2::CASSCF::fillRotatedHamAllInMemory(double * temp1, double * temp2){
                int linsize4 = OrbPerIrrep[irrep4];
                
                if ((linsize1>0) && (linsize2>0) && (linsize3>0) && (linsize4>0)){
+               
+                  const bool symm13 = (irrep1 == irrep3);
+                  const bool symm24 = (irrep2 == irrep4);
+                  const int numPairs24 = (symm24) ? (linsize2 * (linsize2 + 1))/2 : linsize2 * linsize4; //pairs (j,l), with j <= l if symm24
+                  const int numPairs13 = (symm13) ? (linsize1 * (linsize1 + 1))/2 : linsize1 * linsize3; //pairs (a,c), with a <= c if symm13
                   
-                  for (int cnt1=0; cnt1<linsize1; cnt1++){
-                     for (int cnt2=0; cnt2<linsize2; cnt2++){
-                        for (int cnt3=0; cnt3<linsize3; cnt3++){
-                           for (int cnt4=0; cnt4<linsize4; cnt4++){
-                              temp1[cnt1 + linsize1 * ( cnt2 + linsize2 * (cnt3 + linsize3 * cnt4) ) ]
-                                = HamOrig->getVmat(jumpsHamOrig[irrep1]+cnt1, jumpsHamOrig[irrep2]+cnt2, jumpsHamOrig[irrep3]+cnt3, jumpsHamOrig[irrep4]+cnt4);
-                           }
+                  //temp1[i + linsize1 * ( k + linsize3 * pair(j,l) )] = V_ijkl
+                  #pragma omp parallel for schedule(static)
+                  for (int pair=0; pair<numPairs24; pair++){
+                     int cnt2, cnt4;
+                     if (symm24){
+                        cnt4 = 0;
+                        while (((cnt4+1)*(cnt4+2))/2 <= pair){ cnt4++; }
+                        cnt2 = pair - (cnt4*(cnt4+1))/2;
+                     } else {
+                        cnt2 = pair % linsize2;
+                        cnt4 = pair / linsize2;
+                     }
+                     double * block = temp1 + linsize1 * linsize3 * pair;
+                     for (int cnt3=0; cnt3<linsize3; cnt3++){
+                        for (int cnt1=0; cnt1<linsize1; cnt1++){
+                           block[cnt1 + linsize1 * cnt3] = HamOrig->getVmat(jumpsHamOrig[irrep1]+cnt1, jumpsHamOrig[irrep2]+cnt2, jumpsHamOrig[irrep3]+cnt3, jumpsHamOrig[irrep4]+cnt4);
                         }
                      }
                   }
                   
-                  char trans = 'T';
                   char notra = 'N';
                   double alpha = 1.0;
                   double beta = 0.0; //SET !!!
                   
-                  int rightdim = linsize2 * linsize3 * linsize4; //(ijkl) -> (ajkl)
+                  //(ijkl) -> (ajkl) : one dgemm
+                  int rightdim = linsize3 * numPairs24;
                   dgemm_(&notra,&notra,&linsize1,&rightdim,&linsize1, &alpha,unitary[irrep1],&linsize1,temp1,&linsize1, &beta,temp2,&linsize1);
                   
-                  int leftdim = linsize1 * linsize2 * linsize3; //(ajkl) -> (ajkd)
-                  dgemm_(&notra,&trans,&leftdim,&linsize4,&linsize4, &alpha,temp2,&leftdim,unitary[irrep4],&linsize4, &beta,temp1,&leftdim);
+                  //(ajkl) -> (ajcl) : one dgemm per pair (j,l)
+                  #pragma omp parallel for schedule(static)
+                  for (int pair=0; pair<numPairs24; pair++){
+                     char trans2 = 'T';
+                     char notra2 = 'N';
+                     double alpha2 = 1.0;
+                     double beta2 = 0.0; //SET !!!
+                     int size1 = linsize1;
+                     int size3 = linsize3;
+                     dgemm_(&notra2,&trans2,&size1,&size3,&size3, &alpha2,temp2+linsize1*linsize3*pair,&size1,unitary[irrep3],&size3, &beta2,temp1+linsize1*linsize3*pair,&size1);
+                  }
+                  flops += 2.0 * linsize1 * linsize3 * numPairs24 * ( linsize1 + linsize3 );
                   
-                  int jump = leftdim; //(ajkd) -> (ajcd)
-                  leftdim = linsize1 * linsize2;
-                  for (int bla=0; bla<linsize4; bla++){
-                     dgemm_(&notra,&trans,&leftdim,&linsize3,&linsize3, &alpha,temp1+jump*bla,&leftdim,unitary[irrep3],&linsize3, &beta,temp2+jump*bla,&leftdim);
+                  //temp2[j + linsize2 * ( l + linsize4 * pair(a,c) )] = sum_ik U_ai U_ck V_ijkl
+                  #pragma omp parallel for schedule(static)
+                  for (int pair=0; pair<numPairs13; pair++){
+                     int cnt1, cnt3;
+                     if (symm13){
+                        cnt3 = 0;
+                        while (((cnt3+1)*(cnt3+2))/2 <= pair){ cnt3++; }
+                        cnt1 = pair - (cnt3*(cnt3+1))/2;
+                     } else {
+                        cnt1 = pair % linsize1;
+                        cnt3 = pair / linsize1;
+                     }
+                     double * block = temp2 + linsize2 * linsize4 * pair;
+                     for (int cnt4=0; cnt4<linsize4; cnt4++){
+                        for (int cnt2=0; cnt2<linsize2; cnt2++){
+                           const bool swap = ((symm24) && (cnt2 > cnt4));
+                           const int pair24 = (symm24) ? ((swap) ? cnt4 + (cnt2*(cnt2+1))/2 : cnt2 + (cnt4*(cnt4+1))/2) : cnt2 + linsize2 * cnt4;
+                           block[cnt2 + linsize2 * cnt4] = temp1[cnt1 + linsize1 * ( cnt3 + linsize3 * pair24 )];
+                        }
+                     }
                   }
                   
-                  jump = leftdim;
-                  rightdim = linsize3*linsize4;
-                  for (int bla=0; bla<rightdim; bla++){
-                     dgemm_(&notra,&trans,&linsize1,&linsize2,&linsize2,&alpha,temp2+jump*bla,&linsize1,unitary[irrep2],&linsize2,&beta,temp1+jump*bla,&linsize1);
+                  //(ajcl) -> (abcl) : one dgemm
+                  rightdim = linsize4 * numPairs13;
+                  dgemm_(&notra,&notra,&linsize2,&rightdim,&linsize2, &alpha,unitary[irrep2],&linsize2,temp2,&linsize2, &beta,temp1,&linsize2);
+                  
+                  //(abcl) -> (abcd) : one dgemm per pair (a,c)
+                  #pragma omp parallel for schedule(static)
+                  for (int pair=0; pair<numPairs13; pair++){
+                     char trans2 = 'T';
+                     char notra2 = 'N';
+                     double alpha2 = 1.0;
+                     double beta2 = 0.0; //SET !!!
+                     int size2 = linsize2;
+                     int size4 = linsize4;
+                     dgemm_(&notra2,&trans2,&size2,&size4,&size4, &alpha2,temp1+linsize2*linsize4*pair,&size2,unitary[irrep4],&size4, &beta2,temp2+linsize2*linsize4*pair,&size2);
                   }
+                  flops += 2.0 * linsize2 * linsize4 * numPairs13 * ( linsize2 + linsize4 );
                   
-                  for (int cnt1=0; cnt1<linsize1; cnt1++){
+                  //Only once per unique matrix element (hamIndex1 <= hamIndex3 is ensured by the pairs (a,c))
+                  #pragma omp parallel for schedule(static)
+                  for (int pair=0; pair<numPairs13; pair++){
+                     int cnt1, cnt3;
+                     if (symm13){
+                        cnt3 = 0;
+                        while (((cnt3+1)*(cnt3+2))/2 <= pair){ cnt3++; }
+                        cnt1 = pair - (cnt3*(cnt3+1))/2;
+                     } else {
+                        cnt1 = pair % linsize1;
+                        cnt3 = pair / linsize1;
+                     }
+                     const int hamIndex1 = jumpsHamOrig[irrep1] + cnt1;
+                     const int hamIndex3 = jumpsHamOrig[irrep3] + cnt3;
+                     double * block = temp2 + linsize2 * linsize4 * pair;
+                     for (int cnt4=0; cnt4<linsize4; cnt4++){
+                        const int hamIndex4 = jumpsHamOrig[irrep4] + cnt4;
+                        for (int cnt2=0; cnt2<linsize2; cnt2++){
+                           const int hamIndex2 = jumpsHamOrig[irrep2] + cnt2;
+                           if ((hamIndex1 <= hamIndex2) && (hamIndex2 <= hamIndex4) && ((hamIndex1 != hamIndex2) || (hamIndex3 <= hamIndex4))){
+                              HamRotated->setVmat(hamIndex1, hamIndex2, hamIndex3, hamIndex4, block[cnt2 + linsize2 * cnt4]);
+                           }
+                        }
+                     }
+                  }
+                  
+               }
+            }
+         }
+      }
+   }
+   gettimeofday(&end, NULL);
+   const double elapsed = (end.tv_sec - start.tv_sec) + 1e-6 * (end.tv_usec - start.tv_usec);
+   cout << "CASSCF :: Rotation of the two-body matrix elements : " << 1e-9 * flops << " GFLOP in " << elapsed << " seconds (" << 1e-9 * flops / elapsed << " GFLOP/s)" << endl;
+
+}
+
+void CheMPS2::CASSCF::fillRotatedHamRestricted(double * temp1, double * temp2){
+
+   //Constant part of the energy
+   HamRotated->setEconst(HamOrig->getEconst());
+   
+   //One-body terms: diagonal in the irreps.
+   int passed = 0;
+   for (int irrep=0; irrep<numberOfIrreps; irrep++){
+   
+      int linsize = OrbPerIrrep[irrep];
+      if (linsize>1){
+         
+         for (int cnt1=0; cnt1<linsize; cnt1++){
+            for (int cnt2=0; cnt2<linsize; cnt2++){
+               temp1[cnt1 + linsize * cnt2] = HamOrig->getTmat(passed+cnt1,passed+cnt2);
+            }
+         }
+         
+         char trans = 'T';
+         char notra = 'N';
+         double alpha = 1.0;
+         double beta = 0.0;
+         dgemm_(&notra,&notra,&linsize,&linsize,&linsize,&alpha,unitary[irrep],&linsize,temp1,&linsize,&beta,temp2,&linsize);
+         dgemm_(&notra,&trans,&linsize,&linsize,&linsize,&alpha,temp2,&linsize,unitary[irrep],&linsize,&beta,temp1,&linsize);
+         
+         for (int cnt1=0; cnt1<linsize; cnt1++){
+            for (int cnt2=cnt1; cnt2<linsize; cnt2++){
+               HamRotated->setTmat(passed+cnt1,passed+cnt2, temp1[cnt1 + linsize * cnt2] ) ;
+            }
+         }
+         
+      }
+      if (linsize==1){ HamRotated->setTmat(passed,passed, HamOrig->getTmat(passed,passed) ); }
+      
+      passed += linsize;
+   
+   }
+   
+   /*  Two-body terms --> only the matrix elements V_abcd = (ac|bd) with at most two virtual indices are needed: for the DMRG
+       Hamiltonian, the Fock matrix, the Q matrices and the Hessian. Per irrep block, they are split into three disjoint parts:
+          A  : a occ or act                               --> order (i,k,j,l), i restricted first
+          B1 : a virt, c occ or act                       --> order (k,i,j,l), k restricted first
+          B2 : a virt, c virt, b and d occ or act         --> order (j,l,i,k), j restricted first
+       The original matrix elements are gathered once per l into a slab, from which the first quarter transformation of each part is
+       done. The first quarter transformations are restricted to the occ and act orbitals, so that the cost is O(N_occ+act * L^4)
+       instead of O(L^5). The other matrix elements of HamRotated are not updated.  */
+   double flops = 0.0;
+   struct timeval start, end;
+   gettimeofday(&start, NULL);
+   for (int irrep1 = 0; irrep1<numberOfIrreps; irrep1++){
+      for (int irrep2 = irrep1; irrep2<numberOfIrreps; irrep2++){
+         const int productSymm = SymmInfo.directProd(irrep1,irrep2);
+         for (int irrep3 = irrep1; irrep3<numberOfIrreps; irrep3++){
+            const int irrep4 = SymmInfo.directProd(productSymm,irrep3);
+            if (irrep4>=irrep2){
+            
+               int linsize1 = OrbPerIrrep[irrep1];
+               int linsize2 = OrbPerIrrep[irrep2];
+               int linsize3 = OrbPerIrrep[irrep3];
+               int linsize4 = OrbPerIrrep[irrep4];
+               int nonvirt1 = Nocc[irrep1] + NDMRG[irrep1];
+               int nonvirt2 = Nocc[irrep2] + NDMRG[irrep2];
+               int nonvirt3 = Nocc[irrep3] + NDMRG[irrep3];
+               int nonvirt4 = Nocc[irrep4] + NDMRG[irrep4];
+               
+               const bool doA  = ((nonvirt1>0) && (linsize2>0) && (linsize3>0) && (linsize4>0));
+               const bool doB1 = ((nonvirt3>0) && (linsize1>nonvirt1) && (linsize2>0) && (linsize4>0));
+               const bool doB2 = ((nonvirt2>0) && (nonvirt4>0) && (linsize1>nonvirt1) && (linsize3>nonvirt3));
+               
+               if ((doA) || (doB1) || (doB2)){
+               
+                  const bool symm13 = (irrep1 == irrep3);
+                  int slabsize = linsize1 * linsize3;
+                  double * workA  = temp1;
+                  double * workB1 = workA  + ((doA)  ? nonvirt1 * linsize3 * linsize2 * linsize4 : 0);
+                  double * workB2 = workB1 + ((doB1) ? nonvirt3 * linsize1 * linsize2 * linsize4 : 0);
+                  
+                  char trans = 'T';
+                  char notra = 'N';
+                  double alpha = 1.0;
+                  double beta = 0.0; //SET !!!
+                  
+                  for (int cnt4=0; cnt4<linsize4; cnt4++){
+                  
+                     //temp2[i + linsize1 * ( k + linsize3 * j )] = V_ijkl
+                     #pragma omp parallel for schedule(static)
                      for (int cnt2=0; cnt2<linsize2; cnt2++){
+                        double * slab = temp2 + slabsize * cnt2;
                         for (int cnt3=0; cnt3<linsize3; cnt3++){
-                           for (int cnt4=0; cnt4<linsize4; cnt4++){
-                              HamRotated->setVmat(jumpsHamOrig[irrep1]+cnt1, jumpsHamOrig[irrep2]+cnt2, jumpsHamOrig[irrep3]+cnt3, jumpsHamOrig[irrep4]+cnt4,
-                                                  temp1[cnt1 + linsize1 * ( cnt2 + linsize2 * (cnt3 + linsize3 * cnt4) ) ] );
+                           for (int cnt1=0; cnt1<((symm13) ? cnt3+1 : linsize1); cnt1++){
+                              slab[cnt1 + linsize1 * cnt3] = HamOrig->getVmat(jumpsHamOrig[irrep1]+cnt1, jumpsHamOrig[irrep2]+cnt2, jumpsHamOrig[irrep3]+cnt3, jumpsHamOrig[irrep4]+cnt4);
                            }
                         }
+                        if (symm13){
+                           for (int cnt3=0; cnt3<linsize3; cnt3++){
+                              for (int cnt1=cnt3+1; cnt1<linsize1; cnt1++){ slab[cnt1 + linsize1 * cnt3] = slab[cnt3 + linsize1 * cnt1]; }
+                           }
+                        }
+                     }
+                     
+                     //workA[a + nonvirt1 * ( k + linsize3 * ( j + linsize2 * l ) )] : one dgemm
+                     if (doA){
+                        int rightdim = linsize3 * linsize2;
+                        dgemm_(&notra,&notra,&nonvirt1,&rightdim,&linsize1, &alpha,unitary[irrep1],&linsize1,temp2,&linsize1, &beta,workA+nonvirt1*rightdim*cnt4,&nonvirt1);
+                     }
+                     
+                     //workB1[c + nonvirt3 * ( i + linsize1 * ( j + linsize2 * l ) )] : one dgemm per j
+                     if (doB1){
+                        #pragma omp parallel for schedule(static)
+                        for (int cnt2=0; cnt2<linsize2; cnt2++){
+                           char trans2 = 'T';
+                           char notra2 = 'N';
+                           double alpha2 = 1.0;
+                           double beta2 = 0.0; //SET !!!
+                           int rows = nonvirt3;
+                           int cols = linsize1;
+                           int inner = linsize3;
+                           dgemm_(&notra2,&trans2,&rows,&cols,&inner, &alpha2,unitary[irrep3],&inner,temp2+slabsize*cnt2,&cols, &beta2,workB1+rows*cols*(cnt2+linsize2*cnt4),&rows);
+                        }
+                     }
+                     
+                     //workB2[b + nonvirt2 * ( l + linsize4 * ( i + linsize1 * k ) )] : one dgemm
+                     if (doB2){
+                        int ldc = nonvirt2 * linsize4;
+                        dgemm_(&notra,&trans,&nonvirt2,&slabsize,&linsize2, &alpha,unitary[irrep2],&linsize2,temp2,&slabsize, &beta,workB2+nonvirt2*cnt4,&ldc);
                      }
+                     
+                  }
+                  
+                  if (doA){
+                     const int irrepsA[] = { irrep1, irrep3, irrep2, irrep4 };
+                     const int posA[]    = { 0, 2, 1, 3 };
+                     const int startA[]  = { 0, 0, 0, 0 };
+                     const int sizeA[]   = { nonvirt1, linsize3, linsize2, linsize4 };
+                     flops += 2.0 * nonvirt1 * linsize1 * linsize3 * linsize2 * linsize4;
+                     flops += rotateTwoBodyPart(irrepsA, posA, startA, sizeA, workA, temp2);
+                  }
+                  
+                  if (doB1){
+                     const int irrepsB1[] = { irrep3, irrep1, irrep2, irrep4 };
+                     const int posB1[]    = { 2, 0, 1, 3 };
+                     const int startB1[]  = { 0, nonvirt1, 0, 0 };
+                     const int sizeB1[]   = { nonvirt3, linsize1 - nonvirt1, linsize2, linsize4 };
+                     flops += 2.0 * nonvirt3 * linsize3 * linsize1 * linsize2 * linsize4;
+                     flops += rotateTwoBodyPart(irrepsB1, posB1, startB1, sizeB1, workB1, temp2);
+                  }
+                  
+                  if (doB2){
+                     const int irrepsB2[] = { irrep2, irrep4, irrep1, irrep3 };
+                     const int posB2[]    = { 1, 3, 0, 2 };
+                     const int startB2[]  = { 0, 0, nonvirt1, nonvirt3 };
+                     const int sizeB2[]   = { nonvirt2, nonvirt4, linsize1 - nonvirt1, linsize3 - nonvirt3 };
+                     flops += 2.0 * nonvirt2 * linsize2 * linsize4 * linsize1 * linsize3;
+                     flops += rotateTwoBodyPart(irrepsB2, posB2, startB2, sizeB2, workB2, temp2);
                   }
                   
                }
@@ -141,6 +382,121 @@ void CheMPS2::CASSCF::fillRotatedHamAllInMemory(double * temp1, double * temp2){
          }
       }
    }
+   gettimeofday(&end, NULL);
+   const double elapsed = (end.tv_sec - start.tv_sec) + 1e-6 * (end.tv_usec - start.tv_usec);
+   cout << "CASSCF :: Rotation of the two-body matrix elements with at most two virtual indices : " << 1e-9 * flops << " GFLOP in " << elapsed << " seconds (" << 1e-9 * flops / elapsed << " GFLOP/s)" << endl;
+
+}
+
+double CheMPS2::CASSCF::rotateTwoBodyPart(const int * irreps, const int * pos, const int * start, const int * size, double * work, double * temp){
+
+   int lin[4];
+   int jump[4];
+   int dim[4];
+   for (int n=0; n<4; n++){
+      lin[n]  = OrbPerIrrep[irreps[n]];
+      jump[n] = jumpsHamOrig[irreps[n]];
+      dim[n]  = size[n];
+   }
+   
+   //temp[q0 + dim0 * ( q1 + dim1 * ( x2 + lin2 * x3 ) )] : one dgemm per (x2,x3)
+   const int numBlocks23 = lin[2] * lin[3];
+   #pragma omp parallel for schedule(static)
+   for (int block=0; block<numBlocks23; block++){
+      char trans2 = 'T';
+      char notra2 = 'N';
+      double alpha2 = 1.0;
+      double beta2 = 0.0; //SET !!!
+      int rows = dim[0];
+      int cols = dim[1];
+      int inner = lin[1];
+      dgemm_(&notra2,&trans2,&rows,&cols,&inner, &alpha2,work+rows*inner*block,&rows,unitary[irreps[1]]+start[1],&inner, &beta2,temp+rows*cols*block,&rows);
+   }
+   
+   //work[q0 + dim0 * ( q1 + dim1 * ( q2 + dim2 * x3 ) )] : one dgemm per x3
+   #pragma omp parallel for schedule(static)
+   for (int x3=0; x3<lin[3]; x3++){
+      char trans2 = 'T';
+      char notra2 = 'N';
+      double alpha2 = 1.0;
+      double beta2 = 0.0; //SET !!!
+      int rows = dim[0] * dim[1];
+      int cols = dim[2];
+      int inner = lin[2];
+      dgemm_(&notra2,&trans2,&rows,&cols,&inner, &alpha2,temp+rows*inner*x3,&rows,unitary[irreps[2]]+start[2],&inner, &beta2,work+rows*cols*x3,&rows);
+   }
+   
+   //temp[q0 + dim0 * ( q1 + dim1 * ( q2 + dim2 * q3 ) )] : one dgemm
+   char trans = 'T';
+   char notra = 'N';
+   double alpha = 1.0;
+   double beta = 0.0; //SET !!!
+   int dim012 = dim[0] * dim[1] * dim[2];
+   dgemm_(&notra,&trans,&dim012,dim+3,lin+3, &alpha,work,&dim012,unitary[irreps[3]]+start[3],lin+3, &beta,temp,&dim012);
+   
+   //Only once per unique matrix element
+   #pragma omp parallel for schedule(static)
+   for (int q3=0; q3<dim[3]; q3++){
+      int index[4];
+      index[pos[3]] = jump[3] + start[3] + q3;
+      for (int q2=0; q2<dim[2]; q2++){
+         index[pos[2]] = jump[2] + start[2] + q2;
+         for (int q1=0; q1<dim[1]; q1++){
+            index[pos[1]] = jump[1] + start[1] + q1;
+            for (int q0=0; q0<dim[0]; q0++){
+               index[pos[0]] = jump[0] + start[0] + q0;
+               if ((index[0] <= index[1]) && (index[0] <= index[2]) && (index[1] <= index[3]) && ((index[0] != index[1]) || (index[2] <= index[3]))){
+                  HamRotated->setVmat(index[0], index[1], index[2], index[3], temp[q0 + dim[0] * ( q1 + dim[1] * ( q2 + dim[2] * q3 ) )]);
+               }
+            }
+         }
+      }
+   }
+   
+   return 2.0 * dim[0] * dim[1] * lin[1] * lin[2] * lin[3]
+        + 2.0 * dim[0] * dim[1] * dim[2] * lin[2] * lin[3]
+        + 2.0 * dim[0] * dim[1] * dim[2] * dim[3] * lin[3];
+
+}
+
+double CheMPS2::CASSCF::rotationFlops(const bool restricted) const{
+
+   double flops = 0.0;
+   for (int irrep1 = 0; irrep1<numberOfIrreps; irrep1++){
+      for (int irrep2 = irrep1; irrep2<numberOfIrreps; irrep2++){
+         const int productSymm = SymmInfo.directProd(irrep1,irrep2);
+         for (int irrep3 = irrep1; irrep3<numberOfIrreps; irrep3++){
+            const int irrep4 = SymmInfo.directProd(productSymm,irrep3);
+            if (irrep4>=irrep2){
+            
+               const double L1 = OrbPerIrrep[irrep1];
+               const double L2 = OrbPerIrrep[irrep2];
+               const double L3 = OrbPerIrrep[irrep3];
+               const double L4 = OrbPerIrrep[irrep4];
+               
+               if (restricted){
+                  //Parts A, B1 and B2 of fillRotatedHamRestricted, with N the number of occ + act orbitals and V the number of virt orbitals
+                  const double N1 = Nocc[irrep1] + NDMRG[irrep1];
+                  const double N2 = Nocc[irrep2] + NDMRG[irrep2];
+                  const double N3 = Nocc[irrep3] + NDMRG[irrep3];
+                  const double N4 = Nocc[irrep4] + NDMRG[irrep4];
+                  const double V1 = L1 - N1;
+                  const double V3 = L3 - N3;
+                  flops += 2.0 * L2 * L4 * N1 * ( L1 * L3 + L3 * L3 + L3 * L2 + L3 * L4 );
+                  if (V1 > 0){ flops += 2.0 * L2 * L4 * N3 * ( L3 * L1 + V1 * L1 + V1 * L2 + V1 * L4 ); }
+                  if ((V1 > 0) && (V3 > 0)){ flops += 2.0 * L1 * L3 * N2 * ( L2 * L4 + N4 * L4 ) + 2.0 * N2 * N4 * L3 * V1 * ( L1 + V3 ); }
+               } else {
+                  //Pairs (j,l) and (a,c) of fillRotatedHamAllInMemory
+                  const double numPairs24 = (irrep2 == irrep4) ? 0.5 * L2 * ( L2 + 1 ) : L2 * L4;
+                  const double numPairs13 = (irrep1 == irrep3) ? 0.5 * L1 * ( L1 + 1 ) : L1 * L3;
+                  flops += 2.0 * L1 * L3 * numPairs24 * ( L1 + L3 ) + 2.0 * L2 * L4 * numPairs13 * ( L2 + L4 );
+               }
+               
+            }
+         }
+      }
+   }
+   return flops;
 
 }
 
@@ -33,6 +33,18 @@ using std::cout;
 using std::endl;
 using std::max;
 
+void CheMPS2::CASSCF::activateWarmStart(const bool warmStartDimsIn, ConvergenceScheme * WarmOptSchemeIn){
+
+   warmStart = true;
+   warmStartDims = warmStartDimsIn;
+   WarmOptScheme = WarmOptSchemeIn;
+
+}
+
+void CheMPS2::CASSCF::setAugmentedHessianMaxMB(const double megabytes){ augHessDenseMaxMB = megabytes; }
+
+void CheMPS2::CASSCF::setRestrictedRotation(const bool allowed){ allowRestrictedRotation = allowed; }
+
 double CheMPS2::CASSCF::doCASSCFnewtonraphson(const int Nelectrons, const int TwoS, const int Irrep, ConvergenceScheme * OptScheme, const int rootNum){
 
    double gradNorm = 1.0;
@@ -45,7 +57,9 @@ double CheMPS2::CASSCF::doCASSCFnewtonraphson(const int Nelectrons, const int Tw
    
    int maxlinsize = 0;
    for (int cnt=0; cnt<numberOfIrreps; cnt++){ if (OrbPerIrrep[cnt] > maxlinsize){ maxlinsize = OrbPerIrrep[cnt]; } }
-   const bool doBlockWise = (maxlinsize <= CheMPS2::CASSCF_maxlinsizeCutoff) ? false : true; //Only if bigger, do we want to work blockwise
+   //Only rotate the matrix elements with at most two virtual indices if that requires fewer flops than the rotation of all of them
+   const bool restrictedRotation = ((allowRestrictedRotation) && (rotationFlops(true) < rotationFlops(false)));
+   const bool doBlockWise = ((restrictedRotation) || (maxlinsize <= CheMPS2::CASSCF_maxlinsizeCutoff)) ? false : true; //Only if bigger, do we want to work blockwise
    int maxBlockSize = maxlinsize;
    if (doBlockWise){
       int factor   = (int) (ceil( (1.0 * maxlinsize) / CheMPS2::CASSCF_maxlinsizeCutoff ) + 0.01);
@@ -55,8 +69,16 @@ double CheMPS2::CASSCF::doCASSCFnewtonraphson(const int Nelectrons, const int Tw
    
    //One array is approx (maxBlockSize/273.0)^4 * 42 GiB --> [maxBlockSize=100 --> 750 MB]
    int maxBSpower4 = maxBlockSize * maxBlockSize * maxBlockSize * maxBlockSize; //Note that 273**4 overfloats the 32 bit integer!!!!!
-   double * mem1 = new double[max( maxBSpower4 , maxlinsize*maxlinsize*3 )]; //Second argument for updateUnitary
-   double * mem2 = new double[max( maxBSpower4 , maxlinsize*maxlinsize*2 )];
+   int mem1size = maxBSpower4;
+   int mem2size = maxBSpower4;
+   if (restrictedRotation){ //Then the arrays are (3 and 1) * max(1, max. # occ + act orb per irrep) * maxlinsize^3
+      int maxNonVirt = 1;
+      for (int cnt=0; cnt<numberOfIrreps; cnt++){ if (Nocc[cnt] + NDMRG[cnt] > maxNonVirt){ maxNonVirt = Nocc[cnt] + NDMRG[cnt]; } }
+      mem2size = maxNonVirt * maxlinsize * maxlinsize * maxlinsize;
+      mem1size = 3 * mem2size;
+   }
+   double * mem1 = new double[max( mem1size , maxlinsize*maxlinsize*3 )]; //Second argument for updateUnitary
+   double * mem2 = new double[max( mem2size , maxlinsize*maxlinsize*2 )];
    double * mem3 = NULL;
    if (doBlockWise){ mem3 = new double[maxBSpower4]; }
    
@@ -68,6 +90,7 @@ double CheMPS2::CASSCF::doCASSCFnewtonraphson(const int Nelectrons, const int Tw
    
    }
 
+   DMRG * previousDMRG = NULL; //Only kept when warmStart
    while (gradNorm > CheMPS2::CASSCF_gradientNormThreshold){
    
       //Update the unitary transformations based on the previous unitary transformation and the xmatrix
@@ -76,14 +99,21 @@ double CheMPS2::CASSCF::doCASSCFnewtonraphson(const int Nelectrons, const int Tw
       if ((CheMPS2::CASSCF_storeUnitary) && (gradNorm!=1.0)){ saveU(); }
    
       //Setup rotated Hamiltonian matrix elements based on unitary transformations
-      if (doBlockWise){ fillRotatedHamInMemoryBlockWise(mem1, mem2, mem3, maxBlockSize); }
-      else{             fillRotatedHamAllInMemory(mem1, mem2); }
+      if (restrictedRotation){ fillRotatedHamRestricted(mem1, mem2); }
+      else if (doBlockWise){   fillRotatedHamInMemoryBlockWise(mem1, mem2, mem3, maxBlockSize); }
+      else{                    fillRotatedHamAllInMemory(mem1, mem2); }
    
       //Fill HamDMRG based on the HamRotated
       fillHamDMRG(HamDMRG);
       
       //Do the DMRG sweeps, and calculate the 2DM
-      DMRG * theDMRG = new DMRG(Prob,OptScheme);
+      DMRG * theDMRG = NULL;
+      if (previousDMRG==NULL){ theDMRG = new DMRG(Prob,OptScheme); }
+      else {
+         theDMRG = new DMRG(Prob, (WarmOptScheme==NULL) ? OptScheme : WarmOptScheme, previousDMRG, warmStartDims);
+         delete previousDMRG;
+         previousDMRG = NULL;
+      }
       Energy = theDMRG->Solve();
       if (rootNum>1){
          theDMRG->activateExcitations(rootNum-1);
@@ -94,23 +124,31 @@ double CheMPS2::CASSCF::doCASSCFnewtonraphson(const int Nelectrons, const int Tw
       }
       theDMRG->calc2DM();
       theDMRG2DM = theDMRG->get2DM();
+      if (CheMPS2::CASSCF_store2DM){ theDMRG2DM->save(CheMPS2::CASSCF_2DMstorageName); }
       //theDMRG2DM->print2DMAandB_HAM();
       setDMRG1DM(N);
+      setDMRG2DM();
       calcNOON();
       
       if (CheMPS2::CASSCF_debugPrint){ check1DMand2DMrotated(Nelectrons); }
       
       buildFmat(); //Needs to be updated before the Fmat and Wmat functions
+      buildQmat(); //Needs to be updated before the Wmat function
       //gradNorm = updateXmatrixNewtonRaphson();
       gradNorm = updateXmatrixAugmentedHessianNR();
       
       //PrintCoeff_C2(theDMRG); //Print coeff for C2 to discern (for 1Ag) ^1Sigma_g^+ <--> ^1Delta_g   &   (for 3B1u) ^3Sigma_u^+ <--> ^3Delta_u
       
       if (CheMPS2::DMRG_storeMpsOnDisk){        theDMRG->deleteStoredMPS();       }
-      if (CheMPS2::DMRG_storeRenormOptrOnDisk){ theDMRG->deleteStoredOperators(); }
-      delete theDMRG;
+      if ((CheMPS2::DMRG_storeRenormOptrOnDisk) && (!CheMPS2::DMRG_mapRenormOptrOnDisk)){ theDMRG->deleteStoredOperators(); }
+      if (warmStart){ //Only the MPS is needed as guess for the next macro-iteration
+         theDMRG->deleteOperators();
+         previousDMRG = theDMRG;
+      }
+      else { delete theDMRG; }
    
    }
+   if (previousDMRG!=NULL){ delete previousDMRG; }
    
    delete [] mem1;
    delete [] mem2;
@@ -129,6 +167,20 @@ double CheMPS2::CASSCF::updateXmatrixAugmentedHessianNR(){
    double * gradient = new double[x_linearlength];
    double gradNorm = calcGradient(gradient);
    
+   //When the augmented Hessian and its workspace (2 x (n+1)^2 doubles) do not fit in the memory budget, or overflow the LAPACK int, it is solved iteratively with Hessian-vector products
+   const double denseMB = 2.0 * sizeof(double) * (x_linearlength + 1.0) * (x_linearlength + 1.0) / 1048576.0;
+   if ((denseMB > augHessDenseMaxMB) || (x_linearlength >= 46340)){
+      double * augVector = new double[x_linearlength+1];
+      solveAugmentedHessianDavidson(gradient, augVector);
+      double scalar = 1.0/augVector[x_linearlength];
+      int inc = 1;
+      dscal_(&x_linearlength,&scalar,augVector,&inc);
+      copyXsolutionBack(augVector);
+      delete [] augVector;
+      delete [] gradient;
+      return gradNorm;
+   }
+   
    //Calculate the Hessian
    int aug_linlength = x_linearlength+1;
    int size = aug_linlength * aug_linlength;
@@ -241,43 +293,230 @@ double CheMPS2::CASSCF::calcGradient(double * gradient){
 
 void CheMPS2::CASSCF::calcHessian(double * hessian, const int rowjump){
 
-   const int lindim = (x_linearlength * (x_linearlength + 1))/2;
+   //Column col fills the elements (row <= col) of column col and row col; the columns become longer, hence the dynamic schedule
+   #pragma omp parallel for schedule(dynamic)
+   for (int col=0; col<x_linearlength; col++){
+      for (int row=0; row<=col; row++){
+         hessian[row + rowjump * col] = Hmat(row, col);
+         hessian[col + rowjump * row] = hessian[row + rowjump * col];
+      }
+   }
+
+}
+
+double CheMPS2::CASSCF::Hmat(const int row, const int col) const{
+
+   const int p_index = x_firstindex[row];
+   const int q_index = x_secondindex[row];
+   const int r_index = x_firstindex[col];
+   const int s_index = x_secondindex[col];
+   return Wmat(p_index,q_index,r_index,s_index)
+        - Wmat(q_index,p_index,r_index,s_index)
+        - Wmat(p_index,q_index,s_index,r_index)
+        + Wmat(q_index,p_index,s_index,r_index);
+
+}
+
+void CheMPS2::CASSCF::calcHessianVectorProduct(double * vector, double * result){
+
+   for (int row=0; row<x_linearlength; row++){ result[row] = 0.0; }
    
+   //As in calcHessian, only the upper triangle (row <= col) is calculated, and it is used for both triangles
+   #pragma omp parallel
+   {
+      double * partial = new double[x_linearlength];
+      for (int row=0; row<x_linearlength; row++){ partial[row] = 0.0; }
+      
+      #pragma omp for schedule(dynamic)
+      for (int col=0; col<x_linearlength; col++){
+         for (int row=0; row<col; row++){
+            const double element = Hmat(row, col);
+            partial[row] += element * vector[col];
+            partial[col] += element * vector[row];
+         }
+         partial[col] += Hmat(col, col) * vector[col];
+      }
+      
+      #pragma omp critical
+      {
+         for (int row=0; row<x_linearlength; row++){ result[row] += partial[row]; }
+      }
+      
+      delete [] partial;
+   }
+
+}
+
+void CheMPS2::CASSCF::solveAugmentedHessianDavidson(double * gradient, double * augVector){
+
+   int xlength = x_linearlength;
+   int auglength = x_linearlength + 1;
+   int inc = 1;
+   const int maxVec = CheMPS2::CASSCF_augHessNumVec;
+   int numKeep = CheMPS2::CASSCF_augHessNumVecKeep;
+   int keep_size = auglength * numKeep;
+   
+   //Diagonal of the augmented Hessian, for the preconditioner
+   double * diag = new double[auglength];
    #pragma omp parallel for schedule(static)
-   for (int count=0; count<lindim; count++){
+   for (int cnt=0; cnt<x_linearlength; cnt++){ diag[cnt] = Hmat(cnt, cnt); }
+   diag[x_linearlength] = 0.0;
+   
+   //The Davidson vectors, the augmented Hessian times these vectors, and the projected augmented Hessian
+   double * vecs  = new double[auglength * maxVec];
+   double * Avecs = new double[auglength * maxVec];
+   double * mxM = new double[maxVec * maxVec];
+   double * mxM_vecs = new double[maxVec * maxVec];
+   double * mxM_eigs = new double[maxVec];
+   int mxM_lwork = 3 * maxVec - 1;
+   double * mxM_work = new double[mxM_lwork];
+   double * t_vec = new double[auglength];
+   double * r_vec = new double[auglength];
+   double * keep_vecs = new double[auglength * numKeep];
+   
+   //Start from the unit vector of the gradient row: the rescaled eigenvector has a one there
+   for (int cnt=0; cnt<auglength; cnt++){ t_vec[cnt] = 0.0; }
+   t_vec[x_linearlength] = 1.0;
+   
+   int num_vec = 0;
+   int num_iter = 0;
+   bool converged = false;
+   double rnorm = 0.0;
+   while ((!converged) && (num_iter < CheMPS2::CASSCF_augHessMaxIter)){
+   
+      //Orthonormalize t_vec with respect to the Davidson vectors (twice, for numerical stability)
+      double alpha = 1.0/sqrt(ddot_(&auglength, t_vec, &inc, t_vec, &inc));
+      dscal_(&auglength, &alpha, t_vec, &inc);
+      for (int pass=0; pass<2; pass++){
+         for (int vec=0; vec<num_vec; vec++){
+            double overlap = - ddot_(&auglength, vecs + auglength * vec, &inc, t_vec, &inc);
+            daxpy_(&auglength, &overlap, vecs + auglength * vec, &inc, t_vec, &inc);
+         }
+      }
+      const double tnorm = sqrt(ddot_(&auglength, t_vec, &inc, t_vec, &inc));
+      if (!(tnorm > 1e-10)){ break; } //No new direction left: augVector is the best solution in the Davidson space
+      alpha = 1.0/tnorm;
+      dscal_(&auglength, &alpha, t_vec, &inc);
+      
+      //Add it to the Davidson space, together with the augmented Hessian times t_vec
+      double * new_vec  = vecs  + auglength * num_vec;
+      double * new_Avec = Avecs + auglength * num_vec;
+      dcopy_(&auglength, t_vec, &inc, new_vec, &inc);
+      calcHessianVectorProduct(new_vec, new_Avec);
+      daxpy_(&xlength, new_vec + x_linearlength, gradient, &inc, new_Avec, &inc);
+      new_Avec[x_linearlength] = ddot_(&xlength, gradient, &inc, new_vec, &inc);
+      for (int vec=0; vec<=num_vec; vec++){
+         mxM[vec + maxVec * num_vec] = ddot_(&auglength, vecs + auglength * vec, &inc, new_Avec, &inc);
+         mxM[num_vec + maxVec * vec] = mxM[vec + maxVec * num_vec];
+      }
+      num_vec++;
+      num_iter++;
+      
+      //Lowest eigenpair of the projected augmented Hessian
+      for (int cnt=0; cnt<maxVec * num_vec; cnt++){ mxM_vecs[cnt] = mxM[cnt]; }
+      char jobz = 'V';
+      char uplo = 'U';
+      int info;
+      int lda = maxVec;
+      dsyev_(&jobz, &uplo, &num_vec, mxM_vecs, &lda, mxM_eigs, mxM_work, &mxM_lwork, &info); //ascending order of eigs
+      double theta = mxM_eigs[0];
+      
+      //augVector = vecs * y and r_vec = Avecs * y - theta * augVector
+      char notr = 'N';
+      double one = 1.0;
+      double zero = 0.0;
+      dgemv_(&notr, &auglength, &num_vec, &one, vecs,  &auglength, mxM_vecs, &inc, &zero, augVector, &inc);
+      dgemv_(&notr, &auglength, &num_vec, &one, Avecs, &auglength, mxM_vecs, &inc, &zero, r_vec, &inc);
+      double mintheta = -theta;
+      daxpy_(&auglength, &mintheta, augVector, &inc, r_vec, &inc);
+      rnorm = sqrt(ddot_(&auglength, r_vec, &inc, r_vec, &inc));
+      if (rnorm < CheMPS2::CASSCF_augHessRTOL){ converged = true; }
+      else {
+      
+         //Restart with the lowest numKeep Ritz vectors when the Davidson space is full
+         if (num_vec == maxVec){
+            dgemm_(&notr, &notr, &auglength, &numKeep, &num_vec, &one, vecs, &auglength, mxM_vecs, &lda, &zero, keep_vecs, &auglength);
+            dcopy_(&keep_size, keep_vecs, &inc, vecs, &inc);
+            dgemm_(&notr, &notr, &auglength, &numKeep, &num_vec, &one, Avecs, &auglength, mxM_vecs, &lda, &zero, keep_vecs, &auglength);
+            dcopy_(&keep_size, keep_vecs, &inc, Avecs, &inc);
+            for (int row=0; row<numKeep; row++){
+               for (int col=0; col<numKeep; col++){ mxM[row + maxVec * col] = ((row==col) ? mxM_eigs[row] : 0.0); }
+            }
+            num_vec = numKeep;
+         }
+         
+         //Diagonal preconditioner for the new correction vector
+         for (int cnt=0; cnt<auglength; cnt++){
+            const double denom = diag[cnt] - theta;
+            t_vec[cnt] = - r_vec[cnt] / ((fabs(denom) > CheMPS2::HEFF_DAVIDSON_PRECOND_CUTOFF) ? denom : CheMPS2::HEFF_DAVIDSON_PRECOND_CUTOFF);
+         }
+         
+      }
+   
+   }
    
-      int col = 1;
-      while ( (col*(col+1))/2 <= count ) col++;
-      col -= 1;
-      int row = count - (col*(col+1))/2;
+   if (CheMPS2::CASSCF_debugPrint){
+      cout << "Augmented Hessian Davidson : " << num_iter << " iterations, lowest eigenvalue = " << mxM_eigs[0] << " and residual norm = " << rnorm << endl;
+   }
+   if (!converged){
+      cout << "CASSCF::solveAugmentedHessianDavidson : residual norm " << rnorm << " after " << num_iter << " iterations." << endl;
+   }
+   
+   delete [] diag;
+   delete [] vecs;
+   delete [] Avecs;
+   delete [] mxM;
+   delete [] mxM_vecs;
+   delete [] mxM_eigs;
+   delete [] mxM_work;
+   delete [] t_vec;
+   delete [] r_vec;
+   delete [] keep_vecs;
+
+}
+
+void CheMPS2::CASSCF::buildQmat(){
+
+   for (int irrep=0; irrep<numberOfIrreps; irrep++){
+   
+      const int nOrbitals = OrbPerIrrep[irrep];
       
-      int p_index = x_firstindex[row];
-      int q_index = x_secondindex[row];
-      int r_index = x_firstindex[col];
-      int s_index = x_secondindex[col];
-      hessian[row + rowjump * col] = Wmat(p_index,q_index,r_index,s_index)
-                                   - Wmat(q_index,p_index,r_index,s_index)
-                                   - Wmat(p_index,q_index,s_index,r_index)
-                                   + Wmat(q_index,p_index,s_index,r_index);
-      hessian[col + rowjump * row] = hessian[row + rowjump * col];
+      #pragma omp parallel for schedule(static)
+      for (int cnt=0; cnt<nOrbitals*nOrbitals; cnt++){
       
+         const int p_index = jumpsHamOrig[irrep] + cnt % nOrbitals;
+         const int q_index = jumpsHamOrig[irrep] + cnt / nOrbitals;
+         
+         double valueOcc = 0.0;
+         double valueAct = 0.0;
+         for (int irrep_ab=0; irrep_ab<numberOfIrreps; irrep_ab++){
+            for (int alpha_index=jumpsHamOrig[irrep_ab]; alpha_index<jumpsHamOrig[irrep_ab]+Nocc[irrep_ab]; alpha_index++){ //alpha occ
+               valueOcc += 2 * HamRotated->getVmat(p_index,alpha_index,q_index,alpha_index) - HamRotated->getVmat(p_index,q_index,alpha_index,alpha_index);
+            }
+            for (int alpha_index=jumpsHamOrig[irrep_ab]+Nocc[irrep_ab]; alpha_index<jumpsHamOrig[irrep_ab+1]-Nvirt[irrep_ab]; alpha_index++){ //alpha act
+               for (int beta_index=jumpsHamOrig[irrep_ab]+Nocc[irrep_ab]; beta_index<jumpsHamOrig[irrep_ab+1]-Nvirt[irrep_ab]; beta_index++){ //beta act
+                  valueAct += DMRG1DM[DMRGindexOfOrbital[alpha_index] + nOrbDMRG * DMRGindexOfOrbital[beta_index]]
+                            * ( 2 * HamRotated->getVmat(p_index,alpha_index,q_index,beta_index) - HamRotated->getVmat(p_index,q_index,alpha_index,beta_index) );
+               }
+            }
+         }
+         QmatOcc[irrep][cnt] = valueOcc;
+         QmatAct[irrep][cnt] = valueAct;
+      
+      }
    }
 
 }
 
 double CheMPS2::CASSCF::Wmat(const int index1, const int index2, const int index3, const int index4) const{
 
-   int irrep1 = 0;
-   while (index1 >= jumpsHamOrig[irrep1+1]){ irrep1++; }
-   int irrep2 = 0;
-   while (index2 >= jumpsHamOrig[irrep2+1]){ irrep2++; }
+   const int irrep1 = HamOrig->getOrbitalIrrep(index1);
+   const int irrep2 = HamOrig->getOrbitalIrrep(index2);
    
    if (irrep1 != irrep2){ return 0.0; } //From now on: irrep1 == irrep2
    
-   int irrep3 = 0;
-   while (index3 >= jumpsHamOrig[irrep3+1]){ irrep3++; }
-   int irrep4 = 0;
-   while (index4 >= jumpsHamOrig[irrep4+1]){ irrep4++; }
+   const int irrep3 = HamOrig->getOrbitalIrrep(index3);
+   const int irrep4 = HamOrig->getOrbitalIrrep(index4);
    
    if (irrep3 != irrep4){ return 0.0; } //From now on: irrep3 == irrep4
    
@@ -288,8 +527,8 @@ double CheMPS2::CASSCF::Wmat(const int index1, const int index2, const int index
       if (index2 == index3){ value += Fmat(index1,index4) + Fmat(index4,index1); }
    }
    
-   if (index1 > jumpsHamOrig[irrep1] + Nocc[irrep1] + NDMRG[irrep1]){ return value; }
-   if (index3 > jumpsHamOrig[irrep3] + Nocc[irrep3] + NDMRG[irrep3]){ return value; } //index1 and index3 are now certainly not virtual!
+   if (index1 >= jumpsHamOrig[irrep1] + Nocc[irrep1] + NDMRG[irrep1]){ return value; }
+   if (index3 >= jumpsHamOrig[irrep3] + Nocc[irrep3] + NDMRG[irrep3]){ return value; } //index1 and index3 are now certainly not virtual!
    
    if (index1 < jumpsHamOrig[irrep1] + Nocc[irrep1]){
       if (index3 < jumpsHamOrig[irrep3] + Nocc[irrep3]){
@@ -297,27 +536,14 @@ double CheMPS2::CASSCF::Wmat(const int index1, const int index2, const int index
          // (index1,index3) (occupied,occupied) --> (alpha,beta) can be (occupied,occupied) or (active,active)
          if (index1==index3){
          
+            const int Qindex = index2 - jumpsHamOrig[irrep2] + OrbPerIrrep[irrep2] * ( index4 - jumpsHamOrig[irrep4] );
+         
             // Case1: (alpha,beta) is (active,active) --> index1 == index3 needed to return a non-zero element
-            for (int irrep_ab=0; irrep_ab<numberOfIrreps; irrep_ab++){
-               for (int alpha_index=jumpsHamOrig[irrep_ab]+Nocc[irrep_ab]; alpha_index<jumpsHamOrig[irrep_ab+1]-Nvirt[irrep_ab]; alpha_index++){ //alpha act
-                  for (int beta_index=jumpsHamOrig[irrep_ab]+Nocc[irrep_ab]; beta_index<jumpsHamOrig[irrep_ab+1]-Nvirt[irrep_ab]; beta_index++){ //beta act
-                     value += 2 * get1DMrotated(alpha_index,beta_index) * ( 2 * HamRotated->getVmat(index2,alpha_index,index4,beta_index)
-                                                                              - HamRotated->getVmat(index2,index4,alpha_index,beta_index) );
-                  }
-               }
-            }
+            value += 2 * QmatAct[irrep2][Qindex];
             
             // Case2: (alpha,beta) is (occupied,occupied)
-            // Case2a: (index1==index3) and (alpha==beta)
-            for (int irrep_ab=0; irrep_ab<numberOfIrreps; irrep_ab++){
-               for (int alpha_index=jumpsHamOrig[irrep_ab]; alpha_index<jumpsHamOrig[irrep_ab]+Nocc[irrep_ab]; alpha_index++){
-                  if (index1 == alpha_index){
-                     value += 4 * HamRotated->getVmat(index2,alpha_index,index4,alpha_index) + 4 * HamRotated->getVmat(index2,index4,alpha_index,alpha_index);
-                  } else {
-                     value += 8 * HamRotated->getVmat(index2,alpha_index,index4,alpha_index) - 4 * HamRotated->getVmat(index2,index4,alpha_index,alpha_index);
-                  }
-               }
-            }
+            // Case2a: (index1==index3) and (alpha==beta); alpha == index1 contributes 4 * V(index2,alpha,index4,alpha) + 4 * V(index2,index4,alpha,alpha)
+            value += 4 * QmatOcc[irrep2][Qindex] - 4 * HamRotated->getVmat(index2,index1,index4,index1) + 8 * HamRotated->getVmat(index2,index4,index1,index1);
             
             // Case2b: (index1==index3); some element :-)
             value += 4 * HamRotated->getVmat(index2,index4,index1,index3);
@@ -334,10 +560,11 @@ double CheMPS2::CASSCF::Wmat(const int index1, const int index2, const int index
       } else {
       
          // (index1,index3) (occupied,active) --> (alpha,beta) can be (active,occupied) or (occupied,active)
+         const double * OneDMrow = DMRG1DM + nOrbDMRG * DMRGindexOfOrbital[index3];
          for (int alpha_index=jumpsHamOrig[irrep3]+Nocc[irrep3]; alpha_index<jumpsHamOrig[irrep3+1]-Nvirt[irrep3]; alpha_index++){
-            value += 2 * get1DMrotated(index3,alpha_index) * ( 4 * HamRotated->getVmat(index2,index4,index1,alpha_index) 
-                                                                 - HamRotated->getVmat(index2,index4,alpha_index,index1) 
-                                                                 - HamRotated->getVmat(index2,index1,index4,alpha_index) );
+            value += 2 * OneDMrow[DMRGindexOfOrbital[alpha_index]] * ( 4 * HamRotated->getVmat(index2,index4,index1,alpha_index) 
+                                                                       - HamRotated->getVmat(index2,index4,alpha_index,index1) 
+                                                                       - HamRotated->getVmat(index2,index1,index4,alpha_index) );
          }
          
       }
@@ -345,32 +572,35 @@ double CheMPS2::CASSCF::Wmat(const int index1, const int index2, const int index
       if (index3 < jumpsHamOrig[irrep3] + Nocc[irrep3]){
       
          // (index1,index3) (active,occupied) --> (alpha,beta) can be (active,occupied) or (occupied,active)
+         const double * OneDMrow = DMRG1DM + nOrbDMRG * DMRGindexOfOrbital[index1];
          for (int alpha_index=jumpsHamOrig[irrep1]+Nocc[irrep1]; alpha_index<jumpsHamOrig[irrep1+1]-Nvirt[irrep1]; alpha_index++){
-            value += 2 * get1DMrotated(index1,alpha_index) * ( 4 * HamRotated->getVmat(index2,index4,alpha_index,index3) 
-                                                                 - HamRotated->getVmat(index2,alpha_index,index4,index3) 
-                                                                 - HamRotated->getVmat(index2,index4,index3,alpha_index) );
+            value += 2 * OneDMrow[DMRGindexOfOrbital[alpha_index]] * ( 4 * HamRotated->getVmat(index2,index4,alpha_index,index3) 
+                                                                       - HamRotated->getVmat(index2,alpha_index,index4,index3) 
+                                                                       - HamRotated->getVmat(index2,index4,index3,alpha_index) );
          }
          
       } else {
       
          // (index1,index3) (active,active) --> (alpha,beta) can be (occupied,occupied) or (active,active)
          // Case1: (alpha,beta)==(occ,occ) --> alpha == beta
-         double sum = 0.0;
-         for (int irrep_alpha=0; irrep_alpha<numberOfIrreps; irrep_alpha++){
-            for (int alpha_index=jumpsHamOrig[irrep_alpha]; alpha_index<jumpsHamOrig[irrep_alpha]+Nocc[irrep_alpha]; alpha_index++){
-               sum += 2 * HamRotated->getVmat(index2,alpha_index,index4,alpha_index) - HamRotated->getVmat(index2,index4,alpha_index,alpha_index);
-            }
+         if (irrep1 == irrep3){ //Otherwise the 1DM element is zero
+            const int Qindex = index2 - jumpsHamOrig[irrep2] + OrbPerIrrep[irrep2] * ( index4 - jumpsHamOrig[irrep4] );
+            value += QmatOcc[irrep2][Qindex] * 2 * DMRG1DM[DMRGindexOfOrbital[index1] + nOrbDMRG * DMRGindexOfOrbital[index3]];
          }
-         value += sum * 2 * get1DMrotated(index1,index3);
          
          // Case2: (alpha,beta)==(act,act)
+         const int DMRGindex1 = DMRGindexOfOrbital[index1];
+         const int DMRGindex3 = DMRGindexOfOrbital[index3];
          const int productIrrep = SymmInfo.directProd(irrep1,irrep3);
          for (int irrep_alpha=0; irrep_alpha<numberOfIrreps; irrep_alpha++){
             int irrep_beta = SymmInfo.directProd(productIrrep,irrep_alpha);
             for (int alpha_index=jumpsHamOrig[irrep_alpha]+Nocc[irrep_alpha]; alpha_index<jumpsHamOrig[irrep_alpha+1]-Nvirt[irrep_alpha]; alpha_index++){
+               const int DMRGalpha = DMRGindexOfOrbital[alpha_index];
                for (int beta_index=jumpsHamOrig[irrep_beta]+Nocc[irrep_beta]; beta_index<jumpsHamOrig[irrep_beta+1]-Nvirt[irrep_beta]; beta_index++){
-                  value += 2 * (   get2DMrotated(index3,alpha_index,index1,beta_index) * HamRotated->getVmat(index2,alpha_index,index4,beta_index)
-                               + ( get2DMrotated(index3,alpha_index,beta_index,index1) + get2DMrotated(index3,index1,beta_index,alpha_index) ) 
+                  const int DMRGbeta = DMRGindexOfOrbital[beta_index];
+                  value += 2 * (   DMRG2DM[DMRGindex3 + nOrbDMRG * ( DMRGalpha + nOrbDMRG * ( DMRGindex1 + nOrbDMRG * DMRGbeta ) )] * HamRotated->getVmat(index2,alpha_index,index4,beta_index)
+                               + ( DMRG2DM[DMRGindex3 + nOrbDMRG * ( DMRGalpha + nOrbDMRG * ( DMRGbeta + nOrbDMRG * DMRGindex1 ) )]
+                                 + DMRG2DM[DMRGindex3 + nOrbDMRG * ( DMRGindex1 + nOrbDMRG * ( DMRGbeta + nOrbDMRG * DMRGalpha ) )] )
                                * HamRotated->getVmat(index2,index4,alpha_index,beta_index) );
                }
             }
@@ -467,14 +697,16 @@ double CheMPS2::CASSCF::FmatHelper(const int index1, const int index2) const{
       }
       
       //All the summation indices are active
+      const int DMRGindex1 = DMRGindexOfOrbital[index1];
       for (int irrep_r=0; irrep_r<numberOfIrreps; irrep_r++){
          const int productIrrep = SymmInfo.directProd(irrep1,irrep_r);
          for (int irrep_s=0; irrep_s<numberOfIrreps; irrep_s++){
             int irrep_t = SymmInfo.directProd(productIrrep,irrep_s);
             for (int r_index=jumpsHamOrig[irrep_r]+Nocc[irrep_r]; r_index<jumpsHamOrig[irrep_r+1]-Nvirt[irrep_r]; r_index++){
                for (int s_index=jumpsHamOrig[irrep_s]+Nocc[irrep_s]; s_index<jumpsHamOrig[irrep_s+1]-Nvirt[irrep_s]; s_index++){
+                  const double * TwoDMrow = DMRG2DM + DMRGindex1 + nOrbDMRG * ( DMRGindexOfOrbital[r_index] + nOrbDMRG * ( DMRGindexOfOrbital[s_index] ) );
                   for (int t_index=jumpsHamOrig[irrep_t]+Nocc[irrep_t]; t_index<jumpsHamOrig[irrep_t+1]-Nvirt[irrep_t]; t_index++){
-                     value += get2DMrotated(index1, r_index, s_index, t_index) * HamRotated->getVmat(index2, r_index, s_index, t_index);
+                     value += TwoDMrow[nOrbDMRG * nOrbDMRG * nOrbDMRG * DMRGindexOfOrbital[t_index]] * HamRotated->getVmat(index2, r_index, s_index, t_index);
                   }
                }
             }
@@ -34,6 +34,8 @@ CheMPS2::ConvergenceScheme::ConvergenceScheme(const int nInstructions){
       fEconv          = new double[nInstructions];
       nMaxSweeps      = new int[   nInstructions];
       fNoisePrefactor = new double[nInstructions];
+      davidsonOptions = new DavidsonOptions*[nInstructions];
+      for (int instruction=0; instruction<nInstructions; instruction++){ davidsonOptions[instruction] = NULL; }
    } else {
       cerr << "CheMPS2::ConvergenceScheme::ConvergenceScheme  ::  The number of desired instructions was " << nInstructions << endl;
    }
@@ -46,6 +48,7 @@ CheMPS2::ConvergenceScheme::~ConvergenceScheme(){
    delete [] fEconv;
    delete [] nMaxSweeps;
    delete [] fNoisePrefactor;
+   delete [] davidsonOptions;
 
 }
 
@@ -80,4 +83,16 @@ int CheMPS2::ConvergenceScheme::getMaxSweeps(const int instruction){ return nMax
 
 double CheMPS2::ConvergenceScheme::getNoisePrefactor(const int instruction){ return fNoisePrefactor[instruction]; }
 
+void CheMPS2::ConvergenceScheme::setDavidsonOptions(const int instruction, DavidsonOptions * options){
+
+   if ((instruction < 0) || (instruction >= nInstructions)){
+      cerr << "CheMPS2::ConvergenceScheme::setDavidsonOptions  ::  The instruction number was " << instruction << "/" << nInstructions << endl;
+      return;
+   }
+   
+   davidsonOptions[instruction] = options;
+
+}
+
+CheMPS2::DavidsonOptions * CheMPS2::ConvergenceScheme::getDavidsonOptions(const int instruction){ return davidsonOptions[instruction]; }
 
@@ -27,13 +27,20 @@
 #include <string.h>
 #include <sstream>
 #include <sys/stat.h>
+#include <sys/time.h>
 
 #include "DMRG.h"
+#include "ScratchArena.h"
+#include "Wigner.h"
 
 using std::cout;
 using std::endl;
 
-CheMPS2::DMRG::DMRG(Problem * Probin, ConvergenceScheme * OptSchemeIn){
+CheMPS2::DMRG::DMRG(Problem * Probin, ConvergenceScheme * OptSchemeIn){ initialize(Probin, OptSchemeIn, NULL, false); }
+
+CheMPS2::DMRG::DMRG(Problem * Probin, ConvergenceScheme * OptSchemeIn, DMRG * guess, const bool guessDims){ initialize(Probin, OptSchemeIn, guess, guessDims); }
+
+void CheMPS2::DMRG::initialize(Problem * Probin, ConvergenceScheme * OptSchemeIn, DMRG * guess, const bool guessDims){
 
    PrintLicense();
 
@@ -44,6 +51,7 @@ CheMPS2::DMRG::DMRG(Problem * Probin, ConvergenceScheme * OptSchemeIn){
       Prob = NULL;
    }
 
+   Prob->construct(); //The Hamiltonian may have changed since the Problem was created
    OptScheme = OptSchemeIn;
    RNstorage = rand();
    nStates = 1;
@@ -63,10 +71,30 @@ CheMPS2::DMRG::DMRG(Problem * Probin, ConvergenceScheme * OptSchemeIn){
    
    for (int cnt=0; cnt<Prob->gL()-1; cnt++){ isAllocated[cnt] = 0; }
    
+   DavidsonMatvecs = new int[Prob->gL()-1];
+   DavidsonTime = new double[Prob->gL()-1];
+   for (int cnt=0; cnt<Prob->gL()-1; cnt++){
+      DavidsonMatvecs[cnt] = 0;
+      DavidsonTime[cnt] = 0.0;
+   }
+   SweepsLastSolve = 0;
+   
    the2DMallocated = false;
    Exc_activated = false;
+   SA_activated = false;
    
+   ScratchRequestsStart = ScratchArena::gNumRequests();
+   ScratchAllocationsStart = ScratchArena::gNumAllocations();
+   operatorFile = -1;
+   IOcompression = CheMPS2::DMRG_operatorCompression;
+   IOstoreOnDisk = CheMPS2::DMRG_storeRenormOptrOnDisk;
+   mapActive = CheMPS2::DMRG_mapRenormOptrOnDisk;
+   IOasync = CheMPS2::DMRG_asyncOperatorIO;
+   startOperatorMap();
+   startOperatorPool();
+   startOperatorIO();
    setupBookkeeperAndMPS();
+   if (guess!=NULL){ copyMPS(guess, guessDims); }
    PreSolve();
 
 }
@@ -84,6 +112,17 @@ void CheMPS2::DMRG::setupBookkeeperAndMPS(){
       denBK = NULL; //Now all the rest will fail too.
    }
    
+   //The tables of the Wigner symbols are sized from the largest virtual spin
+   if (denBK!=NULL){
+      int maxTwoS = 0;
+      for (int bound=0; bound<=Prob->gL(); bound++){
+         for (int N=denBK->gNmin(bound); N<=denBK->gNmax(bound); N++){
+            if (denBK->gTwoSmax(bound,N) > maxTwoS){ maxTwoS = denBK->gTwoSmax(bound,N); }
+         }
+      }
+      Wigner::setMaxTwoS(maxTwoS);
+   }
+   
    struct stat stFileInfo;
    int intStat = stat(MPSstoragename.c_str(),&stFileInfo);
    loadedMPS = ((CheMPS2::DMRG_storeMpsOnDisk) && (intStat==0))? true : false ;
@@ -100,7 +139,7 @@ void CheMPS2::DMRG::setupBookkeeperAndMPS(){
       cout << "Loaded MPS " << MPSstoragename << " converged y/n? : " << isConverged << endl;
    } else {
       for (int cnt=0; cnt<Prob->gL(); cnt++){
-         TensorDiag * Dstor = new TensorDiag(cnt+1,denBK);
+         TensorDiag * Dstor = new TensorDiag(cnt+1,denBK,true);
          MPS[cnt]->random();
          MPS[cnt]->QR(Dstor);
          delete Dstor;
@@ -111,9 +150,18 @@ void CheMPS2::DMRG::setupBookkeeperAndMPS(){
 
 CheMPS2::DMRG::~DMRG(){
 
-   if (denBK!=NULL) delete denBK;
-   
+   flushOperatorIO();
    deleteAllBoundaryOperators();
+   stopOperatorIO();
+   closeOperatorFile();
+   stopOperatorMap();
+   stopOperatorPool();
+   if (denBK!=NULL) delete denBK; //After the operators, which are kept with the virtual dimensions of their boundary
+   #pragma omp parallel
+   {
+      ScratchArena::release();
+      Wigner::release();
+   }
    
    delete [] Ltensors;
    delete [] F0tensors;
@@ -127,6 +175,8 @@ CheMPS2::DMRG::~DMRG(){
    delete [] Qtensors;
    delete [] Xtensors;
    delete [] isAllocated;
+   delete [] DavidsonMatvecs;
+   delete [] DavidsonTime;
    
    for (int cnt=0; cnt<Prob->gL(); cnt++){ delete MPS[cnt]; }
    delete [] MPS;
@@ -145,6 +195,12 @@ CheMPS2::DMRG::~DMRG(){
    }
    
    if (the2DMallocated){ delete the2DM; }
+   
+   if (SA_activated){
+      for (int root=1; root<SA_nRoots; root++){ delete SA_Tensors[root]; }
+      delete [] SA_Tensors;
+      delete [] SA_Energies;
+   }
 
 }
 
@@ -154,12 +210,15 @@ void CheMPS2::DMRG::PreSolve(){
    
    MinEnergy = 1e8;
    MaxDiscWeightLastSweep = 0.0;
+   DavidsonEnergyChange = 1.0;
+   flushOperatorIO();
 
 }
 
 double CheMPS2::DMRG::Solve(){
 
    bool change = (MinEnergy<1e8) ? true : false; //1 sweep from right to left: fixed virtual dimensions
+   SweepsLastSolve = 0;
    
    for (int instruction=0; instruction < OptScheme->getNInstructions(); instruction++){
    
@@ -167,22 +226,45 @@ double CheMPS2::DMRG::Solve(){
       double EnergyPrevious = 1.0;
    
       int nIterations = 0;
+      bool looseSweep = false; //Whether the last sweep used a looser Davidson tolerance than the tightest one: its energy difference does not indicate convergence
       
-      while ( (fabs(Energy-EnergyPrevious) > OptScheme->getEconv(instruction) ) && ( nIterations < OptScheme->getMaxSweeps(instruction) )){
+      while ( ( (fabs(Energy-EnergyPrevious) > OptScheme->getEconv(instruction)) || looseSweep ) && ( nIterations < OptScheme->getMaxSweeps(instruction) )){
       
+         DavidsonEnergyChange = fabs(Energy-EnergyPrevious);
+         DavidsonOptions * dvdsOptions = OptScheme->getDavidsonOptions(instruction);
+         looseSweep = ((dvdsOptions!=NULL) && (dvdsOptions->getResidualTolerance(DavidsonEnergyChange) > dvdsOptions->getResidualTolerance(0.0)));
+         for (int cnt=0; cnt<Prob->gL()-1; cnt++){
+            DavidsonMatvecs[cnt] = 0;
+            DavidsonTime[cnt] = 0.0;
+         }
+         
          EnergyPrevious = Energy;
-         Energy = sweepleft(change, instruction);
+         Energy = (SA_activated) ? sweepStateAveraged(false, change, instruction) : sweepleft(change, instruction);
          cout << "***  The max. disc. weight at last sweep is " << MaxDiscWeightLastSweep << endl;
          if (!change) change = true; //rest of sweeps: variable virtual dimensions
-         Energy = sweepright(change, instruction);
+         Energy = (SA_activated) ? sweepStateAveraged(true, change, instruction) : sweepright(change, instruction);
          cout << "***  The max. disc. weight at last sweep is " << MaxDiscWeightLastSweep << endl;
-         if (CheMPS2::DMRG_storeMpsOnDisk){ saveMPS(MPSstoragename, MPS, denBK, false); }
+         if (CheMPS2::DMRG_storeMpsOnDisk){
+            flushOperatorIO();
+            saveMPS(MPSstoragename, MPS, denBK, false);
+         }
          
          nIterations++;
+         SweepsLastSolve++;
          
          cout << "*** Number of leftright sweep iterations is " << nIterations << endl; 
          cout << "***                The energy difference is " << fabs(Energy-EnergyPrevious) << endl;
          cout << "***                           The energy is " << Energy << endl;
+         int totalMatvecs = 0;
+         double totalTime = 0.0;
+         for (int cnt=0; cnt<Prob->gL()-1; cnt++){
+            totalMatvecs += DavidsonMatvecs[cnt];
+            totalTime += DavidsonTime[cnt];
+         }
+         cout << "***     The number of Davidson matvecs is " << totalMatvecs << " (" << totalTime << " seconds)" << endl;
+         if (SA_activated){
+            for (int root=0; root<SA_nRoots; root++){ cout << "***               The energy of root " << root << " is " << SA_Energies[root] << endl; }
+         }
          if (Exc_activated){ calcOverlapsWithLowerStates(); }
       
       }
@@ -196,6 +278,8 @@ double CheMPS2::DMRG::Solve(){
    
    }
    
+   flushOperatorIO();
+   
    return MinEnergy;
 
 }
@@ -212,7 +296,6 @@ double CheMPS2::DMRG::sweepleft(const bool change, const int instruction){
       denS->Join(MPS[index],MPS[index+1]);
       
       //Feed everything to the solver
-      Heff Solver(denBK, Prob);
       double ** VeffTilde = NULL;
       if (Exc_activated){
          VeffTilde = new double*[nStates-1];
@@ -221,7 +304,7 @@ double CheMPS2::DMRG::sweepleft(const bool change, const int instruction){
             calcVeffTilde(VeffTilde[cnt], denS, cnt);
          }
       }
-      Energy = Solver.SolveDAVIDSON(denS, Ltensors, Atensors, Btensors, Ctensors, Dtensors, S0tensors, S1tensors, F0tensors, F1tensors, Qtensors, Xtensors, nStates-1, VeffTilde);
+      Energy = solveSite(denS, instruction, VeffTilde);
       if (Exc_activated){
          //calcOverlapsWithLowerStatesDuringSweeps_debug(VeffTilde, denS);
          for (int cnt=0; cnt<nStates-1; cnt++){ delete [] VeffTilde[cnt]; }
@@ -239,6 +322,8 @@ double CheMPS2::DMRG::sweepleft(const bool change, const int instruction){
       //Print info
       cout << "Energy at sites (" << index << ", " << (index+1) << ") is " << Energy << endl;
       if (CheMPS2::DMRG_printDiscardedWeight && change){ cout << "   Info(DMRG) : Discarded weight in SVD decomp. (non-reduced) = " << discWeight << endl; }
+      if (CheMPS2::DMRG_printDavidsonStats){ cout << "   Info(DMRG) : Davidson matvecs = " << DavidsonMatvecs[index] << " ; time = " << DavidsonTime[index] << " seconds" << endl; }
+      if (CheMPS2::DMRG_printDavidsonStats){ cout << "   Info(DMRG) : Scratch arena heap allocations = " << ScratchArena::gNumAllocations() - ScratchAllocationsStart << " ; requests = " << ScratchArena::gNumRequests() - ScratchRequestsStart << endl; }
       
       //Prepare for next step
       updateMovingLeftSafe(index);
@@ -261,7 +346,6 @@ double CheMPS2::DMRG::sweepright(const bool change, const int instruction){
       denS->Join(MPS[index],MPS[index+1]);
       
       //Feed everything to solver
-      Heff Solver(denBK, Prob);
       double ** VeffTilde = NULL;
       if (Exc_activated){
          VeffTilde = new double*[nStates-1];
@@ -270,7 +354,7 @@ double CheMPS2::DMRG::sweepright(const bool change, const int instruction){
             calcVeffTilde(VeffTilde[cnt], denS, cnt);
          }
       }
-      Energy = Solver.SolveDAVIDSON(denS, Ltensors, Atensors, Btensors, Ctensors, Dtensors, S0tensors, S1tensors, F0tensors, F1tensors, Qtensors, Xtensors, nStates-1, VeffTilde);
+      Energy = solveSite(denS, instruction, VeffTilde);
       if (Exc_activated){
          //calcOverlapsWithLowerStatesDuringSweeps_debug(VeffTilde, denS);
          for (int cnt=0; cnt<nStates-1; cnt++){ delete [] VeffTilde[cnt]; }
@@ -288,6 +372,8 @@ double CheMPS2::DMRG::sweepright(const bool change, const int instruction){
       //Print info
       cout << "Energy at sites (" << index << ", " << (index+1) << ") is " << Energy << endl;
       if (CheMPS2::DMRG_printDiscardedWeight && change){ cout << "   Info(DMRG) : Discarded weight in SVD decomp. (non-reduced) = " << discWeight << endl; }
+      if (CheMPS2::DMRG_printDavidsonStats){ cout << "   Info(DMRG) : Davidson matvecs = " << DavidsonMatvecs[index] << " ; time = " << DavidsonTime[index] << " seconds" << endl; }
+      if (CheMPS2::DMRG_printDavidsonStats){ cout << "   Info(DMRG) : Scratch arena heap allocations = " << ScratchArena::gNumAllocations() - ScratchAllocationsStart << " ; requests = " << ScratchArena::gNumRequests() - ScratchRequestsStart << endl; }
       
       //Prepare for next step
       updateMovingRightSafe(index);
@@ -298,6 +384,30 @@ double CheMPS2::DMRG::sweepright(const bool change, const int instruction){
 
 }
 
+double CheMPS2::DMRG::solveSite(Sobject * denS, const int instruction, double ** VeffTilde){
+
+   struct timeval start, end;
+   gettimeofday(&start, NULL);
+   
+   Heff Solver(denBK, Prob);
+   Solver.setDavidsonOptions(OptScheme->getDavidsonOptions(instruction), DavidsonEnergyChange);
+   const double Energy = Solver.SolveDAVIDSON(denS, Ltensors, Atensors, Btensors, Ctensors, Dtensors, S0tensors, S1tensors, F0tensors, F1tensors, Qtensors, Xtensors, nStates-1, VeffTilde);
+   
+   gettimeofday(&end, NULL);
+   const int index = denS->gIndex();
+   DavidsonMatvecs[index] += Solver.gNumMatvecs();
+   DavidsonTime[index] += (end.tv_sec - start.tv_sec) + 1e-6 * (end.tv_usec - start.tv_usec);
+   
+   return Energy;
+
+}
+
+int CheMPS2::DMRG::getDavidsonMatvecs(const int index) const{ return DavidsonMatvecs[index]; }
+
+double CheMPS2::DMRG::getDavidsonTime(const int index) const{ return DavidsonTime[index]; }
+
+int CheMPS2::DMRG::getNumSweeps() const{ return SweepsLastSolve; }
+
 void CheMPS2::DMRG::activateExcitations(const int maxExcIn){
 
    Exc_activated = true;
@@ -311,6 +421,13 @@ void CheMPS2::DMRG::activateExcitations(const int maxExcIn){
 
 void CheMPS2::DMRG::newExcitation(const double EshiftIn){
 
+   if (SA_activated){
+   
+      cout << "DMRG::newExcitation : excitations cannot be combined with state averaging!" << endl;
+      return;
+      
+   }
+
    if (!Exc_activated){
    
       cout << "DMRG::activateExcitations has not been called yet!" << endl;
@@ -19,6 +19,7 @@
 
 #include <hdf5.h>
 #include <iostream>
+#include <algorithm>
 #include <cstdlib>
 #include <sstream>
 #include <string>
@@ -162,6 +163,77 @@ void CheMPS2::DMRG::loadMPS(const std::string name, TensorT ** MPSlocation, bool
 
 }
 
+void CheMPS2::DMRG::copyMPS(DMRG * guess, const bool guessDims){
+
+   //After excitations, the MPS of the guess is its last excitation, and its ground state is pushed back in Exc_MPSs[0]
+   const bool fromGround = ((guess->Exc_activated) && (guess->nStates > 1));
+   TensorT ** guessMPS = (fromGround) ? guess->Exc_MPSs[0] : guess->MPS;
+   SyBookkeeper * guessBK = (fromGround) ? guess->Exc_BKs[0] : guess->denBK;
+
+   bool compatible = ((guess->Prob->gL() == Prob->gL()) && (guessBK->gN() == denBK->gN()) && (guessBK->gTwoS() == denBK->gTwoS()) && (guessBK->gIrrep() == denBK->gIrrep()));
+   if (compatible){
+      for (int orb=0; orb<Prob->gL(); orb++){ if (guessBK->gIrrep(orb) != denBK->gIrrep(orb)){ compatible = false; } }
+   }
+   if (!compatible){
+      std::cout << "DMRG::copyMPS : The guess belongs to a different problem. A random MPS is used instead." << std::endl;
+      return;
+   }
+   
+   if (guessDims){
+      for (int bound=0; bound<=Prob->gL(); bound++){
+         for (int N=denBK->gNmin(bound); N<=denBK->gNmax(bound); N++){
+            for (int TwoS=denBK->gTwoSmin(bound,N); TwoS<=denBK->gTwoSmax(bound,N); TwoS+=2){
+               for (int Irrep=0; Irrep<denBK->getNumberOfIrreps(); Irrep++){
+                  denBK->SetDim(bound, N, TwoS, Irrep, guessBK->gCurrentDim(bound, N, TwoS, Irrep));
+               }
+            }
+         }
+      }
+   }
+   
+   //Copy the overlapping part of each block; the rest of the block is zero
+   for (int site=0; site<Prob->gL(); site++){
+      if (guessDims){ MPS[site]->Reset(); }
+      double * storage = MPS[site]->gStorage();
+      for (int cnt=0; cnt<MPS[site]->gKappa2index(MPS[site]->gNKappa()); cnt++){ storage[cnt] = 0.0; }
+      
+      for (int NL=denBK->gNmin(site); NL<=denBK->gNmax(site); NL++){
+         for (int TwoSL=denBK->gTwoSmin(site,NL); TwoSL<=denBK->gTwoSmax(site,NL); TwoSL+=2){
+            for (int IL=0; IL<denBK->getNumberOfIrreps(); IL++){
+               const int dimL = std::min(denBK->gCurrentDim(site,NL,TwoSL,IL), guessBK->gCurrentDim(site,NL,TwoSL,IL));
+               const int ldL = denBK->gCurrentDim(site,NL,TwoSL,IL);
+               const int ldLguess = guessBK->gCurrentDim(site,NL,TwoSL,IL);
+               
+               //The local states: empty, doubly occupied, and singly occupied with the two spin couplings
+               for (int local=0; local<4; local++){
+                  const int NR    = NL + ((local==0) ? 0 : ((local==1) ? 2 : 1));
+                  const int TwoSR = TwoSL + ((local==2) ? -1 : ((local==3) ? 1 : 0));
+                  const int IR    = (local<2) ? IL : denBK->directProd(IL, denBK->gIrrep(site));
+                  double * block      = MPS[site]->gStorage(NL,TwoSL,IL,NR,TwoSR,IR);
+                  double * blockGuess = guessMPS[site]->gStorage(NL,TwoSL,IL,NR,TwoSR,IR);
+                  if ((block!=NULL) && (blockGuess!=NULL)){
+                     const int dimR = std::min(denBK->gCurrentDim(site+1,NR,TwoSR,IR), guessBK->gCurrentDim(site+1,NR,TwoSR,IR));
+                     for (int r=0; r<dimR; r++){
+                        for (int l=0; l<dimL; l++){ block[l + ldL * r] = blockGuess[l + ldLguess * r]; }
+                     }
+                  }
+               }
+            }
+         }
+      }
+   }
+   
+   //Left-normalize the MPS, and push the R-factors to the right, so that the state itself doesn't change
+   for (int site=0; site<Prob->gL(); site++){
+      TensorDiag * Rstor = new TensorDiag(site+1, denBK, true);
+      MPS[site]->QR(Rstor);
+      if (site+1<Prob->gL()){ MPS[site+1]->LeftMultiply(Rstor); }
+      delete Rstor;
+   }
+   std::cout << "DMRG::copyMPS : The MPS of the previous calculation is used as initial guess." << std::endl;
+
+}
+
 void CheMPS2::DMRG::deleteStoredMPS(){
 
    int info = system("rm CheMPS2_MPS*.h5");
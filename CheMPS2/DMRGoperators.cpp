@@ -23,12 +23,15 @@
 #include <sstream>
 
 #include "DMRG.h"
+#include "ScratchArena.h"
 
 using std::cout;
 using std::endl;
 
 void CheMPS2::DMRG::updateMovingRightSafeFirstTime(const int cnt){
 
+   waitOperatorIO(cnt);
+   IOresident[cnt] = false;
    if (isAllocated[cnt]==2){
       deleteTensors(cnt, false);
       isAllocated[cnt]=0;
@@ -39,13 +42,9 @@ void CheMPS2::DMRG::updateMovingRightSafeFirstTime(const int cnt){
    }
    updateMovingRight(cnt);
    
-   if (CheMPS2::DMRG_storeRenormOptrOnDisk){
+   if ((IOstoreOnDisk) && (!mapActive)){
       if (cnt>0){
-         if (isAllocated[cnt-1]==1){
-            storeOperators(cnt-1, true);
-            deleteTensors(cnt-1, true);
-            isAllocated[cnt-1]=0;
-         }
+         if (isAllocated[cnt-1]==1){ storeOperatorsBehind(cnt-1); }
       }
    }
 
@@ -53,6 +52,8 @@ void CheMPS2::DMRG::updateMovingRightSafeFirstTime(const int cnt){
 
 void CheMPS2::DMRG::updateMovingRightSafe(const int cnt){
 
+   waitOperatorIO(cnt);
+   IOresident[cnt] = false;
    if (isAllocated[cnt]==2){
       deleteTensors(cnt, false);
       isAllocated[cnt]=0;
@@ -63,37 +64,27 @@ void CheMPS2::DMRG::updateMovingRightSafe(const int cnt){
    }
    updateMovingRight(cnt);
    
-   if (CheMPS2::DMRG_storeRenormOptrOnDisk){
+   if ((IOstoreOnDisk) && (!mapActive)){
       if (cnt>0){
-         if (isAllocated[cnt-1]==1){
-            storeOperators(cnt-1, true);
-            deleteTensors(cnt-1, true);
-            isAllocated[cnt-1]=0;
-         }
+         if (isAllocated[cnt-1]==1){ storeOperatorsBehind(cnt-1); }
       }
       if (cnt+1<Prob->gL()-1){
+         waitOperatorIO(cnt+1);
          if (isAllocated[cnt+1]==2){
             deleteTensors(cnt+1, false);
             isAllocated[cnt+1]=0;
          }
       }
-      if (cnt+2<Prob->gL()-1){
-         if (isAllocated[cnt+2]==1){
-            deleteTensors(cnt+2, true);
-            isAllocated[cnt+2]=0;
-         }
-         if (isAllocated[cnt+2]==0){
-            allocateTensors(cnt+2, false);
-            isAllocated[cnt+2]=2;
-         }
-         loadOperators(cnt+2, false);
-      }
+      if (cnt+2<Prob->gL()-1){ loadOperatorsNow(cnt+2, false); }
+      if (cnt+3<Prob->gL()-1){ prefetchOperators(cnt+3, false); } //Needed after the next site
    }
 
 }
 
 void CheMPS2::DMRG::updateMovingLeftSafe(const int cnt){
 
+   waitOperatorIO(cnt);
+   IOresident[cnt] = false;
    if (isAllocated[cnt]==1){
       deleteTensors(cnt, true);
       isAllocated[cnt]=0;
@@ -104,37 +95,27 @@ void CheMPS2::DMRG::updateMovingLeftSafe(const int cnt){
    }
    updateMovingLeft(cnt);
    
-   if (CheMPS2::DMRG_storeRenormOptrOnDisk){
+   if ((IOstoreOnDisk) && (!mapActive)){
       if (cnt+1<Prob->gL()-1){
-         if (isAllocated[cnt+1]==2){
-            storeOperators(cnt+1, false);
-            deleteTensors(cnt+1, false);
-            isAllocated[cnt+1]=0;
-         }
+         if (isAllocated[cnt+1]==2){ storeOperatorsBehind(cnt+1); }
       }
       if (cnt-1>=0){
+         waitOperatorIO(cnt-1);
          if (isAllocated[cnt-1]==1){
             deleteTensors(cnt-1, true);
             isAllocated[cnt-1]=0;
          }
       }
-      if (cnt-2>=0){
-         if (isAllocated[cnt-2]==2){
-            deleteTensors(cnt-2, false);
-            isAllocated[cnt-2]=0;
-         }
-         if (isAllocated[cnt-2]==0){
-            allocateTensors(cnt-2, true);
-            isAllocated[cnt-2]=1;
-         }
-         loadOperators(cnt-2, true);
-      }
+      if (cnt-2>=0){ loadOperatorsNow(cnt-2, true); }
+      if (cnt-3>=0){ prefetchOperators(cnt-3, true); } //Needed after the next site
    }
 
 }
 
 void CheMPS2::DMRG::updateMovingLeftSafe2DM(const int cnt){
 
+   waitOperatorIO(cnt);
+   IOresident[cnt] = false;
    if (isAllocated[cnt]==1){
       deleteTensors(cnt, true);
       isAllocated[cnt]=0;
@@ -145,70 +126,187 @@ void CheMPS2::DMRG::updateMovingLeftSafe2DM(const int cnt){
    }
    updateMovingLeft(cnt);
    
-   if (CheMPS2::DMRG_storeRenormOptrOnDisk){
+   if ((IOstoreOnDisk) && (!mapActive)){
       if (cnt+1<Prob->gL()-1){
+         waitOperatorIO(cnt+1);
          if (isAllocated[cnt+1]==2){
             deleteTensors(cnt+1, false);
             isAllocated[cnt+1]=0;
          }
       }
-      if (cnt-1>=0){
-         if (isAllocated[cnt-1]==2){
-            deleteTensors(cnt-1, false);
-            isAllocated[cnt-1]=0;
-         }
-         if (isAllocated[cnt-1]==0){
-            allocateTensors(cnt-1, true);
-            isAllocated[cnt-1]=1;
-         }
-         loadOperators(cnt-1, true);
-      }
+      if (cnt-1>=0){ loadOperatorsNow(cnt-1, true); }
    }
 
 }
 
 void CheMPS2::DMRG::deleteAllBoundaryOperators(){
 
+   flushOperatorIO();
    for (int cnt=0; cnt<Prob->gL()-1; cnt++){
       if (isAllocated[cnt]==1){ deleteTensors(cnt, true); }
       if (isAllocated[cnt]==2){ deleteTensors(cnt, false); }
       isAllocated[cnt] = 0;
+      IOprefetched[cnt] = false;
+      IOresident[cnt] = false;
+   }
+   for (int slot=0; slot<2*(Prob->gL()-1); slot++){ deleteParkedOperators(slot); } //They refer to the current SyBookkeeper, which may be replaced next
+
+}
+
+void CheMPS2::DMRG::updateMovingRight(const int index){
+
+   updateOperators(index, true);
+   
+   //Otensors
+   if (Exc_activated){
+      for (int state=0; state<nStates-1; state++){
+         if (index==0){
+            Exc_Overlaps[state][index]->update(Exc_MPSs[state][index],MPS[index]);
+         } else {
+            Exc_Overlaps[state][index]->update(Exc_MPSs[state][index],MPS[index],Exc_Overlaps[state][index-1]);
+         }
+      }
    }
 
 }
 
-int CheMPS2::DMRG::trianglefunction(const int k, const int glob){
+void CheMPS2::DMRG::updateMovingLeft(const int index){
 
-   int cnt2tilde = 1;
-   while(cnt2tilde*(cnt2tilde+1)/2 <= glob){ cnt2tilde++; }
-   return k - cnt2tilde;
+   updateOperators(index, false);
    
+   //Otensors
+   if (Exc_activated){
+      for (int state=0; state<nStates-1; state++){
+         if (index==Prob->gL()-2){
+            Exc_Overlaps[state][index]->update(Exc_MPSs[state][index+1],MPS[index+1]);
+         } else {
+            Exc_Overlaps[state][index]->update(Exc_MPSs[state][index+1],MPS[index+1],Exc_Overlaps[state][index+1]);
+         }
+      }
+   }
+
 }
 
-void CheMPS2::DMRG::updateMovingRight(const int index){
+//A work item of the operator updates at one boundary: items of a lower level are handed out first, and within a level the most expensive ones first
+struct DMRGoperatorItem{
+   int level;
+   double cost;
+   int family;
+   int cnt2;
+   int cnt3;
+};
+
+static int DMRG_compareOperatorItems(const void * a, const void * b){
+
+   const DMRGoperatorItem * itemA = (const DMRGoperatorItem *) a;
+   const DMRGoperatorItem * itemB = (const DMRGoperatorItem *) b;
+   if (itemA->level != itemB->level){ return ((itemA->level < itemB->level) ? -1 : 1); }
+   return ((itemA->cost > itemB->cost) ? -1 : ((itemA->cost < itemB->cost) ? 1 : 0));
+
+}
+
+void CheMPS2::DMRG::updateOperators(const int index, const bool movingRight){
+
+   //The number of sites on the side which grows (k1) and on the other side (k2), and whether the boundary is the first one of the sweep
+   const int k1 = (movingRight) ? index+1 : Prob->gL()-1-index;
+   const int k2 = Prob->gL()-k1;
+   const bool first = (movingRight) ? (index==0) : (index==Prob->gL()-2);
+
+   //Estimated flops: a renormalization of one operator (two matrix products over the old and new boundary), and an axpy over the new operator
+   const double dimNew = denBK->gMaxDimAtBound(index+1);
+   const double dimOld = denBK->gMaxDimAtBound((movingRight) ? index : index+2);
+   const double costUpdate = 2 * dimNew * dimOld * (dimNew + dimOld);
+   const double costAxpy = dimNew * dimNew;
+
+   const int numX = (first) ? 1 : Xtensors[index]->gNKappa();
+   const int numItems = k1 + k1*(k1+1)/2 + k2*(k2+1)/2 + k2 + numX;
+   DMRGoperatorItem * items = new DMRGoperatorItem[numItems];
+   int numPrerequisites = 0;
+   int cnt = 0;
+   for (int cnt2=0; cnt2<k1; cnt2++){
+      const DMRGoperatorItem item = { 1, ((cnt2==0) ? costAxpy : costUpdate), OPERATORITEM_L, cnt2, 0 };
+      items[cnt++] = item;
+   }
+   for (int cnt2=0; cnt2<k1; cnt2++){
+      for (int cnt3=0; cnt3<k1-cnt2; cnt3++){
+         //The complementary operators need all two-operator tensors with cnt3==0 of this boundary
+         const double cost = ((cnt2==0) && (cnt3==0)) ? 3*costAxpy : ((cnt2==0) ? 3 : 4) * costUpdate;
+         const DMRGoperatorItem item = { ((cnt3==0) ? 0 : 1), cost, OPERATORITEM_FS, cnt2, cnt3 };
+         items[cnt++] = item;
+         if (cnt3==0){ numPrerequisites++; }
+      }
+   }
+   for (int cnt2=0; cnt2<k2; cnt2++){
+      for (int cnt3=0; cnt3<k2-cnt2; cnt3++){
+         const double cost = ((first) ? 4*costAxpy : 4*costUpdate) + 6*k1*costAxpy;
+         const DMRGoperatorItem item = { 2, cost, OPERATORITEM_ABCD, cnt2, cnt3 };
+         items[cnt++] = item;
+      }
+   }
+   for (int cnt2=0; cnt2<k2; cnt2++){
+      const DMRGoperatorItem item = { 1, ((first) ? 2*costAxpy : 4*costUpdate + 2*k1*costAxpy), OPERATORITEM_Q, cnt2, 0 };
+      items[cnt++] = item;
+   }
+   for (int ikappa=0; ikappa<numX; ikappa++){
+      double cost = costAxpy;
+      if ((!first) && (Xtensors[index]->gKappa2index(numX) > 0)){
+         const double fraction = ((double) (Xtensors[index]->gKappa2index(ikappa+1) - Xtensors[index]->gKappa2index(ikappa))) / Xtensors[index]->gKappa2index(numX);
+         cost = fraction * (6*costUpdate + 2*k1*costAxpy);
+      }
+      const DMRGoperatorItem item = { 1, cost, OPERATORITEM_X, ((first) ? -1 : ikappa), 0 };
+      items[cnt++] = item;
+   }
+   qsort(items, numItems, sizeof(DMRGoperatorItem), DMRG_compareOperatorItems);
+
+   /* The items are handed out in sorted order from a shared counter. The only dependence within a boundary is the one of the complementary
+      operators (level 2) on the two-operator tensors with cnt3==0 (level 0); all other items only need the operators of the previous boundary.
+      As every level 0 item has been handed out before the first level 2 item, a thread which waits for them never waits for a thread which waits. */
+   int next = 0;
+   int numDone = 0;
+   #pragma omp parallel
+   {
+      while (true){
+         int item;
+         #pragma omp atomic capture
+         item = next++;
+         if (item >= numItems){ break; }
+         if (items[item].level == 2){
+            int done = 0;
+            while (done < numPrerequisites){
+               #pragma omp atomic read
+               done = numDone;
+            }
+            #pragma omp flush
+         }
+         if (movingRight){ updateItemMovingRight(index, items[item].family, items[item].cnt2, items[item].cnt3); }
+         else {            updateItemMovingLeft( index, items[item].family, items[item].cnt2, items[item].cnt3); }
+         if (items[item].level == 0){
+            #pragma omp flush
+            #pragma omp atomic
+            numDone++;
+         }
+      }
+   }
+
+   delete [] items;
+
+}
+
+void CheMPS2::DMRG::updateItemMovingRight(const int index, const int family, const int cnt2, const int cnt3){
 
    const int dimL = denBK->gMaxDimAtBound(index);
    const int dimR = denBK->gMaxDimAtBound(index+1);
 
-   //Ltensors
-   #pragma omp parallel for schedule(static)
-   for (int cnt2=0; cnt2<(index+1) ; cnt2++){
+   if (family == OPERATORITEM_L){
       if (cnt2==0){
          Ltensors[index][cnt2]->makenew(MPS[index]);
       } else {
-         double * workmem = new double[dimL*dimR];
+         double * workmem = ScratchArena::get(0, dimL*dimR);
          Ltensors[index][cnt2]->update( Ltensors[index-1][cnt2-1] , MPS[index] , workmem );
-         delete [] workmem;
       }
    }
-   
-   //Two-operator tensors
-   const int k1 = index+1;
-   const int upperbound1 = k1*(k1+1)/2;
-   #pragma omp parallel for schedule(static)
-   for (int glob=0; glob<upperbound1; glob++){
-      const int cnt2 = trianglefunction(k1,glob);
-      const int cnt3 = glob - (k1-1-cnt2)*(k1-cnt2)/2;
+
+   if (family == OPERATORITEM_FS){
       if (cnt3==0){
          if (cnt2==0){
             F0tensors[index][cnt2][cnt3]->makenew(MPS[index]);
@@ -216,42 +314,33 @@ void CheMPS2::DMRG::updateMovingRight(const int index){
             S0tensors[index][cnt2][cnt3]->makenew(MPS[index]);
             //S1[index][0][cnt3] doesn't exist
          } else {
-            double * workmem = new double[dimL*dimR];
+            double * workmem = ScratchArena::get(0, dimL*dimR);
             F0tensors[index][cnt2][cnt3]->makenew(Ltensors[index-1][cnt2-1],MPS[index],workmem);
             F1tensors[index][cnt2][cnt3]->makenew(Ltensors[index-1][cnt2-1],MPS[index],workmem);
             S0tensors[index][cnt2][cnt3]->makenew(Ltensors[index-1][cnt2-1],MPS[index],workmem);
             S1tensors[index][cnt2][cnt3]->makenew(Ltensors[index-1][cnt2-1],MPS[index],workmem);
-            delete [] workmem;
          }
       } else {
-         double * workmem = new double[dimL*dimR];
+         double * workmem = ScratchArena::get(0, dimL*dimR);
          F0tensors[index][cnt2][cnt3]->update(F0tensors[index-1][cnt2][cnt3-1],MPS[index],workmem);
          F1tensors[index][cnt2][cnt3]->update(F1tensors[index-1][cnt2][cnt3-1],MPS[index],workmem);
          S0tensors[index][cnt2][cnt3]->update(S0tensors[index-1][cnt2][cnt3-1],MPS[index],workmem);
          if (cnt2>0){ S1tensors[index][cnt2][cnt3]->update(S1tensors[index-1][cnt2][cnt3-1],MPS[index],workmem); }
-         delete [] workmem;
       }
    }
-   
-   //Complementary two-operator tensors
-   const int k2 = Prob->gL()-1-index;
-   const int upperbound2 = k2*(k2+1)/2;
-   #pragma omp parallel for schedule(static)
-   for (int glob=0; glob<upperbound2; glob++){
-      const int cnt2 = trianglefunction(k2,glob);
-      const int cnt3 = glob - (k2-1-cnt2)*(k2-cnt2)/2;
+
+   if (family == OPERATORITEM_ABCD){
       if (index==0){
          Atensors[index][cnt2][cnt3]->ClearStorage();
          if (cnt2>0){ Btensors[index][cnt2][cnt3]->ClearStorage(); }
          Ctensors[index][cnt2][cnt3]->ClearStorage();
          Dtensors[index][cnt2][cnt3]->ClearStorage();
       } else {
-         double * workmem = new double[dimL*dimR];
+         double * workmem = ScratchArena::get(0, dimL*dimR);
          Atensors[index][cnt2][cnt3]->update(Atensors[index-1][cnt2][cnt3+1],MPS[index],workmem);
          if (cnt2>0){ Btensors[index][cnt2][cnt3]->update(Btensors[index-1][cnt2][cnt3+1],MPS[index],workmem); }
          Ctensors[index][cnt2][cnt3]->update(Ctensors[index-1][cnt2][cnt3+1],MPS[index],workmem);
          Dtensors[index][cnt2][cnt3]->update(Dtensors[index-1][cnt2][cnt3+1],MPS[index],workmem);
-         delete [] workmem;
       }
       for (int num=0; num<(index+1); num++){
          if ( Atensors[index][cnt2][cnt3]->gIdiff() == S0tensors[index][num][0]->gIdiff() ){ //Then the matrix elements are not 0 due to symm.
@@ -281,70 +370,47 @@ void CheMPS2::DMRG::updateMovingRight(const int index){
          }
       }
    }
-   
-   //Qtensors
-   #pragma omp parallel for schedule(static)
-   for (int cnt2=0; cnt2<Prob->gL()-1-index ; cnt2++){
+
+   if (family == OPERATORITEM_Q){
       if (index==0){
          Qtensors[index][cnt2]->ClearStorage();
          Qtensors[index][cnt2]->AddTermSimple(MPS[index]);
       } else {
-         double * workmem = new double[dimL*dimL];
-         double * workmem2 = new double[dimL*dimR];
+         double * workmem = ScratchArena::get(0, dimL*dimL);
+         double * workmem2 = ScratchArena::get(1, dimL*dimR);
          Qtensors[index][cnt2]->update(Qtensors[index-1][cnt2+1],MPS[index],workmem2);
          Qtensors[index][cnt2]->AddTermSimple(MPS[index]);
          Qtensors[index][cnt2]->AddTermsL(Ltensors[index-1],MPS[index], workmem, workmem2);
          Qtensors[index][cnt2]->AddTermsAB(Atensors[index-1][cnt2+1][0], Btensors[index-1][cnt2+1][0], MPS[index], workmem, workmem2);
          Qtensors[index][cnt2]->AddTermsCF0DF1(Ctensors[index-1][cnt2+1][0],F0tensors[index-1][0],Dtensors[index-1][cnt2+1][0],F1tensors[index-1][0],MPS[index], workmem, workmem2);
-         delete [] workmem;
-         delete [] workmem2;
       }
    }
-   
-   //Xtensors
-   if (index==0){
-      Xtensors[index]->update(MPS[index]);
-   } else {
-      Xtensors[index]->update(MPS[index], Ltensors[index-1], Xtensors[index-1], Qtensors[index-1][0], Atensors[index-1][0][0], Ctensors[index-1][0][0], F0tensors[index-1][0], Dtensors[index-1][0][0], F1tensors[index-1][0]);
-   }
-   
-   //Otensors
-   if (Exc_activated){
-      for (int state=0; state<nStates-1; state++){
-         if (index==0){
-            Exc_Overlaps[state][index]->update(Exc_MPSs[state][index],MPS[index]);
-         } else {
-            Exc_Overlaps[state][index]->update(Exc_MPSs[state][index],MPS[index],Exc_Overlaps[state][index-1]);
-         }
+
+   if (family == OPERATORITEM_X){
+      if (cnt2<0){
+         Xtensors[index]->update(MPS[index]);
+      } else {
+         Xtensors[index]->updateBlock(cnt2, MPS[index], Ltensors[index-1], Xtensors[index-1], Qtensors[index-1][0], Atensors[index-1][0][0], Ctensors[index-1][0][0], F0tensors[index-1][0], Dtensors[index-1][0][0], F1tensors[index-1][0]);
       }
    }
-   
+
 }
 
-void CheMPS2::DMRG::updateMovingLeft(const int index){
+void CheMPS2::DMRG::updateItemMovingLeft(const int index, const int family, const int cnt2, const int cnt3){
 
    const int dimL = denBK->gMaxDimAtBound(index+1);
    const int dimR = denBK->gMaxDimAtBound(index+2);
 
-   //Ltensors
-   #pragma omp parallel for schedule(static)
-   for (int cnt2=0; cnt2<Prob->gL()-1-index; cnt2++){
+   if (family == OPERATORITEM_L){
       if (cnt2==0){
          Ltensors[index][cnt2]->makenew(MPS[index+1]);
       } else {
-         double * workmem = new double[dimL*dimR];
+         double * workmem = ScratchArena::get(0, dimL*dimR);
          Ltensors[index][cnt2]->update( Ltensors[index+1][cnt2-1] , MPS[index+1] , workmem );
-         delete [] workmem;
       }
    }
-   
-   //Two-operator tensors
-   const int k1 = Prob->gL()-1-index;
-   const int upperbound1 = k1*(k1+1)/2;
-   #pragma omp parallel for schedule(static)
-   for (int glob=0; glob<upperbound1; glob++){
-      const int cnt2 = trianglefunction(k1,glob);
-      const int cnt3 = glob - (k1-1-cnt2)*(k1-cnt2)/2;
+
+   if (family == OPERATORITEM_FS){
       if (cnt3==0){
          if (cnt2==0){
             F0tensors[index][cnt2][cnt3]->makenew(MPS[index+1]);
@@ -352,42 +418,33 @@ void CheMPS2::DMRG::updateMovingLeft(const int index){
             S0tensors[index][cnt2][cnt3]->makenew(MPS[index+1]);
             //S1[index][0] doesn't exist
          } else {
-            double * workmem = new double[dimL*dimR];
+            double * workmem = ScratchArena::get(0, dimL*dimR);
             F0tensors[index][cnt2][cnt3]->makenew(Ltensors[index+1][cnt2-1],MPS[index+1],workmem);
             F1tensors[index][cnt2][cnt3]->makenew(Ltensors[index+1][cnt2-1],MPS[index+1],workmem);
             S0tensors[index][cnt2][cnt3]->makenew(Ltensors[index+1][cnt2-1],MPS[index+1],workmem);
             S1tensors[index][cnt2][cnt3]->makenew(Ltensors[index+1][cnt2-1],MPS[index+1],workmem);
-            delete [] workmem;
          }
       } else {
-         double * workmem = new double[dimL*dimR];
+         double * workmem = ScratchArena::get(0, dimL*dimR);
          F0tensors[index][cnt2][cnt3]->update(F0tensors[index+1][cnt2][cnt3-1],MPS[index+1],workmem);
          F1tensors[index][cnt2][cnt3]->update(F1tensors[index+1][cnt2][cnt3-1],MPS[index+1],workmem);
          S0tensors[index][cnt2][cnt3]->update(S0tensors[index+1][cnt2][cnt3-1],MPS[index+1],workmem);
          if (cnt2>0){ S1tensors[index][cnt2][cnt3]->update(S1tensors[index+1][cnt2][cnt3-1],MPS[index+1],workmem); }
-         delete [] workmem;
       }
    }
-      
-   //Complementary two-operator tensors
-   const int k2 = index+1;
-   const int upperbound2 = k2*(k2+1)/2;
-   #pragma omp parallel for schedule(static)
-   for (int glob=0; glob<upperbound2; glob++){
-      const int cnt2 = trianglefunction(k2,glob);
-      const int cnt3 = glob - (k2-1-cnt2)*(k2-cnt2)/2;
+
+   if (family == OPERATORITEM_ABCD){
       if (index==Prob->gL()-2){
          Atensors[index][cnt2][cnt3]->ClearStorage();
          if (cnt2>0){ Btensors[index][cnt2][cnt3]->ClearStorage(); }
          Ctensors[index][cnt2][cnt3]->ClearStorage();
          Dtensors[index][cnt2][cnt3]->ClearStorage();
       } else {
-         double * workmem = new double[dimL*dimR];
+         double * workmem = ScratchArena::get(0, dimL*dimR);
          Atensors[index][cnt2][cnt3]->update(Atensors[index+1][cnt2][cnt3+1],MPS[index+1],workmem);
          if (cnt2>0){ Btensors[index][cnt2][cnt3]->update(Btensors[index+1][cnt2][cnt3+1],MPS[index+1],workmem); }
          Ctensors[index][cnt2][cnt3]->update(Ctensors[index+1][cnt2][cnt3+1],MPS[index+1],workmem);
          Dtensors[index][cnt2][cnt3]->update(Dtensors[index+1][cnt2][cnt3+1],MPS[index+1],workmem);
-         delete [] workmem;
       }
       for (int num=0; num<Prob->gL()-index-1; num++){
          if ( Atensors[index][cnt2][cnt3]->gIdiff() == S0tensors[index][num][0]->gIdiff() ){ //Then the matrix elements are not 0 due to symm.
@@ -416,41 +473,27 @@ void CheMPS2::DMRG::updateMovingLeft(const int index){
          }
       }
    }
-   
-   //Qtensors
-   #pragma omp parallel for schedule(static)
-   for (int cnt2=0; cnt2<index+1 ; cnt2++){
+
+   if (family == OPERATORITEM_Q){
       if (index==Prob->gL()-2){
          Qtensors[index][cnt2]->ClearStorage();
          Qtensors[index][cnt2]->AddTermSimple(MPS[index+1]);
       } else {
-         double * workmem = new double[dimR*dimR];
-         double * workmem2 = new double[dimR*dimL];
+         double * workmem = ScratchArena::get(0, dimR*dimR);
+         double * workmem2 = ScratchArena::get(1, dimR*dimL);
          Qtensors[index][cnt2]->update(Qtensors[index+1][cnt2+1],MPS[index+1],workmem2);
          Qtensors[index][cnt2]->AddTermSimple(MPS[index+1]);
          Qtensors[index][cnt2]->AddTermsL(Ltensors[index+1],MPS[index+1], workmem, workmem2);
          Qtensors[index][cnt2]->AddTermsAB(Atensors[index+1][cnt2+1][0], Btensors[index+1][cnt2+1][0], MPS[index+1], workmem, workmem2);
          Qtensors[index][cnt2]->AddTermsCF0DF1(Ctensors[index+1][cnt2+1][0],F0tensors[index+1][0],Dtensors[index+1][cnt2+1][0],F1tensors[index+1][0],MPS[index+1], workmem, workmem2);
-         delete [] workmem;
-         delete [] workmem2;
       }
    }
-   
-   //Xtensors
-   if (index==Prob->gL()-2){
-      Xtensors[index]->update(MPS[index+1]);
-   } else {
-      Xtensors[index]->update(MPS[index+1], Ltensors[index+1], Xtensors[index+1], Qtensors[index+1][0], Atensors[index+1][0][0], Ctensors[index+1][0][0], F0tensors[index+1][0], Dtensors[index+1][0][0], F1tensors[index+1][0]);
-   }
-   
-   //Otensors
-   if (Exc_activated){
-      for (int state=0; state<nStates-1; state++){
-         if (index==Prob->gL()-2){
-            Exc_Overlaps[state][index]->update(Exc_MPSs[state][index+1],MPS[index+1]);
-         } else {
-            Exc_Overlaps[state][index]->update(Exc_MPSs[state][index+1],MPS[index+1],Exc_Overlaps[state][index+1]);
-         }
+
+   if (family == OPERATORITEM_X){
+      if (cnt2<0){
+         Xtensors[index]->update(MPS[index+1]);
+      } else {
+         Xtensors[index]->updateBlock(cnt2, MPS[index+1], Ltensors[index+1], Xtensors[index+1], Qtensors[index+1][0], Atensors[index+1][0][0], Ctensors[index+1][0][0], F0tensors[index+1][0], Dtensors[index+1][0][0], F1tensors[index+1][0]);
       }
    }
 
@@ -458,12 +501,17 @@ void CheMPS2::DMRG::updateMovingLeft(const int index){
 
 void CheMPS2::DMRG::allocateTensors(const int index, const bool movingRight){
 
+   //Reuse the tensor objects kept by deleteTensors, in the order of listOperators. With the pool or the memory map, the storage is attached afterwards.
+   Tensor ** recycled = (poolActive) ? unparkOperators(index, movingRight) : NULL;
+   int next = 0;
+   const bool ownsStorage = ((!poolActive) && (!mapActive));
+
    if (movingRight){
 
       //Ltensors
       //To right: Ltens[cnt][cnt2] = operator on site cnt-cnt2; at boundary cnt+1
       Ltensors[index] = new TensorL * [index+1];
-      for (int cnt2=0; cnt2<(index+1) ; cnt2++){ Ltensors[index][cnt2] = new TensorL(index+1,denBK->gIrrep(index-cnt2),movingRight,denBK); }
+      for (int cnt2=0; cnt2<(index+1) ; cnt2++){ Ltensors[index][cnt2] = (recycled!=NULL) ? (TensorL *) recycled[next++] : new TensorL(index+1,denBK->gIrrep(index-cnt2),movingRight,denBK,ownsStorage); }
    
       //Two-operator tensors
       //To right: F0tens[cnt][cnt2][cnt3] = operators on sites cnt-cnt3-cnt2 and cnt-cnt3; at boundary cnt+1
@@ -478,10 +526,10 @@ void CheMPS2::DMRG::allocateTensors(const int index, const bool movingRight){
          if (cnt2>0){ S1tensors[index][cnt2] = new TensorS1 * [index-cnt2+1]; }
          for (int cnt3=0; cnt3<(index-cnt2+1); cnt3++){
             const int Iprod = denBK->directProd(denBK->gIrrep(index-cnt2-cnt3),denBK->gIrrep(index-cnt3));
-            F0tensors[index][cnt2][cnt3] = new TensorF0(index+1,Iprod,movingRight,denBK);
-            F1tensors[index][cnt2][cnt3] = new TensorF1(index+1,Iprod,movingRight,denBK);
-            S0tensors[index][cnt2][cnt3] = new TensorS0(index+1,Iprod,movingRight,denBK);
-            if (cnt2>0){ S1tensors[index][cnt2][cnt3] = new TensorS1(index+1,Iprod,movingRight,denBK); }
+            F0tensors[index][cnt2][cnt3] = (recycled!=NULL) ? (TensorF0 *) recycled[next++] : new TensorF0(index+1,Iprod,movingRight,denBK,ownsStorage);
+            F1tensors[index][cnt2][cnt3] = (recycled!=NULL) ? (TensorF1 *) recycled[next++] : new TensorF1(index+1,Iprod,movingRight,denBK,ownsStorage);
+            S0tensors[index][cnt2][cnt3] = (recycled!=NULL) ? (TensorS0 *) recycled[next++] : new TensorS0(index+1,Iprod,movingRight,denBK,ownsStorage);
+            if (cnt2>0){ S1tensors[index][cnt2][cnt3] = (recycled!=NULL) ? (TensorS1 *) recycled[next++] : new TensorS1(index+1,Iprod,movingRight,denBK,ownsStorage); }
          }
       }
    
@@ -498,10 +546,10 @@ void CheMPS2::DMRG::allocateTensors(const int index, const bool movingRight){
          Dtensors[index][cnt2] = new TensorD * [Prob->gL()-1-index-cnt2];
          for (int cnt3=0; cnt3<Prob->gL()-1-index-cnt2; cnt3++){
             const int Idiff = denBK->directProd(denBK->gIrrep(index+1+cnt2+cnt3),denBK->gIrrep(index+1+cnt3));
-            Atensors[index][cnt2][cnt3] = new TensorA(index+1,Idiff,movingRight,denBK);
-            if (cnt2>0){ Btensors[index][cnt2][cnt3] = new TensorB(index+1,Idiff,movingRight,denBK); }
-            Ctensors[index][cnt2][cnt3] = new TensorC(index+1,Idiff,movingRight,denBK);
-            Dtensors[index][cnt2][cnt3] = new TensorD(index+1,Idiff,movingRight,denBK);
+            Atensors[index][cnt2][cnt3] = (recycled!=NULL) ? (TensorA *) recycled[next++] : new TensorA(index+1,Idiff,movingRight,denBK,ownsStorage);
+            if (cnt2>0){ Btensors[index][cnt2][cnt3] = (recycled!=NULL) ? (TensorB *) recycled[next++] : new TensorB(index+1,Idiff,movingRight,denBK,ownsStorage); }
+            Ctensors[index][cnt2][cnt3] = (recycled!=NULL) ? (TensorC *) recycled[next++] : new TensorC(index+1,Idiff,movingRight,denBK,ownsStorage);
+            Dtensors[index][cnt2][cnt3] = (recycled!=NULL) ? (TensorD *) recycled[next++] : new TensorD(index+1,Idiff,movingRight,denBK,ownsStorage);
          }
       }
    
@@ -509,16 +557,16 @@ void CheMPS2::DMRG::allocateTensors(const int index, const bool movingRight){
       //To right: Qtens[cnt][cnt2] = operator on site cnt+1+cnt2; at boundary cnt+1
       Qtensors[index] = new TensorQ * [Prob->gL()-1-index];
       for (int cnt2=0; cnt2<Prob->gL()-1-index ; cnt2++){
-         Qtensors[index][cnt2] = new TensorQ(index+1,denBK->gIrrep(index+1+cnt2),movingRight,denBK,Prob,index+1+cnt2);
+         Qtensors[index][cnt2] = (recycled!=NULL) ? (TensorQ *) recycled[next++] : new TensorQ(index+1,denBK->gIrrep(index+1+cnt2),movingRight,denBK,Prob,index+1+cnt2,ownsStorage);
       }
    
       //Xtensors
-      Xtensors[index] = new TensorX(index+1,movingRight,denBK,Prob);
+      Xtensors[index] = (recycled!=NULL) ? (TensorX *) recycled[next++] : new TensorX(index+1,movingRight,denBK,Prob,ownsStorage);
       
       //Otensors
       if (Exc_activated){
          for (int state=0; state<nStates-1; state++){
-            Exc_Overlaps[state][index] = new TensorO(index+1,movingRight,Exc_BKs[state],denBK,Prob);
+            Exc_Overlaps[state][index] = new TensorO(index+1,movingRight,Exc_BKs[state],denBK,Prob,ownsStorage);
          }
       }
    
@@ -527,7 +575,7 @@ void CheMPS2::DMRG::allocateTensors(const int index, const bool movingRight){
       //Ltensors
       //To left: Ltens[cnt][cnt2] = operator on site cnt+1+cnt2; at boundary cnt+1
       Ltensors[index] = new TensorL * [Prob->gL()-1-index];
-      for (int cnt2=0; cnt2<Prob->gL()-1-index; cnt2++){ Ltensors[index][cnt2] = new TensorL(index+1,denBK->gIrrep(index+1+cnt2),movingRight,denBK); }
+      for (int cnt2=0; cnt2<Prob->gL()-1-index; cnt2++){ Ltensors[index][cnt2] = (recycled!=NULL) ? (TensorL *) recycled[next++] : new TensorL(index+1,denBK->gIrrep(index+1+cnt2),movingRight,denBK,ownsStorage); }
    
       //Two-operator tensors
       //To left: F0tens[cnt][cnt2][cnt3] = operators on sites cnt+1+cnt3 and cnt+1+cnt3+cnt2; at boundary cnt+1
@@ -542,10 +590,10 @@ void CheMPS2::DMRG::allocateTensors(const int index, const bool movingRight){
          if (cnt2>0){ S1tensors[index][cnt2] = new TensorS1 * [Prob->gL()-1-index-cnt2]; }
          for (int cnt3=0; cnt3<Prob->gL()-1-index-cnt2; cnt3++){
             const int Iprod = denBK->directProd(denBK->gIrrep(index+1+cnt3),denBK->gIrrep(index+1+cnt2+cnt3));
-            F0tensors[index][cnt2][cnt3] = new TensorF0(index+1,Iprod,movingRight,denBK);
-            F1tensors[index][cnt2][cnt3] = new TensorF1(index+1,Iprod,movingRight,denBK);
-            S0tensors[index][cnt2][cnt3] = new TensorS0(index+1,Iprod,movingRight,denBK);
-            if (cnt2>0){ S1tensors[index][cnt2][cnt3] = new TensorS1(index+1,Iprod,movingRight,denBK); }
+            F0tensors[index][cnt2][cnt3] = (recycled!=NULL) ? (TensorF0 *) recycled[next++] : new TensorF0(index+1,Iprod,movingRight,denBK,ownsStorage);
+            F1tensors[index][cnt2][cnt3] = (recycled!=NULL) ? (TensorF1 *) recycled[next++] : new TensorF1(index+1,Iprod,movingRight,denBK,ownsStorage);
+            S0tensors[index][cnt2][cnt3] = (recycled!=NULL) ? (TensorS0 *) recycled[next++] : new TensorS0(index+1,Iprod,movingRight,denBK,ownsStorage);
+            if (cnt2>0){ S1tensors[index][cnt2][cnt3] = (recycled!=NULL) ? (TensorS1 *) recycled[next++] : new TensorS1(index+1,Iprod,movingRight,denBK,ownsStorage); }
          }
       }
    
@@ -562,252 +610,244 @@ void CheMPS2::DMRG::allocateTensors(const int index, const bool movingRight){
          Dtensors[index][cnt2] = new TensorD * [index + 1 - cnt2];
          for (int cnt3=0; cnt3<index+1-cnt2; cnt3++){
             const int Idiff = denBK->directProd(denBK->gIrrep(index-cnt2-cnt3),denBK->gIrrep(index-cnt3));
-            Atensors[index][cnt2][cnt3] = new TensorA(index+1,Idiff,movingRight,denBK);
-            if (cnt2>0){ Btensors[index][cnt2][cnt3] = new TensorB(index+1,Idiff,movingRight,denBK); }
-            Ctensors[index][cnt2][cnt3] = new TensorC(index+1,Idiff,movingRight,denBK);
-            Dtensors[index][cnt2][cnt3] = new TensorD(index+1,Idiff,movingRight,denBK);
+            Atensors[index][cnt2][cnt3] = (recycled!=NULL) ? (TensorA *) recycled[next++] : new TensorA(index+1,Idiff,movingRight,denBK,ownsStorage);
+            if (cnt2>0){ Btensors[index][cnt2][cnt3] = (recycled!=NULL) ? (TensorB *) recycled[next++] : new TensorB(index+1,Idiff,movingRight,denBK,ownsStorage); }
+            Ctensors[index][cnt2][cnt3] = (recycled!=NULL) ? (TensorC *) recycled[next++] : new TensorC(index+1,Idiff,movingRight,denBK,ownsStorage);
+            Dtensors[index][cnt2][cnt3] = (recycled!=NULL) ? (TensorD *) recycled[next++] : new TensorD(index+1,Idiff,movingRight,denBK,ownsStorage);
          }
       }
    
       //Qtensors
       //To left: Qtens[cnt][cnt2] = operator on site cnt-cnt2; at boundary cnt+1
       Qtensors[index] = new TensorQ * [index+1];
-      for (int cnt2=0; cnt2<index+1 ; cnt2++){ Qtensors[index][cnt2] = new TensorQ(index+1,denBK->gIrrep(index-cnt2),movingRight,denBK,Prob,index-cnt2); }
+      for (int cnt2=0; cnt2<index+1 ; cnt2++){ Qtensors[index][cnt2] = (recycled!=NULL) ? (TensorQ *) recycled[next++] : new TensorQ(index+1,denBK->gIrrep(index-cnt2),movingRight,denBK,Prob,index-cnt2,ownsStorage); }
    
       //Xtensors
-      Xtensors[index] = new TensorX(index+1,movingRight,denBK,Prob);
+      Xtensors[index] = (recycled!=NULL) ? (TensorX *) recycled[next++] : new TensorX(index+1,movingRight,denBK,Prob,ownsStorage);
       
       //Otensors
       if (Exc_activated){
          for (int state=0; state<nStates-1; state++){
-            Exc_Overlaps[state][index] = new TensorO(index+1,movingRight,Exc_BKs[state],denBK,Prob);
+            Exc_Overlaps[state][index] = new TensorO(index+1,movingRight,Exc_BKs[state],denBK,Prob,ownsStorage);
          }
       }
    
    }
-
-}
-
-void CheMPS2::DMRG::MY_HDF5_WRITE(const hid_t file_id, const std::string sPath, Tensor * theTensor){
-
-   const int size = theTensor->gKappa2index(theTensor->gNKappa());
-   if (size > 0){
-
-      hid_t group_id          = H5Gcreate(file_id, sPath.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-
-      hsize_t dimarray        = size;
-      hid_t dataspace_id      = H5Screate_simple(1, &dimarray, NULL);
-      hid_t dataset_id        = H5Dcreate(group_id, "tensorStorage", H5T_IEEE_F64LE, dataspace_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-      H5Dwrite(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, theTensor->gStorage());
-
-      H5Dclose(dataset_id);
-      H5Sclose(dataspace_id);
-
-      H5Gclose(group_id);
    
-   }
+   delete [] recycled;
+   
+   if (mapActive){ mapOperators(index, movingRight); }
+   else if (poolActive){ poolOperators(index, movingRight); }
 
 }
 
-void CheMPS2::DMRG::storeOperators(const int index, const bool movingRight){
+int CheMPS2::DMRG::listOperators(const int index, const bool movingRight, Tensor ** list){
 
    const int Nbound = movingRight ? index+1 : Prob->gL()-1-index;
    const int Cbound = movingRight ? Prob->gL()-1-index : index+1;
-
-   std::stringstream thefilename;
-   thefilename << CheMPS2::TMPpath << "CheMPS2_Operators_" << RNstorage << "_index_" << index << ".h5";
-   
-   //The hdf5 file
-   hid_t file_id = H5Fcreate(thefilename.str().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+   int num = 0;
    
-      //Ltensors
-      for (int cnt2=0; cnt2<Nbound ; cnt2++){
-         std::stringstream sstream;
-         sstream << "/Ltensor_" << cnt2 ;
-         MY_HDF5_WRITE(file_id, sstream.str(), Ltensors[index][cnt2]);
-      }
+   //Ltensors
+   for (int cnt2=0; cnt2<Nbound ; cnt2++){
+      if (list!=NULL){ list[num] = Ltensors[index][cnt2]; }
+      num++;
+   }
    
-      //Two-operator tensors
-      for (int cnt2=0; cnt2<Nbound ; cnt2++){
-         for (int cnt3=0; cnt3<Nbound-cnt2 ; cnt3++){
-            
-            std::stringstream sstream1;
-            sstream1 << "/F0tensor_" << cnt2 << "_" << cnt3 ;
-            MY_HDF5_WRITE(file_id, sstream1.str(), F0tensors[index][cnt2][cnt3]);
-            
-            std::stringstream sstream2;
-            sstream2 << "/F1tensor_" << cnt2 << "_" << cnt3 ;
-            MY_HDF5_WRITE(file_id, sstream2.str(), F1tensors[index][cnt2][cnt3]);
-            
-            std::stringstream sstream3;
-            sstream3 << "/S0tensor_" << cnt2 << "_" << cnt3 ;
-            MY_HDF5_WRITE(file_id, sstream3.str(), S0tensors[index][cnt2][cnt3]);
-            
-            if (cnt2>0){
-               std::stringstream sstream4;
-               sstream4 << "/S1tensor_" << cnt2 << "_" << cnt3 ;
-               MY_HDF5_WRITE(file_id, sstream4.str(), S1tensors[index][cnt2][cnt3]);
-            }
-            
+   //Two-operator tensors
+   for (int cnt2=0; cnt2<Nbound ; cnt2++){
+      for (int cnt3=0; cnt3<Nbound-cnt2 ; cnt3++){
+         if (list!=NULL){
+            list[num  ] = F0tensors[index][cnt2][cnt3];
+            list[num+1] = F1tensors[index][cnt2][cnt3];
+            list[num+2] = S0tensors[index][cnt2][cnt3];
+            if (cnt2>0){ list[num+3] = S1tensors[index][cnt2][cnt3]; }
          }
+         num += ((cnt2>0) ? 4 : 3);
       }
+   }
    
-      //Complementary two-operator tensors
-      for (int cnt2=0; cnt2<Cbound ; cnt2++){
-         for (int cnt3=0; cnt3<Cbound-cnt2 ; cnt3++){
-         
-            std::stringstream sstream1;
-            sstream1 << "/Atensor_" << cnt2 << "_" << cnt3 ;
-            MY_HDF5_WRITE(file_id, sstream1.str(), Atensors[index][cnt2][cnt3]);
-            
-            if (cnt2>0){
-               std::stringstream sstream2;
-               sstream2 << "/Btensor_" << cnt2 << "_" << cnt3 ;
-               MY_HDF5_WRITE(file_id, sstream2.str(), Btensors[index][cnt2][cnt3]);
-            }
-            
-            std::stringstream sstream3;
-            sstream3 << "/Ctensor_" << cnt2 << "_" << cnt3 ;
-            MY_HDF5_WRITE(file_id, sstream3.str(), Ctensors[index][cnt2][cnt3]);
-            
-            std::stringstream sstream4;
-            sstream4 << "/Dtensor_" << cnt2 << "_" << cnt3 ;
-            MY_HDF5_WRITE(file_id, sstream4.str(), Dtensors[index][cnt2][cnt3]);
-            
+   //Complementary two-operator tensors
+   for (int cnt2=0; cnt2<Cbound ; cnt2++){
+      for (int cnt3=0; cnt3<Cbound-cnt2 ; cnt3++){
+         if (list!=NULL){
+            list[num] = Atensors[index][cnt2][cnt3];
+            if (cnt2>0){ list[num+1] = Btensors[index][cnt2][cnt3]; }
+            list[num+((cnt2>0)?2:1)] = Ctensors[index][cnt2][cnt3];
+            list[num+((cnt2>0)?3:2)] = Dtensors[index][cnt2][cnt3];
          }
+         num += ((cnt2>0) ? 4 : 3);
       }
+   }
    
-      //Qtensors
-      for (int cnt2=0; cnt2<Cbound ; cnt2++){
-         std::stringstream sstream;
-         sstream << "/Qtensor_" << cnt2 ;
-         MY_HDF5_WRITE(file_id, sstream.str(), Qtensors[index][cnt2]);
-      }
+   //Qtensors
+   for (int cnt2=0; cnt2<Cbound ; cnt2++){
+      if (list!=NULL){ list[num] = Qtensors[index][cnt2]; }
+      num++;
+   }
    
-      //Xtensors
-      std::string sPathX = "/Xtensor" ;
-      MY_HDF5_WRITE(file_id, sPathX, Xtensors[index]);
-      
-      //Otensors
-      if (Exc_activated){
-         for (int state=0; state<nStates-1; state++){
-            std::stringstream sstream;
-            sstream << "/Otensor_" << state ;
-            MY_HDF5_WRITE(file_id, sstream.str(), Exc_Overlaps[state][index]);
-         }
+   //Xtensors
+   if (list!=NULL){ list[num] = Xtensors[index]; }
+   num++;
+   
+   //Otensors
+   if (Exc_activated){
+      for (int state=0; state<nStates-1; state++){
+         if (list!=NULL){ list[num] = Exc_Overlaps[state][index]; }
+         num++;
       }
-
-   H5Fclose(file_id);
+   }
    
+   return num;
+
+}
+
+hid_t CheMPS2::DMRG::openOperatorDataset(const std::string name, const hid_t type, const hsize_t size, const bool compress){
+
+   //The datasets are chunked and extendible, so that they can be rewritten in place when the virtual dimensions change
+   hid_t dataset_id;
+   if (H5Lexists(operatorFile, name.c_str(), H5P_DEFAULT) > 0){
+      dataset_id = H5Dopen(operatorFile, name.c_str(), H5P_DEFAULT);
+      H5Dset_extent(dataset_id, &size);
+   } else {
+      hsize_t maxdims = H5S_UNLIMITED;
+      hsize_t chunk = CheMPS2::DMRG_operatorChunkSize;
+      hid_t dataspace_id = H5Screate_simple(1, &size, &maxdims);
+      hid_t plist_id = H5Pcreate(H5P_DATASET_CREATE);
+      H5Pset_chunk(plist_id, 1, &chunk);
+      if ((compress) && (IOcompression > 0) && (H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0)){
+         H5Pset_shuffle(plist_id);
+         H5Pset_deflate(plist_id, IOcompression);
+      }
+      dataset_id = H5Dcreate(operatorFile, name.c_str(), type, dataspace_id, H5P_DEFAULT, plist_id, H5P_DEFAULT);
+      H5Pclose(plist_id);
+      H5Sclose(dataspace_id);
+   }
+   return dataset_id;
+
 }
 
-void CheMPS2::DMRG::MY_HDF5_READ(const hid_t file_id, const std::string sPath, Tensor * theTensor){
+void CheMPS2::DMRG::transferOperatorData(const hid_t dataset_id, const hsize_t start, const hsize_t size, double * buffer, const bool write){
 
-   const int size = theTensor->gKappa2index(theTensor->gNKappa());
-   if (size > 0){
+   if (size == 0){ return; }
+   hid_t filespace_id = H5Dget_space(dataset_id);
+   H5Sselect_hyperslab(filespace_id, H5S_SELECT_SET, &start, NULL, &size, NULL);
+   hid_t memspace_id = H5Screate_simple(1, &size, NULL);
+   if (write){ H5Dwrite(dataset_id, H5T_NATIVE_DOUBLE, memspace_id, filespace_id, H5P_DEFAULT, buffer); }
+   else {      H5Dread( dataset_id, H5T_NATIVE_DOUBLE, memspace_id, filespace_id, H5P_DEFAULT, buffer); }
+   H5Sclose(memspace_id);
+   H5Sclose(filespace_id);
 
-      hid_t group_id    = H5Gopen(file_id, sPath.c_str(), H5P_DEFAULT);
+}
 
-      hid_t dataset_id  = H5Dopen(group_id, "tensorStorage", H5P_DEFAULT);
-      H5Dread(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, theTensor->gStorage());
-      
-      H5Dclose(dataset_id);
+void CheMPS2::DMRG::closeOperatorFile(){
 
-      H5Gclose(group_id);
-      
+   if (operatorFile >= 0){
+      H5Fclose(operatorFile);
+      operatorFile = -1;
    }
 
 }
 
-void CheMPS2::DMRG::loadOperators(const int index, const bool movingRight){
-
-   const int Nbound = movingRight ? index+1 : Prob->gL()-1-index;
-   const int Cbound = movingRight ? Prob->gL()-1-index : index+1;
+void CheMPS2::DMRG::storeOperators(const int index, const bool movingRight){
 
-   std::stringstream thefilename;
-   thefilename << CheMPS2::TMPpath << "CheMPS2_Operators_" << RNstorage << "_index_" << index << ".h5";
-   
-   //The hdf5 file
-   hid_t file_id = H5Fopen(thefilename.str().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+   //All operators of boundary index form one contiguous blob: dataset "/index_<index>" in a single file, with the offset table "/offsets_<index>"
+   const int num = listOperators(index, movingRight, NULL);
+   Tensor ** list = new Tensor*[num];
+   listOperators(index, movingRight, list);
+   long long * offsets = new long long[num+1];
+   offsets[0] = 0;
+   for (int cnt=0; cnt<num; cnt++){ offsets[cnt+1] = offsets[cnt] + list[cnt]->gKappa2index(list[cnt]->gNKappa()); }
+   
+   if (operatorFile < 0){
+      std::stringstream thefilename;
+      thefilename << CheMPS2::TMPpath << "CheMPS2_Operators_" << RNstorage << ".h5";
+      operatorFile = H5Fcreate(thefilename.str().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+   }
    
-      //Ltensors
-      for (int cnt2=0; cnt2<Nbound ; cnt2++){
-         std::stringstream sstream;
-         sstream << "/Ltensor_" << cnt2 ;
-         MY_HDF5_READ(file_id, sstream.str(), Ltensors[index][cnt2]);
-      }
-      
-      //Two-operator tensors
-      for (int cnt2=0; cnt2<Nbound ; cnt2++){
-         for (int cnt3=0; cnt3<Nbound-cnt2 ; cnt3++){
-         
-            std::stringstream sstream1;
-            sstream1 << "/F0tensor_" << cnt2 << "_" << cnt3 ;
-            MY_HDF5_READ(file_id, sstream1.str(), F0tensors[index][cnt2][cnt3]);
-            
-            std::stringstream sstream2;
-            sstream2 << "/F1tensor_" << cnt2 << "_" << cnt3 ;
-            MY_HDF5_READ(file_id, sstream2.str(), F1tensors[index][cnt2][cnt3]);
-            
-            std::stringstream sstream3;
-            sstream3 << "/S0tensor_" << cnt2 << "_" << cnt3 ;
-            MY_HDF5_READ(file_id, sstream3.str(), S0tensors[index][cnt2][cnt3]);
-            
-            if (cnt2>0){
-               std::stringstream sstream4;
-               sstream4 << "/S1tensor_" << cnt2 << "_" << cnt3 ;
-               MY_HDF5_READ(file_id, sstream4.str(), S1tensors[index][cnt2][cnt3]);
-            }
-                        
+   std::stringstream offsetname;
+   offsetname << "/offsets_" << index;
+   hid_t offset_id = openOperatorDataset(offsetname.str(), H5T_NATIVE_LLONG, num+1, false);
+   H5Dwrite(offset_id, H5T_NATIVE_LLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, offsets);
+   H5Dclose(offset_id);
+   
+   //The tensors are gathered in a staging buffer of one chunk, which is written when full
+   std::stringstream blobname;
+   blobname << "/index_" << index;
+   hid_t blob_id = openOperatorDataset(blobname.str(), H5T_NATIVE_DOUBLE, offsets[num], true);
+   const hsize_t chunk = CheMPS2::DMRG_operatorChunkSize;
+   double * buffer = new double[chunk];
+   hsize_t written = 0;
+   hsize_t filled = 0;
+   for (int cnt=0; cnt<num; cnt++){
+      const hsize_t size = offsets[cnt+1] - offsets[cnt];
+      hsize_t done = 0;
+      while (done < size){
+         const hsize_t piece = ((size - done) < (chunk - filled)) ? (size - done) : (chunk - filled);
+         memcpy(buffer + filled, list[cnt]->gStorage() + done, sizeof(double) * piece);
+         done += piece;
+         filled += piece;
+         if (filled == chunk){
+            transferOperatorData(blob_id, written, filled, buffer, true);
+            written += filled;
+            filled = 0;
          }
       }
-      
-      //Complementary two-operator tensors
-      for (int cnt2=0; cnt2<Cbound ; cnt2++){
-         for (int cnt3=0; cnt3<Cbound-cnt2 ; cnt3++){
-         
-            std::stringstream sstream1;
-            sstream1 << "/Atensor_" << cnt2 << "_" << cnt3 ;
-            MY_HDF5_READ(file_id, sstream1.str(), Atensors[index][cnt2][cnt3]);
-            
-            if (cnt2>0){
-               std::stringstream sstream2;
-               sstream2 << "/Btensor_" << cnt2 << "_" << cnt3 ;
-               MY_HDF5_READ(file_id, sstream2.str(), Btensors[index][cnt2][cnt3]);
-            }
-            
-            std::stringstream sstream3;
-            sstream3 << "/Ctensor_" << cnt2 << "_" << cnt3 ;
-            MY_HDF5_READ(file_id, sstream3.str(), Ctensors[index][cnt2][cnt3]);
-            
-            std::stringstream sstream4;
-            sstream4 << "/Dtensor_" << cnt2 << "_" << cnt3 ;
-            MY_HDF5_READ(file_id, sstream4.str(), Dtensors[index][cnt2][cnt3]);
-            
-         }
-      }
-      
-      //Qtensors
-      for (int cnt2=0; cnt2<Cbound ; cnt2++){
-         std::stringstream sstream;
-         sstream << "/Qtensor_" << cnt2 ;
-         MY_HDF5_READ(file_id, sstream.str(), Qtensors[index][cnt2]);
+   }
+   transferOperatorData(blob_id, written, filled, buffer, true);
+   H5Dclose(blob_id);
+   
+   delete [] buffer;
+   delete [] offsets;
+   delete [] list;
+   
+}
+
+void CheMPS2::DMRG::loadOperators(const int index, const bool movingRight){
+
+   const int num = listOperators(index, movingRight, NULL);
+   Tensor ** list = new Tensor*[num];
+   listOperators(index, movingRight, list);
+   long long * offsets = new long long[num+1];
+   
+   std::stringstream offsetname;
+   offsetname << "/offsets_" << index;
+   hid_t offset_id = H5Dopen(operatorFile, offsetname.str().c_str(), H5P_DEFAULT);
+   H5Dread(offset_id, H5T_NATIVE_LLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, offsets);
+   H5Dclose(offset_id);
+   for (int cnt=0; cnt<num; cnt++){
+      if (offsets[cnt+1] - offsets[cnt] != list[cnt]->gKappa2index(list[cnt]->gNKappa())){
+         cout << "DMRG::loadOperators : The stored operators of boundary " << index << " do not match the allocated tensors!" << endl;
       }
-      
-      //Xtensors
-      std::string sPathX = "/Xtensor";
-      MY_HDF5_READ(file_id, sPathX, Xtensors[index]);
-      
-      //Otensors
-      if (Exc_activated){
-         for (int state=0; state<nStates-1; state++){
-            std::stringstream sstream;
-            sstream << "/Otensor_" << state ;
-            MY_HDF5_READ(file_id, sstream.str(), Exc_Overlaps[state][index]);
+   }
+   
+   std::stringstream blobname;
+   blobname << "/index_" << index;
+   hid_t blob_id = H5Dopen(operatorFile, blobname.str().c_str(), H5P_DEFAULT);
+   const hsize_t chunk = CheMPS2::DMRG_operatorChunkSize;
+   double * buffer = new double[chunk];
+   hsize_t bufferStart = 0; //The blob offset of buffer[0]
+   hsize_t bufferSize = 0;  //The number of valid elements in buffer
+   for (int cnt=0; cnt<num; cnt++){
+      const hsize_t size = offsets[cnt+1] - offsets[cnt];
+      hsize_t done = 0;
+      while (done < size){
+         const hsize_t position = offsets[cnt] + done;
+         if (position >= bufferStart + bufferSize){
+            bufferStart = position;
+            bufferSize = ((offsets[num] - position) < chunk) ? (offsets[num] - position) : chunk;
+            transferOperatorData(blob_id, bufferStart, bufferSize, buffer, false);
          }
+         const hsize_t available = bufferStart + bufferSize - position;
+         const hsize_t piece = ((size - done) < available) ? (size - done) : available;
+         memcpy(list[cnt]->gStorage() + done, buffer + (position - bufferStart), sizeof(double) * piece);
+         done += piece;
       }
+   }
+   H5Dclose(blob_id);
    
-   H5Fclose(file_id);
+   delete [] buffer;
+   delete [] offsets;
+   delete [] list;
 
 }
 
@@ -816,18 +856,19 @@ void CheMPS2::DMRG::deleteTensors(const int index, const bool movingRightOfTenso
    const int upperBoundNormal = (( movingRightOfTensors)?(index+1):(Prob->gL()-1-index));
    const int upperBoundComple = ((!movingRightOfTensors)?(index+1):(Prob->gL()-1-index));
    
+   //The tensor objects are kept for reuse with the pool, and deleted otherwise
+   const int num = listOperators(index, movingRightOfTensors, NULL);
+   Tensor ** list = new Tensor*[num];
+   listOperators(index, movingRightOfTensors, list);
+   const int numKept = (poolActive) ? parkOperators(index, movingRightOfTensors, list, num) : 0;
+   for (int cnt=numKept; cnt<num; cnt++){ delete list[cnt]; }
+   delete [] list;
+   
    //Ltensors
-   for (int cnt2=0; cnt2<upperBoundNormal; cnt2++){ delete Ltensors[index][cnt2]; }
    delete [] Ltensors[index];
    
    //Two-operator tensors
    for (int cnt2=0; cnt2<upperBoundNormal; cnt2++){
-      for (int cnt3=0; cnt3<upperBoundNormal-cnt2; cnt3++){
-         delete F0tensors[index][cnt2][cnt3];
-         delete F1tensors[index][cnt2][cnt3];
-         delete S0tensors[index][cnt2][cnt3];
-         if (cnt2>0){ delete S1tensors[index][cnt2][cnt3]; }
-      }
       delete [] F0tensors[index][cnt2];
       delete [] F1tensors[index][cnt2];
       delete [] S0tensors[index][cnt2];
@@ -840,12 +881,6 @@ void CheMPS2::DMRG::deleteTensors(const int index, const bool movingRightOfTenso
    
    //Complementary two-operator tensors
    for (int cnt2=0; cnt2<upperBoundComple; cnt2++){
-      for (int cnt3=0; cnt3<upperBoundComple-cnt2; cnt3++){
-         delete Atensors[index][cnt2][cnt3];
-         if (cnt2>0){ delete Btensors[index][cnt2][cnt3]; }
-         delete Ctensors[index][cnt2][cnt3];
-         delete Dtensors[index][cnt2][cnt3];
-      }
       delete [] Atensors[index][cnt2];
       if (cnt2>0){ delete [] Btensors[index][cnt2]; }
       delete [] Ctensors[index][cnt2];
@@ -857,21 +892,17 @@ void CheMPS2::DMRG::deleteTensors(const int index, const bool movingRightOfTenso
    delete [] Dtensors[index];
    
    //Qtensors
-   for (int cnt2=0; cnt2<upperBoundComple ; cnt2++){ delete Qtensors[index][cnt2]; }
    delete [] Qtensors[index];
    
-   //Xtensors
-   delete Xtensors[index];
-   
-   //Otensors
-   if (Exc_activated){
-      for (int state=0; state<nStates-1; state++){ delete Exc_Overlaps[state][index]; }
-   }
+   unmapOperators(index);
+   releaseOperators(index);
    
 }
 
 void CheMPS2::DMRG::deleteStoredOperators(){
 
+   flushOperatorIO();
+   closeOperatorFile();
    std::stringstream temp;
    temp << "rm " << CheMPS2::TMPpath << "CheMPS2_Operators_" << RNstorage << "*.h5";
    int info = system(temp.str().c_str());
@@ -879,3 +910,11 @@ void CheMPS2::DMRG::deleteStoredOperators(){
 
 }
 
+void CheMPS2::DMRG::deleteOperators(){
+
+   deleteAllBoundaryOperators();
+   stopOperatorIOthread();
+   trimOperatorPool();
+
+}
+
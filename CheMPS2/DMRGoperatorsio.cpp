@@ -0,0 +1,318 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <iostream>
+
+#include "DMRG.h"
+
+using std::cout;
+using std::endl;
+
+void CheMPS2::DMRG::startOperatorIO(){
+
+   IOactive = false;
+   IOstop = false;
+   IOnumJobs = 0;
+   IOfirstJob = 0;
+   IOjobType = new int[CheMPS2::DMRG_operatorIOqueueLength];
+   IOjobIndex = new int[CheMPS2::DMRG_operatorIOqueueLength];
+   IOjobMovingRight = new bool[CheMPS2::DMRG_operatorIOqueueLength];
+   IOpending = new int[Prob->gL()-1];
+   IOprefetched = new bool[Prob->gL()-1];
+   IOresident = new bool[Prob->gL()-1];
+   IOlastNeeded = new long long[Prob->gL()-1];
+   for (int cnt=0; cnt<Prob->gL()-1; cnt++){
+      IOpending[cnt] = 0;
+      IOprefetched[cnt] = false;
+      IOresident[cnt] = false;
+      IOlastNeeded[cnt] = 0;
+   }
+   IOclock = 0;
+   IObudget = 1048576.0 * CheMPS2::DMRG_operatorMemoryBudgetMB;
+
+   if ((IOstoreOnDisk) && (!mapActive) && (IOasync) && (CheMPS2::DMRG_operatorIOqueueLength > 0)){
+      pthread_mutex_init(&IOmutex, NULL);
+      pthread_cond_init(&IOworkCond, NULL);
+      pthread_cond_init(&IOdoneCond, NULL);
+      IOactive = (pthread_create(&IOthread, NULL, operatorIOthread, this) == 0);
+      if (!IOactive){
+         cout << "DMRG::startOperatorIO : The I/O thread could not be created. The renormalized operators are stored synchronously." << endl;
+         pthread_mutex_destroy(&IOmutex);
+         pthread_cond_destroy(&IOworkCond);
+         pthread_cond_destroy(&IOdoneCond);
+      }
+   }
+
+}
+
+void CheMPS2::DMRG::stopOperatorIO(){
+
+   stopOperatorIOthread();
+   delete [] IOjobType;
+   delete [] IOjobIndex;
+   delete [] IOjobMovingRight;
+   delete [] IOpending;
+   delete [] IOprefetched;
+   delete [] IOresident;
+   delete [] IOlastNeeded;
+
+}
+
+void CheMPS2::DMRG::stopOperatorIOthread(){
+
+   if (IOactive){
+      flushOperatorIO();
+      pthread_mutex_lock(&IOmutex);
+      IOstop = true;
+      pthread_cond_signal(&IOworkCond);
+      pthread_mutex_unlock(&IOmutex);
+      pthread_join(IOthread, NULL);
+      pthread_mutex_destroy(&IOmutex);
+      pthread_cond_destroy(&IOworkCond);
+      pthread_cond_destroy(&IOdoneCond);
+      IOactive = false;
+   }
+
+}
+
+void CheMPS2::DMRG::runOperatorIO(const int type, const int index, const bool movingRight){
+
+   if (type==OPERATORIO_STORE){
+      storeOperators(index, movingRight);
+      deleteTensors(index, movingRight);
+   }
+   if (type==OPERATORIO_LOAD){
+      loadOperators(index, movingRight);
+   }
+
+}
+
+void * CheMPS2::DMRG::operatorIOthread(void * dmrg){
+
+   DMRG * theDMRG = (DMRG *) dmrg;
+
+   pthread_mutex_lock(&(theDMRG->IOmutex));
+   while (true){
+
+      while ((theDMRG->IOnumJobs == 0) && (!(theDMRG->IOstop))){ pthread_cond_wait(&(theDMRG->IOworkCond), &(theDMRG->IOmutex)); }
+      if (theDMRG->IOnumJobs == 0){ break; } //IOstop and nothing left to do
+
+      //The job stays in the queue while it runs, so that its slot is not reused
+      const int type = theDMRG->IOjobType[theDMRG->IOfirstJob];
+      const int index = theDMRG->IOjobIndex[theDMRG->IOfirstJob];
+      const bool movingRight = theDMRG->IOjobMovingRight[theDMRG->IOfirstJob];
+      pthread_mutex_unlock(&(theDMRG->IOmutex));
+
+      theDMRG->runOperatorIO(type, index, movingRight);
+
+      pthread_mutex_lock(&(theDMRG->IOmutex));
+      theDMRG->IOfirstJob = (theDMRG->IOfirstJob + 1) % CheMPS2::DMRG_operatorIOqueueLength;
+      theDMRG->IOnumJobs--;
+      theDMRG->IOpending[index]--;
+      pthread_cond_broadcast(&(theDMRG->IOdoneCond));
+
+   }
+   pthread_mutex_unlock(&(theDMRG->IOmutex));
+
+   return NULL;
+
+}
+
+void CheMPS2::DMRG::enqueueOperatorIO(const int type, const int index, const bool movingRight){
+
+   if (!IOactive){
+      runOperatorIO(type, index, movingRight);
+      return;
+   }
+
+   pthread_mutex_lock(&IOmutex);
+   while (IOnumJobs == CheMPS2::DMRG_operatorIOqueueLength){ pthread_cond_wait(&IOdoneCond, &IOmutex); }
+   const int slot = (IOfirstJob + IOnumJobs) % CheMPS2::DMRG_operatorIOqueueLength;
+   IOjobType[slot] = type;
+   IOjobIndex[slot] = index;
+   IOjobMovingRight[slot] = movingRight;
+   IOnumJobs++;
+   IOpending[index]++;
+   pthread_cond_signal(&IOworkCond);
+   pthread_mutex_unlock(&IOmutex);
+
+}
+
+void CheMPS2::DMRG::waitOperatorIO(const int index){
+
+   if (!IOactive){ return; }
+
+   pthread_mutex_lock(&IOmutex);
+   while (IOpending[index] > 0){ pthread_cond_wait(&IOdoneCond, &IOmutex); }
+   pthread_mutex_unlock(&IOmutex);
+
+}
+
+void CheMPS2::DMRG::flushOperatorIO(){
+
+   if (!IOactive){ return; }
+
+   pthread_mutex_lock(&IOmutex);
+   while (IOnumJobs > 0){ pthread_cond_wait(&IOdoneCond, &IOmutex); }
+   pthread_mutex_unlock(&IOmutex);
+
+}
+
+void CheMPS2::DMRG::setOperatorMemoryBudget(const double megabytes){
+
+   IObudget = 1048576.0 * megabytes;
+   if (IObudget < 0.0){ IObudget = 0.0; }
+
+}
+
+void CheMPS2::DMRG::setOperatorStorage(const bool storeOnDisk, const bool mapOnDisk, const bool asyncIO){
+
+   //Tear down the operators and the machinery of the current mode, and rebuild them in the new one
+   const double budget = IObudget;
+   deleteAllBoundaryOperators();
+   if ((IOstoreOnDisk) && (!mapActive)){ deleteStoredOperators(); }
+   stopOperatorIO();
+   stopOperatorPool();
+   stopOperatorMap();
+   IOstoreOnDisk = storeOnDisk;
+   mapActive = mapOnDisk;
+   IOasync = asyncIO;
+   startOperatorMap();
+   startOperatorPool();
+   startOperatorIO();
+   IObudget = budget;
+   PreSolve();
+
+}
+
+void CheMPS2::DMRG::setOperatorCompression(const int level){
+
+   //The filters of the existing datasets cannot be changed, so the stored operators are written anew
+   deleteAllBoundaryOperators();
+   if ((IOstoreOnDisk) && (!mapActive)){ deleteStoredOperators(); }
+   IOcompression = level;
+   PreSolve();
+
+}
+
+double CheMPS2::DMRG::operatorFootprint(const int index, const bool movingRight){
+
+   //Every operator at boundary index+1 is estimated as a block-diagonal matrix over the current virtual sectors
+   const int bound = index+1;
+   double blocks = 0.0;
+   for (int N=denBK->gNmin(bound); N<=denBK->gNmax(bound); N++){
+      for (int TwoS=denBK->gTwoSmin(bound,N); TwoS<=denBK->gTwoSmax(bound,N); TwoS+=2){
+         for (int Irrep=0; Irrep<denBK->getNumberOfIrreps(); Irrep++){
+            const double dim = denBK->gCurrentDim(bound,N,TwoS,Irrep);
+            blocks += dim * dim;
+         }
+      }
+   }
+   const int num = listOperators(index, movingRight, NULL);
+   return sizeof(double) * num * blocks;
+
+}
+
+void CheMPS2::DMRG::spillOperators(const int index){
+
+   //The tensors of boundary index are handed over to the I/O thread, which stores and deletes them
+   enqueueOperatorIO(OPERATORIO_STORE, index, (isAllocated[index]==1));
+   isAllocated[index] = 0;
+   IOresident[index] = false;
+
+}
+
+void CheMPS2::DMRG::storeOperatorsBehind(const int index){
+
+   IOlastNeeded[index] = ++IOclock;
+   if (IObudget > 0.0){
+
+      //Keep boundary index in memory if the operators of all allocated boundaries fit in the budget, after spilling the least recently needed resident boundaries
+      double total = 0.0;
+      for (int cnt=0; cnt<Prob->gL()-1; cnt++){
+         if (isAllocated[cnt]!=0){ total += operatorFootprint(cnt, (isAllocated[cnt]==1)); }
+      }
+      while (total > IObudget){
+         int victim = -1;
+         for (int cnt=0; cnt<Prob->gL()-1; cnt++){
+            if ((cnt!=index) && (IOresident[cnt]) && (isAllocated[cnt]!=0)){
+               if ((victim==-1) || (IOlastNeeded[cnt] < IOlastNeeded[victim])){ victim = cnt; }
+            }
+         }
+         if (victim==-1){ break; }
+         total -= operatorFootprint(victim, (isAllocated[victim]==1));
+         spillOperators(victim);
+      }
+      if (total <= IObudget){
+         IOresident[index] = true;
+         return;
+      }
+
+   }
+   spillOperators(index);
+
+}
+
+void CheMPS2::DMRG::loadOperatorsNow(const int index, const bool movingRight){
+
+   waitOperatorIO(index);
+   IOlastNeeded[index] = ++IOclock;
+   IOresident[index] = false;
+   const int allocatedAs = (movingRight) ? 1 : 2;
+   if (isAllocated[index]==allocatedAs){ //Prefetched, or kept resident within the memory budget
+      IOprefetched[index] = false;
+      return;
+   }
+   IOprefetched[index] = false;
+
+   if (isAllocated[index]==3-allocatedAs){
+      deleteTensors(index, !movingRight);
+      isAllocated[index]=0;
+   }
+   if (isAllocated[index]==0){
+      allocateTensors(index, movingRight);
+      isAllocated[index]=allocatedAs;
+   }
+   enqueueOperatorIO(OPERATORIO_LOAD, index, movingRight);
+   waitOperatorIO(index);
+
+}
+
+void CheMPS2::DMRG::prefetchOperators(const int index, const bool movingRight){
+
+   if (!IOactive){ return; } //Only useful when the I/O overlaps with the computation
+
+   waitOperatorIO(index);
+   const int allocatedAs = (movingRight) ? 1 : 2;
+   if (isAllocated[index]==allocatedAs){ //Still resident
+      IOlastNeeded[index] = ++IOclock;
+      IOresident[index] = false;
+      return;
+   }
+   if (isAllocated[index]==3-allocatedAs){
+      deleteTensors(index, !movingRight);
+      isAllocated[index]=0;
+   }
+   allocateTensors(index, movingRight);
+   isAllocated[index]=allocatedAs;
+   enqueueOperatorIO(OPERATORIO_LOAD, index, movingRight);
+   IOprefetched[index] = true;
+
+}
+
@@ -0,0 +1,105 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <iostream>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "DMRG.h"
+
+using std::cout;
+using std::endl;
+
+void CheMPS2::DMRG::startOperatorMap(){
+
+   mapFile = new int[Prob->gL()-1];
+   mapStorage = new double*[Prob->gL()-1];
+   mapBytes = new size_t[Prob->gL()-1];
+   for (int cnt=0; cnt<Prob->gL()-1; cnt++){
+      mapFile[cnt] = -1;
+      mapStorage[cnt] = NULL;
+      mapBytes[cnt] = 0;
+   }
+
+}
+
+void CheMPS2::DMRG::stopOperatorMap(){
+
+   for (int cnt=0; cnt<Prob->gL()-1; cnt++){
+      unmapOperators(cnt);
+      if (mapFile[cnt] >= 0){ close(mapFile[cnt]); }
+   }
+   delete [] mapFile;
+   delete [] mapStorage;
+   delete [] mapBytes;
+
+}
+
+void CheMPS2::DMRG::mapOperators(const int index, const bool movingRight){
+
+   //The tensors are placed one after the other, each one aligned to a cache line
+   const int num = listOperators(index, movingRight, NULL);
+   Tensor ** list = new Tensor*[num];
+   listOperators(index, movingRight, list);
+   const size_t total = operatorRegionSize(list, num);
+   const size_t page = sysconf(_SC_PAGESIZE);
+   const size_t bytes = ((sizeof(double) * total + page - 1) / page) * page;
+
+   //One file per boundary, which is unlinked immediately: it disappears with the DMRG object, or when the program is killed
+   if (mapFile[index] < 0){
+      std::stringstream thefilename;
+      thefilename << CheMPS2::TMPpath << "CheMPS2_Operators_" << RNstorage << "_map_" << index << ".bin";
+      mapFile[index] = open(thefilename.str().c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+      if (mapFile[index] >= 0){ unlink(thefilename.str().c_str()); }
+   }
+
+   bool success = ((mapFile[index] >= 0) && (bytes > 0));
+   if (success){ success = (ftruncate(mapFile[index], bytes) == 0); }
+   if (success){
+      void * region = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, mapFile[index], 0);
+      success = (region != MAP_FAILED);
+      if (success){
+         mapStorage[index] = (double *) region;
+         mapBytes[index] = bytes;
+      }
+   }
+
+   if (success){
+      attachOperatorRegion(list, num, mapStorage[index]);
+   } else {
+      if (bytes > 0){ cout << "DMRG::mapOperators : The operators of boundary " << index << " could not be mapped to a file in " << CheMPS2::TMPpath << ". They are kept in memory." << endl; }
+      poolOperators(index, movingRight); //The tensors were allocated without storage
+   }
+
+   delete [] list;
+
+}
+
+void CheMPS2::DMRG::unmapOperators(const int index){
+
+   if (mapStorage[index] != NULL){
+      munmap(mapStorage[index], mapBytes[index]);
+      mapStorage[index] = NULL;
+      mapBytes[index] = 0;
+   }
+
+}
+
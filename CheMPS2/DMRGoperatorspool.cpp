@@ -0,0 +1,240 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include "DMRG.h"
+
+void CheMPS2::DMRG::startOperatorPool(){
+
+   poolActive = ((CheMPS2::DMRG_operatorPoolRegions > 0) && (!mapActive));
+   poolStorage = new double*[Prob->gL()-1];
+   poolSize = new size_t[Prob->gL()-1];
+   for (int cnt=0; cnt<Prob->gL()-1; cnt++){
+      poolStorage[cnt] = NULL;
+      poolSize[cnt] = 0;
+   }
+   poolNumIdle = 0;
+   poolIdle = new double*[CheMPS2::DMRG_operatorPoolRegions+1];
+   poolIdleSize = new size_t[CheMPS2::DMRG_operatorPoolRegions+1];
+   pthread_mutex_init(&poolMutex, NULL);
+   
+   parkedTensors = new Tensor**[2*(Prob->gL()-1)];
+   parkedNum = new int[2*(Prob->gL()-1)];
+   parkedDims = new int*[2*(Prob->gL()-1)];
+   for (int slot=0; slot<2*(Prob->gL()-1); slot++){
+      parkedTensors[slot] = NULL;
+      parkedNum[slot] = 0;
+      parkedDims[slot] = NULL;
+   }
+   allocatedDims = new int*[Prob->gL()-1];
+   for (int cnt=0; cnt<Prob->gL()-1; cnt++){ allocatedDims[cnt] = NULL; }
+
+}
+
+void CheMPS2::DMRG::stopOperatorPool(){
+
+   for (int cnt=0; cnt<Prob->gL()-1; cnt++){ delete [] poolStorage[cnt]; }
+   for (int cnt=0; cnt<poolNumIdle; cnt++){ delete [] poolIdle[cnt]; }
+   delete [] poolStorage;
+   delete [] poolSize;
+   delete [] poolIdle;
+   delete [] poolIdleSize;
+   pthread_mutex_destroy(&poolMutex);
+   
+   for (int slot=0; slot<2*(Prob->gL()-1); slot++){ deleteParkedOperators(slot); }
+   delete [] parkedTensors;
+   delete [] parkedNum;
+   delete [] parkedDims;
+   for (int cnt=0; cnt<Prob->gL()-1; cnt++){ delete [] allocatedDims[cnt]; }
+   delete [] allocatedDims;
+
+}
+
+size_t CheMPS2::DMRG::operatorRegionSize(Tensor ** list, const int num){
+
+   size_t total = 0;
+   for (int cnt=0; cnt<num; cnt++){
+      const size_t size = list[cnt]->gKappa2index(list[cnt]->gNKappa());
+      total += ((size + OPERATORREGION_ALIGN - 1) / OPERATORREGION_ALIGN) * OPERATORREGION_ALIGN;
+   }
+   return total;
+
+}
+
+void CheMPS2::DMRG::attachOperatorRegion(Tensor ** list, const int num, double * region){
+
+   size_t offset = 0;
+   for (int cnt=0; cnt<num; cnt++){
+      const size_t size = list[cnt]->gKappa2index(list[cnt]->gNKappa());
+      list[cnt]->attachStorage(region + offset);
+      offset += ((size + OPERATORREGION_ALIGN - 1) / OPERATORREGION_ALIGN) * OPERATORREGION_ALIGN;
+   }
+
+}
+
+void CheMPS2::DMRG::poolOperators(const int index, const bool movingRight){
+
+   const int num = listOperators(index, movingRight, NULL);
+   Tensor ** list = new Tensor*[num];
+   listOperators(index, movingRight, list);
+   const size_t total = operatorRegionSize(list, num);
+
+   //Take the smallest idle region which is large enough. As long as the virtual dimensions do not change, the region released by the other direction at this boundary, or by a neighbouring boundary, usually fits.
+   double * region = NULL;
+   size_t size = 0;
+   pthread_mutex_lock(&poolMutex);
+   int best = -1;
+   for (int cnt=0; cnt<poolNumIdle; cnt++){
+      if ((poolIdleSize[cnt] >= total) && ((best==-1) || (poolIdleSize[cnt] < poolIdleSize[best]))){ best = cnt; }
+   }
+   if (best!=-1){
+      region = poolIdle[best];
+      size = poolIdleSize[best];
+      poolNumIdle--;
+      poolIdle[best] = poolIdle[poolNumIdle];
+      poolIdleSize[best] = poolIdleSize[poolNumIdle];
+   }
+   pthread_mutex_unlock(&poolMutex);
+
+   //Otherwise allocate a new one, with some slack for the next time the dimensions grow a little
+   if (region==NULL){
+      size = total + total / OPERATORREGION_SLACK;
+      region = new double[size];
+   }
+
+   attachOperatorRegion(list, num, region);
+   poolStorage[index] = region;
+   poolSize[index] = size;
+
+   delete [] list;
+
+}
+
+void CheMPS2::DMRG::releaseOperators(const int index){
+
+   if (poolStorage[index] == NULL){ return; }
+
+   //Keep the region idle. When there are too many idle regions, the smallest one is freed.
+   pthread_mutex_lock(&poolMutex);
+   poolIdle[poolNumIdle] = poolStorage[index];
+   poolIdleSize[poolNumIdle] = poolSize[index];
+   poolNumIdle++;
+   double * victim = NULL;
+   if (poolNumIdle > CheMPS2::DMRG_operatorPoolRegions){
+      int smallest = 0;
+      for (int cnt=1; cnt<poolNumIdle; cnt++){
+         if (poolIdleSize[cnt] < poolIdleSize[smallest]){ smallest = cnt; }
+      }
+      victim = poolIdle[smallest];
+      poolNumIdle--;
+      poolIdle[smallest] = poolIdle[poolNumIdle];
+      poolIdleSize[smallest] = poolIdleSize[poolNumIdle];
+   }
+   pthread_mutex_unlock(&poolMutex);
+   delete [] victim;
+
+   poolStorage[index] = NULL;
+   poolSize[index] = 0;
+
+}
+
+void CheMPS2::DMRG::trimOperatorPool(){
+
+   pthread_mutex_lock(&poolMutex);
+   for (int cnt=0; cnt<poolNumIdle; cnt++){ delete [] poolIdle[cnt]; }
+   poolNumIdle = 0;
+   pthread_mutex_unlock(&poolMutex);
+
+}
+
+
+int CheMPS2::DMRG::boundaryDims(const int boundary, int * dims) const{
+
+   int num = 0;
+   for (int N=denBK->gNmin(boundary); N<=denBK->gNmax(boundary); N++){
+      for (int TwoS=denBK->gTwoSmin(boundary,N); TwoS<=denBK->gTwoSmax(boundary,N); TwoS+=2){
+         for (int Icnt=0; Icnt<denBK->getNumberOfIrreps(); Icnt++){
+            if (dims!=NULL){ dims[num] = denBK->gCurrentDim(boundary,N,TwoS,Icnt); }
+            num++;
+         }
+      }
+   }
+   return num;
+
+}
+
+int CheMPS2::DMRG::parkOperators(const int index, const bool movingRight, Tensor ** list, const int num){
+
+   //The Otensors are at the end of the list, and are not kept
+   const int numKept = (Exc_activated) ? num - (nStates-1) : num;
+   if (allocatedDims[index] == NULL){ return 0; }
+   const int slot = 2*index + ((movingRight) ? 0 : 1);
+   deleteParkedOperators(slot);
+   
+   parkedTensors[slot] = new Tensor*[numKept];
+   for (int cnt=0; cnt<numKept; cnt++){
+      list[cnt]->attachStorage(NULL); //The region goes back to the pool
+      parkedTensors[slot][cnt] = list[cnt];
+   }
+   parkedNum[slot] = numKept;
+   parkedDims[slot] = allocatedDims[index]; //The virtual dimensions may have changed since, by the decomposition of the last site
+   allocatedDims[index] = NULL;
+   
+   return numKept;
+
+}
+
+CheMPS2::Tensor ** CheMPS2::DMRG::unparkOperators(const int index, const bool movingRight){
+
+   //The block structure of all operators of a boundary follows from the virtual dimensions at that boundary
+   delete [] allocatedDims[index];
+   const int numDims = boundaryDims(index+1, NULL);
+   allocatedDims[index] = new int[numDims];
+   boundaryDims(index+1, allocatedDims[index]);
+
+   const int slot = 2*index + ((movingRight) ? 0 : 1);
+   if (parkedTensors[slot] == NULL){ return NULL; }
+   bool unchanged = true;
+   for (int cnt=0; cnt<numDims; cnt++){
+      if (allocatedDims[index][cnt] != parkedDims[slot][cnt]){ unchanged = false; }
+   }
+   if (!unchanged){
+      deleteParkedOperators(slot);
+      return NULL;
+   }
+   
+   Tensor ** list = parkedTensors[slot];
+   delete [] parkedDims[slot];
+   parkedTensors[slot] = NULL;
+   parkedNum[slot] = 0;
+   parkedDims[slot] = NULL;
+   return list;
+
+}
+
+void CheMPS2::DMRG::deleteParkedOperators(const int slot){
+
+   if (parkedTensors[slot] == NULL){ return; }
+   for (int cnt=0; cnt<parkedNum[slot]; cnt++){ delete parkedTensors[slot][cnt]; }
+   delete [] parkedTensors[slot];
+   delete [] parkedDims[slot];
+   parkedTensors[slot] = NULL;
+   parkedNum[slot] = 0;
+   parkedDims[slot] = NULL;
+
+}
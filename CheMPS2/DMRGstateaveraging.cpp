@@ -0,0 +1,142 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <iostream>
+#include <sys/time.h>
+
+#include "DMRG.h"
+#include "ScratchArena.h"
+
+using std::cout;
+using std::endl;
+
+void CheMPS2::DMRG::activateStateAveraging(const int nRootsIn){
+
+   if (Exc_activated){
+      cout << "DMRG::activateStateAveraging : state averaging cannot be combined with excitations!" << endl;
+      return;
+   }
+   if (SA_activated){
+      cout << "DMRG::activateStateAveraging : state averaging has already been activated!" << endl;
+      return;
+   }
+   if (nRootsIn<2){ return; }
+
+   SA_activated = true;
+   SA_nRoots = nRootsIn;
+   SA_Energies = new double[SA_nRoots];
+   for (int root=0; root<SA_nRoots; root++){ SA_Energies[root] = 0.0; }
+
+   //The sweeps start at the right end, at sites L-2 and L-1. Root 0 is the current MPS, the other roots start from random tensors at site L-1.
+   SA_site = Prob->gL()-1;
+   SA_Tensors = new TensorT*[SA_nRoots];
+   SA_Tensors[0] = NULL;
+   for (int root=1; root<SA_nRoots; root++){
+      SA_Tensors[root] = new TensorT(SA_site,denBK->gIrrep(SA_site),denBK);
+      SA_Tensors[root]->random();
+   }
+
+}
+
+double CheMPS2::DMRG::getStateAveragedEnergy(const int root) const{
+
+   if ((!SA_activated) || (root<0) || (root>=SA_nRoots)){ return MinEnergy; }
+   return SA_Energies[root];
+
+}
+
+double CheMPS2::DMRG::sweepStateAveraged(const bool movingright, const bool change, const int instruction){
+
+   double Energy = 0.0;
+   double NoiseLevel = OptScheme->getNoisePrefactor(instruction) * MaxDiscWeightLastSweep;
+   MaxDiscWeightLastSweep = 0.0;
+
+   Sobject ** denS = new Sobject*[SA_nRoots];
+   TensorT ** Tleft = new TensorT*[SA_nRoots];
+   TensorT ** Tright = new TensorT*[SA_nRoots];
+   double * eigenvalues = new double[SA_nRoots];
+
+   const int firstIndex = (movingright) ? 0 : Prob->gL()-2;
+   const int lastIndex  = (movingright) ? Prob->gL()-3 : 1;
+   const int step       = (movingright) ? 1 : -1;
+   for (int index = firstIndex; index != lastIndex + step; index += step){
+
+      //Construct the S-objects. The root-dependent tensors are located at SA_site, which is index or index+1.
+      for (int root=0; root<SA_nRoots; root++){
+         TensorT * rootTensor = (root==0) ? MPS[SA_site] : SA_Tensors[root];
+         denS[root] = new Sobject(index,denBK->gIrrep(index),denBK->gIrrep(index+1),denBK);
+         denS[root]->Join((SA_site==index) ? rootTensor : MPS[index], (SA_site==index+1) ? rootTensor : MPS[index+1]);
+      }
+      for (int root=1; root<SA_nRoots; root++){ delete SA_Tensors[root]; }
+
+      //Feed everything to the block solver
+      struct timeval start, end;
+      gettimeofday(&start, NULL);
+      Heff Solver(denBK, Prob);
+      Solver.setDavidsonOptions(OptScheme->getDavidsonOptions(instruction), DavidsonEnergyChange);
+      Solver.SolveBlockDAVIDSON(SA_nRoots, denS, eigenvalues, Ltensors, Atensors, Btensors, Ctensors, Dtensors, S0tensors, S1tensors, F0tensors, F1tensors, Qtensors, Xtensors);
+      gettimeofday(&end, NULL);
+      DavidsonMatvecs[index] += Solver.gNumMatvecs();
+      DavidsonTime[index] += (end.tv_sec - start.tv_sec) + 1e-6 * (end.tv_usec - start.tv_usec);
+      Energy = 0.0;
+      for (int root=0; root<SA_nRoots; root++){
+         SA_Energies[root] = eigenvalues[root] + Prob->gEconst();
+         Energy += SA_Energies[root] / SA_nRoots;
+      }
+      if (Energy<MinEnergy){ MinEnergy = Energy; }
+
+      //Decompose the S-objects: the root-dependent tensors move along with the sweep
+      SA_site = (movingright) ? index+1 : index;
+      Tleft[0]  = MPS[index];
+      Tright[0] = MPS[index+1];
+      for (int root=1; root<SA_nRoots; root++){
+         SA_Tensors[root] = new TensorT(SA_site,denBK->gIrrep(SA_site),denBK);
+         if (movingright){ Tright[root] = SA_Tensors[root]; }
+         else {            Tleft[root]  = SA_Tensors[root]; }
+      }
+      if (NoiseLevel>0.0){
+         for (int root=0; root<SA_nRoots; root++){ denS[root]->addNoise(NoiseLevel); }
+      }
+      double discWeight = Sobject::Split(SA_nRoots, denS, Tleft, Tright, OptScheme->getD(instruction), movingright, change);
+      for (int root=0; root<SA_nRoots; root++){ delete denS[root]; }
+      if (discWeight > MaxDiscWeightLastSweep){ MaxDiscWeightLastSweep = discWeight; }
+
+      //Print info
+      cout << "Energies at sites (" << index << ", " << (index+1) << ") are";
+      for (int root=0; root<SA_nRoots; root++){ cout << " " << SA_Energies[root]; }
+      cout << endl;
+      if (CheMPS2::DMRG_printDiscardedWeight && change){ cout << "   Info(DMRG) : Discarded weight in SVD decomp. (non-reduced) = " << discWeight << endl; }
+      if (CheMPS2::DMRG_printDavidsonStats){ cout << "   Info(DMRG) : Davidson matvecs = " << DavidsonMatvecs[index] << " ; time = " << DavidsonTime[index] << " seconds" << endl; }
+      if (CheMPS2::DMRG_printDavidsonStats){ cout << "   Info(DMRG) : Scratch arena heap allocations = " << ScratchArena::gNumAllocations() - ScratchAllocationsStart << " ; requests = " << ScratchArena::gNumRequests() - ScratchRequestsStart << endl; }
+
+      //Prepare for next step
+      if (movingright){ updateMovingRightSafe(index); }
+      else {            updateMovingLeftSafe(index);  }
+
+   }
+
+   delete [] denS;
+   delete [] Tleft;
+   delete [] Tright;
+   delete [] eigenvalues;
+
+   return Energy;
+
+}
+
@@ -62,7 +62,7 @@ void CheMPS2::DMRG::calc2DM(){
    cout << "*********************" << endl;
    updateMovingRightSafe(index);
    
-   TensorDiag * Norm = new TensorDiag(Prob->gL(), denBK);
+   TensorDiag * Norm = new TensorDiag(Prob->gL(), denBK, true);
    MPS[Prob->gL()-1]->QR(Norm);
    delete Norm;
    
@@ -74,13 +74,14 @@ void CheMPS2::DMRG::calc2DM(){
    for (int siteindex=Prob->gL()-1; siteindex>=0; siteindex--){
       the2DM->FillSite(MPS[siteindex], Ltensors, F0tensors, F1tensors, S0tensors, S1tensors);
       if (siteindex>0){
-         TensorDiag * Left = new TensorDiag(siteindex, denBK);
+         TensorDiag * Left = new TensorDiag(siteindex, denBK, true);
          MPS[siteindex]->LQ(Left);
          MPS[siteindex-1]->RightMultiply(Left);
          delete Left;
          updateMovingLeftSafe2DM(siteindex-1);
       }
    }
+   flushOperatorIO();
    
    //Then perform two checks: double trace & energy
    double NtimesNminus1 = the2DM->doubletrace2DMA();
@@ -266,6 +267,7 @@ void CheMPS2::DMRG::calcOverlapsWithLowerStates(){
  
       //Don't do updatemovingRightSafe here, as with storeRenormOp some left boundary operators are stored and removed from mem.
       const int cnt = Prob->gL()-2;
+      waitOperatorIO(cnt);
       if (isAllocated[cnt]==2){
          deleteTensors(cnt, false);
          isAllocated[cnt]=0;
@@ -276,7 +278,7 @@ void CheMPS2::DMRG::calcOverlapsWithLowerStates(){
       }
       updateMovingRight(cnt);
  
-      TensorO * Otemp = new TensorO(Prob->gL(), true, Exc_BKs[state], denBK, Prob);
+      TensorO * Otemp = new TensorO(Prob->gL(), true, Exc_BKs[state], denBK, Prob, true);
       Otemp->update(Exc_MPSs[state][Prob->gL()-1], MPS[Prob->gL()-1], Exc_Overlaps[state][Prob->gL()-2]);
       double overlap = Otemp->gStorage()[0];
       delete Otemp;
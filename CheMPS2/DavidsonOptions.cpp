@@ -0,0 +1,97 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <iostream>
+#include <algorithm>
+
+#include "DavidsonOptions.h"
+#include "Options.h"
+
+using std::cerr;
+using std::endl;
+using std::max;
+using std::min;
+
+CheMPS2::DavidsonOptions::DavidsonOptions(){
+
+   numVec        = CheMPS2::HEFF_DAVIDSON_NUM_VEC;
+   numVecKeep    = CheMPS2::HEFF_DAVIDSON_NUM_VEC_KEEP;
+   rtolBase      = CheMPS2::HEFF_DAVIDSON_RTOL_BASE;
+   rtolLoose     = CheMPS2::HEFF_DAVIDSON_RTOL_BASE;
+   precondCutoff = CheMPS2::HEFF_DAVIDSON_PRECOND_CUTOFF;
+   maxMatvecs    = 0;
+
+}
+
+CheMPS2::DavidsonOptions::~DavidsonOptions(){ }
+
+void CheMPS2::DavidsonOptions::setNumVec(const int numVecIn, const int numVecKeepIn){
+
+   if ((numVecIn >= 2) && (numVecKeepIn >= 1) && (numVecKeepIn < numVecIn)){
+      numVec     = numVecIn;
+      numVecKeep = numVecKeepIn;
+   } else {
+      cerr << "CheMPS2::DavidsonOptions::setNumVec  ::  numVec was " << numVecIn << endl;
+      cerr << "CheMPS2::DavidsonOptions::setNumVec  ::  numVecKeep was " << numVecKeepIn << endl;
+   }
+
+}
+
+void CheMPS2::DavidsonOptions::setResidualTolerance(const double rtolBaseIn, const double rtolLooseIn){
+
+   if ((rtolBaseIn > 0.0) && (rtolLooseIn >= rtolBaseIn)){
+      rtolBase  = rtolBaseIn;
+      rtolLoose = rtolLooseIn;
+   } else {
+      cerr << "CheMPS2::DavidsonOptions::setResidualTolerance  ::  rtolBase was " << rtolBaseIn << endl;
+      cerr << "CheMPS2::DavidsonOptions::setResidualTolerance  ::  rtolLoose was " << rtolLooseIn << endl;
+   }
+
+}
+
+void CheMPS2::DavidsonOptions::setPrecondCutoff(const double precondCutoffIn){
+
+   if (precondCutoffIn > 0.0){
+      precondCutoff = precondCutoffIn;
+   } else {
+      cerr << "CheMPS2::DavidsonOptions::setPrecondCutoff  ::  precondCutoff was " << precondCutoffIn << endl;
+   }
+
+}
+
+void CheMPS2::DavidsonOptions::setMaxMatvecs(const int maxMatvecsIn){
+
+   if (maxMatvecsIn >= 0){
+      maxMatvecs = maxMatvecsIn;
+   } else {
+      cerr << "CheMPS2::DavidsonOptions::setMaxMatvecs  ::  maxMatvecs was " << maxMatvecsIn << endl;
+   }
+
+}
+
+int CheMPS2::DavidsonOptions::getNumVec() const{ return numVec; }
+
+int CheMPS2::DavidsonOptions::getNumVecKeep() const{ return numVecKeep; }
+
+double CheMPS2::DavidsonOptions::getResidualTolerance(const double energyChange) const{ return max(rtolBase, min(rtolLoose, energyChange)); }
+
+double CheMPS2::DavidsonOptions::getPrecondCutoff() const{ return precondCutoff; }
+
+int CheMPS2::DavidsonOptions::getMaxMatvecs() const{ return maxMatvecs; }
+
@@ -24,79 +24,71 @@
 #include <string>
 
 #include "FourIndex.h"
-#include "Lapack.h"
 
 using namespace std;
 
 CheMPS2::FourIndex::FourIndex(const int nGroup, const int * IrrepSizes){
 
    SymmInfo.setGroup(nGroup);
+   const int nIrreps = SymmInfo.getNumberOfIrreps();
    
-   Isizes = new int[SymmInfo.getNumberOfIrreps()];
-   storage = new double*****[SymmInfo.getNumberOfIrreps()];
-   
-   for (int Icenter=0; Icenter<SymmInfo.getNumberOfIrreps(); Icenter++){
+   Isizes = new int[nIrreps];
+   for (int Icenter=0; Icenter<nIrreps; Icenter++){
       Isizes[Icenter] = IrrepSizes[Icenter];
    }
    
    //For the following: see text above storage in Fourindex.h
-   for (int Icenter=0; Icenter<SymmInfo.getNumberOfIrreps(); Icenter++){
-      storage[Icenter] = new double****[SymmInfo.getNumberOfIrreps()];
-      for (int I_i=0; I_i<SymmInfo.getNumberOfIrreps(); I_i++){
+   pairOffsets = new long long*[nIrreps*nIrreps*nIrreps];
+   for (int block=0; block<nIrreps*nIrreps*nIrreps; block++){ pairOffsets[block] = NULL; }
+   arraySize = 0;
+   for (int Icenter=0; Icenter<nIrreps; Icenter++){
+      for (int I_i=0; I_i<nIrreps; I_i++){
          int I_j = SymmInfo.directProd(Icenter,I_i);
          if ((Isizes[I_i]>0)&&(Isizes[I_j]>0)){
-            storage[Icenter][I_i] = new double***[SymmInfo.getNumberOfIrreps()];
-            for (int I_k=I_i; I_k<SymmInfo.getNumberOfIrreps(); I_k++){
+            for (int I_k=I_i; I_k<nIrreps; I_k++){
                int I_l = SymmInfo.directProd(Icenter,I_k);
                if ((Isizes[I_k]>0)&&(Isizes[I_l]>0)){
                   if ((I_i <= I_j) && (I_j <= I_l)){
+                     long long * offsets = NULL;
                      if (Icenter == 0){ // I_i = I_j and I_k = I_l
                         if (I_i == I_k){
-                           storage[Icenter][I_i][I_k] = new double**[Isizes[I_i]*(Isizes[I_i]+1)/2];
+                           const long long n = Isizes[I_i];
+                           offsets = new long long[Isizes[I_i]*(Isizes[I_i]+1)/2];
                            for (int i=0; i<Isizes[I_i]; i++){
                               for (int k=i; k<Isizes[I_k]; k++){
-                                 storage[Icenter][I_i][I_k][i + k*(k+1)/2] = new double*[Isizes[I_j]-i];
-                                 for (int j=i; j<Isizes[I_j]; j++){
-                                    if (i==j) storage[Icenter][I_i][I_k][i + k*(k+1)/2][j-i] = new double[Isizes[I_l]-k]; 
-                                    else      storage[Icenter][I_i][I_k][i + k*(k+1)/2][j-i] = new double[Isizes[I_l]-j]; 
-                                 }
+                                 offsets[i + k*(k+1)/2] = arraySize;
+                                 arraySize += (n-k) + ((n-1-i)*(n-i))/2; // row j==i has n-k elements, row j>i has n-j elements
                               }
                            }
                         } else { // I_i < I_k
-                           storage[Icenter][I_i][I_k] = new double**[Isizes[I_i]*Isizes[I_k]];
+                           offsets = new long long[Isizes[I_i]*Isizes[I_k]];
                            for (int i=0; i<Isizes[I_i]; i++){
                               for (int k=0; k<Isizes[I_k]; k++){
-                                 storage[Icenter][I_i][I_k][i + k*Isizes[I_i]] = new double*[Isizes[I_j]-i];
-                                 for (int j=i; j<Isizes[I_j]; j++){
-                                    if (i==j) storage[Icenter][I_i][I_k][i+k*Isizes[I_i]][j-i] = new double[Isizes[I_l]-k];
-                                    else      storage[Icenter][I_i][I_k][i+k*Isizes[I_i]][j-i] = new double[Isizes[I_l]];
-                                 }
+                                 offsets[i + k*Isizes[I_i]] = arraySize;
+                                 arraySize += (Isizes[I_l]-k) + ((long long) (Isizes[I_j]-1-i)) * Isizes[I_l]; // row j==i has Isizes[I_l]-k elements, row j>i has Isizes[I_l] elements
                               }
                            }
                         }
                      } else { //Icenter !=0 ; I_i < I_j and I_k != I_l
                         if (I_i == I_k){
-                           storage[Icenter][I_i][I_k] = new double**[Isizes[I_i]*(Isizes[I_i]+1)/2];
+                           offsets = new long long[Isizes[I_i]*(Isizes[I_i]+1)/2];
                            for (int i=0; i<Isizes[I_i]; i++){
                               for (int k=i; k<Isizes[I_k]; k++){
-                                 storage[Icenter][I_i][I_k][i + k*(k+1)/2] = new double*[Isizes[I_j]];
-                                 for (int j=0; j<Isizes[I_j]; j++){
-                                    storage[Icenter][I_i][I_k][i + k*(k+1)/2][j] = new double[Isizes[I_l]-j];
-                                 }
+                                 offsets[i + k*(k+1)/2] = arraySize;
+                                 arraySize += ((long long) Isizes[I_j]) * Isizes[I_l] - (((long long) Isizes[I_j]) * (Isizes[I_j]-1))/2; // row j has Isizes[I_l]-j elements
                               }
                            }
                         } else { // I_i < I_k
-                           storage[Icenter][I_i][I_k] = new double**[Isizes[I_i]*Isizes[I_k]];
+                           offsets = new long long[Isizes[I_i]*Isizes[I_k]];
                            for (int i=0; i<Isizes[I_i]; i++){
                               for (int k=0; k<Isizes[I_k]; k++){
-                                 storage[Icenter][I_i][I_k][i + k*Isizes[I_i]] = new double*[Isizes[I_j]];
-                                 for (int j=0; j<Isizes[I_j]; j++){
-                                    storage[Icenter][I_i][I_k][i + k*Isizes[I_i]][j] = new double[Isizes[I_l]];
-                                 }
+                                 offsets[i + k*Isizes[I_i]] = arraySize;
+                                 arraySize += ((long long) Isizes[I_j]) * Isizes[I_l]; // row j has Isizes[I_l] elements
                               }
                            }
                         }
                      }
+                     pairOffsets[Icenter + nIrreps * (I_i + nIrreps * I_k)] = offsets;
                   }
                }
             }
@@ -104,63 +96,25 @@ CheMPS2::FourIndex::FourIndex(const int nGroup, const int * IrrepSizes){
       }
    }
    
+   void * arena = NULL;
+   if (posix_memalign(&arena, 64, sizeof(double) * ((arraySize > 0) ? arraySize : 1)) != 0){
+      std::cerr << "FourIndex::FourIndex : could not allocate " << arraySize << " doubles." << std::endl;
+      exit(EXIT_FAILURE);
+   }
+   storage = (double *) arena;
+   
 }
 
 CheMPS2::FourIndex::~FourIndex(){
    
-   for (int Icenter=0; Icenter<SymmInfo.getNumberOfIrreps(); Icenter++){
-      for (int I_i=0; I_i<SymmInfo.getNumberOfIrreps(); I_i++){
-         int I_j = SymmInfo.directProd(Icenter,I_i);
-         if ((Isizes[I_i]>0)&&(Isizes[I_j]>0)){
-            for (int I_k=I_i; I_k<SymmInfo.getNumberOfIrreps(); I_k++){
-               int I_l = SymmInfo.directProd(Icenter,I_k);
-               if ((Isizes[I_k]>0)&&(Isizes[I_l]>0)){
-                  if ((I_i <= I_j) && (I_j <= I_l)){
-                     if (Icenter == 0){
-                        if (I_i == I_k){
-                           for (int i=0; i<Isizes[I_i]; i++){
-                              for (int k=i; k<Isizes[I_k]; k++){
-                                 for (int j=i; j<Isizes[I_j]; j++) delete [] storage[Icenter][I_i][I_k][i + k*(k+1)/2][j-i];
-                                 delete [] storage[Icenter][I_i][I_k][i + k*(k+1)/2];
-                              }
-                           }
-                        } else {
-                           for (int i=0; i<Isizes[I_i]; i++){
-                              for (int k=0; k<Isizes[I_k]; k++){
-                                 for (int j=i; j<Isizes[I_j]; j++) delete [] storage[Icenter][I_i][I_k][i + k*Isizes[I_i]][j-i];
-                                 delete [] storage[Icenter][I_i][I_k][i + k*Isizes[I_i]];
-                              }
-                           }
-                        }
-                     } else {
-                        if (I_i == I_k){
-                           for (int i=0; i<Isizes[I_i]; i++){
-                              for (int k=i; k<Isizes[I_k]; k++){
-                                 for (int j=0; j<Isizes[I_j]; j++) delete [] storage[Icenter][I_i][I_k][i + k*(k+1)/2][j];
-                                 delete [] storage[Icenter][I_i][I_k][i + k*(k+1)/2];
-                              }
-                           }
-                        } else {
-                           for (int i=0; i<Isizes[I_i]; i++){
-                              for (int k=0; k<Isizes[I_k]; k++){
-                                 for (int j=0; j<Isizes[I_j]; j++) delete [] storage[Icenter][I_i][I_k][i + k*Isizes[I_i]][j];
-                                 delete [] storage[Icenter][I_i][I_k][i + k*Isizes[I_i]];
-                              }
-                           }
-                        }
-                     }
-                     delete [] storage[Icenter][I_i][I_k];
-                  }
-               }
-            }
-            delete [] storage[Icenter][I_i];
-         }
-      }
-      delete [] storage[Icenter];
+   const int nIrreps = SymmInfo.getNumberOfIrreps();
+   for (int block=0; block<nIrreps*nIrreps*nIrreps; block++){
+      if (pairOffsets[block] != NULL){ delete [] pairOffsets[block]; }
    }
+   delete [] pairOffsets;
    
    delete [] Isizes;
-   delete [] storage;
+   free(storage);
    
 }
 
@@ -299,19 +253,30 @@ double * CheMPS2::FourIndex::getPtrIrrepOrderOK(const int irrep_i, const int irr
 
 double * CheMPS2::FourIndex::getPtrAllOK(const int number, const int Icent, const int irrep_i, const int irrep_k, const int i, const int j, const int k, const int l) const {
 
+   const int nIrreps = SymmInfo.getNumberOfIrreps();
+   const long long * offsets = pairOffsets[Icent + nIrreps * (irrep_i + nIrreps * irrep_k)];
+
    switch (number){
       case 1:
-         return storage[Icent][irrep_i][irrep_k][i + k*(k+1)/2][j-i] + l-k;
-      case 2:
-         return storage[Icent][irrep_i][irrep_k][i + k*(k+1)/2][j-i] + l-j;
+         return storage + offsets[i + k*(k+1)/2] + l-k;
+      case 2:{
+         const long long n = Isizes[irrep_i];
+         return storage + offsets[i + k*(k+1)/2] + (n-k) + (j-1-i)*n - (((long long) (j-1))*j)/2 + (((long long) i)*(i+1))/2 + l-j;
+      }
       case 3:
-         return storage[Icent][irrep_i][irrep_k][i + Isizes[irrep_i]*k][j-i] + l-k;
-      case 4:
-         return storage[Icent][irrep_i][irrep_k][i + Isizes[irrep_i]*k][j-i] + l;
-      case 5:
-         return storage[Icent][irrep_i][irrep_k][i + k*(k+1)/2][j] + l-j;
-      case 6:
-         return storage[Icent][irrep_i][irrep_k][i + Isizes[irrep_i]*k][j] + l;
+         return storage + offsets[i + Isizes[irrep_i]*k] + l-k;
+      case 4:{
+         const long long n_l = Isizes[SymmInfo.directProd(Icent,irrep_k)];
+         return storage + offsets[i + Isizes[irrep_i]*k] + (n_l-k) + (j-1-i)*n_l + l;
+      }
+      case 5:{
+         const long long n_l = Isizes[SymmInfo.directProd(Icent,irrep_k)];
+         return storage + offsets[i + k*(k+1)/2] + j*n_l - (((long long) j)*(j-1))/2 + l-j;
+      }
+      case 6:{
+         const long long n_l = Isizes[SymmInfo.directProd(Icent,irrep_k)];
+         return storage + offsets[i + Isizes[irrep_i]*k] + j*n_l + l;
+      }
    }
    
    return NULL;
@@ -320,130 +285,8 @@ double * CheMPS2::FourIndex::getPtrAllOK(const int number, const int Icent, cons
 
 void CheMPS2::FourIndex::save(const std::string name) const{
 
-   //The object size.
-   long long theTotalSize = 0;
-   for (int Icenter=0; Icenter<SymmInfo.getNumberOfIrreps(); Icenter++){
-      for (int I_i=0; I_i<SymmInfo.getNumberOfIrreps(); I_i++){
-         int I_j = SymmInfo.directProd(Icenter,I_i);
-         if ((Isizes[I_i]>0)&&(Isizes[I_j]>0)){
-            for (int I_k=I_i; I_k<SymmInfo.getNumberOfIrreps(); I_k++){
-               int I_l = SymmInfo.directProd(Icenter,I_k);
-               if ((Isizes[I_k]>0)&&(Isizes[I_l]>0)){
-                  if ((I_i <= I_j) && (I_j <= I_l)){
-                     if (Icenter == 0){ // I_i = I_j and I_k = I_l
-                        if (I_i == I_k){
-                           for (int i=0; i<Isizes[I_i]; i++){
-                              for (int k=i; k<Isizes[I_k]; k++){
-                                 for (int j=i; j<Isizes[I_j]; j++){
-                                    theTotalSize += Isizes[I_l] - ((i==j)?k:j);
-                                 }
-                              }
-                           }
-                        } else { // I_i < I_k
-                           for (int i=0; i<Isizes[I_i]; i++){
-                              for (int k=0; k<Isizes[I_k]; k++){
-                                 for (int j=i; j<Isizes[I_j]; j++){
-                                    theTotalSize += Isizes[I_l] - ((i==j)?k:0);
-                                 }
-                              }
-                           }
-                        }
-                     } else { //Icenter !=0 ; I_i < I_j and I_k != I_l
-                        if (I_i == I_k){
-                           for (int i=0; i<Isizes[I_i]; i++){
-                              for (int k=i; k<Isizes[I_k]; k++){
-                                 for (int j=0; j<Isizes[I_j]; j++){
-                                    theTotalSize += Isizes[I_l] - j;
-                                 }
-                              }
-                           }
-                        } else { // I_i < I_k
-                           for (int i=0; i<Isizes[I_i]; i++){
-                              for (int k=0; k<Isizes[I_k]; k++){
-                                 for (int j=0; j<Isizes[I_j]; j++){
-                                    theTotalSize += Isizes[I_l];
-                                 }
-                              }
-                           }
-                        }
-                     }
-                  }
-               }
-            }
-         }
-      }
-   }
-   
-   //Space to copy it: needed for fast HDF5 write.
-   double * writeDump = new double[theTotalSize];
-   
-   //Copy the object.
-   long long theTotalSize2 = 0;
-   for (int Icenter=0; Icenter<SymmInfo.getNumberOfIrreps(); Icenter++){
-      for (int I_i=0; I_i<SymmInfo.getNumberOfIrreps(); I_i++){
-         int I_j = SymmInfo.directProd(Icenter,I_i);
-         if ((Isizes[I_i]>0)&&(Isizes[I_j]>0)){
-            for (int I_k=I_i; I_k<SymmInfo.getNumberOfIrreps(); I_k++){
-               int I_l = SymmInfo.directProd(Icenter,I_k);
-               if ((Isizes[I_k]>0)&&(Isizes[I_l]>0)){
-                  if ((I_i <= I_j) && (I_j <= I_l)){
-                     if (Icenter == 0){ // I_i = I_j and I_k = I_l
-                        if (I_i == I_k){
-                           for (int i=0; i<Isizes[I_i]; i++){
-                              for (int k=i; k<Isizes[I_k]; k++){
-                                 for (int j=i; j<Isizes[I_j]; j++){
-                                    int mySize = Isizes[I_l] - ((i==j)?k:j);
-                                    int inc = 1;
-                                    dcopy_(&mySize, storage[Icenter][I_i][I_k][i + k*(k+1)/2][j-i], &inc, writeDump + theTotalSize2, &inc);
-                                    theTotalSize2 += mySize;
-                                 }
-                              }
-                           }
-                        } else { // I_i < I_k
-                           for (int i=0; i<Isizes[I_i]; i++){
-                              for (int k=0; k<Isizes[I_k]; k++){
-                                 for (int j=i; j<Isizes[I_j]; j++){
-                                    int mySize = Isizes[I_l] - ((i==j)?k:0);
-                                    int inc = 1;
-                                    dcopy_(&mySize, storage[Icenter][I_i][I_k][i + k*Isizes[I_i]][j-i], &inc, writeDump + theTotalSize2, &inc);
-                                    theTotalSize2 += mySize;
-                                 }
-                              }
-                           }
-                        }
-                     } else { //Icenter !=0 ; I_i < I_j and I_k != I_l
-                        if (I_i == I_k){
-                           for (int i=0; i<Isizes[I_i]; i++){
-                              for (int k=i; k<Isizes[I_k]; k++){
-                                 for (int j=0; j<Isizes[I_j]; j++){
-                                    int mySize = Isizes[I_l] - j;
-                                    int inc = 1;
-                                    dcopy_(&mySize, storage[Icenter][I_i][I_k][i + k*(k+1)/2][j], &inc, writeDump + theTotalSize2, &inc);
-                                    theTotalSize2 += mySize;
-                                 }
-                              }
-                           }
-                        } else { // I_i < I_k
-                           for (int i=0; i<Isizes[I_i]; i++){
-                              for (int k=0; k<Isizes[I_k]; k++){
-                                 for (int j=0; j<Isizes[I_j]; j++){
-                                    int mySize = Isizes[I_l];
-                                    int inc = 1;
-                                    dcopy_(&mySize, storage[Icenter][I_i][I_k][i + k*Isizes[I_i]][j], &inc, writeDump + theTotalSize2, &inc);
-                                    theTotalSize2 += mySize;
-                                 }
-                              }
-                           }
-                        }
-                     }
-                  }
-               }
-            }
-         }
-      }
-   }
-   
-   if (theTotalSize != theTotalSize2){ std::cerr << "FourIndex::save : mismatch of theTotalSize and theTotalSize2" << std::endl;}
+   //The storage is one array, in the order of the HDF5 dataset
+   long long theTotalSize = arraySize;
  
    //The hdf5 file
    hid_t file_id = H5Fcreate(name.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
@@ -490,7 +333,7 @@ void CheMPS2::FourIndex::save(const std::string name) const{
          hsize_t dimarray7       = theTotalSize; //hsize_t is defined by default as unsigned long long, so no problem
          hid_t dataspace_id7     = H5Screate_simple(1, &dimarray7, NULL);
          hid_t dataset_id7       = H5Dcreate(group_id7, "Matrix elements", H5T_IEEE_F64LE, dataspace_id7, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-         H5Dwrite(dataset_id7, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, writeDump);
+         H5Dwrite(dataset_id7, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, storage);
              
          H5Dclose(dataset_id7);
          H5Sclose(dataspace_id7);
@@ -498,8 +341,6 @@ void CheMPS2::FourIndex::save(const std::string name) const{
       H5Gclose(group_id7);
       
    H5Fclose(file_id);
-   
-   delete [] writeDump;
 
 }
 
@@ -544,100 +385,20 @@ void CheMPS2::FourIndex::read(const std::string name){
       H5Gclose(group_id);
       
       std::cout << "FourIndex::read : loading " << theTotalSize << " doubles." << std::endl;
-      double * readDump = new double[theTotalSize];
+      if (theTotalSize != arraySize){ std::cerr << "FourIndex::read : mismatch of theTotalSize and the size of the FourIndex object" << std::endl; }
       
-      //The object itself.
-      hid_t group_id7 = H5Gopen(file_id, "/FourIndexObject", H5P_DEFAULT);
+      //The object itself: read directly into the storage
+      if (theTotalSize == arraySize){
+         hid_t group_id7 = H5Gopen(file_id, "/FourIndexObject", H5P_DEFAULT);
 
-      hid_t dataset_id7 = H5Dopen(group_id7, "Matrix elements", H5P_DEFAULT);
-      H5Dread(dataset_id7, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, readDump);
-      H5Dclose(dataset_id7);
+         hid_t dataset_id7 = H5Dopen(group_id7, "Matrix elements", H5P_DEFAULT);
+         H5Dread(dataset_id7, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, storage);
+         H5Dclose(dataset_id7);
 
-      H5Gclose(group_id7);
+         H5Gclose(group_id7);
+      }
       
    H5Fclose(file_id);
-   
-   //Copy the matrix elements back
-   long long theTotalSize2 = 0;
-   for (int Icenter=0; Icenter<SymmInfo.getNumberOfIrreps(); Icenter++){
-      for (int I_i=0; I_i<SymmInfo.getNumberOfIrreps(); I_i++){
-         int I_j = SymmInfo.directProd(Icenter,I_i);
-         if ((Isizes[I_i]>0)&&(Isizes[I_j]>0)){
-            for (int I_k=I_i; I_k<SymmInfo.getNumberOfIrreps(); I_k++){
-               int I_l = SymmInfo.directProd(Icenter,I_k);
-               if ((Isizes[I_k]>0)&&(Isizes[I_l]>0)){
-                  if ((I_i <= I_j) && (I_j <= I_l)){
-                     if (Icenter == 0){ // I_i = I_j and I_k = I_l
-                        if (I_i == I_k){
-                           for (int i=0; i<Isizes[I_i]; i++){
-                              for (int k=i; k<Isizes[I_k]; k++){
-                                 for (int j=i; j<Isizes[I_j]; j++){
-                                 
-                                    double * location = storage[Icenter][I_i][I_k][i + k*(k+1)/2][j-i];
-                                    int mySize = Isizes[I_l] - ((i==j)?k:j);
-                                    int inc = 1;
-                                    dcopy_(&mySize, readDump + theTotalSize2, &inc, location, &inc);
-                                    theTotalSize2 += mySize;
-
-                                 }
-                              }
-                           }
-                        } else { // I_i < I_k
-                           for (int i=0; i<Isizes[I_i]; i++){
-                              for (int k=0; k<Isizes[I_k]; k++){
-                                 for (int j=i; j<Isizes[I_j]; j++){
-                                 
-                                    double * location = storage[Icenter][I_i][I_k][i + k*Isizes[I_i]][j-i];
-                                    int mySize = Isizes[I_l] - ((i==j)?k:0);
-                                    int inc = 1;
-                                    dcopy_(&mySize, readDump + theTotalSize2, &inc, location, &inc);
-                                    theTotalSize2 += mySize;
-
-                                 }
-                              }
-                           }
-                        }
-                     } else { //Icenter !=0 ; I_i < I_j and I_k != I_l
-                        if (I_i == I_k){
-                           for (int i=0; i<Isizes[I_i]; i++){
-                              for (int k=i; k<Isizes[I_k]; k++){
-                                 for (int j=0; j<Isizes[I_j]; j++){
-                                 
-                                    double * location = storage[Icenter][I_i][I_k][i + k*(k+1)/2][j];
-                                    int mySize = Isizes[I_l] - j;
-                                    int inc = 1;
-                                    dcopy_(&mySize, readDump + theTotalSize2, &inc, location, &inc);
-                                    theTotalSize2 += mySize;
-                           
-                                 }
-                              }
-                           }
-                        } else { // I_i < I_k
-                           for (int i=0; i<Isizes[I_i]; i++){
-                              for (int k=0; k<Isizes[I_k]; k++){
-                                 for (int j=0; j<Isizes[I_j]; j++){
-                                 
-                                    double * location = storage[Icenter][I_i][I_k][i + k*Isizes[I_i]][j];
-                                    int mySize = Isizes[I_l];
-                                    int inc = 1;
-                                    dcopy_(&mySize, readDump + theTotalSize2, &inc, location, &inc);
-                                    theTotalSize2 += mySize;
-                           
-                                 }
-                              }
-                           }
-                        }
-                     }
-                  }
-               }
-            }
-         }
-      }
-   }
-   
-   if (theTotalSize != theTotalSize2){ std::cerr << "FourIndex::read : mismatch of theTotalSize and theTotalSize2" << std::endl; }
-   
-   delete [] readDump;
 
 }
 
@@ -24,16 +24,25 @@
 #include <omp.h>
 
 #include "Heff.h"
+#include "ScratchArena.h"
 #include "Lapack.h"
 
 using std::cout;
 using std::endl;
 using std::max;
+using std::min;
 
 CheMPS2::Heff::Heff(const SyBookkeeper * denBKIn, const Problem * ProbIn){
 
    denBK = denBKIn;
    Prob = ProbIn;
+   
+   dvdsNumVec        = CheMPS2::HEFF_DAVIDSON_NUM_VEC;
+   dvdsNumVecKeep    = CheMPS2::HEFF_DAVIDSON_NUM_VEC_KEEP;
+   dvdsRtolBase      = CheMPS2::HEFF_DAVIDSON_RTOL_BASE;
+   dvdsPrecondCutoff = CheMPS2::HEFF_DAVIDSON_PRECOND_CUTOFF;
+   dvdsMaxMatvecs    = 0;
+   dvdsNumMatvecs    = 0;
 
 }
 
@@ -41,7 +50,38 @@ CheMPS2::Heff::~Heff(){
 
 }
 
-void CheMPS2::Heff::makeHeff(double * memS, double * memHeff, const Sobject * denS, TensorL *** Ltensors, TensorA **** Atensors, TensorB **** Btensors, TensorC **** Ctensors, TensorD **** Dtensors, TensorS0 **** S0tensors, TensorS1 **** S1tensors, TensorF0 **** F0tensors, TensorF1 **** F1tensors, TensorQ *** Qtensors, TensorX ** Xtensors, int nLower, double ** VeffTilde) const{
+void CheMPS2::Heff::setDavidsonOptions(const DavidsonOptions * options, const double energyChange){
+
+   if (options!=NULL){
+      dvdsNumVec        = options->getNumVec();
+      dvdsNumVecKeep    = options->getNumVecKeep();
+      dvdsRtolBase      = options->getResidualTolerance(energyChange);
+      dvdsPrecondCutoff = options->getPrecondCutoff();
+      dvdsMaxMatvecs    = options->getMaxMatvecs();
+   }
+
+}
+
+int CheMPS2::Heff::gNumMatvecs() const{ return dvdsNumMatvecs; }
+
+void CheMPS2::Heff::makeHeff(double * memS, double * memHeff, const Sobject * denS, TensorL *** Ltensors, TensorA **** Atensors, TensorB **** Btensors, TensorC **** Ctensors, TensorD **** Dtensors, TensorS0 **** S0tensors, TensorS1 **** S1tensors, TensorF0 **** F0tensors, TensorF1 **** F1tensors, TensorQ *** Qtensors, TensorX ** Xtensors, int nLower, double ** VeffTilde, HeffPlan * plan) const{
+
+   //Replay the recorded contraction schedule. The projection of lower-lying states depends on memS, and is hence done separately.
+   if ((plan!=NULL) && (plan->isRecorded())){
+   
+      plan->execute(memS, memHeff);
+      
+      int dimTotal = denS->gKappa2index(denS->gNKappa());
+      int inc = 1;
+      for (int state=0; state<nLower; state++){
+         double alpha = ddot_(&dimTotal, memS, &inc, VeffTilde[state], &inc);
+         daxpy_(&dimTotal, &alpha, VeffTilde[state], &inc, memHeff, &inc);
+      }
+      return;
+      
+   }
+   
+   const bool record = (plan!=NULL) && (plan->needsRecording());
 
    const int indexS = denS->gIndex();
    const bool atLeft  = (indexS==0)?true:false;
@@ -52,16 +92,17 @@ void CheMPS2::Heff::makeHeff(double * memS, double * memHeff, const Sobject * de
    #pragma omp parallel for schedule(dynamic)
    for (int ikappa=0; ikappa<denS->gNKappa(); ikappa++){
 
-      for (int cnt=denS->gKappa2index(ikappa); cnt<denS->gKappa2index(ikappa+1); cnt++){ memHeff[cnt] = 0.0; }
+      double * temp = ScratchArena::get(0, DIM*DIM);
+      double * temp2 = ScratchArena::get(1, DIM*DIM);
       
-      double * temp = new double[DIM*DIM];
-      double * temp2 = new double[DIM*DIM];
+      if (record){ plan->startRecording(ikappa, memS, memHeff, temp, temp2); }
+      
+      HeffPlan::clear(denS->gKappa2index(ikappa+1) - denS->gKappa2index(ikappa), memHeff + denS->gKappa2index(ikappa));
       
       addDiagram1C(ikappa, memS,memHeff,denS,Prob->gMxElement(indexS,indexS,indexS,indexS));
       addDiagram1D(ikappa, memS,memHeff,denS,Prob->gMxElement(indexS+1,indexS+1,indexS+1,indexS+1));
       addDiagram2dall(ikappa, memS, memHeff, denS);
       addDiagram3Eand3H(ikappa, memS, memHeff, denS);
-      addDiagramExcitations(ikappa, memS, memHeff, denS, nLower, VeffTilde);
       
       if (!atLeft){
 
@@ -149,10 +190,13 @@ void CheMPS2::Heff::makeHeff(double * memS, double * memHeff, const Sobject * de
                
       }
       
-      delete [] temp;
-      delete [] temp2;
+      if (record){ plan->stopRecording(); }
+      
+      addDiagramExcitations(ikappa, memS, memHeff, denS, nLower, VeffTilde);
       
    }
+   
+   if (record){ plan->finalizeRecording(); }
 
 }
 
@@ -196,10 +240,9 @@ void CheMPS2::Heff::fillHeffDiag(double * memHeffDiag, const Sobject * denS, Ten
       
       if ((!atLeft) && (!atRight)){
       
-         double * work = new double[DIM];
+         double * work = ScratchArena::get(0, DIM);
          addDiagonal2a3spin0(ikappa, memHeffDiag, denS, Ctensors, F0tensors, work);
          addDiagonal2a3spin1(ikappa, memHeffDiag, denS, Dtensors, F1tensors, work);
-         delete [] work;
          
       }
       
@@ -210,8 +253,8 @@ void CheMPS2::Heff::fillHeffDiag(double * memHeffDiag, const Sobject * denS, Ten
 double CheMPS2::Heff::SolveDAVIDSON(Sobject * denS, TensorL *** Ltensors, TensorA **** Atensors, TensorB **** Btensors, TensorC **** Ctensors, TensorD **** Dtensors, TensorS0 **** S0tensors, TensorS1 **** S1tensors, TensorF0 **** F0tensors, TensorF1 **** F1tensors, TensorQ *** Qtensors, TensorX ** Xtensors, int nLower, double ** VeffTilde) const{
 
    //From people.inf.ethz.ch/arbenz/ewp/Lnotes/chapter11.pdf : algorithm 11.1, with instead of line (16), equation (11.3).
-   const int DAVIDSON_NUM_VEC      = CheMPS2::HEFF_DAVIDSON_NUM_VEC;
-   const int DAVIDSON_NUM_VEC_KEEP = CheMPS2::HEFF_DAVIDSON_NUM_VEC_KEEP;
+   const int DAVIDSON_NUM_VEC      = dvdsNumVec;
+   const int DAVIDSON_NUM_VEC_KEEP = dvdsNumVecKeep;
 
    //Convert mem of Sobject to symmetric conventions
    denS->prog2symm();
@@ -228,7 +271,7 @@ double CheMPS2::Heff::SolveDAVIDSON(Sobject * denS, TensorL *** Ltensors, Tensor
    int mxM_lwork = 3*DAVIDSON_NUM_VEC-1;
    double * mxM_work = new double[mxM_lwork];
    
-   double rtol = CheMPS2::HEFF_DAVIDSON_RTOL_BASE * sqrt(length_vec);
+   double rtol = dvdsRtolBase * sqrt(length_vec);
    double rnorm = 10*rtol;
    
    double * t_vec = new double[length_vec];
@@ -254,6 +297,13 @@ double CheMPS2::Heff::SolveDAVIDSON(Sobject * denS, TensorL *** Ltensors, Tensor
    double * HeffDiag = new double[length_vec];
    fillHeffDiag(HeffDiag, denS, Ctensors, Dtensors, F0tensors, F1tensors, Xtensors, nLower, VeffTilde);
    
+   //The contraction schedule is recorded during the first makeHeff call, and replayed afterwards
+   HeffPlan * plan = NULL;
+   if (CheMPS2::HEFF_contractionPlan){
+      const int DIM = max(denBK->gMaxDimAtBound(denS->gIndex()), denBK->gMaxDimAtBound(denS->gIndex()+2));
+      plan = new HeffPlan(denS, DIM*DIM);
+   }
+   
    double * Reortho_Lowdin = NULL;
    double * Reortho_Overlap_eigs = NULL;
    double * Reortho_Overlap = NULL;
@@ -262,7 +312,7 @@ double CheMPS2::Heff::SolveDAVIDSON(Sobject * denS, TensorL *** Ltensors, Tensor
    
    int nIterations = 0;
    
-   while (rnorm > rtol){
+   while ((rnorm > rtol) && ((dvdsMaxMatvecs==0) || (nIterations < dvdsMaxMatvecs))){
 
       //1. Orthogonalize the new t_vec w.r.t. the old basis
       for (int cnt=0; cnt<num_vec; cnt++){
@@ -286,7 +336,7 @@ double CheMPS2::Heff::SolveDAVIDSON(Sobject * denS, TensorL *** Ltensors, Tensor
          t_vec = new double[length_vec];
          num_allocated++;
       }
-      makeHeff(vecs[num_vec], Hvecs[num_vec], denS, Ltensors, Atensors, Btensors, Ctensors, Dtensors, S0tensors, S1tensors, F0tensors, F1tensors, Qtensors, Xtensors, nLower, VeffTilde);
+      makeHeff(vecs[num_vec], Hvecs[num_vec], denS, Ltensors, Atensors, Btensors, Ctensors, Dtensors, S0tensors, S1tensors, F0tensors, F1tensors, Qtensors, Xtensors, nLower, VeffTilde, plan);
       nIterations++;
       
       //4. mxM contains the Hamiltonian in the basis "vecs"
@@ -332,20 +382,20 @@ double CheMPS2::Heff::SolveDAVIDSON(Sobject * denS, TensorL *** Ltensors, Tensor
       
          //9a. Calculate the new t_vec based on the residual of the lowest eigenvalue, to add to the vecs.
          for (int cnt=0; cnt<length_vec; cnt++){
-            if (fabs(HeffDiag[cnt] - mxM_eigs[0])> CheMPS2::HEFF_DAVIDSON_PRECOND_CUTOFF ){
+            if (fabs(HeffDiag[cnt] - mxM_eigs[0])> dvdsPrecondCutoff ){
                work_vec[cnt] = u_vec[cnt]/(HeffDiag[cnt] - mxM_eigs[0]); // work_vec = K^(-1) u_vec
             } else {
-               work_vec[cnt] = u_vec[cnt]/ CheMPS2::HEFF_DAVIDSON_PRECOND_CUTOFF ;
+               work_vec[cnt] = u_vec[cnt]/ dvdsPrecondCutoff ;
                if (CheMPS2::HEFF_debugPrint) cout << "|(HeffDiag[" << cnt << "] - mxM_eigs[0])| = " << fabs(HeffDiag[cnt] - mxM_eigs[0]) << endl;
             }
          }
          alpha = - ddot_(&length_vec,work_vec,&inc1,t_vec,&inc1)/ddot_(&length_vec,work_vec,&inc1,u_vec,&inc1); // alpha = - (u^T K^(-1) r) / (u^T K^(-1) u)
          daxpy_(&length_vec,&alpha,u_vec,&inc1,t_vec,&inc1); // t_vec = r - (u^T K^(-1) r) / (u^T K^(-1) u) u
          for (int cnt=0; cnt<length_vec; cnt++){
-            if (fabs(HeffDiag[cnt] - mxM_eigs[0])> CheMPS2::HEFF_DAVIDSON_PRECOND_CUTOFF ){
+            if (fabs(HeffDiag[cnt] - mxM_eigs[0])> dvdsPrecondCutoff ){
                t_vec[cnt] = - t_vec[cnt]/(HeffDiag[cnt] - mxM_eigs[0]); //t_vec = - K^(-1) (r - (u^T K^(-1) r) / (u^T K^(-1) u) u)
             } else {
-               t_vec[cnt] = - t_vec[cnt]/ CheMPS2::HEFF_DAVIDSON_PRECOND_CUTOFF ;
+               t_vec[cnt] = - t_vec[cnt]/ dvdsPrecondCutoff ;
             }
          }
          
@@ -357,7 +407,7 @@ double CheMPS2::Heff::SolveDAVIDSON(Sobject * denS, TensorL *** Ltensors, Tensor
                alpha = 1.0/dlange_(&norm,&length_vec,&inc1,u_vec,&length_vec,u_vec); //work not referenced as Frobenius norm
                dscal_(&length_vec,&alpha,u_vec,&inc1);
                dcopy_(&length_vec,u_vec,&inc1,vecs[0],&inc1);
-               makeHeff(vecs[0], Hvecs[0], denS, Ltensors, Atensors, Btensors, Ctensors, Dtensors, S0tensors, S1tensors, F0tensors, F1tensors, Qtensors, Xtensors, nLower, VeffTilde);
+               makeHeff(vecs[0], Hvecs[0], denS, Ltensors, Atensors, Btensors, Ctensors, Dtensors, S0tensors, S1tensors, F0tensors, F1tensors, Qtensors, Xtensors, nLower, VeffTilde, plan);
                nIterations++;
                mxM[0] = ddot_(&length_vec,vecs[0],&inc1,Hvecs[0],&inc1);
             
@@ -409,7 +459,7 @@ double CheMPS2::Heff::SolveDAVIDSON(Sobject * denS, TensorL *** Ltensors, Tensor
                
                //Construct the H*vecs
                for (int cnt=0; cnt<DAVIDSON_NUM_VEC_KEEP; cnt++){
-                  makeHeff(vecs[cnt], Hvecs[cnt], denS, Ltensors, Atensors, Btensors, Ctensors, Dtensors, S0tensors, S1tensors, F0tensors, F1tensors, Qtensors, Xtensors, nLower, VeffTilde);
+                  makeHeff(vecs[cnt], Hvecs[cnt], denS, Ltensors, Atensors, Btensors, Ctensors, Dtensors, S0tensors, S1tensors, F0tensors, F1tensors, Qtensors, Xtensors, nLower, VeffTilde, plan);
                   nIterations++;
                }
                
@@ -432,6 +482,7 @@ double CheMPS2::Heff::SolveDAVIDSON(Sobject * denS, TensorL *** Ltensors, Tensor
    }
    
    if (CheMPS2::HEFF_debugPrint) cout << "   Stats: nIt(DAVIDSON) = " << nIterations << endl;
+   dvdsNumMatvecs = nIterations;
    
    double eigenvalue = mxM_eigs[0]; //mxM_eigs[0] and u_vec are eigenvalue and vector
    dcopy_(&length_vec,u_vec,&inc1,denS->gStorage(),&inc1);
@@ -450,6 +501,7 @@ double CheMPS2::Heff::SolveDAVIDSON(Sobject * denS, TensorL *** Ltensors, Tensor
    delete [] mxM_vecs;
    delete [] mxM_work;
    delete [] HeffDiag;
+   if (plan!=NULL){ delete plan; }
    
    if (Reortho_Allocated){
       delete [] Reortho_Eigenvecs;
@@ -465,6 +517,276 @@ double CheMPS2::Heff::SolveDAVIDSON(Sobject * denS, TensorL *** Ltensors, Tensor
 
 }
 
+void CheMPS2::Heff::makeHeffBlock(const int nVec, double ** memS, double ** memHeff, const Sobject * denS, TensorL *** Ltensors, TensorA **** Atensors, TensorB **** Btensors, TensorC **** Ctensors, TensorD **** Dtensors, TensorS0 **** S0tensors, TensorS1 **** S1tensors, TensorF0 **** F0tensors, TensorF1 **** F1tensors, TensorQ *** Qtensors, TensorX ** Xtensors, int nLower, double ** VeffTilde, HeffPlan * plan) const{
+
+   //The contraction schedule is recorded with the first vector
+   int first = 0;
+   if ((plan!=NULL) && (plan->needsRecording()) && (nVec>0)){
+      makeHeff(memS[0], memHeff[0], denS, Ltensors, Atensors, Btensors, Ctensors, Dtensors, S0tensors, S1tensors, F0tensors, F1tensors, Qtensors, Xtensors, nLower, VeffTilde, plan);
+      first = 1;
+   }
+   
+   //The other vectors are handled in a single pass over the schedule
+   if ((plan!=NULL) && (plan->isRecorded())){
+      if (nVec>first){
+         plan->execute(nVec-first, memS+first, memHeff+first);
+         int dimTotal = denS->gKappa2index(denS->gNKappa());
+         int inc = 1;
+         for (int ivec=first; ivec<nVec; ivec++){
+            for (int state=0; state<nLower; state++){
+               double alpha = ddot_(&dimTotal, memS[ivec], &inc, VeffTilde[state], &inc);
+               daxpy_(&dimTotal, &alpha, VeffTilde[state], &inc, memHeff[ivec], &inc);
+            }
+         }
+      }
+   } else {
+      for (int ivec=first; ivec<nVec; ivec++){
+         makeHeff(memS[ivec], memHeff[ivec], denS, Ltensors, Atensors, Btensors, Ctensors, Dtensors, S0tensors, S1tensors, F0tensors, F1tensors, Qtensors, Xtensors, nLower, VeffTilde, plan);
+      }
+   }
+
+}
+
+void CheMPS2::Heff::SolveBlockDAVIDSON(const int nRoots, Sobject ** denS, double * eigenvalues, TensorL *** Ltensors, TensorA **** Atensors, TensorB **** Btensors, TensorC **** Ctensors, TensorD **** Dtensors, TensorS0 **** S0tensors, TensorS1 **** S1tensors, TensorF0 **** F0tensors, TensorF1 **** F1tensors, TensorQ *** Qtensors, TensorX ** Xtensors, int nLower, double ** VeffTilde) const{
+
+   //Block version of SolveDAVIDSON: all unconverged roots add their (Olsen-corrected) residual to the basis at once, and the new basis vectors are multiplied with Heff in a single pass.
+   const int DAVIDSON_NUM_VEC      = max(dvdsNumVec, 4*nRoots);
+   const int DAVIDSON_NUM_VEC_KEEP = max(dvdsNumVecKeep, nRoots);
+
+   //Convert mem of Sobjects to symmetric conventions
+   for (int root=0; root<nRoots; root++){ denS[root]->prog2symm(); }
+
+   int length_vec = denS[0]->gKappa2index(denS[0]->gNKappa());
+   const int nSolve = min(nRoots, length_vec); //The number of roots which fit in the two-site space
+   int num_vec = 0;
+   double ** vecs  = new double*[DAVIDSON_NUM_VEC];
+   double ** Hvecs = new double*[DAVIDSON_NUM_VEC];
+   int num_allocated = 0;
+   
+   double * mxM = new double[DAVIDSON_NUM_VEC * DAVIDSON_NUM_VEC];
+   double * mxM_eigs = new double[DAVIDSON_NUM_VEC];
+   double * mxM_vecs = new double[DAVIDSON_NUM_VEC * DAVIDSON_NUM_VEC];
+   int mxM_lwork = 3*DAVIDSON_NUM_VEC-1;
+   double * mxM_work = new double[mxM_lwork];
+   
+   double rtol = dvdsRtolBase * sqrt(length_vec);
+   
+   //The new vectors to add to the basis, the Ritz vectors, and their residuals
+   double ** t_vecs = new double*[nSolve];
+   double ** u_vecs = new double*[nSolve];
+   double ** r_vecs = new double*[nSolve];
+   for (int root=0; root<nSolve; root++){
+      t_vecs[root] = new double[length_vec];
+      u_vecs[root] = new double[length_vec];
+      r_vecs[root] = new double[length_vec];
+   }
+   double * rnorms = new double[nSolve];
+   double * work_vec = new double[length_vec];
+   double * restart_vec = NULL;
+   int inc1 = 1;
+   
+   //The starting vectors are the current states of the Sobjects in symmetric conventions. Linearly dependent ones are replaced by random vectors when they are added.
+   for (int root=0; root<nSolve; root++){ dcopy_(&length_vec,denS[root]->gStorage(),&inc1,t_vecs[root],&inc1); }
+   int num_new = nSolve;
+   
+   double * HeffDiag = new double[length_vec];
+   fillHeffDiag(HeffDiag, denS[0], Ctensors, Dtensors, F0tensors, F1tensors, Xtensors, nLower, VeffTilde);
+   
+   //The contraction schedule is recorded during the first makeHeff call, and replayed afterwards
+   HeffPlan * plan = NULL;
+   if (CheMPS2::HEFF_contractionPlan){
+      const int DIM = max(denBK->gMaxDimAtBound(denS[0]->gIndex()), denBK->gMaxDimAtBound(denS[0]->gIndex()+2));
+      plan = new HeffPlan(denS[0], DIM*DIM);
+   }
+   
+   int nIterations = 0;
+   bool converged = false;
+   bool firstBlock = true;
+   bool firstIteration = true;
+   
+   while (!converged){
+   
+      //1. Orthonormalize the new vectors w.r.t. the basis (twice for stability), and add them to the basis. Dependent vectors are dropped, or replaced by random vectors for the starting block.
+      int num_added = 0;
+      for (int inew=0; inew<num_new; inew++){
+         double * t_vec = t_vecs[inew];
+         int attempt = 0;
+         bool added = false;
+         while ((!added) && (attempt<3)){
+            const double norm_before = sqrt(ddot_(&length_vec,t_vec,&inc1,t_vec,&inc1));
+            for (int pass=0; pass<2; pass++){
+               for (int cnt=0; cnt<num_vec; cnt++){
+                  double min_overlap = - ddot_(&length_vec,t_vec,&inc1,vecs[cnt],&inc1);
+                  daxpy_(&length_vec,&min_overlap,vecs[cnt],&inc1,t_vec,&inc1);
+               }
+            }
+            const double norm_after = sqrt(ddot_(&length_vec,t_vec,&inc1,t_vec,&inc1));
+            if ((norm_before > 0.0) && (norm_after > 1e-8 * norm_before) && (num_vec < DAVIDSON_NUM_VEC)){
+               double alpha = 1.0/norm_after;
+               dscal_(&length_vec,&alpha,t_vec,&inc1);
+               if (num_vec == num_allocated){
+                  vecs[num_allocated] = new double[length_vec];
+                  Hvecs[num_allocated] = new double[length_vec];
+                  num_allocated++;
+               }
+               double * temp = vecs[num_vec];
+               vecs[num_vec] = t_vec;
+               t_vecs[inew] = temp;
+               t_vec = temp;
+               num_vec++;
+               num_added++;
+               added = true;
+            } else {
+               if ((!firstBlock) || (num_vec >= DAVIDSON_NUM_VEC)){ attempt = 3; }
+               else {
+                  for (int cnt=0; cnt<length_vec; cnt++){ t_vec[cnt] = ((double) rand())/RAND_MAX - 0.5; }
+                  attempt++;
+               }
+            }
+         }
+      }
+      firstBlock = false;
+      if (num_added == 0){ //No new directions: the Krylov space is exhausted
+         if (!firstIteration){
+            cout << "WARNING AT HEFF : Block Davidson could not extend its basis; the residual norms (tolerance " << rtol << ") are";
+            for (int root=0; root<min(nSolve, num_vec); root++){ cout << " " << rnorms[root]; }
+            cout << endl;
+         }
+         break;
+      }
+      firstIteration = false;
+      
+      //2. Multiply the new basis vectors with Heff in a single pass
+      makeHeffBlock(num_added, vecs + num_vec - num_added, Hvecs + num_vec - num_added, denS[0], Ltensors, Atensors, Btensors, Ctensors, Dtensors, S0tensors, S1tensors, F0tensors, F1tensors, Qtensors, Xtensors, nLower, VeffTilde, plan);
+      nIterations += num_added;
+      
+      //3. mxM contains the Hamiltonian in the basis "vecs"
+      for (int inew=num_vec-num_added; inew<num_vec; inew++){
+         for (int cnt=0; cnt<=inew; cnt++){
+            mxM[cnt + DAVIDSON_NUM_VEC * inew] = ddot_(&length_vec,vecs[inew],&inc1,Hvecs[cnt],&inc1);
+            mxM[inew + DAVIDSON_NUM_VEC * cnt] = mxM[cnt + DAVIDSON_NUM_VEC * inew];
+         }
+      }
+      
+      //4. Calculate the eigenvalues and vectors of mxM
+      char jobz = 'V';
+      char uplo = 'U';
+      int info;
+      for (int cnt1=0; cnt1<num_vec; cnt1++){
+         for (int cnt2=0; cnt2<num_vec; cnt2++){
+            mxM_vecs[cnt1 + DAVIDSON_NUM_VEC * cnt2] = mxM[cnt1 + DAVIDSON_NUM_VEC * cnt2];
+         }
+      }
+      int lda = DAVIDSON_NUM_VEC;
+      dsyev_(&jobz,&uplo,&num_vec,mxM_vecs,&lda,mxM_eigs,mxM_work,&mxM_lwork,&info); //ascending order of eigs
+      
+      //5. Calculate the Ritz vectors u and their residuals r for the lowest roots
+      const int nRitz = min(nSolve, num_vec);
+      converged = (nRitz == nSolve);
+      num_new = 0;
+      for (int root=0; root<nRitz; root++){
+         for (int cnt=0; cnt<length_vec; cnt++){
+            r_vecs[root][cnt] = 0.0;
+            u_vecs[root][cnt] = 0.0;
+         }
+         for (int cnt=0; cnt<num_vec; cnt++){
+            double alpha = mxM_vecs[cnt + DAVIDSON_NUM_VEC * root];
+            daxpy_(&length_vec,&alpha,Hvecs[cnt],&inc1,r_vecs[root],&inc1);
+            daxpy_(&length_vec,&alpha, vecs[cnt],&inc1,u_vecs[root],&inc1);
+         }
+         double alpha = -mxM_eigs[root];
+         daxpy_(&length_vec,&alpha,u_vecs[root],&inc1,r_vecs[root],&inc1);
+         const double rnorm = sqrt(ddot_(&length_vec,r_vecs[root],&inc1,r_vecs[root],&inc1));
+         rnorms[root] = rnorm;
+         
+         //6. For unconverged roots: the new vector is t = - K^(-1) (r - (u^T K^(-1) r) / (u^T K^(-1) u) u), with K = diag(Heff) - eig
+         if (rnorm > rtol){
+            converged = false;
+            double * t_vec = t_vecs[num_new];
+            for (int cnt=0; cnt<length_vec; cnt++){
+               const double denom = HeffDiag[cnt] - mxM_eigs[root];
+               work_vec[cnt] = u_vecs[root][cnt] / ((fabs(denom) > dvdsPrecondCutoff) ? denom : dvdsPrecondCutoff);
+            }
+            alpha = - ddot_(&length_vec,work_vec,&inc1,r_vecs[root],&inc1)/ddot_(&length_vec,work_vec,&inc1,u_vecs[root],&inc1);
+            dcopy_(&length_vec,r_vecs[root],&inc1,t_vec,&inc1);
+            daxpy_(&length_vec,&alpha,u_vecs[root],&inc1,t_vec,&inc1);
+            for (int cnt=0; cnt<length_vec; cnt++){
+               const double denom = HeffDiag[cnt] - mxM_eigs[root];
+               t_vec[cnt] = - t_vec[cnt] / ((fabs(denom) > dvdsPrecondCutoff) ? denom : dvdsPrecondCutoff);
+            }
+            num_new++;
+         }
+      }
+      
+      if ((!converged) && (dvdsMaxMatvecs>0) && (nIterations >= dvdsMaxMatvecs)){ break; } //The max. number of matrix-vector products is reached: return the current Ritz vectors
+      
+      //7. When the maximum number of vectors would be exceeded: restart with the lowest DAVIDSON_NUM_VEC_KEEP Ritz vectors. Their Heff-products follow from the same linear combinations.
+      if ((!converged) && (num_vec + num_new > DAVIDSON_NUM_VEC)){
+         const int keep = min(num_vec, DAVIDSON_NUM_VEC_KEEP);
+         if (restart_vec==NULL){ restart_vec = new double[length_vec * DAVIDSON_NUM_VEC_KEEP]; }
+         for (int which=0; which<2; which++){
+            double ** basis = (which==0) ? vecs : Hvecs;
+            for (int ivec=0; ivec<keep; ivec++){
+               double * target = restart_vec + length_vec * ivec;
+               for (int cnt=0; cnt<length_vec; cnt++){ target[cnt] = 0.0; }
+               for (int cnt=0; cnt<num_vec; cnt++){ daxpy_(&length_vec, mxM_vecs + cnt + DAVIDSON_NUM_VEC * ivec, basis[cnt], &inc1, target, &inc1); }
+            }
+            for (int ivec=0; ivec<keep; ivec++){ dcopy_(&length_vec, restart_vec + length_vec * ivec, &inc1, basis[ivec], &inc1); }
+         }
+         num_vec = keep;
+         for (int ivec=0; ivec<num_vec; ivec++){
+            for (int ivec2=ivec; ivec2<num_vec; ivec2++){
+               mxM[ivec + DAVIDSON_NUM_VEC * ivec2] = ddot_(&length_vec, vecs[ivec], &inc1, Hvecs[ivec2], &inc1);
+               mxM[ivec2 + DAVIDSON_NUM_VEC * ivec] = mxM[ivec + DAVIDSON_NUM_VEC * ivec2];
+            }
+         }
+      }
+      
+   }
+   
+   if (CheMPS2::HEFF_debugPrint) cout << "   Stats: nIt(BLOCK DAVIDSON) = " << nIterations << endl;
+   dvdsNumMatvecs = nIterations;
+   
+   //Roots which do not fit in the two-site space are returned as zero vectors
+   for (int root=0; root<nRoots; root++){
+      if (root < min(nSolve, num_vec)){
+         eigenvalues[root] = mxM_eigs[root];
+         dcopy_(&length_vec,u_vecs[root],&inc1,denS[root]->gStorage(),&inc1);
+      } else {
+         eigenvalues[root] = 0.0;
+         for (int cnt=0; cnt<length_vec; cnt++){ denS[root]->gStorage()[cnt] = 0.0; }
+      }
+   }
+   
+   for (int cnt=0; cnt<num_allocated; cnt++){
+      delete [] vecs[cnt];
+      delete [] Hvecs[cnt];
+   }
+   for (int root=0; root<nSolve; root++){
+      delete [] t_vecs[root];
+      delete [] u_vecs[root];
+      delete [] r_vecs[root];
+   }
+   delete [] vecs;
+   delete [] Hvecs;
+   delete [] t_vecs;
+   delete [] u_vecs;
+   delete [] r_vecs;
+   delete [] work_vec;
+   delete [] rnorms;
+   if (restart_vec!=NULL){ delete [] restart_vec; }
+   delete [] mxM;
+   delete [] mxM_eigs;
+   delete [] mxM_vecs;
+   delete [] mxM_work;
+   delete [] HeffDiag;
+   if (plan!=NULL){ delete plan; }
+   
+   //convert the Sobjects to program conventions
+   for (int root=0; root<nRoots; root++){ denS[root]->symm2prog(); }
+
+}
+
 int CheMPS2::Heff::phase(const int TwoTimesPower){
 
    return (((TwoTimesPower/2)%2)!=0)?-1:1;
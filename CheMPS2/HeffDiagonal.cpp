@@ -21,7 +21,7 @@
 
 #include "Heff.h"
 #include "Lapack.h"
-#include "Gsl.h"
+#include "Wigner.h"
 
 void CheMPS2::Heff::addDiagonal1A(const int ikappa, double * memHeffDiag, const Sobject * denS, TensorX * Xleft) const{
    int dimL = denBK->gCurrentDim(denS->gIndex(), denS->gNL(ikappa), denS->gTwoSL(ikappa), denS->gIL(ikappa));
@@ -302,7 +302,7 @@ void CheMPS2::Heff::addDiagonal2b3spin1(const int ikappa, double * memHeffDiag,
       int dimR     = denBK->gCurrentDim(theindex+2,NR,TwoSR,IR);
       
       int fase = phase(TwoSL + TwoSR + 2*TwoJ + ((N2==1)?1:0) - 1);
-      const double alpha = fase * (TwoJ+1) * sqrt(3.0*(TwoSL+1)) * gsl_sf_coupling_6j(TwoJ,TwoJ,2,1,1,((N2==1)?1:0)) * gsl_sf_coupling_6j(TwoJ,TwoJ,2,TwoSL,TwoSL,TwoSR);
+      const double alpha = fase * (TwoJ+1) * sqrt(3.0*(TwoSL+1)) * Wigner::wigner6j(TwoJ,TwoJ,2,1,1,((N2==1)?1:0)) * Wigner::wigner6j(TwoJ,TwoJ,2,TwoSL,TwoSL,TwoSR);
       
       double * Dblock = Dtensor->gStorage(NL,TwoSL,IL,NL,TwoSL,IL);
       for (int cntR=0; cntR<dimR; cntR++){
@@ -349,7 +349,7 @@ void CheMPS2::Heff::addDiagonal2c3spin1(const int ikappa, double * memHeffDiag,
       int dimR     = denBK->gCurrentDim(theindex+2,NR,TwoSR,IR);
       
       int fase = phase(TwoSL + TwoSR + 2*TwoJ + ((N1==1)?1:0) - 1);
-      const double alpha = fase * (TwoJ+1) * sqrt(3.0*(TwoSL+1)) * gsl_sf_coupling_6j(TwoJ,TwoJ,2,1,1,((N1==1)?1:0)) * gsl_sf_coupling_6j(TwoJ,TwoJ,2,TwoSL,TwoSL,TwoSR);
+      const double alpha = fase * (TwoJ+1) * sqrt(3.0*(TwoSL+1)) * Wigner::wigner6j(TwoJ,TwoJ,2,1,1,((N1==1)?1:0)) * Wigner::wigner6j(TwoJ,TwoJ,2,TwoSL,TwoSL,TwoSR);
       
       double * Dblock = Dtensor->gStorage(NL,TwoSL,IL,NL,TwoSL,IL);
       for (int cntR=0; cntR<dimR; cntR++){
@@ -396,7 +396,7 @@ void CheMPS2::Heff::addDiagonal2e3spin1(const int ikappa, double * memHeffDiag,
       int dimR     = denBK->gCurrentDim(theindex+2,NR,TwoSR,IR);
       
       int fase = phase(TwoSR + TwoSL + 2*TwoJ + ((N2==1)?1:0) + 1);
-      const double alpha = fase * (TwoJ+1) * sqrt(3.0*(TwoSR+1)) * gsl_sf_coupling_6j(TwoJ,TwoJ,2,1,1,((N2==1)?1:0)) * gsl_sf_coupling_6j(TwoJ,TwoJ,2,TwoSR,TwoSR,TwoSL);
+      const double alpha = fase * (TwoJ+1) * sqrt(3.0*(TwoSR+1)) * Wigner::wigner6j(TwoJ,TwoJ,2,1,1,((N2==1)?1:0)) * Wigner::wigner6j(TwoJ,TwoJ,2,TwoSR,TwoSR,TwoSL);
       
       double * Dblock = Dtensor->gStorage(NR,TwoSR,IR,NR,TwoSR,IR);
       for (int cntR=0; cntR<dimR; cntR++){
@@ -443,7 +443,7 @@ void CheMPS2::Heff::addDiagonal2f3spin1(const int ikappa, double * memHeffDiag,
       int dimR     = denBK->gCurrentDim(theindex+2,NR,TwoSR,IR);
       
       int fase = phase(TwoSR + TwoSL + 2*TwoJ + ((N1==1)?1:0) + 1);
-      const double alpha = fase * (TwoJ+1) * sqrt(3.0*(TwoSR+1)) * gsl_sf_coupling_6j(TwoJ,TwoJ,2,1,1,((N1==1)?1:0)) * gsl_sf_coupling_6j(TwoJ,TwoJ,2,TwoSR,TwoSR,TwoSL);
+      const double alpha = fase * (TwoJ+1) * sqrt(3.0*(TwoSR+1)) * Wigner::wigner6j(TwoJ,TwoJ,2,1,1,((N1==1)?1:0)) * Wigner::wigner6j(TwoJ,TwoJ,2,TwoSR,TwoSR,TwoSL);
       
       double * Dblock = Dtensor->gStorage(NR,TwoSR,IR,NR,TwoSR,IR);
       for (int cntR=0; cntR<dimR; cntR++){
@@ -614,7 +614,7 @@ void CheMPS2::Heff::addDiagonal2a3spin1(const int ikappa, double * memHeffDiag,
    
    int TwoJ = denS->gTwoJ(ikappa);
    const int fase = phase(TwoSL+TwoSR+TwoJ+2);
-   const double alpha = fase * sqrt((TwoSR + 1)*(TwoSL + 1.0)) * gsl_sf_coupling_6j(TwoSL,TwoSR,TwoJ,TwoSR,TwoSL,2);
+   const double alpha = fase * sqrt((TwoSR + 1)*(TwoSL + 1.0)) * Wigner::wigner6j(TwoSL,TwoSR,TwoJ,TwoSR,TwoSL,2);
    
    int theindex = denS->gIndex();
    int ptr = denS->gKappa2index(ikappa);
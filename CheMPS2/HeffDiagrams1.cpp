@@ -30,7 +30,7 @@ void CheMPS2::Heff::addDiagram1A(const int ikappa, double * memS, double * memHe
    
    double one = 1.0;
    char notr = 'N';
-   dgemm_(&notr,&notr,&dimL,&dimR,&dimL,&one,BlockX,&dimL,memS+denS->gKappa2index(ikappa),&dimL,&one,memHeff+denS->gKappa2index(ikappa),&dimL);
+   HeffPlan::dgemm(&notr,&notr,&dimL,&dimR,&dimL,&one,BlockX,&dimL,memS+denS->gKappa2index(ikappa),&dimL,&one,memHeff+denS->gKappa2index(ikappa),&dimL);
 }
 
 void CheMPS2::Heff::addDiagram1B(const int ikappa, double * memS, double * memHeff, const Sobject * denS, TensorX * Xright) const{
@@ -41,7 +41,7 @@ void CheMPS2::Heff::addDiagram1B(const int ikappa, double * memS, double * memHe
    double one = 1.0;
    char notr = 'N';
    char trans = 'T';
-   dgemm_(&notr,&trans,&dimL,&dimR,&dimR,&one,memS+denS->gKappa2index(ikappa),&dimL,BlockX,&dimR,&one,memHeff+denS->gKappa2index(ikappa),&dimL);
+   HeffPlan::dgemm(&notr,&trans,&dimL,&dimR,&dimR,&one,memS+denS->gKappa2index(ikappa),&dimL,BlockX,&dimR,&one,memHeff+denS->gKappa2index(ikappa),&dimL);
 }
 
 void CheMPS2::Heff::addDiagram1C(const int ikappa, double * memS, double * memHeff, const Sobject * denS, double Helem_links) const{
@@ -49,7 +49,7 @@ void CheMPS2::Heff::addDiagram1C(const int ikappa, double * memS, double * memHe
       int inc = 1;
       int ptr = denS->gKappa2index(ikappa);
       int dim = denS->gKappa2index(ikappa+1) - ptr;
-      daxpy_(&dim,&Helem_links,memS+ptr,&inc,memHeff+ptr,&inc);
+      HeffPlan::daxpy(&dim,&Helem_links,memS+ptr,&inc,memHeff+ptr,&inc);
    }
 }
 
@@ -58,7 +58,7 @@ void CheMPS2::Heff::addDiagram1D(const int ikappa, double * memS, double * memHe
       int inc = 1;
       int ptr = denS->gKappa2index(ikappa);
       int dim = denS->gKappa2index(ikappa+1) - ptr;
-      daxpy_(&dim,&Helem_rechts,memS+ptr,&inc,memHeff+ptr,&inc);
+      HeffPlan::daxpy(&dim,&Helem_rechts,memS+ptr,&inc,memHeff+ptr,&inc);
    }
 }
 
@@ -22,7 +22,7 @@
 
 #include "Heff.h"
 #include "Lapack.h"
-#include "Gsl.h"
+#include "Wigner.h"
 
 void CheMPS2::Heff::addDiagram2a1spin0(const int ikappa, double * memS, double * memHeff, const Sobject * denS, TensorA **** Atensors, TensorS0 **** S0tensors, double * workspace) const{
 
@@ -66,11 +66,11 @@ void CheMPS2::Heff::addDiagram2a1spin0(const int ikappa, double * memS, double *
                double alpha = 1.0;
                double beta = 0.0;
                
-               dgemm_(&trans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,BlockS0,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
+               HeffPlan::dgemm(&trans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,BlockS0,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
                
                beta = 1.0;
                
-               dgemm_(&notrans,&notrans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,BlockA,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+               HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,BlockA,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                
             }
          }
@@ -98,11 +98,11 @@ void CheMPS2::Heff::addDiagram2a1spin0(const int ikappa, double * memS, double *
                double alpha = 1.0;
                double beta = 0.0;
                
-               dgemm_(&trans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,BlockA,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
+               HeffPlan::dgemm(&trans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,BlockA,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
                
                beta = 1.0;
                
-               dgemm_(&notrans,&notrans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,BlockS0,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+               HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,BlockS0,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                
             }
          }
@@ -153,11 +153,11 @@ void CheMPS2::Heff::addDiagram2a2spin0(const int ikappa, double * memS, double *
                double alpha = 1.0;
                double beta = 0.0;
                
-               dgemm_(&notrans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,BlockS0,&dimL,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
+               HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,BlockS0,&dimL,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
                
                beta = 1.0;
                
-               dgemm_(&notrans,&trans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,BlockA,&dimR,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+               HeffPlan::dgemm(&notrans,&trans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,BlockA,&dimR,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                
             }
          }
@@ -185,11 +185,11 @@ void CheMPS2::Heff::addDiagram2a2spin0(const int ikappa, double * memS, double *
                double alpha = 1.0;
                double beta = 0.0;
                
-               dgemm_(&notrans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,BlockA,&dimL,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
+               HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,BlockA,&dimL,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
                
                beta = 1.0;
                
-               dgemm_(&notrans,&trans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,BlockS0,&dimR,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+               HeffPlan::dgemm(&notrans,&trans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,BlockS0,&dimR,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                
             }
          }
@@ -226,7 +226,7 @@ void CheMPS2::Heff::addDiagram2a1spin1(const int ikappa, double * memS, double *
             if ((TwoSLdown>=0) && (TwoSRdown>=0) && (abs(TwoSLdown-TwoSRdown)<=TwoJ)){
             
                int fase = phase(TwoSRdown+TwoSL+TwoJ+2);
-               const double thefactor = fase * sqrt((TwoSR + 1)*(TwoSL + 1.0)) * gsl_sf_coupling_6j(TwoSLdown,TwoSRdown,TwoJ,TwoSR,TwoSL,2);
+               const double thefactor = fase * sqrt((TwoSR + 1)*(TwoSL + 1.0)) * Wigner::wigner6j(TwoSLdown,TwoSRdown,TwoJ,TwoSR,TwoSL,2);
       
                for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                   for (int l_beta=l_alpha+1; l_beta<theindex; l_beta++){
@@ -248,11 +248,11 @@ void CheMPS2::Heff::addDiagram2a1spin1(const int ikappa, double * memS, double *
                         double alpha = thefactor;
                         double beta = 0.0;
                
-                        dgemm_(&trans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,BlockS1,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
+                        HeffPlan::dgemm(&trans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,BlockS1,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
                
                         alpha = beta = 1.0;
                
-                        dgemm_(&notrans,&notrans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,BlockB,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                        HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,BlockB,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                
                      }
                   }
@@ -269,7 +269,7 @@ void CheMPS2::Heff::addDiagram2a1spin1(const int ikappa, double * memS, double *
             if ((TwoSLdown>=0) && (TwoSRdown>=0) && (abs(TwoSLdown-TwoSRdown)<=TwoJ)){
             
                int fase = phase(TwoSRdown+TwoSL+TwoJ+2);
-               const double thefactor = fase * sqrt((TwoSR + 1)*(TwoSL + 1.0)) * gsl_sf_coupling_6j(TwoSLdown,TwoSRdown,TwoJ,TwoSR,TwoSL,2);
+               const double thefactor = fase * sqrt((TwoSR + 1)*(TwoSL + 1.0)) * Wigner::wigner6j(TwoSLdown,TwoSRdown,TwoJ,TwoSR,TwoSL,2);
       
                for (int l_gamma=theindex+2; l_gamma<Prob->gL(); l_gamma++){
                   for (int l_delta=l_gamma+1; l_delta<Prob->gL(); l_delta++){
@@ -291,11 +291,11 @@ void CheMPS2::Heff::addDiagram2a1spin1(const int ikappa, double * memS, double *
                         double alpha = thefactor;
                         double beta = 0.0;
                      
-                        dgemm_(&trans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,BlockB,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
+                        HeffPlan::dgemm(&trans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,BlockB,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
                      
                         alpha = beta = 1.0;
                      
-                        dgemm_(&notrans,&notrans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,BlockS1,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                        HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,BlockS1,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                
                      }
                   }
@@ -335,7 +335,7 @@ void CheMPS2::Heff::addDiagram2a2spin1(const int ikappa, double * memS, double *
             if ((TwoSLdown>=0) && (TwoSRdown>=0) && (abs(TwoSLdown-TwoSRdown)<=TwoJ)){
             
                int fase = phase(TwoSLdown+TwoSR+TwoJ+2);
-               const double thefactor = fase * sqrt((TwoSRdown + 1)*(TwoSLdown + 1.0)) * gsl_sf_coupling_6j(TwoSLdown,TwoSRdown,TwoJ,TwoSR,TwoSL,2);
+               const double thefactor = fase * sqrt((TwoSRdown + 1)*(TwoSLdown + 1.0)) * Wigner::wigner6j(TwoSLdown,TwoSRdown,TwoJ,TwoSR,TwoSL,2);
          
                for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                   for (int l_beta=l_alpha+1; l_beta<theindex; l_beta++){
@@ -357,11 +357,11 @@ void CheMPS2::Heff::addDiagram2a2spin1(const int ikappa, double * memS, double *
                         double alpha = thefactor;
                         double beta = 0.0;
                
-                        dgemm_(&notr,&notr,&dimL,&dimRdown,&dimLdown,&alpha,BlockS1,&dimL,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
+                        HeffPlan::dgemm(&notr,&notr,&dimL,&dimRdown,&dimLdown,&alpha,BlockS1,&dimL,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
                
                         alpha = beta = 1.0;
                
-                        dgemm_(&notr,&trans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,BlockB,&dimR,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                        HeffPlan::dgemm(&notr,&trans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,BlockB,&dimR,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                
                      }
                   }
@@ -378,7 +378,7 @@ void CheMPS2::Heff::addDiagram2a2spin1(const int ikappa, double * memS, double *
             if ((TwoSLdown>=0) && (TwoSRdown>=0) && (abs(TwoSLdown-TwoSRdown)<=TwoJ)){
             
                int fase = phase(TwoSLdown+TwoSR+TwoJ+2);
-               const double thefactor = fase * sqrt((TwoSRdown + 1)*(TwoSLdown + 1.0)) * gsl_sf_coupling_6j(TwoSLdown,TwoSRdown,TwoJ,TwoSR,TwoSL,2);
+               const double thefactor = fase * sqrt((TwoSRdown + 1)*(TwoSLdown + 1.0)) * Wigner::wigner6j(TwoSLdown,TwoSRdown,TwoJ,TwoSR,TwoSL,2);
       
                for (int l_gamma=theindex+2; l_gamma<Prob->gL(); l_gamma++){
                   for (int l_delta=l_gamma+1; l_delta<Prob->gL(); l_delta++){
@@ -400,11 +400,11 @@ void CheMPS2::Heff::addDiagram2a2spin1(const int ikappa, double * memS, double *
                         double alpha = thefactor;
                         double beta = 0.0;
                
-                        dgemm_(&notrans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,BlockB,&dimL,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
+                        HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,BlockB,&dimL,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
                
                         alpha = beta = 1.0;
                
-                        dgemm_(&notrans,&trans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,BlockS1,&dimR,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                        HeffPlan::dgemm(&notrans,&trans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,BlockS1,&dimR,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                  
                      }
                   }
@@ -456,11 +456,11 @@ void CheMPS2::Heff::addDiagram2a3spin0(const int ikappa, double * memS, double *
                
                   int size = dimR * dimRdown;
                   int inc = 1;
-                  dcopy_(&size,ptr,&inc,mem,&inc);
+                  HeffPlan::dcopy(&size,ptr,&inc,mem,&inc);
                
                   for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                      double factor = 2 * Prob->gMxElement(l_gamma,l_beta,l_alpha,l_beta) - Prob->gMxElement(l_gamma,l_alpha,l_beta,l_beta);
-                     daxpy_(&size,&factor,F0tensors[theindex+1][0][l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSR,IRdown),&inc,mem,&inc);
+                     HeffPlan::daxpy(&size,&factor,F0tensors[theindex+1][0][l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSR,IRdown),&inc,mem,&inc);
                   }
                   
                   ptr = mem;
@@ -473,11 +473,11 @@ void CheMPS2::Heff::addDiagram2a3spin0(const int ikappa, double * memS, double *
                double alpha = 1.0;
                double beta = 0.0;
                
-               dgemm_(&notrans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,BlockF0,&dimL,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
+               HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,BlockF0,&dimL,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
                
                beta = 1.0;
                
-               dgemm_(&notrans,&trans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,ptr,&dimR,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+               HeffPlan::dgemm(&notrans,&trans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,ptr,&dimR,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                
             }
          }
@@ -501,11 +501,11 @@ void CheMPS2::Heff::addDiagram2a3spin0(const int ikappa, double * memS, double *
                
                   int size = dimR * dimRdown;
                   int inc = 1;
-                  dcopy_(&size,ptr,&inc,mem,&inc);
+                  HeffPlan::dcopy(&size,ptr,&inc,mem,&inc);
                
                   for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                      double alpha = 2 * Prob->gMxElement(l_alpha,l_beta,l_gamma,l_beta) - Prob->gMxElement(l_alpha,l_gamma,l_beta,l_beta);
-                     daxpy_(&size,&alpha,F0tensors[theindex+1][0][l_beta-theindex-2]->gStorage(NR,TwoSR,IRdown,NR,TwoSR,IR),&inc,mem,&inc);
+                     HeffPlan::daxpy(&size,&alpha,F0tensors[theindex+1][0][l_beta-theindex-2]->gStorage(NR,TwoSR,IRdown,NR,TwoSR,IR),&inc,mem,&inc);
                   }
                   
                   ptr = mem;
@@ -518,11 +518,11 @@ void CheMPS2::Heff::addDiagram2a3spin0(const int ikappa, double * memS, double *
                double alpha = 1.0;
                double beta = 0.0;
                
-               dgemm_(&trans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,BlockF0,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
+               HeffPlan::dgemm(&trans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,BlockF0,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
                
                beta = 1.0;
                
-               dgemm_(&notrans,&notrans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,ptr,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+               HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,ptr,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                
             }
          }
@@ -548,11 +548,11 @@ void CheMPS2::Heff::addDiagram2a3spin0(const int ikappa, double * memS, double *
                
                   int size = dimL * dimLdown;
                   int inc = 1;
-                  dcopy_(&size,ptr,&inc,mem,&inc);
+                  HeffPlan::dcopy(&size,ptr,&inc,mem,&inc);
                
                   for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                      double factor = 2 * Prob->gMxElement(l_alpha,l_delta,l_alpha,l_beta) - Prob->gMxElement(l_alpha,l_alpha,l_delta,l_beta);
-                     daxpy_(&size,&factor,F0tensors[theindex-1][0][theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL,TwoSL,ILdown),&inc,mem,&inc);
+                     HeffPlan::daxpy(&size,&factor,F0tensors[theindex-1][0][theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL,TwoSL,ILdown),&inc,mem,&inc);
                   }
                   
                   ptr = mem;
@@ -565,11 +565,11 @@ void CheMPS2::Heff::addDiagram2a3spin0(const int ikappa, double * memS, double *
                double alpha = 1.0;
                double beta = 0.0;
                
-               dgemm_(&notrans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,ptr,&dimL,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
+               HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,ptr,&dimL,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
                
                beta = 1.0;
                
-               dgemm_(&notrans,&trans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,BlockF0,&dimR,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+               HeffPlan::dgemm(&notrans,&trans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,BlockF0,&dimR,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                
             }
          }
@@ -593,11 +593,11 @@ void CheMPS2::Heff::addDiagram2a3spin0(const int ikappa, double * memS, double *
                
                   int size = dimL * dimLdown;
                   int inc = 1;
-                  dcopy_(&size,ptr,&inc,mem,&inc);
+                  HeffPlan::dcopy(&size,ptr,&inc,mem,&inc);
                
                   for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                      double factor = 2 * Prob->gMxElement(l_alpha,l_beta,l_alpha,l_delta) - Prob->gMxElement(l_alpha,l_alpha,l_beta,l_delta);
-                     daxpy_(&size,&factor,F0tensors[theindex-1][0][theindex-1-l_alpha]->gStorage(NL,TwoSL,ILdown,NL,TwoSL,IL),&inc,mem,&inc);
+                     HeffPlan::daxpy(&size,&factor,F0tensors[theindex-1][0][theindex-1-l_alpha]->gStorage(NL,TwoSL,ILdown,NL,TwoSL,IL),&inc,mem,&inc);
                   }
                   
                   ptr = mem;
@@ -610,11 +610,11 @@ void CheMPS2::Heff::addDiagram2a3spin0(const int ikappa, double * memS, double *
                double alpha = 1.0;
                double beta = 0.0;
                
-               dgemm_(&trans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,ptr,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
+               HeffPlan::dgemm(&trans,&notrans,&dimL,&dimRdown,&dimLdown,&alpha,ptr,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
                
                beta = 1.0;
                
-               dgemm_(&notrans,&notrans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,BlockF0,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+               HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimR,&dimRdown,&alpha,workspace,&dimL,BlockF0,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                
             }
          }
@@ -651,7 +651,7 @@ void CheMPS2::Heff::addDiagram2a3spin1(const int ikappa, double * memS, double *
             if ((TwoSLdown>=0) && (TwoSRdown>=0) && (abs(TwoSLdown-TwoSRdown)<=TwoJ)){
             
                int fase = phase(TwoSLdown+TwoSRdown+TwoJ+2);
-               double prefactor = fase * sqrt((TwoSR + 1)*(TwoSLdown + 1.0)) * gsl_sf_coupling_6j(TwoSLdown,TwoSRdown,TwoJ,TwoSR,TwoSL,2);
+               double prefactor = fase * sqrt((TwoSR + 1)*(TwoSLdown + 1.0)) * Wigner::wigner6j(TwoSLdown,TwoSRdown,TwoJ,TwoSR,TwoSL,2);
       
                for (int l_gamma=0; l_gamma<theindex; l_gamma++){
                   for (int l_alpha=l_gamma+1; l_alpha<theindex; l_alpha++){
@@ -671,11 +671,11 @@ void CheMPS2::Heff::addDiagram2a3spin1(const int ikappa, double * memS, double *
                         
                            int size = dimR * dimRdown;
                            int inc = 1;
-                           dcopy_(&size,ptr,&inc,mem,&inc);
+                           HeffPlan::dcopy(&size,ptr,&inc,mem,&inc);
                
                            for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                               double factor = - Prob->gMxElement(l_gamma,l_alpha,l_beta,l_beta);
-                              daxpy_(&size,&factor,F1tensors[theindex+1][0][l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSRdown,IRdown),&inc,mem,&inc);
+                              HeffPlan::daxpy(&size,&factor,F1tensors[theindex+1][0][l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSRdown,IRdown),&inc,mem,&inc);
                            }
                            
                            ptr = mem;
@@ -687,18 +687,18 @@ void CheMPS2::Heff::addDiagram2a3spin1(const int ikappa, double * memS, double *
                         char notr = 'N';
                         double beta = 0.0;
                
-                        dgemm_(&notr,&notr,&dimL,&dimRdown,&dimLdown,&prefactor,BlockF1,&dimL,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
+                        HeffPlan::dgemm(&notr,&notr,&dimL,&dimRdown,&dimLdown,&prefactor,BlockF1,&dimL,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
                
                         beta = 1.0;
                
-                        dgemm_(&notr,&trans,&dimL,&dimR,&dimRdown,&beta,workspace,&dimL,ptr,&dimR,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                        HeffPlan::dgemm(&notr,&trans,&dimL,&dimR,&dimRdown,&beta,workspace,&dimL,ptr,&dimR,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                
                      }
                   }
                }
                
                fase = phase(TwoSL+TwoSR+TwoJ+2);
-               prefactor = fase * sqrt((TwoSRdown + 1)*(TwoSL + 1.0)) * gsl_sf_coupling_6j(TwoSLdown,TwoSRdown,TwoJ,TwoSR,TwoSL,2);
+               prefactor = fase * sqrt((TwoSRdown + 1)*(TwoSL + 1.0)) * Wigner::wigner6j(TwoSLdown,TwoSRdown,TwoJ,TwoSR,TwoSL,2);
       
                for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                   for (int l_gamma=l_alpha; l_gamma<theindex; l_gamma++){
@@ -718,11 +718,11 @@ void CheMPS2::Heff::addDiagram2a3spin1(const int ikappa, double * memS, double *
                         
                            int size = dimR * dimRdown;
                            int inc = 1;
-                           dcopy_(&size,ptr,&inc,mem,&inc);
+                           HeffPlan::dcopy(&size,ptr,&inc,mem,&inc);
                
                            for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                               double alpha = - Prob->gMxElement(l_alpha,l_gamma,l_beta,l_beta);
-                              daxpy_(&size,&alpha,F1tensors[theindex+1][0][l_beta-theindex-2]->gStorage(NR,TwoSRdown,IRdown,NR,TwoSR,IR),&inc,mem,&inc);
+                              HeffPlan::daxpy(&size,&alpha,F1tensors[theindex+1][0][l_beta-theindex-2]->gStorage(NR,TwoSRdown,IRdown,NR,TwoSR,IR),&inc,mem,&inc);
                            }
                            
                            ptr = mem;
@@ -734,11 +734,11 @@ void CheMPS2::Heff::addDiagram2a3spin1(const int ikappa, double * memS, double *
                         char notr = 'N';
                         double beta = 0.0;
                         
-                        dgemm_(&trans,&notr,&dimL,&dimRdown,&dimLdown,&prefactor,BlockF1,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
+                        HeffPlan::dgemm(&trans,&notr,&dimL,&dimRdown,&dimLdown,&prefactor,BlockF1,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
                
                         beta = 1.0;
                
-                        dgemm_(&notr,&notr,&dimL,&dimR,&dimRdown,&beta,workspace,&dimL,ptr,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                        HeffPlan::dgemm(&notr,&notr,&dimL,&dimR,&dimRdown,&beta,workspace,&dimL,ptr,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                
                      }
                   }
@@ -755,7 +755,7 @@ void CheMPS2::Heff::addDiagram2a3spin1(const int ikappa, double * memS, double *
             if ((TwoSLdown>=0) && (TwoSRdown>=0) && (abs(TwoSLdown-TwoSRdown)<=TwoJ)){
             
                int fase = phase(TwoSLdown+TwoSRdown+TwoJ+2);
-               double prefactor = fase * sqrt((TwoSR + 1)*(TwoSLdown + 1.0)) * gsl_sf_coupling_6j(TwoSLdown,TwoSRdown,TwoJ,TwoSR,TwoSL,2);
+               double prefactor = fase * sqrt((TwoSR + 1)*(TwoSLdown + 1.0)) * Wigner::wigner6j(TwoSLdown,TwoSRdown,TwoJ,TwoSR,TwoSL,2);
       
                for (int l_delta=theindex+2; l_delta<Prob->gL(); l_delta++){
                   for (int l_beta=l_delta+1; l_beta<Prob->gL(); l_beta++){
@@ -775,11 +775,11 @@ void CheMPS2::Heff::addDiagram2a3spin1(const int ikappa, double * memS, double *
                         
                            int size = dimL * dimLdown;
                            int inc = 1;
-                           dcopy_(&size,ptr,&inc,mem,&inc);
+                           HeffPlan::dcopy(&size,ptr,&inc,mem,&inc);
                         
                            for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                               double factor = - Prob->gMxElement(l_alpha,l_alpha,l_delta,l_beta);
-                              daxpy_(&size,&factor,F1tensors[theindex-1][0][theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL,TwoSLdown,ILdown),&inc,mem,&inc);
+                              HeffPlan::daxpy(&size,&factor,F1tensors[theindex-1][0][theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL,TwoSLdown,ILdown),&inc,mem,&inc);
                            }
                            
                            ptr = mem;
@@ -791,18 +791,18 @@ void CheMPS2::Heff::addDiagram2a3spin1(const int ikappa, double * memS, double *
                         char notr = 'N';
                         double beta = 0.0;
                
-                        dgemm_(&notr,&notr,&dimL,&dimRdown,&dimLdown,&prefactor,ptr,&dimL,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
+                        HeffPlan::dgemm(&notr,&notr,&dimL,&dimRdown,&dimLdown,&prefactor,ptr,&dimL,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
                
                         beta = 1.0;
                
-                        dgemm_(&notr,&trans,&dimL,&dimR,&dimRdown,&beta,workspace,&dimL,BlockF1,&dimR,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                        HeffPlan::dgemm(&notr,&trans,&dimL,&dimR,&dimRdown,&beta,workspace,&dimL,BlockF1,&dimR,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                
                      }
                   }
                }
                
                fase = phase(TwoSL+TwoSR+TwoJ+2);
-               prefactor = fase * sqrt((TwoSRdown + 1)*(TwoSL + 1.0)) * gsl_sf_coupling_6j(TwoSLdown,TwoSRdown,TwoJ,TwoSR,TwoSL,2);
+               prefactor = fase * sqrt((TwoSRdown + 1)*(TwoSL + 1.0)) * Wigner::wigner6j(TwoSLdown,TwoSRdown,TwoJ,TwoSR,TwoSL,2);
       
                for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                   for (int l_delta=l_beta; l_delta<Prob->gL(); l_delta++){
@@ -821,11 +821,11 @@ void CheMPS2::Heff::addDiagram2a3spin1(const int ikappa, double * memS, double *
                         if (denBK->gIrrep(l_beta)==denBK->gIrrep(l_delta)){
                            int size = dimL * dimLdown;
                            int inc = 1;
-                           dcopy_(&size,ptr,&inc,mem,&inc);
+                           HeffPlan::dcopy(&size,ptr,&inc,mem,&inc);
                
                            for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                               double factor = - Prob->gMxElement(l_alpha,l_alpha,l_beta,l_delta);
-                              daxpy_(&size,&factor,F1tensors[theindex-1][0][theindex-1-l_alpha]->gStorage(NL,TwoSLdown,ILdown,NL,TwoSL,IL),&inc,mem,&inc);
+                              HeffPlan::daxpy(&size,&factor,F1tensors[theindex-1][0][theindex-1-l_alpha]->gStorage(NL,TwoSLdown,ILdown,NL,TwoSL,IL),&inc,mem,&inc);
                            }
                            
                            ptr = mem;
@@ -837,11 +837,11 @@ void CheMPS2::Heff::addDiagram2a3spin1(const int ikappa, double * memS, double *
                         char notr = 'N';
                         double beta = 0.0;
                
-                        dgemm_(&trans,&notr,&dimL,&dimRdown,&dimLdown,&prefactor,ptr,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
+                        HeffPlan::dgemm(&trans,&notr,&dimL,&dimRdown,&dimLdown,&prefactor,ptr,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,workspace,&dimL);
                
                         beta = 1.0;
                
-                        dgemm_(&notr,&notr,&dimL,&dimR,&dimRdown,&beta,workspace,&dimL,BlockF1,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                        HeffPlan::dgemm(&notr,&notr,&dimL,&dimR,&dimRdown,&beta,workspace,&dimL,BlockF1,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                
                      }
                   }
@@ -885,7 +885,7 @@ void CheMPS2::Heff::addDiagram2b1and2b2(const int ikappa, double * memS, double
             double alpha = sqrt(2.0);
             double beta = 1.0;
             
-            dgemm_(&trans,&notrans,&dimLup,&dimR,&dimLdown,&alpha,BlockA,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+            HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimR,&dimLdown,&alpha,BlockA,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
          }
       }
@@ -918,7 +918,7 @@ void CheMPS2::Heff::addDiagram2b1and2b2(const int ikappa, double * memS, double
             double alpha = sqrt(2.0);
             double beta = 1.0;
             
-            dgemm_(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&alpha,BlockA,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+            HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&alpha,BlockA,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
          }
       }
@@ -958,7 +958,7 @@ void CheMPS2::Heff::addDiagram2c1and2c2(const int ikappa, double * memS, double
             double alpha = sqrt(2.0);
             double beta = 1.0;
             
-            dgemm_(&trans,&notrans,&dimLup,&dimR,&dimLdown,&alpha,BlockA,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+            HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimR,&dimLdown,&alpha,BlockA,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
          }
       }
@@ -991,7 +991,7 @@ void CheMPS2::Heff::addDiagram2c1and2c2(const int ikappa, double * memS, double
             double alpha = sqrt(2.0);
             double beta = 1.0;
             
-            dgemm_(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&alpha,BlockA,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+            HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&alpha,BlockA,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
          }
       }
@@ -1014,7 +1014,7 @@ void CheMPS2::Heff::addDiagram2dall(const int ikappa, double * memS, double * me
       
       if (memSkappa!=-1){
          double factor = Prob->gMxElement(theindex, theindex, theindex+1, theindex+1);
-         daxpy_(&size,&factor,memS+denS->gKappa2index(memSkappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
+         HeffPlan::daxpy(&size,&factor,memS+denS->gKappa2index(memSkappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
       }
    }
    
@@ -1024,14 +1024,14 @@ void CheMPS2::Heff::addDiagram2dall(const int ikappa, double * memS, double * me
       
       if (memSkappa!=-1){
          double factor = Prob->gMxElement(theindex, theindex, theindex+1, theindex+1);
-         daxpy_(&size,&factor,memS+denS->gKappa2index(memSkappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
+         HeffPlan::daxpy(&size,&factor,memS+denS->gKappa2index(memSkappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
       }
    }
    
    if ((N1==2) && (N2==2)){ //2d3a
    
       double factor = 4 * Prob->gMxElement(theindex, theindex+1, theindex, theindex+1) - 2 * Prob->gMxElement(theindex, theindex, theindex+1, theindex+1);
-      daxpy_(&size,&factor,memS+denS->gKappa2index(ikappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
+      HeffPlan::daxpy(&size,&factor,memS+denS->gKappa2index(ikappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
    
    }
    
@@ -1039,21 +1039,21 @@ void CheMPS2::Heff::addDiagram2dall(const int ikappa, double * memS, double * me
    
       int fase = (denS->gTwoJ(ikappa) == 0)? 1: -1;
       double factor = Prob->gMxElement(theindex, theindex+1, theindex, theindex+1) + fase * Prob->gMxElement(theindex, theindex, theindex+1, theindex+1);
-      daxpy_(&size,&factor,memS+denS->gKappa2index(ikappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
+      HeffPlan::daxpy(&size,&factor,memS+denS->gKappa2index(ikappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
    
    }
    
    if ((N1==2) && (N2==1)){ //2d3c
    
       double factor = 2 * Prob->gMxElement(theindex, theindex+1, theindex, theindex+1) - Prob->gMxElement(theindex, theindex, theindex+1, theindex+1);
-      daxpy_(&size,&factor,memS+denS->gKappa2index(ikappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
+      HeffPlan::daxpy(&size,&factor,memS+denS->gKappa2index(ikappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
    
    }
    
    if ((N1==1) && (N2==2)){ //2d3d
    
       double factor = 2 * Prob->gMxElement(theindex, theindex+1, theindex, theindex+1) - Prob->gMxElement(theindex, theindex, theindex+1, theindex+1);
-      daxpy_(&size,&factor,memS+denS->gKappa2index(ikappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
+      HeffPlan::daxpy(&size,&factor,memS+denS->gKappa2index(ikappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
    
    }
    
@@ -1086,7 +1086,7 @@ void CheMPS2::Heff::addDiagram2e1and2e2(const int ikappa, double * memS, double
          double alpha = sqrt(2.0);
          double beta = 1.0;
             
-         dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,BlockA,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+         HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,BlockA,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
 
       }
    }
@@ -1115,7 +1115,7 @@ void CheMPS2::Heff::addDiagram2e1and2e2(const int ikappa, double * memS, double
          double alpha = sqrt(2.0);
          double beta = 1.0;
             
-         dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,BlockA,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+         HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,BlockA,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
 
       }
    }
@@ -1149,7 +1149,7 @@ void CheMPS2::Heff::addDiagram2f1and2f2(const int ikappa, double * memS, double
          double alpha = sqrt(2.0);
          double beta = 1.0;
             
-         dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,BlockA,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+         HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,BlockA,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
 
       }
    }
@@ -1178,7 +1178,7 @@ void CheMPS2::Heff::addDiagram2f1and2f2(const int ikappa, double * memS, double
          double alpha = sqrt(2.0);
          double beta = 1.0;
             
-         dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,BlockA,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+         HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,BlockA,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
 
       }
    }
@@ -1203,13 +1203,13 @@ void CheMPS2::Heff::addDiagram2b3spin0(const int ikappa, double * memS, double *
       int size = dimL*dimL;
       int inc = 1;
       double * Cblock = Ctensor->gStorage(NL,TwoSL,IL,NL,TwoSL,IL);
-      dcopy_(&size,Cblock,&inc,workmem,&inc);
+      HeffPlan::dcopy(&size,Cblock,&inc,workmem,&inc);
       
       for (int l_alpha=0; l_alpha<theindex; l_alpha++){
       
          double * F0block = F0tensors[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL,TwoSL,IL);
          double factor = 2 * Prob->gMxElement(l_alpha,theindex,l_alpha,theindex) - Prob->gMxElement(l_alpha,l_alpha,theindex,theindex);
-         daxpy_(&size,&factor,F0block,&inc,workmem,&inc);
+         HeffPlan::daxpy(&size,&factor,F0block,&inc,workmem,&inc);
       
       }
       
@@ -1218,7 +1218,7 @@ void CheMPS2::Heff::addDiagram2b3spin0(const int ikappa, double * memS, double *
       double alpha = ((N1==2)?1.0:0.5)*sqrt(2.0);
       double beta = 1.0;
             
-      dgemm_(&trans,&notrans,&dimL,&dimR,&dimL,&alpha,workmem,&dimL,memS+denS->gKappa2index(ikappa),&dimL,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+      HeffPlan::dgemm(&trans,&notrans,&dimL,&dimR,&dimL,&alpha,workmem,&dimL,memS+denS->gKappa2index(ikappa),&dimL,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
 
    }
    
@@ -1242,13 +1242,13 @@ void CheMPS2::Heff::addDiagram2c3spin0(const int ikappa, double * memS, double *
       int size = dimL*dimL;
       int inc = 1;
       double * Cblock = Ctensor->gStorage(NL,TwoSL,IL,NL,TwoSL,IL);
-      dcopy_(&size,Cblock,&inc,workmem,&inc);
+      HeffPlan::dcopy(&size,Cblock,&inc,workmem,&inc);
       
       for (int l_alpha=0; l_alpha<theindex; l_alpha++){
       
          double * F0block = F0tensors[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL,TwoSL,IL);
          double factor = 2 * Prob->gMxElement(l_alpha,theindex+1,l_alpha,theindex+1) - Prob->gMxElement(l_alpha,l_alpha,theindex+1,theindex+1);
-         daxpy_(&size,&factor,F0block,&inc,workmem,&inc);
+         HeffPlan::daxpy(&size,&factor,F0block,&inc,workmem,&inc);
       
       }
       
@@ -1257,7 +1257,7 @@ void CheMPS2::Heff::addDiagram2c3spin0(const int ikappa, double * memS, double *
       double alpha = ((N2==2)?1.0:0.5)*sqrt(2.0);
       double beta = 1.0;
             
-      dgemm_(&trans,&notrans,&dimL,&dimR,&dimL,&alpha,workmem,&dimL,memS+denS->gKappa2index(ikappa),&dimL,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+      HeffPlan::dgemm(&trans,&notrans,&dimL,&dimR,&dimL,&alpha,workmem,&dimL,memS+denS->gKappa2index(ikappa),&dimL,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
 
    }
    
@@ -1281,13 +1281,13 @@ void CheMPS2::Heff::addDiagram2e3spin0(const int ikappa, double * memS, double *
       int size = dimR*dimR;
       int inc = 1;
       double * Cblock = Ctensor->gStorage(NR,TwoSR,IR,NR,TwoSR,IR);
-      dcopy_(&size,Cblock,&inc,workmem,&inc);
+      HeffPlan::dcopy(&size,Cblock,&inc,workmem,&inc);
       
       for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
       
          double * F0block = F0tensors[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSR,IR);
          double factor = 2 * Prob->gMxElement(theindex,l_beta,theindex,l_beta) - Prob->gMxElement(theindex,theindex,l_beta,l_beta);
-         daxpy_(&size,&factor,F0block,&inc,workmem,&inc);
+         HeffPlan::daxpy(&size,&factor,F0block,&inc,workmem,&inc);
       
       }
       
@@ -1295,7 +1295,7 @@ void CheMPS2::Heff::addDiagram2e3spin0(const int ikappa, double * memS, double *
       double alpha = ((N1==2)?1.0:0.5)*sqrt(2.0);
       double beta = 1.0;
             
-      dgemm_(&notrans,&notrans,&dimL,&dimR,&dimR,&alpha,memS+denS->gKappa2index(ikappa),&dimL,workmem,&dimR,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+      HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimR,&dimR,&alpha,memS+denS->gKappa2index(ikappa),&dimL,workmem,&dimR,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
 
    }
    
@@ -1319,13 +1319,13 @@ void CheMPS2::Heff::addDiagram2f3spin0(const int ikappa, double * memS, double *
       int size = dimR*dimR;
       int inc = 1;
       double * Cblock = Ctensor->gStorage(NR,TwoSR,IR,NR,TwoSR,IR);
-      dcopy_(&size,Cblock,&inc,workmem,&inc);
+      HeffPlan::dcopy(&size,Cblock,&inc,workmem,&inc);
       
       for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
       
          double * F0block = F0tensors[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSR,IR);
          double factor = 2 * Prob->gMxElement(theindex+1,l_beta,theindex+1,l_beta) - Prob->gMxElement(theindex+1,theindex+1,l_beta,l_beta);
-         daxpy_(&size,&factor,F0block,&inc,workmem,&inc);
+         HeffPlan::daxpy(&size,&factor,F0block,&inc,workmem,&inc);
       
       }
       
@@ -1333,7 +1333,7 @@ void CheMPS2::Heff::addDiagram2f3spin0(const int ikappa, double * memS, double *
       double alpha = ((N2==2)?1.0:0.5)*sqrt(2.0);
       double beta = 1.0;
             
-      dgemm_(&notrans,&notrans,&dimL,&dimR,&dimR,&alpha,memS+denS->gKappa2index(ikappa),&dimL,workmem,&dimR,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+      HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimR,&dimR,&alpha,memS+denS->gKappa2index(ikappa),&dimL,workmem,&dimR,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
 
    }
    
@@ -1368,13 +1368,13 @@ void CheMPS2::Heff::addDiagram2b3spin1(const int ikappa, double * memS, double *
             int size = dimLup * dimLdown;
             int inc = 1;
             double * Dblock = Dtensor->gStorage(NL,TwoSLdown,IL,NL,TwoSL,IL);
-            dcopy_(&size,Dblock,&inc,workmem,&inc);
+            HeffPlan::dcopy(&size,Dblock,&inc,workmem,&inc);
          
             for (int l_alpha=0; l_alpha<theindex; l_alpha++){
       
                double * F1block = F1tensors[theindex-1-l_alpha]->gStorage(NL,TwoSLdown,IL,NL,TwoSL,IL);
                double factor = - Prob->gMxElement(l_alpha,l_alpha,theindex,theindex);
-               daxpy_(&size,&factor,F1block,&inc,workmem,&inc);
+               HeffPlan::daxpy(&size,&factor,F1block,&inc,workmem,&inc);
       
             }
             
@@ -1388,12 +1388,12 @@ void CheMPS2::Heff::addDiagram2b3spin1(const int ikappa, double * memS, double *
                   if (memSkappa!=-1){
             
                      int fase = phase(TwoSLdown + TwoSR + TwoJ + TwoS2 + TwoJdown - 1);
-                     double alpha = fase * sqrt(3.0*(TwoJ+1)*(TwoJdown+1)*(TwoSL+1)) * gsl_sf_coupling_6j(TwoJdown,TwoJ,2,1,1,TwoS2) * gsl_sf_coupling_6j(TwoJdown,TwoJ,2,TwoSL,TwoSLdown,TwoSR);
+                     double alpha = fase * sqrt(3.0*(TwoJ+1)*(TwoJdown+1)*(TwoSL+1)) * Wigner::wigner6j(TwoJdown,TwoJ,2,1,1,TwoS2) * Wigner::wigner6j(TwoJdown,TwoJ,2,TwoSL,TwoSLdown,TwoSR);
                      char trans = 'T';
                      char notra = 'N';
                      double beta = 1.0;
                
-                     dgemm_(&trans,&notra,&dimLup,&dimR,&dimLdown,&alpha,workmem,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notra,&dimLup,&dimR,&dimLdown,&alpha,workmem,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
             
                   }
                }
@@ -1433,13 +1433,13 @@ void CheMPS2::Heff::addDiagram2c3spin1(const int ikappa, double * memS, double *
             int size = dimLup * dimLdown;
             int inc = 1;
             double * Dblock = Dtensor->gStorage(NL,TwoSLdown,IL,NL,TwoSL,IL);
-            dcopy_(&size,Dblock,&inc,workmem,&inc);
+            HeffPlan::dcopy(&size,Dblock,&inc,workmem,&inc);
          
             for (int l_alpha=0; l_alpha<theindex; l_alpha++){
       
                double * F1block = F1tensors[theindex-1-l_alpha]->gStorage(NL,TwoSLdown,IL,NL,TwoSL,IL);
                double factor = - Prob->gMxElement(l_alpha,l_alpha,theindex+1,theindex+1);
-               daxpy_(&size,&factor,F1block,&inc,workmem,&inc);
+               HeffPlan::daxpy(&size,&factor,F1block,&inc,workmem,&inc);
       
             }
             
@@ -1453,12 +1453,12 @@ void CheMPS2::Heff::addDiagram2c3spin1(const int ikappa, double * memS, double *
                   if (memSkappa!=-1){
             
                      int fase = phase(TwoSLdown + TwoSR + 2*TwoJ + TwoS1 - 1);
-                     double alpha = fase * sqrt(3.0*(TwoJ+1)*(TwoJdown+1)*(TwoSL+1)) * gsl_sf_coupling_6j(TwoJdown,TwoJ,2,1,1,TwoS1) * gsl_sf_coupling_6j(TwoJdown,TwoJ,2,TwoSL,TwoSLdown,TwoSR);
+                     double alpha = fase * sqrt(3.0*(TwoJ+1)*(TwoJdown+1)*(TwoSL+1)) * Wigner::wigner6j(TwoJdown,TwoJ,2,1,1,TwoS1) * Wigner::wigner6j(TwoJdown,TwoJ,2,TwoSL,TwoSLdown,TwoSR);
                      char trans = 'T';
                      char notra = 'N';
                      double beta = 1.0;
                
-                     dgemm_(&trans,&notra,&dimLup,&dimR,&dimLdown,&alpha,workmem,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notra,&dimLup,&dimR,&dimLdown,&alpha,workmem,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                      
                   }
                }
@@ -1498,13 +1498,13 @@ void CheMPS2::Heff::addDiagram2e3spin1(const int ikappa, double * memS, double *
             int size = dimRup * dimRdown;
             int inc = 1;
             double * Dblock = Dtensor->gStorage(NR,TwoSRdown,IR,NR,TwoSR,IR);
-            dcopy_(&size,Dblock,&inc,workmem,&inc);
+            HeffPlan::dcopy(&size,Dblock,&inc,workmem,&inc);
          
             for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
       
                double * F1block = F1tensors[l_beta-theindex-2]->gStorage(NR,TwoSRdown,IR,NR,TwoSR,IR);
                double factor = - Prob->gMxElement(theindex,theindex,l_beta,l_beta);
-               daxpy_(&size,&factor,F1block,&inc,workmem,&inc);
+               HeffPlan::daxpy(&size,&factor,F1block,&inc,workmem,&inc);
       
             }
             
@@ -1518,11 +1518,11 @@ void CheMPS2::Heff::addDiagram2e3spin1(const int ikappa, double * memS, double *
                   if (memSkappa!=-1){
             
                      int fase = phase(TwoSRdown + TwoSL + 2*TwoJ + TwoS2 + 1);
-                     double alpha = fase * sqrt(3.0*(TwoJ+1)*(TwoJdown+1)*(TwoSRdown+1)) * gsl_sf_coupling_6j(TwoJdown,TwoJ,2,1,1,TwoS2) * gsl_sf_coupling_6j(TwoJdown,TwoJ,2,TwoSR,TwoSRdown,TwoSL);
+                     double alpha = fase * sqrt(3.0*(TwoJ+1)*(TwoJdown+1)*(TwoSRdown+1)) * Wigner::wigner6j(TwoJdown,TwoJ,2,1,1,TwoS2) * Wigner::wigner6j(TwoJdown,TwoJ,2,TwoSR,TwoSRdown,TwoSL);
                      char notr = 'N';
                      double beta = 1.0;
                
-                     dgemm_(&notr,&notr,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,workmem,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                     HeffPlan::dgemm(&notr,&notr,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,workmem,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                      
                   }
                }
@@ -1562,13 +1562,13 @@ void CheMPS2::Heff::addDiagram2f3spin1(const int ikappa, double * memS, double *
             int size = dimRup * dimRdown;
             int inc = 1;
             double * Dblock = Dtensor->gStorage(NR,TwoSRdown,IR,NR,TwoSR,IR);
-            dcopy_(&size,Dblock,&inc,workmem,&inc);
+            HeffPlan::dcopy(&size,Dblock,&inc,workmem,&inc);
          
             for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
       
                double * F1block = F1tensors[l_beta-theindex-2]->gStorage(NR,TwoSRdown,IR,NR,TwoSR,IR);
                double factor = - Prob->gMxElement(theindex+1,theindex+1,l_beta,l_beta);
-               daxpy_(&size,&factor,F1block,&inc,workmem,&inc);
+               HeffPlan::daxpy(&size,&factor,F1block,&inc,workmem,&inc);
       
             }
             
@@ -1582,11 +1582,11 @@ void CheMPS2::Heff::addDiagram2f3spin1(const int ikappa, double * memS, double *
                   if (memSkappa!=-1){
             
                      int fase = phase(TwoSRdown + TwoSL + TwoJ + TwoS1 + TwoJdown + 1);
-                     double alpha = fase * sqrt(3.0*(TwoJ+1)*(TwoJdown+1)*(TwoSRdown+1)) * gsl_sf_coupling_6j(TwoJdown,TwoJ,2,1,1,TwoS1) * gsl_sf_coupling_6j(TwoJdown,TwoJ,2,TwoSR,TwoSRdown,TwoSL);
+                     double alpha = fase * sqrt(3.0*(TwoJ+1)*(TwoJdown+1)*(TwoSRdown+1)) * Wigner::wigner6j(TwoJdown,TwoJ,2,1,1,TwoS1) * Wigner::wigner6j(TwoJdown,TwoJ,2,TwoSR,TwoSRdown,TwoSL);
                      char notr = 'N';
                      double beta = 1.0;
                
-                     dgemm_(&notr,&notr,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,workmem,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                     HeffPlan::dgemm(&notr,&notr,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,workmem,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                      
                   }
                }
@@ -22,7 +22,7 @@
 
 #include "Heff.h"
 #include "Lapack.h"
-#include "Gsl.h"
+#include "Wigner.h"
 
 void CheMPS2::Heff::addDiagram3Aand3D(const int ikappa, double * memS, double * memHeff, const Sobject * denS, TensorQ * Qleft, TensorL ** Lleft, double * temp) const{
 
@@ -56,24 +56,24 @@ void CheMPS2::Heff::addDiagram3Aand3D(const int ikappa, double * memS, double *
                   int memSkappa = denS->gKappa(NL+1,TwoSLdown,ILdown,1,N2,TwoJdown,NR,TwoSR,IR);
                   if (memSkappa!=-1){
                      int fase = phase(TwoSL+TwoSR+2+TwoS2);
-                     double factor = sqrt((TwoJdown+1)*(TwoSLdown+1.0))*fase*gsl_sf_coupling_6j(TwoJdown,TwoS2,1,TwoSL,TwoSLdown,TwoSR);
+                     double factor = sqrt((TwoJdown+1)*(TwoSLdown+1.0))*fase*Wigner::wigner6j(TwoJdown,TwoS2,1,TwoSL,TwoSLdown,TwoSR);
                      double beta = 1.0; //add
                      char notr = 'N';
                   
                      double * BlockQ = Qleft->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                      int inc = 1;
                      int size = dimLup * dimLdown;
-                     dcopy_(&size, BlockQ, &inc, temp, &inc);
+                     HeffPlan::dcopy(&size, BlockQ, &inc, temp, &inc);
                   
                      for (int l_index=0; l_index<theindex; l_index++){
                         if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                            double alpha = Prob->gMxElement(l_index,theindex,theindex,theindex);
                            double * BlockL = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                           daxpy_(&size, &alpha, BlockL, &inc, temp, &inc);
+                           HeffPlan::daxpy(&size, &alpha, BlockL, &inc, temp, &inc);
                         }
                      }
                   
-                     dgemm_(&notr,&notr,&dimLup,&dimR,&dimLdown,&factor,temp,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&notr,&notr,&dimLup,&dimR,&dimLdown,&factor,temp,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   }
                }
             }
@@ -88,11 +88,11 @@ void CheMPS2::Heff::addDiagram3Aand3D(const int ikappa, double * memS, double *
             int memSkappa = denS->gKappa(NL+1,TwoSLdown,ILdown,0,N2,TwoS2,NR,TwoSR,IR);
             if (memSkappa!=-1){
                int fase = phase(TwoSL+TwoSR+1+TwoS2);
-               double factor = sqrt((TwoSLdown+1)*(TwoJ+1.0))*fase*gsl_sf_coupling_6j(TwoS2,TwoJ,1,TwoSL,TwoSLdown,TwoSR);
+               double factor = sqrt((TwoSLdown+1)*(TwoJ+1.0))*fase*Wigner::wigner6j(TwoS2,TwoJ,1,TwoSL,TwoSLdown,TwoSR);
                double beta = 1.0;
                char notr = 'N';
                double * BlockQ = Qleft->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-               dgemm_(&notr,&notr,&dimLup,&dimR,&dimLdown,&factor,BlockQ,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+               HeffPlan::dgemm(&notr,&notr,&dimLup,&dimR,&dimLdown,&factor,BlockQ,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
             }
          }
       }
@@ -111,12 +111,12 @@ void CheMPS2::Heff::addDiagram3Aand3D(const int ikappa, double * memS, double *
                   int memSkappa = denS->gKappa(NL-1,TwoSLdown,ILdown,1,N2,TwoJdown,NR,TwoSR,IR);
                   if (memSkappa!=-1){
                      int fase = phase(TwoSLdown+TwoSR+1+TwoS2);
-                     double factor = fase*sqrt((TwoSL+1)*(TwoJdown+1.0))*gsl_sf_coupling_6j(TwoJdown,TwoS2,1,TwoSL,TwoSLdown,TwoSR);
+                     double factor = fase*sqrt((TwoSL+1)*(TwoJdown+1.0))*Wigner::wigner6j(TwoJdown,TwoS2,1,TwoSL,TwoSLdown,TwoSR);
                      double beta = 1.0;
                      char notr = 'N';
                      char trans = 'T';
                      double * BlockQ = Qleft->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                     dgemm_(&trans,&notr,&dimLup,&dimR,&dimLdown,&factor,BlockQ,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notr,&dimLup,&dimR,&dimLdown,&factor,BlockQ,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   }
                }
             }
@@ -131,7 +131,7 @@ void CheMPS2::Heff::addDiagram3Aand3D(const int ikappa, double * memS, double *
             int memSkappa = denS->gKappa(NL-1,TwoSLdown,ILdown,2,N2,TwoS2,NR,TwoSR,IR);
             if (memSkappa!=-1){
                int fase = phase(TwoSLdown+TwoSR+2+TwoS2);
-               double factor = fase*sqrt((TwoSL+1)*(TwoJ+1.0))*gsl_sf_coupling_6j(TwoS2,TwoJ,1,TwoSL,TwoSLdown,TwoSR);
+               double factor = fase*sqrt((TwoSL+1)*(TwoJ+1.0))*Wigner::wigner6j(TwoS2,TwoJ,1,TwoSL,TwoSLdown,TwoSR);
                double beta = 1.0;
                char notr = 'N';
                char trans = 'T';
@@ -139,17 +139,17 @@ void CheMPS2::Heff::addDiagram3Aand3D(const int ikappa, double * memS, double *
                double * BlockQ = Qleft->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                int inc = 1;
                int size = dimLup * dimLdown;
-               dcopy_(&size, BlockQ, &inc, temp, &inc);
+               HeffPlan::dcopy(&size, BlockQ, &inc, temp, &inc);
                
                for (int l_index=0; l_index<theindex; l_index++){
                   if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                      double alpha = Prob->gMxElement(l_index,theindex,theindex,theindex);
                      double * BlockL = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                     daxpy_(&size, &alpha, BlockL, &inc, temp, &inc);
+                     HeffPlan::daxpy(&size, &alpha, BlockL, &inc, temp, &inc);
                   }
                }
                
-               dgemm_(&trans,&notr,&dimLup,&dimR,&dimLdown,&factor,temp,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+               HeffPlan::dgemm(&trans,&notr,&dimLup,&dimR,&dimLdown,&factor,temp,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
             }
          }
       }
@@ -189,24 +189,24 @@ void CheMPS2::Heff::addDiagram3Band3I(const int ikappa, double * memS, double *
                   int memSkappa = denS->gKappa(NL+1,TwoSLdown,ILdown,N1,1,TwoJdown,NR,TwoSR,IR);
                   if (memSkappa!=-1){
                      int fase = phase(TwoSL+TwoSR+3-TwoJdown);
-                     double factor = sqrt((TwoJdown+1)*(TwoSLdown+1.0))*fase*gsl_sf_coupling_6j(TwoJdown,TwoS1,1,TwoSL,TwoSLdown,TwoSR);
+                     double factor = sqrt((TwoJdown+1)*(TwoSLdown+1.0))*fase*Wigner::wigner6j(TwoJdown,TwoS1,1,TwoSL,TwoSLdown,TwoSR);
                      double beta = 1.0; //add
                      char notr = 'N';
                   
                      double * BlockQ = Qleft->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                      int inc = 1;
                      int size = dimLup * dimLdown;
-                     dcopy_(&size, BlockQ, &inc, temp, &inc);
+                     HeffPlan::dcopy(&size, BlockQ, &inc, temp, &inc);
                   
                      for (int l_index=0; l_index<theindex; l_index++){
                         if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                            double alpha = Prob->gMxElement(l_index,theindex+1,theindex+1,theindex+1);
                            double * BlockL = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                           daxpy_(&size, &alpha, BlockL, &inc, temp, &inc);
+                           HeffPlan::daxpy(&size, &alpha, BlockL, &inc, temp, &inc);
                         }
                      }
                   
-                     dgemm_(&notr,&notr,&dimLup,&dimR,&dimLdown,&factor,temp,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&notr,&notr,&dimLup,&dimR,&dimLdown,&factor,temp,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   }
                }
             }
@@ -221,11 +221,11 @@ void CheMPS2::Heff::addDiagram3Band3I(const int ikappa, double * memS, double *
             int memSkappa = denS->gKappa(NL+1,TwoSLdown,ILdown,N1,0,TwoS1,NR,TwoSR,IR);
             if (memSkappa!=-1){
                int fase = phase(TwoSL+TwoSR+2-TwoJ);
-               double factor = sqrt((TwoSLdown+1)*(TwoJ+1.0))*fase*gsl_sf_coupling_6j(TwoS1,TwoJ,1,TwoSL,TwoSLdown,TwoSR);
+               double factor = sqrt((TwoSLdown+1)*(TwoJ+1.0))*fase*Wigner::wigner6j(TwoS1,TwoJ,1,TwoSL,TwoSLdown,TwoSR);
                double beta = 1.0;
                char notr = 'N';
                double * BlockQ = Qleft->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-               dgemm_(&notr,&notr,&dimLup,&dimR,&dimLdown,&factor,BlockQ,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+               HeffPlan::dgemm(&notr,&notr,&dimLup,&dimR,&dimLdown,&factor,BlockQ,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
             }
          }
       }
@@ -244,12 +244,12 @@ void CheMPS2::Heff::addDiagram3Band3I(const int ikappa, double * memS, double *
                   int memSkappa = denS->gKappa(NL-1,TwoSLdown,ILdown,N1,1,TwoJdown,NR,TwoSR,IR);
                   if (memSkappa!=-1){
                      int fase = phase(TwoSLdown+TwoSR+2-TwoJdown);
-                     double factor = fase*sqrt((TwoSL+1)*(TwoJdown+1.0))*gsl_sf_coupling_6j(TwoJdown,TwoS1,1,TwoSL,TwoSLdown,TwoSR);
+                     double factor = fase*sqrt((TwoSL+1)*(TwoJdown+1.0))*Wigner::wigner6j(TwoJdown,TwoS1,1,TwoSL,TwoSLdown,TwoSR);
                      double beta = 1.0;
                      char notr = 'N';
                      char trans = 'T';
                      double * BlockQ = Qleft->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                     dgemm_(&trans,&notr,&dimLup,&dimR,&dimLdown,&factor,BlockQ,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notr,&dimLup,&dimR,&dimLdown,&factor,BlockQ,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   }
                }
             }
@@ -264,7 +264,7 @@ void CheMPS2::Heff::addDiagram3Band3I(const int ikappa, double * memS, double *
             int memSkappa = denS->gKappa(NL-1,TwoSLdown,ILdown,N1,2,TwoS1,NR,TwoSR,IR);
             if (memSkappa!=-1){
                int fase = phase(TwoSLdown+TwoSR+3-TwoJ);
-               double factor = fase*sqrt((TwoSL+1)*(TwoJ+1.0))*gsl_sf_coupling_6j(TwoS1,TwoJ,1,TwoSL,TwoSLdown,TwoSR);
+               double factor = fase*sqrt((TwoSL+1)*(TwoJ+1.0))*Wigner::wigner6j(TwoS1,TwoJ,1,TwoSL,TwoSLdown,TwoSR);
                double beta = 1.0;
                char notr = 'N';
                char trans = 'T';
@@ -272,17 +272,17 @@ void CheMPS2::Heff::addDiagram3Band3I(const int ikappa, double * memS, double *
                double * BlockQ = Qleft->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                int inc = 1;
                int size = dimLup * dimLdown;
-               dcopy_(&size, BlockQ, &inc, temp, &inc);
+               HeffPlan::dcopy(&size, BlockQ, &inc, temp, &inc);
                
                for (int l_index=0; l_index<theindex; l_index++){
                   if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                      double alpha = Prob->gMxElement(l_index,theindex+1,theindex+1,theindex+1);
                      double * BlockL = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                     daxpy_(&size, &alpha, BlockL, &inc, temp, &inc);
+                     HeffPlan::daxpy(&size, &alpha, BlockL, &inc, temp, &inc);
                   }
                }
             
-               dgemm_(&trans,&notr,&dimLup,&dimR,&dimLdown,&factor,temp,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+               HeffPlan::dgemm(&trans,&notr,&dimLup,&dimR,&dimLdown,&factor,temp,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
             }
          }
       }
@@ -313,7 +313,7 @@ void CheMPS2::Heff::addDiagram3C(const int ikappa, double * memS, double * memHe
          if ((abs(TwoSLdown-TwoSRdown)<=TwoJ) && (TwoSLdown>=0) && (TwoSRdown>=0)){
       
             int fase = phase(TwoSLdown+TwoSR+TwoJ+1 + ((N1==1)?2:0) + ((N2==1)?2:0) );
-            const double factor = fase * sqrt((TwoSLdown+1)*(TwoSRdown+1.0)) * gsl_sf_coupling_6j(TwoSL,TwoSR,TwoJ,TwoSRdown,TwoSLdown,1);
+            const double factor = fase * sqrt((TwoSLdown+1)*(TwoSRdown+1.0)) * Wigner::wigner6j(TwoSL,TwoSR,TwoJ,TwoSRdown,TwoSLdown,1);
       
             for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
                int ILdown = denBK->directProd(IL,denBK->gIrrep(l_index));
@@ -330,11 +330,11 @@ void CheMPS2::Heff::addDiagram3C(const int ikappa, double * memS, double * memHe
                   char notra = 'N';
                   double beta = 0.0; //set
                   double alpha = factor;
-                  dgemm_(&notra,&notra,&dimLup,&dimRdown,&dimLdown,&alpha,Qblock,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,temp,&dimLup);
+                  HeffPlan::dgemm(&notra,&notra,&dimLup,&dimRdown,&dimLdown,&alpha,Qblock,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,temp,&dimLup);
                
                   beta = 1.0; //add
                   alpha = 1.0;
-                  dgemm_(&notra,&trans,&dimLup,&dimRup,&dimRdown,&alpha,temp,&dimLup,Lblock,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&notra,&trans,&dimLup,&dimRup,&dimRdown,&alpha,temp,&dimLup,Lblock,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                }
             }
@@ -348,7 +348,7 @@ void CheMPS2::Heff::addDiagram3C(const int ikappa, double * memS, double * memHe
          if ((abs(TwoSLdown-TwoSRdown)<=TwoJ) && (TwoSLdown>=0) && (TwoSRdown>=0)){
       
             int fase = phase(TwoSL+TwoSRdown+TwoJ+1 + ((N1==1)?2:0) + ((N2==1)?2:0) );
-            const double factor = fase * sqrt((TwoSL+1)*(TwoSR+1.0)) * gsl_sf_coupling_6j(TwoSL,TwoSR,TwoJ,TwoSRdown,TwoSLdown,1);
+            const double factor = fase * sqrt((TwoSL+1)*(TwoSR+1.0)) * Wigner::wigner6j(TwoSL,TwoSR,TwoJ,TwoSRdown,TwoSLdown,1);
       
             for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
                int ILdown = denBK->directProd(IL,denBK->gIrrep(l_index));
@@ -365,11 +365,11 @@ void CheMPS2::Heff::addDiagram3C(const int ikappa, double * memS, double * memHe
                   char notra = 'N';
                   double beta = 0.0; //set
                   double alpha = factor;
-                  dgemm_(&trans,&notra,&dimLup,&dimRdown,&dimLdown,&alpha,Qblock,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,temp,&dimLup);
+                  HeffPlan::dgemm(&trans,&notra,&dimLup,&dimRdown,&dimLdown,&alpha,Qblock,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,temp,&dimLup);
                
                   beta = 1.0; //add
                   alpha = 1.0;
-                  dgemm_(&notra,&notra,&dimLup,&dimRup,&dimRdown,&alpha,temp,&dimLup,Lblock,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&notra,&notra,&dimLup,&dimRup,&dimRdown,&alpha,temp,&dimLup,Lblock,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                }
             }
@@ -403,7 +403,7 @@ void CheMPS2::Heff::addDiagram3Eand3H(const int ikappa, double * memS, double *
       int memSkappa = denS->gKappa(NL,TwoSL,IL,1,1,0,NR,TwoSR,IR);
       if (memSkappa!=-1){
          double alpha = sqrt(2.0) * Prob->gMxElement(theindex,theindex,theindex,theindex+1);
-         daxpy_(&size,&alpha,memS+denS->gKappa2index(memSkappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
+         HeffPlan::daxpy(&size,&alpha,memS+denS->gKappa2index(memSkappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
       }
    
    }
@@ -413,7 +413,7 @@ void CheMPS2::Heff::addDiagram3Eand3H(const int ikappa, double * memS, double *
       int memSkappa = denS->gKappa(NL,TwoSL,IL,1,2,1,NR,TwoSR,IR);
       if (memSkappa!=-1){
          double alpha = - ( Prob->gMxElement(theindex,theindex,theindex,theindex+1) + Prob->gMxElement(theindex,theindex+1,theindex+1,theindex+1) );
-         daxpy_(&size,&alpha,memS+denS->gKappa2index(memSkappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
+         HeffPlan::daxpy(&size,&alpha,memS+denS->gKappa2index(memSkappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
       }
    
    }
@@ -423,13 +423,13 @@ void CheMPS2::Heff::addDiagram3Eand3H(const int ikappa, double * memS, double *
       int memSkappa = denS->gKappa(NL,TwoSL,IL,2,0,0,NR,TwoSR,IR);
       if (memSkappa!=-1){
          double alpha = sqrt(2.0) * Prob->gMxElement(theindex,theindex,theindex,theindex+1);
-         daxpy_(&size,&alpha,memS+denS->gKappa2index(memSkappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
+         HeffPlan::daxpy(&size,&alpha,memS+denS->gKappa2index(memSkappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
       }
       
       memSkappa = denS->gKappa(NL,TwoSL,IL,0,2,0,NR,TwoSR,IR);
       if (memSkappa!=-1){
          double alpha = sqrt(2.0) * Prob->gMxElement(theindex,theindex+1,theindex+1,theindex+1);
-         daxpy_(&size,&alpha,memS+denS->gKappa2index(memSkappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
+         HeffPlan::daxpy(&size,&alpha,memS+denS->gKappa2index(memSkappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
       }
    
    }
@@ -439,7 +439,7 @@ void CheMPS2::Heff::addDiagram3Eand3H(const int ikappa, double * memS, double *
       int memSkappa = denS->gKappa(NL,TwoSL,IL,2,1,1,NR,TwoSR,IR);
       if (memSkappa!=-1){
          double alpha = - ( Prob->gMxElement(theindex,theindex,theindex,theindex+1) + Prob->gMxElement(theindex,theindex+1,theindex+1,theindex+1) );
-         daxpy_(&size,&alpha,memS+denS->gKappa2index(memSkappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
+         HeffPlan::daxpy(&size,&alpha,memS+denS->gKappa2index(memSkappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
       }
    
    }
@@ -449,7 +449,7 @@ void CheMPS2::Heff::addDiagram3Eand3H(const int ikappa, double * memS, double *
       int memSkappa = denS->gKappa(NL,TwoSL,IL,1,1,0,NR,TwoSR,IR);
       if (memSkappa!=-1){
          double alpha = sqrt(2.0) * Prob->gMxElement(theindex,theindex+1,theindex+1,theindex+1);
-         daxpy_(&size,&alpha,memS+denS->gKappa2index(memSkappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
+         HeffPlan::daxpy(&size,&alpha,memS+denS->gKappa2index(memSkappa),&inc,memHeff+denS->gKappa2index(ikappa),&inc);
       }
    
    }
@@ -482,11 +482,11 @@ void CheMPS2::Heff::addDiagram3Kand3F(const int ikappa, double * memS, double *
             int memSkappa = denS->gKappa(NL,TwoSL,IL,0,N2,TwoS2,NR-1,TwoSRdown,IRdown);
             if (memSkappa!=-1){
                int fase = phase(TwoSL+TwoSR+TwoJ+2*TwoS2);
-               double factor = sqrt((TwoJ+1)*(TwoSR+1.0)) * fase * gsl_sf_coupling_6j(TwoS2,TwoJ,1,TwoSR,TwoSRdown,TwoSL);
+               double factor = sqrt((TwoJ+1)*(TwoSR+1.0)) * fase * Wigner::wigner6j(TwoS2,TwoJ,1,TwoSR,TwoSRdown,TwoSL);
                double beta = 1.0; //add
                char notr = 'N';
                double * BlockQ = Qright->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
-               dgemm_(&notr,&notr,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,BlockQ,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+               HeffPlan::dgemm(&notr,&notr,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,BlockQ,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
             }
          }
       }
@@ -505,24 +505,24 @@ void CheMPS2::Heff::addDiagram3Kand3F(const int ikappa, double * memS, double *
                   int memSkappa = denS->gKappa(NL,TwoSL,IL,1,N2,TwoJdown,NR-1,TwoSRdown,IRdown);
                   if (memSkappa!=-1){
                      int fase = phase(TwoSL+TwoSR+TwoJdown+1+2*TwoS2);
-                     double factor = sqrt((TwoJdown+1)*(TwoSR+1.0)) * fase * gsl_sf_coupling_6j(TwoJdown,TwoS2,1,TwoSR,TwoSRdown,TwoSL);
+                     double factor = sqrt((TwoJdown+1)*(TwoSR+1.0)) * fase * Wigner::wigner6j(TwoJdown,TwoS2,1,TwoSR,TwoSRdown,TwoSL);
                      double beta = 1.0; //add
                      char notr = 'N';
                   
                      double * BlockQ = Qright->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                      int inc = 1;
                      int size = dimRup * dimRdown;
-                     dcopy_(&size,BlockQ,&inc,temp,&inc);
+                     HeffPlan::dcopy(&size,BlockQ,&inc,temp,&inc);
                   
                      for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
                         if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                            double alpha = Prob->gMxElement(theindex,theindex,theindex,l_index);
                            double * BlockL = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
-                           daxpy_(&size, &alpha, BlockL, &inc, temp, &inc);
+                           HeffPlan::daxpy(&size, &alpha, BlockL, &inc, temp, &inc);
                         }
                      }
                   
-                     dgemm_(&notr,&notr,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                     HeffPlan::dgemm(&notr,&notr,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                   }
                }
             }
@@ -543,12 +543,12 @@ void CheMPS2::Heff::addDiagram3Kand3F(const int ikappa, double * memS, double *
                   int memSkappa = denS->gKappa(NL,TwoSL,IL,1,N2,TwoJdown,NR+1,TwoSRdown,IRdown);
                   if (memSkappa!=-1){
                      int fase = phase(TwoSL+TwoSRdown+TwoJdown+2*TwoS2);
-                     double factor = sqrt((TwoJdown+1)*(TwoSRdown+1.0)) * fase * gsl_sf_coupling_6j(TwoJdown,TwoS2,1,TwoSR,TwoSRdown,TwoSL);
+                     double factor = sqrt((TwoJdown+1)*(TwoSRdown+1.0)) * fase * Wigner::wigner6j(TwoJdown,TwoS2,1,TwoSR,TwoSRdown,TwoSL);
                      double beta = 1.0; //add
                      char notr = 'N';
                      char tran = 'T';
                      double * BlockQ = Qright->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
-                     dgemm_(&notr,&tran,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,BlockQ,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                     HeffPlan::dgemm(&notr,&tran,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,BlockQ,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                   }
                }
             }
@@ -563,7 +563,7 @@ void CheMPS2::Heff::addDiagram3Kand3F(const int ikappa, double * memS, double *
             int memSkappa = denS->gKappa(NL,TwoSL,IL,2,N2,TwoS2,NR+1,TwoSRdown,IRdown);
             if (memSkappa!=-1){
                int fase = phase(TwoSL+TwoSRdown+TwoJ+1+2*TwoS2);
-               double factor = sqrt((TwoJ+1)*(TwoSRdown+1.0)) * fase * gsl_sf_coupling_6j(TwoS2,TwoJ,1,TwoSR,TwoSRdown,TwoSL);
+               double factor = sqrt((TwoJ+1)*(TwoSRdown+1.0)) * fase * Wigner::wigner6j(TwoS2,TwoJ,1,TwoSR,TwoSRdown,TwoSL);
                double beta = 1.0; //add
                char notr = 'N';
                char tran = 'T';
@@ -571,17 +571,17 @@ void CheMPS2::Heff::addDiagram3Kand3F(const int ikappa, double * memS, double *
                double * BlockQ = Qright->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                int inc = 1;
                int size = dimRup * dimRdown;
-               dcopy_(&size,BlockQ,&inc,temp,&inc);
+               HeffPlan::dcopy(&size,BlockQ,&inc,temp,&inc);
             
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
                   if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                      double alpha = Prob->gMxElement(theindex,theindex,theindex,l_index);
                      double * BlockL = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
-                     daxpy_(&size, &alpha, BlockL, &inc, temp, &inc);
+                     HeffPlan::daxpy(&size, &alpha, BlockL, &inc, temp, &inc);
                   }
                }
             
-               dgemm_(&notr,&tran,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+               HeffPlan::dgemm(&notr,&tran,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
             }
          }
       }
@@ -615,11 +615,11 @@ void CheMPS2::Heff::addDiagram3Land3G(const int ikappa, double * memS, double *
             int memSkappa = denS->gKappa(NL,TwoSL,IL,N1,0,TwoS1,NR-1,TwoSRdown,IRdown);
             if (memSkappa!=-1){
                int fase = phase(TwoSL+TwoSR+TwoS1+1);
-               double factor = sqrt((TwoJ+1)*(TwoSR+1.0)) * fase * gsl_sf_coupling_6j(TwoS1,TwoJ,1,TwoSR,TwoSRdown,TwoSL);
+               double factor = sqrt((TwoJ+1)*(TwoSR+1.0)) * fase * Wigner::wigner6j(TwoS1,TwoJ,1,TwoSR,TwoSRdown,TwoSL);
                double beta = 1.0; //add
                char notr = 'N';
                double * BlockQ = Qright->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
-               dgemm_(&notr,&notr,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,BlockQ,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+               HeffPlan::dgemm(&notr,&notr,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,BlockQ,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
             }
          }
       }
@@ -638,24 +638,24 @@ void CheMPS2::Heff::addDiagram3Land3G(const int ikappa, double * memS, double *
                   int memSkappa = denS->gKappa(NL,TwoSL,IL,N1,1,TwoJdown,NR-1,TwoSRdown,IRdown);
                   if (memSkappa!=-1){
                      int fase = phase(TwoSL+TwoSR+TwoS1+2);
-                     double factor = sqrt((TwoJdown+1)*(TwoSR+1.0)) * fase * gsl_sf_coupling_6j(TwoJdown,TwoS1,1,TwoSR,TwoSRdown,TwoSL);
+                     double factor = sqrt((TwoJdown+1)*(TwoSR+1.0)) * fase * Wigner::wigner6j(TwoJdown,TwoS1,1,TwoSR,TwoSRdown,TwoSL);
                      double beta = 1.0; //add
                      char notr = 'N';
                   
                      double * BlockQ = Qright->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                      int inc = 1;
                      int size = dimRup * dimRdown;
-                     dcopy_(&size,BlockQ,&inc,temp,&inc);
+                     HeffPlan::dcopy(&size,BlockQ,&inc,temp,&inc);
                   
                      for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
                         if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                            double alpha = Prob->gMxElement(theindex+1,theindex+1,theindex+1,l_index);
                            double * BlockL = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
-                           daxpy_(&size, &alpha, BlockL, &inc, temp, &inc);
+                           HeffPlan::daxpy(&size, &alpha, BlockL, &inc, temp, &inc);
                         }
                      }
                   
-                     dgemm_(&notr,&notr,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                     HeffPlan::dgemm(&notr,&notr,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                   }
                }
             }
@@ -676,12 +676,12 @@ void CheMPS2::Heff::addDiagram3Land3G(const int ikappa, double * memS, double *
                   int memSkappa = denS->gKappa(NL,TwoSL,IL,N1,1,TwoJdown,NR+1,TwoSRdown,IRdown);
                   if (memSkappa!=-1){
                      int fase = phase(TwoSL+TwoSRdown+TwoS1+1);
-                     double factor = sqrt((TwoJdown+1)*(TwoSRdown+1.0)) * fase * gsl_sf_coupling_6j(TwoJdown,TwoS1,1,TwoSR,TwoSRdown,TwoSL);
+                     double factor = sqrt((TwoJdown+1)*(TwoSRdown+1.0)) * fase * Wigner::wigner6j(TwoJdown,TwoS1,1,TwoSR,TwoSRdown,TwoSL);
                      double beta = 1.0; //add
                      char notr = 'N';
                      char tran = 'T';
                      double * BlockQ = Qright->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
-                     dgemm_(&notr,&tran,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,BlockQ,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                     HeffPlan::dgemm(&notr,&tran,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,BlockQ,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                   }
                }
             }
@@ -696,7 +696,7 @@ void CheMPS2::Heff::addDiagram3Land3G(const int ikappa, double * memS, double *
             int memSkappa = denS->gKappa(NL,TwoSL,IL,N1,2,TwoS1,NR+1,TwoSRdown,IRdown);
             if (memSkappa!=-1){
                int fase = phase(TwoSL+TwoSRdown+TwoS1+2);
-               double factor = sqrt((TwoJ+1)*(TwoSRdown+1.0)) * fase * gsl_sf_coupling_6j(TwoS1,TwoJ,1,TwoSR,TwoSRdown,TwoSL);
+               double factor = sqrt((TwoJ+1)*(TwoSRdown+1.0)) * fase * Wigner::wigner6j(TwoS1,TwoJ,1,TwoSR,TwoSRdown,TwoSL);
                double beta = 1.0; //add
                char notr = 'N';
                char tran = 'T';
@@ -704,17 +704,17 @@ void CheMPS2::Heff::addDiagram3Land3G(const int ikappa, double * memS, double *
                double * BlockQ = Qright->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                int inc = 1;
                int size = dimRup * dimRdown;
-               dcopy_(&size,BlockQ,&inc,temp,&inc);
+               HeffPlan::dcopy(&size,BlockQ,&inc,temp,&inc);
             
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
                   if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                      double alpha = Prob->gMxElement(theindex+1,theindex+1,theindex+1,l_index);
                      double * BlockL = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
-                     daxpy_(&size, &alpha, BlockL, &inc, temp, &inc);
+                     HeffPlan::daxpy(&size, &alpha, BlockL, &inc, temp, &inc);
                   }
                }
             
-               dgemm_(&notr,&tran,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+               HeffPlan::dgemm(&notr,&tran,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
             }
          }
       }
@@ -745,7 +745,7 @@ void CheMPS2::Heff::addDiagram3J(const int ikappa, double * memS, double * memHe
          if ((abs(TwoSLdown-TwoSRdown)<=TwoJ) && (TwoSLdown>=0) && (TwoSRdown>=0)){
       
             int fase = phase(TwoSLdown+TwoSR+TwoJ+1 + ((N1==1)?2:0) + ((N2==1)?2:0) );
-            const double factor = fase * sqrt((TwoSLdown+1)*(TwoSRdown+1.0)) * gsl_sf_coupling_6j(TwoSL,TwoSR,TwoJ,TwoSRdown,TwoSLdown,1);
+            const double factor = fase * sqrt((TwoSLdown+1)*(TwoSRdown+1.0)) * Wigner::wigner6j(TwoSL,TwoSR,TwoJ,TwoSRdown,TwoSLdown,1);
       
             for (int l_index=0; l_index<theindex; l_index++){
                int ILdown = denBK->directProd(IL,denBK->gIrrep(l_index));
@@ -763,11 +763,11 @@ void CheMPS2::Heff::addDiagram3J(const int ikappa, double * memS, double * memHe
                   char notra = 'N';
                   double beta = 0.0; //set
                   double alpha = factor;
-                  dgemm_(&notra,&notra,&dimLup,&dimRdown,&dimLdown,&alpha,Lblock,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,temp,&dimLup);
+                  HeffPlan::dgemm(&notra,&notra,&dimLup,&dimRdown,&dimLdown,&alpha,Lblock,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,temp,&dimLup);
                
                   beta = 1.0; //add
                   alpha = 1.0;
-                  dgemm_(&notra,&trans,&dimLup,&dimRup,&dimRdown,&alpha,temp,&dimLup,Qblock,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&notra,&trans,&dimLup,&dimRup,&dimRdown,&alpha,temp,&dimLup,Qblock,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                }
             }
@@ -781,7 +781,7 @@ void CheMPS2::Heff::addDiagram3J(const int ikappa, double * memS, double * memHe
          if ((abs(TwoSLdown-TwoSRdown)<=TwoJ) && (TwoSLdown>=0) && (TwoSRdown>=0)){
       
             int fase = phase(TwoSL+TwoSRdown+TwoJ+1 + ((N1==1)?2:0) + ((N2==1)?2:0) );
-            const double factor = fase * sqrt((TwoSL+1)*(TwoSR+1.0)) * gsl_sf_coupling_6j(TwoSL,TwoSR,TwoJ,TwoSRdown,TwoSLdown,1);
+            const double factor = fase * sqrt((TwoSL+1)*(TwoSR+1.0)) * Wigner::wigner6j(TwoSL,TwoSR,TwoJ,TwoSRdown,TwoSLdown,1);
       
             for (int l_index=0; l_index<theindex; l_index++){
                int ILdown = denBK->directProd(IL,denBK->gIrrep(l_index));
@@ -798,11 +798,11 @@ void CheMPS2::Heff::addDiagram3J(const int ikappa, double * memS, double * memHe
                   char notra = 'N';
                   double beta = 0.0; //set
                   double alpha = factor;
-                  dgemm_(&trans,&notra,&dimLup,&dimRdown,&dimLdown,&alpha,Lblock,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,temp,&dimLup);
+                  HeffPlan::dgemm(&trans,&notra,&dimLup,&dimRdown,&dimLdown,&alpha,Lblock,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,temp,&dimLup);
                
                   beta = 1.0; //add
                   alpha = 1.0;
-                  dgemm_(&notra,&notra,&dimLup,&dimRup,&dimRdown,&alpha,temp,&dimLup,Qblock,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&notra,&notra,&dimLup,&dimRup,&dimRdown,&alpha,temp,&dimLup,Qblock,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                }
             }
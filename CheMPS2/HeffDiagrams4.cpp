@@ -22,7 +22,7 @@
 
 #include "Heff.h"
 #include "Lapack.h"
-#include "Gsl.h"
+#include "Wigner.h"
 
 void CheMPS2::Heff::addDiagram4A1and4A2spin0(const int ikappa, double * memS, double * memHeff, const Sobject * denS, TensorA * Atens) const{
 
@@ -58,7 +58,7 @@ void CheMPS2::Heff::addDiagram4A1and4A2spin0(const int ikappa, double * memS, do
          double * Ablock = Atens->gStorage(NL-2,TwoSL,ILdown,NL,TwoSL,IL);
          int dimLdown = denBK->gCurrentDim(theindex,NL-2,TwoSL,ILdown);
          
-         dgemm_(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Ablock,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+         HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Ablock,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
       }
    }
@@ -73,7 +73,7 @@ void CheMPS2::Heff::addDiagram4A1and4A2spin0(const int ikappa, double * memS, do
          double * Ablock = Atens->gStorage(NL-2,TwoSL,ILdown,NL,TwoSL,IL);
          int dimLdown = denBK->gCurrentDim(theindex,NL-2,TwoSL,ILdown);
          
-         dgemm_(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Ablock,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+         HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Ablock,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
       }
    }
@@ -88,7 +88,7 @@ void CheMPS2::Heff::addDiagram4A1and4A2spin0(const int ikappa, double * memS, do
          double * Ablock = Atens->gStorage(NL-2,TwoSL,ILdown,NL,TwoSL,IL);
          int dimLdown = denBK->gCurrentDim(theindex,NL-2,TwoSL,ILdown);
          
-         dgemm_(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Ablock,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+         HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Ablock,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
       }
    }
@@ -103,7 +103,7 @@ void CheMPS2::Heff::addDiagram4A1and4A2spin0(const int ikappa, double * memS, do
          double * Ablock = Atens->gStorage(NL-2,TwoSL,ILdown,NL,TwoSL,IL);
          int dimLdown = denBK->gCurrentDim(theindex,NL-2,TwoSL,ILdown);
          
-         dgemm_(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Ablock,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+         HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Ablock,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
       }
       memSkappa = denS->gKappa(NL+2,TwoSL,ILdown,0,0,0,NR,TwoSR,IR);
@@ -113,7 +113,7 @@ void CheMPS2::Heff::addDiagram4A1and4A2spin0(const int ikappa, double * memS, do
          double * Ablock = Atens->gStorage(NL,TwoSL,IL,NL+2,TwoSL,ILdown);
          int dimLdown = denBK->gCurrentDim(theindex,NL+2,TwoSL,ILdown);
          
-         dgemm_(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Ablock,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+         HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Ablock,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
       }
    }
@@ -128,7 +128,7 @@ void CheMPS2::Heff::addDiagram4A1and4A2spin0(const int ikappa, double * memS, do
          double * Ablock = Atens->gStorage(NL,TwoSL,IL,NL+2,TwoSL,ILdown);
          int dimLdown = denBK->gCurrentDim(theindex,NL+2,TwoSL,ILdown);
          
-         dgemm_(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Ablock,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+         HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Ablock,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
       }
    }
@@ -143,7 +143,7 @@ void CheMPS2::Heff::addDiagram4A1and4A2spin0(const int ikappa, double * memS, do
          double * Ablock = Atens->gStorage(NL,TwoSL,IL,NL+2,TwoSL,ILdown);
          int dimLdown = denBK->gCurrentDim(theindex,NL+2,TwoSL,ILdown);
 
-         dgemm_(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Ablock,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+         HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Ablock,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
       }
    }
@@ -158,7 +158,7 @@ void CheMPS2::Heff::addDiagram4A1and4A2spin0(const int ikappa, double * memS, do
          double * Ablock = Atens->gStorage(NL,TwoSL,IL,NL+2,TwoSL,ILdown);
          int dimLdown = denBK->gCurrentDim(theindex,NL+2,TwoSL,ILdown);
 
-         dgemm_(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Ablock,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+         HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Ablock,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
       }
    }
@@ -202,7 +202,7 @@ void CheMPS2::Heff::addDiagram4A1and4A2spin1(const int ikappa, double * memS, do
                double * Bblock = Btens->gStorage(NL-2,TwoSLdown,ILdown,NL,TwoSL,IL);
                int dimLdown = denBK->gCurrentDim(theindex,NL-2,TwoSLdown,ILdown);
          
-               dgemm_(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Bblock,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+               HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Bblock,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
             }
          }
@@ -219,11 +219,11 @@ void CheMPS2::Heff::addDiagram4A1and4A2spin1(const int ikappa, double * memS, do
             if (memSkappa!=-1){
       
                int fase = phase(TwoSLdown + TwoSR + 1);
-               double factor = fase * sqrt(3.0*(TwoSL+1)) * gsl_sf_coupling_6j(1,1,2,TwoSL,TwoSLdown,TwoSR);
+               double factor = fase * sqrt(3.0*(TwoSL+1)) * Wigner::wigner6j(1,1,2,TwoSL,TwoSLdown,TwoSR);
                double * Bblock = Btens->gStorage(NL-2,TwoSLdown,ILdown,NL,TwoSL,IL);
                int dimLdown = denBK->gCurrentDim(theindex,NL-2,TwoSLdown,ILdown);
          
-               dgemm_(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Bblock,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+               HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Bblock,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
             }
          }
       }
@@ -239,11 +239,11 @@ void CheMPS2::Heff::addDiagram4A1and4A2spin1(const int ikappa, double * memS, do
             if (memSkappa!=-1){
       
                int fase = phase(TwoSLdown + TwoSR + 3);
-               double factor = fase * sqrt(3.0*(TwoSL+1)) * gsl_sf_coupling_6j(1,1,2,TwoSL,TwoSLdown,TwoSR);
+               double factor = fase * sqrt(3.0*(TwoSL+1)) * Wigner::wigner6j(1,1,2,TwoSL,TwoSLdown,TwoSR);
                double * Bblock = Btens->gStorage(NL-2,TwoSLdown,ILdown,NL,TwoSL,IL);
                int dimLdown = denBK->gCurrentDim(theindex,NL-2,TwoSLdown,ILdown);
          
-               dgemm_(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Bblock,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+               HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Bblock,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
             }
          }
       }
@@ -262,7 +262,7 @@ void CheMPS2::Heff::addDiagram4A1and4A2spin1(const int ikappa, double * memS, do
          double * Bblock = Btens->gStorage(NL-2,TwoSLdown,ILdown,NL,TwoSL,IL);
          int dimLdown = denBK->gCurrentDim(theindex,NL-2,TwoSLdown,ILdown);
          
-         dgemm_(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Bblock,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+         HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Bblock,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
       }
       memSkappa = denS->gKappa(NL+2,TwoSLdown,ILdown,0,0,0,NR,TwoSR,IR);
@@ -272,7 +272,7 @@ void CheMPS2::Heff::addDiagram4A1and4A2spin1(const int ikappa, double * memS, do
          double * Bblock = Btens->gStorage(NL,TwoSL,IL,NL+2,TwoSLdown,ILdown);
          int dimLdown = denBK->gCurrentDim(theindex,NL+2,TwoSLdown,ILdown);
          
-         dgemm_(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Bblock,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+         HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Bblock,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
       }
    }
@@ -287,11 +287,11 @@ void CheMPS2::Heff::addDiagram4A1and4A2spin1(const int ikappa, double * memS, do
             if (memSkappa!=-1){
       
                int fase = phase(TwoSL + TwoSR + 1);
-               double factor = fase * sqrt(3.0*(TwoSLdown+1)) * gsl_sf_coupling_6j(1,1,2,TwoSL,TwoSLdown,TwoSR);
+               double factor = fase * sqrt(3.0*(TwoSLdown+1)) * Wigner::wigner6j(1,1,2,TwoSL,TwoSLdown,TwoSR);
                double * Bblock = Btens->gStorage(NL,TwoSL,IL,NL+2,TwoSLdown,ILdown);
                int dimLdown = denBK->gCurrentDim(theindex,NL+2,TwoSLdown,ILdown);
          
-               dgemm_(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Bblock,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+               HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Bblock,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
             }
          }
       }
@@ -307,11 +307,11 @@ void CheMPS2::Heff::addDiagram4A1and4A2spin1(const int ikappa, double * memS, do
             if (memSkappa!=-1){
       
                int fase = phase(TwoSL + TwoSR + 3);
-               double factor = fase * sqrt(3.0*(TwoSLdown+1)) * gsl_sf_coupling_6j(1,1,2,TwoSL,TwoSLdown,TwoSR);
+               double factor = fase * sqrt(3.0*(TwoSLdown+1)) * Wigner::wigner6j(1,1,2,TwoSL,TwoSLdown,TwoSR);
                double * Bblock = Btens->gStorage(NL,TwoSL,IL,NL+2,TwoSLdown,ILdown);
                int dimLdown = denBK->gCurrentDim(theindex,NL+2,TwoSLdown,ILdown);
          
-               dgemm_(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Bblock,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+               HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Bblock,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
             }
          }
       }
@@ -332,7 +332,7 @@ void CheMPS2::Heff::addDiagram4A1and4A2spin1(const int ikappa, double * memS, do
                double * Bblock = Btens->gStorage(NL,TwoSL,IL,NL+2,TwoSLdown,ILdown);
                int dimLdown = denBK->gCurrentDim(theindex,NL+2,TwoSLdown,ILdown);
          
-               dgemm_(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Bblock,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+               HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,Bblock,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
             }
          }
       }
@@ -377,18 +377,18 @@ void CheMPS2::Heff::addDiagram4A3and4A4spin0(const int ikappa, double * memS, do
          
          if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
             int size = dimLup * dimLdown;
-            dcopy_(&size,ptr,&inc,temp,&inc);
+            HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
          
             for (int l_index=0; l_index<theindex; l_index++){
                double alpha = 2 * Prob->gMxElement(l_index,theindex,l_index,theindex+1) - Prob->gMxElement(l_index,l_index,theindex,theindex+1);
                double * F0block = F0tens[theindex-1-l_index]->gStorage(NL,TwoSL,ILdown,NL,TwoSL,IL);
-               daxpy_(&size,&alpha,F0block,&inc,temp,&inc);
+               HeffPlan::daxpy(&size,&alpha,F0block,&inc,temp,&inc);
             }
             
             ptr = temp;
          }
          
-         dgemm_(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+         HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
       }  
    }
@@ -405,18 +405,18 @@ void CheMPS2::Heff::addDiagram4A3and4A4spin0(const int ikappa, double * memS, do
          
          if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
             int size = dimLup * dimLdown;
-            dcopy_(&size,ptr,&inc,temp,&inc);
+            HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
          
             for (int l_index=0; l_index<theindex; l_index++){
                double alpha = 2 * Prob->gMxElement(l_index,theindex,l_index,theindex+1) - Prob->gMxElement(l_index,l_index,theindex,theindex+1);
                double * F0block = F0tens[theindex-1-l_index]->gStorage(NL,TwoSL,ILdown,NL,TwoSL,IL);
-               daxpy_(&size,&alpha,F0block,&inc,temp,&inc);
+               HeffPlan::daxpy(&size,&alpha,F0block,&inc,temp,&inc);
             }
             
             ptr = temp;
          }
          
-         dgemm_(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+         HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
       }
    }
@@ -433,18 +433,18 @@ void CheMPS2::Heff::addDiagram4A3and4A4spin0(const int ikappa, double * memS, do
          
          if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
             int size = dimLup * dimLdown;
-            dcopy_(&size,ptr,&inc,temp,&inc);
+            HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
          
             for (int l_index=0; l_index<theindex; l_index++){
                double alpha = 2 * Prob->gMxElement(l_index,theindex,l_index,theindex+1) - Prob->gMxElement(l_index,l_index,theindex,theindex+1);
                double * F0block = F0tens[theindex-1-l_index]->gStorage(NL,TwoSL,ILdown,NL,TwoSL,IL);
-               daxpy_(&size,&alpha,F0block,&inc,temp,&inc);
+               HeffPlan::daxpy(&size,&alpha,F0block,&inc,temp,&inc);
             }
             
             ptr = temp;
          }
          
-         dgemm_(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+         HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
       }
    }
@@ -461,18 +461,18 @@ void CheMPS2::Heff::addDiagram4A3and4A4spin0(const int ikappa, double * memS, do
          
          if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
             int size = dimLup * dimLdown;
-            dcopy_(&size,ptr,&inc,temp,&inc);
+            HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
          
             for (int l_index=0; l_index<theindex; l_index++){
                double alpha = 2 * Prob->gMxElement(l_index,theindex,l_index,theindex+1) - Prob->gMxElement(l_index,l_index,theindex,theindex+1);
                double * F0block = F0tens[theindex-1-l_index]->gStorage(NL,TwoSL,ILdown,NL,TwoSL,IL);
-               daxpy_(&size,&alpha,F0block,&inc,temp,&inc);
+               HeffPlan::daxpy(&size,&alpha,F0block,&inc,temp,&inc);
             }
             
             ptr = temp;
          }
          
-         dgemm_(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+         HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
       }
    }
@@ -489,18 +489,18 @@ void CheMPS2::Heff::addDiagram4A3and4A4spin0(const int ikappa, double * memS, do
          
          if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
             int size = dimLup * dimLdown;
-            dcopy_(&size,ptr,&inc,temp,&inc);
+            HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
          
             for (int l_index=0; l_index<theindex; l_index++){
                double alpha = 2 * Prob->gMxElement(l_index,theindex,l_index,theindex+1) - Prob->gMxElement(l_index,l_index,theindex,theindex+1);
                double * F0block = F0tens[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL,TwoSL,ILdown);
-               daxpy_(&size,&alpha,F0block,&inc,temp,&inc);
+               HeffPlan::daxpy(&size,&alpha,F0block,&inc,temp,&inc);
             }
             
             ptr = temp;
          }
          
-         dgemm_(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+         HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
       }
    }
@@ -517,18 +517,18 @@ void CheMPS2::Heff::addDiagram4A3and4A4spin0(const int ikappa, double * memS, do
          
          if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
             int size = dimLup * dimLdown;
-            dcopy_(&size,ptr,&inc,temp,&inc);
+            HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
          
             for (int l_index=0; l_index<theindex; l_index++){
                double alpha = 2 * Prob->gMxElement(l_index,theindex,l_index,theindex+1) - Prob->gMxElement(l_index,l_index,theindex,theindex+1);
                double * F0block = F0tens[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL,TwoSL,ILdown);
-               daxpy_(&size,&alpha,F0block,&inc,temp,&inc);
+               HeffPlan::daxpy(&size,&alpha,F0block,&inc,temp,&inc);
             }
             
             ptr = temp;
          }
          
-         dgemm_(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+         HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
       }
    }
@@ -545,18 +545,18 @@ void CheMPS2::Heff::addDiagram4A3and4A4spin0(const int ikappa, double * memS, do
          
          if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
             int size = dimLup * dimLdown;
-            dcopy_(&size,ptr,&inc,temp,&inc);
+            HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
          
             for (int l_index=0; l_index<theindex; l_index++){
                double alpha = 2 * Prob->gMxElement(l_index,theindex,l_index,theindex+1) - Prob->gMxElement(l_index,l_index,theindex,theindex+1);
                double * F0block = F0tens[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL,TwoSL,ILdown);
-               daxpy_(&size,&alpha,F0block,&inc,temp,&inc);
+               HeffPlan::daxpy(&size,&alpha,F0block,&inc,temp,&inc);
             }
             
             ptr = temp;
          }
          
-         dgemm_(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+         HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
       }
    }
@@ -573,18 +573,18 @@ void CheMPS2::Heff::addDiagram4A3and4A4spin0(const int ikappa, double * memS, do
          
          if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
             int size = dimLup * dimLdown;
-            dcopy_(&size,ptr,&inc,temp,&inc);
+            HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
          
             for (int l_index=0; l_index<theindex; l_index++){
                double alpha = 2 * Prob->gMxElement(l_index,theindex,l_index,theindex+1) - Prob->gMxElement(l_index,l_index,theindex,theindex+1);
                double * F0block = F0tens[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL,TwoSL,ILdown);
-               daxpy_(&size,&alpha,F0block,&inc,temp,&inc);
+               HeffPlan::daxpy(&size,&alpha,F0block,&inc,temp,&inc);
             }
             
             ptr = temp;
          }
          
-         dgemm_(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+         HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
       }
    }
@@ -626,24 +626,24 @@ void CheMPS2::Heff::addDiagram4A3and4A4spin1(const int ikappa, double * memS, do
             if (memSkappa!=-1){
       
                int fase = phase(TwoSLdown + TwoSR + 1);
-               double factor = fase * sqrt(3.0*(TwoSL+1)) * gsl_sf_coupling_6j(1, 1, 2, TwoSL, TwoSLdown, TwoSR);
+               double factor = fase * sqrt(3.0*(TwoSL+1)) * Wigner::wigner6j(1, 1, 2, TwoSL, TwoSLdown, TwoSR);
                int dimLdown = denBK->gCurrentDim(theindex,NL,TwoSLdown,ILdown);
                double * ptr = Dtens->gStorage(NL,TwoSLdown,ILdown,NL,TwoSL,IL);
          
                if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
                   int size = dimLup * dimLdown;
-                  dcopy_(&size,ptr,&inc,temp,&inc);
+                  HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
          
                   for (int l_index=0; l_index<theindex; l_index++){
                      double alpha = - Prob->gMxElement(l_index,l_index,theindex,theindex+1);
                      double * F1block = F1tens[theindex-1-l_index]->gStorage(NL,TwoSLdown,ILdown,NL,TwoSL,IL);
-                     daxpy_(&size,&alpha,F1block,&inc,temp,&inc);
+                     HeffPlan::daxpy(&size,&alpha,F1block,&inc,temp,&inc);
                   }
             
                   ptr = temp;
                }
          
-               dgemm_(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+               HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
             }
          }
       }
@@ -664,18 +664,18 @@ void CheMPS2::Heff::addDiagram4A3and4A4spin1(const int ikappa, double * memS, do
          
          if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
             int size = dimLup * dimLdown;
-            dcopy_(&size,ptr,&inc,temp,&inc);
+            HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
          
             for (int l_index=0; l_index<theindex; l_index++){
                double alpha = - Prob->gMxElement(l_index,l_index,theindex,theindex+1);
                double * F1block = F1tens[theindex-1-l_index]->gStorage(NL,TwoSLdown,ILdown,NL,TwoSL,IL);
-               daxpy_(&size,&alpha,F1block,&inc,temp,&inc);
+               HeffPlan::daxpy(&size,&alpha,F1block,&inc,temp,&inc);
             }
          
             ptr = temp;
          }
          
-         dgemm_(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+         HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
          
       }
    }
@@ -695,18 +695,18 @@ void CheMPS2::Heff::addDiagram4A3and4A4spin1(const int ikappa, double * memS, do
          
                if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
                   int size = dimLup * dimLdown;
-                  dcopy_(&size,ptr,&inc,temp,&inc);
+                  HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
          
                   for (int l_index=0; l_index<theindex; l_index++){
                      double alpha = - Prob->gMxElement(l_index,l_index,theindex,theindex+1);
                      double * F1block = F1tens[theindex-1-l_index]->gStorage(NL,TwoSLdown,ILdown,NL,TwoSL,IL);
-                     daxpy_(&size,&alpha,F1block,&inc,temp,&inc);
+                     HeffPlan::daxpy(&size,&alpha,F1block,&inc,temp,&inc);
                   }
             
                   ptr = temp;
                }
          
-               dgemm_(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+               HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
             }
          }
       }
@@ -722,24 +722,24 @@ void CheMPS2::Heff::addDiagram4A3and4A4spin1(const int ikappa, double * memS, do
             if (memSkappa!=-1){
       
                int fase = phase(TwoSLdown + TwoSR + 1);
-               double factor = fase * sqrt(3.0*(TwoSL+1)) * gsl_sf_coupling_6j(1, 1, 2, TwoSL, TwoSLdown, TwoSR);
+               double factor = fase * sqrt(3.0*(TwoSL+1)) * Wigner::wigner6j(1, 1, 2, TwoSL, TwoSLdown, TwoSR);
                int dimLdown = denBK->gCurrentDim(theindex,NL,TwoSLdown,ILdown);
                double * ptr = Dtens->gStorage(NL,TwoSLdown,ILdown,NL,TwoSL,IL);
          
                if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
                   int size = dimLup * dimLdown;
-                  dcopy_(&size,ptr,&inc,temp,&inc);
+                  HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
          
                   for (int l_index=0; l_index<theindex; l_index++){
                      double alpha = - Prob->gMxElement(l_index,l_index,theindex,theindex+1);
                      double * F1block = F1tens[theindex-1-l_index]->gStorage(NL,TwoSLdown,ILdown,NL,TwoSL,IL);
-                     daxpy_(&size,&alpha,F1block,&inc,temp,&inc);
+                     HeffPlan::daxpy(&size,&alpha,F1block,&inc,temp,&inc);
                   }
             
                   ptr = temp;
                }
          
-               dgemm_(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+               HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
             }
          }
       }
@@ -755,24 +755,24 @@ void CheMPS2::Heff::addDiagram4A3and4A4spin1(const int ikappa, double * memS, do
             if (memSkappa!=-1){
       
                int fase = phase(TwoSL + TwoSR + 1);
-               double factor = fase * sqrt(3.0*(TwoSLdown+1)) * gsl_sf_coupling_6j(1, 1, 2, TwoSL, TwoSLdown, TwoSR);
+               double factor = fase * sqrt(3.0*(TwoSLdown+1)) * Wigner::wigner6j(1, 1, 2, TwoSL, TwoSLdown, TwoSR);
                int dimLdown = denBK->gCurrentDim(theindex,NL,TwoSLdown,ILdown);
                double * ptr = Dtens->gStorage(NL,TwoSL,IL,NL,TwoSLdown,ILdown);
          
                if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
                   int size = dimLup * dimLdown;
-                  dcopy_(&size,ptr,&inc,temp,&inc);
+                  HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
          
                   for (int l_index=0; l_index<theindex; l_index++){
                      double alpha = - Prob->gMxElement(l_index,l_index,theindex,theindex+1);
                      double * F1block = F1tens[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL,TwoSLdown,ILdown);
-                     daxpy_(&size,&alpha,F1block,&inc,temp,&inc);
+                     HeffPlan::daxpy(&size,&alpha,F1block,&inc,temp,&inc);
                   }
             
                   ptr = temp;
                }
          
-               dgemm_(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+               HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
             }
          }
       }
@@ -794,18 +794,18 @@ void CheMPS2::Heff::addDiagram4A3and4A4spin1(const int ikappa, double * memS, do
             
                if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
                   int size = dimLup * dimLdown;
-                  dcopy_(&size,ptr,&inc,temp,&inc);
+                  HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
             
                   for (int l_index=0; l_index<theindex; l_index++){
                      double alpha = - Prob->gMxElement(l_index,l_index,theindex,theindex+1);
                      double * F1block = F1tens[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL,TwoSLdown,ILdown);
-                     daxpy_(&size,&alpha,F1block,&inc,temp,&inc);
+                     HeffPlan::daxpy(&size,&alpha,F1block,&inc,temp,&inc);
                   }
                
                   ptr = temp;
                }
             
-               dgemm_(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+               HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
             }
          }
       }
@@ -825,18 +825,18 @@ void CheMPS2::Heff::addDiagram4A3and4A4spin1(const int ikappa, double * memS, do
 
          if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
             int size = dimLup * dimLdown;
-            dcopy_(&size,ptr,&inc,temp,&inc);
+            HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
 
             for (int l_index=0; l_index<theindex; l_index++){
                double alpha = - Prob->gMxElement(l_index,l_index,theindex,theindex+1);
                double * F1block = F1tens[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL,TwoSLdown,ILdown);
-               daxpy_(&size,&alpha,F1block,&inc,temp,&inc);
+               HeffPlan::daxpy(&size,&alpha,F1block,&inc,temp,&inc);
             }
 
             ptr = temp;
          }
 
-         dgemm_(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+         HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
 
       }
    }
@@ -851,24 +851,24 @@ void CheMPS2::Heff::addDiagram4A3and4A4spin1(const int ikappa, double * memS, do
             if (memSkappa!=-1){
       
                int fase = phase(TwoSL + TwoSR + 1);
-               double factor = fase * sqrt(3.0*(TwoSLdown+1)) * gsl_sf_coupling_6j(1, 1, 2, TwoSL, TwoSLdown, TwoSR);
+               double factor = fase * sqrt(3.0*(TwoSLdown+1)) * Wigner::wigner6j(1, 1, 2, TwoSL, TwoSLdown, TwoSR);
                int dimLdown = denBK->gCurrentDim(theindex,NL,TwoSLdown,ILdown);
                double * ptr = Dtens->gStorage(NL,TwoSL,IL,NL,TwoSLdown,ILdown);
          
                if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
                   int size = dimLup * dimLdown;
-                  dcopy_(&size,ptr,&inc,temp,&inc);
+                  HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
          
                   for (int l_index=0; l_index<theindex; l_index++){
                      double alpha = - Prob->gMxElement(l_index,l_index,theindex,theindex+1);
                      double * F1block = F1tens[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL,TwoSLdown,ILdown);
-                     daxpy_(&size,&alpha,F1block,&inc,temp,&inc);
+                     HeffPlan::daxpy(&size,&alpha,F1block,&inc,temp,&inc);
                   }
             
                   ptr = temp;
                }
          
-               dgemm_(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+               HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,ptr,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
             }
          }
       }
@@ -908,7 +908,7 @@ void CheMPS2::Heff::addDiagram4B1and4B2spin0(const int ikappa, double * memS, do
             if ((abs(TwoSL-TwoSRdown)<=TwoJdown) && (TwoSRdown>=0)){
          
                int fase = phase(TwoSR + TwoSL + 1 + TwoJdown + 2*TwoS2);
-               const double factor = fase * sqrt(0.5*(TwoSR+1)*(TwoJdown+1)) * gsl_sf_coupling_6j(TwoJdown, TwoS2, 1, TwoSR, TwoSRdown, TwoSL);
+               const double factor = fase * sqrt(0.5*(TwoSR+1)*(TwoJdown+1)) * Wigner::wigner6j(TwoJdown, TwoS2, 1, TwoSR, TwoSRdown, TwoSL);
    
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -924,12 +924,12 @@ void CheMPS2::Heff::addDiagram4B1and4B2spin0(const int ikappa, double * memS, do
                      double * Lblock = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                      double alpha = 1.0;
                      double beta = 0.0; //set
-                     dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown, &beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown, &beta,temp,&dimLdown);
                   
                      double * Ablock = Aleft[l_index-theindex][0]->gStorage(NL-2,TwoSL,ILdown,NL,TwoSL,IL);
                      alpha = factor;
                      beta = 1.0; //add
-                     dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Ablock,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Ablock,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                 
                   }
                   
@@ -946,7 +946,7 @@ void CheMPS2::Heff::addDiagram4B1and4B2spin0(const int ikappa, double * memS, do
          if ((abs(TwoSL-TwoSRdown)<=TwoS2) && (TwoSRdown>=0)){
          
             int fase = phase(TwoSR + TwoSL + 2 + TwoJ + 2*TwoS2);
-            const double factor = fase * sqrt(0.5*(TwoSR+1)*(TwoJ+1)) * gsl_sf_coupling_6j(TwoJ, TwoS2, 1, TwoSRdown, TwoSR, TwoSL);
+            const double factor = fase * sqrt(0.5*(TwoSR+1)*(TwoJ+1)) * Wigner::wigner6j(TwoJ, TwoS2, 1, TwoSRdown, TwoSR, TwoSL);
    
             for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -962,12 +962,12 @@ void CheMPS2::Heff::addDiagram4B1and4B2spin0(const int ikappa, double * memS, do
                   double * Lblock = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                   double alpha = 1.0;
                   double beta = 0.0; //set
-                  dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp,&dimLdown);
+                  HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp,&dimLdown);
                   
                   double * Ablock = Aleft[l_index-theindex][0]->gStorage(NL-2,TwoSL,ILdown,NL,TwoSL,IL);
                   alpha = factor;
                   beta = 1.0; //add
-                  dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Ablock,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Ablock,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                }
             }
@@ -982,7 +982,7 @@ void CheMPS2::Heff::addDiagram4B1and4B2spin0(const int ikappa, double * memS, do
          if ((abs(TwoSL-TwoSRdown)<=TwoS2) && (TwoSRdown>=0)){
          
             int fase = phase(TwoSRdown + TwoSL + 1 + TwoJ + 2*TwoS2);
-            const double factor = fase * sqrt(0.5*(TwoSRdown+1)*(TwoJ+1)) * gsl_sf_coupling_6j(TwoJ, TwoS2, 1, TwoSRdown, TwoSR, TwoSL);
+            const double factor = fase * sqrt(0.5*(TwoSRdown+1)*(TwoJ+1)) * Wigner::wigner6j(TwoJ, TwoS2, 1, TwoSRdown, TwoSR, TwoSL);
    
             for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -998,12 +998,12 @@ void CheMPS2::Heff::addDiagram4B1and4B2spin0(const int ikappa, double * memS, do
                   double * Lblock = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                   double alpha = 1.0;
                   double beta = 0.0; //set
-                  dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
+                  HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
                   
                   double * Ablock = Aleft[l_index-theindex][0]->gStorage(NL,TwoSL,IL,NL+2,TwoSL,ILdown);
                   alpha = factor;
                   beta = 1.0; //add
-                  dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Ablock,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Ablock,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                }
             }
@@ -1021,7 +1021,7 @@ void CheMPS2::Heff::addDiagram4B1and4B2spin0(const int ikappa, double * memS, do
             if ((abs(TwoSL-TwoSRdown)<=TwoJdown) && (TwoSRdown>=0)){
          
                int fase = phase(TwoSRdown + TwoSL + 2 + TwoJdown + 2*TwoS2);
-               const double factor = fase * sqrt(0.5*(TwoSRdown+1)*(TwoJdown+1)) * gsl_sf_coupling_6j(TwoJdown, TwoS2, 1, TwoSR, TwoSRdown, TwoSL);
+               const double factor = fase * sqrt(0.5*(TwoSRdown+1)*(TwoJdown+1)) * Wigner::wigner6j(TwoJdown, TwoS2, 1, TwoSR, TwoSRdown, TwoSL);
    
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -1037,12 +1037,12 @@ void CheMPS2::Heff::addDiagram4B1and4B2spin0(const int ikappa, double * memS, do
                      double * Lblock = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                      double alpha = 1.0;
                      double beta = 0.0; //set
-                     dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
                   
                      double * Ablock = Aleft[l_index-theindex][0]->gStorage(NL,TwoSL,IL,NL+2,TwoSL,ILdown);
                      alpha = factor;
                      beta = 1.0; //add
-                     dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Ablock,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Ablock,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                   }
                }
@@ -1086,7 +1086,7 @@ void CheMPS2::Heff::addDiagram4B1and4B2spin1(const int ikappa, double * memS, do
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
                   int fase = (TwoS2==0)?1:-1;
-                  const double factor = fase * sqrt(3.0*(TwoSR+1)*(TwoSL+1)*(TwoJdown+1)) * gsl_sf_coupling_9j(2, TwoSLdown, TwoSL, 1, TwoSRdown, TwoSR, 1, TwoJdown, TwoS2);
+                  const double factor = fase * sqrt(3.0*(TwoSR+1)*(TwoSL+1)*(TwoJdown+1)) * Wigner::wigner9j(2, TwoSLdown, TwoSL, 1, TwoSRdown, TwoSR, 1, TwoJdown, TwoS2);
    
                   for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -1102,12 +1102,12 @@ void CheMPS2::Heff::addDiagram4B1and4B2spin1(const int ikappa, double * memS, do
                         double * Lblock = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                         double alpha = 1.0;
                         double beta = 0.0; //set
-                        dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown, Lblock,&dimRdown, &beta,temp, &dimLdown);
+                        HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown, Lblock,&dimRdown, &beta,temp, &dimLdown);
                   
                         double * Bblock = Bleft[l_index-theindex][0]->gStorage(NL-2,TwoSLdown,ILdown,NL,TwoSL,IL);
                         alpha = factor;
                         beta = 1.0; //add
-                        dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Bblock,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                        HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Bblock,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                      }
                   }
@@ -1125,7 +1125,7 @@ void CheMPS2::Heff::addDiagram4B1and4B2spin1(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSRdown)<=TwoS2) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
                int fase = phase(TwoSR - TwoSRdown + TwoSL + 3 - TwoSLdown + 2*TwoS2);
-               const double factor = fase * sqrt(3.0*(TwoSR+1)*(TwoSL+1)*(TwoJ+1)) * gsl_sf_coupling_9j(2, TwoSL, TwoSLdown, 1, TwoSR, TwoSRdown, 1, TwoJ, TwoS2);
+               const double factor = fase * sqrt(3.0*(TwoSR+1)*(TwoSL+1)*(TwoJ+1)) * Wigner::wigner9j(2, TwoSL, TwoSLdown, 1, TwoSR, TwoSRdown, 1, TwoJ, TwoS2);
    
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -1141,12 +1141,12 @@ void CheMPS2::Heff::addDiagram4B1and4B2spin1(const int ikappa, double * memS, do
                      double * Lblock = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                      double alpha = 1.0;
                      double beta = 0.0; //set
-                     dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp, &dimLdown);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp, &dimLdown);
                   
                      double * Bblock = Bleft[l_index-theindex][0]->gStorage(NL-2,TwoSLdown,ILdown,NL,TwoSL,IL);
                      alpha = factor;
                      beta = 1.0; //add
-                     dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Bblock,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Bblock,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                   }
                }
@@ -1163,7 +1163,7 @@ void CheMPS2::Heff::addDiagram4B1and4B2spin1(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSRdown)<=TwoS2) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
                int fase = (TwoS2==0)?1:-1;
-               const double factor = fase * sqrt(3.0*(TwoSRdown+1)*(TwoSLdown+1)*(TwoJ+1)) * gsl_sf_coupling_9j(2, TwoSL, TwoSLdown, 1, TwoSR, TwoSRdown, 1, TwoJ, TwoS2);
+               const double factor = fase * sqrt(3.0*(TwoSRdown+1)*(TwoSLdown+1)*(TwoJ+1)) * Wigner::wigner9j(2, TwoSL, TwoSLdown, 1, TwoSR, TwoSRdown, 1, TwoJ, TwoS2);
    
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -1179,12 +1179,12 @@ void CheMPS2::Heff::addDiagram4B1and4B2spin1(const int ikappa, double * memS, do
                      double * Lblock = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                      double alpha = 1.0;
                      double beta = 0.0; //set
-                     dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
                   
                      double * Bblock = Bleft[l_index-theindex][0]->gStorage(NL,TwoSL,IL,NL+2,TwoSLdown,ILdown);
                      alpha = factor;
                      beta = 1.0; //add
-                     dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Bblock,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Bblock,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                   }
                }
@@ -1204,7 +1204,7 @@ void CheMPS2::Heff::addDiagram4B1and4B2spin1(const int ikappa, double * memS, do
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
                   int fase = phase(TwoSLdown + 3 - TwoSL + TwoSRdown - TwoSR + 2*TwoS2);
-                  const double factor = fase * sqrt(3.0*(TwoSRdown+1)*(TwoJdown+1)*(TwoSLdown+1)) * gsl_sf_coupling_9j(2, TwoSLdown, TwoSL, 1, TwoSRdown, TwoSR, 1, TwoJdown, TwoS2);
+                  const double factor = fase * sqrt(3.0*(TwoSRdown+1)*(TwoJdown+1)*(TwoSLdown+1)) * Wigner::wigner9j(2, TwoSLdown, TwoSL, 1, TwoSRdown, TwoSR, 1, TwoJdown, TwoS2);
    
                   for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -1220,12 +1220,12 @@ void CheMPS2::Heff::addDiagram4B1and4B2spin1(const int ikappa, double * memS, do
                         double * Lblock = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                         double alpha = 1.0;
                         double beta = 0.0; //set
-                        dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp, &dimLdown);
+                        HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp, &dimLdown);
                   
                         double * Bblock = Bleft[l_index-theindex][0]->gStorage(NL,TwoSL,IL,NL+2,TwoSLdown,ILdown);
                         alpha = factor;
                         beta = 1.0; //add
-                        dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Bblock,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                        HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Bblock,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                      }
                   }
@@ -1266,7 +1266,7 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin0(const int ikappa, double * memS, do
          if ((abs(TwoSL-TwoSRdown)<=TwoS2) && (TwoSRdown>=0)){
          
             int fase = phase(TwoSR + TwoSL + TwoJ + 2*TwoS2);
-            const double factor = fase * sqrt(0.5*(TwoSR+1)*(TwoJ+1)) * gsl_sf_coupling_6j(TwoJ, TwoS2, 1, TwoSRdown, TwoSR, TwoSL);
+            const double factor = fase * sqrt(0.5*(TwoSR+1)*(TwoJ+1)) * Wigner::wigner6j(TwoJ, TwoS2, 1, TwoSRdown, TwoSR, TwoSL);
    
             for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -1282,18 +1282,18 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin0(const int ikappa, double * memS, do
                   double * Lblock = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                   double alpha = 1.0;
                   double beta = 0.0; //set
-                  dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp,&dimLdown);
+                  HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp,&dimLdown);
                   
                   double * ptr = Cleft[l_index-theindex][0]->gStorage(NL,TwoSL,ILdown,NL,TwoSL,IL);
                   if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                      int inc = 1;
                      int size = dimLdown * dimLup;
-                     dcopy_(&size,ptr,&inc,temp2,&inc);
+                     HeffPlan::dcopy(&size,ptr,&inc,temp2,&inc);
                   
                      for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                         double prefact = 2 * Prob->gMxElement(l_alpha,theindex,l_alpha,l_index) - Prob->gMxElement(l_alpha,l_alpha,theindex,l_index);
                         double * F0block = F0left[theindex-1-l_alpha]->gStorage(NL,TwoSL,ILdown,NL,TwoSL,IL);
-                        daxpy_(&size,&prefact,F0block,&inc,temp2,&inc);
+                        HeffPlan::daxpy(&size,&prefact,F0block,&inc,temp2,&inc);
                      }
                   
                      ptr = temp2;
@@ -1301,7 +1301,7 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin0(const int ikappa, double * memS, do
                
                   alpha = factor;
                   beta = 1.0; //add
-                  dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                }
             }
@@ -1319,7 +1319,7 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin0(const int ikappa, double * memS, do
             if ((abs(TwoSL-TwoSRdown)<=TwoJdown) && (TwoSRdown>=0)){
          
                int fase = phase(TwoSR + TwoSL + 1 + TwoJdown + 2*TwoS2);
-               const double factor = fase * sqrt(0.5*(TwoSR+1)*(TwoJdown+1)) * gsl_sf_coupling_6j(TwoJdown, TwoS2, 1, TwoSR, TwoSRdown, TwoSL);
+               const double factor = fase * sqrt(0.5*(TwoSR+1)*(TwoJdown+1)) * Wigner::wigner6j(TwoJdown, TwoS2, 1, TwoSR, TwoSRdown, TwoSL);
     
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -1335,18 +1335,18 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin0(const int ikappa, double * memS, do
                      double * Lblock = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                      double alpha = 1.0;
                      double beta = 0.0; //set
-                     dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp, &dimLdown);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp, &dimLdown);
                   
                      double * ptr = Cleft[l_index-theindex][0]->gStorage(NL,TwoSL,ILdown,NL,TwoSL,IL);
                      if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                         int inc = 1;
                         int size = dimLdown * dimLup;
-                        dcopy_(&size,ptr,&inc,temp2,&inc);
+                        HeffPlan::dcopy(&size,ptr,&inc,temp2,&inc);
                   
                         for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                            double prefact = 2 * Prob->gMxElement(l_alpha,theindex,l_alpha,l_index) - Prob->gMxElement(l_alpha,l_alpha,theindex,l_index);
                            double * F0block = F0left[theindex-1-l_alpha]->gStorage(NL,TwoSL,ILdown,NL,TwoSL,IL);
-                           daxpy_(&size,&prefact,F0block,&inc,temp2,&inc);
+                           HeffPlan::daxpy(&size,&prefact,F0block,&inc,temp2,&inc);
                         }
                   
                         ptr = temp2;
@@ -1354,7 +1354,7 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin0(const int ikappa, double * memS, do
                
                      alpha = factor;
                      beta = 1.0; //add
-                     dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                   }
                }
@@ -1373,7 +1373,7 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin0(const int ikappa, double * memS, do
             if ((abs(TwoSL-TwoSRdown)<=TwoJdown) && (TwoSRdown>=0)){
          
                int fase = phase(TwoSRdown + TwoSL + TwoJdown + 2*TwoS2);
-               const double factor = fase * sqrt(0.5*(TwoSRdown+1)*(TwoJdown+1)) * gsl_sf_coupling_6j(TwoJdown, TwoS2, 1, TwoSR, TwoSRdown, TwoSL);
+               const double factor = fase * sqrt(0.5*(TwoSRdown+1)*(TwoJdown+1)) * Wigner::wigner6j(TwoJdown, TwoS2, 1, TwoSR, TwoSRdown, TwoSL);
     
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -1389,18 +1389,18 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin0(const int ikappa, double * memS, do
                      double * Lblock = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                      double alpha = 1.0;
                      double beta = 0.0; //set
-                     dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
                   
                      double * ptr = Cleft[l_index-theindex][0]->gStorage(NL,TwoSL,IL,NL,TwoSL,ILdown);
                      if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                         int inc = 1;
                         int size = dimLdown * dimLup;
-                        dcopy_(&size,ptr,&inc,temp2,&inc);
+                        HeffPlan::dcopy(&size,ptr,&inc,temp2,&inc);
                   
                         for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                            double prefact = 2 * Prob->gMxElement(l_alpha,theindex,l_alpha,l_index) - Prob->gMxElement(l_alpha,l_alpha,theindex,l_index);
                            double * F0block = F0left[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL,TwoSL,ILdown);
-                           daxpy_(&size,&prefact,F0block,&inc,temp2,&inc);
+                           HeffPlan::daxpy(&size,&prefact,F0block,&inc,temp2,&inc);
                         }
                   
                         ptr = temp2;
@@ -1408,7 +1408,7 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin0(const int ikappa, double * memS, do
                
                      alpha = factor;
                      beta = 1.0; //add
-                     dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                   }
                }
@@ -1424,7 +1424,7 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin0(const int ikappa, double * memS, do
          if ((abs(TwoSL-TwoSRdown)<=TwoS2) && (TwoSRdown>=0)){
          
             int fase = phase(TwoSRdown + TwoSL + 1 + TwoJ + 2*TwoS2);
-            const double factor = fase * sqrt(0.5*(TwoSRdown+1)*(TwoJ+1)) * gsl_sf_coupling_6j(TwoJ, TwoS2, 1, TwoSRdown, TwoSR, TwoSL);
+            const double factor = fase * sqrt(0.5*(TwoSRdown+1)*(TwoJ+1)) * Wigner::wigner6j(TwoJ, TwoS2, 1, TwoSRdown, TwoSR, TwoSL);
     
             for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -1440,18 +1440,18 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin0(const int ikappa, double * memS, do
                   double * Lblock = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                   double alpha = 1.0;
                   double beta = 0.0; //set
-                  dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
+                  HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
                   
                   double * ptr = Cleft[l_index-theindex][0]->gStorage(NL,TwoSL,IL,NL,TwoSL,ILdown);
                   if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                      int inc = 1;
                      int size = dimLdown * dimLup;
-                     dcopy_(&size,ptr,&inc,temp2,&inc);
+                     HeffPlan::dcopy(&size,ptr,&inc,temp2,&inc);
                   
                      for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                         double prefact = 2 * Prob->gMxElement(l_alpha,theindex,l_alpha,l_index) - Prob->gMxElement(l_alpha,l_alpha,theindex,l_index);
                         double * F0block = F0left[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL,TwoSL,ILdown);
-                        daxpy_(&size,&prefact,F0block,&inc,temp2,&inc);
+                        HeffPlan::daxpy(&size,&prefact,F0block,&inc,temp2,&inc);
                      }
                   
                      ptr = temp2;
@@ -1459,7 +1459,7 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin0(const int ikappa, double * memS, do
                
                   alpha = factor;
                   beta = 1.0; //add
-                  dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                }
             }
@@ -1499,7 +1499,7 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin1(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSRdown)<=TwoS2) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
                int fase = phase(TwoSL-TwoSLdown + TwoSR - TwoSRdown + 3 + 2*TwoS2);
-               const double factor = fase * sqrt(3.0*(TwoSR+1)*(TwoJ+1)*(TwoSL+1)) * gsl_sf_coupling_9j(2, TwoSL, TwoSLdown, 1, TwoSR, TwoSRdown, 1, TwoJ, TwoS2);
+               const double factor = fase * sqrt(3.0*(TwoSR+1)*(TwoJ+1)*(TwoSL+1)) * Wigner::wigner9j(2, TwoSL, TwoSLdown, 1, TwoSR, TwoSRdown, 1, TwoJ, TwoS2);
    
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -1515,18 +1515,18 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin1(const int ikappa, double * memS, do
                      double * Lblock = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                      double alpha = 1.0;
                      double beta = 0.0; //set
-                     dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp, &dimLdown);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp, &dimLdown);
                   
                      double * ptr = Dleft[l_index-theindex][0]->gStorage(NL,TwoSLdown,ILdown,NL,TwoSL,IL);
                      if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                         int inc = 1;
                         int size = dimLdown * dimLup;
-                        dcopy_(&size,ptr,&inc,temp2,&inc);
+                        HeffPlan::dcopy(&size,ptr,&inc,temp2,&inc);
                   
                         for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                            double prefact = - Prob->gMxElement(l_alpha,l_alpha,theindex,l_index);
                            double * F1block = F1left[theindex-1-l_alpha]->gStorage(NL,TwoSLdown,ILdown,NL,TwoSL,IL);
-                           daxpy_(&size,&prefact,F1block,&inc,temp2,&inc);
+                           HeffPlan::daxpy(&size,&prefact,F1block,&inc,temp2,&inc);
                         }
                   
                         ptr = temp2;
@@ -1534,7 +1534,7 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin1(const int ikappa, double * memS, do
                
                      alpha = factor;
                      beta = 1.0; //add
-                     dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                   }
                }
@@ -1554,7 +1554,7 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin1(const int ikappa, double * memS, do
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
                   int fase = (TwoS2==0)?-1:1;
-                  const double factor = fase * sqrt(3.0*(TwoSR+1)*(TwoJdown+1)*(TwoSL+1)) * gsl_sf_coupling_9j(2, TwoSLdown, TwoSL, 1, TwoSRdown, TwoSR, 1, TwoJdown, TwoS2);
+                  const double factor = fase * sqrt(3.0*(TwoSR+1)*(TwoJdown+1)*(TwoSL+1)) * Wigner::wigner9j(2, TwoSLdown, TwoSL, 1, TwoSRdown, TwoSR, 1, TwoJdown, TwoS2);
     
                   for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -1570,18 +1570,18 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin1(const int ikappa, double * memS, do
                         double * Lblock = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                         double alpha = 1.0;
                         double beta = 0.0; //set
-                        dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp, &dimLdown);
+                        HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp, &dimLdown);
                   
                         double * ptr = Dleft[l_index-theindex][0]->gStorage(NL,TwoSLdown,ILdown,NL,TwoSL,IL);
                         if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                            int inc = 1;
                            int size = dimLdown * dimLup;
-                           dcopy_(&size,ptr,&inc,temp2,&inc);
+                           HeffPlan::dcopy(&size,ptr,&inc,temp2,&inc);
                   
                            for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                              double prefact = - Prob->gMxElement(l_alpha,l_alpha,theindex,l_index);
                               double * F1block = F1left[theindex-1-l_alpha]->gStorage(NL,TwoSLdown,ILdown,NL,TwoSL,IL);
-                              daxpy_(&size,&prefact,F1block,&inc,temp2,&inc);
+                              HeffPlan::daxpy(&size,&prefact,F1block,&inc,temp2,&inc);
                            }
                   
                            ptr = temp2;
@@ -1589,7 +1589,7 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin1(const int ikappa, double * memS, do
                
                         alpha = factor;
                         beta = 1.0; //add
-                        dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                        HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                      }
                   }
@@ -1610,7 +1610,7 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin1(const int ikappa, double * memS, do
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
                   int fase = phase(TwoSRdown - TwoSR + TwoSLdown - TwoSL + 3 + 2*TwoS2);
-                  const double factor = fase * sqrt(3.0*(TwoSRdown+1)*(TwoJdown+1)*(TwoSLdown+1)) * gsl_sf_coupling_9j(2, TwoSLdown, TwoSL, 1, TwoSRdown, TwoSR, 1, TwoJdown, TwoS2);
+                  const double factor = fase * sqrt(3.0*(TwoSRdown+1)*(TwoJdown+1)*(TwoSLdown+1)) * Wigner::wigner9j(2, TwoSLdown, TwoSL, 1, TwoSRdown, TwoSR, 1, TwoJdown, TwoS2);
     
                   for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -1626,18 +1626,18 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin1(const int ikappa, double * memS, do
                         double * Lblock = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                         double alpha = 1.0;
                         double beta = 0.0; //set
-                        dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp, &dimLdown);
+                        HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp, &dimLdown);
                   
                         double * ptr = Dleft[l_index-theindex][0]->gStorage(NL,TwoSL,IL,NL,TwoSLdown,ILdown);
                         if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                            int inc = 1;
                            int size = dimLdown * dimLup;
-                           dcopy_(&size,ptr,&inc,temp2,&inc);
+                           HeffPlan::dcopy(&size,ptr,&inc,temp2,&inc);
                   
                            for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                               double prefact = - Prob->gMxElement(l_alpha,l_alpha,theindex,l_index);
                               double * F1block = F1left[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL,TwoSLdown,ILdown);
-                              daxpy_(&size,&prefact,F1block,&inc,temp2,&inc);
+                              HeffPlan::daxpy(&size,&prefact,F1block,&inc,temp2,&inc);
                            }
                   
                            ptr = temp2;
@@ -1645,7 +1645,7 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin1(const int ikappa, double * memS, do
                
                         alpha = factor;
                         beta = 1.0; //add
-                        dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                        HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                      }
                   }
@@ -1663,7 +1663,7 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin1(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSRdown)<=TwoS2) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
                int fase = (TwoS2==0)?-1:1;
-               const double factor = fase * sqrt(3.0*(TwoSRdown+1)*(TwoJ+1)*(TwoSLdown+1)) * gsl_sf_coupling_9j(2, TwoSL, TwoSLdown, 1, TwoSR, TwoSRdown, 1, TwoJ, TwoS2);
+               const double factor = fase * sqrt(3.0*(TwoSRdown+1)*(TwoJ+1)*(TwoSLdown+1)) * Wigner::wigner9j(2, TwoSL, TwoSLdown, 1, TwoSR, TwoSRdown, 1, TwoJ, TwoS2);
     
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -1679,18 +1679,18 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin1(const int ikappa, double * memS, do
                      double * Lblock = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                      double alpha = 1.0;
                      double beta = 0.0; //set
-                     dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
                   
                      double * ptr = Dleft[l_index-theindex][0]->gStorage(NL,TwoSL,IL,NL,TwoSLdown,ILdown);
                      if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                         int inc = 1;
                         int size = dimLdown * dimLup;
-                        dcopy_(&size,ptr,&inc,temp2,&inc);
+                        HeffPlan::dcopy(&size,ptr,&inc,temp2,&inc);
                   
                         for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                            double prefact = - Prob->gMxElement(l_alpha,l_alpha,theindex,l_index);
                            double * F1block = F1left[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL,TwoSLdown,ILdown);
-                           daxpy_(&size,&prefact,F1block,&inc,temp2,&inc);
+                           HeffPlan::daxpy(&size,&prefact,F1block,&inc,temp2,&inc);
                         }
                   
                         ptr = temp2;
@@ -1698,7 +1698,7 @@ void CheMPS2::Heff::addDiagram4B3and4B4spin1(const int ikappa, double * memS, do
                
                      alpha = factor;
                      beta = 1.0; //add
-                     dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                   }
                }
@@ -1740,7 +1740,7 @@ void CheMPS2::Heff::addDiagram4C1and4C2spin0(const int ikappa, double * memS, do
          for (int TwoJdown=TwoJstart; TwoJdown<=TwoS1+1; TwoJdown+=2){
             if ((abs(TwoSL-TwoSRdown)<=TwoJdown) && (TwoSRdown>=0)){
          
-               const double factor = phase(TwoSR + TwoSL + 2 + TwoS1) * sqrt(0.5*(TwoSR+1)*(TwoJdown+1)) * gsl_sf_coupling_6j(TwoJdown, TwoS1, 1, TwoSR, TwoSRdown, TwoSL);
+               const double factor = phase(TwoSR + TwoSL + 2 + TwoS1) * sqrt(0.5*(TwoSR+1)*(TwoJdown+1)) * Wigner::wigner6j(TwoJdown, TwoS1, 1, TwoSR, TwoSRdown, TwoSL);
    
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -1756,12 +1756,12 @@ void CheMPS2::Heff::addDiagram4C1and4C2spin0(const int ikappa, double * memS, do
                      double * Lblock = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                      double alpha = 1.0;
                      double beta = 0.0; //set
-                     dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp,&dimLdown);
                   
                      double * Ablock = Aleft[l_index-theindex-1][1]->gStorage(NL-2,TwoSL,ILdown,NL,TwoSL,IL);
                      alpha = factor;
                      beta = 1.0; //add
-                     dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Ablock,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Ablock,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                   }
                }
@@ -1776,7 +1776,7 @@ void CheMPS2::Heff::addDiagram4C1and4C2spin0(const int ikappa, double * memS, do
       for (int TwoSRdown=TwoSR-1; TwoSRdown<=TwoSR+1; TwoSRdown+=2){
          if ((abs(TwoSL-TwoSRdown)<=TwoS1) && (TwoSRdown>=0)){
          
-            const double factor = phase(TwoSR + TwoSL + 3 + TwoS1) * sqrt(0.5*(TwoSR+1)*(TwoJ+1)) * gsl_sf_coupling_6j(TwoJ, TwoS1, 1, TwoSRdown, TwoSR, TwoSL);
+            const double factor = phase(TwoSR + TwoSL + 3 + TwoS1) * sqrt(0.5*(TwoSR+1)*(TwoJ+1)) * Wigner::wigner6j(TwoJ, TwoS1, 1, TwoSRdown, TwoSR, TwoSL);
    
             for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
        
@@ -1792,12 +1792,12 @@ void CheMPS2::Heff::addDiagram4C1and4C2spin0(const int ikappa, double * memS, do
                   double * Lblock = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                   double alpha = 1.0;
                   double beta = 0.0; //set
-                  dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp,&dimLdown);
+                  HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp,&dimLdown);
                   
                   double * Ablock = Aleft[l_index-theindex-1][1]->gStorage(NL-2,TwoSL,ILdown,NL,TwoSL,IL);
                   alpha = factor;
                   beta = 1.0; //add
-                  dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Ablock,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Ablock,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                }
             }
@@ -1811,7 +1811,7 @@ void CheMPS2::Heff::addDiagram4C1and4C2spin0(const int ikappa, double * memS, do
       for (int TwoSRdown=TwoSR-1; TwoSRdown<=TwoSR+1; TwoSRdown+=2){
          if ((abs(TwoSL-TwoSRdown)<=TwoS1) && (TwoSRdown>=0)){
          
-            const double factor = phase(TwoSRdown + TwoSL + 2 + TwoS1) * sqrt(0.5*(TwoSRdown+1)*(TwoJ+1)) * gsl_sf_coupling_6j(TwoJ, TwoS1, 1, TwoSRdown, TwoSR, TwoSL);
+            const double factor = phase(TwoSRdown + TwoSL + 2 + TwoS1) * sqrt(0.5*(TwoSRdown+1)*(TwoJ+1)) * Wigner::wigner6j(TwoJ, TwoS1, 1, TwoSRdown, TwoSR, TwoSL);
    
             for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -1827,12 +1827,12 @@ void CheMPS2::Heff::addDiagram4C1and4C2spin0(const int ikappa, double * memS, do
                   double * Lblock = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                   double alpha = 1.0;
                   double beta = 0.0; //set
-                  dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
+                  HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
                   
                   double * Ablock = Aleft[l_index-theindex-1][1]->gStorage(NL,TwoSL,IL,NL+2,TwoSL,ILdown);
                   alpha = factor;
                   beta = 1.0; //add
-                  dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Ablock,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Ablock,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                }
             }
@@ -1849,7 +1849,7 @@ void CheMPS2::Heff::addDiagram4C1and4C2spin0(const int ikappa, double * memS, do
          for (int TwoJdown=TwoJstart; TwoJdown<=TwoS1+1; TwoJdown+=2){
             if ((abs(TwoSL-TwoSRdown)<=TwoJdown) && (TwoSRdown>=0)){
          
-               const double factor = phase(TwoSRdown + TwoSL + 3 + TwoS1) * sqrt(0.5*(TwoSRdown+1)*(TwoJdown+1)) * gsl_sf_coupling_6j(TwoJdown, TwoS1, 1, TwoSR, TwoSRdown, TwoSL);
+               const double factor = phase(TwoSRdown + TwoSL + 3 + TwoS1) * sqrt(0.5*(TwoSRdown+1)*(TwoJdown+1)) * Wigner::wigner6j(TwoJdown, TwoS1, 1, TwoSR, TwoSRdown, TwoSL);
    
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -1865,12 +1865,12 @@ void CheMPS2::Heff::addDiagram4C1and4C2spin0(const int ikappa, double * memS, do
                      double * Lblock = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                      double alpha = 1.0;
                      double beta = 0.0; //set
-                     dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
                   
                      double * Ablock = Aleft[l_index-theindex-1][1]->gStorage(NL,TwoSL,IL,NL+2,TwoSL,ILdown);
                      alpha = factor;
                      beta = 1.0; //add
-                     dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Ablock,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Ablock,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                   }
                }
@@ -1913,7 +1913,7 @@ void CheMPS2::Heff::addDiagram4C1and4C2spin1(const int ikappa, double * memS, do
             for (int TwoJdown=TwoJstart; TwoJdown<=TwoS1+1; TwoJdown+=2){
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
-                  const double factor = phase(1 + TwoS1 - TwoJdown) * sqrt(3.0*(TwoSR+1)*(TwoSL+1)*(TwoJdown+1)) * gsl_sf_coupling_9j(2, TwoSLdown, TwoSL, 1, TwoSRdown, TwoSR, 1, TwoJdown, TwoS1);
+                  const double factor = phase(1 + TwoS1 - TwoJdown) * sqrt(3.0*(TwoSR+1)*(TwoSL+1)*(TwoJdown+1)) * Wigner::wigner9j(2, TwoSLdown, TwoSL, 1, TwoSRdown, TwoSR, 1, TwoJdown, TwoS1);
    
                   for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -1929,12 +1929,12 @@ void CheMPS2::Heff::addDiagram4C1and4C2spin1(const int ikappa, double * memS, do
                         double * Lblock = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                         double alpha = 1.0;
                         double beta = 0.0; //set
-                        dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp,&dimLdown);
+                        HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp,&dimLdown);
                   
                         double * Bblock = Bleft[l_index-theindex-1][1]->gStorage(NL-2,TwoSLdown,ILdown,NL,TwoSL,IL);
                         alpha = factor;
                         beta = 1.0; //add
-                        dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Bblock,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                        HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Bblock,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                      }
                   }
@@ -1951,7 +1951,7 @@ void CheMPS2::Heff::addDiagram4C1and4C2spin1(const int ikappa, double * memS, do
          for (int TwoSLdown=TwoSL-2; TwoSLdown<=TwoSL+2; TwoSLdown+=2){
             if ((abs(TwoSLdown-TwoSRdown)<=TwoS1) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
-               const double factor = phase(TwoSR - TwoSRdown + TwoSL - TwoSLdown + TwoS1 - TwoJ) * sqrt(3.0*(TwoSR+1)*(TwoSL+1)*(TwoJ+1)) * gsl_sf_coupling_9j(2, TwoSL, TwoSLdown, 1, TwoSR, TwoSRdown, 1, TwoJ, TwoS1);
+               const double factor = phase(TwoSR - TwoSRdown + TwoSL - TwoSLdown + TwoS1 - TwoJ) * sqrt(3.0*(TwoSR+1)*(TwoSL+1)*(TwoJ+1)) * Wigner::wigner9j(2, TwoSL, TwoSLdown, 1, TwoSR, TwoSRdown, 1, TwoJ, TwoS1);
    
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -1967,12 +1967,12 @@ void CheMPS2::Heff::addDiagram4C1and4C2spin1(const int ikappa, double * memS, do
                      double * Lblock = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                      double alpha = 1.0;
                      double beta = 0.0; //set
-                     dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp,&dimLdown);
                   
                      double * Bblock = Bleft[l_index-theindex-1][1]->gStorage(NL-2,TwoSLdown,ILdown,NL,TwoSL,IL);
                      alpha = factor;
                      beta = 1.0; //add
-                     dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Bblock,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Bblock,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                   }
                }
@@ -1988,7 +1988,7 @@ void CheMPS2::Heff::addDiagram4C1and4C2spin1(const int ikappa, double * memS, do
          for (int TwoSLdown=TwoSL-2; TwoSLdown<=TwoSL+2; TwoSLdown+=2){
             if ((abs(TwoSLdown-TwoSRdown)<=TwoS1) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
-               const double factor = phase(1 + TwoS1 - TwoJ) * sqrt(3.0*(TwoSRdown+1)*(TwoSLdown+1)*(TwoJ+1)) * gsl_sf_coupling_9j(2, TwoSL, TwoSLdown, 1, TwoSR, TwoSRdown, 1, TwoJ, TwoS1);
+               const double factor = phase(1 + TwoS1 - TwoJ) * sqrt(3.0*(TwoSRdown+1)*(TwoSLdown+1)*(TwoJ+1)) * Wigner::wigner9j(2, TwoSL, TwoSLdown, 1, TwoSR, TwoSRdown, 1, TwoJ, TwoS1);
    
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -2004,12 +2004,12 @@ void CheMPS2::Heff::addDiagram4C1and4C2spin1(const int ikappa, double * memS, do
                      double * Lblock = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                      double alpha = 1.0;
                      double beta = 0.0; //set
-                     dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
                   
                      double * Bblock = Bleft[l_index-theindex-1][1]->gStorage(NL,TwoSL,IL,NL+2,TwoSLdown,ILdown);
                      alpha = factor;
                      beta = 1.0; //add
-                     dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Bblock,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Bblock,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                   }
                }
@@ -2028,7 +2028,7 @@ void CheMPS2::Heff::addDiagram4C1and4C2spin1(const int ikappa, double * memS, do
             for (int TwoJdown=TwoJstart; TwoJdown<=TwoS1+1; TwoJdown+=2){
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
-                  const double factor = phase(TwoSLdown - TwoSL + TwoSRdown - TwoSR + TwoS1 - TwoJdown) * sqrt(3.0*(TwoSRdown+1)*(TwoJdown+1)*(TwoSLdown+1)) * gsl_sf_coupling_9j(2, TwoSLdown, TwoSL, 1, TwoSRdown, TwoSR, 1, TwoJdown, TwoS1);
+                  const double factor = phase(TwoSLdown - TwoSL + TwoSRdown - TwoSR + TwoS1 - TwoJdown) * sqrt(3.0*(TwoSRdown+1)*(TwoJdown+1)*(TwoSLdown+1)) * Wigner::wigner9j(2, TwoSLdown, TwoSL, 1, TwoSRdown, TwoSR, 1, TwoJdown, TwoS1);
    
                   for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -2044,12 +2044,12 @@ void CheMPS2::Heff::addDiagram4C1and4C2spin1(const int ikappa, double * memS, do
                         double * Lblock = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                         double alpha = 1.0;
                         double beta = 0.0; //set
-                        dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
+                        HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
                   
                         double * Bblock = Bleft[l_index-theindex-1][1]->gStorage(NL,TwoSL,IL,NL+2,TwoSLdown,ILdown);
                         alpha = factor;
                         beta = 1.0; //add
-                        dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Bblock,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                        HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,Bblock,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                      }
                   }
@@ -2089,7 +2089,7 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin0(const int ikappa, double * memS, do
       for (int TwoSRdown=TwoSR-1; TwoSRdown<=TwoSR+1; TwoSRdown+=2){
          if ((abs(TwoSL-TwoSRdown)<=TwoS1) && (TwoSRdown>=0)){
          
-            const double factor = phase(TwoSR + TwoSL + 1 + TwoS1) * sqrt(0.5*(TwoSR+1)*(TwoJ+1)) * gsl_sf_coupling_6j(TwoJ, TwoS1, 1, TwoSRdown, TwoSR, TwoSL);
+            const double factor = phase(TwoSR + TwoSL + 1 + TwoS1) * sqrt(0.5*(TwoSR+1)*(TwoJ+1)) * Wigner::wigner6j(TwoJ, TwoS1, 1, TwoSRdown, TwoSR, TwoSL);
    
             for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -2105,18 +2105,18 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin0(const int ikappa, double * memS, do
                   double * Lblock = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                   double alpha = 1.0;
                   double beta = 0.0; //set
-                  dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp,&dimLdown);
+                  HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp,&dimLdown);
                   
                   double * ptr = Cleft[l_index-theindex-1][1]->gStorage(NL,TwoSL,ILdown,NL,TwoSL,IL);
                   if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                      int inc = 1;
                      int size = dimLdown * dimLup;
-                     dcopy_(&size,ptr,&inc,temp2,&inc);
+                     HeffPlan::dcopy(&size,ptr,&inc,temp2,&inc);
                   
                      for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                         double prefact = 2 * Prob->gMxElement(l_alpha,theindex+1,l_alpha,l_index) - Prob->gMxElement(l_alpha,l_alpha,theindex+1,l_index);
                         double * F0block = F0left[theindex-1-l_alpha]->gStorage(NL,TwoSL,ILdown,NL,TwoSL,IL);
-                        daxpy_(&size,&prefact,F0block,&inc,temp2,&inc);
+                        HeffPlan::daxpy(&size,&prefact,F0block,&inc,temp2,&inc);
                      }
                   
                      ptr = temp2;
@@ -2124,7 +2124,7 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin0(const int ikappa, double * memS, do
                
                   alpha = factor;
                   beta = 1.0; //add
-                  dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                }
             }
@@ -2141,7 +2141,7 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin0(const int ikappa, double * memS, do
          for (int TwoJdown=TwoJstart; TwoJdown<=TwoS1+1; TwoJdown+=2){
             if ((abs(TwoSL-TwoSRdown)<=TwoJdown) && (TwoSRdown>=0)){
          
-               const double factor = phase(TwoSR + TwoSL + 2 + TwoS1) * sqrt(0.5*(TwoSR+1)*(TwoJdown+1)) * gsl_sf_coupling_6j(TwoJdown, TwoS1, 1, TwoSR, TwoSRdown, TwoSL);
+               const double factor = phase(TwoSR + TwoSL + 2 + TwoS1) * sqrt(0.5*(TwoSR+1)*(TwoJdown+1)) * Wigner::wigner6j(TwoJdown, TwoS1, 1, TwoSR, TwoSRdown, TwoSL);
     
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -2157,18 +2157,18 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin0(const int ikappa, double * memS, do
                      double * Lblock = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                      double alpha = 1.0;
                      double beta = 0.0; //set
-                     dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp,&dimLdown);
                   
                      double * ptr = Cleft[l_index-theindex-1][1]->gStorage(NL,TwoSL,ILdown,NL,TwoSL,IL);
                      if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                         int inc = 1;
                         int size = dimLdown * dimLup;
-                        dcopy_(&size,ptr,&inc,temp2,&inc);
+                        HeffPlan::dcopy(&size,ptr,&inc,temp2,&inc);
                   
                         for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                            double prefact = 2 * Prob->gMxElement(l_alpha,theindex+1,l_alpha,l_index) - Prob->gMxElement(l_alpha,l_alpha,theindex+1,l_index);
                            double * F0block = F0left[theindex-1-l_alpha]->gStorage(NL,TwoSL,ILdown,NL,TwoSL,IL);
-                           daxpy_(&size,&prefact,F0block,&inc,temp2,&inc);
+                           HeffPlan::daxpy(&size,&prefact,F0block,&inc,temp2,&inc);
                         }
                   
                         ptr = temp2;
@@ -2176,7 +2176,7 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin0(const int ikappa, double * memS, do
                
                      alpha = factor;
                      beta = 1.0; //add
-                     dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                   }
                }
@@ -2194,7 +2194,7 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin0(const int ikappa, double * memS, do
          for (int TwoJdown=TwoJstart; TwoJdown<=TwoS1+1; TwoJdown+=2){
             if ((abs(TwoSL-TwoSRdown)<=TwoJdown) && (TwoSRdown>=0)){
          
-               const double factor = phase(TwoSRdown + TwoSL + 1 + TwoS1) * sqrt(0.5*(TwoSRdown+1)*(TwoJdown+1)) * gsl_sf_coupling_6j(TwoJdown, TwoS1, 1, TwoSR, TwoSRdown, TwoSL);
+               const double factor = phase(TwoSRdown + TwoSL + 1 + TwoS1) * sqrt(0.5*(TwoSRdown+1)*(TwoJdown+1)) * Wigner::wigner6j(TwoJdown, TwoS1, 1, TwoSR, TwoSRdown, TwoSL);
     
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -2210,18 +2210,18 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin0(const int ikappa, double * memS, do
                      double * Lblock = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                      double alpha = 1.0;
                      double beta = 0.0; //set
-                     dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
                   
                      double * ptr = Cleft[l_index-theindex-1][1]->gStorage(NL,TwoSL,IL,NL,TwoSL,ILdown);
                      if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                         int inc = 1;
                         int size = dimLdown * dimLup;
-                        dcopy_(&size,ptr,&inc,temp2,&inc);
+                        HeffPlan::dcopy(&size,ptr,&inc,temp2,&inc);
                   
                         for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                            double prefact = 2 * Prob->gMxElement(l_alpha,theindex+1,l_alpha,l_index) - Prob->gMxElement(l_alpha,l_alpha,theindex+1,l_index);
                            double * F0block = F0left[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL,TwoSL,ILdown);
-                           daxpy_(&size,&prefact,F0block,&inc,temp2,&inc);
+                           HeffPlan::daxpy(&size,&prefact,F0block,&inc,temp2,&inc);
                         }
                   
                         ptr = temp2;
@@ -2229,7 +2229,7 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin0(const int ikappa, double * memS, do
                
                      alpha = factor;
                      beta = 1.0; //add
-                     dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                   }
                }
@@ -2244,7 +2244,7 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin0(const int ikappa, double * memS, do
       for (int TwoSRdown=TwoSR-1; TwoSRdown<=TwoSR+1; TwoSRdown+=2){
          if ((abs(TwoSL-TwoSRdown)<=TwoS1) && (TwoSRdown>=0)){
          
-            const double factor = phase(TwoSRdown+TwoSL+2+TwoS1) * sqrt(0.5*(TwoSRdown+1)*(TwoJ+1)) * gsl_sf_coupling_6j(TwoJ, TwoS1, 1, TwoSRdown, TwoSR, TwoSL);
+            const double factor = phase(TwoSRdown+TwoSL+2+TwoS1) * sqrt(0.5*(TwoSRdown+1)*(TwoJ+1)) * Wigner::wigner6j(TwoJ, TwoS1, 1, TwoSRdown, TwoSR, TwoSL);
     
             for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -2260,18 +2260,18 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin0(const int ikappa, double * memS, do
                   double * Lblock = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                   double alpha = 1.0;
                   double beta = 0.0; //set
-                  dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
+                  HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
                   
                   double * ptr = Cleft[l_index-theindex-1][1]->gStorage(NL,TwoSL,IL,NL,TwoSL,ILdown);
                   if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                      int inc = 1;
                      int size = dimLdown * dimLup;
-                     dcopy_(&size,ptr,&inc,temp2,&inc);
+                     HeffPlan::dcopy(&size,ptr,&inc,temp2,&inc);
                   
                      for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                         double prefact = 2 * Prob->gMxElement(l_alpha,theindex+1,l_alpha,l_index) - Prob->gMxElement(l_alpha,l_alpha,theindex+1,l_index);
                         double * F0block = F0left[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL,TwoSL,ILdown);
-                        daxpy_(&size,&prefact,F0block,&inc,temp2,&inc);
+                        HeffPlan::daxpy(&size,&prefact,F0block,&inc,temp2,&inc);
                      }
                   
                      ptr = temp2;
@@ -2279,7 +2279,7 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin0(const int ikappa, double * memS, do
                
                   alpha = factor;
                   beta = 1.0; //add
-                  dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                }
             }
@@ -2319,7 +2319,7 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin1(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSRdown)<=TwoS1) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
                int fase = phase(TwoSL-TwoSLdown + TwoSR - TwoSRdown + TwoS1 - TwoJ);
-               const double factor = fase * sqrt(3.0*(TwoSR+1)*(TwoJ+1)*(TwoSL+1)) * gsl_sf_coupling_9j(2, TwoSL, TwoSLdown, 1, TwoSR, TwoSRdown, 1, TwoJ, TwoS1);
+               const double factor = fase * sqrt(3.0*(TwoSR+1)*(TwoJ+1)*(TwoSL+1)) * Wigner::wigner9j(2, TwoSL, TwoSLdown, 1, TwoSR, TwoSRdown, 1, TwoJ, TwoS1);
    
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -2335,18 +2335,18 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin1(const int ikappa, double * memS, do
                      double * Lblock = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                      double alpha = 1.0;
                      double beta = 0.0; //set
-                     dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp,&dimLdown);
                   
                      double * ptr = Dleft[l_index-theindex-1][1]->gStorage(NL,TwoSLdown,ILdown,NL,TwoSL,IL);
                      if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                         int inc = 1;
                         int size = dimLdown * dimLup;
-                        dcopy_(&size,ptr,&inc,temp2,&inc);
+                        HeffPlan::dcopy(&size,ptr,&inc,temp2,&inc);
                   
                         for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                            double prefact = - Prob->gMxElement(l_alpha,l_alpha,theindex+1,l_index);
                            double * F1block = F1left[theindex-1-l_alpha]->gStorage(NL,TwoSLdown,ILdown,NL,TwoSL,IL);
-                           daxpy_(&size,&prefact,F1block,&inc,temp2,&inc);
+                           HeffPlan::daxpy(&size,&prefact,F1block,&inc,temp2,&inc);
                         }
                   
                         ptr = temp2;
@@ -2354,7 +2354,7 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin1(const int ikappa, double * memS, do
                
                      alpha = factor;
                      beta = 1.0; //add
-                     dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                   }
                }
@@ -2374,7 +2374,7 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin1(const int ikappa, double * memS, do
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
                
                   int fase = phase(3 + TwoS1 - TwoJdown);
-                  const double factor = fase * sqrt(3.0*(TwoSR+1)*(TwoJdown+1)*(TwoSL+1)) * gsl_sf_coupling_9j(2, TwoSLdown, TwoSL, 1, TwoSRdown, TwoSR, 1, TwoJdown, TwoS1);
+                  const double factor = fase * sqrt(3.0*(TwoSR+1)*(TwoJdown+1)*(TwoSL+1)) * Wigner::wigner9j(2, TwoSLdown, TwoSL, 1, TwoSRdown, TwoSR, 1, TwoJdown, TwoS1);
     
                   for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -2390,18 +2390,18 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin1(const int ikappa, double * memS, do
                         double * Lblock = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                         double alpha = 1.0;
                         double beta = 0.0; //set
-                        dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp,&dimLdown);
+                        HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRdown,&beta,temp,&dimLdown);
                   
                         double * ptr = Dleft[l_index-theindex-1][1]->gStorage(NL,TwoSLdown,ILdown,NL,TwoSL,IL);
                         if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                            int inc = 1;
                            int size = dimLdown * dimLup;
-                           dcopy_(&size,ptr,&inc,temp2,&inc);
+                           HeffPlan::dcopy(&size,ptr,&inc,temp2,&inc);
                   
                            for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                               double prefact = - Prob->gMxElement(l_alpha,l_alpha,theindex+1,l_index);
                               double * F1block = F1left[theindex-1-l_alpha]->gStorage(NL,TwoSLdown,ILdown,NL,TwoSL,IL);
-                              daxpy_(&size,&prefact,F1block,&inc,temp2,&inc);
+                              HeffPlan::daxpy(&size,&prefact,F1block,&inc,temp2,&inc);
                            }
                   
                            ptr = temp2;
@@ -2409,7 +2409,7 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin1(const int ikappa, double * memS, do
                
                         alpha = factor;
                         beta = 1.0; //add
-                        dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                        HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                      }
                   }
@@ -2430,7 +2430,7 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin1(const int ikappa, double * memS, do
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
                   int fase = phase(TwoSRdown - TwoSR + TwoSLdown - TwoSL + TwoS1 - TwoJdown);
-                  const double factor = fase * sqrt(3.0*(TwoSRdown+1)*(TwoJdown+1)*(TwoSLdown+1)) * gsl_sf_coupling_9j(2, TwoSLdown, TwoSL, 1, TwoSRdown, TwoSR, 1, TwoJdown, TwoS1);
+                  const double factor = fase * sqrt(3.0*(TwoSRdown+1)*(TwoJdown+1)*(TwoSLdown+1)) * Wigner::wigner9j(2, TwoSLdown, TwoSL, 1, TwoSRdown, TwoSR, 1, TwoJdown, TwoS1);
     
                   for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -2446,18 +2446,18 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin1(const int ikappa, double * memS, do
                         double * Lblock = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                         double alpha = 1.0;
                         double beta = 0.0; //set
-                        dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
+                        HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
                   
                         double * ptr = Dleft[l_index-theindex-1][1]->gStorage(NL,TwoSL,IL,NL,TwoSLdown,ILdown);
                         if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                            int inc = 1;
                            int size = dimLdown * dimLup;
-                           dcopy_(&size,ptr,&inc,temp2,&inc);
+                           HeffPlan::dcopy(&size,ptr,&inc,temp2,&inc);
                   
                            for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                               double prefact = - Prob->gMxElement(l_alpha,l_alpha,theindex+1,l_index);
                               double * F1block = F1left[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL,TwoSLdown,ILdown);
-                              daxpy_(&size,&prefact,F1block,&inc,temp2,&inc);
+                              HeffPlan::daxpy(&size,&prefact,F1block,&inc,temp2,&inc);
                            }
                   
                            ptr = temp2;
@@ -2465,7 +2465,7 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin1(const int ikappa, double * memS, do
                
                         alpha = factor;
                         beta = 1.0; //add
-                        dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                        HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                      }
                   }
@@ -2483,7 +2483,7 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin1(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSRdown)<=TwoS1) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                int fase = phase(3 + TwoS1 - TwoJ);
-               const double factor = fase * sqrt(3.0*(TwoSRdown+1)*(TwoJ+1)*(TwoSLdown+1)) * gsl_sf_coupling_9j(2, TwoSL, TwoSLdown, 1, TwoSR, TwoSRdown, 1, TwoJ, TwoS1);
+               const double factor = fase * sqrt(3.0*(TwoSRdown+1)*(TwoJ+1)*(TwoSLdown+1)) * Wigner::wigner9j(2, TwoSL, TwoSLdown, 1, TwoSR, TwoSRdown, 1, TwoJ, TwoS1);
     
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
       
@@ -2499,18 +2499,18 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin1(const int ikappa, double * memS, do
                      double * Lblock = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                      double alpha = 1.0;
                      double beta = 0.0; //set
-                     dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,Lblock,&dimRup,&beta,temp,&dimLdown);
                   
                      double * ptr = Dleft[l_index-theindex-1][1]->gStorage(NL,TwoSL,IL,NL,TwoSLdown,ILdown);
                      if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                         int inc = 1;
                         int size = dimLdown * dimLup;
-                        dcopy_(&size,ptr,&inc,temp2,&inc);
+                        HeffPlan::dcopy(&size,ptr,&inc,temp2,&inc);
                   
                         for (int l_alpha=0; l_alpha<theindex; l_alpha++){
                            double prefact = - Prob->gMxElement(l_alpha,l_alpha,theindex+1,l_index);
                            double * F1block = F1left[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL,TwoSLdown,ILdown);
-                           daxpy_(&size,&prefact,F1block,&inc,temp2,&inc);
+                           HeffPlan::daxpy(&size,&prefact,F1block,&inc,temp2,&inc);
                         }
                   
                         ptr = temp2;
@@ -2518,7 +2518,7 @@ void CheMPS2::Heff::addDiagram4C3and4C4spin1(const int ikappa, double * memS, do
                
                      alpha = factor;
                      beta = 1.0; //add
-                     dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,ptr,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                   }
                }
@@ -2564,14 +2564,14 @@ void CheMPS2::Heff::addDiagram4D(const int ikappa, double * memS, double * memHe
             if (dimLdown>0){
             
                int size = dimLup * dimLdown;
-               for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+               HeffPlan::clear(size, temp);
          
                int number = 0;
                for (int l_index=0; l_index<theindex; l_index++){
                   if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                      double alpha = Prob->gMxElement(l_index,theindex,theindex,theindex+1);
                      double * Lblock = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                     daxpy_(&size,&alpha,Lblock,&inc,temp,&inc);
+                     HeffPlan::daxpy(&size,&alpha,Lblock,&inc,temp,&inc);
                      number++;
                   }
                }
@@ -2584,7 +2584,7 @@ void CheMPS2::Heff::addDiagram4D(const int ikappa, double * memS, double * memHe
                      factor = fase * sqrt((TwoSL+1.0)/(TwoSR+1.0));
                   }
                   int memSkappa = denS->gKappa(NL-1,TwoSLdown,ILdown,2,N2-1,TwoS2down,NR,TwoSR,IR);
-                  dgemm_(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,temp,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,temp,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                }
             }
          }
@@ -2602,14 +2602,14 @@ void CheMPS2::Heff::addDiagram4D(const int ikappa, double * memS, double * memHe
             if (dimLdown>0){
             
                int size = dimLup * dimLdown;
-               for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+               HeffPlan::clear(size, temp);
          
                int number = 0;
                for (int l_index=0; l_index<theindex; l_index++){
                   if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                      double alpha = Prob->gMxElement(l_index,theindex,theindex,theindex+1);
                      double * Lblock = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                     daxpy_(&size,&alpha,Lblock,&inc,temp,&inc);
+                     HeffPlan::daxpy(&size,&alpha,Lblock,&inc,temp,&inc);
                      number++;
                   }
                }
@@ -2622,7 +2622,7 @@ void CheMPS2::Heff::addDiagram4D(const int ikappa, double * memS, double * memHe
                      factor = fase * sqrt((TwoSLdown+1.0)/(TwoSR+1.0));
                   }
                   int memSkappa = denS->gKappa(NL+1,TwoSLdown,ILdown,0,N2+1,TwoS2down,NR,TwoSR,IR);
-                  dgemm_(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,temp,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,temp,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                }
             }
          }
@@ -2643,16 +2643,16 @@ void CheMPS2::Heff::addDiagram4D(const int ikappa, double * memS, double * memHe
                if (abs(TwoSLdown-TwoSR)<=TwoJdown){
             
                   int size = dimLup * dimLdown;
-                  for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                  HeffPlan::clear(size, temp);
                
                   double alpha_fact = 0.0;
                   if ((N1==1) && (N2==0)){ //4D3A
                      int fase = phase(TwoSLdown + TwoSR + 2);
-                     alpha_fact = fase * sqrt((TwoSL+1.0)*(TwoJdown+1)) * gsl_sf_coupling_6j(TwoJdown,1,1,TwoSL,TwoSLdown,TwoSR);
+                     alpha_fact = fase * sqrt((TwoSL+1.0)*(TwoJdown+1)) * Wigner::wigner6j(TwoJdown,1,1,TwoSL,TwoSLdown,TwoSR);
                   }
                   if ((N1==1) && (N2==1)){ //4D3B
                      int fase = phase(TwoSLdown + TwoSR + 3 + TwoJ);
-                     alpha_fact = fase * sqrt((TwoSL+1.0)*(TwoJ+1)) * gsl_sf_coupling_6j(TwoSL,TwoSR,TwoJ,1,1,TwoSLdown);
+                     alpha_fact = fase * sqrt((TwoSL+1.0)*(TwoJ+1)) * Wigner::wigner6j(TwoSL,TwoSR,TwoJ,1,1,TwoSLdown);
                   }
                   if ((N1==2) && (N2==0)){ //4D3C
                      alpha_fact = -1.0;
@@ -2681,7 +2681,7 @@ void CheMPS2::Heff::addDiagram4D(const int ikappa, double * memS, double * memHe
                         }
                      
                         double * Lblock = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                        daxpy_(&size,&alpha,Lblock,&inc,temp,&inc);
+                        HeffPlan::daxpy(&size,&alpha,Lblock,&inc,temp,&inc);
                         number++;
                      }
                   }
@@ -2690,7 +2690,7 @@ void CheMPS2::Heff::addDiagram4D(const int ikappa, double * memS, double * memHe
             
                      double factor = 1.0;
                      int memSkappa = denS->gKappa(NL-1,TwoSLdown,ILdown,N1,N2+1,TwoJdown,NR,TwoSR,IR);
-                     dgemm_(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,temp,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimR,&dimLdown,&factor,temp,&dimLdown,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   }
                }
             }
@@ -2714,16 +2714,16 @@ void CheMPS2::Heff::addDiagram4D(const int ikappa, double * memS, double * memHe
                if (abs(TwoSLdown-TwoSR)<=TwoJdown){
             
                   int size = dimLup * dimLdown;
-                  for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                  HeffPlan::clear(size, temp);
                
                   double alpha_fact = 0.0;
                   if ((N1==1) && (N2==1)){ //4D4A
                      int fase = phase(TwoSL + TwoSR + 2);
-                     alpha_fact = fase * sqrt((TwoSLdown+1.0)*(TwoJ+1)) * gsl_sf_coupling_6j(TwoJ,1,1,TwoSLdown,TwoSL,TwoSR);
+                     alpha_fact = fase * sqrt((TwoSLdown+1.0)*(TwoJ+1)) * Wigner::wigner6j(TwoJ,1,1,TwoSLdown,TwoSL,TwoSR);
                   }
                   if ((N1==1) && (N2==2)){ //4D4B
                      int fase = phase(TwoSL + TwoSR + 3 + TwoJdown);
-                     alpha_fact = fase * sqrt((TwoSLdown+1.0)*(TwoJdown+1)) * gsl_sf_coupling_6j(TwoSLdown,TwoSR,TwoJdown,1,1,TwoSL);
+                     alpha_fact = fase * sqrt((TwoSLdown+1.0)*(TwoJdown+1)) * Wigner::wigner6j(TwoSLdown,TwoSR,TwoJdown,1,1,TwoSL);
                   }
                   if ((N1==2) && (N2==1)){ //4D4C
                      alpha_fact = -1.0;
@@ -2752,7 +2752,7 @@ void CheMPS2::Heff::addDiagram4D(const int ikappa, double * memS, double * memHe
                         }
                      
                         double * Lblock = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                        daxpy_(&size,&alpha,Lblock,&inc,temp,&inc);
+                        HeffPlan::daxpy(&size,&alpha,Lblock,&inc,temp,&inc);
                         number++;
                      }
                   }
@@ -2761,7 +2761,7 @@ void CheMPS2::Heff::addDiagram4D(const int ikappa, double * memS, double * memHe
             
                      double factor = 1.0;
                      int memSkappa = denS->gKappa(NL+1,TwoSLdown,ILdown,N1,N2-1,TwoJdown,NR,TwoSR,IR);
-                     dgemm_(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,temp,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimR,&dimLdown,&factor,temp,&dimLup,memS+denS->gKappa2index(memSkappa),&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   }
                }
             }
@@ -2802,7 +2802,7 @@ void CheMPS2::Heff::addDiagram4E(const int ikappa, double * memS, double * memHe
             if ((abs(TwoSLdown-TwoSRdown)<=TwoJ) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
                int fase = phase(TwoSL+TwoSR-TwoS2);
-               const double factor = fase * sqrt((TwoSL+1)*(TwoSRdown+1.0)) * gsl_sf_coupling_6j(TwoSL,TwoSR,TwoS2,TwoSRdown,TwoSLdown,1);
+               const double factor = fase * sqrt((TwoSL+1)*(TwoSRdown+1.0)) * Wigner::wigner6j(TwoSL,TwoSR,TwoS2,TwoSRdown,TwoSLdown,1);
          
                for (int Irrep=0; Irrep < (denBK->getNumberOfIrreps()); Irrep++){
             
@@ -2826,24 +2826,24 @@ void CheMPS2::Heff::addDiagram4E(const int ikappa, double * memS, double * memHe
                            if (Irrep == denBK->gIrrep(l_alpha)){
                      
                               int size = dimRup * dimRdown;
-                              for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                              HeffPlan::clear(size, temp);
                               for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                  if (Irrep == denBK->gIrrep(l_beta)){
                                     double * LblockRight = Lright[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                                     double prefact = Prob->gMxElement(l_alpha,theindex,theindex,l_beta);
-                                    daxpy_(&size,&prefact,LblockRight,&inc,temp,&inc);
+                                    HeffPlan::daxpy(&size,&prefact,LblockRight,&inc,temp,&inc);
                                  }
                               }
                            
                               int memSkappa = denS->gKappa(NL-1,TwoSLdown,ILdown,2,N2,TwoS2,NR+1,TwoSRdown,IRdown);
                               double alpha = factor;
                               double beta = 0.0; //set
-                              dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
+                              HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
                            
                               alpha = 1.0;
                               beta = 1.0; //add
                               double * LblockLeft = Lleft[theindex-1-l_alpha]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                              dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockLeft,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                              HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockLeft,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                            }
                         }
                      }
@@ -2862,7 +2862,7 @@ void CheMPS2::Heff::addDiagram4E(const int ikappa, double * memS, double * memHe
             if ((abs(TwoSLdown-TwoSRdown)<=TwoJ) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                int fase = phase(TwoSLdown+TwoSRdown-TwoS2);
-               const double factor = fase * sqrt((TwoSLdown+1)*(TwoSR+1.0)) * gsl_sf_coupling_6j(TwoSLdown,TwoSRdown,TwoS2,TwoSR,TwoSL,1);
+               const double factor = fase * sqrt((TwoSLdown+1)*(TwoSR+1.0)) * Wigner::wigner6j(TwoSLdown,TwoSRdown,TwoS2,TwoSR,TwoSL,1);
          
                for (int Irrep=0; Irrep < (denBK->getNumberOfIrreps()); Irrep++){
             
@@ -2886,24 +2886,24 @@ void CheMPS2::Heff::addDiagram4E(const int ikappa, double * memS, double * memHe
                            if (Irrep == denBK->gIrrep(l_gamma)){
                      
                               int size = dimRup * dimRdown;
-                              for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                              HeffPlan::clear(size, temp);
                               for (int l_delta=theindex+2; l_delta<Prob->gL(); l_delta++){
                                  if (Irrep == denBK->gIrrep(l_delta)){
                                     double * LblockRight = Lright[l_delta-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                                     double prefact = Prob->gMxElement(l_gamma,theindex,theindex,l_delta);
-                                    daxpy_(&size,&prefact,LblockRight,&inc,temp,&inc);
+                                    HeffPlan::daxpy(&size,&prefact,LblockRight,&inc,temp,&inc);
                                  }
                               }
                            
                               int memSkappa = denS->gKappa(NL+1,TwoSLdown,ILdown,0,N2,TwoS2,NR-1,TwoSRdown,IRdown);
                               double alpha = factor;
                               double beta = 0.0; //set
-                              dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
+                              HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
                            
                               alpha = 1.0;
                               beta = 1.0; //add
                               double * LblockLeft = Lleft[theindex-1-l_gamma]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                              dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockLeft,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                              HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockLeft,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                            }
                         }
                      }
@@ -2925,12 +2925,12 @@ void CheMPS2::Heff::addDiagram4E(const int ikappa, double * memS, double * memHe
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
                
                   int fase = phase(TwoSL + TwoSR + TwoJ + TwoSLdown + TwoSRdown + 1 - TwoS2);
-                  const double factor1 = fase * sqrt((TwoJ+1)*(TwoJdown+1)*(TwoSL+1)*(TwoSR+1.0)) * gsl_sf_coupling_6j(TwoSL, TwoSRdown, TwoS2, TwoJdown, 1, TwoSLdown) * gsl_sf_coupling_6j(TwoJ, 1, TwoS2, TwoSRdown, TwoSL, TwoSR);
+                  const double factor1 = fase * sqrt((TwoJ+1)*(TwoJdown+1)*(TwoSL+1)*(TwoSR+1.0)) * Wigner::wigner6j(TwoSL, TwoSRdown, TwoS2, TwoJdown, 1, TwoSLdown) * Wigner::wigner6j(TwoJ, 1, TwoS2, TwoSRdown, TwoSL, TwoSR);
                
                   double factor2 = 0.0;
                   if (TwoJ == TwoJdown){
                      fase = phase(TwoSL+TwoSRdown+TwoJ+3+2*TwoS2);
-                     factor2 = fase * sqrt((TwoSL+1)*(TwoSR+1.0)) * gsl_sf_coupling_6j(TwoSLdown, TwoSRdown, TwoJ, TwoSR, TwoSL, 1);
+                     factor2 = fase * sqrt((TwoSL+1)*(TwoSR+1.0)) * Wigner::wigner6j(TwoSLdown, TwoSRdown, TwoJ, TwoSR, TwoSL, 1);
                   }
             
                   for (int Irrep=0; Irrep < (denBK->getNumberOfIrreps()); Irrep++){
@@ -2955,24 +2955,24 @@ void CheMPS2::Heff::addDiagram4E(const int ikappa, double * memS, double * memHe
                               if (Irrep == denBK->gIrrep(l_alpha)){
                      
                                  int size = dimRup * dimRdown;
-                                 for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                                 HeffPlan::clear(size, temp);
                                  for (int l_delta=theindex+2; l_delta<Prob->gL(); l_delta++){
                                     if (Irrep == denBK->gIrrep(l_delta)){
                                        double * LblockRight = Lright[l_delta-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                                        double prefact = factor1 * Prob->gMxElement(l_alpha,theindex,theindex,l_delta);
                                        if (TwoJ == TwoJdown){ prefact += factor2 * Prob->gMxElement(l_alpha,theindex,l_delta,theindex); }
-                                       daxpy_(&size,&prefact,LblockRight,&inc,temp,&inc);
+                                       HeffPlan::daxpy(&size,&prefact,LblockRight,&inc,temp,&inc);
                                     }
                                  }
                            
                                  int memSkappa = denS->gKappa(NL-1,TwoSLdown,ILdown,1,N2,TwoJdown,NR-1,TwoSRdown,IRdown);
                                  double alpha = 1.0;
                                  double beta = 0.0; //set
-                                 dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
+                                 HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
                               
                                  beta = 1.0; //add
                                  double * LblockLeft = Lleft[theindex-1-l_alpha]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                                 dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockLeft,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                                 HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockLeft,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                               }
                            }
                         }
@@ -2992,7 +2992,7 @@ void CheMPS2::Heff::addDiagram4E(const int ikappa, double * memS, double * memHe
             if ((abs(TwoSLdown-TwoSRdown)<=TwoJ) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
                int fase = phase(TwoSL + TwoSRdown - TwoS2 + 3);
-               const double factor = fase * sqrt((TwoSL+1)*(TwoSR+1.0)) * gsl_sf_coupling_6j(TwoSLdown, TwoSRdown, TwoS2, TwoSR, TwoSL, 1);
+               const double factor = fase * sqrt((TwoSL+1)*(TwoSR+1.0)) * Wigner::wigner6j(TwoSLdown, TwoSRdown, TwoS2, TwoSR, TwoSL, 1);
                   
                for (int Irrep=0; Irrep < (denBK->getNumberOfIrreps()); Irrep++){
                
@@ -3016,24 +3016,24 @@ void CheMPS2::Heff::addDiagram4E(const int ikappa, double * memS, double * memHe
                            if (Irrep == denBK->gIrrep(l_alpha)){
                      
                               int size = dimRup * dimRdown;
-                              for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                              HeffPlan::clear(size, temp);
                               for (int l_delta=theindex+2; l_delta<Prob->gL(); l_delta++){
                                  if (Irrep == denBK->gIrrep(l_delta)){
                                     double * LblockRight = Lright[l_delta-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                                     double prefact = Prob->gMxElement(l_alpha,theindex,theindex,l_delta) - 2 * Prob->gMxElement(l_alpha,theindex,l_delta,theindex);
-                                    daxpy_(&size,&prefact,LblockRight,&inc,temp,&inc);
+                                    HeffPlan::daxpy(&size,&prefact,LblockRight,&inc,temp,&inc);
                                  }
                               }
                              
                               int memSkappa = denS->gKappa(NL-1,TwoSLdown,ILdown,2,N2,TwoS2,NR-1,TwoSRdown,IRdown);
                               double alpha = factor;
                               double beta = 0.0; //set
-                              dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
+                              HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
                               
                               alpha = 1.0;
                               beta = 1.0; //add
                               double * LblockLeft = Lleft[theindex-1-l_alpha]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                              dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockLeft,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                              HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockLeft,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                            }
                         }
                      }
@@ -3055,12 +3055,12 @@ void CheMPS2::Heff::addDiagram4E(const int ikappa, double * memS, double * memHe
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
                   int fase = phase(TwoSL + TwoSR + TwoJdown + TwoSLdown + TwoSRdown + 1 - TwoS2);
-                  const double factor1 = fase * sqrt((TwoJ+1)*(TwoJdown+1)*(TwoSLdown+1)*(TwoSRdown+1.0)) * gsl_sf_coupling_6j(TwoSLdown, TwoSR, TwoS2, TwoJ, 1, TwoSL) * gsl_sf_coupling_6j(TwoJdown, 1, TwoS2, TwoSR, TwoSLdown, TwoSRdown);
+                  const double factor1 = fase * sqrt((TwoJ+1)*(TwoJdown+1)*(TwoSLdown+1)*(TwoSRdown+1.0)) * Wigner::wigner6j(TwoSLdown, TwoSR, TwoS2, TwoJ, 1, TwoSL) * Wigner::wigner6j(TwoJdown, 1, TwoS2, TwoSR, TwoSLdown, TwoSRdown);
                   
                   double factor2 = 0.0;
                   if (TwoJ == TwoJdown){
                      fase = phase(TwoSLdown+TwoSR+TwoJ+3+2*TwoS2);
-                     factor2 = fase * sqrt((TwoSLdown+1)*(TwoSRdown+1.0)) * gsl_sf_coupling_6j(TwoSL, TwoSR, TwoJ, TwoSRdown, TwoSLdown, 1);
+                     factor2 = fase * sqrt((TwoSLdown+1)*(TwoSRdown+1.0)) * Wigner::wigner6j(TwoSL, TwoSR, TwoJ, TwoSRdown, TwoSLdown, 1);
                   }
                   
                   for (int Irrep=0; Irrep < (denBK->getNumberOfIrreps()); Irrep++){
@@ -3085,24 +3085,24 @@ void CheMPS2::Heff::addDiagram4E(const int ikappa, double * memS, double * memHe
                               if (Irrep == denBK->gIrrep(l_gamma)){
                         
                                  int size = dimRup * dimRdown;
-                                 for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                                 HeffPlan::clear(size, temp);
                                  for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                     if (Irrep == denBK->gIrrep(l_beta)){
                                        double * LblockRight = Lright[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                                        double prefact = factor1 * Prob->gMxElement(l_gamma,theindex,theindex,l_beta);
                                        if (TwoJ == TwoJdown){ prefact += factor2 * Prob->gMxElement(l_gamma,theindex,l_beta,theindex); }
-                                       daxpy_(&size,&prefact,LblockRight,&inc,temp,&inc);
+                                       HeffPlan::daxpy(&size,&prefact,LblockRight,&inc,temp,&inc);
                                     }
                                  }
                               
                                  int memSkappa = denS->gKappa(NL+1,TwoSLdown,ILdown,1,N2,TwoJdown,NR+1,TwoSRdown,IRdown);
                                  double alpha = 1.0;
                                  double beta = 0.0; //set
-                                 dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
+                                 HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
                                  
                                  beta = 1.0; //add
                                  double * LblockLeft = Lleft[theindex-1-l_gamma]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                                 dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockLeft,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                                 HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockLeft,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                               }
                            }
                         }
@@ -3122,7 +3122,7 @@ void CheMPS2::Heff::addDiagram4E(const int ikappa, double * memS, double * memHe
             if ((abs(TwoSLdown-TwoSRdown)<=TwoJ) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                int fase = phase(TwoSLdown + TwoSR - TwoS2 + 3);
-               const double factor = fase * sqrt((TwoSLdown+1)*(TwoSRdown+1.0)) * gsl_sf_coupling_6j(TwoSL, TwoSR, TwoS2, TwoSRdown, TwoSLdown, 1);
+               const double factor = fase * sqrt((TwoSLdown+1)*(TwoSRdown+1.0)) * Wigner::wigner6j(TwoSL, TwoSR, TwoS2, TwoSRdown, TwoSLdown, 1);
                   
                for (int Irrep=0; Irrep < (denBK->getNumberOfIrreps()); Irrep++){
                
@@ -3146,24 +3146,24 @@ void CheMPS2::Heff::addDiagram4E(const int ikappa, double * memS, double * memHe
                            if (Irrep == denBK->gIrrep(l_gamma)){
                      
                               int size = dimRup * dimRdown;
-                              for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                              HeffPlan::clear(size, temp);
                               for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                  if (Irrep == denBK->gIrrep(l_beta)){
                                     double * LblockRight = Lright[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                                     double prefact = Prob->gMxElement(l_gamma,theindex,theindex,l_beta) - 2 * Prob->gMxElement(l_gamma,theindex,l_beta,theindex);
-                                    daxpy_(&size,&prefact,LblockRight,&inc,temp,&inc);
+                                    HeffPlan::daxpy(&size,&prefact,LblockRight,&inc,temp,&inc);
                                  }
                               }
                              
                               int memSkappa = denS->gKappa(NL+1,TwoSLdown,ILdown,2,N2,TwoS2,NR+1,TwoSRdown,IRdown);
                               double alpha = factor;
                               double beta = 0.0; //set
-                              dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
+                              HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
                               
                               alpha = 1.0;
                               beta = 1.0; //add
                               double * LblockLeft = Lleft[theindex-1-l_gamma]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                              dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockLeft,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                              HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockLeft,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                            }
                         }
                      }
@@ -3211,14 +3211,14 @@ void CheMPS2::Heff::addDiagram4F(const int ikappa, double * memS, double * memHe
             if (dimRdown>0){
                
                int size = dimRup * dimRdown;
-               for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+               HeffPlan::clear(size, temp);
             
                int number = 0;
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
                   if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                      double alpha = Prob->gMxElement(theindex,theindex,theindex+1,l_index);
                      double * Lblock = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
-                     daxpy_(&size,&alpha,Lblock,&inc,temp,&inc);
+                     HeffPlan::daxpy(&size,&alpha,Lblock,&inc,temp,&inc);
                      number++;
                   }
                }
@@ -3232,7 +3232,7 @@ void CheMPS2::Heff::addDiagram4F(const int ikappa, double * memS, double * memHe
                      factor = phase(TwoSR+1-TwoSRdown);
                   }
                   int memSkappa = denS->gKappa(NL,TwoSL,IL,0,N2+1,TwoS2down,NR-1,TwoSRdown,IRdown);
-                  dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                  HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                }
             }
          }
@@ -3250,14 +3250,14 @@ void CheMPS2::Heff::addDiagram4F(const int ikappa, double * memS, double * memHe
             if (dimRdown>0){
                
                int size = dimRup * dimRdown;
-               for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+               HeffPlan::clear(size, temp);
             
                int number = 0;
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
                   if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                      double alpha = Prob->gMxElement(theindex,theindex,theindex+1,l_index);
                      double * Lblock = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
-                     daxpy_(&size,&alpha,Lblock,&inc,temp,&inc);
+                     HeffPlan::daxpy(&size,&alpha,Lblock,&inc,temp,&inc);
                      number++;
                   }
                }
@@ -3271,7 +3271,7 @@ void CheMPS2::Heff::addDiagram4F(const int ikappa, double * memS, double * memHe
                      factor = phase(TwoSRdown+1-TwoSR);
                   }
                   int memSkappa = denS->gKappa(NL,TwoSL,IL,2,N2-1,TwoS2down,NR+1,TwoSRdown,IRdown);
-                  dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                  HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                }
             }
          }
@@ -3294,17 +3294,17 @@ void CheMPS2::Heff::addDiagram4F(const int ikappa, double * memS, double * memHe
                if (abs(TwoSL-TwoSRdown)<=TwoJdown){
                
                   int size = dimRup * dimRdown;
-                  for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                  HeffPlan::clear(size, temp);
                   
                   double factor = 0.0;
                   double factor2 = 0.0;
                   if ((N1==1) && (N2==1)){ // 4F3A
                      int fase = phase(TwoSL+TwoSR+2);
-                     factor = fase * sqrt((TwoSR+1.0)*(TwoJ+1)) * gsl_sf_coupling_6j(TwoJ, 1, 1, TwoSRdown, TwoSR, TwoSL);
+                     factor = fase * sqrt((TwoSR+1.0)*(TwoJ+1)) * Wigner::wigner6j(TwoJ, 1, 1, TwoSRdown, TwoSR, TwoSL);
                   }
                   if ((N1==1) && (N2==2)){ // 4F3B
                      int fase = phase(TwoSL+TwoSR+3);
-                     factor = fase * sqrt((TwoSR+1.0)*(TwoJdown+1)) * gsl_sf_coupling_6j(TwoJdown, 1, 1, TwoSR, TwoSRdown, TwoSL);
+                     factor = fase * sqrt((TwoSR+1.0)*(TwoJdown+1)) * Wigner::wigner6j(TwoJdown, 1, 1, TwoSR, TwoSRdown, TwoSL);
                      factor2 = (TwoJdown==0) ? sqrt(2.0*(TwoSR+1.0)/(TwoSRdown+1.0)) : 0.0;
                   }
                   if ((N1==2) && (N2==1)){ // 4F3C
@@ -3330,7 +3330,7 @@ void CheMPS2::Heff::addDiagram4F(const int ikappa, double * memS, double * memHe
                         }
                         
                         double * Lblock = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
-                        daxpy_(&size,&prefact,Lblock,&inc,temp,&inc);
+                        HeffPlan::daxpy(&size,&prefact,Lblock,&inc,temp,&inc);
                         number++;
                      }
                   }
@@ -3339,7 +3339,7 @@ void CheMPS2::Heff::addDiagram4F(const int ikappa, double * memS, double * memHe
                
                      double alpha = 1.0;
                      int memSkappa = denS->gKappa(NL,TwoSL,IL,N1,N2-1,TwoJdown,NR-1,TwoSRdown,IRdown);
-                     dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
             
                   }
                }
@@ -3364,17 +3364,17 @@ void CheMPS2::Heff::addDiagram4F(const int ikappa, double * memS, double * memHe
                if (abs(TwoSL-TwoSRdown)<=TwoJdown){
                
                   int size = dimRup * dimRdown;
-                  for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                  HeffPlan::clear(size, temp);
                   
                   double factor = 0.0;
                   double factor2 = 0.0;
                   if ((N1==1) && (N2==0)){ // 4F3A
                      int fase = phase(TwoSL+TwoSRdown+2);
-                     factor = fase * sqrt((TwoSRdown+1.0)*(TwoJdown+1)) * gsl_sf_coupling_6j(TwoJdown, 1, 1, TwoSR, TwoSRdown, TwoSL);
+                     factor = fase * sqrt((TwoSRdown+1.0)*(TwoJdown+1)) * Wigner::wigner6j(TwoJdown, 1, 1, TwoSR, TwoSRdown, TwoSL);
                   }
                   if ((N1==1) && (N2==1)){ // 4F3B
                      int fase = phase(TwoSL+TwoSRdown+3);
-                     factor = fase * sqrt((TwoSRdown+1.0)*(TwoJ+1)) * gsl_sf_coupling_6j(TwoJ, 1, 1, TwoSRdown, TwoSR, TwoSL);
+                     factor = fase * sqrt((TwoSRdown+1.0)*(TwoJ+1)) * Wigner::wigner6j(TwoJ, 1, 1, TwoSRdown, TwoSR, TwoSL);
                      factor2 = (TwoJ==0) ? sqrt(2.0*(TwoSRdown+1.0)/(TwoSR+1.0)) : 0.0;
                   }
                   if ((N1==2) && (N2==0)){ // 4F3C
@@ -3400,7 +3400,7 @@ void CheMPS2::Heff::addDiagram4F(const int ikappa, double * memS, double * memHe
                         }
                         
                         double * Lblock = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
-                        daxpy_(&size,&prefact,Lblock,&inc,temp,&inc);
+                        HeffPlan::daxpy(&size,&prefact,Lblock,&inc,temp,&inc);
                         number++;
                      }
                   }
@@ -3409,7 +3409,7 @@ void CheMPS2::Heff::addDiagram4F(const int ikappa, double * memS, double * memHe
                
                      double alpha = 1.0;
                      int memSkappa = denS->gKappa(NL,TwoSL,IL,N1,N2+1,TwoJdown,NR+1,TwoSRdown,IRdown);
-                     dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                     HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
             
                   }
                }
@@ -3455,14 +3455,14 @@ void CheMPS2::Heff::addDiagram4G(const int ikappa, double * memS, double * memHe
             if (dimRdown>0){
                
                int size = dimRup * dimRdown;
-               for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+               HeffPlan::clear(size, temp);
             
                int number = 0;
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
                   if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                      double alpha = Prob->gMxElement(theindex,theindex+1,theindex+1,l_index);
                      double * Lblock = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
-                     daxpy_(&size,&alpha,Lblock,&inc,temp,&inc);
+                     HeffPlan::daxpy(&size,&alpha,Lblock,&inc,temp,&inc);
                      number++;
                   }
                }
@@ -3476,7 +3476,7 @@ void CheMPS2::Heff::addDiagram4G(const int ikappa, double * memS, double * memHe
                      factor = phase(TwoSR+1-TwoSRdown);
                   }
                   int memSkappa = denS->gKappa(NL,TwoSL,IL,N1+1,0,TwoS1down,NR-1,TwoSRdown,IRdown);
-                  dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                  HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                }
             }
          }
@@ -3494,14 +3494,14 @@ void CheMPS2::Heff::addDiagram4G(const int ikappa, double * memS, double * memHe
             if (dimRdown>0){
                
                int size = dimRup * dimRdown;
-               for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+               HeffPlan::clear(size, temp);
             
                int number = 0;
                for (int l_index=theindex+2; l_index<Prob->gL(); l_index++){
                   if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                      double alpha = Prob->gMxElement(theindex,theindex+1,theindex+1,l_index);
                      double * Lblock = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
-                     daxpy_(&size,&alpha,Lblock,&inc,temp,&inc);
+                     HeffPlan::daxpy(&size,&alpha,Lblock,&inc,temp,&inc);
                      number++;
                   }
                }
@@ -3515,7 +3515,7 @@ void CheMPS2::Heff::addDiagram4G(const int ikappa, double * memS, double * memHe
                      factor = phase(TwoSRdown+1-TwoSR);
                   }
                   int memSkappa = denS->gKappa(NL,TwoSL,IL,N1-1,2,TwoS1down,NR+1,TwoSRdown,IRdown);
-                  dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                  HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                   
                }
             }
@@ -3539,17 +3539,17 @@ void CheMPS2::Heff::addDiagram4G(const int ikappa, double * memS, double * memHe
                if (abs(TwoSL-TwoSRdown)<=TwoJdown){
                
                   int size = dimRup * dimRdown;
-                  for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                  HeffPlan::clear(size, temp);
                
                   double alpha_prefact = 0.0;
                   double alpha_prefact2 = 0.0;
                   if ((N1==0) && (N2==1)){
                      int fase = phase(TwoSL + TwoSRdown + 2);
-                     alpha_prefact = fase * sqrt((TwoJdown+1)*(TwoSRdown+1.0)) * gsl_sf_coupling_6j(TwoJdown, 1, 1, TwoSR, TwoSRdown, TwoSL);
+                     alpha_prefact = fase * sqrt((TwoJdown+1)*(TwoSRdown+1.0)) * Wigner::wigner6j(TwoJdown, 1, 1, TwoSR, TwoSRdown, TwoSL);
                   }
                   if ((N1==1) && (N2==1)){
                      int fase = phase(TwoSL + TwoSRdown + TwoJ + 3);
-                     alpha_prefact = fase * sqrt((TwoJ+1)*(TwoSRdown+1.0)) * gsl_sf_coupling_6j(TwoJ, 1, 1, TwoSRdown, TwoSR, TwoSL);
+                     alpha_prefact = fase * sqrt((TwoJ+1)*(TwoSRdown+1.0)) * Wigner::wigner6j(TwoJ, 1, 1, TwoSRdown, TwoSR, TwoSL);
                      alpha_prefact2 = (TwoJ==0)? sqrt(2.0*(TwoSRdown+1.0)/(TwoSR+1.0)) : 0.0;
                   }
                   if ((N1==0) && (N2==2)){
@@ -3576,7 +3576,7 @@ void CheMPS2::Heff::addDiagram4G(const int ikappa, double * memS, double * memHe
                         }
                         
                         double * Lblock = Lright[l_index-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
-                        daxpy_(&size,&alpha,Lblock,&inc,temp,&inc);
+                        HeffPlan::daxpy(&size,&alpha,Lblock,&inc,temp,&inc);
                         number++;
                      }
                   }
@@ -3585,7 +3585,7 @@ void CheMPS2::Heff::addDiagram4G(const int ikappa, double * memS, double * memHe
                
                      double factor = 1.0;
                      int memSkappa = denS->gKappa(NL,TwoSL,IL,N1+1,N2,TwoJdown,NR+1,TwoSRdown,IRdown);
-                     dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                     HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
                   }
                }
             }
@@ -3609,17 +3609,17 @@ void CheMPS2::Heff::addDiagram4G(const int ikappa, double * memS, double * memHe
                if (abs(TwoSL-TwoSRdown)<=TwoJdown){
             
                   int size = dimRup * dimRdown;
-                  for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                  HeffPlan::clear(size, temp);
                
                   double alpha_prefact = 0.0;
                   double alpha_prefact2 = 0.0;
                   if ((N1==1) && (N2==1)){
                      int fase = phase(TwoSL + TwoSR + 2);
-                     alpha_prefact = fase * sqrt((TwoJ+1)*(TwoSR+1.0)) * gsl_sf_coupling_6j(TwoJ, 1, 1, TwoSRdown, TwoSR, TwoSL);
+                     alpha_prefact = fase * sqrt((TwoJ+1)*(TwoSR+1.0)) * Wigner::wigner6j(TwoJ, 1, 1, TwoSRdown, TwoSR, TwoSL);
                   }
                   if ((N1==2) && (N2==1)){
                      int fase = phase(TwoSL + TwoSR + TwoJdown + 3);
-                     alpha_prefact = fase * sqrt((TwoJdown+1)*(TwoSR+1.0)) * gsl_sf_coupling_6j(TwoJdown, 1, 1, TwoSR, TwoSRdown, TwoSL);
+                     alpha_prefact = fase * sqrt((TwoJdown+1)*(TwoSR+1.0)) * Wigner::wigner6j(TwoJdown, 1, 1, TwoSR, TwoSRdown, TwoSL);
                      alpha_prefact2 = (TwoJdown==0) ? sqrt(2.0*(TwoSR+1.0)/(TwoSRdown+1.0)) : 0.0;
                   }
                   if ((N1==1) && (N2==2)){
@@ -3646,7 +3646,7 @@ void CheMPS2::Heff::addDiagram4G(const int ikappa, double * memS, double * memHe
                         }
                         
                         double * Lblock = Lright[l_index-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
-                        daxpy_(&size,&alpha,Lblock,&inc,temp,&inc);
+                        HeffPlan::daxpy(&size,&alpha,Lblock,&inc,temp,&inc);
                         number++;
                      }
                   }
@@ -3655,7 +3655,7 @@ void CheMPS2::Heff::addDiagram4G(const int ikappa, double * memS, double * memHe
                
                      double factor = 1.0;
                      int memSkappa = denS->gKappa(NL,TwoSL,IL,N1-1,N2,TwoJdown,NR-1,TwoSRdown,IRdown);
-                     dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&factor,memS+denS->gKappa2index(memSkappa),&dimL,temp,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimL);
             
                   }
                }
@@ -3696,7 +3696,7 @@ void CheMPS2::Heff::addDiagram4H(const int ikappa, double * memS, double * memHe
             if ((abs(TwoSLdown-TwoSRdown)<=TwoJ) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
                int fase = phase(TwoSLdown + TwoSRdown - TwoS1);
-               const double factor = fase * sqrt((TwoSLdown+1)*(TwoSR+1.0)) * gsl_sf_coupling_6j(TwoSL, TwoSR, TwoS1, TwoSRdown, TwoSLdown, 1);
+               const double factor = fase * sqrt((TwoSLdown+1)*(TwoSR+1.0)) * Wigner::wigner6j(TwoSL, TwoSR, TwoS1, TwoSRdown, TwoSLdown, 1);
                   
                for (int Irrep=0; Irrep < (denBK->getNumberOfIrreps()); Irrep++){
                
@@ -3720,14 +3720,14 @@ void CheMPS2::Heff::addDiagram4H(const int ikappa, double * memS, double * memHe
                            if (Irrep == denBK->gIrrep(l_gamma)){
                               
                               int size = dimRup * dimRdown;
-                              for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                              HeffPlan::clear(size, temp);
                               
                               for (int l_delta=theindex+2; l_delta<Prob->gL(); l_delta++){
                                  if (Irrep == denBK->gIrrep(l_delta)){
                                     double fact = factor * Prob->gMxElement(l_gamma,theindex+1,theindex+1,l_delta);
                                     double * LblockR = Lright[l_delta-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                                     int inc = 1;
-                                    daxpy_(&size,&fact,LblockR,&inc,temp,&inc);
+                                    HeffPlan::daxpy(&size,&fact,LblockR,&inc,temp,&inc);
                                  }
                               }
                               
@@ -3736,10 +3736,10 @@ void CheMPS2::Heff::addDiagram4H(const int ikappa, double * memS, double * memHe
                               double * LblockL = Lleft[theindex-1-l_gamma]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                               
                               int memSkappa = denS->gKappa(NL+1,TwoSLdown,ILdown,N1,0,TwoS1,NR-1,TwoSRdown,IRdown);
-                              dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta, temp2,&dimLdown);
+                              HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta, temp2,&dimLdown);
                               
                               beta = 1.0; //add
-                              dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                              HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                               
                            }
                         }
@@ -3759,7 +3759,7 @@ void CheMPS2::Heff::addDiagram4H(const int ikappa, double * memS, double * memHe
             if ((abs(TwoSLdown-TwoSRdown)<=TwoJ) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                int fase = phase(TwoSL + TwoSR - TwoS1);
-               const double factor = fase * sqrt((TwoSL+1)*(TwoSRdown+1.0)) * gsl_sf_coupling_6j(TwoSLdown, TwoSRdown, TwoS1, TwoSR, TwoSL, 1);
+               const double factor = fase * sqrt((TwoSL+1)*(TwoSRdown+1.0)) * Wigner::wigner6j(TwoSLdown, TwoSRdown, TwoS1, TwoSR, TwoSL, 1);
                   
                for (int Irrep=0; Irrep < (denBK->getNumberOfIrreps()); Irrep++){
                
@@ -3783,14 +3783,14 @@ void CheMPS2::Heff::addDiagram4H(const int ikappa, double * memS, double * memHe
                            if (Irrep == denBK->gIrrep(l_alpha)){
                               
                               int size = dimRup * dimRdown;
-                              for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                              HeffPlan::clear(size, temp);
                               
                               for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                  if (Irrep == denBK->gIrrep(l_beta)){
                                     double fact = factor * Prob->gMxElement(l_alpha,theindex+1,theindex+1,l_beta);
                                     double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                                     int inc = 1;
-                                    daxpy_(&size,&fact,LblockR,&inc,temp,&inc);
+                                    HeffPlan::daxpy(&size,&fact,LblockR,&inc,temp,&inc);
                                  }
                               }
                               
@@ -3799,10 +3799,10 @@ void CheMPS2::Heff::addDiagram4H(const int ikappa, double * memS, double * memHe
                               double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                               
                               int memSkappa = denS->gKappa(NL-1,TwoSLdown,ILdown,N1,2,TwoS1,NR+1,TwoSRdown,IRdown);
-                              dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta, temp2,&dimLdown);
+                              HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta, temp2,&dimLdown);
                               
                               beta = 1.0; //add
-                              dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                              HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                               
                            }
                         }
@@ -3825,12 +3825,12 @@ void CheMPS2::Heff::addDiagram4H(const int ikappa, double * memS, double * memHe
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
                   int fase = phase(TwoSL+TwoSR+TwoSLdown+TwoSRdown+TwoJdown+1-TwoS1);
-                  const double factor1 = fase * sqrt((TwoJ+1)*(TwoJdown+1)*(TwoSL+1)*(TwoSR+1.0)) * gsl_sf_coupling_6j(TwoSL, TwoSRdown, TwoS1, TwoJdown, 1, TwoSLdown) * gsl_sf_coupling_6j(TwoJ, 1, TwoS1, TwoSRdown, TwoSL, TwoSR);
+                  const double factor1 = fase * sqrt((TwoJ+1)*(TwoJdown+1)*(TwoSL+1)*(TwoSR+1.0)) * Wigner::wigner6j(TwoSL, TwoSRdown, TwoS1, TwoJdown, 1, TwoSLdown) * Wigner::wigner6j(TwoJ, 1, TwoS1, TwoSRdown, TwoSL, TwoSR);
                   
                   double factor2 = 0.0;
                   if (TwoJ == TwoJdown){
                      fase = phase(TwoSL+TwoSRdown+TwoJ+3+2*TwoS1);
-                     factor2 = fase * sqrt((TwoSL+1)*(TwoSR+1.0)) * gsl_sf_coupling_6j(TwoSLdown, TwoSRdown, TwoJ, TwoSR, TwoSL, 1);
+                     factor2 = fase * sqrt((TwoSL+1)*(TwoSR+1.0)) * Wigner::wigner6j(TwoSLdown, TwoSRdown, TwoJ, TwoSR, TwoSL, 1);
                   }
                   
                   for (int Irrep=0; Irrep < (denBK->getNumberOfIrreps()); Irrep++){
@@ -3855,7 +3855,7 @@ void CheMPS2::Heff::addDiagram4H(const int ikappa, double * memS, double * memHe
                               if (Irrep == denBK->gIrrep(l_alpha)){
                               
                                  int size = dimRup * dimRdown;
-                                 for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                                 HeffPlan::clear(size, temp);
                               
                                  for (int l_delta=theindex+2; l_delta<Prob->gL(); l_delta++){
                                     if (Irrep == denBK->gIrrep(l_delta)){
@@ -3863,7 +3863,7 @@ void CheMPS2::Heff::addDiagram4H(const int ikappa, double * memS, double * memHe
                                        if (TwoJ==TwoJdown){ fact += factor2 * Prob->gMxElement(l_alpha,theindex+1,l_delta,theindex+1); }
                                        double * LblockR = Lright[l_delta-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                                        int inc = 1;
-                                       daxpy_(&size,&fact,LblockR,&inc,temp,&inc);
+                                       HeffPlan::daxpy(&size,&fact,LblockR,&inc,temp,&inc);
                                     }
                                  }
                               
@@ -3872,10 +3872,10 @@ void CheMPS2::Heff::addDiagram4H(const int ikappa, double * memS, double * memHe
                                  double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                               
                                  int memSkappa = denS->gKappa(NL-1,TwoSLdown,ILdown,N1,1,TwoJdown,NR-1,TwoSRdown,IRdown);
-                                 dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta, temp2,&dimLdown);
+                                 HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta, temp2,&dimLdown);
                               
                                  beta = 1.0; //add
-                                 dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                                 HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                               
                               }
                            }
@@ -3896,7 +3896,7 @@ void CheMPS2::Heff::addDiagram4H(const int ikappa, double * memS, double * memHe
             if ((abs(TwoSLdown-TwoSRdown)<=TwoJ) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                int fase = phase(TwoSL+TwoSRdown+3-TwoS1);
-               const double factor = fase * sqrt((TwoSL+1)*(TwoSR+1.0)) * gsl_sf_coupling_6j(TwoSLdown, TwoSRdown, TwoS1, TwoSR, TwoSL, 1);
+               const double factor = fase * sqrt((TwoSL+1)*(TwoSR+1.0)) * Wigner::wigner6j(TwoSLdown, TwoSRdown, TwoS1, TwoSR, TwoSL, 1);
                   
                for (int Irrep=0; Irrep < (denBK->getNumberOfIrreps()); Irrep++){
                
@@ -3920,14 +3920,14 @@ void CheMPS2::Heff::addDiagram4H(const int ikappa, double * memS, double * memHe
                            if (Irrep == denBK->gIrrep(l_alpha)){
                               
                               int size = dimRup * dimRdown;
-                              for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                              HeffPlan::clear(size, temp);
                               
                               for (int l_delta=theindex+2; l_delta<Prob->gL(); l_delta++){
                                  if (Irrep == denBK->gIrrep(l_delta)){
                                     double fact = factor * ( Prob->gMxElement(l_alpha,theindex+1,theindex+1,l_delta) - 2 * Prob->gMxElement(l_alpha,theindex+1,l_delta,theindex+1) );
                                     double * LblockR = Lright[l_delta-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
                                     int inc = 1;
-                                    daxpy_(&size,&fact,LblockR,&inc,temp,&inc);
+                                    HeffPlan::daxpy(&size,&fact,LblockR,&inc,temp,&inc);
                                  }
                               }
                               
@@ -3936,10 +3936,10 @@ void CheMPS2::Heff::addDiagram4H(const int ikappa, double * memS, double * memHe
                               double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                               
                               int memSkappa = denS->gKappa(NL-1,TwoSLdown,ILdown,N1,2,TwoS1,NR-1,TwoSRdown,IRdown);
-                              dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta, temp2,&dimLdown);
+                              HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta, temp2,&dimLdown);
                               
                               beta = 1.0; //add
-                              dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                              HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                               
                            }
                         }
@@ -3962,12 +3962,12 @@ void CheMPS2::Heff::addDiagram4H(const int ikappa, double * memS, double * memHe
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
                
                   int fase = phase(TwoSL+TwoSR+TwoSLdown+TwoSRdown+TwoJ+1-TwoS1);
-                  const double factor1 = fase * sqrt((TwoJ+1)*(TwoJdown+1)*(TwoSLdown+1)*(TwoSRdown+1.0)) * gsl_sf_coupling_6j(TwoSLdown, TwoSR, TwoS1, TwoJ, 1, TwoSL) * gsl_sf_coupling_6j(TwoJdown, 1, TwoS1, TwoSR, TwoSLdown, TwoSRdown);
+                  const double factor1 = fase * sqrt((TwoJ+1)*(TwoJdown+1)*(TwoSLdown+1)*(TwoSRdown+1.0)) * Wigner::wigner6j(TwoSLdown, TwoSR, TwoS1, TwoJ, 1, TwoSL) * Wigner::wigner6j(TwoJdown, 1, TwoS1, TwoSR, TwoSLdown, TwoSRdown);
                   
                   double factor2 = 0.0;
                   if (TwoJ == TwoJdown){
                      fase = phase(TwoSLdown+TwoSR+TwoJ+3+2*TwoS1);
-                     factor2 = fase * sqrt((TwoSLdown+1)*(TwoSRdown+1.0)) * gsl_sf_coupling_6j(TwoSL, TwoSR, TwoJ, TwoSRdown, TwoSLdown, 1);
+                     factor2 = fase * sqrt((TwoSLdown+1)*(TwoSRdown+1.0)) * Wigner::wigner6j(TwoSL, TwoSR, TwoJ, TwoSRdown, TwoSLdown, 1);
                   }
                   
                   for (int Irrep=0; Irrep < (denBK->getNumberOfIrreps()); Irrep++){
@@ -3992,7 +3992,7 @@ void CheMPS2::Heff::addDiagram4H(const int ikappa, double * memS, double * memHe
                               if (Irrep == denBK->gIrrep(l_gamma)){
                               
                                  int size = dimRup * dimRdown;
-                                 for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                                 HeffPlan::clear(size, temp);
                               
                                  for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                     if (Irrep == denBK->gIrrep(l_beta)){
@@ -4000,7 +4000,7 @@ void CheMPS2::Heff::addDiagram4H(const int ikappa, double * memS, double * memHe
                                        if (TwoJ==TwoJdown){ fact += factor2 * Prob->gMxElement(l_gamma,theindex+1,l_beta,theindex+1); }
                                        double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                                        int inc = 1;
-                                       daxpy_(&size,&fact,LblockR,&inc,temp,&inc);
+                                       HeffPlan::daxpy(&size,&fact,LblockR,&inc,temp,&inc);
                                     }
                                  }
                               
@@ -4009,10 +4009,10 @@ void CheMPS2::Heff::addDiagram4H(const int ikappa, double * memS, double * memHe
                                  double * LblockL = Lleft[theindex-1-l_gamma]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                               
                                  int memSkappa = denS->gKappa(NL+1,TwoSLdown,ILdown,N1,1,TwoJdown,NR+1,TwoSRdown,IRdown);
-                                 dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta, temp2,&dimLdown);
+                                 HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta, temp2,&dimLdown);
                               
                                  beta = 1.0; //add
-                                 dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                                 HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                               
                               }
                            }
@@ -4033,7 +4033,7 @@ void CheMPS2::Heff::addDiagram4H(const int ikappa, double * memS, double * memHe
             if ((abs(TwoSLdown-TwoSRdown)<=TwoJ) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                int fase = phase(TwoSLdown+TwoSR+3-TwoS1);
-               const double factor = fase * sqrt((TwoSLdown+1)*(TwoSRdown+1.0)) * gsl_sf_coupling_6j(TwoSL, TwoSR, TwoS1, TwoSRdown, TwoSLdown, 1);
+               const double factor = fase * sqrt((TwoSLdown+1)*(TwoSRdown+1.0)) * Wigner::wigner6j(TwoSL, TwoSR, TwoS1, TwoSRdown, TwoSLdown, 1);
                   
                for (int Irrep=0; Irrep < (denBK->getNumberOfIrreps()); Irrep++){
                
@@ -4057,14 +4057,14 @@ void CheMPS2::Heff::addDiagram4H(const int ikappa, double * memS, double * memHe
                            if (Irrep == denBK->gIrrep(l_gamma)){
                               
                               int size = dimRup * dimRdown;
-                              for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                              HeffPlan::clear(size, temp);
                               
                               for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                  if (Irrep == denBK->gIrrep(l_beta)){
                                     double fact = factor * ( Prob->gMxElement(l_gamma,theindex+1,theindex+1,l_beta) - 2 * Prob->gMxElement(l_gamma,theindex+1,l_beta,theindex+1) );
                                     double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
                                     int inc = 1;
-                                    daxpy_(&size,&fact,LblockR,&inc,temp,&inc);
+                                    HeffPlan::daxpy(&size,&fact,LblockR,&inc,temp,&inc);
                                  }
                               }
                               
@@ -4073,10 +4073,10 @@ void CheMPS2::Heff::addDiagram4H(const int ikappa, double * memS, double * memHe
                               double * LblockL = Lleft[theindex-1-l_gamma]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                               
                               int memSkappa = denS->gKappa(NL+1,TwoSLdown,ILdown,N1,2,TwoS1,NR+1,TwoSRdown,IRdown);
-                              dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta, temp2,&dimLdown);
+                              HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta, temp2,&dimLdown);
                               
                               beta = 1.0; //add
-                              dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                              HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                               
                            }
                         }
@@ -4125,7 +4125,7 @@ void CheMPS2::Heff::addDiagram4I(const int ikappa, double * memS, double * memHe
             if (dimLdown>0){
                
                int size = dimLdown * dimLup;
-               for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+               HeffPlan::clear(size, temp);
                
                int number = 0;
                for (int l_index=0; l_index<theindex; l_index++){
@@ -4133,7 +4133,7 @@ void CheMPS2::Heff::addDiagram4I(const int ikappa, double * memS, double * memHe
                      number++;
                      double alpha = Prob->gMxElement(l_index,theindex,theindex+1,theindex+1);
                      double * Lblock = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                     daxpy_(&size,&alpha,Lblock,&inc,temp,&inc);
+                     HeffPlan::daxpy(&size,&alpha,Lblock,&inc,temp,&inc);
                   }
                }
                
@@ -4145,7 +4145,7 @@ void CheMPS2::Heff::addDiagram4I(const int ikappa, double * memS, double * memHe
                      factor = fase * sqrt((TwoSL+1.0)/(TwoSR+1.0));
                   }
                   int memSkappa = denS->gKappa(NL-1, TwoSLdown, ILdown, N1-1, 2, TwoJdown, NR, TwoSR, IR);
-                  dgemm_(&trans, &notrans, &dimLup, &dimR, &dimLdown, &factor, temp, &dimLdown, memS+denS->gKappa2index(memSkappa), &dimLdown, &beta, memHeff+denS->gKappa2index(ikappa), &dimLup);
+                  HeffPlan::dgemm(&trans, &notrans, &dimLup, &dimR, &dimLdown, &factor, temp, &dimLdown, memS+denS->gKappa2index(memSkappa), &dimLdown, &beta, memHeff+denS->gKappa2index(ikappa), &dimLup);
                }
             }
          }
@@ -4163,7 +4163,7 @@ void CheMPS2::Heff::addDiagram4I(const int ikappa, double * memS, double * memHe
             if (dimLdown>0){
                
                int size = dimLdown * dimLup;
-               for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+               HeffPlan::clear(size, temp);
                
                int number = 0;
                for (int l_index=0; l_index<theindex; l_index++){
@@ -4171,7 +4171,7 @@ void CheMPS2::Heff::addDiagram4I(const int ikappa, double * memS, double * memHe
                      number++;
                      double alpha = Prob->gMxElement(l_index,theindex,theindex+1,theindex+1);
                      double * Lblock = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                     daxpy_(&size,&alpha,Lblock,&inc,temp,&inc);
+                     HeffPlan::daxpy(&size,&alpha,Lblock,&inc,temp,&inc);
                   }
                }
                
@@ -4183,7 +4183,7 @@ void CheMPS2::Heff::addDiagram4I(const int ikappa, double * memS, double * memHe
                      factor = fase * sqrt((TwoSLdown+1.0)/(TwoSR+1.0));
                   }
                   int memSkappa = denS->gKappa(NL+1, TwoSLdown, ILdown, N1+1, 0, TwoJdown, NR, TwoSR, IR);
-                  dgemm_(&notrans, &notrans, &dimLup, &dimR, &dimLdown, &factor, temp, &dimLup, memS+denS->gKappa2index(memSkappa), &dimLdown, &beta, memHeff+denS->gKappa2index(ikappa), &dimLup);
+                  HeffPlan::dgemm(&notrans, &notrans, &dimLup, &dimR, &dimLdown, &factor, temp, &dimLup, memS+denS->gKappa2index(memSkappa), &dimLdown, &beta, memHeff+denS->gKappa2index(ikappa), &dimLup);
                }
             }
          }
@@ -4206,16 +4206,16 @@ void CheMPS2::Heff::addDiagram4I(const int ikappa, double * memS, double * memHe
                if (abs(TwoSLdown-TwoSR)<=TwoJdown){
             
                   int size = dimLdown * dimLup;
-                  for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                  HeffPlan::clear(size, temp);
                   
                   double prefact = 0.0;
                   if ((N1==0)&&(N2==1)){
                      int fase = phase(TwoSLdown+TwoSR+2);
-                     prefact = fase * sqrt((TwoSL+1.0)*(TwoJdown+1)) * gsl_sf_coupling_6j(TwoJdown,1,1,TwoSL,TwoSLdown,TwoSR);
+                     prefact = fase * sqrt((TwoSL+1.0)*(TwoJdown+1)) * Wigner::wigner6j(TwoJdown,1,1,TwoSL,TwoSLdown,TwoSR);
                   }
                   if ((N1==1)&&(N2==1)){
                      int fase = phase(TwoSLdown+TwoSR+3);
-                     prefact = fase * sqrt((TwoJ+1)*(TwoSL+1.0)) * gsl_sf_coupling_6j(TwoJ, 1, 1, TwoSLdown, TwoSL, TwoSR);
+                     prefact = fase * sqrt((TwoJ+1)*(TwoSL+1.0)) * Wigner::wigner6j(TwoJ, 1, 1, TwoSLdown, TwoSL, TwoSR);
                   }
                   if ((N1==0)&&(N2==2)){
                      prefact = 1.0;
@@ -4242,7 +4242,7 @@ void CheMPS2::Heff::addDiagram4I(const int ikappa, double * memS, double * memHe
                         }
                         
                         double * Lblock = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                        daxpy_(&size,&alpha,Lblock,&inc,temp,&inc);
+                        HeffPlan::daxpy(&size,&alpha,Lblock,&inc,temp,&inc);
                      }
                   }
                
@@ -4250,7 +4250,7 @@ void CheMPS2::Heff::addDiagram4I(const int ikappa, double * memS, double * memHe
       
                      double factor = 1.0;
                      int memSkappa = denS->gKappa(NL-1, TwoSLdown, ILdown, N1+1, N2, TwoJdown, NR, TwoSR, IR);
-                     dgemm_(&trans, &notrans, &dimLup, &dimR, &dimLdown, &factor, temp, &dimLdown, memS+denS->gKappa2index(memSkappa), &dimLdown, &beta, memHeff+denS->gKappa2index(ikappa), &dimLup);
+                     HeffPlan::dgemm(&trans, &notrans, &dimLup, &dimR, &dimLdown, &factor, temp, &dimLdown, memS+denS->gKappa2index(memSkappa), &dimLdown, &beta, memHeff+denS->gKappa2index(ikappa), &dimLup);
                   }
                }   
             }
@@ -4274,16 +4274,16 @@ void CheMPS2::Heff::addDiagram4I(const int ikappa, double * memS, double * memHe
                if (abs(TwoSLdown-TwoSR)<=TwoJdown){
                
                   int size = dimLdown * dimLup;
-                  for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                  HeffPlan::clear(size, temp);
                   
                   double prefact = 0.0;
                   if ((N1==1)&&(N2==1)){
                      int fase = phase(TwoSL+TwoSR+2);
-                     prefact = fase * sqrt((TwoSLdown+1.0)*(TwoJ+1)) * gsl_sf_coupling_6j(TwoJ,1,1,TwoSLdown,TwoSL,TwoSR);
+                     prefact = fase * sqrt((TwoSLdown+1.0)*(TwoJ+1)) * Wigner::wigner6j(TwoJ,1,1,TwoSLdown,TwoSL,TwoSR);
                   }
                   if ((N1==2)&&(N2==1)){
                      int fase = phase(TwoSL+TwoSR+3);
-                     prefact = fase * sqrt((TwoJdown+1)*(TwoSLdown+1.0)) * gsl_sf_coupling_6j(TwoJdown, 1, 1, TwoSL, TwoSLdown, TwoSR);
+                     prefact = fase * sqrt((TwoJdown+1)*(TwoSLdown+1.0)) * Wigner::wigner6j(TwoJdown, 1, 1, TwoSL, TwoSLdown, TwoSR);
                   }
                   if ((N1==1)&&(N2==2)){
                      prefact = 1.0;
@@ -4310,7 +4310,7 @@ void CheMPS2::Heff::addDiagram4I(const int ikappa, double * memS, double * memHe
                         }
                         
                         double * Lblock = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                        daxpy_(&size,&alpha,Lblock,&inc,temp,&inc);
+                        HeffPlan::daxpy(&size,&alpha,Lblock,&inc,temp,&inc);
                      }
                   }
                
@@ -4318,7 +4318,7 @@ void CheMPS2::Heff::addDiagram4I(const int ikappa, double * memS, double * memHe
       
                      double factor = 1.0;
                      int memSkappa = denS->gKappa(NL+1, TwoSLdown, ILdown, N1-1, N2, TwoJdown, NR, TwoSR, IR);
-                     dgemm_(&notrans, &notrans, &dimLup, &dimR, &dimLdown, &factor, temp, &dimLup, memS+denS->gKappa2index(memSkappa), &dimLdown, &beta, memHeff+denS->gKappa2index(ikappa), &dimLup);
+                     HeffPlan::dgemm(&notrans, &notrans, &dimLup, &dimR, &dimLdown, &factor, temp, &dimLup, memS+denS->gKappa2index(memSkappa), &dimLdown, &beta, memHeff+denS->gKappa2index(ikappa), &dimLup);
                   }
                }   
             }
@@ -4360,7 +4360,7 @@ void CheMPS2::Heff::addDiagram4J1and4J2spin0(const int ikappa, double * memS, do
          double alpha = 1.0;
          double beta = 1.0;
          double * Ablock = Aright->gStorage(NR,TwoSR,IR,NR+2,TwoSR,IRdown);
-         dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Ablock,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+         HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Ablock,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
       }
    }
@@ -4375,7 +4375,7 @@ void CheMPS2::Heff::addDiagram4J1and4J2spin0(const int ikappa, double * memS, do
          double alpha = - sqrt(0.5);
          double beta = 1.0;
          double * Ablock = Aright->gStorage(NR,TwoSR,IR,NR+2,TwoSR,IRdown);
-         dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Ablock,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+         HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Ablock,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
       }
    }
@@ -4390,7 +4390,7 @@ void CheMPS2::Heff::addDiagram4J1and4J2spin0(const int ikappa, double * memS, do
          double alpha = - sqrt(0.5);
          double beta = 1.0;
          double * Ablock = Aright->gStorage(NR,TwoSR,IR,NR+2,TwoSR,IRdown);
-         dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Ablock,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+         HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Ablock,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
       }
    }
@@ -4405,7 +4405,7 @@ void CheMPS2::Heff::addDiagram4J1and4J2spin0(const int ikappa, double * memS, do
          double alpha = -1.0;
          double beta = 1.0;
          double * Ablock = Aright->gStorage(NR,TwoSR,IR,NR+2,TwoSR,IRdown);
-         dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Ablock,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+         HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Ablock,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
       }
       
@@ -4416,7 +4416,7 @@ void CheMPS2::Heff::addDiagram4J1and4J2spin0(const int ikappa, double * memS, do
          double alpha = 1.0;
          double beta = 1.0;
          double * Ablock = Aright->gStorage(NR-2,TwoSR,IRdown,NR,TwoSR,IR);
-         dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Ablock,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+         HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Ablock,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
       }
    }
@@ -4431,7 +4431,7 @@ void CheMPS2::Heff::addDiagram4J1and4J2spin0(const int ikappa, double * memS, do
          double alpha = - sqrt(0.5);
          double beta = 1.0;
          double * Ablock = Aright->gStorage(NR-2,TwoSR,IRdown,NR,TwoSR,IR);
-         dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Ablock,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+         HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Ablock,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
       }
    }
@@ -4446,7 +4446,7 @@ void CheMPS2::Heff::addDiagram4J1and4J2spin0(const int ikappa, double * memS, do
          double alpha = - sqrt(0.5);
          double beta = 1.0;
          double * Ablock = Aright->gStorage(NR-2,TwoSR,IRdown,NR,TwoSR,IR);
-         dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Ablock,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+         HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Ablock,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
       }
    }
@@ -4461,7 +4461,7 @@ void CheMPS2::Heff::addDiagram4J1and4J2spin0(const int ikappa, double * memS, do
          double alpha = -1.0;
          double beta = 1.0;
          double * Ablock = Aright->gStorage(NR-2,TwoSR,IRdown,NR,TwoSR,IR);
-         dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Ablock,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+         HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Ablock,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
       }
    }
@@ -4502,7 +4502,7 @@ void CheMPS2::Heff::addDiagram4J1and4J2spin1(const int ikappa, double * memS, do
             double alpha = sqrt((TwoSRdown+1.0)/(TwoSR+1.0));
             double beta = 1.0;
             double * Bblock = Bright->gStorage(NR,TwoSR,IR,NR+2,TwoSRdown,IRdown);
-            dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Bblock,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+            HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Bblock,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
          
          }
       }
@@ -4519,10 +4519,10 @@ void CheMPS2::Heff::addDiagram4J1and4J2spin1(const int ikappa, double * memS, do
          
                int memSkappa = denS->gKappa(NL,TwoSL,IL,2,1,1,NR+2,TwoSRdown,IRdown);
                int fase = phase(TwoSL+TwoSRdown+3);
-               double alpha = fase * sqrt(3.0 * (TwoSRdown+1)) * gsl_sf_coupling_6j(1,1,2,TwoSR,TwoSRdown,TwoSL);
+               double alpha = fase * sqrt(3.0 * (TwoSRdown+1)) * Wigner::wigner6j(1,1,2,TwoSR,TwoSRdown,TwoSL);
                double beta = 1.0;
                double * Bblock = Bright->gStorage(NR,TwoSR,IR,NR+2,TwoSRdown,IRdown);
-               dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Bblock,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+               HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Bblock,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
             }
          }
       }
@@ -4539,10 +4539,10 @@ void CheMPS2::Heff::addDiagram4J1and4J2spin1(const int ikappa, double * memS, do
          
                int memSkappa = denS->gKappa(NL,TwoSL,IL,1,2,1,NR+2,TwoSRdown,IRdown);
                int fase = phase(TwoSL+TwoSRdown+1);
-               double alpha = fase * sqrt(3.0 * (TwoSRdown+1)) * gsl_sf_coupling_6j(1,1,2,TwoSR,TwoSRdown,TwoSL);
+               double alpha = fase * sqrt(3.0 * (TwoSRdown+1)) * Wigner::wigner6j(1,1,2,TwoSR,TwoSRdown,TwoSL);
                double beta = 1.0;
                double * Bblock = Bright->gStorage(NR,TwoSR,IR,NR+2,TwoSRdown,IRdown);
-               dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Bblock,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+               HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Bblock,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
             }
          }
       }
@@ -4560,7 +4560,7 @@ void CheMPS2::Heff::addDiagram4J1and4J2spin1(const int ikappa, double * memS, do
          double alpha = phase(TwoSR-TwoSRdown);
          double beta = 1.0;
          double * Bblock = Bright->gStorage(NR,TwoSR,IR,NR+2,TwoSRdown,IRdown);
-         dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Bblock,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+         HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Bblock,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
       }
 
@@ -4572,7 +4572,7 @@ void CheMPS2::Heff::addDiagram4J1and4J2spin1(const int ikappa, double * memS, do
          double alpha = sqrt((TwoSR+1.0)/(TwoSRdown+1.0));
          double beta = 1.0;
          double * Bblock = Bright->gStorage(NR-2,TwoSRdown,IRdown,NR,TwoSR,IR);
-         dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Bblock,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+         HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Bblock,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
          
       }
 
@@ -4589,10 +4589,10 @@ void CheMPS2::Heff::addDiagram4J1and4J2spin1(const int ikappa, double * memS, do
          
                int memSkappa = denS->gKappa(NL,TwoSL,IL,1,0,1,NR-2,TwoSRdown,IRdown);
                int fase = phase(TwoSL+TwoSR+3);
-               double alpha = fase * sqrt(3.0 * (TwoSR+1)) * gsl_sf_coupling_6j(1,1,2,TwoSRdown,TwoSR,TwoSL);
+               double alpha = fase * sqrt(3.0 * (TwoSR+1)) * Wigner::wigner6j(1,1,2,TwoSRdown,TwoSR,TwoSL);
                double beta = 1.0;
                double * Bblock = Bright->gStorage(NR-2,TwoSRdown,IRdown,NR,TwoSR,IR);
-               dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Bblock,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+               HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Bblock,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
             }
          }
       }
@@ -4609,10 +4609,10 @@ void CheMPS2::Heff::addDiagram4J1and4J2spin1(const int ikappa, double * memS, do
          
                int memSkappa = denS->gKappa(NL,TwoSL,IL,0,1,1,NR-2,TwoSRdown,IRdown);
                int fase = phase(TwoSL+TwoSR+1);
-               double alpha = fase * sqrt(3.0 * (TwoSR+1)) * gsl_sf_coupling_6j(1,1,2,TwoSRdown,TwoSR,TwoSL);
+               double alpha = fase * sqrt(3.0 * (TwoSR+1)) * Wigner::wigner6j(1,1,2,TwoSRdown,TwoSR,TwoSL);
                double beta = 1.0;
                double * Bblock = Bright->gStorage(NR-2,TwoSRdown,IRdown,NR,TwoSR,IR);
-               dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Bblock,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+               HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Bblock,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
             
             }
          }
@@ -4631,7 +4631,7 @@ void CheMPS2::Heff::addDiagram4J1and4J2spin1(const int ikappa, double * memS, do
             double alpha = phase(TwoSR-TwoSRdown);
             double beta = 1.0;
             double * Bblock = Bright->gStorage(NR-2,TwoSRdown,IRdown,NR,TwoSR,IR);
-            dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Bblock,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+            HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,Bblock,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
          }
       }
@@ -4676,19 +4676,19 @@ void CheMPS2::Heff::addDiagram4J3and4J4spin0(const int ikappa, double * memS, do
          if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
          
             int size = dimRup * dimRdown;
-            dcopy_(&size,ptr,&inc,temp,&inc);
+            HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
             
             for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                double fact = 2 * Prob->gMxElement(theindex,l_beta,theindex+1,l_beta) - Prob->gMxElement(theindex,theindex+1,l_beta,l_beta);
                double * F0block = F0tens[l_beta-theindex-2]->gStorage(NR,TwoSR,IRdown,NR,TwoSR,IR);
-               daxpy_(&size,&fact,F0block,&inc,temp,&inc);
+               HeffPlan::daxpy(&size,&fact,F0block,&inc,temp,&inc);
             }
             
             ptr = temp;
             
          }
          
-         dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+         HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
          
       }
    
@@ -4702,19 +4702,19 @@ void CheMPS2::Heff::addDiagram4J3and4J4spin0(const int ikappa, double * memS, do
          if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
          
             int size = dimRup * dimRdown;
-            dcopy_(&size,ptr,&inc,temp,&inc);
+            HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
             
             for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                double fact = 2 * Prob->gMxElement(theindex,l_beta,theindex+1,l_beta) - Prob->gMxElement(theindex,theindex+1,l_beta,l_beta);
                double * F0block = F0tens[l_beta-theindex-2]->gStorage(NR,TwoSR,IRdown,NR,TwoSR,IR);
-               daxpy_(&size,&fact,F0block,&inc,temp,&inc);
+               HeffPlan::daxpy(&size,&fact,F0block,&inc,temp,&inc);
             }
             
             ptr = temp;
             
          }
          
-         dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+         HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
       }
    
@@ -4728,19 +4728,19 @@ void CheMPS2::Heff::addDiagram4J3and4J4spin0(const int ikappa, double * memS, do
          if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
          
             int size = dimRup * dimRdown;
-            dcopy_(&size,ptr,&inc,temp,&inc);
+            HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
             
             for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                double fact = 2 * Prob->gMxElement(theindex,l_beta,theindex+1,l_beta) - Prob->gMxElement(theindex,theindex+1,l_beta,l_beta);
                double * F0block = F0tens[l_beta-theindex-2]->gStorage(NR,TwoSR,IRdown,NR,TwoSR,IR);
-               daxpy_(&size,&fact,F0block,&inc,temp,&inc);
+               HeffPlan::daxpy(&size,&fact,F0block,&inc,temp,&inc);
             }
             
             ptr = temp;
             
          }
          
-         dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+         HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
       }
    
@@ -4754,19 +4754,19 @@ void CheMPS2::Heff::addDiagram4J3and4J4spin0(const int ikappa, double * memS, do
          if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
          
             int size = dimRup * dimRdown;
-            dcopy_(&size,ptr,&inc,temp,&inc);
+            HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
             
             for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                double fact = 2 * Prob->gMxElement(theindex,l_beta,theindex+1,l_beta) - Prob->gMxElement(theindex,theindex+1,l_beta,l_beta);
                double * F0block = F0tens[l_beta-theindex-2]->gStorage(NR,TwoSR,IRdown,NR,TwoSR,IR);
-               daxpy_(&size,&fact,F0block,&inc,temp,&inc);
+               HeffPlan::daxpy(&size,&fact,F0block,&inc,temp,&inc);
             }
             
             ptr = temp;
             
          }
          
-         dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+         HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
       }
 
@@ -4780,19 +4780,19 @@ void CheMPS2::Heff::addDiagram4J3and4J4spin0(const int ikappa, double * memS, do
          if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
          
             int size = dimRup * dimRdown;
-            dcopy_(&size,ptr,&inc,temp,&inc);
+            HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
             
             for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                double fact = 2 * Prob->gMxElement(theindex,l_beta,theindex+1,l_beta) - Prob->gMxElement(theindex,theindex+1,l_beta,l_beta);
                double * F0block = F0tens[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSR,IRdown);
-               daxpy_(&size,&fact,F0block,&inc,temp,&inc);
+               HeffPlan::daxpy(&size,&fact,F0block,&inc,temp,&inc);
             }
             
             ptr = temp;
             
          }
          
-         dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+         HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
       }
    
@@ -4806,19 +4806,19 @@ void CheMPS2::Heff::addDiagram4J3and4J4spin0(const int ikappa, double * memS, do
          if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
          
             int size = dimRup * dimRdown;
-            dcopy_(&size,ptr,&inc,temp,&inc);
+            HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
             
             for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                double fact = 2 * Prob->gMxElement(theindex,l_beta,theindex+1,l_beta) - Prob->gMxElement(theindex,theindex+1,l_beta,l_beta);
                double * F0block = F0tens[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSR,IRdown);
-               daxpy_(&size,&fact,F0block,&inc,temp,&inc);
+               HeffPlan::daxpy(&size,&fact,F0block,&inc,temp,&inc);
             }
             
             ptr = temp;
             
          }
          
-         dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+         HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
       }
 
@@ -4832,19 +4832,19 @@ void CheMPS2::Heff::addDiagram4J3and4J4spin0(const int ikappa, double * memS, do
          if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
          
             int size = dimRup * dimRdown;
-            dcopy_(&size,ptr,&inc,temp,&inc);
+            HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
             
             for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                double fact = 2 * Prob->gMxElement(theindex,l_beta,theindex+1,l_beta) - Prob->gMxElement(theindex,theindex+1,l_beta,l_beta);
                double * F0block = F0tens[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSR,IRdown);
-               daxpy_(&size,&fact,F0block,&inc,temp,&inc);
+               HeffPlan::daxpy(&size,&fact,F0block,&inc,temp,&inc);
             }
             
             ptr = temp;
             
          }
          
-         dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+         HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
       }
    
@@ -4858,19 +4858,19 @@ void CheMPS2::Heff::addDiagram4J3and4J4spin0(const int ikappa, double * memS, do
          if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
          
             int size = dimRup * dimRdown;
-            dcopy_(&size,ptr,&inc,temp,&inc);
+            HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
             
             for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                double fact = 2 * Prob->gMxElement(theindex,l_beta,theindex+1,l_beta) - Prob->gMxElement(theindex,theindex+1,l_beta,l_beta);
                double * F0block = F0tens[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSR,IRdown);
-               daxpy_(&size,&fact,F0block,&inc,temp,&inc);
+               HeffPlan::daxpy(&size,&fact,F0block,&inc,temp,&inc);
             }
             
             ptr = temp;
             
          }
          
-         dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+         HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
       }
    
@@ -4912,25 +4912,25 @@ void CheMPS2::Heff::addDiagram4J3and4J4spin1(const int ikappa, double * memS, do
       
             int memSkappa = denS->gKappa(NL,TwoSL,IL,0,1,1,NR,TwoSRdown,IRdown);
             int fase = phase(TwoSL+TwoSRdown+3);
-            double alpha = fase * sqrt(3.0*(TwoSRdown+1)) * gsl_sf_coupling_6j(1,1,2,TwoSR,TwoSRdown,TwoSL);
+            double alpha = fase * sqrt(3.0*(TwoSRdown+1)) * Wigner::wigner6j(1,1,2,TwoSR,TwoSRdown,TwoSL);
             double beta = 1.0;
             double * ptr = Dright->gStorage(NR,TwoSRdown,IRdown,NR,TwoSR,IR);
             if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
          
                int size = dimRup * dimRdown;
-               dcopy_(&size,ptr,&inc,temp,&inc);
+               HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
             
                for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                   double fact = - Prob->gMxElement(theindex,theindex+1,l_beta,l_beta);
                   double * F1block = F1tens[l_beta-theindex-2]->gStorage(NR,TwoSRdown,IRdown,NR,TwoSR,IR);
-                  daxpy_(&size,&fact,F1block,&inc,temp,&inc);
+                  HeffPlan::daxpy(&size,&fact,F1block,&inc,temp,&inc);
                }
             
                ptr = temp;
             
             }
          
-            dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+            HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
          
          }
    
@@ -4944,19 +4944,19 @@ void CheMPS2::Heff::addDiagram4J3and4J4spin1(const int ikappa, double * memS, do
             if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
          
                int size = dimRup * dimRdown;
-               dcopy_(&size,ptr,&inc,temp,&inc);
+               HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
             
                for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                   double fact = - Prob->gMxElement(theindex,theindex+1,l_beta,l_beta);
                   double * F1block = F1tens[l_beta-theindex-2]->gStorage(NR,TwoSRdown,IRdown,NR,TwoSR,IR);
-                  daxpy_(&size,&fact,F1block,&inc,temp,&inc);
+                  HeffPlan::daxpy(&size,&fact,F1block,&inc,temp,&inc);
                }
             
                ptr = temp;
             
             }
          
-            dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+            HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
          }
    
@@ -4970,19 +4970,19 @@ void CheMPS2::Heff::addDiagram4J3and4J4spin1(const int ikappa, double * memS, do
             if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
          
                int size = dimRup * dimRdown;
-               dcopy_(&size,ptr,&inc,temp,&inc);
+               HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
             
                for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                   double fact = - Prob->gMxElement(theindex,theindex+1,l_beta,l_beta);
                   double * F1block = F1tens[l_beta-theindex-2]->gStorage(NR,TwoSRdown,IRdown,NR,TwoSR,IR);
-                  daxpy_(&size,&fact,F1block,&inc,temp,&inc);
+                  HeffPlan::daxpy(&size,&fact,F1block,&inc,temp,&inc);
                }
             
                ptr = temp;
                
             }
          
-            dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+            HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
          }
    
@@ -4991,25 +4991,25 @@ void CheMPS2::Heff::addDiagram4J3and4J4spin1(const int ikappa, double * memS, do
       
             int memSkappa = denS->gKappa(NL,TwoSL,IL,1,2,1,NR,TwoSRdown,IRdown);
             int fase = phase(TwoSL+TwoSRdown+3);
-            double alpha = fase * sqrt(3.0*(TwoSRdown+1)) * gsl_sf_coupling_6j(1,1,2,TwoSR,TwoSRdown,TwoSL);
+            double alpha = fase * sqrt(3.0*(TwoSRdown+1)) * Wigner::wigner6j(1,1,2,TwoSR,TwoSRdown,TwoSL);
             double beta = 1.0;
             double * ptr = Dright->gStorage(NR,TwoSRdown,IRdown,NR,TwoSR,IR);
             if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
          
                int size = dimRup * dimRdown;
-               dcopy_(&size,ptr,&inc,temp,&inc);
+               HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
             
                for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                   double fact = - Prob->gMxElement(theindex,theindex+1,l_beta,l_beta);
                   double * F1block = F1tens[l_beta-theindex-2]->gStorage(NR,TwoSRdown,IRdown,NR,TwoSR,IR);
-                  daxpy_(&size,&fact,F1block,&inc,temp,&inc);
+                  HeffPlan::daxpy(&size,&fact,F1block,&inc,temp,&inc);
                }
             
                ptr = temp;
             
             }
          
-            dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+            HeffPlan::dgemm(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRdown,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
          }
 
@@ -5018,25 +5018,25 @@ void CheMPS2::Heff::addDiagram4J3and4J4spin1(const int ikappa, double * memS, do
       
             int memSkappa = denS->gKappa(NL,TwoSL,IL,1,0,1,NR,TwoSRdown,IRdown);
             int fase = phase(TwoSL+TwoSR+3);
-            double alpha = fase * sqrt(3.0*(TwoSR+1)) * gsl_sf_coupling_6j(1,1,2,TwoSR,TwoSRdown,TwoSL);
+            double alpha = fase * sqrt(3.0*(TwoSR+1)) * Wigner::wigner6j(1,1,2,TwoSR,TwoSRdown,TwoSL);
             double beta = 1.0;
             double * ptr = Dright->gStorage(NR,TwoSR,IR,NR,TwoSRdown,IRdown);
             if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
          
                int size = dimRup * dimRdown;
-               dcopy_(&size,ptr,&inc,temp,&inc);
+               HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
             
                for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                   double fact = - Prob->gMxElement(theindex,theindex+1,l_beta,l_beta);
                   double * F1block = F1tens[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSRdown,IRdown);
-                  daxpy_(&size,&fact,F1block,&inc,temp,&inc);
+                  HeffPlan::daxpy(&size,&fact,F1block,&inc,temp,&inc);
                }
             
                ptr = temp;
             
             }
          
-            dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+            HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
          }
    
@@ -5050,19 +5050,19 @@ void CheMPS2::Heff::addDiagram4J3and4J4spin1(const int ikappa, double * memS, do
             if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
          
                int size = dimRup * dimRdown;
-               dcopy_(&size,ptr,&inc,temp,&inc);
+               HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
             
                for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                   double fact = - Prob->gMxElement(theindex,theindex+1,l_beta,l_beta);
                   double * F1block = F1tens[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSRdown,IRdown);
-                  daxpy_(&size,&fact,F1block,&inc,temp,&inc);
+                  HeffPlan::daxpy(&size,&fact,F1block,&inc,temp,&inc);
                }
             
                ptr = temp;
             
             }
          
-            dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+            HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
          }
 
@@ -5076,19 +5076,19 @@ void CheMPS2::Heff::addDiagram4J3and4J4spin1(const int ikappa, double * memS, do
             if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
             
                int size = dimRup * dimRdown;
-               dcopy_(&size,ptr,&inc,temp,&inc);
+               HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
             
                for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                   double fact = - Prob->gMxElement(theindex,theindex+1,l_beta,l_beta);
                   double * F1block = F1tens[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSRdown,IRdown);
-                  daxpy_(&size,&fact,F1block,&inc,temp,&inc);
+                  HeffPlan::daxpy(&size,&fact,F1block,&inc,temp,&inc);
                }
             
                ptr = temp;
             
             }
          
-            dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+            HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
          }
    
@@ -5097,25 +5097,25 @@ void CheMPS2::Heff::addDiagram4J3and4J4spin1(const int ikappa, double * memS, do
       
             int memSkappa = denS->gKappa(NL,TwoSL,IL,2,1,1,NR,TwoSRdown,IRdown);
             int fase = phase(TwoSL+TwoSR+3);
-            double alpha = fase * sqrt(3.0*(TwoSR+1)) * gsl_sf_coupling_6j(1,1,2,TwoSR,TwoSRdown,TwoSL);
+            double alpha = fase * sqrt(3.0*(TwoSR+1)) * Wigner::wigner6j(1,1,2,TwoSR,TwoSRdown,TwoSL);
             double beta = 1.0;
             double * ptr = Dright->gStorage(NR,TwoSR,IR,NR,TwoSRdown,IRdown);
             if (denBK->gIrrep(theindex) == denBK->gIrrep(theindex+1)){
          
                int size = dimRup * dimRdown;
-               dcopy_(&size,ptr,&inc,temp,&inc);
+               HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
             
                for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                   double fact = - Prob->gMxElement(theindex,theindex+1,l_beta,l_beta);
                   double * F1block = F1tens[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSRdown,IRdown);
-                  daxpy_(&size,&fact,F1block,&inc,temp,&inc);
+                  HeffPlan::daxpy(&size,&fact,F1block,&inc,temp,&inc);
                }
             
                ptr = temp;
             
             }
          
-            dgemm_(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
+            HeffPlan::dgemm(&notrans,&trans,&dimL,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimL,ptr,&dimRup,&beta,memHeff+denS->gKappa2index(ikappa), &dimL);
       
          }
       }
@@ -5152,7 +5152,7 @@ void CheMPS2::Heff::addDiagram4K1and4K2spin0(const int ikappa, double * memS, do
          if ((abs(TwoSLdown-TwoSR)<=TwoS1) && (TwoSLdown>=0)){
    
             int fase = phase(TwoSLdown + TwoSR + TwoJ + 1 + 2*TwoS1);
-            const double factor = fase * sqrt(0.5 * (TwoSL+1) * (TwoJ+1)) * gsl_sf_coupling_6j(TwoS1,TwoJ,1,TwoSL,TwoSLdown,TwoSR);
+            const double factor = fase * sqrt(0.5 * (TwoSL+1) * (TwoJ+1)) * Wigner::wigner6j(TwoS1,TwoJ,1,TwoSL,TwoSLdown,TwoSR);
          
             for (int l_index=0; l_index<theindex; l_index++){
                
@@ -5169,13 +5169,13 @@ void CheMPS2::Heff::addDiagram4K1and4K2spin0(const int ikappa, double * memS, do
                   double beta = 0.0; //set
                   double alpha = factor;
                   
-                  dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockA,&dimRdown,&beta,temp,&dimLdown);
+                  HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockA,&dimRdown,&beta,temp,&dimLdown);
                   
                   beta = 1.0; //add
                   alpha = 1.0;
                   double * blockL = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                   
-                  dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                }
             }
@@ -5192,7 +5192,7 @@ void CheMPS2::Heff::addDiagram4K1and4K2spin0(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSR)<=TwoJdown) && (TwoSLdown>=0)){
             
                int fase = phase(TwoSLdown + TwoSR + TwoJdown + 2 + 2*TwoS1);
-               const double factor = fase * sqrt(0.5 * (TwoSL+1) * (TwoJdown+1)) * gsl_sf_coupling_6j(TwoJdown,TwoS1,1,TwoSL,TwoSLdown,TwoSR);
+               const double factor = fase * sqrt(0.5 * (TwoSL+1) * (TwoJdown+1)) * Wigner::wigner6j(TwoJdown,TwoS1,1,TwoSL,TwoSLdown,TwoSR);
          
                for (int l_index=0; l_index<theindex; l_index++){
                
@@ -5209,13 +5209,13 @@ void CheMPS2::Heff::addDiagram4K1and4K2spin0(const int ikappa, double * memS, do
                      double beta = 0.0; //set
                      double alpha = factor;
                   
-                     dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockA,&dimRdown,&beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockA,&dimRdown,&beta,temp,&dimLdown);
                   
                      beta = 1.0; //add
                      alpha = 1.0;
                      double * blockL = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                   
-                     dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                      
                   }
                }
@@ -5233,7 +5233,7 @@ void CheMPS2::Heff::addDiagram4K1and4K2spin0(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSR)<=TwoJdown) && (TwoSLdown>=0)){
             
                int fase = phase(TwoSL + TwoSR + TwoJdown + 1 + 2*TwoS1);
-               const double factor = fase * sqrt(0.5 * (TwoSLdown+1) * (TwoJdown+1)) * gsl_sf_coupling_6j(TwoJdown,TwoS1,1,TwoSL,TwoSLdown,TwoSR);
+               const double factor = fase * sqrt(0.5 * (TwoSLdown+1) * (TwoJdown+1)) * Wigner::wigner6j(TwoJdown,TwoS1,1,TwoSL,TwoSLdown,TwoSR);
          
                for (int l_index=0; l_index<theindex; l_index++){
                
@@ -5250,13 +5250,13 @@ void CheMPS2::Heff::addDiagram4K1and4K2spin0(const int ikappa, double * memS, do
                      double beta = 0.0; //set
                      double alpha = factor;
                   
-                     dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockA,&dimRup,&beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockA,&dimRup,&beta,temp,&dimLdown);
                   
                      beta = 1.0; //add
                      alpha = 1.0;
                      double * blockL = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                   
-                     dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   
                   }
                }
@@ -5271,7 +5271,7 @@ void CheMPS2::Heff::addDiagram4K1and4K2spin0(const int ikappa, double * memS, do
          if ((abs(TwoSLdown-TwoSR)<=TwoS1) && (TwoSLdown>=0)){
    
             int fase = phase(TwoSL + TwoSR + TwoJ + 2 + 2*TwoS1);
-            const double factor = fase * sqrt(0.5 * (TwoSLdown+1) * (TwoJ+1)) * gsl_sf_coupling_6j(TwoJ,TwoS1,1,TwoSLdown,TwoSL,TwoSR);
+            const double factor = fase * sqrt(0.5 * (TwoSLdown+1) * (TwoJ+1)) * Wigner::wigner6j(TwoJ,TwoS1,1,TwoSLdown,TwoSL,TwoSR);
          
             for (int l_index=0; l_index<theindex; l_index++){
                
@@ -5288,13 +5288,13 @@ void CheMPS2::Heff::addDiagram4K1and4K2spin0(const int ikappa, double * memS, do
                   double beta = 0.0; //set
                   double alpha = factor;
                   
-                  dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockA,&dimRup,&beta,temp,&dimLdown);
+                  HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockA,&dimRup,&beta,temp,&dimLdown);
                   
                   beta = 1.0; //add
                   alpha = 1.0;
                   double * blockL = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                   
-                  dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                }
             }
@@ -5332,7 +5332,7 @@ void CheMPS2::Heff::addDiagram4L1and4L2spin0(const int ikappa, double * memS, do
          if ((abs(TwoSLdown-TwoSR)<=TwoS2) && (TwoSLdown>=0)){
    
             int fase = phase(TwoSLdown + TwoSR + 2 + TwoS2);
-            const double factor = fase * sqrt(0.5 * (TwoSL+1) * (TwoJ+1)) * gsl_sf_coupling_6j(TwoS2,TwoJ,1,TwoSL,TwoSLdown,TwoSR);
+            const double factor = fase * sqrt(0.5 * (TwoSL+1) * (TwoJ+1)) * Wigner::wigner6j(TwoS2,TwoJ,1,TwoSL,TwoSLdown,TwoSR);
          
             for (int l_index=0; l_index<theindex; l_index++){
                
@@ -5349,13 +5349,13 @@ void CheMPS2::Heff::addDiagram4L1and4L2spin0(const int ikappa, double * memS, do
                   double beta = 0.0; //set
                   double alpha = factor;
                   
-                  dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockA,&dimRdown,&beta,temp,&dimLdown);
+                  HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockA,&dimRdown,&beta,temp,&dimLdown);
                   
                   beta = 1.0; //add
                   alpha = 1.0;
                   double * blockL = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                   
-                  dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                }
             }
@@ -5372,7 +5372,7 @@ void CheMPS2::Heff::addDiagram4L1and4L2spin0(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSR)<=TwoJdown) && (TwoSLdown>=0)){
             
                int fase = phase(TwoSLdown + TwoSR + 3 + TwoS2);
-               const double factor = fase * sqrt(0.5 * (TwoSL+1) * (TwoJdown+1)) * gsl_sf_coupling_6j(TwoJdown,TwoS2,1,TwoSL,TwoSLdown,TwoSR);
+               const double factor = fase * sqrt(0.5 * (TwoSL+1) * (TwoJdown+1)) * Wigner::wigner6j(TwoJdown,TwoS2,1,TwoSL,TwoSLdown,TwoSR);
          
                for (int l_index=0; l_index<theindex; l_index++){
                
@@ -5389,13 +5389,13 @@ void CheMPS2::Heff::addDiagram4L1and4L2spin0(const int ikappa, double * memS, do
                      double beta = 0.0; //set
                      double alpha = factor;
                   
-                     dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockA,&dimRdown,&beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockA,&dimRdown,&beta,temp,&dimLdown);
                   
                      beta = 1.0; //add
                      alpha = 1.0;
                      double * blockL = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                   
-                     dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   
                   }
                }
@@ -5413,7 +5413,7 @@ void CheMPS2::Heff::addDiagram4L1and4L2spin0(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSR)<=TwoJdown) && (TwoSLdown>=0)){
             
                int fase = phase(TwoSL + TwoSR + 2 + TwoS2);
-               const double factor = fase * sqrt(0.5 * (TwoSLdown+1) * (TwoJdown+1)) * gsl_sf_coupling_6j(TwoJdown,TwoS2,1,TwoSL,TwoSLdown,TwoSR);
+               const double factor = fase * sqrt(0.5 * (TwoSLdown+1) * (TwoJdown+1)) * Wigner::wigner6j(TwoJdown,TwoS2,1,TwoSL,TwoSLdown,TwoSR);
          
                for (int l_index=0; l_index<theindex; l_index++){
                
@@ -5430,13 +5430,13 @@ void CheMPS2::Heff::addDiagram4L1and4L2spin0(const int ikappa, double * memS, do
                      double beta = 0.0; //set
                      double alpha = factor;
                   
-                     dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockA,&dimRup,&beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockA,&dimRup,&beta,temp,&dimLdown);
                   
                      beta = 1.0; //add
                      alpha = 1.0;
                      double * blockL = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                   
-                     dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   
                   }
                }
@@ -5451,7 +5451,7 @@ void CheMPS2::Heff::addDiagram4L1and4L2spin0(const int ikappa, double * memS, do
          if ((abs(TwoSLdown-TwoSR)<=TwoS2) && (TwoSLdown>=0)){
          
             int fase = phase(TwoSL + TwoSR + 3 + TwoS2);
-            const double factor = fase * sqrt(0.5 * (TwoSLdown+1) * (TwoJ+1)) * gsl_sf_coupling_6j(TwoJ,TwoS2,1,TwoSLdown,TwoSL,TwoSR);
+            const double factor = fase * sqrt(0.5 * (TwoSLdown+1) * (TwoJ+1)) * Wigner::wigner6j(TwoJ,TwoS2,1,TwoSLdown,TwoSL,TwoSR);
          
             for (int l_index=0; l_index<theindex; l_index++){
                
@@ -5468,13 +5468,13 @@ void CheMPS2::Heff::addDiagram4L1and4L2spin0(const int ikappa, double * memS, do
                   double beta = 0.0; //set
                   double alpha = factor;
                   
-                  dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockA,&dimRup,&beta,temp,&dimLdown);
+                  HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockA,&dimRup,&beta,temp,&dimLdown);
                   
                   beta = 1.0; //add
                   alpha = 1.0;
                   double * blockL = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                   
-                  dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                
                }
             }
@@ -5513,7 +5513,7 @@ void CheMPS2::Heff::addDiagram4K1and4K2spin1(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSRdown)<=TwoS1) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                int fase = (TwoS1==1)?-1:1;
-               const double factor = fase * sqrt(3.0 * (TwoSR+1) * (TwoSL+1) * (TwoJ+1)) * gsl_sf_coupling_9j(2, TwoSR, TwoSRdown, 1, TwoSL, TwoSLdown, 1, TwoJ, TwoS1);
+               const double factor = fase * sqrt(3.0 * (TwoSR+1) * (TwoSL+1) * (TwoJ+1)) * Wigner::wigner9j(2, TwoSR, TwoSRdown, 1, TwoSL, TwoSLdown, 1, TwoJ, TwoS1);
          
                for (int l_index=0; l_index<theindex; l_index++){
                
@@ -5530,13 +5530,13 @@ void CheMPS2::Heff::addDiagram4K1and4K2spin1(const int ikappa, double * memS, do
                      double beta = 0.0; //set
                      double alpha = factor;
                   
-                     dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockB,&dimRdown,&beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockB,&dimRdown,&beta,temp,&dimLdown);
                   
                      beta = 1.0; //add
                      alpha = 1.0;
                      double * blockL = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                   
-                     dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   
                   }
                }
@@ -5555,7 +5555,7 @@ void CheMPS2::Heff::addDiagram4K1and4K2spin1(const int ikappa, double * memS, do
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
                
                   int fase = phase(TwoSR-TwoSRdown+TwoSLdown-TwoSL+3+2*TwoS1);
-                  const double factor = fase * sqrt(3.0 * (TwoSR+1) * (TwoSL+1) * (TwoJdown+1)) * gsl_sf_coupling_9j(2, TwoSRdown, TwoSR, 1, TwoSLdown, TwoSL, 1, TwoJdown, TwoS1);
+                  const double factor = fase * sqrt(3.0 * (TwoSR+1) * (TwoSL+1) * (TwoJdown+1)) * Wigner::wigner9j(2, TwoSRdown, TwoSR, 1, TwoSLdown, TwoSL, 1, TwoJdown, TwoS1);
          
                   for (int l_index=0; l_index<theindex; l_index++){
                
@@ -5572,13 +5572,13 @@ void CheMPS2::Heff::addDiagram4K1and4K2spin1(const int ikappa, double * memS, do
                         double beta = 0.0; //set
                         double alpha = factor;
                   
-                        dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockB,&dimRdown,&beta, temp,&dimLdown);
+                        HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockB,&dimRdown,&beta, temp,&dimLdown);
                   
                         beta = 1.0; //add
                         alpha = 1.0;
                         double * blockL = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                   
-                        dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                        HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                      
                      }
                   }
@@ -5598,7 +5598,7 @@ void CheMPS2::Heff::addDiagram4K1and4K2spin1(const int ikappa, double * memS, do
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
                
                   int fase = (TwoS1==1)?-1:1;
-                  const double factor = fase * sqrt(3.0 * (TwoSRdown+1) * (TwoSLdown+1) * (TwoJdown+1)) * gsl_sf_coupling_9j(2, TwoSRdown, TwoSR, 1, TwoSLdown, TwoSL, 1, TwoJdown, TwoS1);
+                  const double factor = fase * sqrt(3.0 * (TwoSRdown+1) * (TwoSLdown+1) * (TwoJdown+1)) * Wigner::wigner9j(2, TwoSRdown, TwoSR, 1, TwoSLdown, TwoSL, 1, TwoJdown, TwoS1);
          
                   for (int l_index=0; l_index<theindex; l_index++){
                
@@ -5615,13 +5615,13 @@ void CheMPS2::Heff::addDiagram4K1and4K2spin1(const int ikappa, double * memS, do
                         double beta = 0.0; //set
                         double alpha = factor;
                   
-                        dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockB,&dimRup,&beta,temp,&dimLdown);
+                        HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockB,&dimRup,&beta,temp,&dimLdown);
                   
                         beta = 1.0; //add
                         alpha = 1.0;
                         double * blockL = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                   
-                        dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                        HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                      
                      }
                   }
@@ -5638,7 +5638,7 @@ void CheMPS2::Heff::addDiagram4K1and4K2spin1(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSRdown)<=TwoS1) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                int fase = phase(TwoSRdown-TwoSR+TwoSL-TwoSLdown+3+2*TwoS1);
-               const double factor = fase * sqrt(3.0 * (TwoSRdown+1) * (TwoSLdown+1) * (TwoJ+1)) * gsl_sf_coupling_9j(2, TwoSR, TwoSRdown, 1, TwoSL, TwoSLdown, 1, TwoJ, TwoS1);
+               const double factor = fase * sqrt(3.0 * (TwoSRdown+1) * (TwoSLdown+1) * (TwoJ+1)) * Wigner::wigner9j(2, TwoSR, TwoSRdown, 1, TwoSL, TwoSLdown, 1, TwoJ, TwoS1);
          
                for (int l_index=0; l_index<theindex; l_index++){
                
@@ -5655,13 +5655,13 @@ void CheMPS2::Heff::addDiagram4K1and4K2spin1(const int ikappa, double * memS, do
                      double beta = 0.0; //set
                      double alpha = factor;
                   
-                     dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockB,&dimRup,&beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockB,&dimRup,&beta,temp,&dimLdown);
                   
                      beta = 1.0; //add
                      alpha = 1.0;
                      double * blockL = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                   
-                     dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   }
                }
             }
@@ -5700,7 +5700,7 @@ void CheMPS2::Heff::addDiagram4L1and4L2spin1(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSRdown)<=TwoS2) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                int fase = phase(1+TwoS2-TwoJ);
-               const double factor = fase * sqrt(3.0 * (TwoSR+1) * (TwoSL+1) * (TwoJ+1)) * gsl_sf_coupling_9j(2, TwoSR, TwoSRdown, 1, TwoSL, TwoSLdown, 1, TwoJ, TwoS2);
+               const double factor = fase * sqrt(3.0 * (TwoSR+1) * (TwoSL+1) * (TwoJ+1)) * Wigner::wigner9j(2, TwoSR, TwoSRdown, 1, TwoSL, TwoSLdown, 1, TwoJ, TwoS2);
          
                for (int l_index=0; l_index<theindex; l_index++){
                
@@ -5717,13 +5717,13 @@ void CheMPS2::Heff::addDiagram4L1and4L2spin1(const int ikappa, double * memS, do
                      double beta = 0.0; //set
                      double alpha = factor;
                   
-                     dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockB,&dimRdown,&beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockB,&dimRdown,&beta,temp,&dimLdown);
                   
                      beta = 1.0; //add
                      alpha = 1.0;
                      double * blockL = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                   
-                     dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   }
                }
             }
@@ -5741,7 +5741,7 @@ void CheMPS2::Heff::addDiagram4L1and4L2spin1(const int ikappa, double * memS, do
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
 
                   int fase = phase(TwoSR-TwoSRdown+TwoSLdown-TwoSL+TwoS2-TwoJdown); //bug fixed
-                  const double factor = fase * sqrt(3.0 * (TwoSR+1) * (TwoSL+1) * (TwoJdown+1)) * gsl_sf_coupling_9j(2, TwoSRdown, TwoSR, 1, TwoSLdown, TwoSL, 1, TwoJdown, TwoS2);
+                  const double factor = fase * sqrt(3.0 * (TwoSR+1) * (TwoSL+1) * (TwoJdown+1)) * Wigner::wigner9j(2, TwoSRdown, TwoSR, 1, TwoSLdown, TwoSL, 1, TwoJdown, TwoS2);
          
                   for (int l_index=0; l_index<theindex; l_index++){
                
@@ -5758,13 +5758,13 @@ void CheMPS2::Heff::addDiagram4L1and4L2spin1(const int ikappa, double * memS, do
                         double beta = 0.0; //set
                         double alpha = factor;
                   
-                        dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockB,&dimRdown,&beta, temp,&dimLdown);
+                        HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockB,&dimRdown,&beta, temp,&dimLdown);
                   
                         beta = 1.0; //add
                         alpha = 1.0;
                         double * blockL = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                   
-                        dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                        HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                      }
                   }
                }
@@ -5783,7 +5783,7 @@ void CheMPS2::Heff::addDiagram4L1and4L2spin1(const int ikappa, double * memS, do
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
                
                   int fase = phase(1+TwoS2-TwoJdown);
-                  const double factor = fase * sqrt(3.0 * (TwoSRdown+1) * (TwoSLdown+1) * (TwoJdown+1)) * gsl_sf_coupling_9j(2, TwoSRdown, TwoSR, 1, TwoSLdown, TwoSL, 1, TwoJdown, TwoS2);
+                  const double factor = fase * sqrt(3.0 * (TwoSRdown+1) * (TwoSLdown+1) * (TwoJdown+1)) * Wigner::wigner9j(2, TwoSRdown, TwoSR, 1, TwoSLdown, TwoSL, 1, TwoJdown, TwoS2);
          
                   for (int l_index=0; l_index<theindex; l_index++){
                
@@ -5800,13 +5800,13 @@ void CheMPS2::Heff::addDiagram4L1and4L2spin1(const int ikappa, double * memS, do
                         double beta = 0.0; //set
                         double alpha = factor;
                   
-                        dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockB,&dimRup,&beta,temp,&dimLdown);
+                        HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockB,&dimRup,&beta,temp,&dimLdown);
                   
                         beta = 1.0; //add
                         alpha = 1.0;
                         double * blockL = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                   
-                        dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                        HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                      }
                   }
                }
@@ -5822,7 +5822,7 @@ void CheMPS2::Heff::addDiagram4L1and4L2spin1(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSRdown)<=TwoS2) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                int fase = phase(TwoSRdown-TwoSR+TwoSL-TwoSLdown+TwoS2-TwoJ);
-               const double factor = fase * sqrt(3.0 * (TwoSRdown+1) * (TwoSLdown+1) * (TwoJ+1)) * gsl_sf_coupling_9j(2, TwoSR, TwoSRdown, 1, TwoSL, TwoSLdown, 1, TwoJ, TwoS2);
+               const double factor = fase * sqrt(3.0 * (TwoSRdown+1) * (TwoSLdown+1) * (TwoJ+1)) * Wigner::wigner9j(2, TwoSR, TwoSRdown, 1, TwoSL, TwoSLdown, 1, TwoJ, TwoS2);
          
                for (int l_index=0; l_index<theindex; l_index++){
                
@@ -5839,13 +5839,13 @@ void CheMPS2::Heff::addDiagram4L1and4L2spin1(const int ikappa, double * memS, do
                      double beta = 0.0; //set
                      double alpha = factor;
                   
-                     dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockB,&dimRup,&beta,temp,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,blockB,&dimRup,&beta,temp,&dimLdown);
                   
                      beta = 1.0; //add
                      alpha = 1.0;
                      double * blockL = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                   
-                     dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   }
                }
             }
@@ -5883,7 +5883,7 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin0(const int ikappa, double * memS, do
          if ((abs(TwoSLdown-TwoSR)<=TwoS1) && (TwoSLdown>=0)){
          
             int fase = phase(TwoSL + TwoSR + TwoJ + 2*TwoS1);
-            const double factor = fase * sqrt(0.5 * (TwoSLdown+1) * (TwoJ+1)) * gsl_sf_coupling_6j(TwoJ,TwoS1,1,TwoSLdown,TwoSL,TwoSR);
+            const double factor = fase * sqrt(0.5 * (TwoSLdown+1) * (TwoJ+1)) * Wigner::wigner6j(TwoJ,TwoS1,1,TwoSLdown,TwoSL,TwoSR);
          
             for (int l_index=0; l_index<theindex; l_index++){
                
@@ -5900,12 +5900,12 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin0(const int ikappa, double * memS, do
                   if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                      int inc = 1;
                      int size = dimRup * dimRdown;
-                     dcopy_(&size,ptr,&inc,temp,&inc);
+                     HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
                      
                      for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                         double prefac = 2 * Prob->gMxElement(l_index,l_beta,theindex+1,l_beta) - Prob->gMxElement(l_index,theindex+1,l_beta,l_beta);
                         double * blockF0 = F0right[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSR,IRdown);
-                        daxpy_(&size,&prefac,blockF0,&inc,temp,&inc);                  
+                        HeffPlan::daxpy(&size,&prefac,blockF0,&inc,temp,&inc);                  
                      }
                   
                      ptr = temp;
@@ -5914,13 +5914,13 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin0(const int ikappa, double * memS, do
                   double beta = 0.0; //set
                   double alpha = factor;
                   
-                  dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRup,&beta,temp2,&dimLdown);
+                  HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRup,&beta,temp2,&dimLdown);
                   
                   beta = 1.0; //add
                   alpha = 1.0;
                   double * blockL = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                   
-                  dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                }
             }
          }
@@ -5936,7 +5936,7 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin0(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSR)<=TwoJdown) && (TwoSLdown>=0)){
             
                int fase = phase(TwoSL + TwoSR + TwoJdown + 1 + 2*TwoS1);
-               const double factor = fase * sqrt(0.5 * (TwoSLdown+1) * (TwoJdown+1)) * gsl_sf_coupling_6j(TwoJdown,TwoS1,1,TwoSL,TwoSLdown,TwoSR);
+               const double factor = fase * sqrt(0.5 * (TwoSLdown+1) * (TwoJdown+1)) * Wigner::wigner6j(TwoJdown,TwoS1,1,TwoSL,TwoSLdown,TwoSR);
          
                for (int l_index=0; l_index<theindex; l_index++){
                
@@ -5953,12 +5953,12 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin0(const int ikappa, double * memS, do
                      if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                         int inc = 1;
                         int size = dimRup * dimRdown;
-                        dcopy_(&size,ptr,&inc,temp,&inc);
+                        HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
                      
                         for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                            double prefac = 2 * Prob->gMxElement(l_index,l_beta,theindex+1,l_beta) - Prob->gMxElement(l_index,theindex+1,l_beta,l_beta);
                            double * blockF0 = F0right[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSR,IRdown);
-                           daxpy_(&size,&prefac,blockF0,&inc,temp,&inc);                  
+                           HeffPlan::daxpy(&size,&prefac,blockF0,&inc,temp,&inc);                  
                         }
                   
                         ptr = temp;
@@ -5967,13 +5967,13 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin0(const int ikappa, double * memS, do
                      double beta = 0.0; //set
                      double alpha = factor;
                   
-                     dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRup,&beta,temp2,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRup,&beta,temp2,&dimLdown);
                   
                      beta = 1.0; //add
                      alpha = 1.0;
                      double * blockL = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                   
-                     dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   }
                }
             }
@@ -5990,7 +5990,7 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin0(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSR)<=TwoJdown) && (TwoSLdown>=0)){
             
                int fase = phase(TwoSLdown + TwoSR + TwoJdown + 2*TwoS1);
-               const double factor = fase * sqrt(0.5 * (TwoSL+1) * (TwoJdown+1)) * gsl_sf_coupling_6j(TwoJdown,TwoS1,1,TwoSL,TwoSLdown,TwoSR);
+               const double factor = fase * sqrt(0.5 * (TwoSL+1) * (TwoJdown+1)) * Wigner::wigner6j(TwoJdown,TwoS1,1,TwoSL,TwoSLdown,TwoSR);
          
                for (int l_index=0; l_index<theindex; l_index++){
                
@@ -6007,12 +6007,12 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin0(const int ikappa, double * memS, do
                      if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                         int inc = 1;
                         int size = dimRup * dimRdown;
-                        dcopy_(&size,ptr,&inc,temp,&inc);
+                        HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
                      
                         for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                            double prefac = 2 * Prob->gMxElement(l_index,l_beta,theindex+1,l_beta) - Prob->gMxElement(l_index,theindex+1,l_beta,l_beta);
                            double * blockF0 = F0right[l_beta-theindex-2]->gStorage(NR,TwoSR,IRdown,NR,TwoSR,IR);
-                           daxpy_(&size,&prefac,blockF0,&inc,temp,&inc);                  
+                           HeffPlan::daxpy(&size,&prefac,blockF0,&inc,temp,&inc);                  
                         }
                   
                         ptr = temp;
@@ -6021,13 +6021,13 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin0(const int ikappa, double * memS, do
                      double beta = 0.0; //set
                      double alpha = factor;
                   
-                     dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRdown,&beta,temp2,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRdown,&beta,temp2,&dimLdown);
                   
                      beta = 1.0; //add
                      alpha = 1.0;
                      double * blockL = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                   
-                     dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   }
                }
             }
@@ -6041,7 +6041,7 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin0(const int ikappa, double * memS, do
          if ((abs(TwoSLdown-TwoSR)<=TwoS1) && (TwoSLdown>=0)){
          
             int fase = phase(TwoSLdown + TwoSR + 1 + TwoJ + 2*TwoS1);
-            const double factor = fase * sqrt(0.5 * (TwoSL+1) * (TwoJ+1)) * gsl_sf_coupling_6j(TwoJ,TwoS1,1,TwoSLdown,TwoSL,TwoSR);
+            const double factor = fase * sqrt(0.5 * (TwoSL+1) * (TwoJ+1)) * Wigner::wigner6j(TwoJ,TwoS1,1,TwoSLdown,TwoSL,TwoSR);
          
             for (int l_index=0; l_index<theindex; l_index++){
                
@@ -6058,12 +6058,12 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin0(const int ikappa, double * memS, do
                   if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                      int inc = 1;
                      int size = dimRup * dimRdown;
-                     dcopy_(&size,ptr,&inc,temp,&inc);
+                     HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
                      
                      for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                         double prefac = 2 * Prob->gMxElement(l_index,l_beta,theindex+1,l_beta) - Prob->gMxElement(l_index,theindex+1,l_beta,l_beta);
                         double * blockF0 = F0right[l_beta-theindex-2]->gStorage(NR,TwoSR,IRdown,NR,TwoSR,IR);
-                        daxpy_(&size,&prefac,blockF0,&inc,temp,&inc);                  
+                        HeffPlan::daxpy(&size,&prefac,blockF0,&inc,temp,&inc);                  
                      }
                   
                      ptr = temp;
@@ -6072,13 +6072,13 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin0(const int ikappa, double * memS, do
                   double beta = 0.0; //set
                   double alpha = factor;
                   
-                  dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRdown,&beta,temp2,&dimLdown);
+                  HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRdown,&beta,temp2,&dimLdown);
                   
                   beta = 1.0; //add
                   alpha = 1.0;
                   double * blockL = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                 
-                  dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                }
             }
          }
@@ -6115,7 +6115,7 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin0(const int ikappa, double * memS, do
          if ((abs(TwoSLdown-TwoSR)<=TwoS2) && (TwoSLdown>=0)){
          
             int fase = phase(TwoSL + TwoSR + 1 + TwoS2);
-            const double factor = fase * sqrt(0.5 * (TwoSLdown+1) * (TwoJ+1)) * gsl_sf_coupling_6j(TwoJ,TwoS2,1,TwoSLdown,TwoSL,TwoSR);
+            const double factor = fase * sqrt(0.5 * (TwoSLdown+1) * (TwoJ+1)) * Wigner::wigner6j(TwoJ,TwoS2,1,TwoSLdown,TwoSL,TwoSR);
          
             for (int l_index=0; l_index<theindex; l_index++){
                
@@ -6132,12 +6132,12 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin0(const int ikappa, double * memS, do
                   if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                      int inc = 1;
                      int size = dimRup * dimRdown;
-                     dcopy_(&size,ptr,&inc,temp,&inc);
+                     HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
                      
                      for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                         double prefac = 2 * Prob->gMxElement(l_index,l_beta,theindex,l_beta) - Prob->gMxElement(l_index,theindex,l_beta,l_beta);
                         double * blockF0 = F0right[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSR,IRdown);
-                        daxpy_(&size,&prefac,blockF0,&inc,temp,&inc);                  
+                        HeffPlan::daxpy(&size,&prefac,blockF0,&inc,temp,&inc);                  
                      }
                   
                      ptr = temp;
@@ -6146,13 +6146,13 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin0(const int ikappa, double * memS, do
                   double beta = 0.0; //set
                   double alpha = factor;
                   
-                  dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRup,&beta,temp2,&dimLdown);
+                  HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRup,&beta,temp2,&dimLdown);
                   
                   beta = 1.0; //add
                   alpha = 1.0;
                   double * blockL = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                   
-                  dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                }
             }
          }
@@ -6168,7 +6168,7 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin0(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSR)<=TwoJdown) && (TwoSLdown>=0)){
             
                int fase = phase(TwoSL + TwoSR + 2 + TwoS2);
-               const double factor = fase * sqrt(0.5 * (TwoSLdown+1) * (TwoJdown+1)) * gsl_sf_coupling_6j(TwoJdown,TwoS2,1,TwoSL,TwoSLdown,TwoSR);
+               const double factor = fase * sqrt(0.5 * (TwoSLdown+1) * (TwoJdown+1)) * Wigner::wigner6j(TwoJdown,TwoS2,1,TwoSL,TwoSLdown,TwoSR);
          
                for (int l_index=0; l_index<theindex; l_index++){
                
@@ -6185,12 +6185,12 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin0(const int ikappa, double * memS, do
                      if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                         int inc = 1;
                         int size = dimRup * dimRdown;
-                        dcopy_(&size,ptr,&inc,temp,&inc);
+                        HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
                      
                         for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                            double prefac = 2 * Prob->gMxElement(l_index,l_beta,theindex,l_beta) - Prob->gMxElement(l_index,theindex,l_beta,l_beta);
                            double * blockF0 = F0right[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSR,IRdown);
-                           daxpy_(&size,&prefac,blockF0,&inc,temp,&inc);                  
+                           HeffPlan::daxpy(&size,&prefac,blockF0,&inc,temp,&inc);                  
                         }
                   
                         ptr = temp;
@@ -6199,13 +6199,13 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin0(const int ikappa, double * memS, do
                      double beta = 0.0; //set
                      double alpha = factor;
                   
-                     dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRup,&beta,temp2,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRup,&beta,temp2,&dimLdown);
                   
                      beta = 1.0; //add
                      alpha = 1.0;
                      double * blockL = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                   
-                     dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   }
                }
             }
@@ -6222,7 +6222,7 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin0(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSR)<=TwoJdown) && (TwoSLdown>=0)){
             
                int fase = phase(TwoSLdown + TwoSR + 1 + TwoS2);
-               const double factor = fase * sqrt(0.5 * (TwoSL+1) * (TwoJdown+1)) * gsl_sf_coupling_6j(TwoJdown,TwoS2,1,TwoSL,TwoSLdown,TwoSR);
+               const double factor = fase * sqrt(0.5 * (TwoSL+1) * (TwoJdown+1)) * Wigner::wigner6j(TwoJdown,TwoS2,1,TwoSL,TwoSLdown,TwoSR);
          
                for (int l_index=0; l_index<theindex; l_index++){
                
@@ -6239,12 +6239,12 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin0(const int ikappa, double * memS, do
                      if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                         int inc = 1;
                         int size = dimRup * dimRdown;
-                        dcopy_(&size,ptr,&inc,temp,&inc);
+                        HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
                      
                         for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                            double prefac = 2 * Prob->gMxElement(l_index,l_beta,theindex,l_beta) - Prob->gMxElement(l_index,theindex,l_beta,l_beta);
                            double * blockF0 = F0right[l_beta-theindex-2]->gStorage(NR,TwoSR,IRdown,NR,TwoSR,IR);
-                           daxpy_(&size,&prefac,blockF0,&inc,temp,&inc);                  
+                           HeffPlan::daxpy(&size,&prefac,blockF0,&inc,temp,&inc);                  
                         }
                   
                         ptr = temp;
@@ -6253,13 +6253,13 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin0(const int ikappa, double * memS, do
                      double beta = 0.0; //set
                      double alpha = factor;
                   
-                     dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRdown,&beta,temp2,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRdown,&beta,temp2,&dimLdown);
                   
                      beta = 1.0; //add
                      alpha = 1.0;
                      double * blockL = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                   
-                     dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   }
                }
             }
@@ -6273,7 +6273,7 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin0(const int ikappa, double * memS, do
          if ((abs(TwoSLdown-TwoSR)<=TwoS2) && (TwoSLdown>=0)){
          
             int fase = phase(TwoSLdown + TwoSR + 2 + TwoS2);
-            const double factor = fase * sqrt(0.5 * (TwoSL+1) * (TwoJ+1)) * gsl_sf_coupling_6j(TwoJ,TwoS2,1,TwoSLdown,TwoSL,TwoSR);
+            const double factor = fase * sqrt(0.5 * (TwoSL+1) * (TwoJ+1)) * Wigner::wigner6j(TwoJ,TwoS2,1,TwoSLdown,TwoSL,TwoSR);
          
             for (int l_index=0; l_index<theindex; l_index++){
                
@@ -6290,12 +6290,12 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin0(const int ikappa, double * memS, do
                   if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                      int inc = 1;
                      int size = dimRup * dimRdown;
-                     dcopy_(&size,ptr,&inc,temp,&inc);
+                     HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
                      
                      for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                         double prefac = 2 * Prob->gMxElement(l_index,l_beta,theindex,l_beta) - Prob->gMxElement(l_index,theindex,l_beta,l_beta);
                         double * blockF0 = F0right[l_beta-theindex-2]->gStorage(NR,TwoSR,IRdown,NR,TwoSR,IR);
-                        daxpy_(&size,&prefac,blockF0,&inc,temp,&inc);                  
+                        HeffPlan::daxpy(&size,&prefac,blockF0,&inc,temp,&inc);                  
                      }
                   
                      ptr = temp;
@@ -6304,13 +6304,13 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin0(const int ikappa, double * memS, do
                   double beta = 0.0; //set
                   double alpha = factor;
                   
-                  dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRdown,&beta,temp2,&dimLdown);
+                  HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRdown,&beta,temp2,&dimLdown);
                   
                   beta = 1.0; //add
                   alpha = 1.0;
                   double * blockL = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                 
-                  dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                  HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                }
             }
          }
@@ -6348,7 +6348,7 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin1(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSRdown)<=TwoS1) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                int fase = phase(TwoSL - TwoSLdown + 1 + 2*TwoS1);
-               const double factor = fase * sqrt(3.0 * (TwoSR+1) * (TwoSLdown+1) * (TwoJ+1)) * gsl_sf_coupling_9j(2, TwoSR, TwoSRdown, 1, TwoSL, TwoSLdown, 1, TwoJ, TwoS1);
+               const double factor = fase * sqrt(3.0 * (TwoSR+1) * (TwoSLdown+1) * (TwoJ+1)) * Wigner::wigner9j(2, TwoSR, TwoSRdown, 1, TwoSL, TwoSLdown, 1, TwoJ, TwoS1);
          
                for (int l_index=0; l_index<theindex; l_index++){
                
@@ -6365,12 +6365,12 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin1(const int ikappa, double * memS, do
                      if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                         int inc = 1;
                         int size = dimRup * dimRdown;
-                        dcopy_(&size,ptr,&inc,temp,&inc);
+                        HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
                      
                         for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                            double prefac = - Prob->gMxElement(l_index,theindex+1,l_beta,l_beta);
                            double * blockF1 = F1right[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSRdown,IRdown);
-                           daxpy_(&size,&prefac,blockF1,&inc,temp,&inc);                  
+                           HeffPlan::daxpy(&size,&prefac,blockF1,&inc,temp,&inc);                  
                         }
                   
                         ptr = temp;
@@ -6379,13 +6379,13 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin1(const int ikappa, double * memS, do
                      double beta = 0.0; //set
                      double alpha = factor;
                   
-                     dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRup,&beta,temp2,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRup,&beta,temp2,&dimLdown);
                   
                      beta = 1.0; //add
                      alpha = 1.0;
                      double * blockL = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                   
-                     dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   }
                }
             }
@@ -6403,7 +6403,7 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin1(const int ikappa, double * memS, do
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
                
                   int fase = phase(TwoSR - TwoSRdown + 2*TwoS1);
-                  const double factor = fase * sqrt(3.0 * (TwoSR+1) * (TwoSLdown+1) * (TwoJdown+1)) * gsl_sf_coupling_9j(2, TwoSRdown, TwoSR, 1, TwoSLdown, TwoSL, 1, TwoJdown, TwoS1);
+                  const double factor = fase * sqrt(3.0 * (TwoSR+1) * (TwoSLdown+1) * (TwoJdown+1)) * Wigner::wigner9j(2, TwoSRdown, TwoSR, 1, TwoSLdown, TwoSL, 1, TwoJdown, TwoS1);
          
                   for (int l_index=0; l_index<theindex; l_index++){
                
@@ -6420,12 +6420,12 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin1(const int ikappa, double * memS, do
                         if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                            int inc = 1;
                            int size = dimRup * dimRdown;
-                           dcopy_(&size,ptr,&inc,temp,&inc);
+                           HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
                      
                            for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                               double prefac = - Prob->gMxElement(l_index,theindex+1,l_beta,l_beta);
                               double * blockF1 = F1right[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSRdown,IRdown);
-                              daxpy_(&size,&prefac,blockF1,&inc,temp,&inc);                  
+                              HeffPlan::daxpy(&size,&prefac,blockF1,&inc,temp,&inc);                  
                            }
                   
                            ptr = temp;
@@ -6434,13 +6434,13 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin1(const int ikappa, double * memS, do
                         double beta = 0.0; //set
                         double alpha = factor;
                   
-                        dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRup,&beta,temp2,&dimLdown);
+                        HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRup,&beta,temp2,&dimLdown);
                   
                         beta = 1.0; //add
                         alpha = 1.0;
                         double * blockL = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                   
-                        dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                        HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                      }
                   }
                }
@@ -6459,7 +6459,7 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin1(const int ikappa, double * memS, do
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
                
                   int fase = phase(TwoSLdown + 1 - TwoSL + 2*TwoS1);
-                  const double factor = fase * sqrt(3.0 * (TwoSRdown+1) * (TwoSL+1) * (TwoJdown+1)) * gsl_sf_coupling_9j(2, TwoSRdown, TwoSR, 1, TwoSLdown, TwoSL, 1, TwoJdown, TwoS1);
+                  const double factor = fase * sqrt(3.0 * (TwoSRdown+1) * (TwoSL+1) * (TwoJdown+1)) * Wigner::wigner9j(2, TwoSRdown, TwoSR, 1, TwoSLdown, TwoSL, 1, TwoJdown, TwoS1);
          
                   for (int l_index=0; l_index<theindex; l_index++){
                
@@ -6476,12 +6476,12 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin1(const int ikappa, double * memS, do
                         if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                            int inc = 1;
                            int size = dimRup * dimRdown;
-                           dcopy_(&size,ptr,&inc,temp,&inc);
+                           HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
                      
                            for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                               double prefac = - Prob->gMxElement(l_index,theindex+1,l_beta,l_beta);
                               double * blockF1 = F1right[l_beta-theindex-2]->gStorage(NR,TwoSRdown,IRdown,NR,TwoSR,IR);
-                              daxpy_(&size,&prefac,blockF1,&inc,temp,&inc);                  
+                              HeffPlan::daxpy(&size,&prefac,blockF1,&inc,temp,&inc);                  
                            }
                   
                            ptr = temp;
@@ -6490,13 +6490,13 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin1(const int ikappa, double * memS, do
                         double beta = 0.0; //set
                         double alpha = factor;
                   
-                        dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRdown,&beta,temp2,&dimLdown);
+                        HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRdown,&beta,temp2,&dimLdown);
                   
                         beta = 1.0; //add
                         alpha = 1.0;
                         double * blockL = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                   
-                        dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                        HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                      }
                   }
                }
@@ -6512,7 +6512,7 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin1(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSRdown)<=TwoS1) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                int fase = phase(TwoSR - TwoSRdown + 2*TwoS1);
-               const double factor = fase * sqrt(3.0 * (TwoSRdown+1) * (TwoSL+1) * (TwoJ+1)) * gsl_sf_coupling_9j(2, TwoSR, TwoSRdown, 1, TwoSL, TwoSLdown, 1, TwoJ, TwoS1);
+               const double factor = fase * sqrt(3.0 * (TwoSRdown+1) * (TwoSL+1) * (TwoJ+1)) * Wigner::wigner9j(2, TwoSR, TwoSRdown, 1, TwoSL, TwoSLdown, 1, TwoJ, TwoS1);
          
                for (int l_index=0; l_index<theindex; l_index++){
                
@@ -6529,12 +6529,12 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin1(const int ikappa, double * memS, do
                      if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex+1)){
                         int inc = 1;
                         int size = dimRup * dimRdown;
-                        dcopy_(&size,ptr,&inc,temp,&inc);
+                        HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
                      
                         for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                            double prefac = - Prob->gMxElement(l_index,theindex+1,l_beta,l_beta);
                            double * blockF1 = F1right[l_beta-theindex-2]->gStorage(NR,TwoSRdown,IRdown,NR,TwoSR,IR);
-                           daxpy_(&size,&prefac,blockF1,&inc,temp,&inc);                  
+                           HeffPlan::daxpy(&size,&prefac,blockF1,&inc,temp,&inc);                  
                         }
                   
                         ptr = temp;
@@ -6543,13 +6543,13 @@ void CheMPS2::Heff::addDiagram4K3and4K4spin1(const int ikappa, double * memS, do
                      double beta = 0.0; //set
                      double alpha = factor;
                   
-                     dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRdown,&beta,temp2,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRdown,&beta,temp2,&dimLdown);
                   
                      beta = 1.0; //add
                      alpha = 1.0;
                      double * blockL = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                 
-                     dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   }
                }
             }
@@ -6588,7 +6588,7 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin1(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSRdown)<=TwoS2) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                int fase = phase(TwoSL - TwoSLdown + 2 + TwoS2 - TwoJ);
-               const double factor = fase * sqrt(3.0 * (TwoSR+1) * (TwoSLdown+1) * (TwoJ+1)) * gsl_sf_coupling_9j(2, TwoSR, TwoSRdown, 1, TwoSL, TwoSLdown, 1, TwoJ, TwoS2);
+               const double factor = fase * sqrt(3.0 * (TwoSR+1) * (TwoSLdown+1) * (TwoJ+1)) * Wigner::wigner9j(2, TwoSR, TwoSRdown, 1, TwoSL, TwoSLdown, 1, TwoJ, TwoS2);
          
                for (int l_index=0; l_index<theindex; l_index++){
                
@@ -6605,12 +6605,12 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin1(const int ikappa, double * memS, do
                      if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                         int inc = 1;
                         int size = dimRup * dimRdown;
-                        dcopy_(&size,ptr,&inc,temp,&inc);
+                        HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
                      
                         for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                            double prefac = - Prob->gMxElement(l_index,theindex,l_beta,l_beta);
                            double * blockF1 = F1right[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSRdown,IRdown);
-                           daxpy_(&size,&prefac,blockF1,&inc,temp,&inc);                  
+                           HeffPlan::daxpy(&size,&prefac,blockF1,&inc,temp,&inc);                  
                         }
                   
                         ptr = temp;
@@ -6619,13 +6619,13 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin1(const int ikappa, double * memS, do
                      double beta = 0.0; //set
                      double alpha = factor;
                   
-                     dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRup,&beta,temp2,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRup,&beta,temp2,&dimLdown);
                   
                      beta = 1.0; //add
                      alpha = 1.0;
                      double * blockL = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                   
-                     dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   }
                }
             }
@@ -6643,7 +6643,7 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin1(const int ikappa, double * memS, do
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
                
                   int fase = phase(TwoSR - TwoSRdown + 1 + TwoS2 - TwoJdown);
-                  const double factor = fase * sqrt(3.0 * (TwoSR+1) * (TwoSLdown+1) * (TwoJdown+1)) * gsl_sf_coupling_9j(2, TwoSRdown, TwoSR, 1, TwoSLdown, TwoSL, 1, TwoJdown, TwoS2);
+                  const double factor = fase * sqrt(3.0 * (TwoSR+1) * (TwoSLdown+1) * (TwoJdown+1)) * Wigner::wigner9j(2, TwoSRdown, TwoSR, 1, TwoSLdown, TwoSL, 1, TwoJdown, TwoS2);
          
                   for (int l_index=0; l_index<theindex; l_index++){
                
@@ -6660,12 +6660,12 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin1(const int ikappa, double * memS, do
                         if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                            int inc = 1;
                            int size = dimRup * dimRdown;
-                           dcopy_(&size,ptr,&inc,temp,&inc);
+                           HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
                      
                            for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                               double prefac = - Prob->gMxElement(l_index,theindex,l_beta,l_beta);
                               double * blockF1 = F1right[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR,TwoSRdown,IRdown);
-                              daxpy_(&size,&prefac,blockF1,&inc,temp,&inc);                  
+                              HeffPlan::daxpy(&size,&prefac,blockF1,&inc,temp,&inc);                  
                            }
                   
                            ptr = temp;
@@ -6674,13 +6674,13 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin1(const int ikappa, double * memS, do
                         double beta = 0.0; //set
                         double alpha = factor;
                   
-                        dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRup,&beta,temp2,&dimLdown);
+                        HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRup,&beta,temp2,&dimLdown);
                   
                         beta = 1.0; //add
                         alpha = 1.0;
                         double * blockL = Lleft[theindex-1-l_index]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
                   
-                        dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                        HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                      }
                   }
                }
@@ -6699,7 +6699,7 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin1(const int ikappa, double * memS, do
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
                
                   int fase = phase(TwoSLdown + 2 - TwoSL + TwoS2 - TwoJdown);
-                  const double factor = fase * sqrt(3.0 * (TwoSRdown+1) * (TwoSL+1) * (TwoJdown+1)) * gsl_sf_coupling_9j(2, TwoSRdown, TwoSR, 1, TwoSLdown, TwoSL, 1, TwoJdown, TwoS2);
+                  const double factor = fase * sqrt(3.0 * (TwoSRdown+1) * (TwoSL+1) * (TwoJdown+1)) * Wigner::wigner9j(2, TwoSRdown, TwoSR, 1, TwoSLdown, TwoSL, 1, TwoJdown, TwoS2);
          
                   for (int l_index=0; l_index<theindex; l_index++){
                
@@ -6716,12 +6716,12 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin1(const int ikappa, double * memS, do
                         if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                            int inc = 1;
                            int size = dimRup * dimRdown;
-                           dcopy_(&size,ptr,&inc,temp,&inc);
+                           HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
                      
                            for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                               double prefac = - Prob->gMxElement(l_index,theindex,l_beta,l_beta);
                               double * blockF1 = F1right[l_beta-theindex-2]->gStorage(NR,TwoSRdown,IRdown,NR,TwoSR,IR);
-                              daxpy_(&size,&prefac,blockF1,&inc,temp,&inc);                  
+                              HeffPlan::daxpy(&size,&prefac,blockF1,&inc,temp,&inc);                  
                            }
                   
                            ptr = temp;
@@ -6730,13 +6730,13 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin1(const int ikappa, double * memS, do
                         double beta = 0.0; //set
                         double alpha = factor;
                   
-                        dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRdown,&beta,temp2,&dimLdown);
+                        HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRdown,&beta,temp2,&dimLdown);
                   
                         beta = 1.0; //add
                         alpha = 1.0;
                         double * blockL = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                   
-                        dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                        HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                      }
                   }
                }
@@ -6752,7 +6752,7 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin1(const int ikappa, double * memS, do
             if ((abs(TwoSLdown-TwoSRdown)<=TwoS2) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                int fase = phase(TwoSR - TwoSRdown + 1 + TwoS2 - TwoJ);
-               const double factor = fase * sqrt(3.0 * (TwoSRdown+1) * (TwoSL+1) * (TwoJ+1)) * gsl_sf_coupling_9j(2, TwoSR, TwoSRdown, 1, TwoSL, TwoSLdown, 1, TwoJ, TwoS2);
+               const double factor = fase * sqrt(3.0 * (TwoSRdown+1) * (TwoSL+1) * (TwoJ+1)) * Wigner::wigner9j(2, TwoSR, TwoSRdown, 1, TwoSL, TwoSLdown, 1, TwoJ, TwoS2);
          
                for (int l_index=0; l_index<theindex; l_index++){
                
@@ -6769,12 +6769,12 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin1(const int ikappa, double * memS, do
                      if (denBK->gIrrep(l_index) == denBK->gIrrep(theindex)){
                         int inc = 1;
                         int size = dimRup * dimRdown;
-                        dcopy_(&size,ptr,&inc,temp,&inc);
+                        HeffPlan::dcopy(&size,ptr,&inc,temp,&inc);
                      
                         for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                            double prefac = - Prob->gMxElement(l_index,theindex,l_beta,l_beta);
                            double * blockF1 = F1right[l_beta-theindex-2]->gStorage(NR,TwoSRdown,IRdown,NR,TwoSR,IR);
-                           daxpy_(&size,&prefac,blockF1,&inc,temp,&inc);                  
+                           HeffPlan::daxpy(&size,&prefac,blockF1,&inc,temp,&inc);                  
                         }
                   
                         ptr = temp;
@@ -6783,13 +6783,13 @@ void CheMPS2::Heff::addDiagram4L3and4L4spin1(const int ikappa, double * memS, do
                      double beta = 0.0; //set
                      double alpha = factor;
                   
-                     dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRdown,&beta,temp2,&dimLdown);
+                     HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,ptr,&dimRdown,&beta,temp2,&dimLdown);
                   
                      beta = 1.0; //add
                      alpha = 1.0;
                      double * blockL = Lleft[theindex-1-l_index]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
                 
-                     dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                     HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,blockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                   }
                }
             }
@@ -22,7 +22,7 @@
 
 #include "Heff.h"
 #include "Lapack.h"
-#include "Gsl.h"
+#include "Wigner.h"
 
 void CheMPS2::Heff::addDiagram5A(const int ikappa, double * memS, double * memHeff, const Sobject * denS, TensorL ** Lleft, TensorL ** Lright, double * temp, double * temp2) const{
 
@@ -57,7 +57,7 @@ void CheMPS2::Heff::addDiagram5A(const int ikappa, double * memS, double * memHe
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                   int fase = phase(TwoSLdown+TwoSRdown+2);
-                  const double factor = fase * sqrt((TwoJdown+1)*(TwoSRdown+1.0)) * gsl_sf_coupling_6j(1, 1, TwoJdown, TwoSLdown, TwoSRdown, TwoSR);
+                  const double factor = fase * sqrt((TwoJdown+1)*(TwoSRdown+1.0)) * Wigner::wigner6j(1, 1, TwoJdown, TwoSLdown, TwoSRdown, TwoSR);
             
                   for (int Irrep=0; Irrep<(denBK->getNumberOfIrreps()); Irrep++){
                
@@ -86,14 +86,14 @@ void CheMPS2::Heff::addDiagram5A(const int ikappa, double * memS, double * memHe
                               if ((dimLdown>0) && (dimRdown>0)){
                               
                                  int size = dimRup * dimRdown;
-                                 for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                                 HeffPlan::clear(size, temp);
                               
                                  for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                     if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                        double prefac =             factor * ( Prob->gMxElement(l_alpha, theindex+1, theindex, l_beta) 
                                                      + ((TwoJdown==0)?1:-1) * Prob->gMxElement(l_alpha, theindex, theindex+1, l_beta) );
                                        double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
-                                       daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                       HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                                     }
                                  }
                               
@@ -101,11 +101,11 @@ void CheMPS2::Heff::addDiagram5A(const int ikappa, double * memS, double * memHe
                                  double beta = 0.0; //set
                                  int memSkappa = denS->gKappa(NL-1, TwoSLdown, ILdown, 1, 1, TwoJdown, NR+1, TwoSRdown, IRdown);
                               
-                                 dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
+                                 HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
                               
                                  beta = 1.0; //add
                                  double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                                 dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                                 HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                               
                               }
                            }
@@ -162,14 +162,14 @@ void CheMPS2::Heff::addDiagram5A(const int ikappa, double * memS, double * memHe
                            if ((dimLdown>0) && (dimRdown>0)){
                               
                               int size = dimRup * dimRdown;
-                              for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                              HeffPlan::clear(size, temp);
                               
                               for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                  if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                     double prefac = factor1 * Prob->gMxElement(l_alpha, theindex+1, theindex, l_beta) 
                                                   + factor2 * Prob->gMxElement(l_alpha, theindex, theindex+1, l_beta);
                                     double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
-                                    daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                    HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                                  }
                               }
                               
@@ -177,11 +177,11 @@ void CheMPS2::Heff::addDiagram5A(const int ikappa, double * memS, double * memHe
                               double beta = 0.0; //set
                               int memSkappa = denS->gKappa(NL-1, TwoSLdown, ILdown, 2, 1, 1, NR+1, TwoSRdown, IRdown);
                               
-                              dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
+                              HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
                               
                               beta = 1.0; //add
                               double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                              dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                              HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
 
                            }
                         }
@@ -237,14 +237,14 @@ void CheMPS2::Heff::addDiagram5A(const int ikappa, double * memS, double * memHe
                            if ((dimLdown>0) && (dimRdown>0)){
                               
                               int size = dimRup * dimRdown;
-                              for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                              HeffPlan::clear(size, temp);
                               
                               for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                  if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                     double prefac = factor1 * Prob->gMxElement(l_alpha, theindex+1, theindex, l_beta) 
                                                   + factor2 * Prob->gMxElement(l_alpha, theindex, theindex+1, l_beta);
                                     double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
-                                    daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                    HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                                  }
                               }
                               
@@ -252,11 +252,11 @@ void CheMPS2::Heff::addDiagram5A(const int ikappa, double * memS, double * memHe
                               double beta = 0.0; //set
                               int memSkappa = denS->gKappa(NL-1, TwoSLdown, ILdown, 1, 2, 1, NR+1, TwoSRdown, IRdown);
                               
-                              dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
+                              HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
                               
                               beta = 1.0; //add
                               double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                              dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                              HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                            
                            }
                         }
@@ -276,7 +276,7 @@ void CheMPS2::Heff::addDiagram5A(const int ikappa, double * memS, double * memHe
             int TwoSRdown = TwoSLdown;
             
             int fase = (((TwoSL+1)%2)!=0)?-1:1;
-            const double factor = fase * sqrt((TwoJ+1)*(TwoSL+1.0)) * gsl_sf_coupling_6j(1, 1, TwoJ, TwoSL, TwoSR, TwoSRdown);
+            const double factor = fase * sqrt((TwoJ+1)*(TwoSL+1.0)) * Wigner::wigner6j(1, 1, TwoJ, TwoSL, TwoSR, TwoSRdown);
             
             for (int Irrep=0; Irrep<(denBK->getNumberOfIrreps()); Irrep++){
                
@@ -305,14 +305,14 @@ void CheMPS2::Heff::addDiagram5A(const int ikappa, double * memS, double * memHe
                         if ((dimLdown>0) && (dimRdown>0)){
                          
                            int size = dimRup * dimRdown;
-                           for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                           HeffPlan::clear(size, temp);
                              
                            for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                               if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                  double prefac =             factor * ( Prob->gMxElement(l_alpha, theindex+1, theindex, l_beta) 
                                                + ((TwoJ==0)?1:-1) * Prob->gMxElement(l_alpha, theindex, theindex+1, l_beta) );
                                  double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
-                                 daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                 HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                               }
                            }
                                  
@@ -320,11 +320,11 @@ void CheMPS2::Heff::addDiagram5A(const int ikappa, double * memS, double * memHe
                            double beta = 0.0; //set
                            int memSkappa = denS->gKappa(NL-1, TwoSLdown, ILdown, 2, 2, 0, NR+1, TwoSRdown, IRdown);
                                  
-                           dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
+                           HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
                                  
                            beta = 1.0; //add
                            double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                           dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                           HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                         }
                      }
                   }
@@ -367,7 +367,7 @@ void CheMPS2::Heff::addDiagram5B(const int ikappa, double * memS, double * memHe
             int TwoSRdown = TwoSLdown;
                
             int fase = phase(TwoSL+TwoSR+2);
-            const double factor = fase * sqrt((TwoJ+1)*(TwoSR+1.0)) * gsl_sf_coupling_6j(1, 1, TwoJ, TwoSL, TwoSR, TwoSRdown);
+            const double factor = fase * sqrt((TwoJ+1)*(TwoSR+1.0)) * Wigner::wigner6j(1, 1, TwoJ, TwoSL, TwoSR, TwoSRdown);
            
             for (int Irrep=0; Irrep<(denBK->getNumberOfIrreps()); Irrep++){
                
@@ -396,14 +396,14 @@ void CheMPS2::Heff::addDiagram5B(const int ikappa, double * memS, double * memHe
                         if ((dimLdown>0) && (dimRdown>0)){
                              
                            int size = dimRup * dimRdown;
-                           for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                           HeffPlan::clear(size, temp);
                               
                            for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                               if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                  double prefac =         factor * ( Prob->gMxElement(l_alpha, theindex+1, theindex, l_beta) 
                                                + ((TwoJ==0)?1:-1) * Prob->gMxElement(l_alpha, theindex, theindex+1, l_beta) );
                                  double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
-                                 daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                 HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                               }
                            }
                                  
@@ -411,11 +411,11 @@ void CheMPS2::Heff::addDiagram5B(const int ikappa, double * memS, double * memHe
                            double beta = 0.0; //set
                            int memSkappa = denS->gKappa(NL+1, TwoSLdown, ILdown, 0, 0, 0, NR-1, TwoSRdown, IRdown);
                                 
-                           dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
+                           HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
                                  
                            beta = 1.0; //add
                            double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                           dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                           HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                         }
                      }
                   }
@@ -469,14 +469,14 @@ void CheMPS2::Heff::addDiagram5B(const int ikappa, double * memS, double * memHe
                            if ((dimLdown>0) && (dimRdown>0)){
                               
                               int size = dimRup * dimRdown;
-                              for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                              HeffPlan::clear(size, temp);
                               
                               for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                  if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                     double prefac = factor1 * Prob->gMxElement(l_alpha, theindex+1, theindex, l_beta) 
                                                   + factor2 * Prob->gMxElement(l_alpha, theindex, theindex+1, l_beta);
                                     double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
-                                    daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                    HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                                  }
                               }
                               
@@ -484,11 +484,11 @@ void CheMPS2::Heff::addDiagram5B(const int ikappa, double * memS, double * memHe
                               double beta = 0.0; //set
                               int memSkappa = denS->gKappa(NL+1, TwoSLdown, ILdown, 1, 0, 1, NR-1, TwoSRdown, IRdown);
                               
-                              dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
+                              HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
                               
                               beta = 1.0; //add
                               double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                              dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                              HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                            
                            }
                         }
@@ -543,14 +543,14 @@ void CheMPS2::Heff::addDiagram5B(const int ikappa, double * memS, double * memHe
                            if ((dimLdown>0) && (dimRdown>0)){
                               
                               int size = dimRup * dimRdown;
-                              for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                              HeffPlan::clear(size, temp);
                               
                               for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                  if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                     double prefac = factor1 * Prob->gMxElement(l_alpha, theindex+1, theindex, l_beta) 
                                                   + factor2 * Prob->gMxElement(l_alpha, theindex, theindex+1, l_beta);
                                     double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
-                                    daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                    HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                                  }
                               }
                               
@@ -558,11 +558,11 @@ void CheMPS2::Heff::addDiagram5B(const int ikappa, double * memS, double * memHe
                               double beta = 0.0; //set
                               int memSkappa = denS->gKappa(NL+1, TwoSLdown, ILdown, 0, 1, 1, NR-1, TwoSRdown, IRdown);
                               
-                              dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
+                              HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
                               
                               beta = 1.0; //add
                               double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                              dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                              HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                            
                            }
                         }
@@ -583,7 +583,7 @@ void CheMPS2::Heff::addDiagram5B(const int ikappa, double * memS, double * memHe
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                   int fase = (((TwoSLdown+1)%2)!=0)?-1:1;
-                  const double factor = fase * sqrt((TwoJdown+1)*(TwoSLdown+1.0)) * gsl_sf_coupling_6j(1, 1, TwoJdown, TwoSLdown, TwoSRdown, TwoSR);
+                  const double factor = fase * sqrt((TwoJdown+1)*(TwoSLdown+1.0)) * Wigner::wigner6j(1, 1, TwoJdown, TwoSLdown, TwoSRdown, TwoSR);
             
                   for (int Irrep=0; Irrep<(denBK->getNumberOfIrreps()); Irrep++){
                
@@ -612,14 +612,14 @@ void CheMPS2::Heff::addDiagram5B(const int ikappa, double * memS, double * memHe
                               if ((dimLdown>0) && (dimRdown>0)){
                               
                                  int size = dimRup * dimRdown;
-                                 for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                                 HeffPlan::clear(size, temp);
                               
                                  for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                     if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                        double prefac =             factor * ( Prob->gMxElement(l_alpha, theindex+1, theindex, l_beta) 
                                                      + ((TwoJdown==0)?1:-1) * Prob->gMxElement(l_alpha, theindex, theindex+1, l_beta) );
                                        double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
-                                       daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                       HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                                     }
                                  }
                               
@@ -627,11 +627,11 @@ void CheMPS2::Heff::addDiagram5B(const int ikappa, double * memS, double * memHe
                                  double beta = 0.0; //set
                                  int memSkappa = denS->gKappa(NL+1, TwoSLdown, ILdown, 1, 1, TwoJdown, NR-1, TwoSRdown, IRdown);
                               
-                                 dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
+                                 HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
                               
                                  beta = 1.0; //add
                                  double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                                 dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                                 HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                               }
                            }
                         }
@@ -677,7 +677,7 @@ void CheMPS2::Heff::addDiagram5C(const int ikappa, double * memS, double * memHe
             if ((abs(TwoSLdown-TwoSRdown)<=1) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                int fase = phase(TwoSL+TwoSRdown);
-               const double factor2 = fase * sqrt((TwoSL+1)*(TwoSR+1.0)) * gsl_sf_coupling_6j(TwoSLdown, TwoSRdown, 1, TwoSR, TwoSL, 1);
+               const double factor2 = fase * sqrt((TwoSL+1)*(TwoSR+1.0)) * Wigner::wigner6j(TwoSLdown, TwoSRdown, 1, TwoSR, TwoSL, 1);
                const double factor1 = (TwoSL==TwoSRdown)?sqrt((TwoSR+1.0)/(TwoSRdown+1.0)):0.0;
            
                for (int Irrep=0; Irrep<(denBK->getNumberOfIrreps()); Irrep++){
@@ -707,14 +707,14 @@ void CheMPS2::Heff::addDiagram5C(const int ikappa, double * memS, double * memHe
                            if ((dimLdown>0) && (dimRdown>0)){
                               
                               int size = dimRup * dimRdown;
-                              for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                              HeffPlan::clear(size, temp);
                               
                               for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                  if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                     double prefac = factor1 * Prob->gMxElement(l_alpha,theindex,theindex+1,l_beta)
                                                   + factor2 * Prob->gMxElement(l_alpha,theindex,l_beta,theindex+1);
                                     double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
-                                    daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                    HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                                  }
                               }
                               
@@ -722,11 +722,11 @@ void CheMPS2::Heff::addDiagram5C(const int ikappa, double * memS, double * memHe
                               double beta = 0.0; //set
                               int memSkappa = denS->gKappa(NL-1, TwoSLdown, ILdown, 0, 1, 1, NR-1, TwoSRdown, IRdown);
                              
-                              dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
+                              HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
                               
                               beta = 1.0; //add
                               double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                              dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                              HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                            }
                         }
                      }
@@ -746,7 +746,7 @@ void CheMPS2::Heff::addDiagram5C(const int ikappa, double * memS, double * memHe
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
                   int fase = phase(TwoSR + TwoSLdown + 3 + TwoJdown);
-                  const double factor1 = fase * sqrt((TwoSR+1)*(TwoJdown+1.0)) * gsl_sf_coupling_6j(1, 1, TwoJdown, TwoSLdown, TwoSRdown, TwoSR);
+                  const double factor1 = fase * sqrt((TwoSR+1)*(TwoJdown+1.0)) * Wigner::wigner6j(1, 1, TwoJdown, TwoSLdown, TwoSRdown, TwoSR);
                   const double factor2 = (TwoJdown==0)?sqrt(2.0*(TwoSR+1.0)/(TwoSRdown+1.0)):0.0;
             
                   for (int Irrep=0; Irrep<(denBK->getNumberOfIrreps()); Irrep++){
@@ -776,14 +776,14 @@ void CheMPS2::Heff::addDiagram5C(const int ikappa, double * memS, double * memHe
                               if ((dimLdown>0) && (dimRdown>0)){
                               
                                  int size = dimRup * dimRdown;
-                                 for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                                 HeffPlan::clear(size, temp);
                               
                                  for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                     if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                        double prefac = factor1 * Prob->gMxElement(l_alpha, theindex, theindex+1, l_beta) 
                                                      + factor2 * Prob->gMxElement(l_alpha, theindex, l_beta, theindex+1);
                                        double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
-                                       daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                       HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                                     }
                                  }
                               
@@ -791,11 +791,11 @@ void CheMPS2::Heff::addDiagram5C(const int ikappa, double * memS, double * memHe
                                  double beta = 0.0; //set
                                  int memSkappa = denS->gKappa(NL-1, TwoSLdown, ILdown, 1, 1, TwoJdown, NR-1, TwoSRdown, IRdown);
                               
-                                 dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
+                                 HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
                               
                                  beta = 1.0; //add
                                  double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                                 dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                                 HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                               }
                            }
                         }
@@ -815,7 +815,7 @@ void CheMPS2::Heff::addDiagram5C(const int ikappa, double * memS, double * memHe
             int TwoSRdown = TwoSLdown;
             
             int fase = phase(TwoSR + TwoSRdown + 3 + TwoJ);
-            double factor1 = fase * sqrt((TwoSL+1.0)*(TwoJ+1.0)*(TwoSR+1.0)/(TwoSRdown+1.0)) * gsl_sf_coupling_6j(1, 1, TwoJ, TwoSL, TwoSR, TwoSRdown);
+            double factor1 = fase * sqrt((TwoSL+1.0)*(TwoJ+1.0)*(TwoSR+1.0)/(TwoSRdown+1.0)) * Wigner::wigner6j(1, 1, TwoJ, TwoSL, TwoSR, TwoSRdown);
             double factor2 = (TwoJ==0)?sqrt(2.0*(TwoSR+1.0)/(TwoSRdown+1.0)):0.0;
             
             for (int Irrep=0; Irrep<(denBK->getNumberOfIrreps()); Irrep++){
@@ -845,14 +845,14 @@ void CheMPS2::Heff::addDiagram5C(const int ikappa, double * memS, double * memHe
                         if ((dimLdown>0) && (dimRdown>0)){
                              
                            int size = dimRup * dimRdown;
-                           for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                           HeffPlan::clear(size, temp);
                               
                            for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                               if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                  double prefac = factor1 * Prob->gMxElement(l_alpha, theindex, theindex+1, l_beta) 
                                                + factor2 * Prob->gMxElement(l_alpha, theindex, l_beta, theindex+1);
                                  double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
-                                 daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                 HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                               }
                            }
                                  
@@ -860,11 +860,11 @@ void CheMPS2::Heff::addDiagram5C(const int ikappa, double * memS, double * memHe
                            double beta = 0.0; //set
                            int memSkappa = denS->gKappa(NL-1, TwoSLdown, ILdown, 0, 2, 0, NR-1, TwoSRdown, IRdown);
                                
-                           dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
+                           HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
                                  
                            beta = 1.0; //add
                            double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                           dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                           HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                         }
                      }
                   }
@@ -882,7 +882,7 @@ void CheMPS2::Heff::addDiagram5C(const int ikappa, double * memS, double * memHe
             if ((abs(TwoSLdown-TwoSRdown)<=1) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                const double factor1 = (TwoSLdown==TwoSR) ? phase(TwoSL-TwoSRdown) * sqrt((TwoSL+1.0)/(TwoSLdown+1.0)) : 0.0;
-               const double factor2 = phase(TwoSL+TwoSRdown+2) * sqrt((TwoSL+1)*(TwoSR+1.0)) * gsl_sf_coupling_6j(TwoSLdown,TwoSRdown,1,TwoSR,TwoSL,1);
+               const double factor2 = phase(TwoSL+TwoSRdown+2) * sqrt((TwoSL+1)*(TwoSR+1.0)) * Wigner::wigner6j(TwoSLdown,TwoSRdown,1,TwoSR,TwoSL,1);
             
                for (int Irrep=0; Irrep<(denBK->getNumberOfIrreps()); Irrep++){
                
@@ -911,14 +911,14 @@ void CheMPS2::Heff::addDiagram5C(const int ikappa, double * memS, double * memHe
                            if ((dimLdown>0) && (dimRdown>0)){
                               
                               int size = dimRup * dimRdown;
-                              for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                              HeffPlan::clear(size, temp);
                               
                               for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                  if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                     double prefac = factor1 * Prob->gMxElement(l_alpha, theindex, theindex+1, l_beta) 
                                                   + factor2 * Prob->gMxElement(l_alpha, theindex, l_beta, theindex+1);
                                     double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
-                                    daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                    HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                                  }
                               }
                               
@@ -926,11 +926,11 @@ void CheMPS2::Heff::addDiagram5C(const int ikappa, double * memS, double * memHe
                               double beta = 0.0; //set
                               int memSkappa = denS->gKappa(NL-1, TwoSLdown, ILdown, 1, 2, 1, NR-1, TwoSRdown, IRdown);
                               
-                              dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
+                              HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
                               
                               beta = 1.0; //add
                               double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                              dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                              HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                            }
                         }
                      }
@@ -975,7 +975,7 @@ void CheMPS2::Heff::addDiagram5D(const int ikappa, double * memS, double * memHe
             if ((abs(TwoSLdown-TwoSRdown)<=1) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                int fase = phase(TwoSLdown+TwoSR);
-               const double factor2 = fase * sqrt((TwoSLdown+1)*(TwoSRdown+1.0)) * gsl_sf_coupling_6j(TwoSL, TwoSR, 1, TwoSRdown, TwoSLdown, 1);
+               const double factor2 = fase * sqrt((TwoSLdown+1)*(TwoSRdown+1.0)) * Wigner::wigner6j(TwoSL, TwoSR, 1, TwoSRdown, TwoSLdown, 1);
                const double factor1 = (TwoSLdown==TwoSR)?sqrt((TwoSRdown+1.0)/(TwoSR+1.0)):0.0;
            
                for (int Irrep=0; Irrep<(denBK->getNumberOfIrreps()); Irrep++){
@@ -1005,14 +1005,14 @@ void CheMPS2::Heff::addDiagram5D(const int ikappa, double * memS, double * memHe
                            if ((dimLdown>0) && (dimRdown>0)){
                               
                               int size = dimRup * dimRdown;
-                              for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                              HeffPlan::clear(size, temp);
                               
                               for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                  if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                     double prefac = factor1 * Prob->gMxElement(l_alpha,theindex,theindex+1,l_beta)
                                                   + factor2 * Prob->gMxElement(l_alpha,theindex,l_beta,theindex+1);
                                     double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
-                                    daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                    HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                                  }
                               }
                               
@@ -1020,11 +1020,11 @@ void CheMPS2::Heff::addDiagram5D(const int ikappa, double * memS, double * memHe
                               double beta = 0.0; //set
                               int memSkappa = denS->gKappa(NL+1, TwoSLdown, ILdown, 1, 0, 1, NR+1, TwoSRdown, IRdown);
                              
-                              dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
+                              HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
                               
                               beta = 1.0; //add
                               double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                              dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                              HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                            
                            }
                         }
@@ -1044,7 +1044,7 @@ void CheMPS2::Heff::addDiagram5D(const int ikappa, double * memS, double * memHe
             int TwoSRdown = TwoSLdown;
             
             int fase = phase(TwoSRdown + TwoSL + 3 + TwoJ);
-            const double factor1 = fase * sqrt((TwoSRdown+1)*(TwoJ+1.0)) * gsl_sf_coupling_6j(1, 1, TwoJ, TwoSL, TwoSR, TwoSRdown);
+            const double factor1 = fase * sqrt((TwoSRdown+1)*(TwoJ+1.0)) * Wigner::wigner6j(1, 1, TwoJ, TwoSL, TwoSR, TwoSRdown);
             const double factor2 = (TwoJ==0)?sqrt(2.0*(TwoSRdown+1.0)/(TwoSR+1.0)):0.0;
                
             for (int Irrep=0; Irrep<(denBK->getNumberOfIrreps()); Irrep++){
@@ -1074,14 +1074,14 @@ void CheMPS2::Heff::addDiagram5D(const int ikappa, double * memS, double * memHe
                         if ((dimLdown>0) && (dimRdown>0)){
                                  
                            int size = dimRup * dimRdown;
-                           for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                           HeffPlan::clear(size, temp);
                                  
                            for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                               if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                  double prefac = factor1 * Prob->gMxElement(l_alpha, theindex, theindex+1, l_beta) 
                                                + factor2 * Prob->gMxElement(l_alpha, theindex, l_beta, theindex+1);
                                  double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
-                                 daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                 HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                               }
                            }
                                 
@@ -1089,11 +1089,11 @@ void CheMPS2::Heff::addDiagram5D(const int ikappa, double * memS, double * memHe
                            double beta = 0.0; //set
                            int memSkappa = denS->gKappa(NL+1, TwoSLdown, ILdown, 2, 0, 0, NR+1, TwoSRdown, IRdown);
                                  
-                           dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
+                           HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
                                  
                            beta = 1.0; //add
                            double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                           dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                           HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                         }
                      }
                   }
@@ -1112,7 +1112,7 @@ void CheMPS2::Heff::addDiagram5D(const int ikappa, double * memS, double * memHe
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
                   int fase = phase(TwoSR + TwoSRdown + 3 + TwoJdown);
-                  double factor1 = fase * sqrt((TwoSLdown+1.0)*(TwoJdown+1.0)*(TwoSRdown+1.0)/(TwoSR+1.0)) * gsl_sf_coupling_6j(1, 1, TwoJdown, TwoSLdown, TwoSRdown, TwoSR);
+                  double factor1 = fase * sqrt((TwoSLdown+1.0)*(TwoJdown+1.0)*(TwoSRdown+1.0)/(TwoSR+1.0)) * Wigner::wigner6j(1, 1, TwoJdown, TwoSLdown, TwoSRdown, TwoSR);
                   double factor2 = (TwoJdown==0)?sqrt(2.0*(TwoSRdown+1.0)/(TwoSR+1.0)):0.0;
             
                   for (int Irrep=0; Irrep<(denBK->getNumberOfIrreps()); Irrep++){
@@ -1142,14 +1142,14 @@ void CheMPS2::Heff::addDiagram5D(const int ikappa, double * memS, double * memHe
                               if ((dimLdown>0) && (dimRdown>0)){
                               
                                  int size = dimRup * dimRdown;
-                                 for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                                 HeffPlan::clear(size, temp);
                               
                                  for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                     if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                        double prefac = factor1 * Prob->gMxElement(l_alpha, theindex, theindex+1, l_beta) 
                                                      + factor2 * Prob->gMxElement(l_alpha, theindex, l_beta, theindex+1);
                                        double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
-                                       daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                       HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                                     }
                                  }
                               
@@ -1157,11 +1157,11 @@ void CheMPS2::Heff::addDiagram5D(const int ikappa, double * memS, double * memHe
                                  double beta = 0.0; //set
                                  int memSkappa = denS->gKappa(NL+1, TwoSLdown, ILdown, 1, 1, TwoJdown, NR+1, TwoSRdown, IRdown);
                             
-                                 dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
+                                 HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
                               
                                  beta = 1.0; //add
                                  double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                                 dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                                 HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                               }
                            }
                         }
@@ -1181,7 +1181,7 @@ void CheMPS2::Heff::addDiagram5D(const int ikappa, double * memS, double * memHe
             if ((abs(TwoSLdown-TwoSRdown)<=1) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                const double factor1 = (TwoSL==TwoSRdown) ? phase(TwoSLdown-TwoSR) * sqrt((TwoSLdown+1.0)/(TwoSL+1.0)) : 0.0;
-               const double factor2 = phase(TwoSLdown+TwoSR+2) * sqrt((TwoSLdown+1)*(TwoSRdown+1.0)) * gsl_sf_coupling_6j(TwoSL,TwoSR,1,TwoSRdown,TwoSLdown,1);
+               const double factor2 = phase(TwoSLdown+TwoSR+2) * sqrt((TwoSLdown+1)*(TwoSRdown+1.0)) * Wigner::wigner6j(TwoSL,TwoSR,1,TwoSRdown,TwoSLdown,1);
             
                for (int Irrep=0; Irrep<(denBK->getNumberOfIrreps()); Irrep++){
                
@@ -1210,14 +1210,14 @@ void CheMPS2::Heff::addDiagram5D(const int ikappa, double * memS, double * memHe
                            if ((dimLdown>0) && (dimRdown>0)){
                               
                               int size = dimRup * dimRdown;
-                              for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                              HeffPlan::clear(size, temp);
                               
                               for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                  if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                     double prefac = factor1 * Prob->gMxElement(l_alpha, theindex, theindex+1, l_beta) 
                                                   + factor2 * Prob->gMxElement(l_alpha, theindex, l_beta, theindex+1);
                                     double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
-                                    daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                    HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                                  }
                               }
                               
@@ -1225,11 +1225,11 @@ void CheMPS2::Heff::addDiagram5D(const int ikappa, double * memS, double * memHe
                               double beta = 0.0; //set
                               int memSkappa = denS->gKappa(NL+1, TwoSLdown, ILdown, 2, 1, 1, NR+1, TwoSRdown, IRdown);
                               
-                              dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
+                              HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
                               
                               beta = 1.0; //add
                               double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                              dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                              HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                            }
                         }
                      }
@@ -1273,7 +1273,7 @@ void CheMPS2::Heff::addDiagram5E(const int ikappa, double * memS, double * memHe
          for (int TwoSRdown=TwoSR-1; TwoSRdown<=TwoSR+1; TwoSRdown+=2){
             if ((abs(TwoSLdown-TwoSRdown)<=1) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
-               const double factor2 = phase(TwoSL+TwoSRdown) * sqrt((TwoSL+1)*(TwoSR+1.0)) * gsl_sf_coupling_6j(TwoSLdown, TwoSRdown, 1, TwoSR, TwoSL, 1);
+               const double factor2 = phase(TwoSL+TwoSRdown) * sqrt((TwoSL+1)*(TwoSR+1.0)) * Wigner::wigner6j(TwoSLdown, TwoSRdown, 1, TwoSR, TwoSL, 1);
                const double factor1 = (TwoSL==TwoSRdown)?sqrt((TwoSR+1.0)/(TwoSRdown+1.0)):0.0;
            
                for (int Irrep=0; Irrep<(denBK->getNumberOfIrreps()); Irrep++){
@@ -1303,14 +1303,14 @@ void CheMPS2::Heff::addDiagram5E(const int ikappa, double * memS, double * memHe
                            if ((dimLdown>0) && (dimRdown>0)){
                               
                               int size = dimRup * dimRdown;
-                              for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                              HeffPlan::clear(size, temp);
                               
                               for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                  if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                     double prefac = factor1 * Prob->gMxElement(l_alpha,theindex+1,theindex,l_beta)
                                                   + factor2 * Prob->gMxElement(l_alpha,theindex,l_beta,theindex+1);
                                     double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
-                                    daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                    HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                                  }
                               }
                               
@@ -1318,11 +1318,11 @@ void CheMPS2::Heff::addDiagram5E(const int ikappa, double * memS, double * memHe
                               double beta = 0.0; //set
                               int memSkappa = denS->gKappa(NL-1, TwoSLdown, ILdown, 1, 0, 1, NR-1, TwoSRdown, IRdown);
                              
-                              dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
+                              HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
                               
                               beta = 1.0; //add
                               double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                              dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                              HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                            }
                         }
                      }
@@ -1342,7 +1342,7 @@ void CheMPS2::Heff::addDiagram5E(const int ikappa, double * memS, double * memHe
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
          
                   int fase = phase(TwoSR + TwoSLdown + 3);
-                  const double factor1 = fase * sqrt((TwoSR+1)*(TwoJdown+1.0)) * gsl_sf_coupling_6j(1, 1, TwoJdown, TwoSLdown, TwoSRdown, TwoSR);
+                  const double factor1 = fase * sqrt((TwoSR+1)*(TwoJdown+1.0)) * Wigner::wigner6j(1, 1, TwoJdown, TwoSLdown, TwoSRdown, TwoSR);
                   const double factor2 = (TwoJdown==0)?sqrt(2.0*(TwoSR+1.0)/(TwoSRdown+1.0)):0.0;
             
                   for (int Irrep=0; Irrep<(denBK->getNumberOfIrreps()); Irrep++){
@@ -1372,14 +1372,14 @@ void CheMPS2::Heff::addDiagram5E(const int ikappa, double * memS, double * memHe
                               if ((dimLdown>0) && (dimRdown>0)){
                               
                                  int size = dimRup * dimRdown;
-                                 for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                                 HeffPlan::clear(size, temp);
                               
                                  for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                     if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                        double prefac = factor1 * Prob->gMxElement(l_alpha, theindex+1, theindex, l_beta) 
                                                      + factor2 * Prob->gMxElement(l_alpha, theindex, l_beta, theindex+1);
                                        double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
-                                       daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                       HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                                     }
                                  }
                               
@@ -1387,11 +1387,11 @@ void CheMPS2::Heff::addDiagram5E(const int ikappa, double * memS, double * memHe
                                  double beta = 0.0; //set
                                  int memSkappa = denS->gKappa(NL-1, TwoSLdown, ILdown, 1, 1, TwoJdown, NR-1, TwoSRdown, IRdown);
                               
-                                 dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
+                                 HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
                               
                                  beta = 1.0; //add
                                  double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                                 dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                                 HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                               }
                            }
                         }
@@ -1411,7 +1411,7 @@ void CheMPS2::Heff::addDiagram5E(const int ikappa, double * memS, double * memHe
             int TwoSRdown = TwoSLdown;
             
             int fase = phase(TwoSR + TwoSRdown + 3);
-            double factor1 = fase * sqrt((TwoSL+1.0)*(TwoJ+1.0)*(TwoSR+1.0)/(TwoSRdown+1.0)) * gsl_sf_coupling_6j(1, 1, TwoJ, TwoSL, TwoSR, TwoSRdown);
+            double factor1 = fase * sqrt((TwoSL+1.0)*(TwoJ+1.0)*(TwoSR+1.0)/(TwoSRdown+1.0)) * Wigner::wigner6j(1, 1, TwoJ, TwoSL, TwoSR, TwoSRdown);
             double factor2 = (TwoJ==0)?sqrt(2.0*(TwoSR+1.0)/(TwoSRdown+1.0)):0.0;
                
             for (int Irrep=0; Irrep<(denBK->getNumberOfIrreps()); Irrep++){
@@ -1441,14 +1441,14 @@ void CheMPS2::Heff::addDiagram5E(const int ikappa, double * memS, double * memHe
                         if ((dimLdown>0) && (dimRdown>0)){
                                  
                            int size = dimRup * dimRdown;
-                           for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                           HeffPlan::clear(size, temp);
                                  
                            for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                               if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                  double prefac = factor1 * Prob->gMxElement(l_alpha, theindex+1, theindex, l_beta) 
                                                + factor2 * Prob->gMxElement(l_alpha, theindex, l_beta, theindex+1);
                                  double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
-                                 daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                 HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                               }
                            }
                                  
@@ -1456,11 +1456,11 @@ void CheMPS2::Heff::addDiagram5E(const int ikappa, double * memS, double * memHe
                            double beta = 0.0; //set
                            int memSkappa = denS->gKappa(NL-1, TwoSLdown, ILdown, 2, 0, 0, NR-1, TwoSRdown, IRdown);
                                
-                           dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
+                           HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
                                  
                            beta = 1.0; //add
                            double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                           dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                           HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                         }
                      }
                   }
@@ -1478,7 +1478,7 @@ void CheMPS2::Heff::addDiagram5E(const int ikappa, double * memS, double * memHe
             if ((abs(TwoSLdown-TwoSRdown)<=1) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                const double factor1 = (TwoSLdown==TwoSR) ? phase(TwoSL-TwoSRdown) * sqrt((TwoSL+1.0)/(TwoSLdown+1.0)) : 0.0;
-               const double factor2 = phase(TwoSL+TwoSRdown+2) * sqrt((TwoSL+1)*(TwoSR+1.0)) * gsl_sf_coupling_6j(TwoSLdown,TwoSRdown,1,TwoSR,TwoSL,1);
+               const double factor2 = phase(TwoSL+TwoSRdown+2) * sqrt((TwoSL+1)*(TwoSR+1.0)) * Wigner::wigner6j(TwoSLdown,TwoSRdown,1,TwoSR,TwoSL,1);
             
                for (int Irrep=0; Irrep<(denBK->getNumberOfIrreps()); Irrep++){
                
@@ -1507,14 +1507,14 @@ void CheMPS2::Heff::addDiagram5E(const int ikappa, double * memS, double * memHe
                            if ((dimLdown>0) && (dimRdown>0)){
                               
                               int size = dimRup * dimRdown;
-                              for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                              HeffPlan::clear(size, temp);
                               
                               for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                  if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                     double prefac = factor1 * Prob->gMxElement(l_alpha, theindex+1, theindex, l_beta) 
                                                   + factor2 * Prob->gMxElement(l_alpha, theindex, l_beta, theindex+1);
                                     double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR-1,TwoSRdown,IRdown,NR,TwoSR,IR);
-                                    daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                    HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                                  }
                               }
                                
@@ -1522,11 +1522,11 @@ void CheMPS2::Heff::addDiagram5E(const int ikappa, double * memS, double * memHe
                               double beta = 0.0; //set
                               int memSkappa = denS->gKappa(NL-1, TwoSLdown, ILdown, 2, 1, 1, NR-1, TwoSRdown, IRdown);
                               
-                              dgemm_(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
+                              HeffPlan::dgemm(&notrans,&notrans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRdown,&beta,temp2,&dimLdown);
                               
                               beta = 1.0; //add
                               double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL-1,TwoSLdown,ILdown,NL,TwoSL,IL);
-                              dgemm_(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                              HeffPlan::dgemm(&trans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLdown,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                            }
                         }
                      }
@@ -1570,7 +1570,7 @@ void CheMPS2::Heff::addDiagram5F(const int ikappa, double * memS, double * memHe
          for (int TwoSRdown=TwoSR-1; TwoSRdown<=TwoSR+1; TwoSRdown+=2){
             if ((abs(TwoSLdown-TwoSRdown)<=1) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
-               const double factor2 = phase(TwoSLdown+TwoSR) * sqrt((TwoSLdown+1)*(TwoSRdown+1.0)) * gsl_sf_coupling_6j(TwoSL, TwoSR, 1, TwoSRdown, TwoSLdown, 1);
+               const double factor2 = phase(TwoSLdown+TwoSR) * sqrt((TwoSLdown+1)*(TwoSRdown+1.0)) * Wigner::wigner6j(TwoSL, TwoSR, 1, TwoSRdown, TwoSLdown, 1);
                const double factor1 = (TwoSLdown==TwoSR)?sqrt((TwoSRdown+1.0)/(TwoSR+1.0)):0.0;
            
                for (int Irrep=0; Irrep<(denBK->getNumberOfIrreps()); Irrep++){
@@ -1600,14 +1600,14 @@ void CheMPS2::Heff::addDiagram5F(const int ikappa, double * memS, double * memHe
                            if ((dimLdown>0) && (dimRdown>0)){
                               
                               int size = dimRup * dimRdown;
-                              for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                              HeffPlan::clear(size, temp);
                               
                               for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                  if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                     double prefac = factor1 * Prob->gMxElement(l_alpha,theindex+1,theindex,l_beta)
                                                   + factor2 * Prob->gMxElement(l_alpha,theindex,l_beta,theindex+1);
                                     double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
-                                    daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                    HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                                  }
                               }
                               
@@ -1615,11 +1615,11 @@ void CheMPS2::Heff::addDiagram5F(const int ikappa, double * memS, double * memHe
                               double beta = 0.0; //set
                               int memSkappa = denS->gKappa(NL+1, TwoSLdown, ILdown, 0, 1, 1, NR+1, TwoSRdown, IRdown);
                              
-                              dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
+                              HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
                               
                               beta = 1.0; //add
                               double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                              dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                              HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                            }
                         }
                      }
@@ -1637,7 +1637,7 @@ void CheMPS2::Heff::addDiagram5F(const int ikappa, double * memS, double * memHe
          if ((TwoSLdown>=0) && (abs(TwoSR-TwoSLdown)<=1)){
             int TwoSRdown = TwoSLdown;
             
-            const double factor1 = phase(TwoSRdown + TwoSL + 3) * sqrt((TwoSRdown+1)*(TwoJ+1.0)) * gsl_sf_coupling_6j(1, 1, TwoJ, TwoSL, TwoSR, TwoSRdown);
+            const double factor1 = phase(TwoSRdown + TwoSL + 3) * sqrt((TwoSRdown+1)*(TwoJ+1.0)) * Wigner::wigner6j(1, 1, TwoJ, TwoSL, TwoSR, TwoSRdown);
             const double factor2 = (TwoJ==0)?sqrt(2.0*(TwoSRdown+1.0)/(TwoSR+1.0)):0.0;
                
             for (int Irrep=0; Irrep<(denBK->getNumberOfIrreps()); Irrep++){
@@ -1667,14 +1667,14 @@ void CheMPS2::Heff::addDiagram5F(const int ikappa, double * memS, double * memHe
                         if ((dimLdown>0) && (dimRdown>0)){
                            
                            int size = dimRup * dimRdown;
-                           for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                           HeffPlan::clear(size, temp);
                             
                            for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                               if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                  double prefac = factor1 * Prob->gMxElement(l_alpha, theindex+1, theindex, l_beta) 
                                                + factor2 * Prob->gMxElement(l_alpha, theindex, l_beta, theindex+1);
                                  double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
-                                 daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                 HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                               }
                            }
                              
@@ -1682,11 +1682,11 @@ void CheMPS2::Heff::addDiagram5F(const int ikappa, double * memS, double * memHe
                            double beta = 0.0; //set
                            int memSkappa = denS->gKappa(NL+1, TwoSLdown, ILdown, 0, 2, 0, NR+1, TwoSRdown, IRdown);
                               
-                           dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
+                           HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
                               
                            beta = 1.0; //add
                            double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                           dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                           HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                         }
                      }
                   }
@@ -1704,7 +1704,7 @@ void CheMPS2::Heff::addDiagram5F(const int ikappa, double * memS, double * memHe
             for (int TwoJdown=0; TwoJdown<=2; TwoJdown+=2){
                if ((abs(TwoSLdown-TwoSRdown)<=TwoJdown) && (TwoSLdown>=0) && (TwoSRdown>=0)){
                
-                  double factor1 = phase(TwoSR + TwoSRdown + 3) * sqrt((TwoSLdown+1.0)*(TwoJdown+1.0)*(TwoSRdown+1.0)/(TwoSR+1.0)) * gsl_sf_coupling_6j(1, 1, TwoJdown, TwoSLdown, TwoSRdown, TwoSR);
+                  double factor1 = phase(TwoSR + TwoSRdown + 3) * sqrt((TwoSLdown+1.0)*(TwoJdown+1.0)*(TwoSRdown+1.0)/(TwoSR+1.0)) * Wigner::wigner6j(1, 1, TwoJdown, TwoSLdown, TwoSRdown, TwoSR);
                   double factor2 = (TwoJdown==0)?sqrt(2.0*(TwoSRdown+1.0)/(TwoSR+1.0)):0.0;
             
                   for (int Irrep=0; Irrep<(denBK->getNumberOfIrreps()); Irrep++){
@@ -1734,14 +1734,14 @@ void CheMPS2::Heff::addDiagram5F(const int ikappa, double * memS, double * memHe
                               if ((dimLdown>0) && (dimRdown>0)){
                               
                                  int size = dimRup * dimRdown;
-                                 for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                                 HeffPlan::clear(size, temp);
                               
                                  for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                     if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                        double prefac = factor1 * Prob->gMxElement(l_alpha, theindex+1, theindex, l_beta) 
                                                      + factor2 * Prob->gMxElement(l_alpha, theindex, l_beta, theindex+1);
                                        double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
-                                       daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                       HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                                     }
                                  }
                               
@@ -1749,11 +1749,11 @@ void CheMPS2::Heff::addDiagram5F(const int ikappa, double * memS, double * memHe
                                  double beta = 0.0; //set
                                  int memSkappa = denS->gKappa(NL+1, TwoSLdown, ILdown, 1, 1, TwoJdown, NR+1, TwoSRdown, IRdown);
                             
-                                 dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
+                                 HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
                               
                                  beta = 1.0; //add
                                  double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                                 dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                                 HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                               }
                            }
                         }
@@ -1773,7 +1773,7 @@ void CheMPS2::Heff::addDiagram5F(const int ikappa, double * memS, double * memHe
             if ((abs(TwoSLdown-TwoSRdown)<=1) && (TwoSLdown>=0) && (TwoSRdown>=0)){
             
                const double factor1 = (TwoSL==TwoSRdown) ? phase(TwoSLdown-TwoSR) * sqrt((TwoSLdown+1.0)/(TwoSL+1.0)) : 0.0;
-               const double factor2 = phase(TwoSLdown+TwoSR+2) * sqrt((TwoSLdown+1)*(TwoSRdown+1.0)) * gsl_sf_coupling_6j(TwoSL,TwoSR,1,TwoSRdown,TwoSLdown,1);
+               const double factor2 = phase(TwoSLdown+TwoSR+2) * sqrt((TwoSLdown+1)*(TwoSRdown+1.0)) * Wigner::wigner6j(TwoSL,TwoSR,1,TwoSRdown,TwoSLdown,1);
             
                for (int Irrep=0; Irrep<(denBK->getNumberOfIrreps()); Irrep++){
                
@@ -1802,14 +1802,14 @@ void CheMPS2::Heff::addDiagram5F(const int ikappa, double * memS, double * memHe
                            if ((dimLdown>0) && (dimRdown>0)){
                               
                               int size = dimRup * dimRdown;
-                              for (int cnt=0; cnt<size; cnt++){ temp[cnt] = 0.0; }
+                              HeffPlan::clear(size, temp);
                               
                               for (int l_beta=theindex+2; l_beta<Prob->gL(); l_beta++){
                                  if (denBK->gIrrep(l_beta) == IrrepTimesMid){
                                     double prefac = factor1 * Prob->gMxElement(l_alpha, theindex+1, theindex, l_beta) 
                                                   + factor2 * Prob->gMxElement(l_alpha, theindex, l_beta, theindex+1);
                                     double * LblockR = Lright[l_beta-theindex-2]->gStorage(NR,TwoSR,IR,NR+1,TwoSRdown,IRdown);
-                                    daxpy_(&size,&prefac,LblockR,&inc,temp,&inc);
+                                    HeffPlan::daxpy(&size,&prefac,LblockR,&inc,temp,&inc);
                                  }
                               }
                               
@@ -1817,11 +1817,11 @@ void CheMPS2::Heff::addDiagram5F(const int ikappa, double * memS, double * memHe
                               double beta = 0.0; //set
                               int memSkappa = denS->gKappa(NL+1, TwoSLdown, ILdown, 1, 2, 1, NR+1, TwoSRdown, IRdown);
                               
-                              dgemm_(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
+                              HeffPlan::dgemm(&notrans,&trans,&dimLdown,&dimRup,&dimRdown,&alpha,memS+denS->gKappa2index(memSkappa),&dimLdown,temp,&dimRup,&beta,temp2,&dimLdown);
                               
                               beta = 1.0; //add
                               double * LblockL = Lleft[theindex-1-l_alpha]->gStorage(NL,TwoSL,IL,NL+1,TwoSLdown,ILdown);
-                              dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
+                              HeffPlan::dgemm(&notrans,&notrans,&dimLup,&dimRup,&dimLdown,&alpha,LblockL,&dimLup,temp2,&dimLdown,&beta,memHeff+denS->gKappa2index(ikappa),&dimLup);
                            }
                         }
                      }
@@ -0,0 +1,741 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <stdlib.h>
+#include <limits.h>
+#include <iostream>
+#include <omp.h>
+
+#include "HeffPlan.h"
+#include "ScratchArena.h"
+#include "Lapack.h"
+#include "Options.h"
+
+using std::cout;
+using std::endl;
+
+//The recording state of the calling thread: the plan, the block, and the base pointers and sizes of the buffers
+static CheMPS2::HeffPlan * HeffPlan_recorder = NULL;
+static int HeffPlan_recordKappa = 0;
+static double * HeffPlan_recordBase[5];
+static int HeffPlan_recordSize[5];
+#pragma omp threadprivate(HeffPlan_recorder, HeffPlan_recordKappa, HeffPlan_recordBase, HeffPlan_recordSize)
+
+CheMPS2::HeffPlan::HeffPlan(const Sobject * denSIn, const int workSizeIn){
+
+   denS = denSIn;
+   nKappa = denS->gNKappa();
+   vectorSize = denS->gKappa2index(nKappa);
+   workSize = workSizeIn;
+
+   recordingDone = false;
+   recorded = false;
+
+   recordTasks = new HeffTask*[nKappa];
+   recordNum = new int[nKappa];
+   recordAlloc = new int[nKappa];
+   for (int ikappa=0; ikappa<nKappa; ikappa++){
+      recordTasks[ikappa] = NULL;
+      recordNum[ikappa] = 0;
+      recordAlloc[ikappa] = 0;
+   }
+
+   tasks = NULL;
+   kappa2task = NULL;
+   constants = NULL;
+
+   nItems = 0;
+   itemFirst = NULL;
+   itemLast = NULL;
+   nSplit = 0;
+   splitKappa = NULL;
+   splitParts = NULL;
+   splitOffset = NULL;
+   partialSize = 0;
+   partialVectors = 0;
+   partial = NULL;
+
+}
+
+CheMPS2::HeffPlan::~HeffPlan(){
+
+   if (recordTasks != NULL){
+      for (int ikappa=0; ikappa<nKappa; ikappa++){
+         if (recordTasks[ikappa] != NULL){ delete [] recordTasks[ikappa]; }
+      }
+      delete [] recordTasks;
+      delete [] recordNum;
+      delete [] recordAlloc;
+   }
+   if (tasks != NULL){ delete [] tasks; }
+   if (kappa2task != NULL){ delete [] kappa2task; }
+   if (constants != NULL){ delete [] constants; }
+   if (itemFirst != NULL){ delete [] itemFirst; }
+   if (itemLast != NULL){ delete [] itemLast; }
+   if (splitKappa != NULL){ delete [] splitKappa; }
+   if (splitParts != NULL){ delete [] splitParts; }
+   if (splitOffset != NULL){ delete [] splitOffset; }
+   if (partial != NULL){ delete [] partial; }
+
+}
+
+bool CheMPS2::HeffPlan::needsRecording() const{ return !recordingDone; }
+
+bool CheMPS2::HeffPlan::isRecorded() const{ return recorded; }
+
+int CheMPS2::HeffPlan::gNumTasks() const{ return ((recorded) ? kappa2task[nKappa] : 0); }
+
+void CheMPS2::HeffPlan::startRecording(const int ikappa, double * memS, double * memHeff, double * temp, double * temp2){
+
+   HeffPlan_recorder = this;
+   HeffPlan_recordKappa = ikappa;
+
+   HeffPlan_recordBase[HEFFPLAN_ABSOLUTE] = NULL;
+   HeffPlan_recordBase[HEFFPLAN_MEMS]     = memS;
+   HeffPlan_recordBase[HEFFPLAN_MEMHEFF]  = memHeff;
+   HeffPlan_recordBase[HEFFPLAN_TEMP]     = temp;
+   HeffPlan_recordBase[HEFFPLAN_TEMP2]    = temp2;
+
+   HeffPlan_recordSize[HEFFPLAN_ABSOLUTE] = 0;
+   HeffPlan_recordSize[HEFFPLAN_MEMS]     = vectorSize;
+   HeffPlan_recordSize[HEFFPLAN_MEMHEFF]  = vectorSize;
+   HeffPlan_recordSize[HEFFPLAN_TEMP]     = workSize;
+   HeffPlan_recordSize[HEFFPLAN_TEMP2]    = workSize;
+
+}
+
+void CheMPS2::HeffPlan::stopRecording(){
+
+   HeffPlan_recorder = NULL;
+
+}
+
+void CheMPS2::HeffPlan::finalizeRecording(){
+
+   recordingDone = true;
+
+   int numTasks = 0;
+   int poolSize = 0;
+   for (int ikappa=0; ikappa<nKappa; ikappa++){ countFolded(recordTasks[ikappa], recordNum[ikappa], numTasks, poolSize); }
+
+   const double sizeMB = ( sizeof(HeffTask) * ((double) numTasks) + sizeof(int) * (nKappa + 1.0) + sizeof(double) * ((double) poolSize) ) / 1048576.0;
+   if (sizeMB <= CheMPS2::HEFF_contractionPlanMaxMB){
+      tasks = new HeffTask[numTasks];
+      kappa2task = new int[nKappa+1];
+      constants = new double[(poolSize>0) ? poolSize : 1];
+      int taskCnt = 0;
+      int poolCnt = 0;
+      kappa2task[0] = 0;
+      for (int ikappa=0; ikappa<nKappa; ikappa++){
+         const HeffTask * list = recordTasks[ikappa];
+         int start = 0;
+         while (start < recordNum[ikappa]){
+            const int length = chainLength(list, recordNum[ikappa], start);
+            if (length == 0){
+               tasks[taskCnt] = list[start];
+               start++;
+            } else {
+               //Evaluate the chain in the same order as the diagrams did, and replace it by a copy from the constant pool
+               const int size = list[start].m;
+               double * pool = constants + poolCnt;
+               if (list[start].type == HEFFPLAN_COPY){ for (int cnt=0; cnt<size; cnt++){ pool[cnt] = list[start].absolute[0][cnt]; } }
+               else { for (int cnt=0; cnt<size; cnt++){ pool[cnt] = 0.0; } }
+               for (int link=start+1; link<start+length; link++){
+                  int inc = 1;
+                  int sizeCopy = size;
+                  double alpha = list[link].alpha;
+                  daxpy_(&sizeCopy, &alpha, list[link].absolute[0], &inc, pool, &inc);
+               }
+               tasks[taskCnt] = list[start];
+               tasks[taskCnt].type = HEFFPLAN_COPY;
+               tasks[taskCnt].alpha = 1.0;
+               tasks[taskCnt].ld[0] = 1;
+               tasks[taskCnt].buffer[0] = HEFFPLAN_CONSTANT;
+               tasks[taskCnt].offset[0] = poolCnt;
+               tasks[taskCnt].absolute[0] = NULL;
+               poolCnt += size;
+               start += length;
+            }
+            classify(tasks[taskCnt]);
+            taskCnt++;
+         }
+         kappa2task[ikappa+1] = taskCnt;
+      }
+      schedule();
+      recorded = true;
+   } else {
+      if (CheMPS2::HEFF_debugPrint){ cout << "   HeffPlan : the contraction schedule (" << sizeMB << " MB) exceeds HEFF_contractionPlanMaxMB and is discarded." << endl; }
+   }
+
+   for (int ikappa=0; ikappa<nKappa; ikappa++){
+      if (recordTasks[ikappa] != NULL){ delete [] recordTasks[ikappa]; }
+   }
+   delete [] recordTasks;
+   delete [] recordNum;
+   delete [] recordAlloc;
+   recordTasks = NULL;
+   recordNum = NULL;
+   recordAlloc = NULL;
+
+}
+
+int CheMPS2::HeffPlan::chainLength(const HeffTask * list, const int num, const int start){
+
+   const HeffTask & first = list[start];
+   const bool copyStart  = (first.type == HEFFPLAN_COPY) && (first.buffer[0] == HEFFPLAN_ABSOLUTE) && (first.ld[0] == 1);
+   const bool clearStart = (first.type == HEFFPLAN_CLEAR);
+   if ((!copyStart) && (!clearStart)){ return 0; }
+   if ((first.buffer[2] == HEFFPLAN_ABSOLUTE) || (first.ld[2] != 1)){ return 0; }
+
+   int length = 1;
+   while (start + length < num){
+      const HeffTask & link = list[start + length];
+      if ((link.type != HEFFPLAN_AXPY) || (link.buffer[0] != HEFFPLAN_ABSOLUTE) || (link.ld[0] != 1) || (link.ld[2] != 1)){ break; }
+      if ((link.buffer[2] != first.buffer[2]) || (link.offset[2] != first.offset[2]) || (link.m != first.m)){ break; }
+      length++;
+   }
+
+   return ((length >= 2) ? length : 0);
+
+}
+
+void CheMPS2::HeffPlan::countFolded(const HeffTask * list, const int num, int & numTasks, int & poolSize){
+
+   int start = 0;
+   while (start < num){
+      const int length = chainLength(list, num, start);
+      if (length == 0){ start++; }
+      else {
+         poolSize += list[start].m;
+         start += length;
+      }
+      numTasks++;
+   }
+
+}
+
+void CheMPS2::HeffPlan::classify(HeffTask & task){
+
+   if ((task.type == HEFFPLAN_GEMM) && (((double) task.m) * task.n * task.k <= CheMPS2::HEFF_smallGemmCutoff)){ task.type = HEFFPLAN_SMALLGEMM; }
+   if ((task.type == HEFFPLAN_AXPY) && (task.ld[0] == 1) && (task.ld[2] == 1) && (task.m <= CheMPS2::HEFF_smallVectorCutoff)){ task.type = HEFFPLAN_SMALLAXPY; }
+   if ((task.type == HEFFPLAN_COPY) && (task.ld[0] == 1) && (task.ld[2] == 1) && (task.m <= CheMPS2::HEFF_smallVectorCutoff)){ task.type = HEFFPLAN_SMALLCOPY; }
+
+}
+
+void CheMPS2::HeffPlan::append(const HeffTask & task){
+
+   const int ikappa = HeffPlan_recordKappa;
+   if (recordNum[ikappa] == recordAlloc[ikappa]){
+      const int newAlloc = (recordAlloc[ikappa]==0) ? 64 : 2*recordAlloc[ikappa];
+      HeffTask * newTasks = new HeffTask[newAlloc];
+      for (int cnt=0; cnt<recordNum[ikappa]; cnt++){ newTasks[cnt] = recordTasks[ikappa][cnt]; }
+      if (recordTasks[ikappa] != NULL){ delete [] recordTasks[ikappa]; }
+      recordTasks[ikappa] = newTasks;
+      recordAlloc[ikappa] = newAlloc;
+   }
+   recordTasks[ikappa][recordNum[ikappa]] = task;
+   recordNum[ikappa]++;
+
+}
+
+void CheMPS2::HeffPlan::locate(double * ptr, unsigned char & buffer, int & offset, double *& absolute){
+
+   for (int buf=HEFFPLAN_MEMS; buf<=HEFFPLAN_TEMP2; buf++){
+      if ((HeffPlan_recordBase[buf] != NULL) && (ptr >= HeffPlan_recordBase[buf]) && (ptr < HeffPlan_recordBase[buf] + HeffPlan_recordSize[buf])){
+         buffer = buf;
+         offset = ptr - HeffPlan_recordBase[buf];
+         absolute = NULL;
+         return;
+      }
+   }
+
+   //Not in the Sobject vectors or the work arrays --> a constant operator block
+   buffer = HEFFPLAN_ABSOLUTE;
+   offset = 0;
+   absolute = ptr;
+
+}
+
+double * CheMPS2::HeffPlan::resolve(const HeffTask & task, const int operand, double ** bases){
+
+   if (task.buffer[operand] == HEFFPLAN_ABSOLUTE){ return task.absolute[operand]; }
+   return bases[task.buffer[operand]] + task.offset[operand];
+
+}
+
+void CheMPS2::HeffPlan::recordGemm(char * transA, char * transB, int * m, int * n, int * k, double * alpha, double * A, int * lda, double * B, int * ldb, double * beta, double * C, int * ldc){
+
+   HeffTask task;
+   task.type   = HEFFPLAN_GEMM;
+   task.transA = *transA;
+   task.transB = *transB;
+   task.m      = *m;
+   task.n      = *n;
+   task.k      = *k;
+   task.ld[0]  = *lda;
+   task.ld[1]  = *ldb;
+   task.ld[2]  = *ldc;
+   task.alpha  = *alpha;
+   task.beta   = *beta;
+   locate(A, task.buffer[0], task.offset[0], task.absolute[0]);
+   locate(B, task.buffer[1], task.offset[1], task.absolute[1]);
+   locate(C, task.buffer[2], task.offset[2], task.absolute[2]);
+   HeffPlan_recorder->append(task);
+
+}
+
+void CheMPS2::HeffPlan::recordVector(const int type, const int n, const double alpha, double * x, const int incx, double * y, const int incy){
+
+   HeffTask task;
+   task.type   = type;
+   task.transA = 'N';
+   task.transB = 'N';
+   task.m      = n;
+   task.n      = 1;
+   task.k      = 1;
+   task.ld[0]  = incx;
+   task.ld[1]  = 1;
+   task.ld[2]  = incy;
+   task.alpha  = alpha;
+   task.beta   = 1.0;
+   if (x != NULL){ locate(x, task.buffer[0], task.offset[0], task.absolute[0]); }
+   else {
+      task.buffer[0] = HEFFPLAN_ABSOLUTE;
+      task.offset[0] = 0;
+      task.absolute[0] = NULL;
+   }
+   task.buffer[1] = HEFFPLAN_ABSOLUTE;
+   task.offset[1] = 0;
+   task.absolute[1] = NULL;
+   locate(y, task.buffer[2], task.offset[2], task.absolute[2]);
+   HeffPlan_recorder->append(task);
+
+}
+
+void CheMPS2::HeffPlan::dgemm(char * transA, char * transB, int * m, int * n, int * k, double * alpha, double * A, int * lda, double * B, int * ldb, double * beta, double * C, int * ldc){
+
+   dgemm_(transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+   if (HeffPlan_recorder != NULL){ recordGemm(transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc); }
+
+}
+
+void CheMPS2::HeffPlan::daxpy(int * n, double * alpha, double * x, int * incx, double * y, int * incy){
+
+   daxpy_(n, alpha, x, incx, y, incy);
+   if (HeffPlan_recorder != NULL){ recordVector(HEFFPLAN_AXPY, *n, *alpha, x, *incx, y, *incy); }
+
+}
+
+void CheMPS2::HeffPlan::dcopy(int * n, double * x, int * incx, double * y, int * incy){
+
+   dcopy_(n, x, incx, y, incy);
+   if (HeffPlan_recorder != NULL){ recordVector(HEFFPLAN_COPY, *n, 1.0, x, *incx, y, *incy); }
+
+}
+
+void CheMPS2::HeffPlan::clear(const int size, double * vec){
+
+   for (int cnt=0; cnt<size; cnt++){ vec[cnt] = 0.0; }
+   if (HeffPlan_recorder != NULL){ recordVector(HEFFPLAN_CLEAR, size, 0.0, NULL, 1, vec, 1); }
+
+}
+
+void CheMPS2::HeffPlan::execute(double * memS, double * memHeff){
+
+   execute(1, &memS, &memHeff);
+
+}
+
+void CheMPS2::HeffPlan::execute(const int nVec, double ** memS, double ** memHeff){
+
+   if ((nSplit > 0) && (partialVectors < nVec)){
+      if (partial != NULL){ delete [] partial; }
+      partial = new double[nVec * partialSize];
+      partialVectors = nVec;
+   }
+
+   //PARALLEL
+   #pragma omp parallel for schedule(dynamic)
+   for (int item=0; item<nItems; item++){
+
+      //The buffers of vector ivec are bases[HEFFPLAN_NUMBUFFERS * ivec + buffer]
+      double * temp = ScratchArena::get(0, 2 * nVec * workSize);
+      double ** bases = ScratchArena::getPointers(HEFFPLAN_NUMBUFFERS * nVec);
+      for (int ivec=0; ivec<nVec; ivec++){
+         bases[HEFFPLAN_NUMBUFFERS * ivec + HEFFPLAN_ABSOLUTE] = NULL;
+         bases[HEFFPLAN_NUMBUFFERS * ivec + HEFFPLAN_MEMS]     = memS[ivec];
+         bases[HEFFPLAN_NUMBUFFERS * ivec + HEFFPLAN_MEMHEFF]  = memHeff[ivec];
+         bases[HEFFPLAN_NUMBUFFERS * ivec + HEFFPLAN_TEMP]     = temp + 2 * ivec * workSize;
+         bases[HEFFPLAN_NUMBUFFERS * ivec + HEFFPLAN_TEMP2]    = temp + (2 * ivec + 1) * workSize;
+         bases[HEFFPLAN_NUMBUFFERS * ivec + HEFFPLAN_CONSTANT] = constants;
+         bases[HEFFPLAN_NUMBUFFERS * ivec + HEFFPLAN_PARTIAL]  = partial + ivec * partialSize;
+      }
+
+      //Each task is applied to all vectors before moving on, so that its operator blocks are reused while they are in cache
+      for (int itask=itemFirst[item]; itask<itemLast[item]; itask++){
+
+         const HeffTask & task = tasks[itask];
+         int size = task.m;
+         int incx = task.ld[0];
+         int incy = task.ld[2];
+         double alpha = task.alpha;
+
+         for (int ivec=0; ivec<nVec; ivec++){
+
+            double ** vecBases = bases + HEFFPLAN_NUMBUFFERS * ivec;
+            double * out = resolve(task, 2, vecBases);
+
+            switch(task.type){
+               case HEFFPLAN_GEMM:
+                  {
+                     char transA = task.transA;
+                     char transB = task.transB;
+                     int m = task.m;
+                     int n = task.n;
+                     int k = task.k;
+                     int lda = task.ld[0];
+                     int ldb = task.ld[1];
+                     int ldc = task.ld[2];
+                     double beta = task.beta;
+                     dgemm_(&transA, &transB, &m, &n, &k, &alpha, resolve(task, 0, vecBases), &lda, resolve(task, 1, vecBases), &ldb, &beta, out, &ldc);
+                  }
+                  break;
+               case HEFFPLAN_AXPY:
+                  daxpy_(&size, &alpha, resolve(task, 0, vecBases), &incx, out, &incy);
+                  break;
+               case HEFFPLAN_COPY:
+                  dcopy_(&size, resolve(task, 0, vecBases), &incx, out, &incy);
+                  break;
+               case HEFFPLAN_CLEAR:
+                  for (int cnt=0; cnt<size; cnt++){ out[cnt] = 0.0; }
+                  break;
+               case HEFFPLAN_SMALLGEMM:
+                  smallGemm(task.transA, task.transB, task.m, task.n, task.k, alpha, resolve(task, 0, vecBases), task.ld[0], resolve(task, 1, vecBases), task.ld[1], task.beta, out, task.ld[2]);
+                  break;
+               case HEFFPLAN_SMALLAXPY:
+                  smallAxpy(size, alpha, resolve(task, 0, vecBases), out);
+                  break;
+               case HEFFPLAN_SMALLCOPY:
+                  {
+                     const double * in = resolve(task, 0, vecBases);
+                     for (int cnt=0; cnt<size; cnt++){ out[cnt] = in[cnt]; }
+                  }
+                  break;
+            }
+         }
+      }
+
+   }
+
+   //Add the partial results of the split blocks, always in the same order
+   #pragma omp parallel for schedule(dynamic)
+   for (int isplit=0; isplit<nSplit; isplit++){
+      const int ikappa = splitKappa[isplit];
+      int size = denS->gKappa2index(ikappa+1) - denS->gKappa2index(ikappa);
+      int inc = 1;
+      double one = 1.0;
+      for (int ivec=0; ivec<nVec; ivec++){
+         for (int part=1; part<splitParts[isplit]; part++){
+            daxpy_(&size, &one, partial + ivec * partialSize + splitOffset[isplit] + (part-1) * size, &inc, memHeff[ivec] + denS->gKappa2index(ikappa), &inc);
+         }
+      }
+   }
+
+}
+
+double CheMPS2::HeffPlan::cost(const HeffTask & task){
+
+   //A call costs about as much as 64 flops
+   const double overhead = 64.0;
+   if ((task.type == HEFFPLAN_GEMM) || (task.type == HEFFPLAN_SMALLGEMM)){ return overhead + 2.0 * task.m * task.n * task.k; }
+   return overhead + task.m;
+
+}
+
+void CheMPS2::HeffPlan::operandRange(const HeffTask & task, const int operand, int & lower, int & upper){
+
+   int rows = 1;
+   int cols = task.m; //Vectors are cols elements with increment ld
+   if ((task.type == HEFFPLAN_GEMM) || (task.type == HEFFPLAN_SMALLGEMM)){
+      if (operand == 0){
+         rows = (task.transA == 'N') ? task.m : task.k;
+         cols = (task.transA == 'N') ? task.k : task.m;
+      }
+      if (operand == 1){
+         rows = (task.transB == 'N') ? task.k : task.n;
+         cols = (task.transB == 'N') ? task.n : task.k;
+      }
+      if (operand == 2){
+         rows = task.m;
+         cols = task.n;
+      }
+   }
+
+   lower = task.offset[operand];
+   if ((rows <= 0) || (cols <= 0)){ upper = lower; }
+   else if (task.ld[operand] <= 0){ //Negative increments: assume the whole buffer
+      lower = 0;
+      upper = INT_MAX;
+   } else {
+      upper = lower + task.ld[operand] * (cols - 1) + rows;
+   }
+
+}
+
+int CheMPS2::HeffPlan::findCuts(const int ikappa, const double target, int * cuts) const{
+
+   const int first = kappa2task[ikappa];
+   const int num = kappa2task[ikappa+1] - first;
+   const int blockStart = denS->gKappa2index(ikappa);
+   const int blockEnd = denS->gKappa2index(ikappa+1);
+
+   //A cut before task first+pos is only allowed when no work array value is written before and read after it (crossing[pos] == 0 after the prefix sum), and when all later writes to memHeff accumulate
+   int * crossing = new int[num+1];
+   for (int pos=0; pos<=num; pos++){ crossing[pos] = 0; }
+   int lastOverwrite = 0;
+   bool splittable = true;
+
+   for (int pos=0; (pos<num) && (splittable); pos++){
+
+      const HeffTask & task = tasks[first+pos];
+      const bool isGemm = (task.type == HEFFPLAN_GEMM) || (task.type == HEFFPLAN_SMALLGEMM);
+      const bool isAxpy = (task.type == HEFFPLAN_AXPY) || (task.type == HEFFPLAN_SMALLAXPY);
+      const int numInputs = (isGemm) ? 2 : ((task.type == HEFFPLAN_CLEAR) ? 0 : 1);
+      const bool readsOutput = (isAxpy) || ((isGemm) && (task.beta != 0.0));
+
+      if (task.buffer[2] == HEFFPLAN_MEMHEFF){
+         int lower, upper;
+         operandRange(task, 2, lower, upper);
+         if ((lower < blockStart) || (upper > blockEnd)){ splittable = false; }
+         if (!((isAxpy) || ((isGemm) && (task.beta == 1.0)))){ lastOverwrite = pos; }
+      }
+
+      for (int operand=0; operand<3; operand++){
+         const bool isRead = (operand < numInputs) || ((operand == 2) && (readsOutput));
+         if (!isRead){ continue; }
+         const unsigned char buffer = task.buffer[operand];
+         if ((buffer == HEFFPLAN_MEMHEFF) && (operand < 2)){ splittable = false; }
+         if ((buffer != HEFFPLAN_TEMP) && (buffer != HEFFPLAN_TEMP2)){ continue; }
+         int lower, upper;
+         operandRange(task, operand, lower, upper);
+         //Every earlier write which overlaps, up to the first one which covers the range, is a value which has to stay in the same item
+         for (int prev=pos-1; prev>=0; prev--){
+            const HeffTask & writer = tasks[first+prev];
+            if (writer.buffer[2] != buffer){ continue; }
+            int wLower, wUpper;
+            operandRange(writer, 2, wLower, wUpper);
+            if ((wUpper <= lower) || (upper <= wLower)){ continue; }
+            crossing[prev+1]++;
+            crossing[pos+1]--;
+            if ((wLower <= lower) && (upper <= wUpper)){ break; }
+         }
+      }
+
+   }
+
+   //Cut greedily after about target cost
+   int numCuts = 0;
+   if (splittable){
+      double accumulated = 0.0;
+      int live = 0;
+      for (int pos=1; pos<num; pos++){
+         accumulated += cost(tasks[first+pos-1]);
+         live += crossing[pos];
+         if ((accumulated >= target) && (live == 0) && (pos > lastOverwrite)){
+            cuts[numCuts] = first + pos;
+            numCuts++;
+            accumulated = 0.0;
+         }
+      }
+   }
+
+   delete [] crossing;
+   return numCuts;
+
+}
+
+static int HeffPlan_compareItems(const void * a, const void * b){
+
+   const double costA = ((const double *) a)[0];
+   const double costB = ((const double *) b)[0];
+   return ((costA > costB) ? -1 : ((costA < costB) ? 1 : 0));
+
+}
+
+void CheMPS2::HeffPlan::schedule(){
+
+   const int numTasks = kappa2task[nKappa];
+   double total = 0.0;
+   for (int itask=0; itask<numTasks; itask++){ total += cost(tasks[itask]); }
+
+   //The part boundaries per block: parts of block ikappa start at cuts[firstCut[ikappa]] to cuts[firstCut[ikappa+1]-1]
+   const int numThreads = omp_get_max_threads();
+   const double target = total / (CheMPS2::HEFF_itemsPerThread * numThreads);
+   int * cuts = new int[numTasks + nKappa];
+   int * firstCut = new int[nKappa+1];
+   int numCuts = 0;
+   nSplit = 0;
+   for (int ikappa=0; ikappa<nKappa; ikappa++){
+      firstCut[ikappa] = numCuts;
+      cuts[numCuts] = kappa2task[ikappa];
+      numCuts++;
+      double blockCost = 0.0;
+      for (int itask=kappa2task[ikappa]; itask<kappa2task[ikappa+1]; itask++){ blockCost += cost(tasks[itask]); }
+      if ((numThreads > 1) && (blockCost > target)){
+         const int extra = findCuts(ikappa, target, cuts + numCuts);
+         numCuts += extra;
+         if (extra > 0){ nSplit++; }
+      }
+   }
+   firstCut[nKappa] = numCuts;
+
+   //Rebuild the task list: every part beyond the first clears its partial result, and accumulates into it instead of memHeff
+   nItems = numCuts;
+   itemFirst = new int[nItems];
+   itemLast = new int[nItems];
+   double * itemSort = new double[3 * nItems]; //cost, first, last
+   if (nSplit > 0){
+      splitKappa = new int[nSplit];
+      splitParts = new int[nSplit];
+      splitOffset = new int[nSplit];
+   }
+   HeffTask * newTasks = (nSplit > 0) ? new HeffTask[numTasks + numCuts - nKappa] : tasks;
+   int taskCnt = 0;
+   int isplit = 0;
+   partialSize = 0;
+   for (int ikappa=0; ikappa<nKappa; ikappa++){
+      const int blockStart = denS->gKappa2index(ikappa);
+      const int blockSize = denS->gKappa2index(ikappa+1) - blockStart;
+      const int numParts = firstCut[ikappa+1] - firstCut[ikappa];
+      if (numParts > 1){
+         splitKappa[isplit] = ikappa;
+         splitParts[isplit] = numParts;
+         splitOffset[isplit] = partialSize;
+         isplit++;
+      }
+      const int oldLast = kappa2task[ikappa+1];
+      kappa2task[ikappa] = taskCnt;
+      for (int part=0; part<numParts; part++){
+         const int item = firstCut[ikappa] + part;
+         const int from = cuts[item];
+         const int upto = (part+1 < numParts) ? cuts[item+1] : oldLast;
+         itemSort[3*item+1] = taskCnt;
+         itemSort[3*item] = 0.0;
+         if (part > 0){
+            HeffTask & clearTask = newTasks[taskCnt];
+            clearTask = tasks[from];
+            clearTask.type = HEFFPLAN_CLEAR;
+            clearTask.m = blockSize;
+            clearTask.n = 1;
+            clearTask.k = 1;
+            clearTask.ld[2] = 1;
+            clearTask.buffer[2] = HEFFPLAN_PARTIAL;
+            clearTask.offset[2] = partialSize;
+            clearTask.absolute[2] = NULL;
+            itemSort[3*item] += cost(clearTask);
+            taskCnt++;
+         }
+         for (int itask=from; itask<upto; itask++){
+            if (nSplit > 0){ newTasks[taskCnt] = tasks[itask]; }
+            if ((part > 0) && (newTasks[taskCnt].buffer[2] == HEFFPLAN_MEMHEFF)){
+               newTasks[taskCnt].buffer[2] = HEFFPLAN_PARTIAL;
+               newTasks[taskCnt].offset[2] += partialSize - blockStart;
+            }
+            itemSort[3*item] += cost(newTasks[taskCnt]);
+            taskCnt++;
+         }
+         itemSort[3*item+2] = taskCnt;
+         if (part > 0){ partialSize += blockSize; }
+      }
+   }
+   kappa2task[nKappa] = taskCnt;
+   if (nSplit > 0){
+      delete [] tasks;
+      tasks = newTasks;
+   }
+
+   //Largest items first, so that the most expensive work does not end up in the tail of the parallel loop
+   qsort(itemSort, nItems, 3 * sizeof(double), HeffPlan_compareItems);
+   for (int item=0; item<nItems; item++){
+      itemFirst[item] = (int) itemSort[3*item+1];
+      itemLast[item]  = (int) itemSort[3*item+2];
+   }
+
+   delete [] itemSort;
+   delete [] cuts;
+   delete [] firstCut;
+
+}
+
+void CheMPS2::HeffPlan::smallAxpy(const int n, const double alpha, const double * x, double * y){
+
+   #pragma omp simd
+   for (int cnt=0; cnt<n; cnt++){ y[cnt] += alpha * x[cnt]; }
+
+}
+
+void CheMPS2::HeffPlan::smallGemm(const char transA, const char transB, const int m, const int n, const int k, const double alpha, const double * A, const int lda, const double * B, const int ldb, const double beta, double * C, const int ldc){
+
+   const bool normalA = ((transA == 'N') || (transA == 'n'));
+   const bool normalB = ((transB == 'N') || (transB == 'n'));
+
+   for (int col=0; col<n; col++){
+
+      double * Ccol = C + ldc * col;
+      if (beta == 0.0){ for (int row=0; row<m; row++){ Ccol[row] = 0.0; } }
+      else if (beta != 1.0){ for (int row=0; row<m; row++){ Ccol[row] *= beta; } }
+      if (alpha == 0.0){ continue; }
+
+      if (normalA){
+         //C[:,col] += sum_l A[:,l] * alpha * op(B)[l,col] : unit stride over the rows of A and C
+         int l = 0;
+         for (; l+2<=k; l+=2){
+            const double factor0 = alpha * ((normalB) ? B[l   + ldb * col] : B[col + ldb * l    ]);
+            const double factor1 = alpha * ((normalB) ? B[l+1 + ldb * col] : B[col + ldb * (l+1)]);
+            const double * Acol0 = A + lda * l;
+            const double * Acol1 = A + lda * (l+1);
+            #pragma omp simd
+            for (int row=0; row<m; row++){ Ccol[row] += Acol0[row] * factor0 + Acol1[row] * factor1; }
+         }
+         for (; l<k; l++){
+            const double factor = alpha * ((normalB) ? B[l + ldb * col] : B[col + ldb * l]);
+            const double * Acol = A + lda * l;
+            #pragma omp simd
+            for (int row=0; row<m; row++){ Ccol[row] += Acol[row] * factor; }
+         }
+      } else {
+         //C[row,col] += alpha * A[:,row]^T op(B)[:,col] : unit stride over the columns of A (and of B when normalB)
+         for (int row=0; row<m; row++){
+            const double * Acol = A + lda * row;
+            double value = 0.0;
+            if (normalB){
+               const double * Bcol = B + ldb * col;
+               #pragma omp simd reduction(+:value)
+               for (int l=0; l<k; l++){ value += Acol[l] * Bcol[l]; }
+            } else {
+               for (int l=0; l<k; l++){ value += Acol[l] * B[col + ldb * l]; }
+            }
+            Ccol[row] += alpha * value;
+         }
+      }
+
+   }
+
+}
+
@@ -21,6 +21,7 @@
 #include <iostream>
 
 #include "Problem.h"
+#include "Options.h"
 
 using std::cout;
 using std::endl;
@@ -33,6 +34,8 @@ CheMPS2::Problem::Problem(const Hamiltonian * Hamin, const int TwoSin, const int
    OneOverNMinusOne = 1.0/(N-1);
    Irrep = Irrepin;
    bReorderD2h = false;
+   L = Ham->getL();
+   mxElements = NULL;
    
    checkConsistency();
 
@@ -44,6 +47,7 @@ CheMPS2::Problem::~Problem(){
       delete [] f1;
       delete [] f2;
    }
+   if (mxElements != NULL){ delete [] mxElements; }
 
 }
 
@@ -52,6 +56,10 @@ void CheMPS2::Problem::SetupReorderD2h(){
    if (gSy()==7){ //Only if D2h of course
    
       bReorderD2h = true;
+      if (mxElements != NULL){ //The cache is in the old orbital order
+         delete [] mxElements;
+         mxElements = NULL;
+      }
       f1 = new int[Ham->getL()];
       f2 = new int[Ham->getL()];
       
@@ -105,6 +113,18 @@ int CheMPS2::Problem::gf2(const int DMRGOrb) const{ return (bReorderD2h)?f2[DMRG
 
 double CheMPS2::Problem::gMxElement(const int alpha, const int beta, const int gamma, const int delta) const{
 
+   if (mxElements != NULL){
+      //The unordered pairs (alpha, gamma) and (beta, delta), and the unordered couple of both pairs
+      const long long first  = (alpha > gamma) ? ((alpha * (alpha + 1)) / 2 + gamma) : ((gamma * (gamma + 1)) / 2 + alpha);
+      const long long second = (beta  > delta) ? ((beta  * (beta  + 1)) / 2 + delta) : ((delta * (delta + 1)) / 2 + beta );
+      return mxElements[(first > second) ? ((first * (first + 1)) / 2 + second) : ((second * (second + 1)) / 2 + first)];
+   }
+   return calcMxElement(alpha, beta, gamma, delta);
+
+}
+
+double CheMPS2::Problem::calcMxElement(const int alpha, const int beta, const int gamma, const int delta) const{
+
    if (!bReorderD2h){
       return Ham->getVmat(alpha, beta, gamma, delta) + OneOverNMinusOne*(((alpha==gamma)?Ham->getTmat(beta,delta):0) + ((beta==delta)?Ham->getTmat(alpha,gamma):0));
    }
@@ -113,6 +133,47 @@ double CheMPS2::Problem::gMxElement(const int alpha, const int beta, const int g
 
 }
 
+void CheMPS2::Problem::construct(){
+
+   if (mxElements != NULL){
+      delete [] mxElements;
+      mxElements = NULL;
+   }
+   
+   //One element per class of the 8-fold permutation symmetry of the Vmat: the pairs (alpha, gamma) and (beta, delta) are unordered, and so is the couple of both pairs
+   const long long numPairs = (((long long) L) * (L + 1)) / 2;
+   const long long numClasses = (numPairs * (numPairs + 1)) / 2;
+   const double megabytes = sizeof(double) * ((double) numClasses) / 1048576.0;
+   if ((L == 0) || (megabytes > CheMPS2::PROBLEM_mxElementCacheMaxMB)){
+      cout << "Problem::construct : The matrix elements are not cached (" << megabytes << " MB > " << CheMPS2::PROBLEM_mxElementCacheMaxMB << " MB)." << endl;
+      return;
+   }
+   
+   double * cache = new double[numClasses];
+   Irreps SymmInfo(gSy());
+   
+   //Each class is calculated for its representative with alpha <= gamma, beta <= delta and pair (beta, delta) <= pair (alpha, gamma)
+   #pragma omp parallel for schedule(dynamic)
+   for (int gamma=0; gamma<L; gamma++){
+      for (int alpha=0; alpha<=gamma; alpha++){
+         const long long first = (gamma * (gamma + 1)) / 2 + alpha;
+         for (int delta=0; delta<=gamma; delta++){
+            for (int beta=0; beta<=delta; beta++){
+               const long long second = (delta * (delta + 1)) / 2 + beta;
+               if (second <= first){
+                  const bool allowed = (SymmInfo.directProd(gIrrep(alpha), gIrrep(beta)) == SymmInfo.directProd(gIrrep(gamma), gIrrep(delta)));
+                  cache[(first * (first + 1)) / 2 + second] = (allowed) ? calcMxElement(alpha, beta, gamma, delta) : 0.0;
+               }
+            }
+         }
+      }
+   }
+   
+   mxElements = cache;
+   cout << "Problem::construct : The matrix elements are cached (" << megabytes << " MB)." << endl;
+
+}
+
 bool CheMPS2::Problem::checkConsistency() const{
 
    Irreps SymmInfo(gSy());
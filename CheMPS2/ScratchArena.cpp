@@ -0,0 +1,103 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include "ScratchArena.h"
+
+//The buffers of the calling thread, their sizes, and its statistics
+static double * ScratchArena_buffer[CheMPS2::ScratchArena::SCRATCHARENA_NUMSLOTS];
+static size_t ScratchArena_size[CheMPS2::ScratchArena::SCRATCHARENA_NUMSLOTS];
+static double ** ScratchArena_pointers = NULL;
+static size_t ScratchArena_numPointers = 0;
+static long long ScratchArena_numRequests = 0;
+static long long ScratchArena_numAllocations = 0;
+#pragma omp threadprivate(ScratchArena_buffer, ScratchArena_size, ScratchArena_pointers, ScratchArena_numPointers, ScratchArena_numRequests, ScratchArena_numAllocations)
+
+double * CheMPS2::ScratchArena::get(const int slot, const size_t size){
+
+   ScratchArena_numRequests++;
+
+   if (size > ScratchArena_size[slot]){
+      ScratchArena_numAllocations++;
+      delete [] ScratchArena_buffer[slot];
+      ScratchArena_buffer[slot] = new double[size];
+      ScratchArena_size[slot] = size;
+   }
+   return ScratchArena_buffer[slot];
+
+}
+
+double ** CheMPS2::ScratchArena::getPointers(const size_t size){
+
+   ScratchArena_numRequests++;
+
+   if (size > ScratchArena_numPointers){
+      ScratchArena_numAllocations++;
+      delete [] ScratchArena_pointers;
+      ScratchArena_pointers = new double*[size];
+      ScratchArena_numPointers = size;
+   }
+   return ScratchArena_pointers;
+
+}
+
+void CheMPS2::ScratchArena::release(){
+
+   for (int slot=0; slot<SCRATCHARENA_NUMSLOTS; slot++){
+      delete [] ScratchArena_buffer[slot];
+      ScratchArena_buffer[slot] = NULL;
+      ScratchArena_size[slot] = 0;
+   }
+   delete [] ScratchArena_pointers;
+   ScratchArena_pointers = NULL;
+   ScratchArena_numPointers = 0;
+
+}
+
+long long CheMPS2::ScratchArena::gNumRequests(){
+
+   long long total = 0;
+   #pragma omp parallel reduction(+:total)
+   {
+      total += ScratchArena_numRequests;
+   }
+   return total;
+
+}
+
+long long CheMPS2::ScratchArena::gNumAllocations(){
+
+   long long total = 0;
+   #pragma omp parallel reduction(+:total)
+   {
+      total += ScratchArena_numAllocations;
+   }
+   return total;
+
+}
+
+void CheMPS2::ScratchArena::resetStatistics(){
+
+   #pragma omp parallel
+   {
+      ScratchArena_numRequests = 0;
+      ScratchArena_numAllocations = 0;
+   }
+
+}
+
@@ -25,7 +25,7 @@
 #include "TensorT.h"
 #include "SyBookkeeper.h"
 #include "Lapack.h"
-#include "Gsl.h"
+#include "Wigner.h"
 
 using std::min;
 using std::max;
@@ -118,6 +118,54 @@ CheMPS2::Sobject::Sobject(const int indexIn, const int IlocalIn1, const int Iloc
    }
    
    storage = new double[kappa2index[nKappa]];
+   
+   fillLookup();
+
+}
+
+int CheMPS2::Sobject::gLocalNum(const int N1, const int N2, const int TwoJ, const int TwoSRminTwoSL){
+
+   if ((N1<0) || (N1>2) || (N2<0) || (N2>2)) return -1;
+   if ((TwoSRminTwoSL<-2) || (TwoSRminTwoSL>2)) return -1;
+   int localNum = 3*N1 + N2; // 0 to 8 for TwoJ==((N1+N2)%2)
+   if (TwoJ != ((N1+N2)%2)){
+      if ((N1==1) && (N2==1) && (TwoJ==2)){ localNum = 9; }
+      else { return -1; }
+   }
+   return localNum * 5 + TwoSRminTwoSL + 2;
+
+}
+
+void CheMPS2::Sobject::fillLookup(){
+
+   NLmin = denBK->gNmin(index);
+   NLmax = denBK->gNmax(index);
+   numTwoSL = 1;
+   for (int NL=NLmin; NL<=NLmax; NL++){ numTwoSL = max( numTwoSL, denBK->gTwoSmax(index,NL)/2 + 1 ); }
+   const int numIrreps = denBK->getNumberOfIrreps();
+   
+   const int sizeLeft = max( 1, (NLmax - NLmin + 1) * numTwoSL * numIrreps );
+   sectorLeftNum = new int[sizeLeft];
+   for (int cnt=0; cnt<sizeLeft; cnt++){ sectorLeftNum[cnt] = -1; }
+   
+   int numLeft = 0;
+   for (int ikappa=0; ikappa<nKappa; ikappa++){
+      const int ptr = sectorIL[ikappa] + numIrreps * ( sectorTwoSL[ikappa]/2 + numTwoSL * (sectorNL[ikappa] - NLmin) );
+      if (sectorLeftNum[ptr] == -1){
+         sectorLeftNum[ptr] = numLeft;
+         numLeft++;
+      }
+   }
+   
+   const int sizeLookup = max( 1, numLeft * numLocal );
+   kappaLookup = new int[sizeLookup];
+   for (int cnt=0; cnt<sizeLookup; cnt++){ kappaLookup[cnt] = -1; }
+   
+   for (int ikappa=0; ikappa<nKappa; ikappa++){
+      const int ptr = sectorIL[ikappa] + numIrreps * ( sectorTwoSL[ikappa]/2 + numTwoSL * (sectorNL[ikappa] - NLmin) );
+      const int localNum = gLocalNum(sectorN1[ikappa], sectorN2[ikappa], sectorTwoJ[ikappa], sectorTwoSR[ikappa] - sectorTwoSL[ikappa]);
+      kappaLookup[ sectorLeftNum[ptr] * numLocal + localNum ] = ikappa;
+   }
 
 }
 
@@ -134,6 +182,8 @@ CheMPS2::Sobject::~Sobject(){
    delete [] sectorIR;
    delete [] kappa2index;
    delete [] storage;
+   delete [] sectorLeftNum;
+   delete [] kappaLookup;
 
 }
 
@@ -143,9 +193,15 @@ double * CheMPS2::Sobject::gStorage() { return storage; }
       
 int CheMPS2::Sobject::gKappa(const int NL, const int TwoSL, const int IL, const int N1, const int N2, const int TwoJ, const int NR, const int TwoSR, const int IR) const{
 
-   for (int cnt=0; cnt<nKappa; cnt++){
-      if ((sectorNL[cnt]==NL)&&(sectorTwoSL[cnt]==TwoSL)&&(sectorIL[cnt]==IL)&&(sectorN1[cnt]==N1)&&(sectorN2[cnt]==N2)&&(sectorTwoJ[cnt]==TwoJ)&&(sectorNR[cnt]==NR)&&(sectorTwoSR[cnt]==TwoSR)&&(sectorIR[cnt]==IR)) return cnt;
-   }
+   if ((NL<NLmin) || (NL>NLmax) || (TwoSL<0) || (TwoSL/2>=numTwoSL) || (IL<0) || (IL>=denBK->getNumberOfIrreps())) return -1;
+   const int leftNum = sectorLeftNum[ IL + denBK->getNumberOfIrreps() * ( TwoSL/2 + numTwoSL * (NL - NLmin) ) ];
+   if (leftNum == -1) return -1;
+   const int localNum = gLocalNum(N1, N2, TwoJ, TwoSR - TwoSL);
+   if (localNum == -1) return -1;
+   
+   //The lookup table is keyed on a subset of the labels (NR and IR follow from the others, TwoSL/2 aliases both parities) --> verify the block
+   const int cnt = kappaLookup[ leftNum * numLocal + localNum ];
+   if ((cnt!=-1)&&(sectorNL[cnt]==NL)&&(sectorTwoSL[cnt]==TwoSL)&&(sectorIL[cnt]==IL)&&(sectorN1[cnt]==N1)&&(sectorN2[cnt]==N2)&&(sectorTwoJ[cnt]==TwoJ)&&(sectorNR[cnt]==NR)&&(sectorTwoSR[cnt]==TwoSR)&&(sectorIR[cnt]==IR)) return cnt;
    
    return -1;
 
@@ -213,7 +269,7 @@ void CheMPS2::Sobject::Join(TensorT * Tleft, TensorT * Tright){
             double * BlockLeft =   Tleft->gStorage(sectorNL[ikappa],sectorTwoSL[ikappa],sectorIL[ikappa],NM,TwoJM[casenr],IM);
             double * BlockRight = Tright->gStorage(NM,TwoJM[casenr],IM,sectorNR[ikappa],sectorTwoSR[ikappa],sectorIR[ikappa]);
          
-            double prefactor = gsl_sf_coupling_6j(sectorTwoSL[ikappa],sectorTwoSR[ikappa],sectorTwoJ[ikappa],((sectorN2[ikappa]==1)?1:0),((sectorN1[ikappa]==1)?1:0),TwoJM[casenr]) * sqrt((sectorTwoJ[ikappa]+1.0)*(TwoJM[casenr]+1)) * phase;
+            double prefactor = Wigner::wigner6j(sectorTwoSL[ikappa],sectorTwoSR[ikappa],sectorTwoJ[ikappa],((sectorN2[ikappa]==1)?1:0),((sectorN1[ikappa]==1)?1:0),TwoJM[casenr]) * sqrt((sectorTwoJ[ikappa]+1.0)*(TwoJM[casenr]+1)) * phase;
          
             double beta = (casenr==0)?0.0:1.0; //first time: set, other times: add.
             char notrans = 'N';
@@ -232,6 +288,23 @@ void CheMPS2::Sobject::Join(TensorT * Tleft, TensorT * Tright){
 
 double CheMPS2::Sobject::Split(TensorT * Tleft, TensorT * Tright, const int virtualdimensionD, const bool movingright, const bool change){
 
+   Sobject * denS = this;
+   return Split(1, &denS, &Tleft, &Tright, virtualdimensionD, movingright, change);
+
+}
+
+double CheMPS2::Sobject::Split(const int nRoots, Sobject ** denS, TensorT ** Tleft, TensorT ** Tright, const int virtualdimensionD, const bool movingright, const bool change){
+
+   const int index = denS[0]->index;
+   const int Ilocal1 = denS[0]->Ilocal1;
+   const int Ilocal2 = denS[0]->Ilocal2;
+   SyBookkeeper * denBK = denS[0]->denBK;
+   
+   //The roots are averaged with equal weights: moving right, the blocks of the roots are put next to each other (a common U); moving left, below each other (a common VT)
+   const int nRootsL = (movingright) ? 1 : nRoots;
+   const int nRootsR = (movingright) ? nRoots : 1;
+   const double rootWeight = sqrt(1.0/nRoots);
+
    //Get the number of central sectors
    int nCenterSectors = 0;
    for (int NM=denBK->gNmin(index+1); NM<=denBK->gNmax(index+1); NM++){
@@ -271,6 +344,8 @@ double CheMPS2::Sobject::Split(TensorT * Tleft, TensorT * Tright, const int virt
    int * CenterDims = new int[nCenterSectors];
    int * DimLtotal = new int[nCenterSectors];
    int * DimRtotal = new int[nCenterSectors];
+   int * MemRows = new int[nCenterSectors];
+   int * MemCols = new int[nCenterSectors];
    
    //PARALLEL
    #pragma omp parallel for schedule(dynamic)
@@ -301,76 +376,117 @@ double CheMPS2::Sobject::Split(TensorT * Tleft, TensorT * Tright, const int virt
             }
          }
       }
-      CenterDims[iCenter] = min(DimLtotal[iCenter],DimRtotal[iCenter]); //CenterDims contains the min. amount
+      MemRows[iCenter] = nRootsL * DimLtotal[iCenter];
+      MemCols[iCenter] = nRootsR * DimRtotal[iCenter];
+      CenterDims[iCenter] = min(MemRows[iCenter],MemCols[iCenter]); //CenterDims contains the min. amount. For several roots, it can exceed the FCI dimension of the central sector.
 
       //Allocate memory to store the SVD in.
       Lambdas[iCenter] = new double[CenterDims[iCenter]];
-      Us[iCenter] = new double[DimLtotal[iCenter]*CenterDims[iCenter]];
-      VTs[iCenter] = new double[CenterDims[iCenter]*DimRtotal[iCenter]];
+      Us[iCenter] = new double[MemRows[iCenter]*CenterDims[iCenter]];
+      VTs[iCenter] = new double[CenterDims[iCenter]*MemCols[iCenter]];
       
-      //Allocate memory to copy the different parts of the S-object. Use prefactor sqrt((2jR+1)/(2jM+1) * (2jM+1) * (2j+1)) W6J (-1)^(jL+jR+s1+s2) and sum over j.
-      if (CenterDims[iCenter]>0){
-         double * mem = new double[DimLtotal[iCenter]*DimRtotal[iCenter]];
-         for (int cnt=0; cnt<DimLtotal[iCenter]*DimRtotal[iCenter]; cnt++){ mem[cnt] = 0.0; }
-
-         int dimLtotal2 = 0;
-         int dimRtotal2;
-         for (int NL=SplitSectNM[iCenter]-2; NL<=SplitSectNM[iCenter]; NL++){
-            for (int TwoSL=SplitSectTwoJM[iCenter]-((NL==SplitSectNM[iCenter]-1)?1:0); TwoSL<SplitSectTwoJM[iCenter]+2; TwoSL+=2){
-               if (TwoSL>=0){
-                  int IL = ((NL==SplitSectNM[iCenter]-1)?denBK->directProd(Ilocal1,SplitSectIM[iCenter]):SplitSectIM[iCenter]);
-                  int dimL = denBK->gCurrentDim(index,NL,TwoSL,IL);
-                  if (dimL>0){
-                     dimRtotal2 = 0;
-                     for (int NR=SplitSectNM[iCenter]; NR<=SplitSectNM[iCenter]+2; NR++){
-                        for (int TwoSR=SplitSectTwoJM[iCenter]-((NR==SplitSectNM[iCenter]+1)?1:0); TwoSR<SplitSectTwoJM[iCenter]+2; TwoSR+=2){
-                           if (TwoSR>=0){
-                              int IR = ((NR==SplitSectNM[iCenter]+1)?denBK->directProd(Ilocal2,SplitSectIM[iCenter]):SplitSectIM[iCenter]);
-                              int dimR = denBK->gCurrentDim(index+2,NR,TwoSR,IR);
-                              if (dimR>0){
-                                 //Loop over contributing TwoJ's
-                                 int TwoS2 = (NR==SplitSectNM[iCenter]+1)?1:0;
-                                 int TwoS1 = (NL==SplitSectNM[iCenter]-1)?1:0;
-                                 int fase = ((((TwoSL + TwoSR + TwoS1 + TwoS2)/2)%2)!=0)?-1:1;
-                                 for (int TwoJ = max(abs(TwoSR-TwoSL),abs(TwoS2-TwoS1)); TwoJ<=min(TwoS1+TwoS2,TwoSL+TwoSR); TwoJ+=2){
-                                    //calc prefactor
-                                    double prefact = gsl_sf_coupling_6j(TwoSL,TwoSR,TwoJ,TwoS2,TwoS1,SplitSectTwoJM[iCenter]) * sqrt((TwoJ+1.0)*(TwoSR+1)) * fase;
-                              
-                                    //add them to mem.
-                                    double * Block = gStorage(NL,TwoSL,IL,SplitSectNM[iCenter]-NL,NR-SplitSectNM[iCenter],TwoJ,NR,TwoSR,IR);
-                                    for (int l=0; l<dimL; l++){
-                                       for (int r=0; r<dimR; r++){
-                                          mem[dimLtotal2 + l + DimLtotal[iCenter] * (dimRtotal2 + r)] += prefact * Block[l + dimL * r]; //+= because several TwoJ
+   }
+   
+   //Order the center sectors by decreasing SVD cost, so that the dynamic schedule starts with the largest ones
+   int * order = new int[nCenterSectors];
+   for (int iCenter=0; iCenter<nCenterSectors; iCenter++){
+      const double cost = ((double) MemRows[iCenter]) * MemCols[iCenter] * CenterDims[iCenter];
+      int pos = iCenter;
+      while ((pos>0) && (((double) MemRows[order[pos-1]]) * MemCols[order[pos-1]] * CenterDims[order[pos-1]] < cost)){
+         order[pos] = order[pos-1];
+         pos--;
+      }
+      order[pos] = iCenter;
+   }
+   
+   //The large sectors are decomposed one after the other, each with the threads of the BLAS/LAPACK library. The others concurrently.
+   int nLarge = 0;
+   while ((nLarge<nCenterSectors) && (CenterDims[order[nLarge]] >= CheMPS2::SOBJECT_threadedSvdCutoff)){ nLarge++; }
+   
+   for (int phase=0; phase<2; phase++){
+   
+      const int first = (phase==0) ? 0 : nLarge;
+      const int last  = (phase==0) ? nLarge : nCenterSectors;
+   
+      //PARALLEL
+      #pragma omp parallel for schedule(dynamic) if(phase==1)
+      for (int iSorted=first; iSorted<last; iSorted++){
+   
+         const int iCenter = order[iSorted];
+      
+         //Allocate memory to copy the different parts of the S-object. Use prefactor sqrt((2jR+1)/(2jM+1) * (2jM+1) * (2j+1)) W6J (-1)^(jL+jR+s1+s2) and sum over j.
+         if (CenterDims[iCenter]>0){
+            double * mem = new double[MemRows[iCenter]*MemCols[iCenter]];
+            for (int cnt=0; cnt<MemRows[iCenter]*MemCols[iCenter]; cnt++){ mem[cnt] = 0.0; }
+
+            for (int root=0; root<nRoots; root++){
+               const double weight = (nRoots==1) ? 1.0 : rootWeight;
+               int dimLtotal2 = (movingright) ? 0 : root * DimLtotal[iCenter];
+               int dimRtotal2;
+               for (int NL=SplitSectNM[iCenter]-2; NL<=SplitSectNM[iCenter]; NL++){
+                  for (int TwoSL=SplitSectTwoJM[iCenter]-((NL==SplitSectNM[iCenter]-1)?1:0); TwoSL<SplitSectTwoJM[iCenter]+2; TwoSL+=2){
+                     if (TwoSL>=0){
+                        int IL = ((NL==SplitSectNM[iCenter]-1)?denBK->directProd(Ilocal1,SplitSectIM[iCenter]):SplitSectIM[iCenter]);
+                        int dimL = denBK->gCurrentDim(index,NL,TwoSL,IL);
+                        if (dimL>0){
+                           dimRtotal2 = (movingright) ? root * DimRtotal[iCenter] : 0;
+                           for (int NR=SplitSectNM[iCenter]; NR<=SplitSectNM[iCenter]+2; NR++){
+                              for (int TwoSR=SplitSectTwoJM[iCenter]-((NR==SplitSectNM[iCenter]+1)?1:0); TwoSR<SplitSectTwoJM[iCenter]+2; TwoSR+=2){
+                                 if (TwoSR>=0){
+                                    int IR = ((NR==SplitSectNM[iCenter]+1)?denBK->directProd(Ilocal2,SplitSectIM[iCenter]):SplitSectIM[iCenter]);
+                                    int dimR = denBK->gCurrentDim(index+2,NR,TwoSR,IR);
+                                    if (dimR>0){
+                                       //Loop over contributing TwoJ's
+                                       int TwoS2 = (NR==SplitSectNM[iCenter]+1)?1:0;
+                                       int TwoS1 = (NL==SplitSectNM[iCenter]-1)?1:0;
+                                       int fase = ((((TwoSL + TwoSR + TwoS1 + TwoS2)/2)%2)!=0)?-1:1;
+                                       for (int TwoJ = max(abs(TwoSR-TwoSL),abs(TwoS2-TwoS1)); TwoJ<=min(TwoS1+TwoS2,TwoSL+TwoSR); TwoJ+=2){
+                                          //calc prefactor
+                                          double prefact = weight * Wigner::wigner6j(TwoSL,TwoSR,TwoJ,TwoS2,TwoS1,SplitSectTwoJM[iCenter]) * sqrt((TwoJ+1.0)*(TwoSR+1)) * fase;
+                                 
+                                          //add them to mem.
+                                          double * Block = denS[root]->gStorage(NL,TwoSL,IL,SplitSectNM[iCenter]-NL,NR-SplitSectNM[iCenter],TwoJ,NR,TwoSR,IR);
+                                          for (int l=0; l<dimL; l++){
+                                             for (int r=0; r<dimR; r++){
+                                                mem[dimLtotal2 + l + MemRows[iCenter] * (dimRtotal2 + r)] += prefact * Block[l + dimL * r]; //+= because several TwoJ
+                                             }
+                                          }
                                        }
+                                       dimRtotal2 += dimR;
                                     }
                                  }
-                                 dimRtotal2 += dimR;
                               }
                            }
+                           dimLtotal2 += dimL;
                         }
                      }
-                     dimLtotal2 += dimL;
                   }
                }
             }
-         }
       
-         //Now mem contains sqrt((2jR+1)/(2jM+1)) * (TT)^{jM nM IM) --> SVD per central symmetry
-         char jobz = 'S'; //M x min(M,N) in U and min(M,N) x N in VT
-         int lwork = 3*CenterDims[iCenter] + max(max(DimLtotal[iCenter],DimRtotal[iCenter]),4*CenterDims[iCenter]*(CenterDims[iCenter]+1));
-         double * work = new double[lwork];
-         int * iwork = new int[8*CenterDims[iCenter]];
-         int info;
-
-         //dgesdd is not thread-safe in every implementation (intel MKL is safe, Atlas is not safe)
-         #pragma omp critical
-         dgesdd_(&jobz, DimLtotal + iCenter, DimRtotal + iCenter, mem, DimLtotal + iCenter, Lambdas[iCenter], Us[iCenter], DimLtotal + iCenter, VTs[iCenter], CenterDims + iCenter, work, &lwork, iwork, &info);
-
-         delete [] work;
-         delete [] iwork;
-         delete [] mem;
+            //Now mem contains sqrt((2jR+1)/(2jM+1)) * (TT)^{jM nM IM) --> SVD per central symmetry
+            char jobz = 'S'; //M x min(M,N) in U and min(M,N) x N in VT
+            int lwork = 3*CenterDims[iCenter] + max(max(MemRows[iCenter],MemCols[iCenter]),4*CenterDims[iCenter]*(CenterDims[iCenter]+1));
+            double * work = new double[lwork];
+            int * iwork = new int[8*CenterDims[iCenter]];
+            int info;
+
+            #ifdef CHEMPS2_THREADSAFE_LAPACK
+            dgesdd_(&jobz, MemRows + iCenter, MemCols + iCenter, mem, MemRows + iCenter, Lambdas[iCenter], Us[iCenter], MemRows + iCenter, VTs[iCenter], CenterDims + iCenter, work, &lwork, iwork, &info);
+            #else
+            //dgesdd is not thread-safe in every implementation (intel MKL is safe, Atlas is not safe) --> configure with -DTHREADSAFE_LAPACK=ON if it is
+            #pragma omp critical
+            dgesdd_(&jobz, MemRows + iCenter, MemCols + iCenter, mem, MemRows + iCenter, Lambdas[iCenter], Us[iCenter], MemRows + iCenter, VTs[iCenter], CenterDims + iCenter, work, &lwork, iwork, &info);
+            #endif
+
+            delete [] work;
+            delete [] iwork;
+            delete [] mem;
+         }
       }
+   
    }
+   delete [] order;
    
    double discardedWeight = 0.0; //Only if change==true; will the discardedWeight be meaningful and different from zero.
 
@@ -434,67 +550,72 @@ double CheMPS2::Sobject::Split(TensorT * Tleft, TensorT * Tright, const int virt
          for (int iCenter=0; iCenter<nCenterSectors; iCenter++){
             denBK->SetDim(index+1,SplitSectNM[iCenter],SplitSectTwoJM[iCenter],SplitSectIM[iCenter],NewDims[iCenter]);
          }
-         Tleft ->Reset();
-         Tright->Reset();
+         for (int root=0; root<nRootsL; root++){ Tleft[root]->Reset(); }
+         for (int root=0; root<nRootsR; root++){ Tright[root]->Reset(); }
       }
       
       delete [] NewDims;
       
    }
    
-   //copy first gCurrentDimM per central symmetry sector to the relevant parts.
+   //copy first gCurrentDimM per central symmetry sector to the relevant parts. The weight of the roots is removed again from the root-dependent parts.
+   const double rootFactor = (nRoots==1) ? 1.0 : 1.0/rootWeight;
    //PARALLEL
    #pragma omp parallel for schedule(dynamic)
    for (int iCenter=0; iCenter<nCenterSectors; iCenter++){
       int dimM = denBK->gCurrentDim(index+1,SplitSectNM[iCenter],SplitSectTwoJM[iCenter],SplitSectIM[iCenter]);
       if (dimM>0){
          //U-part: copy
-         int dimLtotal2 = 0;
-         for (int NL=SplitSectNM[iCenter]-2; NL<=SplitSectNM[iCenter]; NL++){
-            for (int TwoSL=SplitSectTwoJM[iCenter]-((NL==SplitSectNM[iCenter]-1)?1:0); TwoSL<SplitSectTwoJM[iCenter]+2; TwoSL+=2){
-               if (TwoSL>=0){
-                  int IL = ((NL==SplitSectNM[iCenter]-1)?denBK->directProd(Ilocal1,SplitSectIM[iCenter]):SplitSectIM[iCenter]);
-                  int dimL = denBK->gCurrentDim(index,NL,TwoSL,IL);
-                  if (dimL>0){
-                     double * TleftBlock = Tleft->gStorage(NL,TwoSL,IL,SplitSectNM[iCenter],SplitSectTwoJM[iCenter],SplitSectIM[iCenter]);
-                     for (int r=0; r<min(dimM,CenterDims[iCenter]); r++){
-                        double fact = (movingright)?1.0:Lambdas[iCenter][r];
-                        for (int l=0; l<dimL; l++){
-                           TleftBlock[l + dimL * r] = fact * Us[iCenter][dimLtotal2 + l + DimLtotal[iCenter]*r]; //l 0-->dimL and r 0-->dimM
+         for (int root=0; root<nRootsL; root++){
+            int dimLtotal2 = root * DimLtotal[iCenter];
+            for (int NL=SplitSectNM[iCenter]-2; NL<=SplitSectNM[iCenter]; NL++){
+               for (int TwoSL=SplitSectTwoJM[iCenter]-((NL==SplitSectNM[iCenter]-1)?1:0); TwoSL<SplitSectTwoJM[iCenter]+2; TwoSL+=2){
+                  if (TwoSL>=0){
+                     int IL = ((NL==SplitSectNM[iCenter]-1)?denBK->directProd(Ilocal1,SplitSectIM[iCenter]):SplitSectIM[iCenter]);
+                     int dimL = denBK->gCurrentDim(index,NL,TwoSL,IL);
+                     if (dimL>0){
+                        double * TleftBlock = Tleft[root]->gStorage(NL,TwoSL,IL,SplitSectNM[iCenter],SplitSectTwoJM[iCenter],SplitSectIM[iCenter]);
+                        for (int r=0; r<min(dimM,CenterDims[iCenter]); r++){
+                           double fact = (movingright)?1.0:(rootFactor * Lambdas[iCenter][r]);
+                           for (int l=0; l<dimL; l++){
+                              TleftBlock[l + dimL * r] = fact * Us[iCenter][dimLtotal2 + l + MemRows[iCenter]*r]; //l 0-->dimL and r 0-->dimM
+                           }
                         }
-                     }
-                     for (int r=min(dimM,CenterDims[iCenter]); r<dimM; r++){
-                        for (int l=0; l<dimL; l++){
-                           TleftBlock[l + dimL * r] = 0.0;
+                        for (int r=min(dimM,CenterDims[iCenter]); r<dimM; r++){
+                           for (int l=0; l<dimL; l++){
+                              TleftBlock[l + dimL * r] = 0.0;
+                           }
                         }
+                        dimLtotal2 += dimL;
                      }
-                     dimLtotal2 += dimL;
                   }
                }
             }
          }
          
          //VT-part: copy
-         int dimRtotal2 = 0;
-         for (int NR=SplitSectNM[iCenter]; NR<=SplitSectNM[iCenter]+2; NR++){
-            for (int TwoSR=SplitSectTwoJM[iCenter]-((NR==SplitSectNM[iCenter]+1)?1:0); TwoSR<SplitSectTwoJM[iCenter]+2; TwoSR+=2){
-               if (TwoSR>=0){
-                  int IR = ((NR==SplitSectNM[iCenter]+1)?denBK->directProd(Ilocal2,SplitSectIM[iCenter]):SplitSectIM[iCenter]);
-                  int dimR = denBK->gCurrentDim(index+2,NR,TwoSR,IR);
-                  if (dimR>0){
-                     double * TrightBlock = Tright->gStorage(SplitSectNM[iCenter],SplitSectTwoJM[iCenter],SplitSectIM[iCenter],NR,TwoSR,IR);
-                     for (int l=0; l<min(dimM,CenterDims[iCenter]); l++){
-                        double fact = ((movingright)?Lambdas[iCenter][l]:1.0) * sqrt((SplitSectTwoJM[iCenter] + 1.0)/(TwoSR + 1.0));
-                        for (int r=0; r<dimR; r++){
-                           TrightBlock[l + dimM * r] = fact * VTs[iCenter][l + CenterDims[iCenter] * (dimRtotal2 + r)]; //l 0-->dimM and r 0-->dimR
+         for (int root=0; root<nRootsR; root++){
+            int dimRtotal2 = root * DimRtotal[iCenter];
+            for (int NR=SplitSectNM[iCenter]; NR<=SplitSectNM[iCenter]+2; NR++){
+               for (int TwoSR=SplitSectTwoJM[iCenter]-((NR==SplitSectNM[iCenter]+1)?1:0); TwoSR<SplitSectTwoJM[iCenter]+2; TwoSR+=2){
+                  if (TwoSR>=0){
+                     int IR = ((NR==SplitSectNM[iCenter]+1)?denBK->directProd(Ilocal2,SplitSectIM[iCenter]):SplitSectIM[iCenter]);
+                     int dimR = denBK->gCurrentDim(index+2,NR,TwoSR,IR);
+                     if (dimR>0){
+                        double * TrightBlock = Tright[root]->gStorage(SplitSectNM[iCenter],SplitSectTwoJM[iCenter],SplitSectIM[iCenter],NR,TwoSR,IR);
+                        for (int l=0; l<min(dimM,CenterDims[iCenter]); l++){
+                           double fact = ((movingright)?(rootFactor * Lambdas[iCenter][l]):1.0) * sqrt((SplitSectTwoJM[iCenter] + 1.0)/(TwoSR + 1.0));
+                           for (int r=0; r<dimR; r++){
+                              TrightBlock[l + dimM * r] = fact * VTs[iCenter][l + CenterDims[iCenter] * (dimRtotal2 + r)]; //l 0-->dimM and r 0-->dimR
+                           }
                         }
-                     }
-                     for (int l=min(dimM,CenterDims[iCenter]); l<dimM; l++){
-                        for (int r=0; r<dimR; r++){
-                           TrightBlock[l + dimM * r] = 0.0;
+                        for (int l=min(dimM,CenterDims[iCenter]); l<dimM; l++){
+                           for (int r=0; r<dimR; r++){
+                              TrightBlock[l + dimM * r] = 0.0;
+                           }
                         }
+                        dimRtotal2 += dimR;
                      }
-                     dimRtotal2 += dimR;
                   }
                }
             }
@@ -517,6 +638,8 @@ double CheMPS2::Sobject::Split(TensorT * Tleft, TensorT * Tright, const int virt
    delete [] CenterDims;
    delete [] DimLtotal;
    delete [] DimRtotal;
+   delete [] MemRows;
+   delete [] MemCols;
    
    return discardedWeight;
    
@@ -0,0 +1,99 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <algorithm>
+
+#include "Tensor.h"
+
+using std::min;
+using std::max;
+
+CheMPS2::Tensor::Tensor(){
+
+   storage = NULL;
+   ownsStorage = true;
+
+}
+
+CheMPS2::Tensor::~Tensor(){
+
+}
+
+void CheMPS2::Tensor::attachStorage(double * external){
+
+   if (ownsStorage){ delete [] storage; }
+   storage = external;
+   ownsStorage = false;
+
+}
+
+void CheMPS2::Tensor::buildBlockIndex(){
+
+   blockIndexNmin = 0;
+   blockIndexNmax = -1;
+   blockIndexHalfTwoSmin = 0;
+   int halfTwoSmax = -1;
+   for (int ikappa=0; ikappa<nKappa; ikappa++){
+      if (ikappa==0){
+         blockIndexNmin = sectorN1[ikappa];
+         blockIndexNmax = sectorN1[ikappa];
+         blockIndexHalfTwoSmin = sectorTwoS1[ikappa]/2;
+         halfTwoSmax = sectorTwoS1[ikappa]/2;
+      } else {
+         blockIndexNmin = min( blockIndexNmin, sectorN1[ikappa] );
+         blockIndexNmax = max( blockIndexNmax, sectorN1[ikappa] );
+         blockIndexHalfTwoSmin = min( blockIndexHalfTwoSmin, sectorTwoS1[ikappa]/2 );
+         halfTwoSmax = max( halfTwoSmax, sectorTwoS1[ikappa]/2 );
+      }
+   }
+   blockIndexNumHalfTwoS = halfTwoSmax - blockIndexHalfTwoSmin + 1;
+   
+   const int numIrreps = denBK->getNumberOfIrreps();
+   const int size = max( 1, (blockIndexNmax - blockIndexNmin + 1) * blockIndexNumHalfTwoS * numIrreps );
+   blockIndex = new int[size];
+   for (int cnt=0; cnt<size; cnt++){ blockIndex[cnt] = -1; }
+   
+   //Loop backwards, so that the first kappa of each first sector is stored
+   for (int ikappa=nKappa-1; ikappa>=0; ikappa--){
+      blockIndex[ sectorI1[ikappa] + numIrreps * ( sectorTwoS1[ikappa]/2 - blockIndexHalfTwoSmin + blockIndexNumHalfTwoS * ( sectorN1[ikappa] - blockIndexNmin ) ) ] = ikappa;
+   }
+
+}
+
+void CheMPS2::Tensor::deleteBlockIndex(){
+
+   delete [] blockIndex;
+
+}
+
+int CheMPS2::Tensor::gKappaFirstSector(const int N1, const int TwoS1, const int I1) const{
+
+   if ((N1 < blockIndexNmin) || (N1 > blockIndexNmax) || (TwoS1 < 0)) return -1;
+   const int halfTwoS1 = TwoS1/2 - blockIndexHalfTwoSmin;
+   if ((halfTwoS1 < 0) || (halfTwoS1 >= blockIndexNumHalfTwoS)) return -1;
+   const int numIrreps = denBK->getNumberOfIrreps();
+   if ((I1 < 0) || (I1 >= numIrreps)) return -1;
+   
+   const int kappa = blockIndex[ I1 + numIrreps * ( halfTwoS1 + blockIndexNumHalfTwoS * ( N1 - blockIndexNmin ) ) ];
+   if (kappa == -1) return -1;
+   if (sectorTwoS1[kappa] != TwoS1) return -1; //TwoS1/2 is shared by both spin parities
+   return kappa;
+
+}
+
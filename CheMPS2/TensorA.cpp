@@ -22,7 +22,7 @@
 #include "TensorA.h"
 #include "Lapack.h"
 
-CheMPS2::TensorA::TensorA(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn) : TensorS0Abase(indexIn, IdiffIn, movingRightIn, denBKIn){
+CheMPS2::TensorA::TensorA(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const bool ownsStorageIn) : TensorS0Abase(indexIn, IdiffIn, movingRightIn, denBKIn, ownsStorageIn){
 
 }
 
@@ -22,7 +22,7 @@
 #include "TensorB.h"
 #include "Lapack.h"
 
-CheMPS2::TensorB::TensorB(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn) : TensorS1Bbase(indexIn, IdiffIn, movingRightIn, denBKIn){
+CheMPS2::TensorB::TensorB(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const bool ownsStorageIn) : TensorS1Bbase(indexIn, IdiffIn, movingRightIn, denBKIn, ownsStorageIn){
 
 }
 
@@ -22,7 +22,7 @@
 #include "TensorC.h"
 #include "Lapack.h"
 
-CheMPS2::TensorC::TensorC(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn) : TensorF0Cbase(indexIn, IdiffIn, movingRightIn, denBKIn){
+CheMPS2::TensorC::TensorC(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const bool ownsStorageIn) : TensorF0Cbase(indexIn, IdiffIn, movingRightIn, denBKIn, ownsStorageIn){
 
 }
 
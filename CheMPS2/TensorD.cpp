@@ -23,7 +23,7 @@
 #include "TensorD.h"
 #include "Lapack.h"
 
-CheMPS2::TensorD::TensorD(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn) : TensorF1Dbase(indexIn, IdiffIn, movingRightIn, denBKIn){
+CheMPS2::TensorD::TensorD(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const bool ownsStorageIn) : TensorF1Dbase(indexIn, IdiffIn, movingRightIn, denBKIn, ownsStorageIn){
 
 }
 
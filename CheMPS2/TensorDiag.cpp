@@ -19,7 +19,7 @@
 
 #include "TensorDiag.h"
 
-CheMPS2::TensorDiag::TensorDiag(const int indexIn, const SyBookkeeper * denBKIn) : Tensor(){
+CheMPS2::TensorDiag::TensorDiag(const int indexIn, const SyBookkeeper * denBKIn, const bool ownsStorageIn) : Tensor(){
 
    index = indexIn;
    denBK = denBKIn;
@@ -56,7 +56,10 @@ CheMPS2::TensorDiag::TensorDiag(const int indexIn, const SyBookkeeper * denBKIn)
       }
    }
    
-   storage = new double[kappa2index[nKappa]];
+   ownsStorage = ownsStorageIn;
+   if (ownsStorage){ storage = new double[kappa2index[nKappa]]; }
+   
+   buildBlockIndex();
 
 }
 
@@ -66,7 +69,8 @@ CheMPS2::TensorDiag::~TensorDiag(){
    delete [] sectorTwoS1;
    delete [] sectorI1;
    delete [] kappa2index;
-   delete [] storage;
+   if (ownsStorage){ delete [] storage; }
+   deleteBlockIndex();
 
 }
 
@@ -78,11 +82,7 @@ int CheMPS2::TensorDiag::gKappa(const int N1, const int TwoS1, const int I1, con
 
    if ((N1!=N2) || (TwoS1!=TwoS2) || (I1!=I2)) return -1;
 
-   for (int cnt=0; cnt<nKappa; cnt++){
-      if ( (sectorN1[cnt]==N1) && (sectorTwoS1[cnt]==TwoS1) && (sectorI1[cnt]==I1) ) return cnt;
-   }
-   
-   return -1;
+   return gKappaFirstSector(N1,TwoS1,I1);
 
 }
       
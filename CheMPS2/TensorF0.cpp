@@ -23,7 +23,7 @@
 #include "TensorF0.h"
 #include "Lapack.h"
 
-CheMPS2::TensorF0::TensorF0(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn) : TensorF0Cbase(indexIn, IdiffIn, movingRightIn, denBKIn){
+CheMPS2::TensorF0::TensorF0(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const bool ownsStorageIn) : TensorF0Cbase(indexIn, IdiffIn, movingRightIn, denBKIn, ownsStorageIn){
 
 }
 
@@ -23,7 +23,7 @@
 #include "TensorF0Cbase.h"
 #include "Lapack.h"
 
-CheMPS2::TensorF0Cbase::TensorF0Cbase(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn) : Tensor(){
+CheMPS2::TensorF0Cbase::TensorF0Cbase(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const bool ownsStorageIn) : Tensor(){
 
    index = indexIn; //boundary = index
    Idiff = IdiffIn;
@@ -72,7 +72,10 @@ CheMPS2::TensorF0Cbase::TensorF0Cbase(const int indexIn, const int IdiffIn, cons
       }
    }
    
-   storage = new double[kappa2index[nKappa]];
+   ownsStorage = ownsStorageIn;
+   if (ownsStorage){ storage = new double[kappa2index[nKappa]]; }
+   
+   buildBlockIndex();
 
 }
 
@@ -82,7 +85,8 @@ CheMPS2::TensorF0Cbase::~TensorF0Cbase(){
    delete [] sectorTwoS1;
    delete [] sectorI1;
    delete [] kappa2index;
-   delete [] storage;
+   if (ownsStorage){ delete [] storage; }
+   deleteBlockIndex();
 
 }
 
@@ -96,11 +100,7 @@ int CheMPS2::TensorF0Cbase::gKappa(const int N1, const int TwoS1, const int I1,
    if (N2!=N1) return -1;
    if (TwoS2!=TwoS1) return -1;
 
-   for (int cnt=0; cnt<nKappa; cnt++){
-      if ((sectorN1[cnt]==N1)&&(sectorTwoS1[cnt]==TwoS1)&&(sectorI1[cnt]==I1)) return cnt;
-   }
-   
-   return -1;
+   return gKappaFirstSector(N1,TwoS1,I1);
 
 }
       
@@ -22,9 +22,9 @@
 
 #include "TensorF1.h"
 #include "Lapack.h"
-#include "Gsl.h"
+#include "Wigner.h"
 
-CheMPS2::TensorF1::TensorF1(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn) : TensorF1Dbase(indexIn, IdiffIn, movingRightIn, denBKIn){
+CheMPS2::TensorF1::TensorF1(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const bool ownsStorageIn) : TensorF1Dbase(indexIn, IdiffIn, movingRightIn, denBKIn, ownsStorageIn){
 
 }
 
@@ -67,7 +67,7 @@ void CheMPS2::TensorF1::makenewRight(TensorT * denT){ //Idiff = Itrivial
                char trans = 'T';
                char notrans = 'N';
                int fase = ((((TwoSL + sectorTwoSD[ikappa] + 3)/2)%2)!=0)?-1:1;
-               double alpha = fase * sqrt(3.0*(sectorTwoS1[ikappa]+1)) * gsl_sf_coupling_6j(1,1,2,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSL);
+               double alpha = fase * sqrt(3.0*(sectorTwoS1[ikappa]+1)) * Wigner::wigner6j(1,1,2,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSL);
                double beta = 1.0; //add
                dgemm_(&trans,&notrans,&dimRU,&dimRD,&dimL,&alpha,BlockTup,&dimL,BlockTdo,&dimL,&beta,storage+kappa2index[ikappa],&dimRU);
          
@@ -99,7 +99,7 @@ void CheMPS2::TensorF1::makenewLeft(TensorT * denT){ //Idiff = Itrivial
                char trans = 'T';
                char notrans = 'N';
                int fase = ((((sectorTwoSD[ikappa] + TwoSR + 1)/2)%2)!=0)?-1:1;
-               double alpha = fase * sqrt(3.0/(sectorTwoS1[ikappa]+1.0)) * (TwoSR + 1) * gsl_sf_coupling_6j(1,1,2,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSR);
+               double alpha = fase * sqrt(3.0/(sectorTwoS1[ikappa]+1.0)) * (TwoSR + 1) * Wigner::wigner6j(1,1,2,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSR);
                double beta = 1.0; //add
                dgemm_(&notrans,&trans,&dimLU,&dimLD,&dimR,&alpha,BlockTup,&dimLU,BlockTdown,&dimLD,&beta,storage+kappa2index[ikappa],&dimLU);
          
@@ -165,10 +165,10 @@ void CheMPS2::TensorF1::makenewRight(TensorL * denL, TensorT * denT, double * wo
             double alpha;
             if (geval<=1){
                int fase = ((((TwoSLU + sectorTwoSD[ikappa] + 3)/2)%2)!=0)?-1:1;
-               alpha = fase * sqrt(3.0*(sectorTwoS1[ikappa]+1)) * gsl_sf_coupling_6j(1,1,2,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSLU);
+               alpha = fase * sqrt(3.0*(sectorTwoS1[ikappa]+1)) * Wigner::wigner6j(1,1,2,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSLU);
             } else {
                int fase = ((((sectorTwoS1[ikappa] + sectorTwoSD[ikappa] + 2)/2)%2)!=0)?-1:1;
-               alpha = fase * sqrt(3.0*(TwoSLD+1)) * gsl_sf_coupling_6j(1,1,2,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSLD);
+               alpha = fase * sqrt(3.0*(TwoSLD+1)) * Wigner::wigner6j(1,1,2,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSLD);
             }
             double beta = 0.0; //set
             dgemm_(&trans,&notrans,&dimUR,&dimLD,&dimLU,&alpha,BlockTup,&dimLU,BlockL,&dimLU,&beta,workmem,&dimUR);
@@ -238,10 +238,10 @@ void CheMPS2::TensorF1::makenewLeft(TensorL * denL, TensorT * denT, double * wor
             double alpha;
             if (geval<=1){
                int fase = ((((sectorTwoSD[ikappa] + TwoSRD + 1)/2)%2)!=0)?-1:1;
-               alpha = fase * sqrt(3.0/(sectorTwoS1[ikappa]+1.0)) * (TwoSRD+1) * gsl_sf_coupling_6j(1,1,2,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSRD);
+               alpha = fase * sqrt(3.0/(sectorTwoS1[ikappa]+1.0)) * (TwoSRD+1) * Wigner::wigner6j(1,1,2,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSRD);
             } else {
                int fase = (((sectorTwoS1[ikappa])%2)!=0)?-1:1;
-               alpha = fase * sqrt(3.0 *(TwoSRU+1.0)*(sectorTwoSD[ikappa]+1.0)/(sectorTwoS1[ikappa]+1.0)) * gsl_sf_coupling_6j(1,1,2,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSRU);
+               alpha = fase * sqrt(3.0 *(TwoSRU+1.0)*(sectorTwoSD[ikappa]+1.0)/(sectorTwoS1[ikappa]+1.0)) * Wigner::wigner6j(1,1,2,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSRU);
             }
             double beta = 0.0; //set
             dgemm_(&notrans,&notrans,&dimUL,&dimRD,&dimRU,&alpha,BlockTup,&dimUL,BlockL,&dimRU,&beta,workmem,&dimUL);
@@ -24,7 +24,7 @@
 #include "Lapack.h"
 #include "Gsl.h"
 
-CheMPS2::TensorL::TensorL(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn) : TensorSwap(indexIn, IdiffIn, movingRightIn, denBKIn){
+CheMPS2::TensorL::TensorL(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const bool ownsStorageIn) : TensorSwap(indexIn, IdiffIn, movingRightIn, denBKIn, ownsStorageIn){
 
 }
 
@@ -24,7 +24,7 @@
 #include "TensorO.h"
 #include "Lapack.h"
 
-CheMPS2::TensorO::TensorO(const int indexIn, const bool movingRightIn, const SyBookkeeper * denBKupIn, const SyBookkeeper * denBKdownIn, const Problem * ProbIn) : Tensor(){
+CheMPS2::TensorO::TensorO(const int indexIn, const bool movingRightIn, const SyBookkeeper * denBKupIn, const SyBookkeeper * denBKdownIn, const Problem * ProbIn, const bool ownsStorageIn) : Tensor(){
 
    index = indexIn;
    denBKup = denBKupIn;
@@ -66,7 +66,10 @@ CheMPS2::TensorO::TensorO(const int indexIn, const bool movingRightIn, const SyB
       }
    }
    
-   storage = new double[kappa2index[nKappa]];
+   ownsStorage = ownsStorageIn;
+   if (ownsStorage){ storage = new double[kappa2index[nKappa]]; }
+   
+   buildBlockIndex();
 
 }
 
@@ -76,7 +79,8 @@ CheMPS2::TensorO::~TensorO(){
    delete [] sectorTwoS1;
    delete [] sectorI1;
    delete [] kappa2index;
-   delete [] storage;
+   if (ownsStorage){ delete [] storage; }
+   deleteBlockIndex();
 
 }
 
@@ -88,11 +92,7 @@ int CheMPS2::TensorO::gKappa(const int N1, const int TwoS1, const int I1, const
 
    if ((N1!=N2) || (TwoS1!=TwoS2) || (I1!=I2)) return -1;
 
-   for (int cnt=0; cnt<nKappa; cnt++){
-      if ( (sectorN1[cnt]==N1) && (sectorTwoS1[cnt]==TwoS1) && (sectorI1[cnt]==I1) ) return cnt;
-   }
-   
-   return -1;
+   return gKappaFirstSector(N1,TwoS1,I1);
 
 }
       
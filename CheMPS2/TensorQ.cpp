@@ -22,9 +22,9 @@
 
 #include "TensorQ.h"
 #include "Lapack.h"
-#include "Gsl.h"
+#include "Wigner.h"
 
-CheMPS2::TensorQ::TensorQ(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const Problem * ProbIn, const int siteIn) : TensorSwap(indexIn, IdiffIn, movingRightIn, denBKIn){
+CheMPS2::TensorQ::TensorQ(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const Problem * ProbIn, const int siteIn, const bool ownsStorageIn) : TensorSwap(indexIn, IdiffIn, movingRightIn, denBKIn, ownsStorageIn){
 
    Prob = ProbIn;
    site = siteIn;
@@ -200,7 +200,7 @@ void CheMPS2::TensorQ::AddTermsLRight(TensorL ** Ltensors, TensorT * denT, doubl
                   dimLD = denBK->gCurrentDim(index-1, sectorN1[ikappa]  , TwoSLD, ILD);
                   if ((dimLU>0) && (dimLD>0)){
                      int fase = ((((sectorTwoS1[ikappa]+TwoSLD)/2)%2)!=0)?-1:1;
-                     double factor = fase * sqrt((TwoSLD+1)*(sectorTwoS1[ikappa]+1.0)) * gsl_sf_coupling_6j(sectorTwoS1[ikappa], sectorTwoSD[ikappa], 1, TwoSLD, TwoSLU, 1);
+                     double factor = fase * sqrt((TwoSLD+1)*(sectorTwoS1[ikappa]+1.0)) * Wigner::wigner6j(sectorTwoS1[ikappa], sectorTwoSD[ikappa], 1, TwoSLD, TwoSLU, 1);
                   
                      int dimLUxLD = dimLU * dimLD;
                      for (int cnt=0; cnt<dimLUxLD; cnt++){ workmem[cnt] = 0.0; }
@@ -335,7 +335,7 @@ void CheMPS2::TensorQ::AddTermsLLeft(TensorL ** Ltensors, TensorT * denT, double
                   dimRD = denBK->gCurrentDim(index+1, sectorN1[ikappa]+2, TwoSRD, IRD);
                   if ((dimRU>0) && (dimRD>0)){
                      int fase = ((((sectorTwoSD[ikappa]+TwoSRU)/2)%2)!=0)?-1:1;
-                     double factor1 = fase * sqrt((TwoSRU+1.0)/(sectorTwoSD[ikappa]+1.0)) * (TwoSRD+1) * gsl_sf_coupling_6j(sectorTwoS1[ikappa], sectorTwoSD[ikappa], 1, TwoSRD, TwoSRU, 1);
+                     double factor1 = fase * sqrt((TwoSRU+1.0)/(sectorTwoSD[ikappa]+1.0)) * (TwoSRD+1) * Wigner::wigner6j(sectorTwoS1[ikappa], sectorTwoSD[ikappa], 1, TwoSRD, TwoSRU, 1);
                      double factor2 = (TwoSRD+1.0)/(sectorTwoSD[ikappa]+1.0);
                   
                      int dimRUxRD = dimRU * dimRD;
@@ -398,7 +398,7 @@ void CheMPS2::TensorQ::AddTermsABRight(TensorA * denA, TensorB * denB, TensorT *
          if ((dimLU>0) && (dimLD>0)){
          
             int fase = ((((TwoSLU + sectorTwoSD[ikappa] + 2)/2)%2)!=0)?-1:1;
-            double factorB = fase * sqrt(3.0*(sectorTwoS1[ikappa]+1)) * gsl_sf_coupling_6j(1,2,1,sectorTwoSD[ikappa],sectorTwoS1[ikappa],TwoSLU);
+            double factorB = fase * sqrt(3.0*(sectorTwoS1[ikappa]+1)) * Wigner::wigner6j(1,2,1,sectorTwoSD[ikappa],sectorTwoS1[ikappa],TwoSLU);
             
             double alpha;
             double * mem;
@@ -445,7 +445,7 @@ void CheMPS2::TensorQ::AddTermsABRight(TensorA * denA, TensorB * denB, TensorT *
          if ((dimLU>0) && (dimLD>0)){
          
             int fase = ((((sectorTwoS1[ikappa] + sectorTwoSD[ikappa] + 1)/2)%2)!=0)?-1:1;
-            double factorB = fase * sqrt(3.0*(TwoSLD+1)) * gsl_sf_coupling_6j(1,2,1,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSLD);
+            double factorB = fase * sqrt(3.0*(TwoSLD+1)) * Wigner::wigner6j(1,2,1,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSLD);
             
             double alpha;
             double * mem;
@@ -501,7 +501,7 @@ void CheMPS2::TensorQ::AddTermsABLeft(TensorA * denA, TensorB * denB, TensorT *
          if ((dimRU>0) && (dimRD>0)){
          
             int fase = ((((TwoSRD + sectorTwoS1[ikappa] + 2)/2)%2)!=0)?-1:1;
-            double factorB = fase * sqrt(3.0/(sectorTwoSD[ikappa]+1.0)) * (TwoSRD+1) * gsl_sf_coupling_6j(1,1,2,sectorTwoS1[ikappa],TwoSRD,sectorTwoSD[ikappa]);
+            double factorB = fase * sqrt(3.0/(sectorTwoSD[ikappa]+1.0)) * (TwoSRD+1) * Wigner::wigner6j(1,1,2,sectorTwoS1[ikappa],TwoSRD,sectorTwoSD[ikappa]);
             
             double alpha;
             double * mem;
@@ -548,7 +548,7 @@ void CheMPS2::TensorQ::AddTermsABLeft(TensorA * denA, TensorB * denB, TensorT *
          if ((dimRU>0) && (dimRD>0)){
          
             int fase = ((((sectorTwoS1[ikappa] + sectorTwoSD[ikappa] + 1)/2)%2)!=0)?-1:1;
-            double factorB = fase * sqrt(3.0*(TwoSRU+1)) * gsl_sf_coupling_6j(1,1,2,TwoSRU,sectorTwoSD[ikappa],sectorTwoS1[ikappa]);
+            double factorB = fase * sqrt(3.0*(TwoSRU+1)) * Wigner::wigner6j(1,1,2,TwoSRU,sectorTwoSD[ikappa],sectorTwoS1[ikappa]);
             
             double alpha;
             double * mem;
@@ -615,7 +615,7 @@ void CheMPS2::TensorQ::AddTermsCF0DF1Right(TensorC * denC, TensorF0 ** deF0s, Te
             
             //first set to D
             int fase = ((((sectorTwoS1[ikappa]+sectorTwoSD[ikappa]+1)/2)%2)!=0)?-1:1;
-            double factor = fase * sqrt(3.0*(TwoSLD+1)) * gsl_sf_coupling_6j(1,2,1,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSLD);
+            double factor = fase * sqrt(3.0*(TwoSLD+1)) * Wigner::wigner6j(1,2,1,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSLD);
             double * block = denD->gStorage( sectorN1[ikappa], sectorTwoS1[ikappa], sectorI1[ikappa], sectorN1[ikappa], TwoSLD, ILD );
             for (int cnt=0; cnt<dimLUxLD; cnt++){ workmem[cnt] = factor * block[cnt]; }
             
@@ -684,7 +684,7 @@ void CheMPS2::TensorQ::AddTermsCF0DF1Right(TensorC * denC, TensorF0 ** deF0s, Te
             
             //first set to D
             int fase = ((((TwoSLU + sectorTwoSD[ikappa])/2)%2)!=0)?-1:1;
-            double factor = fase * sqrt(3.0*(sectorTwoS1[ikappa]+1)) * gsl_sf_coupling_6j(1,2,1,sectorTwoSD[ikappa],sectorTwoS1[ikappa],TwoSLU);
+            double factor = fase * sqrt(3.0*(sectorTwoS1[ikappa]+1)) * Wigner::wigner6j(1,2,1,sectorTwoSD[ikappa],sectorTwoS1[ikappa],TwoSLU);
             double * block = denD->gStorage( sectorN1[ikappa]-1, TwoSLU, ILU, sectorN1[ikappa]-1, sectorTwoSD[ikappa], IRD );
             for (int cnt=0; cnt<dimLUxLD; cnt++){ workmem[cnt] = factor * block[cnt]; }
             
@@ -764,7 +764,7 @@ void CheMPS2::TensorQ::AddTermsCF0DF1Left(TensorC * denC, TensorF0 ** deF0s, Ten
             
             //first set to D
             int fase = ((((sectorTwoS1[ikappa]+TwoSRU+3)/2)%2)!=0)?-1:1;
-            double factor = fase * sqrt(3.0/(sectorTwoSD[ikappa]+1.0)) * (TwoSRU+1) * gsl_sf_coupling_6j(1,1,2,TwoSRU,sectorTwoSD[ikappa],sectorTwoS1[ikappa]);
+            double factor = fase * sqrt(3.0/(sectorTwoSD[ikappa]+1.0)) * (TwoSRU+1) * Wigner::wigner6j(1,1,2,TwoSRU,sectorTwoSD[ikappa],sectorTwoS1[ikappa]);
             double * block = denD->gStorage( sectorN1[ikappa]+1, TwoSRU, IRU, sectorN1[ikappa]+1, sectorTwoSD[ikappa], ILD );
             for (int cnt=0; cnt<dimRUxRD; cnt++){ workmem[cnt] = factor * block[cnt]; }
             
@@ -833,7 +833,7 @@ void CheMPS2::TensorQ::AddTermsCF0DF1Left(TensorC * denC, TensorF0 ** deF0s, Ten
             
             //first set to D
             int fase = (((TwoSRD+1)%2)!=0)?-1:1;
-            double factor = fase * sqrt(3.0*(TwoSRD+1.0)*(sectorTwoS1[ikappa]+1.0)/(sectorTwoSD[ikappa]+1.0)) * gsl_sf_coupling_6j(1,1,2,sectorTwoS1[ikappa],TwoSRD,sectorTwoSD[ikappa]);
+            double factor = fase * sqrt(3.0*(TwoSRD+1.0)*(sectorTwoS1[ikappa]+1.0)/(sectorTwoSD[ikappa]+1.0)) * Wigner::wigner6j(1,1,2,sectorTwoS1[ikappa],TwoSRD,sectorTwoSD[ikappa]);
             double * block = denD->gStorage( sectorN1[ikappa]+2, sectorTwoS1[ikappa], sectorI1[ikappa], sectorN1[ikappa]+2, TwoSRD, IRD );
             for (int cnt=0; cnt<dimRUxRD; cnt++){ workmem[cnt] = factor * block[cnt]; }
             
@@ -23,7 +23,7 @@
 #include "TensorS0.h"
 #include "Lapack.h"
 
-CheMPS2::TensorS0::TensorS0(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn) : TensorS0Abase(indexIn, IdiffIn, movingRightIn, denBKIn){
+CheMPS2::TensorS0::TensorS0(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const bool ownsStorageIn) : TensorS0Abase(indexIn, IdiffIn, movingRightIn, denBKIn, ownsStorageIn){
 
 }
 
@@ -22,7 +22,7 @@
 #include "TensorS0Abase.h"
 #include "Lapack.h"
 
-CheMPS2::TensorS0Abase::TensorS0Abase(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn) : Tensor(){
+CheMPS2::TensorS0Abase::TensorS0Abase(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const bool ownsStorageIn) : Tensor(){
 
    index = indexIn; //boundary = index
    Idiff = IdiffIn;
@@ -71,7 +71,10 @@ CheMPS2::TensorS0Abase::TensorS0Abase(const int indexIn, const int IdiffIn, cons
       }
    }
    
-   storage = new double[kappa2index[nKappa]];
+   ownsStorage = ownsStorageIn;
+   if (ownsStorage){ storage = new double[kappa2index[nKappa]]; }
+   
+   buildBlockIndex();
 
 }
 
@@ -81,7 +84,8 @@ CheMPS2::TensorS0Abase::~TensorS0Abase(){
    delete [] sectorTwoS1;
    delete [] sectorI1;
    delete [] kappa2index;
-   delete [] storage;
+   if (ownsStorage){ delete [] storage; }
+   deleteBlockIndex();
 
 }
 
@@ -95,11 +99,7 @@ int CheMPS2::TensorS0Abase::gKappa(const int N1, const int TwoS1, const int I1,
    if (N2!=N1+2) return -1;
    if (TwoS1!=TwoS2) return -1;
 
-   for (int cnt=0; cnt<nKappa; cnt++){
-      if ((sectorN1[cnt]==N1)&&(sectorTwoS1[cnt]==TwoS1)&&(sectorI1[cnt]==I1)) return cnt;
-   }
-   
-   return -1;
+   return gKappaFirstSector(N1,TwoS1,I1);
 
 }
       
@@ -22,9 +22,9 @@
 
 #include "TensorS1.h"
 #include "Lapack.h"
-#include "Gsl.h"
+#include "Wigner.h"
 
-CheMPS2::TensorS1::TensorS1(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn) : TensorS1Bbase(indexIn, IdiffIn, movingRightIn, denBKIn){
+CheMPS2::TensorS1::TensorS1(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const bool ownsStorageIn) : TensorS1Bbase(indexIn, IdiffIn, movingRightIn, denBKIn, ownsStorageIn){
 
 }
 
@@ -94,10 +94,10 @@ void CheMPS2::TensorS1::makenewRight(TensorL * denL, TensorT * denT, double * wo
             double alpha = 1.0;
             if (geval<=1){
                int fase = ((((sectorTwoS1[ikappa] + sectorTwoSD[ikappa] + 2)/2)%2)!=0)?-1:1;
-               alpha = fase * sqrt(3.0*(TwoSLD+1)) * gsl_sf_coupling_6j(1,1,2,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSLD);
+               alpha = fase * sqrt(3.0*(TwoSLD+1)) * Wigner::wigner6j(1,1,2,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSLD);
             } else {
                int fase = ((((TwoSLU + sectorTwoSD[ikappa] + 1)/2)%2)!=0)?-1:1;
-               alpha = fase * sqrt(3.0*(sectorTwoS1[ikappa]+1)) * gsl_sf_coupling_6j(1,1,2,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSLU);
+               alpha = fase * sqrt(3.0*(sectorTwoS1[ikappa]+1)) * Wigner::wigner6j(1,1,2,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSLU);
             }
             double beta = 0.0; //set
             dgemm_(&trans,&notrans,&dimUR,&dimLD,&dimLU,&alpha,BlockTup,&dimLU,BlockL,&dimLU,&beta,workmem,&dimUR);
@@ -167,10 +167,10 @@ void CheMPS2::TensorS1::makenewLeft(TensorL * denL, TensorT * denT, double * wor
             double alpha = 1.0;
             if (geval<=1){
                int fase = ((((sectorTwoS1[ikappa] + sectorTwoSD[ikappa] + 2)/2)%2)!=0)?-1:1;
-               alpha = fase * sqrt(3.0 * (TwoSRU+1)) * gsl_sf_coupling_6j(1,1,2,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSRU);
+               alpha = fase * sqrt(3.0 * (TwoSRU+1)) * Wigner::wigner6j(1,1,2,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSRU);
             } else {
                int fase = ((((sectorTwoS1[ikappa] + TwoSRD + 1)/2)%2)!=0)?-1:1;
-               alpha = fase * sqrt(3.0 / (sectorTwoSD[ikappa] + 1.0)) * (TwoSRD + 1) * gsl_sf_coupling_6j(1,1,2,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSRD);
+               alpha = fase * sqrt(3.0 / (sectorTwoSD[ikappa] + 1.0)) * (TwoSRD + 1) * Wigner::wigner6j(1,1,2,sectorTwoS1[ikappa],sectorTwoSD[ikappa],TwoSRD);
             }
             double beta = 0.0; //set
             dgemm_(&notrans,&notrans,&dimUL,&dimRD,&dimRU,&alpha,BlockTup,&dimUL,BlockL,&dimRU,&beta,workmem,&dimUL);
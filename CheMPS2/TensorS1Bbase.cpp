@@ -22,9 +22,9 @@
 
 #include "TensorS1Bbase.h"
 #include "Lapack.h"
-#include "Gsl.h"
+#include "Wigner.h"
 
-CheMPS2::TensorS1Bbase::TensorS1Bbase(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn) : Tensor(){
+CheMPS2::TensorS1Bbase::TensorS1Bbase(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const bool ownsStorageIn) : Tensor(){
 
    index = indexIn; //boundary = index
    Idiff = IdiffIn;
@@ -83,7 +83,10 @@ CheMPS2::TensorS1Bbase::TensorS1Bbase(const int indexIn, const int IdiffIn, cons
       }
    }
    
-   storage = new double[kappa2index[nKappa]];
+   ownsStorage = ownsStorageIn;
+   if (ownsStorage){ storage = new double[kappa2index[nKappa]]; }
+   
+   buildBlockIndex();
 
 }
 
@@ -94,7 +97,8 @@ CheMPS2::TensorS1Bbase::~TensorS1Bbase(){
    delete [] sectorI1;
    delete [] sectorTwoSD;
    delete [] kappa2index;
-   delete [] storage;
+   if (ownsStorage){ delete [] storage; }
+   deleteBlockIndex();
 
 }
 
@@ -107,8 +111,11 @@ int CheMPS2::TensorS1Bbase::gKappa(const int N1, const int TwoS1, const int I1,
    if ((denBK->directProd(I1,Idiff))!=I2) return -1;
    if (N2!=N1+2) return -1;
 
-   for (int cnt=0; cnt<nKappa; cnt++){
-      if ((sectorN1[cnt]==N1)&&(sectorTwoS1[cnt]==TwoS1)&&(sectorI1[cnt]==I1)&&(sectorTwoSD[cnt]==TwoS2)) return cnt;
+   const int first = gKappaFirstSector(N1,TwoS1,I1);
+   if (first == -1) return -1;
+   
+   for (int cnt=first; (cnt<nKappa) && (sectorN1[cnt]==N1) && (sectorTwoS1[cnt]==TwoS1) && (sectorI1[cnt]==I1); cnt++){
+      if (sectorTwoSD[cnt]==TwoS2) return cnt;
    }
    
    return -1;
@@ -210,7 +217,7 @@ void CheMPS2::TensorS1Bbase::updateMovingRight(TensorS1Bbase * S1BbasePrevious,
             double alpha = 1.0;
             if (geval>=2){
                int fase = ((((sectorTwoS1[ikappa] + TwoSDL + 3)/2)%2)!=0)?-1:1;
-               alpha = fase * sqrt((TwoSDL+1.0)*(sectorTwoS1[ikappa]+1)) * gsl_sf_coupling_6j(TwoSUL,TwoSDL,2,sectorTwoSD[ikappa],sectorTwoS1[ikappa],1);
+               alpha = fase * sqrt((TwoSDL+1.0)*(sectorTwoS1[ikappa]+1)) * Wigner::wigner6j(TwoSUL,TwoSDL,2,sectorTwoSD[ikappa],sectorTwoS1[ikappa],1);
             }
             char trans = 'T';
             char notr = 'N';
@@ -297,7 +304,7 @@ void CheMPS2::TensorS1Bbase::updateMovingLeft(TensorS1Bbase * S1BbasePrevious, T
             double alpha = 1.0;
             if (geval>=2){
                int fase = ((((sectorTwoSD[ikappa] + TwoSUR + 3)/2)%2)!=0)?-1:1;
-               alpha = fase * (TwoSDR + 1) * sqrt((TwoSUR+1.0)/(sectorTwoSD[ikappa]+1.0)) * gsl_sf_coupling_6j(TwoSUR,TwoSDR,2,sectorTwoSD[ikappa],sectorTwoS1[ikappa],1);
+               alpha = fase * (TwoSDR + 1) * sqrt((TwoSUR+1.0)/(sectorTwoSD[ikappa]+1.0)) * Wigner::wigner6j(TwoSUR,TwoSDR,2,sectorTwoSD[ikappa],sectorTwoS1[ikappa],1);
             }
             char notr = 'N';
             double beta = 0.0; //set mem
@@ -22,9 +22,9 @@
 
 #include "TensorSwap.h"
 #include "Lapack.h"
-#include "Gsl.h"
+#include "Wigner.h"
 
-CheMPS2::TensorSwap::TensorSwap(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn) : Tensor(){
+CheMPS2::TensorSwap::TensorSwap(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const bool ownsStorageIn) : Tensor(){
 
    index = indexIn; //boundary = index
    Idiff = IdiffIn;
@@ -83,7 +83,10 @@ CheMPS2::TensorSwap::TensorSwap(const int indexIn, const int IdiffIn, const bool
       }
    }
    
-   storage = new double[kappa2index[nKappa]];
+   ownsStorage = ownsStorageIn;
+   if (ownsStorage){ storage = new double[kappa2index[nKappa]]; }
+   
+   buildBlockIndex();
 
 }
 
@@ -94,7 +97,8 @@ CheMPS2::TensorSwap::~TensorSwap(){
    delete [] sectorI1;
    delete [] sectorTwoSD;
    delete [] kappa2index;
-   delete [] storage;
+   if (ownsStorage){ delete [] storage; }
+   deleteBlockIndex();
 
 }
 
@@ -107,8 +111,11 @@ int CheMPS2::TensorSwap::gKappa(const int N1, const int TwoS1, const int I1, con
    if ((denBK->directProd(I1,Idiff))!=I2) return -1;
    if (N2!=N1+1) return -1;
 
-   for (int cnt=0; cnt<nKappa; cnt++){
-      if ((sectorN1[cnt]==N1)&&(sectorTwoS1[cnt]==TwoS1)&&(sectorI1[cnt]==I1)&&(sectorTwoSD[cnt]==TwoS2)) return cnt;
+   const int first = gKappaFirstSector(N1,TwoS1,I1);
+   if (first == -1) return -1;
+   
+   for (int cnt=first; (cnt<nKappa) && (sectorN1[cnt]==N1) && (sectorTwoS1[cnt]==TwoS1) && (sectorI1[cnt]==I1); cnt++){
+      if (sectorTwoSD[cnt]==TwoS2) return cnt;
    }
    
    return -1;
@@ -203,7 +210,7 @@ void CheMPS2::TensorSwap::updateMovingRight(TensorSwap * SwapPrevious, TensorT *
             double alpha = 1.0;
             if (geval>=2){
                int fase = ((((TwoSDL+sectorTwoS1[ikappa])/2)%2)!=0)?-1:1;
-               alpha = fase * sqrt((TwoSDL+1.0)*(sectorTwoS1[ikappa]+1.0)) * gsl_sf_coupling_6j(sectorTwoS1[ikappa],sectorTwoSD[ikappa],1,TwoSDL,TwoSUL,1);
+               alpha = fase * sqrt((TwoSDL+1.0)*(sectorTwoS1[ikappa]+1.0)) * Wigner::wigner6j(sectorTwoS1[ikappa],sectorTwoSD[ikappa],1,TwoSDL,TwoSUL,1);
             }
             char trans = 'T';
             char notr = 'N';
@@ -283,7 +290,7 @@ void CheMPS2::TensorSwap::updateMovingLeft(TensorSwap * SwapPrevious, TensorT *
             double alpha = 1.0;
             if (geval>=2){
                int fase = ((((sectorTwoSD[ikappa]+TwoSUR)/2)%2)!=0)?-1:1;
-               alpha = fase*(TwoSDR+1)*sqrt((TwoSUR+1.0)/(sectorTwoSD[ikappa]+1.0))*gsl_sf_coupling_6j(TwoSUR,TwoSDR,1,sectorTwoSD[ikappa],sectorTwoS1[ikappa],1);
+               alpha = fase*(TwoSDR+1)*sqrt((TwoSUR+1.0)/(sectorTwoSD[ikappa]+1.0))*Wigner::wigner6j(TwoSUR,TwoSDR,1,sectorTwoSD[ikappa],sectorTwoS1[ikappa],1);
             }
             char notr = 'N';
             double beta = 0.0; //set mem
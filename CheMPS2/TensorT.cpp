@@ -97,6 +97,9 @@ void CheMPS2::TensorT::AllocateAllArrays(){
    }
    
    storage = new double[kappa2index[nKappa]];
+   ownsStorage = true;
+   
+   buildBlockIndex();
 
 }
 
@@ -115,7 +118,8 @@ void CheMPS2::TensorT::DeleteAllArrays(){
    delete [] sectorTwoSR;
    delete [] sectorIR;
    delete [] kappa2index;
-   delete [] storage;
+   if (ownsStorage){ delete [] storage; }
+   deleteBlockIndex();
 
 }
 
@@ -132,8 +136,11 @@ double * CheMPS2::TensorT::gStorage() { return storage; }
       
 int CheMPS2::TensorT::gKappa(const int N1, const int TwoS1, const int I1, const int N2, const int TwoS2, const int I2) const{
 
-   for (int cnt=0; cnt<nKappa; cnt++){
-      if ((sectorN1[cnt]==N1)&&(sectorTwoS1[cnt]==TwoS1)&&(sectorI1[cnt]==I1)&&(sectorNR[cnt]==N2)&&(sectorTwoSR[cnt]==TwoS2)&&(sectorIR[cnt]==I2)) return cnt;
+   const int first = gKappaFirstSector(N1,TwoS1,I1);
+   if (first == -1) return -1;
+   
+   for (int cnt=first; (cnt<nKappa) && (sectorN1[cnt]==N1) && (sectorTwoS1[cnt]==TwoS1) && (sectorI1[cnt]==I1); cnt++){
+      if ((sectorNR[cnt]==N2)&&(sectorTwoSR[cnt]==TwoS2)&&(sectorIR[cnt]==I2)) return cnt;
    }
    
    return -1;
@@ -21,10 +21,11 @@
 #include <math.h>
 
 #include "TensorX.h"
+#include "ScratchArena.h"
 #include "Lapack.h"
-#include "Gsl.h"
+#include "Wigner.h"
 
-CheMPS2::TensorX::TensorX(const int indexIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const Problem * ProbIn) : TensorDiag(indexIn, denBKIn){
+CheMPS2::TensorX::TensorX(const int indexIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const Problem * ProbIn, const bool ownsStorageIn) : TensorDiag(indexIn, denBKIn, ownsStorageIn){
 
    movingRight = movingRightIn;
    Prob = ProbIn;
@@ -51,47 +52,43 @@ void CheMPS2::TensorX::update(TensorT * denT){
 
 void CheMPS2::TensorX::update(TensorT * denT, TensorL ** Ltensors, TensorX * Xtensor, TensorQ * Qtensor, TensorA * Atensor, TensorC * Ctensor, TensorF0 ** F0tensors, TensorD * Dtensor, TensorF1 ** F1tensors){
 
+   //PARALLEL
+   #pragma omp parallel for schedule(dynamic)
+   for (int ikappa=0; ikappa<nKappa; ikappa++){
+      updateBlock(ikappa, denT, Ltensors, Xtensor, Qtensor, Atensor, Ctensor, F0tensors, Dtensor, F1tensors);
+   }
+
+}
+
+void CheMPS2::TensorX::updateBlock(const int ikappa, TensorT * denT, TensorL ** Ltensors, TensorX * Xtensor, TensorQ * Qtensor, TensorA * Atensor, TensorC * Ctensor, TensorF0 ** F0tensors, TensorD * Dtensor, TensorF1 ** F1tensors){
+
    if (movingRight){
-      //PARALLEL
-      #pragma omp parallel for schedule(dynamic)
-      for (int ikappa=0; ikappa<nKappa; ikappa++){
-         makenewRight(ikappa, denT);
-         if (index>1){
-            const int dimL = denBK->gMaxDimAtBound(index-1);
-            const int dimR = denBK->gMaxDimAtBound(index);
-            double * workmemLL = new double[dimL*dimL];
-            double * workmemLR = new double[dimL*dimR];
-            double * workmemRR = new double[dimR*dimR];
-            addTermXRight(ikappa, denT, Xtensor, workmemLR);
-            addTermQLRight(ikappa, denT, Ltensors, Qtensor, workmemRR, workmemLR, workmemLL);
-            addTermARight(ikappa, denT, Atensor, workmemRR, workmemLR);
-            addTermCF0Right(ikappa, denT, Ctensor, F0tensors, workmemLL, workmemLR);
-            addTermDF1Right(ikappa, denT, Dtensor, F1tensors, workmemLL, workmemLR);
-            delete [] workmemLL;
-            delete [] workmemLR;
-            delete [] workmemRR;
-         }
+      makenewRight(ikappa, denT);
+      if (index>1){
+         const int dimL = denBK->gMaxDimAtBound(index-1);
+         const int dimR = denBK->gMaxDimAtBound(index);
+         double * workmemLL = ScratchArena::get(0, dimL*dimL);
+         double * workmemLR = ScratchArena::get(1, dimL*dimR);
+         double * workmemRR = ScratchArena::get(2, dimR*dimR);
+         addTermXRight(ikappa, denT, Xtensor, workmemLR);
+         addTermQLRight(ikappa, denT, Ltensors, Qtensor, workmemRR, workmemLR, workmemLL);
+         addTermARight(ikappa, denT, Atensor, workmemRR, workmemLR);
+         addTermCF0Right(ikappa, denT, Ctensor, F0tensors, workmemLL, workmemLR);
+         addTermDF1Right(ikappa, denT, Dtensor, F1tensors, workmemLL, workmemLR);
       }
    } else {
-      //PARALLEL
-      #pragma omp parallel for schedule(dynamic)
-      for (int ikappa=0; ikappa<nKappa; ikappa++){
-         makenewLeft(ikappa, denT);
-         if (index<Prob->gL()-1){
-            const int dimL = denBK->gMaxDimAtBound(index);
-            const int dimR = denBK->gMaxDimAtBound(index+1);
-            double * workmemLL = new double[dimL*dimL];
-            double * workmemLR = new double[dimL*dimR];
-            double * workmemRR = new double[dimR*dimR];
-            addTermXLeft(ikappa, denT, Xtensor, workmemLR);
-            addTermQLLeft(ikappa, denT, Ltensors, Qtensor, workmemLL, workmemLR, workmemRR);
-            addTermALeft(ikappa, denT, Atensor, workmemLR, workmemLL);
-            addTermCF0Left(ikappa, denT, Ctensor, F0tensors, workmemRR, workmemLR);
-            addTermDF1Left(ikappa, denT, Dtensor, F1tensors, workmemRR, workmemLR);
-            delete [] workmemLL;
-            delete [] workmemLR;
-            delete [] workmemRR;
-         }
+      makenewLeft(ikappa, denT);
+      if (index<Prob->gL()-1){
+         const int dimL = denBK->gMaxDimAtBound(index);
+         const int dimR = denBK->gMaxDimAtBound(index+1);
+         double * workmemLL = ScratchArena::get(0, dimL*dimL);
+         double * workmemLR = ScratchArena::get(1, dimL*dimR);
+         double * workmemRR = ScratchArena::get(2, dimR*dimR);
+         addTermXLeft(ikappa, denT, Xtensor, workmemLR);
+         addTermQLLeft(ikappa, denT, Ltensors, Qtensor, workmemLL, workmemLR, workmemRR);
+         addTermALeft(ikappa, denT, Atensor, workmemLR, workmemLL);
+         addTermCF0Left(ikappa, denT, Ctensor, F0tensors, workmemRR, workmemLR);
+         addTermDF1Left(ikappa, denT, Dtensor, F1tensors, workmemRR, workmemLR);
       }
    }
 
@@ -680,7 +677,7 @@ void CheMPS2::TensorX::addTermDF1Right(const int ikappa, TensorT * denT, TensorD
          double * BlockTdown = (TwoSLup==TwoSLdown)? BlockTup : denT->gStorage(NL,TwoSLdown,IL,sectorN1[ikappa],sectorTwoS1[ikappa],sectorI1[ikappa]);
          
          int fase = ((((TwoSLdown + sectorTwoS1[ikappa] + 1)/2)%2)!=0)?-1:1;
-         double factor = fase * sqrt(3.0 * (TwoSLup+1)) * gsl_sf_coupling_6j(1,1,2,TwoSLup,TwoSLdown,sectorTwoS1[ikappa]);
+         double factor = fase * sqrt(3.0 * (TwoSLup+1)) * Wigner::wigner6j(1,1,2,TwoSLup,TwoSLdown,sectorTwoS1[ikappa]);
          double beta = 0.0; //set
          char totrans = 'T';
          dgemm_(&totrans, &totrans, &dimR, &dimLdown, &dimLup, &factor, BlockTup, &dimLup, workmemLL, &dimLdown, &beta, workmemLR, &dimR);
@@ -745,7 +742,7 @@ void CheMPS2::TensorX::addTermDF1Left(const int ikappa, TensorT * denT, TensorD
          double * BlockTdown = (TwoSRup == TwoSRdown)? BlockTup : denT->gStorage(sectorN1[ikappa],sectorTwoS1[ikappa],sectorI1[ikappa],NR,TwoSRdown,IR);
          
          int fase = ((((sectorTwoS1[ikappa] + TwoSRdown + 3)/2)%2)!=0)?-1:1;
-         double factor = fase*sqrt(3.0 *(TwoSRup+1))*((TwoSRdown + 1.0)/(sectorTwoS1[ikappa]+1.0))*gsl_sf_coupling_6j(1,1,2,TwoSRup,TwoSRdown,sectorTwoS1[ikappa]);
+         double factor = fase*sqrt(3.0 *(TwoSRup+1))*((TwoSRdown + 1.0)/(sectorTwoS1[ikappa]+1.0))*Wigner::wigner6j(1,1,2,TwoSRup,TwoSRdown,sectorTwoS1[ikappa]);
          double beta = 0.0; //set
          char trans = 'T';
          char notr = 'N';
@@ -17,6 +17,7 @@
    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 */
 
+#include <hdf5.h>
 #include <stdlib.h>
 #include <math.h>
 #include <algorithm>
@@ -24,9 +25,11 @@
 #include <iostream>
 
 #include "TwoDM.h"
+#include "ScratchArena.h"
 #include "Lapack.h"
-#include "Gsl.h"
+#include "Wigner.h"
 
+using std::cerr;
 using std::endl;
 using std::ofstream;
 using std::ios;
@@ -37,11 +40,46 @@ CheMPS2::TwoDM::TwoDM(const SyBookkeeper * denBKIn, const Problem * ProbIn){
    denBK = denBKIn;
    Prob = ProbIn;
    L = denBK->gL();
+   const int nIrreps = denBK->getNumberOfIrreps();
    
-   TwoDMA = new double[L*L*L*L];
-   TwoDMB = new double[L*L*L*L];
+   //Number the pairs per center irrep: see TwoDM.h
+   int * nPairs = new int[nIrreps];
+   int * nPairsX = new int[nIrreps];
+   for (int Icent=0; Icent<nIrreps; Icent++){
+      nPairs[Icent] = 0;
+      nPairsX[Icent] = 0;
+   }
+   pairIndex = new int[L*L];
+   pairIndexX = new int[L*L];
+   for (int j=0; j<L; j++){
+      for (int i=0; i<=j; i++){
+         const int Icent = denBK->directProd(denBK->gIrrep(i), denBK->gIrrep(j));
+         pairIndex[i + L*j] = nPairs[Icent];
+         nPairs[Icent]++;
+         if (i<j){
+            pairIndexX[i + L*j] = nPairsX[Icent];
+            nPairsX[Icent]++;
+         } else {
+            pairIndexX[i + L*j] = -1;
+         }
+      }
+   }
    
-   for (int cnt=0; cnt<L*L*L*L; cnt++){
+   blockOffset = new long long[2*nIrreps];
+   arraySize = 0;
+   for (int Icent=0; Icent<nIrreps; Icent++){
+      blockOffset[2*Icent] = arraySize;
+      arraySize += ((long long) nPairs[Icent]) * (nPairs[Icent] + 1) / 2;
+      blockOffset[2*Icent+1] = arraySize;
+      arraySize += ((long long) nPairsX[Icent]) * (nPairsX[Icent] + 1) / 2;
+   }
+   delete [] nPairs;
+   delete [] nPairsX;
+   
+   TwoDMA = new double[arraySize];
+   TwoDMB = new double[arraySize];
+   
+   for (long long cnt=0; cnt<arraySize; cnt++){
       TwoDMA[cnt] = 0.0;
       TwoDMB[cnt] = 0.0;
    }
@@ -52,54 +90,88 @@ CheMPS2::TwoDM::~TwoDM(){
 
    delete [] TwoDMA;
    delete [] TwoDMB;
+   delete [] pairIndex;
+   delete [] pairIndexX;
+   delete [] blockOffset;
+
+}
+
+long long CheMPS2::TwoDM::getIndex(const int cnt1, const int cnt2, const int cnt3, const int cnt4) const{
+
+   const int Icent = denBK->directProd(denBK->gIrrep(cnt1), denBK->gIrrep(cnt2));
+   if (Icent != denBK->directProd(denBK->gIrrep(cnt3), denBK->gIrrep(cnt4))){ return -1; }
+   
+   //Gamma_ijkl = Gamma_jilk: make sure that i<=j
+   const bool swap = (cnt1 > cnt2);
+   const int i = (swap) ? cnt2 : cnt1;
+   const int j = (swap) ? cnt1 : cnt2;
+   const int k = (swap) ? cnt4 : cnt3;
+   const int l = (swap) ? cnt3 : cnt4;
+   
+   int p, q, block;
+   if (k<=l){
+      p = pairIndex[i + L*j];
+      q = pairIndex[k + L*l];
+      block = 2*Icent;
+   } else if (i==j){ //Gamma_iikl = Gamma_iilk
+      p = pairIndex[i + L*j];
+      q = pairIndex[l + L*k];
+      block = 2*Icent;
+   } else {
+      p = pairIndexX[i + L*j];
+      q = pairIndexX[l + L*k];
+      block = 2*Icent+1;
+   }
+   
+   //Gamma_ijkl = Gamma_klij: lower triangle
+   if (p>=q){ return blockOffset[block] + q + ((long long) p) * (p + 1) / 2; }
+   return blockOffset[block] + p + ((long long) q) * (q + 1) / 2;
 
 }
 
 void CheMPS2::TwoDM::setTwoDMA_DMRG(const int cnt1, const int cnt2, const int cnt3, const int cnt4, const double value){
 
-   TwoDMA[cnt1 + L*(cnt2 + L*(cnt3 + L*cnt4))] = value;
-   TwoDMA[cnt2 + L*(cnt1 + L*(cnt4 + L*cnt3))] = value;
-   TwoDMA[cnt3 + L*(cnt4 + L*(cnt1 + L*cnt2))] = value;
-   TwoDMA[cnt4 + L*(cnt3 + L*(cnt2 + L*cnt1))] = value;
+   const long long index = getIndex(cnt1, cnt2, cnt3, cnt4);
+   if (index >= 0){ TwoDMA[index] = value; }
 
 }
 
 void CheMPS2::TwoDM::setTwoDMB_DMRG(const int cnt1, const int cnt2, const int cnt3, const int cnt4, const double value){
 
-   TwoDMB[cnt1 + L*(cnt2 + L*(cnt3 + L*cnt4))] = value;
-   TwoDMB[cnt2 + L*(cnt1 + L*(cnt4 + L*cnt3))] = value;
-   TwoDMB[cnt3 + L*(cnt4 + L*(cnt1 + L*cnt2))] = value;
-   TwoDMB[cnt4 + L*(cnt3 + L*(cnt2 + L*cnt1))] = value;
+   const long long index = getIndex(cnt1, cnt2, cnt3, cnt4);
+   if (index >= 0){ TwoDMB[index] = value; }
 
 }
 
 double CheMPS2::TwoDM::getTwoDMA_DMRG(const int cnt1, const int cnt2, const int cnt3, const int cnt4) const{
 
-   return TwoDMA[cnt1 + L*(cnt2 + L*(cnt3 + L*cnt4))];
+   const long long index = getIndex(cnt1, cnt2, cnt3, cnt4);
+   return (index >= 0) ? TwoDMA[index] : 0.0;
 
 }
 
 double CheMPS2::TwoDM::getTwoDMB_DMRG(const int cnt1, const int cnt2, const int cnt3, const int cnt4) const{
 
-   return TwoDMB[cnt1 + L*(cnt2 + L*(cnt3 + L*cnt4))];
+   const long long index = getIndex(cnt1, cnt2, cnt3, cnt4);
+   return (index >= 0) ? TwoDMB[index] : 0.0;
 
 }
 
 double CheMPS2::TwoDM::getTwoDMA_HAM(const int cnt1, const int cnt2, const int cnt3, const int cnt4) const{
 
    if (Prob->gReorderD2h()){
-      return TwoDMA[Prob->gf1(cnt1) + L*(Prob->gf1(cnt2) + L*(Prob->gf1(cnt3) + L*Prob->gf1(cnt4)))];
+      return getTwoDMA_DMRG(Prob->gf1(cnt1), Prob->gf1(cnt2), Prob->gf1(cnt3), Prob->gf1(cnt4));
    }
-   return TwoDMA[cnt1 + L*(cnt2 + L*(cnt3 + L*cnt4))];
+   return getTwoDMA_DMRG(cnt1, cnt2, cnt3, cnt4);
 
 }
 
 double CheMPS2::TwoDM::getTwoDMB_HAM(const int cnt1, const int cnt2, const int cnt3, const int cnt4) const{
 
    if (Prob->gReorderD2h()){
-      return TwoDMB[Prob->gf1(cnt1) + L*(Prob->gf1(cnt2) + L*(Prob->gf1(cnt3) + L*Prob->gf1(cnt4)))];
+      return getTwoDMB_DMRG(Prob->gf1(cnt1), Prob->gf1(cnt2), Prob->gf1(cnt3), Prob->gf1(cnt4));
    }
-   return TwoDMB[cnt1 + L*(cnt2 + L*(cnt3 + L*cnt4))];
+   return getTwoDMB_DMRG(cnt1, cnt2, cnt3, cnt4);
 
 }
 
@@ -186,64 +258,204 @@ void CheMPS2::TwoDM::print2DMAandB_HAM(){
 
 }
 
-void CheMPS2::TwoDM::FillSite(TensorT * denT, TensorL *** Ltens, TensorF0 **** F0tens, TensorF1 **** F1tens, TensorS0 **** S0tens, TensorS1 **** S1tens){
+void CheMPS2::TwoDM::save(const std::string name) const{
 
-   int theindex = denT->gIndex();
-   int DIM = max(denBK->gMaxDimAtBound(theindex), denBK->gMaxDimAtBound(theindex+1));
-   double * workmem = new double[DIM*DIM];
-   double * workmem2 = new double[DIM*DIM];
+   //The orbital irreps in DMRG order, and the DMRG index of each Hamiltonian orbital
+   int * irreps = new int[L];
+   int * HamToDMRG = new int[L];
+   for (int orb=0; orb<L; orb++){
+      irreps[orb] = denBK->gIrrep(orb);
+      HamToDMRG[orb] = (Prob->gReorderD2h()) ? Prob->gf1(orb) : orb;
+   }
+   long long theTotalSize = arraySize;
+
+   //The hdf5 file
+   hid_t file_id = H5Fcreate(name.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+      
+      //The metadata
+      hid_t group_id = H5Gcreate(file_id, "/MetaData", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+       
+         //The orbital irreps
+         hsize_t dimarray       = L;
+         hid_t dataspace_id     = H5Screate_simple(1, &dimarray, NULL);
+         hid_t dataset_id       = H5Dcreate(group_id, "Irreps", H5T_STD_I32LE, dataspace_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+         H5Dwrite(dataset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, irreps);
+    
+            //Attributes
+            hid_t attribute_space_id1  = H5Screate(H5S_SCALAR);
+            hid_t attribute_id1        = H5Acreate(dataset_id, "nGroup", H5T_STD_I32LE, attribute_space_id1, H5P_DEFAULT, H5P_DEFAULT);
+            int nGroup                 = Prob->gSy();
+            H5Awrite(attribute_id1, H5T_NATIVE_INT, &nGroup); 
+            
+            hid_t attribute_space_id2  = H5Screate(H5S_SCALAR);
+            hid_t attribute_id2        = H5Acreate(dataset_id, "theTotalSize", H5T_STD_I64LE, attribute_space_id2, H5P_DEFAULT, H5P_DEFAULT);
+            H5Awrite(attribute_id2, H5T_NATIVE_LLONG, &theTotalSize); 
+
+            H5Aclose(attribute_id1);
+            H5Aclose(attribute_id2);
+            H5Sclose(attribute_space_id1);
+            H5Sclose(attribute_space_id2);
+    
+         H5Dclose(dataset_id);
+         
+         //The orbital reordering
+         hid_t dataset_id2      = H5Dcreate(group_id, "HamToDMRG", H5T_STD_I32LE, dataspace_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+         H5Dwrite(dataset_id2, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, HamToDMRG);
+         H5Dclose(dataset_id2);
+         H5Sclose(dataspace_id);
+
+      H5Gclose(group_id);
+      
+      //The packed 2DMs: see TwoDM.h for the order
+      hid_t group_id3 = H5Gcreate(file_id, "/TwoDMObject", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+            
+         hsize_t dimarray3       = theTotalSize;
+         hid_t dataspace_id3     = H5Screate_simple(1, &dimarray3, NULL);
+         hid_t dataset_id3       = H5Dcreate(group_id3, "2DM-A", H5T_IEEE_F64LE, dataspace_id3, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+         H5Dwrite(dataset_id3, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, TwoDMA);
+         H5Dclose(dataset_id3);
+         hid_t dataset_id4       = H5Dcreate(group_id3, "2DM-B", H5T_IEEE_F64LE, dataspace_id3, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+         H5Dwrite(dataset_id4, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, TwoDMB);
+         H5Dclose(dataset_id4);
+         H5Sclose(dataspace_id3);
+
+      H5Gclose(group_id3);
+      
+   H5Fclose(file_id);
    
-   double prefactorSpin = 1.0/(Prob->gTwoS() + 1.0);
+   delete [] irreps;
+   delete [] HamToDMRG;
+
+}
+
+void CheMPS2::TwoDM::read(const std::string name){
+
+   //The hdf5 file
+   hid_t file_id = H5Fopen(name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+      
+      //The metadata
+      hid_t group_id = H5Gopen(file_id, "/MetaData", H5P_DEFAULT);
+       
+         //The orbital irreps
+         hid_t dataset_id = H5Dopen(group_id, "Irreps", H5P_DEFAULT);
+    
+            //Attributes
+            hid_t attribute_id1 = H5Aopen_name(dataset_id, "nGroup");
+            int nGroup;
+            H5Aread(attribute_id1, H5T_NATIVE_INT, &nGroup);
+            if (nGroup != Prob->gSy()){ cerr << "Error at TwoDM::read : nGroup doesn't match." << endl; }
+            
+            hid_t attribute_id2 = H5Aopen_name(dataset_id, "theTotalSize");
+            long long theTotalSize;
+            H5Aread(attribute_id2, H5T_NATIVE_LLONG, &theTotalSize);
+
+            H5Aclose(attribute_id1);
+            H5Aclose(attribute_id2);
+         
+         hid_t dataspace_id = H5Dget_space(dataset_id);
+         bool irrepsOK = (H5Sget_simple_extent_npoints(dataspace_id) == L);
+         H5Sclose(dataspace_id);
+         if (irrepsOK){
+            int * irreps = new int[L];
+            H5Dread(dataset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, irreps);
+            for (int orb=0; orb<L; orb++){ if (irreps[orb] != denBK->gIrrep(orb)){ irrepsOK = false; } }
+            delete [] irreps;
+         }
+         if (!irrepsOK){ cerr << "Error at TwoDM::read : The orbital irreps don't match." << endl; }
+         H5Dclose(dataset_id);
+
+      H5Gclose(group_id);
+      
+      if (theTotalSize != arraySize){ cerr << "Error at TwoDM::read : mismatch of theTotalSize and the size of the TwoDM object." << endl; }
+      
+      //The packed 2DMs: read directly into the storage
+      if ((irrepsOK) && (theTotalSize == arraySize)){
+         hid_t group_id3 = H5Gopen(file_id, "/TwoDMObject", H5P_DEFAULT);
+         
+         hid_t dataset_id3 = H5Dopen(group_id3, "2DM-A", H5P_DEFAULT);
+         H5Dread(dataset_id3, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, TwoDMA);
+         H5Dclose(dataset_id3);
+         
+         hid_t dataset_id4 = H5Dopen(group_id3, "2DM-B", H5P_DEFAULT);
+         H5Dread(dataset_id4, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, TwoDMB);
+         H5Dclose(dataset_id4);
+         
+         H5Gclose(group_id3);
+      }
+      
+   H5Fclose(file_id);
+
+}
+
+void CheMPS2::TwoDM::FillSite(TensorT * denT, TensorL *** Ltens, TensorF0 **** F0tens, TensorF1 **** F1tens, TensorS0 **** S0tens, TensorS1 **** S1tens){
+
+   const int theindex = denT->gIndex();
+   const int DIM = max(denBK->gMaxDimAtBound(theindex), denBK->gMaxDimAtBound(theindex+1));
+   const double prefactorSpin = 1.0/(Prob->gTwoS() + 1.0);
 
    //Diagram 1
-   double d1 = doD1(denT) * prefactorSpin;
+   const double d1 = doD1(denT) * prefactorSpin;
    setTwoDMA_DMRG(theindex,theindex,theindex,theindex, 2*d1);
    setTwoDMB_DMRG(theindex,theindex,theindex,theindex,-2*d1);
    
-   //Diagram 2
-   for (int j_index=theindex+1; j_index<L; j_index++){
-      if (denBK->gIrrep(j_index) == denBK->gIrrep(theindex)){
-         double d2 = doD2(denT, Ltens[theindex][j_index-theindex-1], workmem) * prefactorSpin;
-         setTwoDMA_DMRG(theindex,j_index,theindex,theindex, 2*d2);
-         setTwoDMB_DMRG(theindex,j_index,theindex,theindex,-2*d2);
-      }
-   }
+   //PARALLEL: every (g,j,k) combination sets its own 2DM elements, so the iterations of each loop can be distributed over the threads
+   const int numRight = L-1-theindex;
+   #pragma omp parallel
+   {
    
-   for (int j_index=theindex+1; j_index<L; j_index++){
-      for (int k_index=j_index; k_index<L; k_index++){
-         if (denBK->gIrrep(j_index) == denBK->gIrrep(k_index)){
-         
-            //Diagram 3
-            double d3 = doD3(denT, S0tens[theindex][k_index-j_index][j_index-theindex-1], workmem) * prefactorSpin;
-            setTwoDMA_DMRG(theindex,theindex,j_index,k_index, 2*d3);
-            setTwoDMB_DMRG(theindex,theindex,j_index,k_index,-2*d3);
-            
-            //Diagrams 4,5 and 6
-            double d4 = doD4(denT, F0tens[theindex][k_index-j_index][j_index-theindex-1], workmem) * prefactorSpin;
-            double d5 = doD5(denT, F0tens[theindex][k_index-j_index][j_index-theindex-1], workmem) * prefactorSpin;
-            double d6 = doD6(denT, F1tens[theindex][k_index-j_index][j_index-theindex-1], workmem) * prefactorSpin;
-            setTwoDMA_DMRG(theindex,j_index,k_index,theindex, -2*d4 - 2*d5 - 3*d6);
-            setTwoDMB_DMRG(theindex,j_index,k_index,theindex, -2*d4 - 2*d5 +   d6);
-            setTwoDMA_DMRG(theindex,j_index,theindex,k_index,  4*d4 + 4*d5);
-            setTwoDMB_DMRG(theindex,j_index,theindex,k_index,  2*d6);
+      double * workmem = ScratchArena::get(0, DIM*DIM);
+      double * workmem2 = ScratchArena::get(1, DIM*DIM);
+      
+      //Diagram 2
+      #pragma omp for schedule(dynamic)
+      for (int j_index=theindex+1; j_index<L; j_index++){
+         if (denBK->gIrrep(j_index) == denBK->gIrrep(theindex)){
+            double d2 = doD2(denT, Ltens[theindex][j_index-theindex-1], workmem) * prefactorSpin;
+            setTwoDMA_DMRG(theindex,j_index,theindex,theindex, 2*d2);
+            setTwoDMB_DMRG(theindex,j_index,theindex,theindex,-2*d2);
+         }
+      }
+      
+      #pragma omp for schedule(dynamic)
+      for (int j_index=theindex+1; j_index<L; j_index++){
+         for (int k_index=j_index; k_index<L; k_index++){
+            if (denBK->gIrrep(j_index) == denBK->gIrrep(k_index)){
             
+               //Diagram 3
+               double d3 = doD3(denT, S0tens[theindex][k_index-j_index][j_index-theindex-1], workmem) * prefactorSpin;
+               setTwoDMA_DMRG(theindex,theindex,j_index,k_index, 2*d3);
+               setTwoDMB_DMRG(theindex,theindex,j_index,k_index,-2*d3);
+               
+               //Diagrams 4,5 and 6
+               double d4 = doD4(denT, F0tens[theindex][k_index-j_index][j_index-theindex-1], workmem) * prefactorSpin;
+               double d5 = doD5(denT, F0tens[theindex][k_index-j_index][j_index-theindex-1], workmem) * prefactorSpin;
+               double d6 = doD6(denT, F1tens[theindex][k_index-j_index][j_index-theindex-1], workmem) * prefactorSpin;
+               setTwoDMA_DMRG(theindex,j_index,k_index,theindex, -2*d4 - 2*d5 - 3*d6);
+               setTwoDMB_DMRG(theindex,j_index,k_index,theindex, -2*d4 - 2*d5 +   d6);
+               setTwoDMA_DMRG(theindex,j_index,theindex,k_index,  4*d4 + 4*d5);
+               setTwoDMB_DMRG(theindex,j_index,theindex,k_index,  2*d6);
+               
+            }
          }
       }
-   }
-   
-   //Diagram 7
-   for (int g_index=0; g_index<theindex; g_index++){
-      if (denBK->gIrrep(g_index) == denBK->gIrrep(theindex)){
-         double d7 = doD7(denT, Ltens[theindex-1][theindex-g_index-1], workmem) * prefactorSpin;
-         setTwoDMA_DMRG(g_index,theindex,theindex,theindex, 2*d7);
-         setTwoDMB_DMRG(g_index,theindex,theindex,theindex,-2*d7);
+      
+      //Diagram 7
+      #pragma omp for schedule(dynamic)
+      for (int g_index=0; g_index<theindex; g_index++){
+         if (denBK->gIrrep(g_index) == denBK->gIrrep(theindex)){
+            double d7 = doD7(denT, Ltens[theindex-1][theindex-g_index-1], workmem) * prefactorSpin;
+            setTwoDMA_DMRG(g_index,theindex,theindex,theindex, 2*d7);
+            setTwoDMB_DMRG(g_index,theindex,theindex,theindex,-2*d7);
+         }
       }
-   }
-   
-   for (int g_index=0; g_index<theindex; g_index++){
-      const int I_g = denBK->gIrrep(g_index);
-      for (int j_index=theindex+1; j_index<L; j_index++){
-         if (denBK->gIrrep(g_index) == denBK->gIrrep(j_index)){
+      
+      //The (g,j) pairs are combined into one loop index, so that there is enough work for all threads at the edges of the chain
+      #pragma omp for schedule(dynamic)
+      for (int glob=0; glob<theindex*numRight; glob++){
+         const int g_index = glob % theindex;
+         const int j_index = theindex + 1 + glob / theindex;
+         const int I_g = denBK->gIrrep(g_index);
+         if (I_g == denBK->gIrrep(j_index)){
             //Diagrams 8,9,10 and 11
             double d8 = doD8(denT, Ltens[theindex-1][theindex-g_index-1], Ltens[theindex][j_index-theindex-1], workmem, workmem2, I_g) * prefactorSpin;
             double d9, d10, d11;
@@ -262,11 +474,12 @@ void CheMPS2::TwoDM::FillSite(TensorT * denT, TensorL *** Ltens, TensorF0 **** F
             setTwoDMB_DMRG(g_index,j_index,theindex,theindex,-2*d12);
          }
       }
-   }
-   
-   for (int g_index=0; g_index<theindex; g_index++){
-      const int I_g = denBK->gIrrep(g_index);
-      for (int j_index=theindex+1; j_index<L; j_index++){
+      
+      #pragma omp for schedule(dynamic)
+      for (int glob=0; glob<theindex*numRight; glob++){
+         const int g_index = glob % theindex;
+         const int j_index = theindex + 1 + glob / theindex;
+         const int I_g = denBK->gIrrep(g_index);
          for (int k_index=j_index; k_index<L; k_index++){
             if (denBK->directProd(I_g, denBK->gIrrep(theindex)) == denBK->directProd(denBK->gIrrep(j_index), denBK->gIrrep(k_index))){
                //Diagrams 13,14,15 and 16
@@ -305,11 +518,8 @@ void CheMPS2::TwoDM::FillSite(TensorT * denT, TensorL *** Ltens, TensorF0 **** F
             }
          }
       }
-   }
    
-   delete [] workmem;
-   delete [] workmem2;
-
+   }
 
 }
 
@@ -535,7 +745,7 @@ double CheMPS2::TwoDM::doD6(TensorT * denT, TensorF1 * F1right, double * workmem
                      dgemm_(&notrans,&notrans,&dimL,&dimRup,&dimRdown,&alpha,Tdown,&dimL,F1block,&dimRdown,&beta,workmem,&dimL);
                
                      int fase = ((((TwoSL + TwoSRdown - 1)/2)%2)!=0)?-1:1;
-                     double factor = sqrt((TwoSRup+1)/3.0) * (TwoSRdown+1) * fase * gsl_sf_coupling_6j(1,1,2,TwoSRup,TwoSRdown,TwoSL);
+                     double factor = sqrt((TwoSRup+1)/3.0) * (TwoSRdown+1) * fase * Wigner::wigner6j(1,1,2,TwoSRup,TwoSRdown,TwoSL);
                      
                      int length = dimL * dimRup;
                      int inc = 1;
@@ -702,8 +912,8 @@ void CheMPS2::TwoDM::doD9andD10andD11(TensorT * denT, TensorL * Lleft, TensorL *
                               double value = ddot_(&length, workmem2, &inc, T_up, &inc);
                               
                               int fase = ((((TwoSLup + TwoSRdown + 2)/2)%2)!=0) ? -1 : 1;
-                              double fact1 = fase * (TwoSRup+1) * sqrt((TwoSRdown+1)*(TwoSLup+1.0)) * gsl_sf_coupling_6j(TwoSRup,1,TwoSLup,TwoSLdown,1,TwoSRdown);
-                              double fact2 = 2 * (TwoSRup+1) * sqrt((TwoSRdown+1)*(TwoSLup+1.0)) * gsl_sf_coupling_6j(TwoSRup, TwoSLdown, 2, 1, 1, TwoSLup) * gsl_sf_coupling_6j(TwoSRup, TwoSLdown, 2, 1, 1, TwoSRdown);
+                              double fact1 = fase * (TwoSRup+1) * sqrt((TwoSRdown+1)*(TwoSLup+1.0)) * Wigner::wigner6j(TwoSRup,1,TwoSLup,TwoSLdown,1,TwoSRdown);
+                              double fact2 = 2 * (TwoSRup+1) * sqrt((TwoSRdown+1)*(TwoSLup+1.0)) * Wigner::wigner6j(TwoSRup, TwoSLdown, 2, 1, 1, TwoSLup) * Wigner::wigner6j(TwoSRup, TwoSLdown, 2, 1, 1, TwoSRdown);
                               double fact3 = (TwoSRdown == TwoSLup) ? TwoSRup+1.0 : 0.0 ;
                               
                               d9[0] += fact1  * value;
@@ -931,7 +1141,7 @@ double CheMPS2::TwoDM::doD15(TensorT * denT, TensorL * Lleft, TensorS1 * S1right
                         dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimRdown,&alpha,workmem,&dimLup,S1block,&dimRdown,&beta,workmem2,&dimLup);
                
                         int fase = ((((TwoSLdown + TwoSLup + 1)/2)%2)!=0) ? -1 : 1;
-                        double factor = fase * (TwoSLup+1) * sqrt((TwoSRdown+1)/3.0) * gsl_sf_coupling_6j(1,1,2,TwoSLup,TwoSRdown,TwoSLdown);
+                        double factor = fase * (TwoSLup+1) * sqrt((TwoSRdown+1)/3.0) * Wigner::wigner6j(1,1,2,TwoSLup,TwoSRdown,TwoSLdown);
                         
                         int length = dimLup * dimRup;
                         int inc = 1;
@@ -990,7 +1200,7 @@ double CheMPS2::TwoDM::doD16(TensorT * denT, TensorL * Lleft, TensorS1 * S1right
                         dgemm_(&notrans,&notrans,&dimLup,&dimRup,&dimRdown,&alpha,workmem,&dimLup,S1block,&dimRdown,&beta,workmem2,&dimLup);
                   
                         int fase = ((((TwoSRup+TwoSLdown+2)/2)%2)!=0) ? -1 : 1;
-                        double factor = fase * (TwoSRup+1) * sqrt((TwoSLup+1)/3.0) * gsl_sf_coupling_6j(1,1,2,TwoSRup,TwoSLdown,TwoSLup);
+                        double factor = fase * (TwoSRup+1) * sqrt((TwoSLup+1)/3.0) * Wigner::wigner6j(1,1,2,TwoSRup,TwoSLdown,TwoSLup);
                         
                         int length = dimLup * dimRup;
                         int inc = 1;
@@ -1171,10 +1381,10 @@ double CheMPS2::TwoDM::doD19orD23(TensorT * denT, TensorL * Lleft, TensorF1 * F1
                         double factor = 0.0;
                         if (shouldIdoD19){
                            int fase = ((((TwoSLdown + TwoSRdown - 1)/2)%2)!=0) ? -1 : 1;
-                           factor = fase * (TwoSRdown+1) * sqrt((TwoSLup+1)/3.0) * gsl_sf_coupling_6j(1,1,2,TwoSLup,TwoSRdown,TwoSLdown);
+                           factor = fase * (TwoSRdown+1) * sqrt((TwoSLup+1)/3.0) * Wigner::wigner6j(1,1,2,TwoSLup,TwoSRdown,TwoSLdown);
                         } else {
                            int fase = ((((TwoSLdown + TwoSLup - 1)/2)%2)!=0) ? -1 : 1;
-                           factor = fase * (TwoSLup+1) * sqrt((TwoSRdown+1)/3.0) * gsl_sf_coupling_6j(1,1,2,TwoSLup,TwoSRdown,TwoSLdown);
+                           factor = fase * (TwoSLup+1) * sqrt((TwoSRdown+1)/3.0) * Wigner::wigner6j(1,1,2,TwoSLup,TwoSRdown,TwoSLdown);
                         }
                         
                         int length = dimLup * dimRup;
@@ -1239,10 +1449,10 @@ double CheMPS2::TwoDM::doD20orD24(TensorT * denT, TensorL * Lleft, TensorF1 * F1
                         double factor = 0.0;
                         if (shouldIdoD20){
                            int fase = (((TwoSLup)%2)!=0) ? -1 : 1;
-                           factor = fase * sqrt((TwoSLup+1)*(TwoSRup+1)*(TwoSLdown+1)/3.0) * gsl_sf_coupling_6j(1,1,2,TwoSRup,TwoSLdown,TwoSLup);
+                           factor = fase * sqrt((TwoSLup+1)*(TwoSRup+1)*(TwoSLdown+1)/3.0) * Wigner::wigner6j(1,1,2,TwoSRup,TwoSLdown,TwoSLup);
                         } else {
                            int fase = ((((2*TwoSLup + TwoSRup - TwoSLdown)/2)%2)!=0) ? -1 : 1;
-                           factor = fase * (TwoSRup+1) * sqrt((TwoSLup+1)/3.0) * gsl_sf_coupling_6j(1,1,2,TwoSRup,TwoSLdown,TwoSLup);
+                           factor = fase * (TwoSRup+1) * sqrt((TwoSLup+1)/3.0) * Wigner::wigner6j(1,1,2,TwoSRup,TwoSLdown,TwoSLup);
                         }
                         
                         int length = dimLup * dimRup;
@@ -0,0 +1,136 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <stdlib.h>
+
+#include "Wigner.h"
+#include "Gsl.h"
+
+//The keys are packed with 7 bits per argument. 6j keys have bit 63 set, 9j keys not. An empty slot has a key with all bits set, which no symbol can have.
+static const unsigned long long Wigner_empty = ~(0ULL);
+static const unsigned long long Wigner_flag6j = (1ULL << 63);
+
+//The table of the calling thread: 2^Wigner_logCapacity keys and values, of which Wigner_numUsed are filled
+static unsigned long long * Wigner_keys = NULL;
+static double * Wigner_values = NULL;
+static int Wigner_logCapacity = 0;
+static int Wigner_numUsed = 0;
+#pragma omp threadprivate(Wigner_keys, Wigner_values, Wigner_logCapacity, Wigner_numUsed)
+
+//Shared by all threads: the initial size of the tables, and whether the memo is used
+static int Wigner_initialLogCapacity = 12;
+static bool Wigner_memo = true;
+
+double CheMPS2::Wigner::wigner6j(const int two_ja, const int two_jb, const int two_jc, const int two_jd, const int two_je, const int two_jf){
+
+   if (!Wigner_memo){ return gsl_sf_coupling_6j(two_ja, two_jb, two_jc, two_jd, two_je, two_jf); }
+   const int two_j[] = { two_ja, two_jb, two_jc, two_jd, two_je, two_jf };
+   unsigned long long key = Wigner_flag6j;
+   for (int cnt=0; cnt<6; cnt++){
+      if ((two_j[cnt] < 0) || (two_j[cnt] > WIGNER_MAXARG)){ return gsl_sf_coupling_6j(two_ja, two_jb, two_jc, two_jd, two_je, two_jf); }
+      key |= ((unsigned long long) two_j[cnt]) << (7*cnt);
+   }
+   return lookup(key, two_j, false);
+
+}
+
+double CheMPS2::Wigner::wigner9j(const int two_ja, const int two_jb, const int two_jc, const int two_jd, const int two_je, const int two_jf, const int two_jg, const int two_jh, const int two_ji){
+
+   if (!Wigner_memo){ return gsl_sf_coupling_9j(two_ja, two_jb, two_jc, two_jd, two_je, two_jf, two_jg, two_jh, two_ji); }
+   const int two_j[] = { two_ja, two_jb, two_jc, two_jd, two_je, two_jf, two_jg, two_jh, two_ji };
+   unsigned long long key = 0;
+   for (int cnt=0; cnt<9; cnt++){
+      if ((two_j[cnt] < 0) || (two_j[cnt] > WIGNER_MAXARG)){ return gsl_sf_coupling_9j(two_ja, two_jb, two_jc, two_jd, two_je, two_jf, two_jg, two_jh, two_ji); }
+      key |= ((unsigned long long) two_j[cnt]) << (7*cnt);
+   }
+   return lookup(key, two_j, true);
+
+}
+
+double CheMPS2::Wigner::lookup(const unsigned long long key, const int * two_j, const bool is9j){
+
+   if (Wigner_keys == NULL){ resize(Wigner_initialLogCapacity); }
+
+   //Fibonacci hashing with linear probing
+   const unsigned long long mask = (1ULL << Wigner_logCapacity) - 1;
+   unsigned long long slot = (key * 11400714819323198485ULL) >> (64 - Wigner_logCapacity);
+   while (Wigner_keys[slot] != Wigner_empty){
+      if (Wigner_keys[slot] == key){ return Wigner_values[slot]; }
+      slot = (slot + 1) & mask;
+   }
+
+   const double value = (is9j) ? gsl_sf_coupling_9j(two_j[0], two_j[1], two_j[2], two_j[3], two_j[4], two_j[5], two_j[6], two_j[7], two_j[8])
+                               : gsl_sf_coupling_6j(two_j[0], two_j[1], two_j[2], two_j[3], two_j[4], two_j[5]);
+   Wigner_keys[slot] = key;
+   Wigner_values[slot] = value;
+   Wigner_numUsed++;
+   if (2 * Wigner_numUsed > (1 << Wigner_logCapacity)){ resize(Wigner_logCapacity + 1); }
+   return value;
+
+}
+
+void CheMPS2::Wigner::resize(const int logCapacity){
+
+   unsigned long long * oldKeys = Wigner_keys;
+   double * oldValues = Wigner_values;
+   const int oldCapacity = (oldKeys == NULL) ? 0 : (1 << Wigner_logCapacity);
+
+   const int capacity = (1 << logCapacity);
+   Wigner_keys = new unsigned long long[capacity];
+   Wigner_values = new double[capacity];
+   Wigner_logCapacity = logCapacity;
+   for (int cnt=0; cnt<capacity; cnt++){ Wigner_keys[cnt] = Wigner_empty; }
+
+   const unsigned long long mask = capacity - 1;
+   for (int cnt=0; cnt<oldCapacity; cnt++){
+      if (oldKeys[cnt] != Wigner_empty){
+         unsigned long long slot = (oldKeys[cnt] * 11400714819323198485ULL) >> (64 - Wigner_logCapacity);
+         while (Wigner_keys[slot] != Wigner_empty){ slot = (slot + 1) & mask; }
+         Wigner_keys[slot] = oldKeys[cnt];
+         Wigner_values[slot] = oldValues[cnt];
+      }
+   }
+
+   delete [] oldKeys;
+   delete [] oldValues;
+
+}
+
+void CheMPS2::Wigner::setMaxTwoS(const int maxTwoS){
+
+   //About 256 different symbols per virtual spin value, at a load of at most one half
+   int logCapacity = 10;
+   while ((logCapacity < 24) && ((1 << logCapacity) < 512 * (maxTwoS + 1))){ logCapacity++; }
+   Wigner_initialLogCapacity = logCapacity;
+
+}
+
+void CheMPS2::Wigner::setMemo(const bool active){ Wigner_memo = active; }
+
+void CheMPS2::Wigner::release(){
+
+   delete [] Wigner_keys;
+   delete [] Wigner_values;
+   Wigner_keys = NULL;
+   Wigner_values = NULL;
+   Wigner_logCapacity = 0;
+   Wigner_numUsed = 0;
+
+}
+
@@ -77,6 +77,19 @@ namespace CheMPS2{
          //! CASSCF unitary rotation remove call
          void deleteStoredUnitary();
          
+         //! Start the DMRG calculation of each macro-iteration of doCASSCFnewtonraphson from the MPS of the previous macro-iteration, instead of from a random MPS
+         /** \param warmStartDimsIn Whether the virtual dimensions of the previous MPS are reused as well; otherwise the previous MPS is projected onto the virtual dimensions of the first instruction
+             \param WarmOptSchemeIn The optimization scheme for the macro-iterations which start from the previous MPS, typically a shortened version of the one passed to doCASSCFnewtonraphson; NULL means that the same scheme is used (externally allocated and deleted) */
+         void activateWarmStart(const bool warmStartDimsIn, ConvergenceScheme * WarmOptSchemeIn);
+         
+         //! Set the memory above which the augmented Hessian is solved iteratively with Hessian-vector products instead of being stored and diagonalized; the default is CheMPS2::CASSCF_augHessDenseMaxMB
+         /** \param megabytes The max. size in MB of the dense augmented Hessian and its LAPACK workspace; 0.0 means that the augmented Hessian is always solved iteratively */
+         void setAugmentedHessianMaxMB(const double megabytes);
+         
+         //! Allow doCASSCFnewtonraphson to rotate only the two-body matrix elements with at most two virtual indices, when that requires fewer flops than the rotation of all of them; the default is CheMPS2::CASSCF_restrictedRotation
+         /** \param allowed Whether the restricted rotation is allowed */
+         void setRestrictedRotation(const bool allowed);
+         
       private:
          
          /* The x-matrix (anti-symmetric) from the paper:
@@ -132,6 +145,17 @@ namespace CheMPS2{
          //Boolean whether or not setupStart has been called
          bool setupStartCalled;
          
+         //Whether the DMRG calculations start from the MPS of the previous macro-iteration, whether its virtual dimensions are reused, and the optimization scheme for those calculations (NULL: the one of doCASSCFnewtonraphson)
+         bool warmStart;
+         bool warmStartDims;
+         ConvergenceScheme * WarmOptScheme;
+         
+         //The max. size in MB of the stored augmented Hessian and its workspace
+         double augHessDenseMaxMB;
+         
+         //Whether the rotation of only the two-body matrix elements with at most two virtual indices is allowed
+         bool allowRestrictedRotation;
+         
          //Number of DMRG orbitals
          int nOrbDMRG;
          
@@ -144,6 +168,9 @@ namespace CheMPS2{
          //List of DMRG orbitals in terms of the original Ham orbitals
          int * listDMRG;
          
+         //Inverse of listDMRG: the DMRG orbital index of each original Ham orbital (-1 if it is occupied or virtual)
+         int * DMRGindexOfOrbital;
+         
          //Number of condensed orbitals
          int nCondensed;
          
@@ -159,6 +186,12 @@ namespace CheMPS2{
          //Set the DMRG 1DM
          void setDMRG1DM(const int N);
          
+         //Dense copy of the DMRG 2DM-A in the orbital ordering of HamDMRG: DMRG2DM[i + n * ( j + n * ( k + n * l ) )] with n = nOrbDMRG
+         double * DMRG2DM;
+         
+         //Copy theDMRG2DM into DMRG2DM
+         void setDMRG2DM();
+         
          //Once the DMRG1DM is set, the NOON can be calculated
          void calcNOON();
          
@@ -183,6 +216,15 @@ namespace CheMPS2{
          //With the updated unitary, the rotated matrix elements can be determined --> do everything in memory, but blockwise
          void fillRotatedHamInMemoryBlockWise(double * mem1, double * mem2, double * mem3, const int maxBlockSize);
          
+         //With the updated unitary, only the rotated matrix elements with at most two virtual indices are determined --> temp1 of size 3 * M * maxlinsize^3 and temp2 of size M * maxlinsize^3, with M = max(1, max. # occ + act orb per irrep)
+         void fillRotatedHamRestricted(double * temp1, double * temp2);
+         
+         //Last three quarter transformations of one part of fillRotatedHamRestricted: tensor index n has irrep irreps[n], is argument pos[n] of setVmat, and only rows start[n] to start[n]+size[n]-1 of its unitary are kept; work contains the first quarter transformation and is overwritten; returns the flop count
+         double rotateTwoBodyPart(const int * irreps, const int * pos, const int * start, const int * size, double * work, double * temp);
+         
+         //Estimated flop count of the two-body rotation, either restricted to the matrix elements with at most two virtual indices or not
+         double rotationFlops(const bool restricted) const;
+         
          //Get the 1DM in the rotated basis
          double get1DMrotated(const int index1, const int index2) const;
          
@@ -195,6 +237,15 @@ namespace CheMPS2{
          //Calculate the hessian
          void calcHessian(double * hessian, const int rowjump);
          
+         //Hessian element for the linear x-matrix indices row and col
+         double Hmat(const int row, const int col) const;
+         
+         //Hessian-vector product result = Hessian * vector, with the Hessian elements calculated on the fly
+         void calcHessianVectorProduct(double * vector, double * result);
+         
+         //Davidson solution for the lowest eigenvector of the augmented Hessian [[ Hessian , gradient ],[ gradient^T , 0 ]], which is never stored; augVector has length x_linearlength+1
+         void solveAugmentedHessianDavidson(double * gradient, double * augVector);
+         
          //Based on the new 2DM and 1DM from the DMRG calculation, calculate the gradient, Hessian, and new x
          double updateXmatrixNewtonRaphson();
          
@@ -216,6 +267,13 @@ namespace CheMPS2{
          //Wmat function as defined by Eq.(21b) in the Siegbahn paper.
          double Wmat(const int index1, const int index2, const int index3, const int index4) const;
          
+         //Two-body parts of the inactive and active Fock matrices, which are the (index2,index4) sums over occupied and active orbitals in Wmat:
+         //   QmatOcc[irrep][p + n_irrep * q] = sum_{a occ} ( 2 V(p,a,q,a) - V(p,q,a,a) )
+         //   QmatAct[irrep][p + n_irrep * q] = sum_{a,b act} 1DM(a,b) ( 2 V(p,a,q,b) - V(p,q,a,b) )
+         double ** QmatOcc;
+         double ** QmatAct;
+         void buildQmat();
+         
          //Check the 1DM and 2DM rotated
          void check1DMand2DMrotated(const int N);
          
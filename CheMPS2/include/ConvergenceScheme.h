@@ -20,6 +20,8 @@
 #ifndef CONVERGENCESCHEME_H
 #define CONVERGENCESCHEME_H
 
+#include "DavidsonOptions.h"
+
 namespace CheMPS2{
 /** ConvergenceScheme class.
     \author Sebastian Wouters <sebastianwouters@gmail.com>
@@ -34,7 +36,9 @@ namespace CheMPS2{
     The noise level which is added to the Sobject is the product of\n
     (1) f\n
     (2) the maximum discarded weight during the last sweep\n
-    (3) a random number in the interval [-0.5,0.5]*/
+    (3) a random number in the interval [-0.5,0.5]\n
+    \n
+    Optionally, DavidsonOptions can be attached to an instruction, to set the Davidson solver parameters during its sweeps.*/
    class ConvergenceScheme{
 
       public:
@@ -78,6 +82,16 @@ namespace CheMPS2{
              \return the noise prefactor for this instruction */
          double getNoisePrefactor(const int instruction);
          
+         //! Attach Davidson solver options to an instruction. The ConvergenceScheme does not take ownership; the DavidsonOptions should exist as long as the ConvergenceScheme is used.
+         /** \param instruction the number of the instruction
+             \param options the Davidson solver options for that instruction; NULL means the defaults of Options.h */
+         void setDavidsonOptions(const int instruction, DavidsonOptions * options);
+         
+         //! Get the Davidson solver options for a particular instruction
+         /** \param instruction the number of the instruction
+             \return the Davidson solver options for this instruction; NULL means the defaults of Options.h */
+         DavidsonOptions * getDavidsonOptions(const int instruction);
+         
       private:
       
          //The number of instructions
@@ -95,6 +109,9 @@ namespace CheMPS2{
          //The noise prefactor for each instruction
          double * fNoisePrefactor;
          
+         //The Davidson solver options for each instruction (not owned)
+         DavidsonOptions ** davidsonOptions;
+         
    };
 }
 
@@ -22,6 +22,7 @@
 
 #include <string>
 #include <hdf5.h>
+#include <pthread.h>
 
 #include "Options.h"
 #include "Problem.h"
@@ -59,6 +60,13 @@ namespace CheMPS2{
              \param OptSchemeIn The optimization scheme for the DMRG sweeps */
          DMRG(Problem * Probin, ConvergenceScheme * OptSchemeIn);
          
+         //! Constructor, which starts from the MPS of a previous calculation instead of a random MPS. The guess should have the same number of orbitals, orbital irreps, particle number, spin and irrep; otherwise a random MPS is used. Its current MPS (or its ground state, when it has calculated excitations) is copied and left-normalized, so that the guess can be deleted once the constructor has returned. This is useful when the Hamiltonian changes only slightly, as in the macro-iterations of CASSCF.
+         /** \param Probin The problem to be solved
+             \param OptSchemeIn The optimization scheme for the DMRG sweeps
+             \param guess The DMRG object of which the MPS is used as initial guess
+             \param guessDims Whether the virtual dimensions of the guess are copied as well; otherwise the guess is projected onto the virtual dimensions of the first instruction of OptSchemeIn */
+         DMRG(Problem * Probin, ConvergenceScheme * OptSchemeIn, DMRG * guess, const bool guessDims);
+         
          //! Destructor
          ~DMRG();
          
@@ -83,6 +91,9 @@ namespace CheMPS2{
          //! Call "rm + localTmpPath + CheMPS2_ + RNstorage + *.h5"
          void deleteStoredOperators();
          
+         //! Delete the renormalized operators, their idle pooled storage and the background I/O thread, so that only the MPS is kept, e.g. while the object waits to serve as guess for a later DMRG calculation. Note that the DMRG class cannot be used for further updates anymore !!!
+         void deleteOperators();
+         
          //! Activate the necessary storage and machinery to handle excitations
          /** \param maxExcIn The max. number of excitations desired */
          void activateExcitations(const int maxExcIn);
@@ -91,13 +102,56 @@ namespace CheMPS2{
          /** \param EshiftIn To the Hamiltonian, a level shift is introduced to exclude the previously calculated MPS: Hnew = Hold + EshiftIn * | prev> <prev| */
          void newExcitation(const double EshiftIn);
          
+         //! Optimize the lowest nRootsIn states of the Problem together in the following calls to Solve(). The roots share all MPS tensors except the one of the active site, and their reduced density matrices are averaged with equal weights. Solve() then returns the min. state-averaged energy encountered during the sweeps. The 2DM and the stored MPS refer to root 0. Cannot be combined with excitations.
+         /** \param nRootsIn The number of roots */
+         void activateStateAveraging(const int nRootsIn);
+         
+         //! Get the energy of a root at the last step of the last state-averaged sweep
+         /** \param root The root
+             \return The energy of root */
+         double getStateAveragedEnergy(const int root) const;
+         
+         //! Get the number of Davidson matrix-vector products at a site during the last left-right sweep iteration of Solve()
+         /** \param index The first site of the two-site object (sites index and index+1)
+             \return The number of matrix-vector products */
+         int getDavidsonMatvecs(const int index) const;
+         
+         //! Get the wall time spent in the Davidson solver at a site during the last left-right sweep iteration of Solve()
+         /** \param index The first site of the two-site object (sites index and index+1)
+             \return The wall time in seconds */
+         double getDavidsonTime(const int index) const;
+         
+         //! Get the number of left-right sweep iterations of the last call to Solve(), summed over the instructions
+         /** \return The number of left-right sweep iterations */
+         int getNumSweeps() const;
+         
+         //! Set the memory budget for the renormalized operators, when they are stored on disk (CheMPS2::DMRG_storeRenormOptrOnDisk). Boundaries which would be written to disk behind the sweep stay in memory as long as the estimated operator memory of all allocated boundaries fits in the budget; otherwise the least recently needed boundaries are spilled to disk. A budget of 0 keeps only the boundaries in the neighbourhood of the sweep in memory. The default is CheMPS2::DMRG_operatorMemoryBudgetMB.
+         /** \param megabytes The memory budget in MB */
+         void setOperatorMemoryBudget(const double megabytes);
+         
+         //! Choose how the renormalized operators are kept, instead of CheMPS2::DMRG_storeRenormOptrOnDisk, CheMPS2::DMRG_mapRenormOptrOnDisk and CheMPS2::DMRG_asyncOperatorIO. All boundary operators are rebuilt from the current MPS, so call it before Solve().
+         /** \param storeOnDisk Whether the operators of the boundaries away from the sweep are stored on disk
+             \param mapOnDisk Whether the operators of all boundaries are kept in memory-mapped files instead (takes precedence over storeOnDisk)
+             \param asyncIO Whether the stores and loads of storeOnDisk are done by a background thread */
+         void setOperatorStorage(const bool storeOnDisk, const bool mapOnDisk, const bool asyncIO);
+         
+         //! Set the deflate level (0 = off, 1-9) of the renormalized operators which are stored on disk, instead of CheMPS2::DMRG_operatorCompression. All boundary operators are rebuilt from the current MPS, so call it before Solve().
+         /** \param level The deflate level */
+         void setOperatorCompression(const int level);
+         
          //! Print the license
          void PrintLicense();
          
       private:
       
+         //The part of the constructors which they have in common; guess can be NULL
+         void initialize(Problem * Probin, ConvergenceScheme * OptSchemeIn, DMRG * guess, const bool guessDims);
+      
          //Setup the DMRG SyBK and MPS (in separate function to allow pushbacks and recreations for excited states)
          void setupBookkeeperAndMPS();
+         
+         //Replace the MPS by the left-normalized current MPS of guess (and if guessDims also take over its virtual dimensions)
+         void copyMPS(DMRG * guess, const bool guessDims);
       
          //! DMRG MPS + virt. dim. storage filename
          string MPSstoragename;
@@ -120,6 +174,23 @@ namespace CheMPS2{
          //Max. discarded weight of last sweep
          double MaxDiscWeightLastSweep;
          
+         //The energy difference between the last two sweeps, which sets the Davidson residual tolerance
+         double DavidsonEnergyChange;
+         
+         //The Davidson telemetry of the last left-right sweep iteration: the number of matrix-vector products and the wall time per site index
+         int * DavidsonMatvecs;
+         double * DavidsonTime;
+         
+         //The number of left-right sweep iterations of the last call to Solve()
+         int SweepsLastSolve;
+         
+         //The scratch arena statistics at construction, so that the printed statistics only count the requests and allocations since then
+         long long ScratchRequestsStart;
+         long long ScratchAllocationsStart;
+         
+         //Solve the two-site problem at sites index and index+1 with SolveDAVIDSON, and add the number of matrix-vector products and the wall time to the telemetry
+         double solveSite(Sobject * denS, const int instruction, double ** VeffTilde);
+         
          //Symmetry information object
          SyBookkeeper * denBK;
          
@@ -177,9 +248,13 @@ namespace CheMPS2{
          //sweepright
          double sweepright(const bool change, const int instruction);
          
-         //Load and save functions
-         void MY_HDF5_WRITE(const hid_t file_id, const std::string sPath, Tensor * theTensor);
-         void MY_HDF5_READ( const hid_t file_id, const std::string sPath, Tensor * theTensor);
+         //Load and save functions. The renormalized operators of all boundaries are stored in the single file CheMPS2_Operators_<RNstorage>.h5: per boundary one chunked (and with a compression level > 0 deflated) dataset with all tensor blocks, and an offset table.
+         int listOperators(const int index, const bool movingRight, Tensor ** list); //The operators of boundary index in storage order (only counted if list==NULL)
+         hid_t openOperatorDataset(const std::string name, const hid_t type, const hsize_t size, const bool compress);
+         void transferOperatorData(const hid_t dataset_id, const hsize_t start, const hsize_t size, double * buffer, const bool write);
+         void closeOperatorFile();
+         hid_t operatorFile; //The file with the renormalized operators of all boundaries; negative when not open
+         int IOcompression; //The deflate level of the operator blobs; initialized from CheMPS2::DMRG_operatorCompression
          void storeOperators(const int index, const bool movingRight);
          void loadOperators(const int index, const bool movingRight);
          
@@ -190,6 +265,10 @@ namespace CheMPS2{
          //Helper functions for making the boundary operators
          void updateMovingRight(const int index);
          void updateMovingLeft(const int index);
+         enum { OPERATORITEM_L=0, OPERATORITEM_FS=1, OPERATORITEM_ABCD=2, OPERATORITEM_Q=3, OPERATORITEM_X=4 }; //The work items of updateOperators: a TensorL, the two-operator tensors F0/F1/S0/S1 or the complementary tensors A/B/C/D with indices (cnt2, cnt3), a TensorQ, or a symmetry block cnt2 of the TensorX
+         void updateOperators(const int index, const bool movingRight); //All renormalized operators except the Otensors, as one graph of work items without barriers between the operator families
+         void updateItemMovingRight(const int index, const int family, const int cnt2, const int cnt3);
+         void updateItemMovingLeft(const int index, const int family, const int cnt2, const int cnt3);
          void deleteTensors(const int index, const bool movingRightOfTensors);
          void allocateTensors(const int index, const bool movingRight);
          void updateMovingRightSafe(const int cnt);
@@ -197,7 +276,80 @@ namespace CheMPS2{
          void updateMovingLeftSafe(const int cnt);
          void updateMovingLeftSafe2DM(const int cnt);
          void deleteAllBoundaryOperators();
-         static int trianglefunction(const int k, const int glob);
+         
+         //Background I/O of the renormalized operators (DMRGoperatorsio.cpp). With CheMPS2::DMRG_storeRenormOptrOnDisk, the operators of the boundary which was just left are written out behind the sweep (write-behind), and the operators of boundary cnt+-3 are read in while the Davidson solve at the next site runs (prefetch). All operator HDF5 calls are done by the I/O thread, in the order in which they are queued. The main thread calls waitOperatorIO(index) before it touches the tensors or isAllocated[index] of a boundary with pending jobs, and every public function returns with an empty queue.
+         enum { OPERATORIO_STORE=0, OPERATORIO_LOAD=1 };
+         void startOperatorIO();
+         void stopOperatorIO();
+         void stopOperatorIOthread(); //Afterwards the operators are stored synchronously
+         void enqueueOperatorIO(const int type, const int index, const bool movingRight);
+         void waitOperatorIO(const int index);
+         void flushOperatorIO();
+         void runOperatorIO(const int type, const int index, const bool movingRight);
+         static void * operatorIOthread(void * dmrg);
+         void storeOperatorsBehind(const int index);
+         void loadOperatorsNow(const int index, const bool movingRight);
+         void prefetchOperators(const int index, const bool movingRight);
+         bool IOstoreOnDisk; //Whether the operators are stored on disk; initialized from CheMPS2::DMRG_storeRenormOptrOnDisk
+         bool IOasync; //Whether the I/O thread is used; initialized from CheMPS2::DMRG_asyncOperatorIO
+         bool IOactive;
+         bool IOstop;
+         pthread_t IOthread;
+         pthread_mutex_t IOmutex;
+         pthread_cond_t IOworkCond;
+         pthread_cond_t IOdoneCond;
+         int IOnumJobs;
+         int IOfirstJob;
+         int * IOjobType;
+         int * IOjobIndex;
+         bool * IOjobMovingRight;
+         int * IOpending; //The number of queued or running jobs per boundary
+         bool * IOprefetched; //Whether a prefetch was queued for the boundary, which is not consumed yet
+         
+         //Residency of the renormalized operators within a memory budget (DMRGoperatorsio.cpp). A resident boundary is kept in memory instead of being stored behind the sweep; it can be spilled to disk later on.
+         double operatorFootprint(const int index, const bool movingRight); //Estimated from the current virtual dimensions, in bytes
+         void spillOperators(const int index);
+         double IObudget; //In bytes
+         bool * IOresident;
+         long long * IOlastNeeded;
+         long long IOclock;
+         
+         //Memory-mapped renormalized operators (DMRGoperatorsmap.cpp). With CheMPS2::DMRG_mapRenormOptrOnDisk, the operators of all boundaries stay allocated as without CheMPS2::DMRG_storeRenormOptrOnDisk, but allocateTensors attaches their storage to a MAP_SHARED mapping of an (unlinked) file per boundary in CheMPS2::TMPpath. The kernel then pages the operators in and out, and no explicit stores or loads are done.
+         void startOperatorMap();
+         void stopOperatorMap();
+         void mapOperators(const int index, const bool movingRight);
+         void unmapOperators(const int index);
+         bool mapActive; //Whether the operators are memory-mapped; initialized from CheMPS2::DMRG_mapRenormOptrOnDisk
+         int * mapFile; //The file descriptor per boundary; negative when not open
+         double ** mapStorage; //The mapped region per boundary; NULL when not mapped
+         size_t * mapBytes; //The size of the mapped region per boundary
+         
+         //Pooled storage of the renormalized operators (DMRGoperatorspool.cpp). Unless they are memory-mapped, allocateTensors attaches the storage of all operators of a boundary to one contiguous region, and deleteTensors hands that region back to a pool of at most CheMPS2::DMRG_operatorPoolRegions idle regions. The next allocation picks the smallest idle region which is large enough, so that the operator storage is recycled across the sweep steps without malloc churn or fresh page faults. The idle regions are shared with the I/O thread, which deletes the stored operators, and are guarded by poolMutex; the region of a boundary is only touched by the thread which (de)allocates its tensors.
+         enum { OPERATORREGION_ALIGN=8, OPERATORREGION_SLACK=16 }; //Each tensor is aligned to a cache line; new regions get 1/16 of extra room
+         void startOperatorPool();
+         void stopOperatorPool();
+         static size_t operatorRegionSize(Tensor ** list, const int num); //In doubles
+         static void attachOperatorRegion(Tensor ** list, const int num, double * region);
+         void poolOperators(const int index, const bool movingRight);
+         void releaseOperators(const int index);
+         void trimOperatorPool(); //Delete the idle regions
+         bool poolActive;
+         double ** poolStorage; //The region per boundary; NULL when the boundary has no pooled region
+         size_t * poolSize; //The size of the region per boundary, in doubles
+         double ** poolIdle;
+         size_t * poolIdleSize;
+         int poolNumIdle;
+         pthread_mutex_t poolMutex;
+         
+         //With the pool, deleteTensors also keeps the tensor objects of a boundary, without their storage, and allocateTensors reuses them when the same direction is allocated again with unchanged virtual dimensions at that boundary. The Otensors are always rebuilt. A boundary keeps at most one such set per direction, and the set of a direction is taken out again when that direction is allocated, so that their memory is of the order of the sector bookkeeping of the operators of one sweep direction.
+         int parkOperators(const int index, const bool movingRight, Tensor ** list, const int num); //Keeps list[0 .. returned number of tensors) for reuse
+         Tensor ** unparkOperators(const int index, const bool movingRight); //The kept tensors in the order of listOperators, or NULL; the caller deletes the array. Also records allocatedDims[index].
+         void deleteParkedOperators(const int slot);
+         int boundaryDims(const int boundary, int * dims) const; //The virtual dimensions of a boundary (only counted if dims==NULL)
+         Tensor *** parkedTensors; //The kept tensors per slot 2*index+(movingRight?0:1); NULL when there are none
+         int * parkedNum;
+         int ** parkedDims;
+         int ** allocatedDims; //The virtual dimensions with which the operators of a boundary were allocated, recorded by unparkOperators
          
          //The storage and functions to handle excited states
          int nStates;
@@ -211,6 +363,14 @@ namespace CheMPS2{
          void calcOverlapsWithLowerStates();
          void calcOverlapsWithLowerStatesDuringSweeps_debug(double ** VeffTilde, Sobject * denS);
          
+         //The storage and functions to handle state averaging: the root-dependent tensors SA_Tensors[root > 0] are located at site SA_site (root 0 is MPS[SA_site])
+         bool SA_activated;
+         int SA_nRoots;
+         int SA_site;
+         TensorT ** SA_Tensors;
+         double * SA_Energies;
+         double sweepStateAveraged(const bool movingright, const bool change, const int instruction);
+         
    };
 }
 
@@ -0,0 +1,107 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef DAVIDSONOPTIONS_H
+#define DAVIDSONOPTIONS_H
+
+namespace CheMPS2{
+/** DavidsonOptions class.
+    \date October 17, 2026
+
+    The DavidsonOptions class contains the runtime settings of the Davidson solver in Heff. They can be attached to an instruction of the ConvergenceScheme. The default values are the ones in Options.h:\n
+    (1) the max. number of Davidson vectors (CheMPS2::HEFF_DAVIDSON_NUM_VEC)\n
+    (2) the number of vectors kept at a restart (CheMPS2::HEFF_DAVIDSON_NUM_VEC_KEEP)\n
+    (3) the residual tolerance prefactor (CheMPS2::HEFF_DAVIDSON_RTOL_BASE)\n
+    (4) the preconditioner cutoff (CheMPS2::HEFF_DAVIDSON_PRECOND_CUTOFF)\n
+    (5) the max. number of matrix-vector products per solve (0 means no limit)\n
+    \n
+    The residual tolerance can tighten as the energy converges. During a sweep, the residual tolerance prefactor is max(rtolBase, min(rtolLoose, dE)), with dE the energy difference between the last two sweeps. The Davidson residual tolerance is this prefactor times the square root of the Sobject size. By default rtolLoose equals rtolBase, and the tolerance is fixed. */
+   class DavidsonOptions{
+
+      public:
+
+         //! Constructor, which sets the default values of Options.h
+         DavidsonOptions();
+
+         //! Destructor
+         ~DavidsonOptions();
+
+         //! Set the size of the Davidson space
+         /** \param numVecIn The max. number of Davidson vectors (at least 2)
+             \param numVecKeepIn The number of vectors kept at a restart (at least 1, and smaller than numVecIn) */
+         void setNumVec(const int numVecIn, const int numVecKeepIn);
+
+         //! Set the residual tolerance prefactors
+         /** \param rtolBaseIn The tightest residual tolerance prefactor, which is used when the energy has converged
+             \param rtolLooseIn The loosest residual tolerance prefactor, which is used when the energy changes a lot (at least rtolBaseIn) */
+         void setResidualTolerance(const double rtolBaseIn, const double rtolLooseIn);
+
+         //! Set the preconditioner cutoff
+         /** \param precondCutoffIn The smallest allowed |diag(Heff) - eigenvalue| in the preconditioner */
+         void setPrecondCutoff(const double precondCutoffIn);
+
+         //! Set the max. number of matrix-vector products per Davidson solve
+         /** \param maxMatvecsIn The max. number of matrix-vector products; 0 means no limit */
+         void setMaxMatvecs(const int maxMatvecsIn);
+
+         //! Get the max. number of Davidson vectors
+         /** \return The max. number of Davidson vectors */
+         int getNumVec() const;
+
+         //! Get the number of vectors kept at a restart
+         /** \return The number of vectors kept at a restart */
+         int getNumVecKeep() const;
+
+         //! Get the residual tolerance prefactor for a given energy change
+         /** \param energyChange The energy difference between the last two sweeps
+             \return max(rtolBase, min(rtolLoose, energyChange)) */
+         double getResidualTolerance(const double energyChange) const;
+
+         //! Get the preconditioner cutoff
+         /** \return The preconditioner cutoff */
+         double getPrecondCutoff() const;
+
+         //! Get the max. number of matrix-vector products per Davidson solve
+         /** \return The max. number of matrix-vector products; 0 means no limit */
+         int getMaxMatvecs() const;
+
+      private:
+
+         //The max. number of Davidson vectors
+         int numVec;
+
+         //The number of vectors kept at a restart
+         int numVecKeep;
+
+         //The tightest residual tolerance prefactor
+         double rtolBase;
+
+         //The loosest residual tolerance prefactor
+         double rtolLoose;
+
+         //The preconditioner cutoff
+         double precondCutoff;
+
+         //The max. number of matrix-vector products per solve; 0 means no limit
+         int maxMatvecs;
+
+   };
+}
+
+#endif
@@ -114,8 +114,17 @@ namespace CheMPS2{
                         - If I_i == I_k and hence I_j == I_l : index k>=i and index l>=j
                         - Vmat[Icent][I_i][I_i][i + k*(k+1)/2][j][l-j]
                         - If I_i <  I_k and hence I_j <  I_l : fixed by block order
-                        - Vmat[Icent][I_i][I_k][i + nOrbWithIrrepI_i * k][j][l] */
-         double ****** storage;
+                        - Vmat[Icent][I_i][I_k][i + nOrbWithIrrepI_i * k][j][l]
+            - All elements are stored in one 64-byte aligned array. The pairs (i,k) of a block Vmat[Icent][I_i][I_k] follow each other in the order of the loops over i (outer) and k (inner), and within a pair the rows j follow each other. This is also the order of the HDF5 file, so that save and read are a single write and read.
+                  - pairOffsets[Icent + nIrreps * (I_i + nIrreps * I_k)][i + k(k+1)/2 or i + nOrbWithIrrepI_i * k] is the position of row j==i (Icent == Itriv) or j==0 (Icent > Itriv) of the pair in storage; NULL if the block is not stored
+                  - The position of the other rows follows from the row lengths above */
+         double * storage;
+         
+         //The size of storage
+         long long arraySize;
+         
+         //The position in storage of the first row of each (i,k) pair of each block: see above
+         long long ** pairOffsets;
          
          //Functions to get the correct pointer to memory
          double * getPointer(const int irrep_i, const int irrep_j, const int irrep_k, const int irrep_l, const int i, const int j, const int k, const int l) const;
@@ -34,6 +34,8 @@
 #include "Problem.h"
 #include "SyBookkeeper.h"
 #include "Sobject.h"
+#include "HeffPlan.h"
+#include "DavidsonOptions.h"
 #include "Options.h"
 
 namespace CheMPS2{
@@ -54,6 +56,15 @@ namespace CheMPS2{
          //! Destructor
          ~Heff();
          
+         //! Set the Davidson solver parameters. Without a call to this function, the defaults of Options.h are used.
+         /** \param options The Davidson solver options; NULL means the defaults of Options.h
+             \param energyChange The energy difference between the last two sweeps, which determines the residual tolerance (see DavidsonOptions) */
+         void setDavidsonOptions(const DavidsonOptions * options, const double energyChange);
+         
+         //! Get the number of matrix-vector products during the last call to SolveDAVIDSON or SolveBlockDAVIDSON
+         /** \return The number of matrix-vector products */
+         int gNumMatvecs() const;
+         
          //! Davidson Solver
          /** \param denS Initial guess S-object
              \param Ltensors Pointer to the single contracted 2nd quantized operators
@@ -71,6 +82,25 @@ namespace CheMPS2{
              \param VeffTilde The projection operators to project the nLower lower-lying states out */
          double SolveDAVIDSON(Sobject * denS, TensorL *** Ltensors, TensorA **** Atensors, TensorB **** Btensors, TensorC **** Ctensors, TensorD **** Dtensors, TensorS0 **** S0tensors, TensorS1 **** S1tensors, TensorF0 **** F0tensors, TensorF1 **** F1tensors, TensorQ *** Qtensors, TensorX ** Xtensors, int nLower = 0, double ** VeffTilde = NULL) const;
          
+         //! Block Davidson Solver for the lowest nRoots eigenpairs. The unconverged roots extend the basis together, and the new basis vectors are multiplied with Heff in a single pass over the renormalized operators.
+         /** \param nRoots The number of roots
+             \param denS Initial guess S-objects, one per root. On exit, they contain the eigenvectors. Roots which do not fit in the two-site space are returned as zero.
+             \param eigenvalues Array of length nRoots. On exit, it contains the lowest eigenvalues in ascending order.
+             \param Ltensors Pointer to the single contracted 2nd quantized operators
+             \param Atensors Spin-0 complementary operators of two creators
+             \param Btensors Spin-1 complementary operators of two creators
+             \param Ctensors Spin-0 complementary operators of a creator and an annihilator
+             \param Dtensors Spin-1 complementary operators of a creator and an annihilator
+             \param S0tensors Spin-0 reduction of two creators
+             \param S1tensors Spin-1 reduction of two creators
+             \param F0tensors Spin-0 reduction of a creator and an annihilator
+             \param F1tensors Spin-1 reduction of a creator and an annihilator
+             \param Qtensors Complementary operators of three sandwiched 2nd quantized operators
+             \param Xtensors Pointer to the completely contracted terms
+             \param nLower Number of lower-lying states to project out
+             \param VeffTilde The projection operators to project the nLower lower-lying states out */
+         void SolveBlockDAVIDSON(const int nRoots, Sobject ** denS, double * eigenvalues, TensorL *** Ltensors, TensorA **** Atensors, TensorB **** Btensors, TensorC **** Ctensors, TensorD **** Dtensors, TensorS0 **** S0tensors, TensorS1 **** S1tensors, TensorF0 **** F0tensors, TensorF1 **** F1tensors, TensorQ *** Qtensors, TensorX ** Xtensors, int nLower = 0, double ** VeffTilde = NULL) const;
+         
       private:
       
          //The SyBookkeeper
@@ -79,11 +109,24 @@ namespace CheMPS2{
          //The Problem (and hence Hamiltonian)
          const Problem * Prob;
          
+         //The Davidson solver parameters: the max. number of vectors, the number of vectors kept at a restart, the residual tolerance prefactor, the preconditioner cutoff and the max. number of matrix-vector products (0 means no limit)
+         int dvdsNumVec;
+         int dvdsNumVecKeep;
+         double dvdsRtolBase;
+         double dvdsPrecondCutoff;
+         int dvdsMaxMatvecs;
+         
+         //The number of matrix-vector products during the last solve
+         mutable int dvdsNumMatvecs;
+         
          //Phase function
          static int phase(const int TwoTimesPower);
       
-         //Do Heff * memS -> memHeff
-         void makeHeff(double * memS, double * memHeff, const Sobject * denS, TensorL *** Ltensors, TensorA **** Atensors, TensorB **** Btensors, TensorC **** Ctensors, TensorD **** Dtensors, TensorS0 **** S0tensors, TensorS1 **** S1tensors, TensorF0 **** F0tensors, TensorF1 **** F1tensors, TensorQ *** Qtensors, TensorX ** Xtensors, int nLower, double ** VeffTilde) const;
+         //Do Heff * memS -> memHeff. If plan!=NULL, the diagrams are recorded in plan during the first call, and the following calls execute the recorded plan.
+         void makeHeff(double * memS, double * memHeff, const Sobject * denS, TensorL *** Ltensors, TensorA **** Atensors, TensorB **** Btensors, TensorC **** Ctensors, TensorD **** Dtensors, TensorS0 **** S0tensors, TensorS1 **** S1tensors, TensorF0 **** F0tensors, TensorF1 **** F1tensors, TensorQ *** Qtensors, TensorX ** Xtensors, int nLower, double ** VeffTilde, HeffPlan * plan) const;
+         
+         //Do Heff * memS[ivec] -> memHeff[ivec] for nVec vectors, in a single pass over the contraction schedule when plan!=NULL
+         void makeHeffBlock(const int nVec, double ** memS, double ** memHeff, const Sobject * denS, TensorL *** Ltensors, TensorA **** Atensors, TensorB **** Btensors, TensorC **** Ctensors, TensorD **** Dtensors, TensorS0 **** S0tensors, TensorS1 **** S1tensors, TensorF0 **** F0tensors, TensorF1 **** F1tensors, TensorQ *** Qtensors, TensorX ** Xtensors, int nLower, double ** VeffTilde, HeffPlan * plan) const;
          
          //Fill the diagonal elements
          void fillHeffDiag(double * memHeffDiag, const Sobject * denS, TensorC **** Ctensors, TensorD **** Dtensors, TensorF0 **** F0tensors, TensorF1 **** F1tensors, TensorX ** Xtensors, int nLower, double ** VeffTilde) const;
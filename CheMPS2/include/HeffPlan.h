@@ -0,0 +1,234 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef HEFFPLAN_H
+#define HEFFPLAN_H
+
+#include "Sobject.h"
+
+namespace CheMPS2{
+/** HeffPlan class.
+    \date October 17, 2026
+
+    The HeffPlan class contains the contraction schedule of the effective Hamiltonian for one Sobject. The symmetry bookkeeping in the Heff diagrams (block lookups, dimensions, Wigner symbols, matrix elements and operator block pointers) does not change during one call of Heff::SolveDAVIDSON. During the first matrix-vector product, the BLAS calls of the diagrams are therefore recorded per Sobject block as a flat list of tasks. The operands of a task are either constant operator blocks, or offsets in the Sobject vectors and work arrays. The following matrix-vector products replay the task lists, which is a pure stream of BLAS calls.
+
+    The diagrams call the BLAS wrappers HeffPlan::dgemm, HeffPlan::daxpy, HeffPlan::dcopy and HeffPlan::clear. They execute the operation, and record it when the calling thread is recording.
+
+    At low and medium virtual dimension, most recorded tasks are tiny, and the per-call overhead of BLAS dominates. When the task lists are compacted, two passes therefore cut down the number of calls:
+     - A chain of copies and axpys which builds a linear combination of operator blocks in a work array does not depend on the Sobject vector. Such a chain is evaluated once into a constant pool, and replaced by a single copy.
+     - Matrix multiplications with m*n*k <= CheMPS2::HEFF_smallGemmCutoff, and vector operations with length <= CheMPS2::HEFF_smallVectorCutoff, are executed by the small-matrix kernels HeffPlan::smallGemm and HeffPlan::smallAxpy instead of BLAS.
+
+    The tasks are not bucketed by shape into grouped or batched calls: the linked BLAS has no batched interface, and the work arrays are reused within a block, so the tasks of a block are executed one at a time in recorded order.
+
+    The replay is parallelized over work items, which are handed out from the most to the least expensive one (estimated from the flop counts of the tasks). In singlet ground states, a few central blocks carry most of the work. A block whose cost exceeds the total cost divided by (CheMPS2::HEFF_itemsPerThread * the number of threads) is therefore split into several items, at points in its task list where no work array content is live. The first item of a split block writes into memHeff; the others accumulate into private partial results, which are added to memHeff in a fixed order afterwards. */
+   class HeffPlan{
+
+      public:
+
+         //! Constructor
+         /** \param denSIn The Sobject for which the effective Hamiltonian is scheduled
+             \param workSizeIn The size of each of the two work arrays which are passed to the diagrams */
+         HeffPlan(const Sobject * denSIn, const int workSizeIn);
+
+         //! Destructor
+         ~HeffPlan();
+
+         //! Whether the task lists still need to be recorded
+         /** \return Whether the task lists still need to be recorded */
+         bool needsRecording() const;
+
+         //! Whether the task lists are recorded and can be executed
+         /** \return Whether execute() can be called */
+         bool isRecorded() const;
+
+         //! Start recording the tasks of block ikappa on the calling thread
+         /** \param ikappa The Sobject block for which the tasks are recorded
+             \param memS The Sobject vector on which Heff acts
+             \param memHeff The result vector of Heff
+             \param temp The first work array
+             \param temp2 The second work array */
+         void startRecording(const int ikappa, double * memS, double * memHeff, double * temp, double * temp2);
+
+         //! Stop recording on the calling thread
+         void stopRecording();
+
+         //! Compact the recorded task lists into one flat list. When the schedule exceeds CheMPS2::HEFF_contractionPlanMaxMB, it is discarded.
+         void finalizeRecording();
+
+         //! Execute the recorded tasks: memHeff = Heff * memS (excluding the projection of lower-lying states)
+         /** \param memS The Sobject vector on which Heff acts
+             \param memHeff The result vector */
+         void execute(double * memS, double * memHeff);
+
+         //! Execute the recorded tasks for a block of vectors in a single pass over the schedule: memHeff[ivec] = Heff * memS[ivec] (excluding the projection of lower-lying states)
+         /** \param nVec The number of vectors
+             \param memS The Sobject vectors on which Heff acts
+             \param memHeff The result vectors */
+         void execute(const int nVec, double ** memS, double ** memHeff);
+
+         //! Get the number of recorded tasks
+         /** \return The number of recorded tasks */
+         int gNumTasks() const;
+
+         //! Wrapper for dgemm_, see Lapack.h
+         static void dgemm(char * transA, char * transB, int * m, int * n, int * k, double * alpha, double * A, int * lda, double * B, int * ldb, double * beta, double * C, int * ldc);
+
+         //! Wrapper for daxpy_, see Lapack.h
+         static void daxpy(int * n, double * alpha, double * x, int * incx, double * y, int * incy);
+
+         //! Wrapper for dcopy_, see Lapack.h
+         static void dcopy(int * n, double * x, int * incx, double * y, int * incy);
+
+         //! Small-matrix kernel: C = alpha * op(A) * op(B) + beta * C, with the same conventions as dgemm_
+         /** \param transA Whether op(A) = A ('N') or A^T ('T')
+             \param transB Whether op(B) = B ('N') or B^T ('T')
+             \param m The number of rows of C
+             \param n The number of columns of C
+             \param k The number of columns of op(A)
+             \param alpha The prefactor of op(A) * op(B)
+             \param A The matrix A
+             \param lda The leading dimension of A
+             \param B The matrix B
+             \param ldb The leading dimension of B
+             \param beta The prefactor of C
+             \param C The matrix C
+             \param ldc The leading dimension of C */
+         static void smallGemm(const char transA, const char transB, const int m, const int n, const int k, const double alpha, const double * A, const int lda, const double * B, const int ldb, const double beta, double * C, const int ldc);
+
+         //! Small-vector kernel: y = y + alpha * x, for unit increments
+         /** \param n The vector length
+             \param alpha The prefactor of x
+             \param x The vector x
+             \param y The vector y */
+         static void smallAxpy(const int n, const double alpha, const double * x, double * y);
+
+         //! Set the first size elements of vec to zero
+         /** \param size The number of elements to set
+             \param vec The array */
+         static void clear(const int size, double * vec);
+
+      private:
+
+         //Operand buffers: constant operator blocks (absolute pointer), the two Sobject vectors, the two work arrays, the constant pool and the partial results of the split blocks
+         enum { HEFFPLAN_ABSOLUTE=0, HEFFPLAN_MEMS=1, HEFFPLAN_MEMHEFF=2, HEFFPLAN_TEMP=3, HEFFPLAN_TEMP2=4, HEFFPLAN_CONSTANT=5, HEFFPLAN_PARTIAL=6, HEFFPLAN_NUMBUFFERS=7 };
+
+         //Task types; the small variants are only assigned in finalizeRecording()
+         enum { HEFFPLAN_GEMM=0, HEFFPLAN_AXPY=1, HEFFPLAN_COPY=2, HEFFPLAN_CLEAR=3, HEFFPLAN_SMALLGEMM=4, HEFFPLAN_SMALLAXPY=5, HEFFPLAN_SMALLCOPY=6 };
+
+         //One BLAS call. Operand 0 and 1 are the inputs (A and B for gemm; x for axpy and copy), operand 2 is the output (C for gemm; y for axpy, copy and clear).
+         struct HeffTask{
+            char type;
+            char transA;
+            char transB;
+            unsigned char buffer[3];
+            int m; //the vector length for axpy, copy and clear
+            int n;
+            int k;
+            int ld[3]; //the increments for axpy and copy
+            int offset[3];
+            double * absolute[3];
+            double alpha;
+            double beta;
+         };
+
+         //The Sobject
+         const Sobject * denS;
+
+         //The number of Sobject blocks
+         int nKappa;
+
+         //The size of the Sobject vectors
+         int vectorSize;
+
+         //The size of each work array
+         int workSize;
+
+         //Whether finalizeRecording() has been called
+         bool recordingDone;
+
+         //Whether the flat task list is available
+         bool recorded;
+
+         //During recording: the task lists per block, with their lengths and allocated sizes
+         HeffTask ** recordTasks;
+         int * recordNum;
+         int * recordAlloc;
+
+         //After recording: the flat task list. The tasks of block ikappa are tasks[kappa2task[ikappa]] to tasks[kappa2task[ikappa+1]-1].
+         HeffTask * tasks;
+         int * kappa2task;
+
+         //After recording: the constant pool with the evaluated operator chains
+         double * constants;
+
+         //After recording: the work items, sorted by decreasing cost. Item i consists of tasks[itemFirst[i]] to tasks[itemLast[i]-1].
+         int nItems;
+         int * itemFirst;
+         int * itemLast;
+
+         //After recording: the split blocks. Block splitKappa[i] has splitParts[i] items; the partial results of all but the first item start at splitOffset[i] in the partial buffer of each vector, one block after the other.
+         int nSplit;
+         int * splitKappa;
+         int * splitParts;
+         int * splitOffset;
+
+         //The size of the partial results per vector, and the partial buffer for partialVectors vectors (it only grows)
+         int partialSize;
+         int partialVectors;
+         double * partial;
+
+         //Split the expensive blocks and sort the work items by decreasing cost
+         void schedule();
+
+         //The positions within the task list of block ikappa where it is cut in parts of about target cost; returns the number of cuts
+         int findCuts(const int ikappa, const double target, int * cuts) const;
+
+         //The estimated cost of a task: its flop count plus the call overhead
+         static double cost(const HeffTask & task);
+
+         //The range [lower, upper) of buffer elements which an operand of a task touches
+         static void operandRange(const HeffTask & task, const int operand, int & lower, int & upper);
+
+         //The number of tasks which will remain after folding the operator chains of a task list, and the size of their constant pool
+         static void countFolded(const HeffTask * list, const int num, int & numTasks, int & poolSize);
+
+         //The length of the foldable operator chain which starts at list[start]: a copy from an operator block (or a clear), followed by axpys from operator blocks onto the same unit-stride range. Chains shorter than 2 are not folded.
+         static int chainLength(const HeffTask * list, const int num, const int start);
+
+         //Assign the small kernels to the tasks which are small enough
+         static void classify(HeffTask & task);
+
+         //Append a task to the list of the block which the calling thread is recording
+         void append(const HeffTask & task);
+
+         //Find the buffer and offset (or absolute pointer) of ptr, for the calling thread's recording buffers
+         static void locate(double * ptr, unsigned char & buffer, int & offset, double *& absolute);
+
+         //Get the pointer to an operand of a task
+         static double * resolve(const HeffTask & task, const int operand, double ** bases);
+
+         //Record calls (only called from the wrappers when the calling thread is recording)
+         static void recordGemm(char * transA, char * transB, int * m, int * n, int * k, double * alpha, double * A, int * lda, double * B, int * ldb, double * beta, double * C, int * ldc);
+         static void recordVector(const int type, const int n, const double alpha, double * x, const int incx, double * y, const int incy);
+
+   };
+}
+
+#endif
+
@@ -31,11 +31,27 @@ namespace CheMPS2{
    const bool   CASSCF_storeUnitary           = true;
    const double CASSCF_gradientNormThreshold  = 1e-6;
    const string CASSCF_unitaryStorageName     = "CheMPS2_CASSCF.h5";
+   const bool   CASSCF_store2DM               = false;
+   const string CASSCF_2DMstorageName         = "CheMPS2_CASSCF_2DM.h5";
    const int    CASSCF_maxlinsizeCutoff       = 100;
+   const bool   CASSCF_restrictedRotation     = false;
+   const double CASSCF_augHessDenseMaxMB      = 4096.0;
+   const int    CASSCF_augHessNumVec          = 32;
+   const int    CASSCF_augHessNumVecKeep      = 8;
+   const int    CASSCF_augHessMaxIter         = 1000;
+   const double CASSCF_augHessRTOL            = 1e-8;
 
    const string TMPpath                       = "/tmp/";
    const bool   DMRG_printDiscardedWeight     = false;
+   const bool   DMRG_printDavidsonStats       = false;
    const bool   DMRG_storeRenormOptrOnDisk    = true;
+   const bool   DMRG_asyncOperatorIO          = true;
+   const int    DMRG_operatorIOqueueLength    = 8;
+   const int    DMRG_operatorChunkSize        = 65536;
+   const int    DMRG_operatorCompression      = 0;
+   const double DMRG_operatorMemoryBudgetMB   = 0.0;
+   const bool   DMRG_mapRenormOptrOnDisk      = false;
+   const int    DMRG_operatorPoolRegions      = 2;
    const bool   DMRG_storeMpsOnDisk           = false;
    
    const bool   HAMILTONIAN_debugPrint        = false;
@@ -48,6 +64,15 @@ namespace CheMPS2{
    const int    HEFF_DAVIDSON_NUM_VEC_KEEP    = 3;
    const double HEFF_DAVIDSON_PRECOND_CUTOFF  = 1e-12;
    const double HEFF_DAVIDSON_RTOL_BASE       = 1e-10;
+   const bool   HEFF_contractionPlan          = true;
+   const double HEFF_contractionPlanMaxMB     = 2048.0;
+   const double HEFF_smallGemmCutoff          = 64.0;
+   const int    HEFF_smallVectorCutoff        = 256;
+   const double HEFF_itemsPerThread           = 4.0;
+   
+   const double PROBLEM_mxElementCacheMaxMB   = 512.0;
+   
+   const int    SOBJECT_threadedSvdCutoff     = 500;
    
    const bool   SYBK_debugPrint               = false;
    const int    SYBK_dimensionCutoff          = 262144;
@@ -104,6 +104,9 @@ namespace CheMPS2{
          //! Reorder the orbitals, so that they form irrep blocks, with order of irreps Ag B1u B3u B2g B2u B3g B1g Au
          void SetupReorderD2h();
          
+         //! Build a cache with all matrix elements gMxElement in DMRG orbital order, with one element per class of the 8-fold permutation symmetry (about L^4/8 doubles), so that gMxElement is a few integer operations and a single load. The cache is not built when it would be larger than CheMPS2::PROBLEM_mxElementCacheMaxMB. It has to be rebuilt when the Hamiltonian changes; the DMRG constructor does this.
+         void construct();
+         
       private:
       
          //Pointer to the Hamiltonian --> constructed and destructed outside of this class
@@ -130,6 +133,15 @@ namespace CheMPS2{
          //f2[DMRGIndex] = HamiltonianIndex
          int * f2;
          
+         //The number of orbitals
+         int L;
+         
+         //mxElements[first * (first + 1) / 2 + second] = gMxElement(alpha, beta, gamma, delta) in DMRG orbital order, with first >= second the indices gamma * (gamma + 1) / 2 + alpha of the pairs (alpha <= gamma) and (beta <= delta); NULL if the cache is not built
+         double * mxElements;
+         
+         //Calculate gMxElement from the Hamiltonian
+         double calcMxElement(const int alpha, const int beta, const int gamma, const int delta) const;
+         
    };
 }
 
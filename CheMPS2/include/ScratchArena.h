@@ -0,0 +1,69 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef SCRATCHARENA_H
+#define SCRATCHARENA_H
+
+#include <stdlib.h>
+
+namespace CheMPS2{
+/** ScratchArena class.
+    \date October 17, 2026
+
+    The ScratchArena class hands out the work arrays of the diagram kernels: Heff::makeHeff, Heff::fillHeffDiag, HeffPlan::execute, DMRG::updateMovingRight/Left, TensorX::update and TwoDM::FillSite. Every thread owns SCRATCHARENA_NUMSLOTS buffers, which only grow. A kernel asks for the buffers of the calling thread with the size it needs (typically derived from SyBookkeeper::gMaxDimAtBound), and does not free them. Once the buffers have reached the size of the largest virtual dimension, the kernels and matrix-vector products do not touch the heap anymore.
+
+    The buffers are thread-local (OpenMP threadprivate), so that a buffer can be used by one kernel at a time on each thread. A kernel which holds a slot should hence not call another kernel which uses the same slot. The number of requests and heap allocations is counted per thread, to check that the hot path is allocation-free, and summed over the threads when it is asked for.
+
+    OpenMP only keeps threadprivate data across parallel regions with the same number of threads. The functions which act on all threads (release from within a parallel region, the statistics and their reset) hence only see the threads of a team of the current size, which should be the size of the teams in which the kernels ran. */
+   class ScratchArena{
+
+      public:
+
+         //! The number of double buffers per thread
+         enum { SCRATCHARENA_NUMSLOTS = 3 };
+
+         //! Get a double buffer of the calling thread
+         /** \param slot The buffer, between 0 and SCRATCHARENA_NUMSLOTS-1
+             \param size The required number of doubles
+             \return Pointer to the buffer; its content is undefined */
+         static double * get(const int slot, const size_t size);
+
+         //! Get the pointer buffer of the calling thread
+         /** \param size The required number of pointers
+             \return Pointer to the buffer; its content is undefined */
+         static double ** getPointers(const size_t size);
+
+         //! Free the buffers of the calling thread. Call it within a parallel region to free the buffers of all threads of that team. The buffers of threads outside the team, such as the extra threads of an earlier and larger team, are not freed.
+         static void release();
+
+         //! Get the number of buffer requests since the last reset, summed over the threads of a team of the current size. Call it outside of parallel regions.
+         /** \return The number of calls to get() and getPointers() */
+         static long long gNumRequests();
+
+         //! Get the number of heap allocations since the last reset, summed over the threads of a team of the current size. Call it outside of parallel regions.
+         /** \return The number of times a buffer had to grow */
+         static long long gNumAllocations();
+
+         //! Reset the request and allocation counters of the threads of a team of the current size. Call it outside of parallel regions.
+         static void resetStatistics();
+
+   };
+}
+
+#endif
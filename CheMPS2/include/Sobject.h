@@ -102,6 +102,17 @@ namespace CheMPS2{
              \return the discarded weight if change==true ; else 0.0 */
          double Split(TensorT * Tleft, TensorT * Tright, const int virtualdimensionD, const bool movingright, const bool change);
          
+         //! SVD the state-averaged S-objects of several roots into TensorT's. The roots have equal weights. When moving right, the left TensorT is shared and the right TensorT's are root-dependent; when moving left, the other way around.
+         /** \param nRoots The number of roots
+             \param denS The S-objects of the roots; they all span the same sites
+             \param Tleft Left TensorT storage space. When moving right, Tleft[0] is shared by all roots and left normalized at output; when moving left, Tleft[root] contains U times the singular values of root.
+             \param Tright Right TensorT storage space. When moving left, Tright[0] is shared by all roots and right normalized at output; when moving right, Tright[root] contains the singular values times V^T of root.
+             \param virtualdimensionD The virtual dimension which is partitioned over the different symmetry blocks based on the state-averaged Schmidt spectrum
+             \param movingright Whether the root-dependent part moves to the right
+             \param change Whether or not the symmetry virtual dimensions are allowed to change (when false: D doesn't matter)
+             \return the discarded weight of the state-averaged density matrix if change==true ; else 0.0 */
+         static double Split(const int nRoots, Sobject ** denS, TensorT ** Tleft, TensorT ** Tright, const int virtualdimensionD, const bool movingright, const bool change);
+         
          //! Add noise to the current S-object
          /** \param NoiseLevel The noise added to the S-object is of size (-0.5 < random number < 0.5) * NoiseLevel / infinity-norm(gStorage()) */
          void addNoise(const double NoiseLevel);
@@ -192,6 +203,24 @@ namespace CheMPS2{
          //The actual variables. Symmetry block kappa begins at storage+kappa2index[kappa] and ends at storage+kappa2index[kappa+1].
          double * storage;
          
+         //Dense lookup table for gKappa: the left sector (NL,TwoSL,IL) is mapped to a left block number with sectorLeftNum[NL-NLmin][TwoSL/2][IL] (-1 if dimL==0)
+         int NLmin;
+         int NLmax;
+         int numTwoSL;
+         int * sectorLeftNum;
+         
+         //kappaLookup[leftnum * numLocal + gLocalNum(N1,N2,TwoJ,TwoSR-TwoSL)] gives kappa or -1
+         int * kappaLookup;
+         
+         //The number of (N1,N2,TwoJ,TwoSR-TwoSL) combinations per left block
+         static const int numLocal = 50;
+         
+         //Map (N1,N2,TwoJ,TwoSR-TwoSL) to [0,numLocal[; -1 when impossible
+         static int gLocalNum(const int N1, const int N2, const int TwoJ, const int TwoSRminTwoSL);
+         
+         //Fill sectorLeftNum and kappaLookup (called from the constructor once the sector arrays are set)
+         void fillLookup();
+         
    };
 }
 
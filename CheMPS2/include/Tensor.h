@@ -32,6 +32,16 @@ namespace CheMPS2{
 
       public:
          
+         //! Constructor: the storage is owned by the Tensor
+         Tensor();
+         
+         //! Destructor
+         virtual ~Tensor();
+         
+         //! Let the Tensor use an externally allocated and destroyed memory region of size gKappa2index(gNKappa()) as storage, e.g. a memory-mapped file. The external region can be replaced by another one, or detached with NULL. The current content of the storage is discarded.
+         /** \param external Pointer to the external memory region */
+         void attachStorage(double * external);
+         
          //! Get the number of tensor blocks
          /** return The number of tensor blocks */
          virtual int gNKappa() const = 0;
@@ -80,6 +90,9 @@ namespace CheMPS2{
          //! The actual variables. Tensor block kappa begins at storage+kappa2index[kappa] and ends at storage+kappa2index[kappa+1].
          double * storage;
          
+         //! Whether storage was allocated by the Tensor itself, and should be deleted by its destructor.
+         bool ownsStorage;
+         
          //! Number of Tensor blocks.
          int nKappa;
          
@@ -95,6 +108,32 @@ namespace CheMPS2{
          //! kappa2index[kappa] indicates the start of tensor block kappa in storage. kappa2index[nKappa] gives the size of storage.
          int * kappa2index;
          
+         //! Build the block index, which maps a first sector (N1,TwoS1,I1) to its first tensor block. To be called once sectorN1, sectorTwoS1, sectorI1 and nKappa are set; the blocks should be ordered by first sector.
+         void buildBlockIndex();
+         
+         //! Delete the block index
+         void deleteBlockIndex();
+         
+         //! Get the first tensor block with a certain first sector
+         /** \param N1 The left or up particle number sector
+             \param TwoS1 The left or up spin symmetry sector
+             \param I1 The left or up irrep sector
+             \return The smallest kappa with sectorN1[kappa]==N1, sectorTwoS1[kappa]==TwoS1 and sectorI1[kappa]==I1; -1 means no such block */
+         int gKappaFirstSector(const int N1, const int TwoS1, const int I1) const;
+         
+      private:
+      
+         //The smallest and largest N1 present in the sector arrays
+         int blockIndexNmin;
+         int blockIndexNmax;
+         
+         //The smallest TwoS1/2 present in the sector arrays, and the number of TwoS1/2 values in the range
+         int blockIndexHalfTwoSmin;
+         int blockIndexNumHalfTwoS;
+         
+         //blockIndex[I1 + nIrreps * (TwoS1/2 - blockIndexHalfTwoSmin + blockIndexNumHalfTwoS * (N1 - blockIndexNmin))] is the first kappa with that first sector or -1
+         int * blockIndex;
+         
    };
 }
 
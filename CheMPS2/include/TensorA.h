@@ -37,8 +37,9 @@ namespace CheMPS2{
          /** \param indexIn The boundary index
              \param IdiffIn Direct product of irreps of the two 2nd quantized operators; both sandwiched & to sandwich
              \param movingRightIn If true: sweep from left to right. If false: sweep from right to left
-             \param denBKIn The problem to be solved */
-         TensorA(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn);
+             \param denBKIn The problem to be solved
+             \param ownsStorageIn Whether the Tensor allocates its own storage. If false, attachStorage should be called before the storage is used */
+         TensorA(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const bool ownsStorageIn);
          
          //! Destructor
          ~TensorA();
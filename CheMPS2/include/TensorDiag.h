@@ -37,8 +37,9 @@ namespace CheMPS2{
       
          //! Constructor
          /** \param indexIn The boundary index
-             \param denBKIn The problem to be solved */
-         TensorDiag(const int indexIn, const SyBookkeeper * denBKIn);
+             \param denBKIn The problem to be solved
+             \param ownsStorageIn Whether the Tensor allocates its own storage. If false, attachStorage should be called before the storage is used */
+         TensorDiag(const int indexIn, const SyBookkeeper * denBKIn, const bool ownsStorageIn);
          
          //! Destructor
          ~TensorDiag();
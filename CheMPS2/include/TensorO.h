@@ -40,8 +40,9 @@ namespace CheMPS2{
              \param movingRightIn If true: sweep from left to right. If false: sweep from right to left
              \param denBKupIn The symmetry bookkeeper with the upper symmetry sector virtual dimensions (old MPS)
              \param denBKdownIn The symmetry bookkeeper with the lower symmetry sector virtual dimensions (current MPS)
-             \param ProbIn The Problem containing the Hamiltonian matrix elements */
-         TensorO(const int indexIn, const bool movingRightIn, const SyBookkeeper * denBKupIn, const SyBookkeeper * denBKdownIn, const Problem * ProbIn);
+             \param ProbIn The Problem containing the Hamiltonian matrix elements
+             \param ownsStorageIn Whether the Tensor allocates its own storage. If false, attachStorage should be called before the storage is used */
+         TensorO(const int indexIn, const bool movingRightIn, const SyBookkeeper * denBKupIn, const SyBookkeeper * denBKdownIn, const Problem * ProbIn, const bool ownsStorageIn);
          
          //! Destructor
          ~TensorO();
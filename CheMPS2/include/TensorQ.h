@@ -48,8 +48,9 @@ namespace CheMPS2{
              \param movingRightIn If true: sweep from left to right. If false: sweep from right to left
              \param denBKIn Symmetry bookkeeper of the problem at hand
              \param ProbIn Problem containing the matrix elements
-             \param siteIn The site on which the last crea/annih should work */
-         TensorQ(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const Problem * ProbIn, const int siteIn);
+             \param siteIn The site on which the last crea/annih should work
+             \param ownsStorageIn Whether the Tensor allocates its own storage. If false, attachStorage should be called before the storage is used */
+         TensorQ(const int indexIn, const int IdiffIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const Problem * ProbIn, const int siteIn, const bool ownsStorageIn);
          
          //! Destructor
          ~TensorQ();
@@ -45,8 +45,9 @@ namespace CheMPS2{
          /** \param indexIn The boundary index
              \param movingRightIn If true: sweep from left to right. If false: sweep from right to left
              \param denBKIn The symmetry bookkeeper with symemtry sector virtual dimensions
-             \param ProbIn The Problem containing the Hamiltonian matrix elements */
-         TensorX(const int indexIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const Problem * ProbIn);
+             \param ProbIn The Problem containing the Hamiltonian matrix elements
+             \param ownsStorageIn Whether the Tensor allocates its own storage. If false, attachStorage should be called before the storage is used */
+         TensorX(const int indexIn, const bool movingRightIn, const SyBookkeeper * denBKIn, const Problem * ProbIn, const bool ownsStorageIn);
          
          //! Destructor
          ~TensorX();
@@ -63,6 +64,19 @@ namespace CheMPS2{
              \param F1tensors Array with the TensorF1's */
          void update(TensorT * denT, TensorL ** Ltensors, TensorX * Xtensor, TensorQ * Qtensor, TensorA * Atensor, TensorC * Ctensor, TensorF0 ** F0tensors, TensorD * Dtensor, TensorF1 ** F1tensors);
          
+         //! Clear and add the relevant terms to one symmetry block of the TensorX. Calling it for all blocks is equivalent to update(denT, Ltensors, Xtensor, Qtensor, Atensor, Ctensor, F0tensors, Dtensor, F1tensors); the blocks can be done concurrently.
+         /** \param ikappa The symmetry block
+             \param denT TensorT from which the new TensorX should be made
+             \param Ltensors Array with the TensorL's
+             \param Xtensor The previous TensorX
+             \param Qtensor The previous TensorQ
+             \param Atensor The previous TensorA
+             \param Ctensor The previous TensorC
+             \param F0tensors Array with the TensorF0's
+             \param Dtensor The previous TensorD
+             \param F1tensors Array with the TensorF1's */
+         void updateBlock(const int ikappa, TensorT * denT, TensorL ** Ltensors, TensorX * Xtensor, TensorQ * Qtensor, TensorA * Atensor, TensorC * Ctensor, TensorF0 ** F0tensors, TensorD * Dtensor, TensorF1 ** F1tensors);
+         
          //! Clear and add the relevant terms to the TensorX
          /** \param denT TensorT from which the new TensorX should be made */
          void update(TensorT * denT);
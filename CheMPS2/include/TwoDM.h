@@ -20,6 +20,8 @@
 #ifndef TWODM_H
 #define TWODM_H
 
+#include <string>
+
 #include "TensorT.h"
 #include "TensorL.h"
 #include "TensorF0.h"
@@ -38,7 +40,8 @@ namespace CheMPS2{
     we can define two spin-reduced versions of interest:\n
     \f$ \Gamma^A_{\alpha \beta ; \gamma \delta} = \sum_{\sigma \tau} \Gamma_{(\alpha \sigma) (\beta \tau) ; (\gamma \sigma) (\delta \tau)} \f$ \n
     \f$ \Gamma^B_{\alpha \beta ; \gamma \delta} = \sum_{\sigma} \left( \Gamma_{(\alpha \sigma) (\beta \sigma) ; (\gamma \sigma) (\delta \sigma)} - \Gamma_{(\alpha \sigma) (\beta -\sigma) ; (\gamma \sigma) (\delta -\sigma)} \right) \f$. \n
-    Because the wave-function belongs to a certain Abelian irrep, \f$ I_{\alpha} \otimes I_{\beta} \otimes I_{\gamma} \otimes I_{\delta} = I_{trivial} \f$ must be valid before the corresponding element \f$ \Gamma^{A,B}_{\alpha \beta ; \gamma \delta} \f$ is non-zero.
+    Because the wave-function belongs to a certain Abelian irrep, \f$ I_{\alpha} \otimes I_{\beta} \otimes I_{\gamma} \otimes I_{\delta} = I_{trivial} \f$ must be valid before the corresponding element \f$ \Gamma^{A,B}_{\alpha \beta ; \gamma \delta} \f$ is non-zero.\n
+    Both 2DMs have the 4-fold permutation symmetry \f$ \Gamma_{\alpha \beta ; \gamma \delta} = \Gamma_{\beta \alpha ; \delta \gamma} = \Gamma_{\gamma \delta ; \alpha \beta} = \Gamma_{\delta \gamma ; \beta \alpha} \f$. Unlike the matrix elements in FourIndex, they do not have the 8-fold symmetry. Only the symmetry-allowed elements of one permutation are stored, which requires about \f$ L^4 / (4 n_{irreps}) \f$ doubles per 2DM.
 */
    class TwoDM{
 
@@ -120,6 +123,14 @@ namespace CheMPS2{
          //! Print the 2DM-A and 2DM-B in Hamiltonian indices [i.e. the irrep order from Psi4] to the file 2DMoutput.txt
          void print2DMAandB_HAM();
          
+         //! Save the packed 2DM-A and 2DM-B, together with the orbital irreps and the orbital reordering, to an HDF5 file
+         /** \param name filename */
+         void save(const std::string name) const;
+         
+         //! Load the packed 2DM-A and 2DM-B from an HDF5 file, which was written by save for the same orbital irreps
+         /** \param name filename */
+         void read(const std::string name);
+         
       private:
       
          //The BK containing all the irrep information
@@ -131,10 +142,29 @@ namespace CheMPS2{
          //The chain length
          int L;
          
-         //Two 2DM^{A,B} objects
+         /*The following conventions are used for storage:
+            - With a pair (i,j) with i<=j of DMRG orbitals, and Icent = I_i x I_j its center irrep:
+                  - pairIndex[i + L*j] is the number of the pair among all pairs i<=j with the same Icent
+                  - pairIndexX[i + L*j] is the number of the pair among all pairs i<j with the same Icent (-1 if i==j)
+            - Reorder indices with the 4-fold permutation symmetry until i<=j, and until k<=l unless i<j and k>l:
+                  - k<=l : direct element D[Icent][(i,j)][(k,l)] = Gamma_ijkl
+                  - k>l  : exchange element X[Icent][(i,j)][(l,k)] = Gamma_ijkl, with i<j and l<k
+            - D[Icent] and X[Icent] are symmetric in their two pairs, and only the lower triangle (first pair >= second pair) is stored
+            - blockOffset[2*Icent] and blockOffset[2*Icent+1] are the positions of D[Icent] and X[Icent] in TwoDMA and TwoDMB */
+         int * pairIndex;
+         int * pairIndexX;
+         long long * blockOffset;
+         
+         //The number of doubles in each of TwoDMA and TwoDMB
+         long long arraySize;
+         
+         //Two packed 2DM^{A,B} objects
          double * TwoDMA;
          double * TwoDMB;
          
+         //The position of the element in TwoDMA and TwoDMB; -1 if the element is zero due to symmetry
+         long long getIndex(const int cnt1, const int cnt2, const int cnt3, const int cnt4) const;
+         
          //Helper functions
          double doD1(TensorT * denT);
          double doD2(TensorT * denT, TensorL * Lright, double * workmem);
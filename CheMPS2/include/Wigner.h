@@ -0,0 +1,82 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef WIGNER_H
+#define WIGNER_H
+
+namespace CheMPS2{
+/** Wigner class.
+    \date October 17, 2026
+
+    The Wigner class memoizes the Wigner 6j and 9j symbols of GSL. The arguments are twice the angular momenta, as for gsl_sf_coupling_6j and gsl_sf_coupling_9j. In the diagrams and tensor updates, all arguments are small integers: the spins of the virtual sectors, and 0, 1 or 2 for the local and operator spins. The arguments of a symbol are therefore packed into one 64-bit key, which is looked up in an open-addressing hash table. A symbol is only evaluated by GSL the first time it is needed; arguments outside [0, WIGNER_MAXARG] are passed on to GSL directly.
+
+    Every thread has its own table (OpenMP threadprivate), so that lookups and insertions do not need locks. A table starts with room for the symbols which involve spins up to the value passed to setMaxTwoS (e.g. the largest 2S in the SyBookkeeper), and doubles in size when it is half full. */
+   class Wigner{
+
+      public:
+
+         //! The largest argument which is memoized
+         enum { WIGNER_MAXARG = 126 };
+
+         //! Wigner 6j symbol { ja jb jc ; jd je jf }
+         /** \param two_ja Twice ja
+             \param two_jb Twice jb
+             \param two_jc Twice jc
+             \param two_jd Twice jd
+             \param two_je Twice je
+             \param two_jf Twice jf
+             \return The 6j symbol */
+         static double wigner6j(const int two_ja, const int two_jb, const int two_jc, const int two_jd, const int two_je, const int two_jf);
+
+         //! Wigner 9j symbol { ja jb jc ; jd je jf ; jg jh ji }
+         /** \param two_ja Twice ja
+             \param two_jb Twice jb
+             \param two_jc Twice jc
+             \param two_jd Twice jd
+             \param two_je Twice je
+             \param two_jf Twice jf
+             \param two_jg Twice jg
+             \param two_jh Twice jh
+             \param two_ji Twice ji
+             \return The 9j symbol */
+         static double wigner9j(const int two_ja, const int two_jb, const int two_jc, const int two_jd, const int two_je, const int two_jf, const int two_jg, const int two_jh, const int two_ji);
+
+         //! Set the largest virtual spin for which the tables are sized. Only tables which are created afterwards are affected.
+         /** \param maxTwoS Twice the largest spin of the virtual sectors */
+         static void setMaxTwoS(const int maxTwoS);
+
+         //! Switch the memo on or off for all threads. When it is off, every symbol is evaluated by GSL, e.g. to benchmark the memo. Call it outside of parallel regions; the default is on.
+         /** \param active Whether the symbols are memoized */
+         static void setMemo(const bool active);
+         
+         //! Free the table of the calling thread. Call it within a parallel region to free the tables of all threads of the team.
+         static void release();
+
+      private:
+
+         //Look up the key in the table of the calling thread; compute and insert the symbol when it is not present
+         static double lookup(const unsigned long long key, const int * two_j, const bool is9j);
+
+         //Create or enlarge the table of the calling thread
+         static void resize(const int logCapacity);
+
+   };
+}
+
+#endif
@@ -0,0 +1,218 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <stdlib.h>
+#include <iostream>
+#include <math.h>
+#include <sys/time.h>
+
+#include "Problem.h"
+#include "SyBookkeeper.h"
+#include "TensorT.h"
+#include "TensorL.h"
+#include "TensorF0.h"
+#include "TensorF1.h"
+#include "TensorS0.h"
+#include "TensorS1.h"
+#include "TensorA.h"
+#include "TensorB.h"
+#include "TensorC.h"
+#include "TensorD.h"
+
+using namespace std;
+
+/* Benchmark of the block lookup Tensor::gKappa, which is called for every block of every diagram, for 24 electrons in 24 d2h orbitals.
+   Part 1: for all MPS tensors at D = 2000, all combinations of the sectors at both boundaries are looked up, including the absent ones.
+   Part 2: the renormalized operator updates of DMRG::updateMovingRight, which look up the blocks of the new operator, the previous operator and the MPS tensor, are timed at D = 500. The MPS tensors and the operators of the previous boundary are filled with random numbers. At every boundary, one operator of each family is updated from the one of the previous boundary, or made from the TensorL of the previous boundary (F0, F1, S0 and S1 also have this second kind of update).
+   Build it at two commits and compare the number of lookups per second and the time per update. */
+
+double seconds(const struct timeval & start){
+
+   struct timeval end;
+   gettimeofday(&end, NULL);
+   return (end.tv_sec - start.tv_sec) + 1e-6 * (end.tv_usec - start.tv_usec);
+
+}
+
+void fillRandom(CheMPS2::Tensor * tensor){
+
+   double * storage = tensor->gStorage();
+   const int size = tensor->gKappa2index(tensor->gNKappa());
+   for (int cnt=0; cnt<size; cnt++){ storage[cnt] = ((double) rand()) / RAND_MAX - 0.5; }
+
+}
+
+const int numFamilies = 13;
+const char * familyNames[] = { "TensorL::update", "TensorF0::makenew(L)", "TensorF1::makenew(L)", "TensorS0::makenew(L)", "TensorS1::makenew(L)",
+                               "TensorF0::update", "TensorF1::update", "TensorS0::update", "TensorS1::update",
+                               "TensorA::update", "TensorB::update", "TensorC::update", "TensorD::update" };
+
+void benchmarkUpdates(const CheMPS2::Problem * Prob, const int L, const int repeats){
+
+   CheMPS2::SyBookkeeper * denBK = new CheMPS2::SyBookkeeper(Prob, 500);
+   CheMPS2::TensorT ** MPS = new CheMPS2::TensorT*[L];
+   int maxDim = 0;
+   for (int index=0; index<L; index++){
+      MPS[index] = new CheMPS2::TensorT(index, denBK->gIrrep(index), denBK);
+      fillRandom(MPS[index]);
+      if (denBK->gMaxDimAtBound(index) > maxDim){ maxDim = denBK->gMaxDimAtBound(index); }
+   }
+   double * workmem = new double[maxDim * maxDim];
+
+   double * elapsed = new double[numFamilies];
+   for (int family=0; family<numFamilies; family++){ elapsed[family] = 0.0; }
+   struct timeval start;
+   for (int index=1; index<L-1; index++){
+
+      //The operators at boundary index: a TensorL on site index-1, and two-operator tensors on site index-1 (Idiff 0)
+      const int Iprev = denBK->gIrrep(index-1);
+      const int Iprod = denBK->directProd(Iprev, denBK->gIrrep(index));
+      CheMPS2::Tensor * prev[] = { new CheMPS2::TensorL(index, Iprev, true, denBK, true),
+                                   new CheMPS2::TensorF0(index, 0, true, denBK, true), new CheMPS2::TensorF1(index, 0, true, denBK, true),
+                                   new CheMPS2::TensorS0(index, 0, true, denBK, true), new CheMPS2::TensorS1(index, 0, true, denBK, true),
+                                   new CheMPS2::TensorA(index, 0, true, denBK, true), new CheMPS2::TensorB(index, 0, true, denBK, true),
+                                   new CheMPS2::TensorC(index, 0, true, denBK, true), new CheMPS2::TensorD(index, 0, true, denBK, true) };
+      for (int cnt=0; cnt<9; cnt++){ fillRandom(prev[cnt]); }
+      CheMPS2::TensorL * Lprev = (CheMPS2::TensorL *) prev[0];
+
+      //The operators at boundary index+1
+      CheMPS2::TensorL * Lnew = new CheMPS2::TensorL(index+1, Iprev, true, denBK, true);
+      CheMPS2::TensorF0 * F0made = new CheMPS2::TensorF0(index+1, Iprod, true, denBK, true);
+      CheMPS2::TensorF1 * F1made = new CheMPS2::TensorF1(index+1, Iprod, true, denBK, true);
+      CheMPS2::TensorS0 * S0made = new CheMPS2::TensorS0(index+1, Iprod, true, denBK, true);
+      CheMPS2::TensorS1 * S1made = new CheMPS2::TensorS1(index+1, Iprod, true, denBK, true);
+      CheMPS2::TensorF0 * F0new = new CheMPS2::TensorF0(index+1, 0, true, denBK, true);
+      CheMPS2::TensorF1 * F1new = new CheMPS2::TensorF1(index+1, 0, true, denBK, true);
+      CheMPS2::TensorS0 * S0new = new CheMPS2::TensorS0(index+1, 0, true, denBK, true);
+      CheMPS2::TensorS1 * S1new = new CheMPS2::TensorS1(index+1, 0, true, denBK, true);
+      CheMPS2::TensorA * Anew = new CheMPS2::TensorA(index+1, 0, true, denBK, true);
+      CheMPS2::TensorB * Bnew = new CheMPS2::TensorB(index+1, 0, true, denBK, true);
+      CheMPS2::TensorC * Cnew = new CheMPS2::TensorC(index+1, 0, true, denBK, true);
+      CheMPS2::TensorD * Dnew = new CheMPS2::TensorD(index+1, 0, true, denBK, true);
+
+      for (int rep=0; rep<repeats; rep++){
+         gettimeofday(&start, NULL); Lnew->update(Lprev, MPS[index], workmem);                                 elapsed[0]  += seconds(start);
+         gettimeofday(&start, NULL); F0made->makenew(Lprev, MPS[index], workmem);                              elapsed[1]  += seconds(start);
+         gettimeofday(&start, NULL); F1made->makenew(Lprev, MPS[index], workmem);                              elapsed[2]  += seconds(start);
+         gettimeofday(&start, NULL); S0made->makenew(Lprev, MPS[index], workmem);                              elapsed[3]  += seconds(start);
+         gettimeofday(&start, NULL); S1made->makenew(Lprev, MPS[index], workmem);                              elapsed[4]  += seconds(start);
+         gettimeofday(&start, NULL); F0new->update((CheMPS2::TensorF0 *) prev[1], MPS[index], workmem);        elapsed[5]  += seconds(start);
+         gettimeofday(&start, NULL); F1new->update((CheMPS2::TensorF1 *) prev[2], MPS[index], workmem);        elapsed[6]  += seconds(start);
+         gettimeofday(&start, NULL); S0new->update((CheMPS2::TensorS0 *) prev[3], MPS[index], workmem);        elapsed[7]  += seconds(start);
+         gettimeofday(&start, NULL); S1new->update((CheMPS2::TensorS1 *) prev[4], MPS[index], workmem);        elapsed[8]  += seconds(start);
+         gettimeofday(&start, NULL); Anew->update((CheMPS2::TensorA *) prev[5], MPS[index], workmem);          elapsed[9]  += seconds(start);
+         gettimeofday(&start, NULL); Bnew->update((CheMPS2::TensorB *) prev[6], MPS[index], workmem);          elapsed[10] += seconds(start);
+         gettimeofday(&start, NULL); Cnew->update((CheMPS2::TensorC *) prev[7], MPS[index], workmem);          elapsed[11] += seconds(start);
+         gettimeofday(&start, NULL); Dnew->update((CheMPS2::TensorD *) prev[8], MPS[index], workmem);          elapsed[12] += seconds(start);
+      }
+
+      for (int cnt=0; cnt<9; cnt++){ delete prev[cnt]; }
+      delete Lnew;
+      delete F0made;
+      delete F1made;
+      delete S0made;
+      delete S1made;
+      delete F0new;
+      delete F1new;
+      delete S0new;
+      delete S1new;
+      delete Anew;
+      delete Bnew;
+      delete Cnew;
+      delete Dnew;
+
+   }
+
+   const int numCalls = repeats * (L-2);
+   double total = 0.0;
+   for (int family=0; family<numFamilies; family++){
+      cout << familyNames[family] << " : " << numCalls << " calls ; " << 1000 * elapsed[family] / numCalls << " ms per call" << endl;
+      total += elapsed[family];
+   }
+   cout << "All operator updates : " << total << " seconds" << endl;
+
+   delete [] elapsed;
+   delete [] workmem;
+   for (int index=0; index<L; index++){ delete MPS[index]; }
+   delete [] MPS;
+   delete denBK;
+
+}
+
+int main(void){
+
+   cout.precision(6);
+
+   //Only the symmetry sectors matter, so the matrix elements are left zero
+   const int L = 24;
+   int * OrbIrreps = new int[L];
+   for (int orb=0; orb<L; orb++){ OrbIrreps[orb] = orb % 8; }
+   CheMPS2::Hamiltonian * Ham = new CheMPS2::Hamiltonian(L, 7, OrbIrreps);
+   delete [] OrbIrreps;
+   CheMPS2::Problem * Prob = new CheMPS2::Problem(Ham, 0, L, 0);
+   CheMPS2::SyBookkeeper * denBK = new CheMPS2::SyBookkeeper(Prob, 2000);
+   const int nIrreps = denBK->getNumberOfIrreps();
+
+   CheMPS2::TensorT ** MPS = new CheMPS2::TensorT*[L];
+   for (int index=0; index<L; index++){ MPS[index] = new CheMPS2::TensorT(index, denBK->gIrrep(index), denBK); }
+
+   const int repeats = 3;
+   long long lookups = 0;
+   long long found = 0;
+   struct timeval start;
+   gettimeofday(&start, NULL);
+   for (int rep=0; rep<repeats; rep++){
+      for (int index=0; index<L; index++){
+         for (int N1=denBK->gNmin(index); N1<=denBK->gNmax(index); N1++){
+            for (int TwoS1=denBK->gTwoSmin(index,N1); TwoS1<=denBK->gTwoSmax(index,N1); TwoS1+=2){
+               for (int I1=0; I1<nIrreps; I1++){
+                  for (int N2=denBK->gNmin(index+1); N2<=denBK->gNmax(index+1); N2++){
+                     for (int TwoS2=denBK->gTwoSmin(index+1,N2); TwoS2<=denBK->gTwoSmax(index+1,N2); TwoS2+=2){
+                        for (int I2=0; I2<nIrreps; I2++){
+                           if (MPS[index]->gKappa(N1, TwoS1, I1, N2, TwoS2, I2) != -1){ found++; }
+                           lookups++;
+                        }
+                     }
+                  }
+               }
+            }
+         }
+      }
+   }
+   const double elapsed = seconds(start);
+
+   int totalBlocks = 0;
+   for (int index=0; index<L; index++){ totalBlocks += MPS[index]->gNKappa(); }
+   cout << "Tensor::gKappa : " << lookups << " lookups (" << found << " present) over " << L << " MPS tensors with " << totalBlocks << " blocks in total" << endl;
+   cout << "Tensor::gKappa : " << elapsed << " seconds, or " << lookups / elapsed * 1e-6 << " million lookups per second" << endl;
+
+   for (int index=0; index<L; index++){ delete MPS[index]; }
+   delete [] MPS;
+   delete denBK;
+
+   srand(1);
+   benchmarkUpdates(Prob, L, 3);
+
+   delete Prob;
+   delete Ham;
+
+   return 0;
+
+}
+
@@ -0,0 +1,324 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <stdlib.h>
+#include <iostream>
+#include <sstream>
+#include <math.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+#include "DMRG.h"
+
+using namespace std;
+
+/* Benchmark of the storage of the renormalized operators, on a Hubbard chain of L sites in C1 symmetry (hopping -1, U = 4, half filling).
+   Part 1 compares the two on-disk layouts without running DMRG. The operators of all boundaries of a left-to-right sweep are built for virtual dimension D, filled with random numbers, stored and loaded back:
+    - the legacy layout: one HDF5 file per boundary, with one group and one contiguous dataset per tensor;
+    - the single-file layout of DMRG::storeOperators: one chunked blob and one offset table per boundary, without and with shuffle + deflate.
+   Part 2 solves the ground state with the operators in memory, with the synchronous store on disk without and with compression, and with the store done by the I/O thread.
+   Every run starts from the same random MPS, after one warm-up run. The difference in wall time with the in-memory run is the cost of storing and loading the operators. */
+
+const int L = 20;
+const int D = 200;
+
+const int numLayouts = 3;
+const char * layoutNames[] = { "legacy file per boundary", "single file", "single file with deflate 1" };
+
+const int numModes = 4;
+const char * modeNames[] = { "operators in memory", "synchronous store on disk", "synchronous store on disk with deflate 1", "store on disk by the I/O thread" };
+
+double seconds(const struct timeval & start){
+
+   struct timeval end;
+   gettimeofday(&end, NULL);
+   return (end.tv_sec - start.tv_sec) + 1e-6 * (end.tv_usec - start.tv_usec);
+
+}
+
+//The operators at boundary index+1 when moving right, in the order of DMRG::listOperators (C1, so all irreps are 0); returns their number
+int buildOperators(const int index, const CheMPS2::SyBookkeeper * denBK, const CheMPS2::Problem * Prob, CheMPS2::Tensor ** list){
+
+   const int Nbound = index + 1;
+   const int Cbound = L - 1 - index;
+   int num = 0;
+   for (int cnt2=0; cnt2<Nbound; cnt2++){ list[num++] = new CheMPS2::TensorL(index+1, 0, true, denBK, true); }
+   for (int cnt2=0; cnt2<Nbound; cnt2++){
+      for (int cnt3=0; cnt3<Nbound-cnt2; cnt3++){
+         list[num++] = new CheMPS2::TensorF0(index+1, 0, true, denBK, true);
+         list[num++] = new CheMPS2::TensorF1(index+1, 0, true, denBK, true);
+         list[num++] = new CheMPS2::TensorS0(index+1, 0, true, denBK, true);
+         if (cnt2>0){ list[num++] = new CheMPS2::TensorS1(index+1, 0, true, denBK, true); }
+      }
+   }
+   for (int cnt2=0; cnt2<Cbound; cnt2++){
+      for (int cnt3=0; cnt3<Cbound-cnt2; cnt3++){
+         list[num++] = new CheMPS2::TensorA(index+1, 0, true, denBK, true);
+         if (cnt2>0){ list[num++] = new CheMPS2::TensorB(index+1, 0, true, denBK, true); }
+         list[num++] = new CheMPS2::TensorC(index+1, 0, true, denBK, true);
+         list[num++] = new CheMPS2::TensorD(index+1, 0, true, denBK, true);
+      }
+   }
+   for (int cnt2=0; cnt2<Cbound; cnt2++){ list[num++] = new CheMPS2::TensorQ(index+1, 0, true, denBK, Prob, index+1+cnt2, true); }
+   list[num++] = new CheMPS2::TensorX(index+1, true, denBK, Prob, true);
+   return num;
+
+}
+
+string fileName(const int layout, const int index){
+
+   stringstream name;
+   name << CheMPS2::TMPpath << "CheMPS2_bench2_" << layout;
+   if (layout == 0){ name << "_index_" << index; }
+   name << ".h5";
+   return name.str();
+
+}
+
+//The legacy layout: a new file per boundary, with per tensor a group "/tensor_<cnt>" and a contiguous dataset "tensorStorage"
+void legacyTransfer(const int index, CheMPS2::Tensor ** list, const int num, const bool write){
+
+   hid_t file_id = (write) ? H5Fcreate(fileName(0, index).c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT)
+                           : H5Fopen(fileName(0, index).c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+   for (int cnt=0; cnt<num; cnt++){
+      const int size = list[cnt]->gKappa2index(list[cnt]->gNKappa());
+      if (size == 0){ continue; }
+      stringstream path;
+      path << "/tensor_" << cnt;
+      if (write){
+         hid_t group_id = H5Gcreate(file_id, path.str().c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+         hsize_t dimarray = size;
+         hid_t dataspace_id = H5Screate_simple(1, &dimarray, NULL);
+         hid_t dataset_id = H5Dcreate(group_id, "tensorStorage", H5T_IEEE_F64LE, dataspace_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+         H5Dwrite(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, list[cnt]->gStorage());
+         H5Dclose(dataset_id);
+         H5Sclose(dataspace_id);
+         H5Gclose(group_id);
+      } else {
+         hid_t group_id = H5Gopen(file_id, path.str().c_str(), H5P_DEFAULT);
+         hid_t dataset_id = H5Dopen(group_id, "tensorStorage", H5P_DEFAULT);
+         H5Dread(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, list[cnt]->gStorage());
+         H5Dclose(dataset_id);
+         H5Gclose(group_id);
+      }
+   }
+   H5Fclose(file_id);
+
+}
+
+//The single-file layout: per boundary an offset table "/offsets_<index>" and a chunked blob "/index_<index>", transferred through a staging buffer of one chunk
+void blobTransfer(const hid_t file_id, const int index, CheMPS2::Tensor ** list, const int num, const int level, const bool write){
+
+   long long * offsets = new long long[num+1];
+   offsets[0] = 0;
+   for (int cnt=0; cnt<num; cnt++){ offsets[cnt+1] = offsets[cnt] + list[cnt]->gKappa2index(list[cnt]->gNKappa()); }
+
+   stringstream offsetname;
+   offsetname << "/offsets_" << index;
+   stringstream blobname;
+   blobname << "/index_" << index;
+   hid_t offset_id, blob_id;
+   if (write){
+      hsize_t numOffsets = num+1;
+      hid_t offsetspace_id = H5Screate_simple(1, &numOffsets, NULL);
+      offset_id = H5Dcreate(file_id, offsetname.str().c_str(), H5T_NATIVE_LLONG, offsetspace_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+      H5Dwrite(offset_id, H5T_NATIVE_LLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, offsets);
+      H5Sclose(offsetspace_id);
+      hsize_t size = offsets[num];
+      hsize_t maxdims = H5S_UNLIMITED;
+      hsize_t chunk = CheMPS2::DMRG_operatorChunkSize;
+      hid_t blobspace_id = H5Screate_simple(1, &size, &maxdims);
+      hid_t plist_id = H5Pcreate(H5P_DATASET_CREATE);
+      H5Pset_chunk(plist_id, 1, &chunk);
+      if (level > 0){
+         H5Pset_shuffle(plist_id);
+         H5Pset_deflate(plist_id, level);
+      }
+      blob_id = H5Dcreate(file_id, blobname.str().c_str(), H5T_NATIVE_DOUBLE, blobspace_id, H5P_DEFAULT, plist_id, H5P_DEFAULT);
+      H5Pclose(plist_id);
+      H5Sclose(blobspace_id);
+   } else {
+      offset_id = H5Dopen(file_id, offsetname.str().c_str(), H5P_DEFAULT);
+      H5Dread(offset_id, H5T_NATIVE_LLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, offsets);
+      blob_id = H5Dopen(file_id, blobname.str().c_str(), H5P_DEFAULT);
+   }
+   H5Dclose(offset_id);
+
+   //Both directions stream the blob chunk by chunk; a tensor can straddle two chunks
+   const hsize_t chunk = CheMPS2::DMRG_operatorChunkSize;
+   double * buffer = new double[chunk];
+   hsize_t start = 0;
+   int tensor = 0;
+   hsize_t done = 0; //Of the current tensor
+   while (start < (hsize_t) offsets[num]){
+      const hsize_t size = (((hsize_t) offsets[num] - start) < chunk) ? ((hsize_t) offsets[num] - start) : chunk;
+      if (!write){
+         hid_t filespace_id = H5Dget_space(blob_id);
+         H5Sselect_hyperslab(filespace_id, H5S_SELECT_SET, &start, NULL, &size, NULL);
+         hid_t memspace_id = H5Screate_simple(1, &size, NULL);
+         H5Dread(blob_id, H5T_NATIVE_DOUBLE, memspace_id, filespace_id, H5P_DEFAULT, buffer);
+         H5Sclose(memspace_id);
+         H5Sclose(filespace_id);
+      }
+      hsize_t filled = 0;
+      while (filled < size){
+         const hsize_t left = offsets[tensor+1] - offsets[tensor] - done;
+         const hsize_t piece = (left < (size - filled)) ? left : (size - filled);
+         if (write){ memcpy(buffer + filled, list[tensor]->gStorage() + done, sizeof(double) * piece); }
+         else {      memcpy(list[tensor]->gStorage() + done, buffer + filled, sizeof(double) * piece); }
+         filled += piece;
+         done += piece;
+         if (done == (hsize_t)(offsets[tensor+1] - offsets[tensor])){ tensor++; done = 0; }
+      }
+      if (write){
+         hid_t filespace_id = H5Dget_space(blob_id);
+         H5Sselect_hyperslab(filespace_id, H5S_SELECT_SET, &start, NULL, &size, NULL);
+         hid_t memspace_id = H5Screate_simple(1, &size, NULL);
+         H5Dwrite(blob_id, H5T_NATIVE_DOUBLE, memspace_id, filespace_id, H5P_DEFAULT, buffer);
+         H5Sclose(memspace_id);
+         H5Sclose(filespace_id);
+      }
+      start += size;
+   }
+   H5Dclose(blob_id);
+
+   delete [] buffer;
+   delete [] offsets;
+
+}
+
+void compareLayouts(const CheMPS2::Problem * Prob){
+
+   CheMPS2::SyBookkeeper * denBK = new CheMPS2::SyBookkeeper(Prob, D);
+   const int maxNum = 2 * L * L * L + L; //Upper bound for the number of operators of a boundary
+   CheMPS2::Tensor ** list = new CheMPS2::Tensor*[maxNum];
+
+   double totalMB = 0.0;
+   for (int layout=0; layout<numLayouts; layout++){
+      hid_t file_id = (layout > 0) ? H5Fcreate(fileName(layout, 0).c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT) : -1;
+      double timeStore = 0.0;
+      double timeLoad = 0.0;
+      double checksum = 0.0;
+      double fileMB = 0.0;
+      totalMB = 0.0;
+      for (int write=1; write>=0; write--){
+         if ((layout > 0) && (write == 0)){
+            H5Fclose(file_id);
+            struct stat stFileInfo;
+            stat(fileName(layout, 0).c_str(), &stFileInfo);
+            fileMB = stFileInfo.st_size / 1048576.0;
+            file_id = H5Fopen(fileName(layout, 0).c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+         }
+         srand(1);
+         for (int index=0; index<L-1; index++){
+            const int num = buildOperators(index, denBK, Prob, list);
+            for (int cnt=0; cnt<num; cnt++){
+               double * storage = list[cnt]->gStorage();
+               const int size = list[cnt]->gKappa2index(list[cnt]->gNKappa());
+               for (int elem=0; elem<size; elem++){ storage[elem] = (write) ? ((double) rand()) / RAND_MAX : 0.0; }
+               if (write){ totalMB += sizeof(double) * size / 1048576.0; }
+            }
+            struct timeval start;
+            gettimeofday(&start, NULL);
+            if (layout == 0){ legacyTransfer(index, list, num, write); }
+            else {            blobTransfer(file_id, index, list, num, (layout == 2) ? 1 : 0, write); }
+            if (write){ timeStore += seconds(start); }
+            else {      timeLoad  += seconds(start); }
+            for (int cnt=0; cnt<num; cnt++){
+               if (!write){
+                  double * storage = list[cnt]->gStorage();
+                  const int size = list[cnt]->gKappa2index(list[cnt]->gNKappa());
+                  for (int elem=0; elem<size; elem++){ checksum += storage[elem]; }
+               }
+               delete list[cnt];
+            }
+            if ((layout == 0) && (write)){
+               struct stat stFileInfo;
+               stat(fileName(layout, index).c_str(), &stFileInfo);
+               fileMB += stFileInfo.st_size / 1048576.0;
+            }
+         }
+      }
+      if (layout > 0){ H5Fclose(file_id); }
+      for (int index=0; index<((layout == 0) ? L-1 : 1); index++){ remove(fileName(layout, index).c_str()); }
+      cout << "Layout " << layoutNames[layout] << " : store " << timeStore << " seconds ; load " << timeLoad << " seconds ; on disk " << fileMB << " MB ; checksum " << checksum << endl;
+   }
+   cout << "The operators of all " << L-1 << " boundaries take " << totalMB << " MB in memory." << endl;
+
+   delete [] list;
+   delete denBK;
+
+}
+
+int main(void){
+
+   cout.precision(6);
+
+   int * irreps = new int[L];
+   for (int orb=0; orb<L; orb++){ irreps[orb] = 0; }
+   CheMPS2::Hamiltonian * Ham = new CheMPS2::Hamiltonian(L, 0, irreps);
+   delete [] irreps;
+   for (int i=0; i<L; i++){
+      for (int j=0; j<L; j++){
+         Ham->setTmat(i, j, (abs(i-j) == 1) ? -1.0 : 0.0);
+         for (int k=0; k<L; k++){
+            for (int l=0; l<L; l++){ Ham->setVmat(i, j, k, l, ((i==j) && (j==k) && (k==l)) ? 4.0 : 0.0); }
+         }
+      }
+   }
+   Ham->setEconst(0.0);
+   CheMPS2::Problem * Prob = new CheMPS2::Problem(Ham, 0, L, 0);
+
+   compareLayouts(Prob);
+
+   CheMPS2::ConvergenceScheme * OptScheme = new CheMPS2::ConvergenceScheme(2);
+   OptScheme->setInstruction(0, 30, 1e-10, 2, 0.1);
+   OptScheme->setInstruction(1, D, 1e-10, 2, 0.0);
+
+   double * elapsed = new double[numModes];
+   double * energies = new double[numModes];
+   for (int run=-1; run<numModes; run++){
+      const int mode = (run < 0) ? 0 : run;
+      srand(1);
+      CheMPS2::DMRG * theDMRG = new CheMPS2::DMRG(Prob, OptScheme);
+      theDMRG->setOperatorStorage(mode > 0, false, mode == 3);
+      theDMRG->setOperatorCompression((mode == 2) ? 1 : 0);
+      struct timeval start;
+      gettimeofday(&start, NULL);
+      energies[mode] = theDMRG->Solve();
+      elapsed[mode] = seconds(start);
+      if (CheMPS2::DMRG_storeMpsOnDisk){ theDMRG->deleteStoredMPS(); }
+      if (mode > 0){ theDMRG->deleteStoredOperators(); }
+      delete theDMRG;
+   }
+
+   for (int mode=0; mode<numModes; mode++){
+      cout << "Solve with " << modeNames[mode] << " : " << elapsed[mode] << " seconds ; difference with the operators in memory = " << elapsed[mode] - elapsed[0] << " seconds ; energy = " << energies[mode] << endl;
+   }
+
+   delete [] elapsed;
+   delete [] energies;
+   delete OptScheme;
+   delete Prob;
+   delete Ham;
+
+   return 0;
+
+}
@@ -0,0 +1,129 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <stdlib.h>
+#include <iostream>
+#include <sys/time.h>
+
+#include "FourIndex.h"
+
+using namespace std;
+
+/* Benchmark of the storage of the two-body matrix elements in FourIndex.
+   For 100 orbitals in C1 and in d2h, the construction, the random access with get, and save and read to HDF5 are timed.
+   The random orbitals are drawn with a linear congruential generator, so that every build does the same accesses and prints the same checksum. */
+
+double seconds(const struct timeval & start){
+
+   struct timeval end;
+   gettimeofday(&end, NULL);
+   return (end.tv_sec - start.tv_sec) + 1e-6 * (end.tv_usec - start.tv_usec);
+
+}
+
+void benchmark(const int nGroup, const int nIrreps, const int * IrrepSizes, const char * name){
+
+   //The irrep and the index within the irrep of each orbital
+   int L = 0;
+   for (int irrep=0; irrep<nIrreps; irrep++){ L += IrrepSizes[irrep]; }
+   int * orbIrrep = new int[L];
+   int * orbIndex = new int[L];
+   int * irrepStart = new int[nIrreps];
+   int orb = 0;
+   for (int irrep=0; irrep<nIrreps; irrep++){
+      irrepStart[irrep] = orb;
+      for (int cnt=0; cnt<IrrepSizes[irrep]; cnt++){
+         orbIrrep[orb] = irrep;
+         orbIndex[orb] = cnt;
+         orb++;
+      }
+   }
+
+   struct timeval start;
+   gettimeofday(&start, NULL);
+   CheMPS2::FourIndex * theVmat = new CheMPS2::FourIndex(nGroup, IrrepSizes);
+   const double timeConstruct = seconds(start);
+
+   //Random symmetry-allowed elements: the irrep of l follows from those of i, j and k (all d2h subgroups are Abelian with I x I = trivial)
+   const int numAccess = 10000000;
+   unsigned int lcg = 12345;
+   gettimeofday(&start, NULL);
+   for (int cnt=0; cnt<numAccess; cnt++){
+      lcg = 1664525 * lcg + 1013904223; const int i = (lcg >> 8) % L;
+      lcg = 1664525 * lcg + 1013904223; const int j = (lcg >> 8) % L;
+      lcg = 1664525 * lcg + 1013904223; const int k = (lcg >> 8) % L;
+      const int irrep_l = orbIrrep[i] ^ orbIrrep[j] ^ orbIrrep[k];
+      if (IrrepSizes[irrep_l] == 0){ continue; }
+      lcg = 1664525 * lcg + 1013904223; const int l = irrepStart[irrep_l] + (lcg >> 8) % IrrepSizes[irrep_l];
+      theVmat->set(orbIrrep[i], orbIrrep[j], orbIrrep[k], orbIrrep[l], orbIndex[i], orbIndex[j], orbIndex[k], orbIndex[l], 1e-3 * (cnt % 1000));
+   }
+   const double timeSet = seconds(start);
+
+   //The same elements as were set, so that the checksum does not depend on uninitialized storage
+   double sum = 0.0;
+   lcg = 12345;
+   gettimeofday(&start, NULL);
+   for (int cnt=0; cnt<numAccess; cnt++){
+      lcg = 1664525 * lcg + 1013904223; const int i = (lcg >> 8) % L;
+      lcg = 1664525 * lcg + 1013904223; const int j = (lcg >> 8) % L;
+      lcg = 1664525 * lcg + 1013904223; const int k = (lcg >> 8) % L;
+      const int irrep_l = orbIrrep[i] ^ orbIrrep[j] ^ orbIrrep[k];
+      if (IrrepSizes[irrep_l] == 0){ continue; }
+      lcg = 1664525 * lcg + 1013904223; const int l = irrepStart[irrep_l] + (lcg >> 8) % IrrepSizes[irrep_l];
+      sum += theVmat->get(orbIrrep[i], orbIrrep[j], orbIrrep[k], orbIrrep[l], orbIndex[i], orbIndex[j], orbIndex[k], orbIndex[l]);
+   }
+   const double timeGet = seconds(start);
+
+   const string filename = "CheMPS2_bench3.h5";
+   gettimeofday(&start, NULL);
+   theVmat->save(filename);
+   const double timeSave = seconds(start);
+
+   gettimeofday(&start, NULL);
+   theVmat->read(filename);
+   const double timeRead = seconds(start);
+   int info = system(("rm " + filename).c_str());
+
+   gettimeofday(&start, NULL);
+   delete theVmat;
+   const double timeDelete = seconds(start);
+
+   cout << name << " : construct " << timeConstruct << " s ; set " << numAccess / timeSet * 1e-6 << " M/s ; get " << numAccess / timeGet * 1e-6 << " M/s ; save " << timeSave << " s ; read " << timeRead << " s ; delete " << timeDelete << " s" << endl;
+   cout << name << " : checksum " << sum << " ; rm info " << info << endl;
+
+   delete [] orbIrrep;
+   delete [] orbIndex;
+   delete [] irrepStart;
+
+}
+
+int main(void){
+
+   cout.precision(4);
+
+   int sizesC1[] = { 100 };
+   benchmark(0, 1, sizesC1, "C1,  100 orbitals");
+
+   int sizesD2h[] = { 19, 7, 12, 12, 5, 19, 13, 13 };
+   benchmark(7, 8, sizesD2h, "d2h, 100 orbitals");
+
+   return 0;
+
+}
+
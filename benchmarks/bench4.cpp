@@ -0,0 +1,176 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <stdlib.h>
+#include <iostream>
+#include <sys/time.h>
+
+#include "Wigner.h"
+#include "Gsl.h"
+#include "DMRG.h"
+
+using namespace std;
+
+/* Benchmark of the memoized Wigner 6j and 9j symbols.
+   The arguments follow the pattern of the diagrams: virtual spins up to maxTwoS which differ by a local spin 1/2 or an operator spin 0 or 1, so that all triangle conditions hold.
+   The same symbols are evaluated directly with GSL, with an empty memo (one pass, which fills it), and with a filled memo. The GSL and filled memo timings are averaged over numPasses passes.
+   Afterwards, the ground state of a Hubbard chain of L sites in C1 symmetry (hopping -1, U = 4, half filling) is solved with the memo, and with every symbol evaluated by GSL (Wigner::setMemo(false)). Both runs start from the same random MPS, after one warm-up run. */
+
+double seconds(const struct timeval & start){
+
+   struct timeval end;
+   gettimeofday(&end, NULL);
+   return (end.tv_sec - start.tv_sec) + 1e-6 * (end.tv_usec - start.tv_usec);
+
+}
+
+double pass6j(const int maxTwoS, const bool memo, int & numCalls){
+
+   double sum = 0.0;
+   numCalls = 0;
+   for (int TwoSL=0; TwoSL<=maxTwoS; TwoSL++){
+      for (int TwoSR=TwoSL-1; TwoSR<=TwoSL+1; TwoSR+=2){
+         if (TwoSR < 0){ continue; }
+         for (int TwoJ=0; TwoJ<=2; TwoJ+=2){
+            for (int TwoSLprime=abs(TwoSL-TwoJ); TwoSLprime<=TwoSL+TwoJ; TwoSLprime+=2){
+               sum += (memo) ? CheMPS2::Wigner::wigner6j(TwoSL, TwoSR, 1, TwoSR, TwoSLprime, TwoJ)
+                             : gsl_sf_coupling_6j(TwoSL, TwoSR, 1, TwoSR, TwoSLprime, TwoJ);
+               numCalls++;
+            }
+         }
+      }
+   }
+   return sum;
+
+}
+
+double pass9j(const int maxTwoS, const bool memo, int & numCalls){
+
+   double sum = 0.0;
+   numCalls = 0;
+   for (int TwoSL=0; TwoSL<=maxTwoS; TwoSL++){
+      for (int TwoSR=TwoSL-1; TwoSR<=TwoSL+1; TwoSR+=2){
+         if (TwoSR < 0){ continue; }
+         for (int TwoJ=0; TwoJ<=2; TwoJ+=2){
+            for (int TwoSLprime=abs(TwoSL-TwoJ); TwoSLprime<=TwoSL+TwoJ; TwoSLprime+=2){
+               for (int TwoSRprime=TwoSLprime-1; TwoSRprime<=TwoSLprime+1; TwoSRprime+=2){
+                  if (TwoSRprime < 0){ continue; }
+                  sum += (memo) ? CheMPS2::Wigner::wigner9j(TwoSL, TwoSR, 1, TwoJ, TwoJ, 0, TwoSLprime, TwoSRprime, 1)
+                                : gsl_sf_coupling_9j(TwoSL, TwoSR, 1, TwoJ, TwoJ, 0, TwoSLprime, TwoSRprime, 1);
+                  numCalls++;
+               }
+            }
+         }
+      }
+   }
+   return sum;
+
+}
+
+void benchmark(double (*pass)(const int, const bool, int &), const int maxTwoS, const int numPasses, const char * name){
+
+   CheMPS2::Wigner::release();
+   CheMPS2::Wigner::setMaxTwoS(maxTwoS);
+   int numCalls = 0;
+   struct timeval start;
+
+   double sumGsl = 0.0;
+   gettimeofday(&start, NULL);
+   for (int cnt=0; cnt<numPasses; cnt++){ sumGsl = pass(maxTwoS, false, numCalls); }
+   const double timeGsl = seconds(start) / numPasses;
+
+   gettimeofday(&start, NULL);
+   const double sumCold = pass(maxTwoS, true, numCalls);
+   const double timeCold = seconds(start);
+
+   double sumWarm = 0.0;
+   gettimeofday(&start, NULL);
+   for (int cnt=0; cnt<numPasses; cnt++){ sumWarm = pass(maxTwoS, true, numCalls); }
+   const double timeWarm = seconds(start) / numPasses;
+
+   cout << name << " : " << numCalls << " calls per pass ; GSL " << numCalls / timeGsl * 1e-6 << " M/s ; empty memo " << numCalls / timeCold * 1e-6 << " M/s ; filled memo " << numCalls / timeWarm * 1e-6 << " M/s" << endl;
+   cout << name << " : checksum GSL " << sumGsl << " ; empty memo " << sumCold << " ; filled memo " << sumWarm << endl;
+
+}
+
+void benchmarkSolve(const int L, const int D){
+
+   int * irreps = new int[L];
+   for (int orb=0; orb<L; orb++){ irreps[orb] = 0; }
+   CheMPS2::Hamiltonian * Ham = new CheMPS2::Hamiltonian(L, 0, irreps);
+   delete [] irreps;
+   for (int i=0; i<L; i++){
+      for (int j=0; j<L; j++){
+         Ham->setTmat(i, j, (abs(i-j) == 1) ? -1.0 : 0.0);
+         for (int k=0; k<L; k++){
+            for (int l=0; l<L; l++){ Ham->setVmat(i, j, k, l, ((i==j) && (j==k) && (k==l)) ? 4.0 : 0.0); }
+         }
+      }
+   }
+   Ham->setEconst(0.0);
+   CheMPS2::Problem * Prob = new CheMPS2::Problem(Ham, 0, L, 0);
+
+   CheMPS2::ConvergenceScheme * OptScheme = new CheMPS2::ConvergenceScheme(2);
+   OptScheme->setInstruction(0, 30, 1e-10, 2, 0.1);
+   OptScheme->setInstruction(1, D, 1e-10, 2, 0.0);
+
+   double elapsed[2];
+   double energies[2];
+   for (int run=-1; run<2; run++){
+      const bool memo = (run != 1);
+      CheMPS2::Wigner::setMemo(memo);
+      srand(1);
+      CheMPS2::DMRG * theDMRG = new CheMPS2::DMRG(Prob, OptScheme);
+      struct timeval start;
+      gettimeofday(&start, NULL);
+      const double energy = theDMRG->Solve();
+      if (run >= 0){
+         elapsed[run] = seconds(start);
+         energies[run] = energy;
+      }
+      if (CheMPS2::DMRG_storeMpsOnDisk){ theDMRG->deleteStoredMPS(); }
+      if (CheMPS2::DMRG_storeRenormOptrOnDisk){ theDMRG->deleteStoredOperators(); }
+      delete theDMRG; //Also frees the memo tables
+   }
+   CheMPS2::Wigner::setMemo(true);
+
+   cout << "Solve of the Hubbard chain with L = " << L << " and D = " << D << " : memo " << elapsed[0] << " seconds ; GSL " << elapsed[1] << " seconds" << endl;
+   cout << "Solve of the Hubbard chain with L = " << L << " and D = " << D << " : energy memo " << energies[0] << " ; GSL " << energies[1] << endl;
+
+   delete OptScheme;
+   delete Prob;
+   delete Ham;
+
+}
+
+int main(void){
+
+   cout.precision(10);
+
+   const int maxTwoS = 60;
+   const int numPasses = 1000;
+   benchmark(pass6j, maxTwoS, numPasses, "6j");
+   benchmark(pass9j, maxTwoS, numPasses, "9j");
+   CheMPS2::Wigner::release();
+
+   benchmarkSolve(12, 250);
+
+   return 0;
+
+}
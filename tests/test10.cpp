@@ -0,0 +1,104 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <stdlib.h> /*srand, rand*/
+#include <iostream>
+#include <time.h> /*time*/
+#include <math.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "CASSCF.h"
+
+using namespace std;
+
+//The CASSCF solver options which are compared with the default ones
+const int numModes = 2;
+const char * modeNames[] = { "the matrix-free augmented Hessian", "the restricted two-body rotation" };
+
+double runCASSCF(const string matrixelements, CheMPS2::ConvergenceScheme * OptScheme, const int mode){
+
+   CheMPS2::CASSCF koekoek(matrixelements);
+   
+   int Nocc[]  = { 1, 0, 0, 0, 0, 0, 0, 0 };
+   int NDMRG[] = { 0, 0, 0, 0, 0, 3, 0, 0 };
+   int Nvirt[] = { 5, 0, 0, 0, 0, 3, 0, 0 };
+   koekoek.setupStart(Nocc,NDMRG,Nvirt);
+   
+   if (mode==0){ koekoek.setAugmentedHessianMaxMB(0.0); } //Always solve the augmented Hessian with Hessian-vector products
+   if (mode==1){ koekoek.setRestrictedRotation(true); } //Only rotate the matrix elements with at most two virtual indices
+   
+   int N = 6;
+   int TwoS = 0;
+   int Irrep = 0;
+   int rootNum = 1; //Ground state only
+   double Energy = koekoek.doCASSCFnewtonraphson(N, TwoS, Irrep, OptScheme, rootNum);
+   
+   if (CheMPS2::CASSCF_storeUnitary){ koekoek.deleteStoredUnitary(); }
+   return Energy;
+
+}
+
+int main(void){
+
+   cout.precision(15);
+   srand(time(NULL));
+   
+   //The path to the matrix elements
+   string matrixelements = "../../tests/matrixelements/H6_N6_S0_d2h_I0.dat";
+   struct stat stFileInfo;
+   int intStat = stat(matrixelements.c_str(),&stFileInfo);
+   if (intStat != 0){
+      cout << "Please set the correct relative path to tests/matrixelements/H6_N6_S0_d2h_I0.dat in tests/test10.cpp for the compiled binary test10 to work." << endl;
+      return 628788;
+   }
+   
+   //Setup convergence scheme
+   CheMPS2::ConvergenceScheme * OptScheme = new CheMPS2::ConvergenceScheme(2);
+   int D = 30;
+   double Econv = 1e-10;
+   int maxSweeps = 3;
+   double noisePrefactor = 0.1;
+   OptScheme->setInstruction(0,D,Econv,maxSweeps,noisePrefactor);
+   D = 1000;
+   maxSweeps = 10;
+   noisePrefactor = 0.0;
+   OptScheme->setInstruction(1,D,Econv,maxSweeps,noisePrefactor);
+
+   //Run CASSCF with the default options, and with each of the other ones
+   double EnergyDefault = runCASSCF(matrixelements, OptScheme, -1);
+   bool success = (fabs(EnergyDefault + 2.71181433378107) < 1e-10) ? true : false;
+   for (int mode=0; mode<numModes; mode++){
+      double Energy = runCASSCF(matrixelements, OptScheme, mode);
+      cout << "Energy with " << modeNames[mode] << " = " << Energy << " ; difference with the default = " << Energy - EnergyDefault << endl;
+      if (fabs(Energy - EnergyDefault) >= 1e-10){ success = false; }
+   }
+   
+   //Clean up
+   delete OptScheme;
+   
+   //Check succes
+   cout << "================> Did test 10 succeed : ";
+   if (success){ cout << "yes" << endl; }
+   else { cout << "no" << endl; }
+
+   return 0;
+
+}
+
@@ -0,0 +1,122 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <stdlib.h> /*srand, rand*/
+#include <iostream>
+#include <time.h> /*time*/
+#include <math.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "DMRG.h"
+#include "TwoDM.h"
+
+using namespace std;
+
+int main(void){
+
+   cout.precision(15);
+   srand(time(NULL));
+  
+   //The path to the matrix elements
+   string matrixelements = "../../tests/matrixelements/N2_N14_S0_d2h_I0.dat";
+   struct stat stFileInfo;
+   int intStat = stat(matrixelements.c_str(),&stFileInfo);
+   if (intStat != 0){
+      cout << "Please set the correct relative path to tests/matrixelements/N2_N14_S0_d2h_I0.dat in tests/test11.cpp for the compiled binary test11 to work." << endl;
+      return 628788;
+   }
+ 
+   //The Hamiltonian
+   CheMPS2::Hamiltonian * Ham = new CheMPS2::Hamiltonian(matrixelements);
+
+   //The targeted state
+   int TwoS = 0;
+   int N = 14;
+   int Irrep = 0;
+   CheMPS2::Problem * Prob = new CheMPS2::Problem(Ham, TwoS, N, Irrep);
+   Prob->SetupReorderD2h();
+
+   //The convergence scheme
+   CheMPS2::ConvergenceScheme * OptScheme = new CheMPS2::ConvergenceScheme(2);
+   int D = 30;
+   double Econv = 1e-10;
+   int maxSweeps = 3;
+   double noisePrefactor = 0.1;
+   OptScheme->setInstruction(0,D,Econv,maxSweeps,noisePrefactor);
+   D = 1000;
+   maxSweeps = 10;
+   noisePrefactor = 0.0;
+   OptScheme->setInstruction(1,D,Econv,maxSweeps,noisePrefactor);
+
+   //Run ground state calculation and calculate the 2DM
+   CheMPS2::DMRG * theDMRG = new CheMPS2::DMRG(Prob,OptScheme);
+   double Energy = theDMRG->Solve();
+   theDMRG->calc2DM();
+   CheMPS2::TwoDM * the2DM = theDMRG->get2DM();
+   double Energy2DM = the2DM->calcEnergy();
+   double Trace2DM = the2DM->doubletrace2DMA();
+   
+   //Save the packed 2DM-A and 2DM-B, read them into a new TwoDM object, and compare all elements
+   const string filename = "CheMPS2_test11_2DM.h5";
+   the2DM->save(filename);
+   CheMPS2::SyBookkeeper * theBK = new CheMPS2::SyBookkeeper(Prob, 1);
+   CheMPS2::TwoDM * readDM = new CheMPS2::TwoDM(theBK, Prob);
+   readDM->read(filename);
+   double maxDiff = 0.0;
+   const int L = Prob->gL();
+   for (int cnt1=0; cnt1<L; cnt1++){
+      for (int cnt2=0; cnt2<L; cnt2++){
+         for (int cnt3=0; cnt3<L; cnt3++){
+            for (int cnt4=0; cnt4<L; cnt4++){
+               maxDiff = max(maxDiff, fabs(the2DM->getTwoDMA_DMRG(cnt1,cnt2,cnt3,cnt4) - readDM->getTwoDMA_DMRG(cnt1,cnt2,cnt3,cnt4)));
+               maxDiff = max(maxDiff, fabs(the2DM->getTwoDMB_DMRG(cnt1,cnt2,cnt3,cnt4) - readDM->getTwoDMB_DMRG(cnt1,cnt2,cnt3,cnt4)));
+            }
+         }
+      }
+   }
+   double EnergyRead = readDM->calcEnergy();
+   cout << "Energy = " << Energy << " ; 2DM energy = " << Energy2DM << " ; 2DM energy after save and read = " << EnergyRead << endl;
+   cout << "Double trace of 2DM-A = " << Trace2DM << " ; max. difference of the 2DM elements after save and read = " << maxDiff << endl;
+   delete readDM;
+   delete theBK;
+   int info = system(("rm " + filename).c_str());
+   cout << "Info on 2DM rm call to system: " << info << endl;
+
+   if (CheMPS2::DMRG_storeMpsOnDisk){ theDMRG->deleteStoredMPS(); }
+   if (CheMPS2::DMRG_storeRenormOptrOnDisk){ theDMRG->deleteStoredOperators(); }
+   delete theDMRG;
+   delete OptScheme;
+   delete Prob;
+   delete Ham;
+
+   //Check succes
+   bool OK1 = (fabs(Energy + 107.648250974014) < 1e-10) ? true : false;
+   bool OK2 = (fabs(Energy2DM - Energy) < 1e-10) ? true : false;
+   bool OK3 = (fabs(Trace2DM - N*(N-1)) < 1e-10) ? true : false;
+   bool OK4 = ((maxDiff == 0.0) && (EnergyRead == Energy2DM)) ? true : false;
+   bool success = (OK1 && OK2 && OK3 && OK4);
+   cout << "================> Did test 11 succeed : ";
+   if (success){ cout << "yes" << endl; }
+   else { cout << "no" << endl; }
+
+   return 0;
+
+}
+
@@ -0,0 +1,128 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <stdlib.h> /*srand, rand*/
+#include <iostream>
+#include <time.h> /*time*/
+#include <math.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "DMRG.h"
+
+using namespace std;
+
+int main(void){
+
+   cout.precision(15);
+   srand(time(NULL));
+  
+   //The path to the matrix elements
+   string matrixelements = "../../tests/matrixelements/N2_N14_S0_d2h_I0.dat";
+   struct stat stFileInfo;
+   int intStat = stat(matrixelements.c_str(),&stFileInfo);
+   if (intStat != 0){
+      cout << "Please set the correct relative path to tests/matrixelements/N2_N14_S0_d2h_I0.dat in tests/test12.cpp for the compiled binary test12 to work." << endl;
+      return 628788;
+   }
+ 
+   //The Hamiltonian
+   CheMPS2::Hamiltonian * Ham = new CheMPS2::Hamiltonian(matrixelements);
+
+   //The targeted state
+   int TwoS = 0;
+   int N = 14;
+   int Irrep = 0;
+   CheMPS2::Problem * Prob = new CheMPS2::Problem(Ham, TwoS, N, Irrep);
+   Prob->SetupReorderD2h();
+
+   //The Davidson options: a residual tolerance which is loose while the energy changes a lot, and a cap on the matrix-vector products per solve
+   const int maxMatvecs = 8;
+   const double rtolBase = 1e-10;
+   const double rtolLoose = 1e-3;
+   CheMPS2::DavidsonOptions * dvdsOptions = new CheMPS2::DavidsonOptions();
+   dvdsOptions->setResidualTolerance(rtolBase, rtolLoose);
+   dvdsOptions->setMaxMatvecs(maxMatvecs);
+   bool success = ((dvdsOptions->getMaxMatvecs() == maxMatvecs) && (dvdsOptions->getResidualTolerance(1.0) == rtolLoose)
+                && (dvdsOptions->getResidualTolerance(1e-6) == 1e-6) && (dvdsOptions->getResidualTolerance(0.0) == rtolBase));
+
+   //One left-right sweep iteration from a random MPS, in which an uncapped Davidson solve needs far more matrix-vector products. The telemetry of a site adds its solves of the left and the right sweep, so it should not exceed twice the cap.
+   CheMPS2::ConvergenceScheme * OneSweep = new CheMPS2::ConvergenceScheme(1);
+   OneSweep->setInstruction(0,30,1e-10,1,0.0);
+   OneSweep->setDavidsonOptions(0, dvdsOptions);
+   CheMPS2::DMRG * firstDMRG = new CheMPS2::DMRG(Prob,OneSweep);
+   firstDMRG->Solve();
+   int mostMatvecs = 0;
+   for (int index=0; index<Prob->gL()-1; index++){
+      if (firstDMRG->getDavidsonMatvecs(index) > mostMatvecs){ mostMatvecs = firstDMRG->getDavidsonMatvecs(index); }
+   }
+   cout << "The max. number of matrix-vector products per site in the first sweep iteration = " << mostMatvecs << endl;
+   success = ((success) && (mostMatvecs > 0) && (mostMatvecs <= 2 * maxMatvecs));
+   if (CheMPS2::DMRG_storeMpsOnDisk){ firstDMRG->deleteStoredMPS(); }
+   if (CheMPS2::DMRG_storeRenormOptrOnDisk){ firstDMRG->deleteStoredOperators(); }
+   delete firstDMRG;
+   delete OneSweep;
+
+   //The convergence scheme of test1, with the Davidson options attached to both instructions
+   CheMPS2::ConvergenceScheme * OptScheme = new CheMPS2::ConvergenceScheme(2);
+   int D = 30;
+   double Econv = 1e-10;
+   int maxSweeps = 3;
+   double noisePrefactor = 0.1;
+   OptScheme->setInstruction(0,D,Econv,maxSweeps,noisePrefactor);
+   D = 1000;
+   maxSweeps = 20;
+   noisePrefactor = 0.0;
+   OptScheme->setInstruction(1,D,Econv,maxSweeps,noisePrefactor);
+   OptScheme->setDavidsonOptions(0, dvdsOptions);
+   OptScheme->setDavidsonOptions(1, dvdsOptions);
+   success = ((success) && (OptScheme->getDavidsonOptions(1) == dvdsOptions));
+
+   //Run ground state calculation
+   CheMPS2::DMRG * theDMRG = new CheMPS2::DMRG(Prob,OptScheme);
+   double Energy = theDMRG->Solve();
+   
+   //The telemetry of the last sweep iteration respects the cap as well
+   int totalMatvecs = 0;
+   for (int index=0; index<Prob->gL()-1; index++){
+      const int matvecs = theDMRG->getDavidsonMatvecs(index);
+      cout << "Davidson at sites (" << index << ", " << index+1 << ") : " << matvecs << " matrix-vector products in " << theDMRG->getDavidsonTime(index) << " seconds" << endl;
+      if ((matvecs > 2 * maxMatvecs) || (theDMRG->getDavidsonTime(index) < 0.0)){ success = false; }
+      totalMatvecs += matvecs;
+   }
+   if (totalMatvecs == 0){ success = false; }
+
+   if (CheMPS2::DMRG_storeMpsOnDisk){ theDMRG->deleteStoredMPS(); }
+   if (CheMPS2::DMRG_storeRenormOptrOnDisk){ theDMRG->deleteStoredOperators(); }
+   delete theDMRG;
+   delete OptScheme;
+   delete dvdsOptions;
+   delete Prob;
+   delete Ham;
+
+   //Check succes: the loose sweeps do not count as converged, so the energy of test1 is reached
+   success = ((success) && (fabs(Energy + 107.648250974014) < 1e-10));
+   cout << "================> Did test 12 succeed : ";
+   if (success){ cout << "yes" << endl; }
+   else { cout << "no" << endl; }
+
+   return 0;
+
+}
+
@@ -0,0 +1,120 @@
+/*
+   CheMPS2: a spin-adapted implementation of DMRG for ab initio quantum chemistry
+   Copyright (C) 2013 Sebastian Wouters
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include <stdlib.h> /*srand, rand*/
+#include <iostream>
+#include <time.h> /*time*/
+#include <math.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "DMRG.h"
+
+using namespace std;
+
+//The ways of keeping the renormalized operators which are compared with the default one
+const int numModes = 4;
+const char * modeNames[] = { "synchronous operator I/O", "operators in memory", "memory-mapped operators", "a 0.5 MB operator budget" };
+
+double runDMRG(CheMPS2::Problem * Prob, CheMPS2::ConvergenceScheme * OptScheme, const int mode){
+
+   CheMPS2::DMRG * theDMRG = new CheMPS2::DMRG(Prob,OptScheme);
+   bool onDisk = CheMPS2::DMRG_storeRenormOptrOnDisk;
+   if (mode==0){ //Stores and loads by the calling thread
+      theDMRG->setOperatorStorage(true, false, false);
+      onDisk = true;
+   }
+   if (mode==1){ //No single-file operator store at all
+      theDMRG->setOperatorStorage(false, false, false);
+      onDisk = false;
+   }
+   if (mode==2){ //One unlinked memory-mapped file per boundary
+      theDMRG->setOperatorStorage(false, true, false);
+      onDisk = false;
+   }
+   if (mode==3){ //Some boundaries stay resident, the least recently needed ones are spilled to disk
+      theDMRG->setOperatorMemoryBudget(0.5);
+   }
+   double Energy = theDMRG->Solve();
+
+   if (CheMPS2::DMRG_storeMpsOnDisk){ theDMRG->deleteStoredMPS(); }
+   if (onDisk){ theDMRG->deleteStoredOperators(); }
+   delete theDMRG;
+   return Energy;
+
+}
+
+int main(void){
+
+   cout.precision(15);
+   srand(time(NULL));
+  
+   //The path to the matrix elements
+   string matrixelements = "../../tests/matrixelements/N2_N14_S0_d2h_I0.dat";
+   struct stat stFileInfo;
+   int intStat = stat(matrixelements.c_str(),&stFileInfo);
+   if (intStat != 0){
+      cout << "Please set the correct relative path to tests/matrixelements/N2_N14_S0_d2h_I0.dat in tests/test8.cpp for the compiled binary test8 to work." << endl;
+      return 628788;
+   }
+ 
+   //The Hamiltonian
+   CheMPS2::Hamiltonian * Ham = new CheMPS2::Hamiltonian(matrixelements);
+
+   //The targeted state
+   int TwoS = 0;
+   int N = 14;
+   int Irrep = 0;
+   CheMPS2::Problem * Prob = new CheMPS2::Problem(Ham, TwoS, N, Irrep);
+   Prob->SetupReorderD2h();
+
+   //The convergence scheme
+   CheMPS2::ConvergenceScheme * OptScheme = new CheMPS2::ConvergenceScheme(2);
+   int D = 30;
+   double Econv = 1e-10;
+   int maxSweeps = 3;
+   double noisePrefactor = 0.1;
+   OptScheme->setInstruction(0,D,Econv,maxSweeps,noisePrefactor);
+   D = 1000;
+   maxSweeps = 10;
+   noisePrefactor = 0.0;
+   OptScheme->setInstruction(1,D,Econv,maxSweeps,noisePrefactor);
+
+   //Run the ground state calculation with the default operator storage, and with each of the other modes
+   double EnergyDefault = runDMRG(Prob, OptScheme, -1);
+   bool success = (fabs(EnergyDefault + 107.648250974014) < 1e-10) ? true : false;
+   for (int mode=0; mode<numModes; mode++){
+      double Energy = runDMRG(Prob, OptScheme, mode);
+      cout << "Energy with " << modeNames[mode] << " = " << Energy << " ; difference with the default = " << Energy - EnergyDefault << endl;
+      if (fabs(Energy - EnergyDefault) >= 1e-10){ success = false; }
+   }
+
+   delete OptScheme;
+   delete Prob;
+   delete Ham;
+
+   //Check succes
+   cout << "================> Did test 8 succeed : ";
+   if (success){ cout << "yes" << endl; }
+   else { cout << "no" << endl; }
+
+   return 0;
+
+}
+